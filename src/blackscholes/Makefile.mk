@@ -5,3 +5,6 @@ $(APP_NAME)_dir  := $(shell dirname $(realpath $(lastword $(MAKEFILE_LIST))))
 
 # Instantiate the template
 $(eval $(call template_mk,$(APP_NAME),$($(APP_NAME)_dir)))
+
+# Training run of the pgo profile: enough options to leave the setup behind
+$(APP_NAME)_PGO_ARGS := -d large
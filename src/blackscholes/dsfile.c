@@ -0,0 +1,260 @@
+/* dsfile.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the binary Black-Scholes dataset; see dsfile.h.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Include common headers */
+#include "common/alloc.h"
+
+/* Include application-specific headers */
+#include "include/dsfile.h"
+
+/* Rows converted per batch; bounds the converter's memory */
+#define DSFILE_BATCH (64 * 1024)
+
+static const uint32_t col_elsize[DSFILE_NCOLS] = {
+  sizeof(float),   /* sptPrice   */
+  sizeof(float),   /* strike     */
+  sizeof(float),   /* rate       */
+  sizeof(float),   /* volatility */
+  sizeof(float),   /* otime      */
+  sizeof(char ),   /* otype      */
+  sizeof(float),   /* price      */
+};
+
+static uint64_t dsfile_round_up(uint64_t n, uint64_t align)
+{
+  return (n + align - 1) / align * align;
+}
+
+/* Section layout for count options; returns the file size */
+static uint64_t dsfile_layout(dsfile_header_t* hdr, uint64_t count)
+{
+  memset(hdr, 0, sizeof(*hdr));
+  memcpy(hdr->magic, DSFILE_MAGIC, sizeof(hdr->magic));
+  hdr->version = DSFILE_VERSION;
+  hdr->ncols   = DSFILE_NCOLS;
+  hdr->count   = count;
+
+  uint64_t offset = dsfile_round_up(sizeof(*hdr), DSFILE_ALIGN);
+  for (int c = 0; c < DSFILE_NCOLS; c++) {
+    hdr->offset[c] = offset;
+    hdr->elsize[c] = col_elsize[c];
+    offset = dsfile_round_up(offset + count * col_elsize[c] + DSFILE_PAD,
+                             DSFILE_ALIGN);
+  }
+
+  return offset;
+}
+
+int dsfile_open(const char* path, dsfile_header_t* hdr, uint64_t* length)
+{
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    printf("\n");
+    printf("ERROR: Cannot open dataset \"%s\": %s\n", path, strerror(errno));
+    return -1;
+  }
+
+  struct stat st;
+
+  if (fstat(fd, &st) != 0 ||
+      pread(fd, hdr, sizeof(*hdr), 0) != (ssize_t)sizeof(*hdr) ||
+      memcmp(hdr->magic, DSFILE_MAGIC, sizeof(hdr->magic)) != 0) {
+    printf("\n");
+    printf("ERROR: \"%s\" is not a binary dataset (see --convert)\n", path);
+    close(fd);
+    return -1;
+  }
+
+  /* Check the layout against what this build expects */
+  dsfile_header_t want;
+  *length = dsfile_layout(&want, hdr->count);
+
+  if (hdr->version != DSFILE_VERSION || hdr->ncols != DSFILE_NCOLS ||
+      memcmp(hdr->offset, want.offset, sizeof(want.offset)) != 0 ||
+      memcmp(hdr->elsize, want.elsize, sizeof(want.elsize)) != 0 ||
+      (uint64_t)st.st_size < *length) {
+    printf("\n");
+    printf("ERROR: Dataset \"%s\" is truncated or of another version\n", path);
+    close(fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+int dsfile_map(const char* path, dsfile_t* ds)
+{
+  memset(ds, 0, sizeof(*ds));
+
+  dsfile_header_t hdr;
+  uint64_t        length;
+
+  int fd = dsfile_open(path, &hdr, &length);
+  if (fd < 0) return -1;
+
+  /* Private and writable so the guard word can go after the prices;
+   * populated up front when the run asks for prefaulting */
+  int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+  if (mem_get_policy()->prefault) flags |= MAP_POPULATE;
+#endif
+
+  void* base = mmap(NULL, length, PROT_READ | PROT_WRITE, flags, fd, 0);
+  close(fd);
+
+  if (base == MAP_FAILED) {
+    printf("\n");
+    printf("ERROR: Cannot map dataset \"%s\": %s\n", path, strerror(errno));
+    return -1;
+  }
+
+  char* p = (char*)base;
+
+  ds->base       = base;
+  ds->length     = length;
+  ds->count      = hdr.count;
+
+  ds->sptPrice   = (float*)(p + hdr.offset[DSFILE_SPTPRICE  ]);
+  ds->strike     = (float*)(p + hdr.offset[DSFILE_STRIKE    ]);
+  ds->rate       = (float*)(p + hdr.offset[DSFILE_RATE      ]);
+  ds->volatility = (float*)(p + hdr.offset[DSFILE_VOLATILITY]);
+  ds->otime      = (float*)(p + hdr.offset[DSFILE_OTIME     ]);
+  ds->otype      = (char *)(p + hdr.offset[DSFILE_OTYPE     ]);
+  ds->price      = (float*)(p + hdr.offset[DSFILE_PRICE     ]);
+
+  return 0;
+}
+
+void dsfile_unmap(dsfile_t* ds)
+{
+  if (ds->base != NULL) munmap(ds->base, ds->length);
+
+  memset(ds, 0, sizeof(*ds));
+}
+
+/* Write one batch of every column at row offset first */
+static int dsfile_write_batch(int fd, const dsfile_header_t* hdr,
+                              void* const cols[DSFILE_NCOLS],
+                              uint64_t first, size_t n)
+{
+  for (int c = 0; c < DSFILE_NCOLS; c++) {
+    size_t bytes = n * hdr->elsize[c];
+    off_t  at    = (off_t)(hdr->offset[c] + first * hdr->elsize[c]);
+
+    if (pwrite(fd, cols[c], bytes, at) != (ssize_t)bytes) return -1;
+  }
+
+  return 0;
+}
+
+int64_t dsfile_convert(const char* txt_path, const char* out_path)
+{
+  FILE* in = fopen(txt_path, "r");
+  if (in == NULL) {
+    printf("\n");
+    printf("ERROR: Cannot open \"%s\": %s\n", txt_path, strerror(errno));
+    return -1;
+  }
+
+  /* The count is a line of its own */
+  char      line[64];
+  char*     end   = NULL;
+  long long count = -1;
+
+  if (fgets(line, sizeof(line), in) != NULL) {
+    count = strtoll(line, &end, 10);
+    while (end != line && (*end == ' ' || *end == '\t' || *end == '\r')) end++;
+    if (end == line || (*end != '\n' && *end != '\0')) count = -1;
+  }
+
+  if (count < 0) {
+    printf("\n");
+    printf("ERROR: \"%s\" does not start with an option count\n", txt_path);
+    fclose(in);
+    return -1;
+  }
+
+  int fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    printf("\n");
+    printf("ERROR: Cannot create \"%s\": %s\n", out_path, strerror(errno));
+    fclose(in);
+    return -1;
+  }
+
+  dsfile_header_t hdr;
+  uint64_t length = dsfile_layout(&hdr, (uint64_t)count);
+
+  /* Size the file first; the gaps between sections read back as zeros */
+  int err = (ftruncate(fd, (off_t)length) != 0) ||
+            (pwrite(fd, &hdr, sizeof(hdr), 0) != (ssize_t)sizeof(hdr));
+
+  void* cols[DSFILE_NCOLS];
+  for (int c = 0; c < DSFILE_NCOLS; c++) {
+    cols[c] = malloc((size_t)DSFILE_BATCH * col_elsize[c]);
+    if (cols[c] == NULL) err = 1;
+  }
+
+  uint64_t row = 0;
+  while (!err && row < (uint64_t)count) {
+    size_t n = 0;
+
+    for (; n < DSFILE_BATCH && row + n < (uint64_t)count; n++) {
+      float s, k, r, q, v, t, divs, ref;
+      char  type;
+
+      if (fscanf(in, "%f %f %f %f %f %f %c %f %f",
+                 &s, &k, &r, &q, &v, &t, &type, &divs, &ref) != 9) {
+        printf("\n");
+        printf("ERROR: \"%s\": malformed option #%llu\n", txt_path,
+               (unsigned long long)(row + n + 1));
+        err = 1;
+        break;
+      }
+
+      ((float*)cols[DSFILE_SPTPRICE  ])[n] = s;
+      ((float*)cols[DSFILE_STRIKE    ])[n] = k;
+      ((float*)cols[DSFILE_RATE      ])[n] = r;
+      ((float*)cols[DSFILE_VOLATILITY])[n] = v;
+      ((float*)cols[DSFILE_OTIME     ])[n] = t;
+      ((char *)cols[DSFILE_OTYPE     ])[n] = type;
+      ((float*)cols[DSFILE_PRICE     ])[n] = ref;
+    }
+
+    if (!err && dsfile_write_batch(fd, &hdr, cols, row, n) != 0) err = 1;
+    row += n;
+  }
+
+  for (int c = 0; c < DSFILE_NCOLS; c++) {
+    free(cols[c]);
+  }
+
+  fclose(in);
+  if (close(fd) != 0) err = 1;
+
+  if (err) {
+    printf("\n");
+    printf("ERROR: Converting \"%s\" to \"%s\" failed\n", txt_path, out_path);
+    unlink(out_path);
+    return -1;
+  }
+
+  return count;
+}
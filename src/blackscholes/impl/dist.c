@@ -0,0 +1,247 @@
+/* dist.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the distributed pricer; see dist.h.
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/pool.h"
+#include "common/dist.h"
+#include "common/driver.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/para.h"
+#include "impl/dist.h"
+
+/* Options [begin, end) of rank r */
+static void dist_partition(size_t n, int r, int nranks, size_t* begin, size_t* end)
+{
+  pool_partition(n, PARA_CHUNK_ALIGN, r, nranks, begin, end);
+}
+
+/* impl_parallel over options [begin, begin + count) of args */
+static void dist_price(const args_t* args, size_t begin, size_t count)
+{
+  args_t part = *args;
+
+  part.num_stocks = count;
+  part.sptPrice   = args->sptPrice   + begin;
+  part.strike     = args->strike     + begin;
+  part.rate       = args->rate       + begin;
+  part.volatility = args->volatility + begin;
+  part.otime      = args->otime      + begin;
+  part.otype      = args->otype      + begin;
+  part.output     = args->output     + begin;
+
+  impl_parallel(&part);
+}
+
+static void dist_lost(int r)
+{
+  printf("\n");
+  printf("ERROR: Lost rank %d\n", r);
+  exit(1);
+}
+
+void* impl_dist(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+  dist_t* d           = parsed_args->dist;
+
+  size_t  n           = parsed_args->num_stocks;
+  int     nranks      = d->nranks;
+
+  uint64_t t0 = dist_now();
+
+  /* Chunk k of every partition, then chunk k + 1 */
+  for (size_t off = 0; ; off += DIST_CHUNK) {
+    bool more = false;
+
+    for (int r = 1; r < nranks; r++) {
+      size_t begin, end;
+      dist_partition(n, r, nranks, &begin, &end);
+
+      if (begin + off >= end) continue;
+
+      size_t   i     = begin + off;
+      size_t   count = (end - i < DIST_CHUNK) ? end - i : DIST_CHUNK;
+      uint64_t arg[2] = { count, i + count == end };
+      int      fd    = d->fds[r];
+
+      if (!dist_send_msg(d, fd, DIST_PRICE, arg, 2) ||
+          !dist_send(d, fd, &parsed_args->sptPrice  [i], count * sizeof(float)) ||
+          !dist_send(d, fd, &parsed_args->strike    [i], count * sizeof(float)) ||
+          !dist_send(d, fd, &parsed_args->rate      [i], count * sizeof(float)) ||
+          !dist_send(d, fd, &parsed_args->volatility[i], count * sizeof(float)) ||
+          !dist_send(d, fd, &parsed_args->otime     [i], count * sizeof(float)) ||
+          !dist_send(d, fd, &parsed_args->otype     [i], count * sizeof(char ))) {
+        dist_lost(r);
+      }
+
+      more |= (i + count < end);
+    }
+
+    if (!more) break;
+  }
+
+  uint64_t t1 = dist_now();
+
+  /* Our own partition, while the workers price theirs */
+  size_t begin, end;
+  dist_partition(n, 0, nranks, &begin, &end);
+  if (nranks == 1) impl_parallel(parsed_args);
+  else             dist_price(parsed_args, begin, end - begin);
+
+  uint64_t t2 = dist_now();
+
+  for (int r = 1; r < nranks; r++) {
+    dist_partition(n, r, nranks, &begin, &end);
+    if (begin == end) continue;
+
+    dist_msg_t msg;
+    if (!dist_recv_msg(d, d->fds[r], &msg) || msg.op != DIST_PRICES ||
+        msg.arg[0] != end - begin ||
+        !dist_recv(d, d->fds[r], &parsed_args->output[begin], (end - begin) * sizeof(float))) {
+      dist_lost(r);
+    }
+
+    d->phases.remote_compute += (double)msg.arg[1];
+    d->phases.remote_wait    += (double)msg.arg[2];
+  }
+
+  uint64_t t3 = dist_now();
+
+  d->phases.invocations++;
+  d->used            = true;
+  d->phases.send    += (double)(t1 - t0);
+  d->phases.compute += (double)(t2 - t1);
+  d->phases.gather  += (double)(t3 - t2);
+
+  /* Done */
+  return NULL;
+}
+
+/* Columns of the partition being received, grown as needed */
+typedef struct {
+  size_t cap;
+  float* col[6];             /* Five inputs, then the prices */
+  char * otype;
+} dist_buf_t;
+
+static void dist_reserve(dist_buf_t* buf, size_t n)
+{
+  if (n <= buf->cap) return;
+
+  size_t cap = (buf->cap > 0) ? buf->cap : DIST_CHUNK;
+  while (cap < n) cap *= 2;
+
+  for (int j = 0; j < 6; j++) {
+    float* col = __ALLOC_DATA(float, cap);
+    if (buf->col[j] != NULL) memcpy(col, buf->col[j], buf->cap * sizeof(float));
+    __FREE_DATA(buf->col[j]);
+    buf->col[j] = col;
+  }
+
+  char* otype = __ALLOC_DATA(char, cap);
+  if (buf->otype != NULL) memcpy(otype, buf->otype, buf->cap);
+  __FREE_DATA(buf->otype);
+  buf->otype = otype;
+
+  buf->cap = cap;
+}
+
+int dist_worker(const driver_env_t* env)
+{
+  dist_t*    d  = env->dist;
+  int        fd = d->fds[0];
+  dist_buf_t buf;
+
+  memset(&buf, 0, sizeof(buf));
+
+  args_t args;
+
+  memset(&args, 0, sizeof(args));
+  args.cpu      = env->cpu;
+  args.nthreads = env->nthreads;
+  args.pool     = env->pool;
+
+  size_t   off     = 0;
+  uint64_t compute = 0;
+  uint64_t wait    = 0;
+  int      ret     = 0;
+
+  for (;;) {
+    dist_msg_t msg;
+
+    /* Idle until the first chunk; only what follows is network time */
+    uint64_t t0 = dist_now();
+    if (!dist_recv_msg(d, fd, &msg)) break;
+    if (off > 0) wait += dist_now() - t0;
+
+    if (msg.op != DIST_PRICE) {
+      printf("ERROR: Unknown request %u from rank 0\n", msg.op);
+      ret = 1;
+      break;
+    }
+
+    size_t count = (size_t)msg.arg[0];
+    bool   last  = msg.arg[1] != 0;
+
+    dist_reserve(&buf, off + count);
+
+    uint64_t t1 = dist_now();
+    bool ok = true;
+    for (int j = 0; j < 5 && ok; j++) {
+      ok = dist_recv(d, fd, &buf.col[j][off], count * sizeof(float));
+    }
+    ok = ok && dist_recv(d, fd, &buf.otype[off], count);
+    if (!ok) {
+      printf("ERROR: Rank 0 hung up in the middle of a request\n");
+      ret = 1;
+      break;
+    }
+    uint64_t t2 = dist_now();
+    wait += t2 - t1;
+
+    args.num_stocks = count;
+    args.sptPrice   = &buf.col[0][off];
+    args.strike     = &buf.col[1][off];
+    args.rate       = &buf.col[2][off];
+    args.volatility = &buf.col[3][off];
+    args.otime      = &buf.col[4][off];
+    args.otype      = &buf.otype [off];
+    args.output     = &buf.col[5][off];
+    impl_parallel(&args);
+
+    compute += dist_now() - t2;
+    off     += count;
+
+    if (!last) continue;
+
+    uint64_t arg[3] = { off, compute, wait };
+    if (!dist_send_msg(d, fd, DIST_PRICES, arg, 3) ||
+        !dist_send(d, fd, buf.col[5], off * sizeof(float))) {
+      printf("ERROR: Rank 0 hung up before the prices\n");
+      ret = 1;
+      break;
+    }
+
+    d->phases.invocations++;
+    off = compute = wait = 0;
+  }
+
+  for (int j = 0; j < 6; j++) __FREE_DATA(buf.col[j]);
+  __FREE_DATA(buf.otype);
+
+  return ret;
+}
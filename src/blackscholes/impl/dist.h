@@ -0,0 +1,43 @@
+/* dist.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the distributed implementation (-i dist with --ranks N;
+ * common/dist.h). The dataset is split into one partition per rank,
+ * with the partition impl_parallel uses for threads. Rank 0 sends every
+ * worker its options in chunks of DIST_CHUNK, round robin, so the first
+ * workers price while the last ones are still receiving; a worker
+ * prices each chunk with impl_parallel as soon as it has arrived. Rank 0
+ * then prices its own partition and gathers the prices, partition by
+ * partition.
+ *
+ *   DIST_PRICE   rank 0 -> worker: arg[0] options, arg[1] last chunk;
+ *                the five input columns and the option types follow
+ *   DIST_PRICES  worker -> rank 0, after the last chunk: arg[0] options,
+ *                arg[1] ns computing, arg[2] ns receiving; the prices
+ *                of the whole partition follow
+ *
+ * On one rank this is impl_parallel.
+ */
+
+#ifndef __IMPL_DIST_H_
+#define __IMPL_DIST_H_
+
+#include <stddef.h>
+
+#include "common/driver.h"
+
+/* Options per message */
+#define DIST_CHUNK (1 << 16)
+
+#define DIST_PRICE  1
+#define DIST_PRICES 2
+
+/* Rank 0; args->dist must be set */
+void* impl_dist  (void* args);
+
+/* A worker: answer rank 0 until it hangs up (driver_bench_t.serve) */
+int   dist_worker(const driver_env_t* env);
+
+#endif //__IMPL_DIST_H_
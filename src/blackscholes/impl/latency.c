@@ -0,0 +1,298 @@
+/* latency.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the latency mode; see latency.h.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <time.h>
+#if defined(__amd64__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/stats.h"
+#include "common/driver.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/para.h"
+#include "impl/price.h"
+#include "impl/latency.h"
+
+/* Empty stamp pairs timed to find the timer's own cost */
+#define LATENCY_CALIBRATE 1000
+
+static const char* latency_paths[LATENCY_NUM] = {
+  "price_scalar, inlined", "price_select()", "impl_parallel, args_t per call"
+};
+
+/* Timer read that neither starts before the code ahead of it has
+ * executed nor lets the code after it start early */
+PRICE_INLINE uint64_t latency_stamp(void)
+{
+#if defined(__amd64__) || defined(__x86_64__)
+  unsigned int aux;
+  uint64_t     t = __rdtscp(&aux);
+
+  _mm_lfence();
+  return t;
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+  uint64_t t;
+
+  __asm__ __volatile__ ("isb\n\tmrs %0, cntvct_el0\n\tisb" : "=r"(t) : : "memory");
+  return t;
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+static double latency_ticks_ns(void)
+{
+#if defined(__amd64__) || defined(__x86_64__)
+  return driver_tsc_ghz();
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+  uint64_t freq;
+
+  __asm__ __volatile__ ("mrs %0, cntfrq_el0" : "=r"(freq));
+  return freq / 1e9;
+#else
+  return 1.0;
+#endif
+}
+
+int latency_init(latency_t* lat, size_t batch)
+{
+  memset(lat, 0, sizeof(*lat));
+  lat->batch = batch;
+  lat->last  = -1;
+
+  for (int k = 0; k < LATENCY_NUM; k++) {
+    lat->samples[k] = (uint64_t*)malloc(LATENCY_MAX_SAMPLES * sizeof(uint64_t));
+    if (lat->samples[k] == NULL) {
+      latency_destroy(lat);
+      return -1;
+    }
+  }
+
+  lat->ticks_ns = latency_ticks_ns();
+  if (lat->ticks_ns <= 0.0) lat->ticks_ns = 1.0;
+
+  /* The cheapest empty pair is what every sample carries on top */
+  uint64_t best = UINT64_MAX;
+  for (int i = 0; i < LATENCY_CALIBRATE; i++) {
+    uint64_t t0 = latency_stamp();
+    uint64_t t1 = latency_stamp();
+    if (t1 - t0 < best) best = t1 - t0;
+  }
+  lat->overhead = best;
+
+  return 0;
+}
+
+void latency_destroy(latency_t* lat)
+{
+  for (int k = 0; k < LATENCY_NUM; k++) {
+    free(lat->samples[k]);
+    lat->samples[k]  = NULL;
+    lat->nsamples[k] = 0;
+  }
+}
+
+void latency_timed(latency_t* lat, bool on)
+{
+  if (on) memset(lat->nsamples, 0, sizeof(lat->nsamples));
+
+  lat->recording = on;
+}
+
+PRICE_INLINE void latency_record(latency_t* lat, latency_kind_t kind,
+                                 uint64_t t0, uint64_t t1)
+{
+  uint64_t d = t1 - t0;
+
+  lat->last = kind;
+
+  if (lat->recording && lat->nsamples[kind] < LATENCY_MAX_SAMPLES) {
+    lat->samples[kind][lat->nsamples[kind]++] = (d > lat->overhead) ? d - lat->overhead : 0;
+  }
+}
+
+/* The columns of args from option i on, as price_fn_t takes them */
+#define LATENCY_COLUMNS(a, i)                                \
+  &(a)->sptPrice  [i], &(a)->strike    [i], &(a)->rate[i],   \
+  &(a)->volatility[i], &(a)->otime     [i], &(a)->otype[i],  \
+  &(a)->output    [i]
+
+void* impl_latency_scalar(void* args)
+{
+  args_t*    parsed_args = (args_t*)args;
+  latency_t* lat         = parsed_args->latency;
+
+  size_t     n           = parsed_args->num_stocks;
+  size_t     batch       = lat->batch;
+  size_t     full        = n - n % batch;
+
+  for (size_t i = 0; i < full; i += batch) {
+    uint64_t t0 = latency_stamp();
+    price_scalar(batch, LATENCY_COLUMNS(parsed_args, i));
+    uint64_t t1 = latency_stamp();
+
+    latency_record(lat, LATENCY_SCALAR, t0, t1);
+  }
+
+  if (full < n) price_scalar(n - full, LATENCY_COLUMNS(parsed_args, full));
+
+  /* Done */
+  return NULL;
+}
+
+void* impl_latency_vector(void* args)
+{
+  args_t*    parsed_args = (args_t*)args;
+  latency_t* lat         = parsed_args->latency;
+
+  size_t     n           = parsed_args->num_stocks;
+  size_t     batch       = lat->batch;
+  size_t     full        = n - n % batch;
+
+  /* Resolved once, as a caller of the typed API would */
+  price_fn_t price       = price_select();
+
+  for (size_t i = 0; i < full; i += batch) {
+    uint64_t t0 = latency_stamp();
+    price(batch, LATENCY_COLUMNS(parsed_args, i));
+    uint64_t t1 = latency_stamp();
+
+    latency_record(lat, LATENCY_VECTOR, t0, t1);
+  }
+
+  if (full < n) price(n - full, LATENCY_COLUMNS(parsed_args, full));
+
+  /* Done */
+  return NULL;
+}
+
+/* One call of the void* path: a fresh args_t over options [i, i + count) */
+static inline void latency_parallel_call(const args_t* args, size_t i, size_t count)
+{
+  args_t call = *args;
+
+  call.num_stocks = count;
+  call.sptPrice   = args->sptPrice   + i;
+  call.strike     = args->strike     + i;
+  call.rate       = args->rate       + i;
+  call.volatility = args->volatility + i;
+  call.otime      = args->otime      + i;
+  call.otype      = args->otype      + i;
+  call.output     = args->output     + i;
+  call.latency    = NULL;
+
+  impl_parallel(&call);
+}
+
+void* impl_latency_parallel(void* args)
+{
+  args_t*    parsed_args = (args_t*)args;
+  latency_t* lat         = parsed_args->latency;
+
+  size_t     n           = parsed_args->num_stocks;
+  size_t     batch       = lat->batch;
+  size_t     full        = n - n % batch;
+
+  for (size_t i = 0; i < full; i += batch) {
+    uint64_t t0 = latency_stamp();
+    latency_parallel_call(parsed_args, i, batch);
+    uint64_t t1 = latency_stamp();
+
+    latency_record(lat, LATENCY_PARALLEL, t0, t1);
+  }
+
+  if (full < n) latency_parallel_call(parsed_args, full, n - full);
+
+  /* Done */
+  return NULL;
+}
+
+static int latency_cmp(const void* a, const void* b)
+{
+  double x = *(const double*)a;
+  double y = *(const double*)b;
+
+  return (x > y) - (x < y);
+}
+
+bool latency_stats(const uint64_t* samples, uint32_t n, double ticks_ns,
+                   latency_stats_t* s)
+{
+  if (n == 0) return false;
+
+  double* v = (double*)malloc(n * sizeof(double));
+  if (v == NULL) return false;
+
+  double sum = 0.0;
+  for (uint32_t i = 0; i < n; i++) {
+    v[i] = samples[i] / ticks_ns;
+    sum += v[i];
+  }
+  qsort(v, n, sizeof(double), latency_cmp);
+
+  s->n    = n;
+  s->min  = v[0];
+  s->p50  = stats_percentile(v, n, 50.0);
+  s->p90  = stats_percentile(v, n, 90.0);
+  s->p99  = stats_percentile(v, n, 99.0);
+  s->p999 = stats_percentile(v, n, 99.9);
+  s->max  = v[n - 1];
+  s->mean = sum / n;
+
+  free(v);
+  return true;
+}
+
+void latency_print(const latency_t* lat, const char* indent)
+{
+  latency_stats_t s;
+  if (lat->last < 0) return;
+  if (!latency_stats(lat->samples[lat->last], lat->nsamples[lat->last], lat->ticks_ns, &s)) return;
+
+  printf("%s* Latency per call (batch of %zu through %s, %u calls):\n",
+         indent, lat->batch, latency_paths[lat->last], s.n);
+  printf("%s  - min    = %.1f ns\n", indent, s.min);
+  printf("%s  - p50    = %.1f ns (%.2f ns per option)\n", indent, s.p50, s.p50 / lat->batch);
+  printf("%s  - p90    = %.1f ns\n", indent, s.p90);
+  printf("%s  - p99    = %.1f ns\n", indent, s.p99);
+  printf("%s  - p99.9  = %.1f ns\n", indent, s.p999);
+  printf("%s  - max    = %.1f ns\n", indent, s.max);
+  printf("%s  - mean   = %.1f ns\n", indent, s.mean);
+  printf("%s  - timer  = %.1f ns per call, subtracted\n", indent, lat->overhead / lat->ticks_ns);
+}
+
+void latency_dump(const latency_t* lat, FILE* fp)
+{
+  latency_stats_t s;
+  if (lat->last < 0) return;
+  if (!latency_stats(lat->samples[lat->last], lat->nsamples[lat->last], lat->ticks_ns, &s)) return;
+
+  fprintf(fp, "\nlatency_batch,%zu", lat->batch);
+  fprintf(fp, "\nlatency_calls,%u", s.n);
+  fprintf(fp, "\nlatency_min,%.3f", s.min);
+  fprintf(fp, "\nlatency_p50,%.3f", s.p50);
+  fprintf(fp, "\nlatency_p90,%.3f", s.p90);
+  fprintf(fp, "\nlatency_p99,%.3f", s.p99);
+  fprintf(fp, "\nlatency_p99.9,%.3f", s.p999);
+  fprintf(fp, "\nlatency_max,%.3f", s.max);
+  fprintf(fp, "\nlatency_mean,%.3f", s.mean);
+  fprintf(fp, "\nlatency_timer,%.3f", lat->overhead / lat->ticks_ns);
+}
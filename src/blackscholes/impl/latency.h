@@ -0,0 +1,86 @@
+/* latency.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the latency mode (--latency). Instead of pricing the whole
+ * dataset in one call, each invocation walks it in consecutive batches
+ * of a few options, one call per batch, each call timed on its own:
+ * rdtscp fenced with lfence on x86 (the TSC), the virtual counter
+ * behind an isb on aarch64, the monotonic clock elsewhere. The cost of
+ * an empty stamp pair is measured once and subtracted. A trailing
+ * partial batch is priced untimed.
+ *
+ *   impl_latency_scalar    price_scalar (impl/price.h), inlined
+ *   impl_latency_vector    the typed variant from price_select()
+ *   impl_latency_parallel  impl_parallel on an args_t built per call;
+ *                          argument setup and the fork/join included
+ *
+ * Samples are kept per implementation, of the timed runs of the case
+ * only (latency_timed), up to LATENCY_MAX_SAMPLES each; calls past that,
+ * and those of the warm-up and the verification, still run, unrecorded.
+ * The report is of the implementation that ran last, which is the one
+ * the driver just verified.
+ */
+
+#ifndef __IMPL_LATENCY_H_
+#define __IMPL_LATENCY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/* Batch sizes of --latency without a list, and the most in one list */
+#define LATENCY_DEFAULT_BATCHES "1,8,64"
+#define LATENCY_MAX_BATCHES     16
+
+#define LATENCY_MAX_SAMPLES     (1u << 20)
+
+typedef enum {
+  LATENCY_SCALAR = 0,
+  LATENCY_VECTOR,
+  LATENCY_PARALLEL,
+  LATENCY_NUM
+} latency_kind_t;
+
+typedef struct latency_t {
+  size_t    batch;                   /* Options per call          */
+  double    ticks_ns;                /* Timer ticks per ns        */
+  uint64_t  overhead;                /* Ticks of an empty pair    */
+
+  uint64_t* samples [LATENCY_NUM];   /* Ticks per call, overhead
+                                      * subtracted                */
+  uint32_t  nsamples[LATENCY_NUM];
+  bool      recording;               /* Within the timed runs     */
+  int       last;                    /* latency_kind_t, or -1     */
+} latency_t;
+
+/* Distribution of n samples of ticks, in ns */
+typedef struct {
+  uint32_t n;
+  double   min, p50, p90, p99, p999, max, mean;
+} latency_stats_t;
+
+bool  latency_stats  (const uint64_t* samples, uint32_t n, double ticks_ns,
+                      latency_stats_t* s);  /* false if n is 0 */
+
+/* Allocate the sample buffers and calibrate the timer; 0 on success */
+int   latency_init   (latency_t* lat, size_t batch);
+void  latency_destroy(latency_t* lat);
+
+/* Start (on = true, dropping what was recorded) or stop recording; for
+ * driver_bench_t.timed */
+void  latency_timed  (latency_t* lat, bool on);
+
+/* Per-call distribution of the last implementation that ran, and the
+ * same as CSV rows (latency_<stat>,ns) */
+void  latency_print  (const latency_t* lat, const char* indent);
+void  latency_dump   (const latency_t* lat, FILE* fp);
+
+/* Implementations; args->latency must be set */
+void* impl_latency_scalar  (void* args);
+void* impl_latency_vector  (void* args);
+void* impl_latency_parallel(void* args);
+
+#endif //__IMPL_LATENCY_H_
@@ -8,16 +8,186 @@
 
 /* Standard C includes */
 #include <stdlib.h>
+#include <string.h>
 
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
+#include "common/pool.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "impl/vec.h"
+#include "impl/para.h"
+
+/* AoSoA chunks must start on a block */
+_Static_assert(PARA_CHUNK_ALIGN % AOSOA_BLOCK == 0,
+               "chunks must be whole AoSoA blocks");
+
+/* Chunk of options owned by thread tid; chunks start on a cache line */
+static args_t para_chunk(const args_t* args, int tid, int nthreads)
+{
+  size_t begin, end;
+  pool_partition(args->num_stocks, PARA_CHUNK_ALIGN, tid, nthreads,
+                 &begin, &end);
+
+  args_t chunk = *args;
+
+  chunk.num_stocks = end - begin;
+
+  chunk.sptPrice   = args->sptPrice   + begin;
+  chunk.strike     = args->strike     + begin;
+  chunk.rate       = args->rate       + begin;
+  chunk.volatility = args->volatility + begin;
+  chunk.otime      = args->otime      + begin;
+  chunk.otype      = args->otype      + begin;
+  chunk.output     = args->output     + begin;
+
+  if (args->delta != NULL) {
+    chunk.delta    = args->delta      + begin;
+    chunk.gamma    = args->gamma      + begin;
+    chunk.vega     = args->vega       + begin;
+    chunk.theta    = args->theta      + begin;
+    chunk.rho      = args->rho        + begin;
+  }
+
+  if (args->market != NULL) {
+    chunk.market   = args->market     + begin;
+  }
+
+  if (args->aos != NULL) {
+    chunk.aos      = args->aos        + begin;
+  }
+
+  if (args->aosoa != NULL) {
+    chunk.aosoa    = args->aosoa      + begin / AOSOA_BLOCK;
+  }
+
+  if (args->pd.sptPrice != NULL) {
+    chunk.pd.sptPrice   = args->pd.sptPrice   + begin;
+    chunk.pd.strike     = args->pd.strike     + begin;
+    chunk.pd.rate       = args->pd.rate       + begin;
+    chunk.pd.volatility = args->pd.volatility + begin;
+    chunk.pd.otime      = args->pd.otime      + begin;
+    chunk.pd.output     = args->pd.output     + begin;
+  }
+
+  return chunk;
+}
+
+/* Chunked task handed to every thread by para_for_chunks */
+typedef struct {
+  args_t*         args;
+  para_chunk_fn_t fn;
+} para_task_t;
+
+static void chunk_worker(int tid, int nthreads, void* args)
+{
+  para_task_t* task  = (para_task_t*)args;
+  args_t       chunk = para_chunk(task->args, tid, nthreads);
+
+  if (chunk.num_stocks > 0) {
+    task->fn(&chunk, (size_t)(chunk.output - task->args->output));
+  }
+}
+
+static void first_touch_chunk(void* args, size_t begin)
+{
+  args_t* chunk = (args_t*)args;
+
+  memset(chunk->output, 0, chunk->num_stocks * sizeof(float));
+
+  if (chunk->pd.output != NULL) {
+    memset(chunk->pd.output, 0, chunk->num_stocks * sizeof(double));
+  }
+
+  if (chunk->delta != NULL) {
+    memset(chunk->delta, 0, chunk->num_stocks * sizeof(float));
+    memset(chunk->gamma, 0, chunk->num_stocks * sizeof(float));
+    memset(chunk->vega , 0, chunk->num_stocks * sizeof(float));
+    memset(chunk->theta, 0, chunk->num_stocks * sizeof(float));
+    memset(chunk->rho  , 0, chunk->num_stocks * sizeof(float));
+  }
+}
+
+/* Kernel run by every thread of impl_parallel* */
+typedef struct {
+  args_t*   args;
+  void*   (*kernel)(void* args);
+} para_run_t;
+
+static void worker(int tid, int nthreads, void* args)
+{
+  para_run_t* run   = (para_run_t*)args;
+  args_t      chunk = para_chunk(run->args, tid, nthreads);
+
+  /* Each pinned thread runs the vectorized kernel on its own chunk */
+  if (chunk.num_stocks > 0) {
+    run->kernel(&chunk);
+  }
+}
+
+static void para_run(args_t* args, void* (*kernel)(void* args))
+{
+  para_run_t run = { args, kernel };
+
+  /* Dispatch into the worker pool */
+  pool_run(args->pool, args->nthreads, worker, &run);
+}
+
+void para_for_chunks(void* args, para_chunk_fn_t fn)
+{
+  args_t*     p_args = (args_t*)args;
+  para_task_t task   = { p_args, fn };
+
+  pool_run(p_args->pool, p_args->nthreads, chunk_worker, &task);
+}
+
+void para_first_touch(void* args)
+{
+  para_for_chunks(args, first_touch_chunk);
+}
 
 /* Alternative Implementation */
 void* impl_parallel(void* args)
 {
+  para_run((args_t*)args, impl_vector);
+
+  /* Done */
+  return NULL;
+}
+
+void* impl_parallel_pd(void* args)
+{
+  para_run((args_t*)args, impl_vector_pd);
+
+  return NULL;
+}
+
+void* impl_parallel_mixed(void* args)
+{
+  para_run((args_t*)args, impl_vector_mixed);
+
+  return NULL;
+}
+
+void* impl_parallel_aos(void* args)
+{
+  para_run((args_t*)args, impl_vector_aos);
+
+  return NULL;
+}
+
+void* impl_parallel_aosoa(void* args)
+{
+  para_run((args_t*)args, impl_vector_aosoa);
+
+  return NULL;
+}
+
+void* impl_parallel_iv(void* args)
+{
+  para_run((args_t*)args, impl_vector_iv);
+
   return NULL;
 }
@@ -9,7 +9,35 @@
 #ifndef __IMPL_PARA_H_
 #define __IMPL_PARA_H_
 
+#include <stddef.h>
+
+/* Per-thread chunks are multiples of one cache line of floats, so no two
+ * threads ever write the same line of the output */
+#define PARA_CHUNK_ALIGN (64 / sizeof(float))
+
 /* Function declaration */
 void* impl_parallel(void* args);
 
+/* The same over impl_vector_pd and impl_vector_mixed (impl/vec.h) */
+void* impl_parallel_pd   (void* args);
+void* impl_parallel_mixed(void* args);
+
+/* ... and over impl_vector_aos and impl_vector_aosoa; chunk boundaries
+ * are multiples of PARA_CHUNK_ALIGN, hence of AOSOA_BLOCK */
+void* impl_parallel_aos  (void* args);
+void* impl_parallel_aosoa(void* args);
+
+/* ... and over impl_vector_iv */
+void* impl_parallel_iv   (void* args);
+
+/* Run fn on every thread's chunk (an args_t of its options, starting at
+ * option begin) with the same partition as impl_parallel, so whatever fn
+ * writes first lands on the NUMA node of the thread that prices it */
+typedef void (*para_chunk_fn_t)(void* chunk, size_t begin);
+
+void  para_for_chunks (void* args, para_chunk_fn_t fn);
+
+/* Zero the output (and the Greeks, if set) with that partition */
+void  para_first_touch(void* args);
+
 #endif //__IMPL_PARA_H_
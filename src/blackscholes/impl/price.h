@@ -0,0 +1,151 @@
+/* price.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Typed single-batch pricing API, for callers that price one option or
+ * a small basket at a time (a quoting service) and cannot amortize an
+ * args_t and a void* entry point over a whole dataset: columns in,
+ * prices out, no Greeks.
+ *
+ *   price_scalar        inlined into the caller
+ *   price_select()      the widest vectorized variant the host supports
+ *                       (within --isa), resolved once by the caller and
+ *                       then called directly
+ *
+ * Every variant prices exactly like impl_vector on the same options.
+ * Each keeps compiled copies of its loop for the sizes of
+ * PRICE_SPECIALIZE, which impl_vector also goes through when it prices
+ * only.
+ */
+
+#ifndef __IMPL_PRICE_H_
+#define __IMPL_PRICE_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <math.h>
+
+#define PRICE_INLINE static inline __attribute__((always_inline))
+
+/* Price options [0, n) of the columns into output */
+typedef void (*price_fn_t)(size_t n,
+                           const float* sptPrice  , const float* strike    ,
+                           const float* rate      , const float* volatility,
+                           const float* otime     , const char * otype     ,
+                           float*       output);
+
+/* Per-ISA variants, in vec.<isa>.c (and vec.c) */
+void       price_vector_scalar(size_t n,
+                               const float* sptPrice  , const float* strike    ,
+                               const float* rate      , const float* volatility,
+                               const float* otime     , const char * otype     ,
+                               float*       output);
+void       price_vector_avx2  (size_t n,
+                               const float* sptPrice  , const float* strike    ,
+                               const float* rate      , const float* volatility,
+                               const float* otime     , const char * otype     ,
+                               float*       output);
+void       price_vector_avx512(size_t n,
+                               const float* sptPrice  , const float* strike    ,
+                               const float* rate      , const float* volatility,
+                               const float* otime     , const char * otype     ,
+                               float*       output);
+void       price_vector_neon  (size_t n,
+                               const float* sptPrice  , const float* strike    ,
+                               const float* rate      , const float* volatility,
+                               const float* otime     , const char * otype     ,
+                               float*       output);
+void       price_vector_sve   (size_t n,
+                               const float* sptPrice  , const float* strike    ,
+                               const float* rate      , const float* volatility,
+                               const float* otime     , const char * otype     ,
+                               float*       output);
+
+/* The widest enabled variant; cheap, but meant to be called once */
+price_fn_t price_select(void);
+
+/* false (--generic) sends every size to the generic loop, to measure
+ * what the specialization saves */
+extern bool price_sized;
+
+/* Call fn(n, ...) with n a constant when it is one of the sizes below,
+ * so the kernel is compiled again for it: fully unrolled when small, no
+ * tail when a whole number of vectors. The list is the test (4), dev
+ * (23) and small (4000) datasets and the --latency batches (1, 8, 64);
+ * any other n runs the generic loop. */
+#define PRICE_SPECIALIZE(n, fn, ...)                                    \
+  do {                                                                  \
+    size_t __n = (n);                                                   \
+                                                                        \
+    if      (!price_sized) fn(__n , __VA_ARGS__);                       \
+    else if (__n ==    1)  fn(   1, __VA_ARGS__);                       \
+    else if (__n ==    4)  fn(   4, __VA_ARGS__);                       \
+    else if (__n ==    8)  fn(   8, __VA_ARGS__);                       \
+    else if (__n ==   16)  fn(  16, __VA_ARGS__);                       \
+    else if (__n ==   23)  fn(  23, __VA_ARGS__);                       \
+    else if (__n ==   64)  fn(  64, __VA_ARGS__);                       \
+    else if (__n == 4000)  fn(4000, __VA_ARGS__);                       \
+    else                   fn(__n , __VA_ARGS__);                       \
+  } while (0)
+
+/* Cumulative normal distribution; the same polynomial as _mm256_cndf_ps.
+ * The normal density N'(x) comes out through pdf. */
+PRICE_INLINE float price_cndf(float x, float* pdf)
+{
+  int   sign = x < 0.0f;
+  float ax   = fabsf(x);
+
+  float npx  = expf(-0.5f * ax * ax) * 0.39894228040143270286f;
+  *pdf = npx;
+  float k    = 1.0f / (1.0f + 0.2316419f * ax);
+
+  float y    = 1.330274429f;
+  y = y * k - 1.821255978f;
+  y = y * k + 1.781477937f;
+  y = y * k - 0.356563782f;
+  y = y * k + 0.319381530f;
+  y = y * k;
+
+  y = 1.0f - y * npx;
+
+  return sign ? 1.0f - y : y;
+}
+
+/* Price of one option, as impl_vector_scalar; and its vega, if not NULL */
+PRICE_INLINE float price_one(float sptPrice, float strike, float rate,
+                             float volatility, float otime, char otype,
+                             float* vega)
+{
+  float sqrt_t = sqrtf(otime);
+  float den    = volatility * sqrt_t;
+
+  float d1 = (logf(sptPrice / strike) +
+              (rate + 0.5f * volatility * volatility) * otime) / den;
+  float d2 = d1 - den;
+
+  float pdf;
+  float n_d1 = price_cndf(d1, &pdf);
+  if (vega != NULL) *vega = sptPrice * pdf * sqrt_t;
+  float n_d2 = price_cndf(d2, &pdf);
+
+  float fv = strike * expf(-rate * otime);
+
+  return (otype == 'P') ? fv * (1.0f - n_d2) - sptPrice * (1.0f - n_d1)
+                        : sptPrice * n_d1 - fv * n_d2;
+}
+
+/* Inlined batch */
+PRICE_INLINE void price_scalar(size_t n,
+                               const float* sptPrice  , const float* strike    ,
+                               const float* rate      , const float* volatility,
+                               const float* otime     , const char * otype     ,
+                               float*       output)
+{
+  for (size_t i = 0; i < n; i++) {
+    output[i] = price_one(sptPrice[i], strike[i], rate[i], volatility[i],
+                          otime[i], otype[i], NULL);
+  }
+}
+
+#endif //__IMPL_PRICE_H_
@@ -15,9 +15,33 @@
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "impl/vec.h"
+#include "impl/price.h"
 
 /* Naive Implementation */
 void* impl_scalar(void* args)
 {
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* The Greeks, the double precision, the layouts and the solver come
+   * from the portable kernels of impl_vector, which are scalar code too */
+  if (parsed_args->delta     != NULL) return impl_vector_scalar      (args);
+  if (parsed_args->pd.output != NULL) return impl_vector_pd_scalar   (args);
+  if (parsed_args->aos       != NULL) return impl_vector_aos_scalar  (args);
+  if (parsed_args->aosoa     != NULL) return impl_vector_aosoa_scalar(args);
+  if (parsed_args->market    != NULL) return impl_vector_iv_scalar   (args);
+
+  /* One option at a time */
+  for (size_t i = 0; i < parsed_args->num_stocks; i++) {
+    parsed_args->output[i] = price_one(parsed_args->sptPrice  [i],
+                                       parsed_args->strike    [i],
+                                       parsed_args->rate      [i],
+                                       parsed_args->volatility[i],
+                                       parsed_args->otime     [i],
+                                       parsed_args->otype     [i], NULL);
+  }
+
+  /* Done */
   return NULL;
 }
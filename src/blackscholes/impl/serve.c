@@ -0,0 +1,457 @@
+/* serve.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the request-queue service mode; see serve.h.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <sched.h>
+#include <time.h>
+#if defined(__amd64__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/cpu.h"
+#include "common/pool.h"
+#include "common/mpmc.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/price.h"
+#include "impl/latency.h"
+#include "impl/serve.h"
+
+/* Spins before a waiting thread starts yielding its CPU */
+#define SERVE_SPIN_LIMIT 1024
+
+static const char* serve_paths[SERVE_NUM] = {
+  "price_scalar", "price_select()", "price_select()"
+};
+
+/* One invocation */
+typedef struct {
+  serve_t*      sv;
+  const args_t* args;
+  serve_kind_t  kind;
+  price_fn_t    price;
+  size_t        width;         /* Options per vector of price         */
+  bool          record;        /* Keep its latencies and rate         */
+
+  size_t        n;             /* Requests                            */
+  int           producers;
+  int           consumers;
+  uint64_t      t0;            /* ns; request k is due at t0 + k * period */
+  double        period;        /* ns between requests; 0 = unpaced    */
+
+  _Alignas(64) atomic_size_t priced;
+  atomic_uint_least64_t      finish;
+} serve_run_t;
+
+static inline uint64_t serve_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline void serve_pause(int* spins)
+{
+  if (++*spins >= SERVE_SPIN_LIMIT) {
+    sched_yield();
+  } else {
+#if defined(__amd64__) || defined(__x86_64__)
+    _mm_pause();
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+    __asm__ __volatile__ ("yield");
+#endif
+  }
+}
+
+/* Options per vector of the variant price_select() picked */
+static size_t serve_width(serve_kind_t kind)
+{
+  if (kind == SERVE_SCALAR) return 1;
+
+  switch (cpu_active_isa()) {
+    case CPU_ISA_AVX512: return 16;
+    case CPU_ISA_AVX2  : return  8;
+    case CPU_ISA_SSE42 :
+    case CPU_ISA_NEON  :
+    case CPU_ISA_SVE   : return  4;
+    default            : return  1;
+  }
+}
+
+int serve_init(serve_t* sv, double rate, int producers, size_t batch,
+               int nthreads)
+{
+  memset(sv, 0, sizeof(*sv));
+  sv->rate      = rate;
+  sv->producers = producers;
+  sv->batch     = batch;
+  sv->last      = -1;
+
+  if (nthreads < 1) nthreads = 1;
+  sv->nlanes = nthreads;
+
+  sv->queues = (mpmc_t      *)calloc(nthreads, sizeof(mpmc_t));
+  sv->lanes  = (serve_lane_t*)calloc(nthreads, sizeof(serve_lane_t));
+  if (sv->queues == NULL || sv->lanes == NULL) {
+    serve_destroy(sv);
+    return -1;
+  }
+
+  for (int c = 0; c < nthreads; c++) {
+    serve_lane_t* lane = &sv->lanes[c];
+
+    if (mpmc_init(&sv->queues[c], SERVE_QUEUE_DEPTH) != 0) {
+      serve_destroy(sv);
+      return -1;
+    }
+
+    lane->sptPrice   = __ALLOC_DATA(float   , batch);
+    lane->strike     = __ALLOC_DATA(float   , batch);
+    lane->rate       = __ALLOC_DATA(float   , batch);
+    lane->volatility = __ALLOC_DATA(float   , batch);
+    lane->otime      = __ALLOC_DATA(float   , batch);
+    lane->otype      = __ALLOC_DATA(char    , batch);
+    lane->output     = __ALLOC_DATA(float   , batch);
+    lane->id         = __ALLOC_DATA(uint64_t, batch);
+    lane->due        = __ALLOC_DATA(uint64_t, batch);
+  }
+
+  for (int k = 0; k < SERVE_NUM; k++) {
+    sv->samples[k] = (uint64_t*)malloc(SERVE_MAX_SAMPLES * sizeof(uint64_t));
+    if (sv->samples[k] == NULL) {
+      serve_destroy(sv);
+      return -1;
+    }
+    atomic_init(&sv->nsamples[k], 0);
+    atomic_init(&sv->batches [k], 0);
+  }
+
+  return 0;
+}
+
+void serve_destroy(serve_t* sv)
+{
+  for (int c = 0; c < sv->nlanes; c++) {
+    if (sv->queues != NULL) mpmc_destroy(&sv->queues[c]);
+
+    if (sv->lanes != NULL) {
+      serve_lane_t* lane = &sv->lanes[c];
+
+      __FREE_DATA(lane->sptPrice);
+      __FREE_DATA(lane->strike);
+      __FREE_DATA(lane->rate);
+      __FREE_DATA(lane->volatility);
+      __FREE_DATA(lane->otime);
+      __FREE_DATA(lane->otype);
+      __FREE_DATA(lane->output);
+      __FREE_DATA(lane->id);
+      __FREE_DATA(lane->due);
+    }
+  }
+
+  free(sv->queues); sv->queues = NULL;
+  free(sv->lanes ); sv->lanes  = NULL;
+  sv->nlanes = 0;
+
+  for (int k = 0; k < SERVE_NUM; k++) {
+    free(sv->samples[k]);
+    sv->samples[k] = NULL;
+  }
+}
+
+/* Issue request k, which is due now or earlier; false if its queue is
+ * full */
+static inline bool serve_issue(serve_run_t* run, size_t k)
+{
+  mpmc_item_t item;
+
+  item.id    = k;
+  item.stamp = (run->period > 0.0) ? run->t0 + (uint64_t)(k * run->period)
+                                   : serve_now();
+
+  return mpmc_push(&run->sv->queues[k % run->consumers], item);
+}
+
+static void serve_produce(serve_run_t* run, int pid)
+{
+  for (size_t k = pid; k < run->n; k += run->producers) {
+    int spins = 0;
+
+    /* Open loop: wait for the due time, never for the service */
+    if (run->period > 0.0) {
+      uint64_t due = run->t0 + (uint64_t)(k * run->period);
+      while (serve_now() < due) serve_pause(&spins);
+    }
+
+    while (!serve_issue(run, k)) serve_pause(&spins);
+  }
+}
+
+/* Drain one batch from queue q into lane c, price it and scatter the
+ * prices; returns the requests priced */
+static size_t serve_consume(serve_run_t* run, int c, int q)
+{
+  serve_t*      sv   = run->sv;
+  serve_lane_t* lane = &sv->lanes[c];
+  const args_t* args = run->args;
+
+  /* All that is queued, in whole vectors while there are any */
+  size_t want = mpmc_depth(&sv->queues[q]);
+  if (want > sv->batch ) want = sv->batch;
+  if (want > run->width) want -= want % run->width;
+  if (want == 0) return 0;
+
+  size_t m = 0;
+  for (mpmc_item_t item; m < want && mpmc_pop(&sv->queues[q], &item); m++) {
+    size_t id = (size_t)item.id;
+
+    lane->id        [m] = item.id;
+    lane->due       [m] = item.stamp;
+    lane->sptPrice  [m] = args->sptPrice  [id];
+    lane->strike    [m] = args->strike    [id];
+    lane->rate      [m] = args->rate      [id];
+    lane->volatility[m] = args->volatility[id];
+    lane->otime     [m] = args->otime     [id];
+    lane->otype     [m] = args->otype     [id];
+  }
+  if (m == 0) return 0;
+
+  run->price(m, lane->sptPrice, lane->strike, lane->rate, lane->volatility,
+             lane->otime, lane->otype, lane->output);
+
+  for (size_t i = 0; i < m; i++) {
+    args->output[lane->id[i]] = lane->output[i];
+  }
+
+  /* Every request of the batch completes with it */
+  uint64_t done = serve_now();
+
+  if (run->record) {
+    unsigned base = atomic_fetch_add_explicit(&sv->nsamples[run->kind], (unsigned)m,
+                                              memory_order_relaxed);
+
+    for (size_t i = 0; i < m && base + i < SERVE_MAX_SAMPLES; i++) {
+      sv->samples[run->kind][base + i] = (done > lane->due[i]) ? done - lane->due[i] : 0;
+    }
+
+    atomic_fetch_add_explicit(&sv->batches[run->kind], 1, memory_order_relaxed);
+  }
+
+  if (atomic_fetch_add_explicit(&run->priced, m, memory_order_acq_rel) + m == run->n) {
+    atomic_store_explicit(&run->finish, done, memory_order_relaxed);
+  }
+
+  return m;
+}
+
+static void serve_drain(serve_run_t* run, int c)
+{
+  int spins = 0;
+
+  while (atomic_load_explicit(&run->priced, memory_order_acquire) < run->n) {
+    /* Our own queue first, then steal from the others */
+    size_t got = 0;
+    for (int j = 0; j < run->consumers && got == 0; j++) {
+      got = serve_consume(run, c, (c + j) % run->consumers);
+    }
+
+    if (got == 0) serve_pause(&spins);
+    else          spins = 0;
+  }
+}
+
+static void serve_worker(int tid, int nthreads, void* args)
+{
+  serve_run_t* run = (serve_run_t*)args;
+
+  if (tid < run->producers) serve_produce(run, tid);
+  else                      serve_drain  (run, tid - run->producers);
+}
+
+/* One thread does both: issue what is due, then price a batch */
+static void serve_alone(serve_run_t* run)
+{
+  serve_t* sv    = run->sv;
+  size_t   next  = 0;
+  int      spins = 0;
+
+  while (atomic_load_explicit(&run->priced, memory_order_relaxed) < run->n) {
+    uint64_t now   = serve_now();
+    size_t   limit = next + sv->batch;
+
+    while (next < run->n && next < limit &&
+           (run->period <= 0.0 || run->t0 + (uint64_t)(next * run->period) <= now) &&
+           serve_issue(run, next)) {
+      next++;
+    }
+
+    if (serve_consume(run, 0, 0) == 0) serve_pause(&spins);
+    else                               spins = 0;
+  }
+}
+
+void serve_timed(serve_t* sv, bool on)
+{
+  sv->recording = on;
+}
+
+static void serve_run(args_t* args, serve_kind_t kind)
+{
+  serve_t*    sv  = args->serve;
+  serve_run_t run;
+
+  memset(&run, 0, sizeof(run));
+  run.sv        = sv;
+  run.args      = args;
+  run.kind      = kind;
+  run.price     = (kind == SERVE_SCALAR) ? price_scalar : price_select();
+  run.width     = serve_width(kind);
+  run.record    = sv->recording;
+  run.n         = args->num_stocks;
+  run.producers = sv->producers;
+  run.period    = (sv->rate > 0.0) ? 1e9 / sv->rate : 0.0;
+  atomic_init(&run.priced, 0);
+  atomic_init(&run.finish, 0);
+
+  sv->last = kind;
+
+  /* Latencies, rate and batches all describe the last timed invocation,
+   * so no sample cap skews one against the others; the warm-up and the
+   * verification leave them as they are */
+  if (run.record) {
+    atomic_store(&sv->nsamples[kind], 0);
+    atomic_store(&sv->batches [kind], 0);
+  }
+
+  /* pool_run gives no more threads than the pool has */
+  int nthreads = args->nthreads;
+  if (args->pool == NULL) nthreads = 1;
+  else if (nthreads > args->pool->nthreads) nthreads = args->pool->nthreads;
+  if (nthreads > sv->nlanes) nthreads = sv->nlanes;
+
+  if (nthreads <= run.producers) {
+    run.producers = 1;
+    run.consumers = 1;
+    run.t0        = serve_now();
+    serve_alone(&run);
+  } else {
+    run.consumers = (kind == SERVE_PARALLEL) ? nthreads - run.producers : 1;
+    run.t0        = serve_now();
+    pool_run(args->pool, run.producers + run.consumers, serve_worker, &run);
+  }
+
+  if (run.record) {
+    sv->consumers[kind] = run.consumers;
+    sv->served   [kind] = run.n;
+    sv->elapsed  [kind] = (double)(atomic_load(&run.finish) - run.t0);
+  }
+}
+
+void* impl_serve_scalar(void* args)
+{
+  serve_run((args_t*)args, SERVE_SCALAR);
+
+  /* Done */
+  return NULL;
+}
+
+void* impl_serve_vector(void* args)
+{
+  serve_run((args_t*)args, SERVE_VECTOR);
+
+  /* Done */
+  return NULL;
+}
+
+void* impl_serve_parallel(void* args)
+{
+  serve_run((args_t*)args, SERVE_PARALLEL);
+
+  /* Done */
+  return NULL;
+}
+
+/* Latencies of the last implementation, and the rate it sustained */
+static bool serve_stats(const serve_t* sv, latency_stats_t* s, double* achieved)
+{
+  if (sv->last < 0) return false;
+
+  unsigned n = atomic_load(&sv->nsamples[sv->last]);
+  if (n > SERVE_MAX_SAMPLES) n = SERVE_MAX_SAMPLES;
+
+  /* Samples are in ns already */
+  if (!latency_stats(sv->samples[sv->last], n, 1.0, s)) return false;
+
+  double elapsed = sv->elapsed[sv->last];
+  *achieved = (elapsed > 0.0) ? sv->served[sv->last] / (elapsed * 1e-9) : 0.0;
+
+  return true;
+}
+
+void serve_print(const serve_t* sv, const char* indent)
+{
+  latency_stats_t s;
+  double          achieved;
+  if (!serve_stats(sv, &s, &achieved)) return;
+
+  size_t batches = atomic_load(&sv->batches[sv->last]);
+
+  printf("%s* Service (%d producer(s), %d consumer(s) through %s):\n",
+         indent, sv->producers, sv->consumers[sv->last], serve_paths[sv->last]);
+  if (sv->rate > 0.0) {
+    printf("%s  - offered   = %.0f req/s\n", indent, sv->rate);
+  } else {
+    printf("%s  - offered   = unpaced\n", indent);
+  }
+  printf("%s  - sustained = %.0f req/s\n", indent, achieved);
+  printf("%s  - batch     = %.2f requests on average (at most %zu)\n", indent,
+         (batches > 0) ? (double)sv->served[sv->last] / batches : 0.0, sv->batch);
+  printf("%s* Latency per request, from due to priced (%u requests):\n", indent, s.n);
+  printf("%s  - min    = %.1f ns\n", indent, s.min);
+  printf("%s  - p50    = %.1f ns\n", indent, s.p50);
+  printf("%s  - p90    = %.1f ns\n", indent, s.p90);
+  printf("%s  - p99    = %.1f ns\n", indent, s.p99);
+  printf("%s  - p99.9  = %.1f ns\n", indent, s.p999);
+  printf("%s  - max    = %.1f ns\n", indent, s.max);
+  printf("%s  - mean   = %.1f ns\n", indent, s.mean);
+}
+
+void serve_dump(const serve_t* sv, FILE* fp)
+{
+  latency_stats_t s;
+  double          achieved;
+  if (!serve_stats(sv, &s, &achieved)) return;
+
+  size_t batches = atomic_load(&sv->batches[sv->last]);
+
+  fprintf(fp, "\nserve_rate,%.0f", sv->rate);
+  fprintf(fp, "\nserve_sustained,%.0f", achieved);
+  fprintf(fp, "\nserve_producers,%d", sv->producers);
+  fprintf(fp, "\nserve_consumers,%d", sv->consumers[sv->last]);
+  fprintf(fp, "\nserve_max_batch,%zu", sv->batch);
+  fprintf(fp, "\nserve_mean_batch,%.3f",
+          (batches > 0) ? (double)sv->served[sv->last] / batches : 0.0);
+  fprintf(fp, "\nserve_requests,%u", s.n);
+  fprintf(fp, "\nserve_min,%.3f", s.min);
+  fprintf(fp, "\nserve_p50,%.3f", s.p50);
+  fprintf(fp, "\nserve_p90,%.3f", s.p90);
+  fprintf(fp, "\nserve_p99,%.3f", s.p99);
+  fprintf(fp, "\nserve_p99.9,%.3f", s.p999);
+  fprintf(fp, "\nserve_max,%.3f", s.max);
+  fprintf(fp, "\nserve_mean,%.3f", s.mean);
+}
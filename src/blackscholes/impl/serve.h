@@ -0,0 +1,116 @@
+/* serve.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the request-queue service mode (--serve). Every option of
+ * the dataset becomes one pricing request. Producer threads issue them
+ * open loop, at a synthetic arrival rate: request k is due at
+ * t0 + k / rate no matter how far behind the service is, and its
+ * latency runs from that due time, not from when it was pushed, so a
+ * backlog is charged to the requests that waited (no coordinated
+ * omission). Requests go round-robin into one lock-free MPMC queue per
+ * consumer (common/mpmc.h). Each pinned consumer drains its own queue,
+ * or steals from the others when it is empty, in micro-batches: all
+ * that is queued, up to --serve-batch, rounded down to whole vectors.
+ * It gathers the options into columns, prices them through the typed
+ * API (impl/price.h) and scatters the prices back.
+ *
+ *   tid 0 .. P - 1   producers (--producers, default 1)
+ *   tid P ..         consumers
+ *
+ * impl_serve_scalar and impl_serve_vector run one consumer (the scalar
+ * and the vectorized kernel), impl_serve_parallel runs all the other
+ * threads. With a single thread, that thread alternates between issuing
+ * the requests that are due and draining a batch.
+ *
+ * One invocation serves the whole dataset. The requests per second it
+ * sustained and the latency of every request are kept per
+ * implementation for its last invocation among the timed runs
+ * (serve_timed), which is the one reported; the warm-up and the
+ * verification serve unrecorded. Latencies cover the first
+ * SERVE_MAX_SAMPLES requests of that invocation.
+ */
+
+#ifndef __IMPL_SERVE_H_
+#define __IMPL_SERVE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdatomic.h>
+
+#include "common/mpmc.h"
+
+/* Defaults: offered requests per second, producers and largest batch */
+#define SERVE_RATE        1e6
+#define SERVE_PRODUCERS   1
+#define SERVE_BATCH       64
+
+/* Requests each queue holds */
+#define SERVE_QUEUE_DEPTH 4096
+
+#define SERVE_MAX_SAMPLES (1u << 22)
+
+typedef enum {
+  SERVE_SCALAR = 0,
+  SERVE_VECTOR,
+  SERVE_PARALLEL,
+  SERVE_NUM
+} serve_kind_t;
+
+/* Gathered columns of one consumer's batch */
+typedef struct {
+  float*    sptPrice;
+  float*    strike;
+  float*    rate;
+  float*    volatility;
+  float*    otime;
+  char *    otype;
+  float*    output;
+  uint64_t* id;
+  uint64_t* due;
+} serve_lane_t;
+
+typedef struct serve_t {
+  /* Configuration */
+  double         rate;               /* Requests per second; 0 = unpaced */
+  int            producers;
+  size_t         batch;              /* Largest micro-batch              */
+
+  int            nlanes;             /* Queues and lanes, one per thread */
+  mpmc_t*        queues;
+  serve_lane_t*  lanes;
+
+  /* Per implementation, over its last timed invocation */
+  uint64_t*      samples [SERVE_NUM];  /* ns from due to priced       */
+  atomic_uint    nsamples[SERVE_NUM];
+  double         elapsed [SERVE_NUM];  /* ns from t0 to the last price */
+  size_t         served  [SERVE_NUM];
+  atomic_size_t  batches [SERVE_NUM];
+  int            consumers[SERVE_NUM];
+  int            last;                 /* serve_kind_t, or -1          */
+  bool           recording;            /* Within the timed runs        */
+} serve_t;
+
+/* Queues and lanes for up to nthreads threads; 0 on success */
+int   serve_init   (serve_t* sv, double rate, int producers, size_t batch,
+                    int nthreads);
+void  serve_destroy(serve_t* sv);
+
+/* Start (on = true) or stop recording invocations; for
+ * driver_bench_t.timed */
+void  serve_timed  (serve_t* sv, bool on);
+
+/* Throughput and latency of the last implementation that ran, and the
+ * same as CSV rows (serve_<stat>) */
+void  serve_print  (const serve_t* sv, const char* indent);
+void  serve_dump   (const serve_t* sv, FILE* fp);
+
+/* Implementations; args->serve must be set */
+void* impl_serve_scalar  (void* args);
+void* impl_serve_vector  (void* args);
+void* impl_serve_parallel(void* args);
+
+#endif //__IMPL_SERVE_H_
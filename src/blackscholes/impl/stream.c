@@ -0,0 +1,314 @@
+/* stream.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the streaming pipeline; see stream.h.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/pool.h"
+#include "common/check.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/scalar.h"
+#include "impl/vec.h"
+#include "impl/para.h"
+#include "impl/stream.h"
+
+/* Spins before a waiting stage starts yielding its CPU */
+#define STREAM_SPIN_LIMIT 1024
+
+/* Verification tolerance; matches the resident path */
+#define STREAM_DELTA 1e-4f
+
+/* One run of the pipeline */
+typedef struct {
+  stream_t*   st;
+  args_t*     args;          /* Template for the kernel's arguments */
+  void*     (*kernel)(void* args);
+  int         ncompute;      /* Compute threads (0: tid 0 does it all) */
+} stream_run_t;
+
+static void stream_wait(atomic_size_t* v, size_t want)
+{
+  for (int spins = 0;
+       atomic_load_explicit(v, memory_order_acquire) != want;
+       spins++) {
+    if (spins >= STREAM_SPIN_LIMIT) sched_yield();
+  }
+}
+
+int stream_open(stream_t* st, const char* path, const char* out_path,
+                size_t batch)
+{
+  memset(st, 0, sizeof(*st));
+  st->out_fd = -1;
+
+  uint64_t length;
+  st->fd = dsfile_open(path, &st->hdr, &length);
+  if (st->fd < 0) return -1;
+
+  st->count    = st->hdr.count;
+  st->batch    = batch > 0 ? batch : STREAM_BATCH;
+  st->nbatches = (st->count + st->batch - 1) / st->batch;
+
+  if (out_path != NULL) {
+    st->out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (st->out_fd < 0 ||
+        ftruncate(st->out_fd, (off_t)(st->count * sizeof(float))) != 0) {
+      printf("\n");
+      printf("ERROR: Cannot create \"%s\": %s\n", out_path, strerror(errno));
+      stream_close(st);
+      return -1;
+    }
+  }
+
+  for (int s = 0; s < 2; s++) {
+    stream_slot_t* slot = &st->slots[s];
+
+    slot->sptPrice   = __ALLOC_DATA(float, st->batch);
+    slot->strike     = __ALLOC_DATA(float, st->batch);
+    slot->rate       = __ALLOC_DATA(float, st->batch);
+    slot->volatility = __ALLOC_DATA(float, st->batch);
+    slot->otime      = __ALLOC_DATA(float, st->batch);
+    slot->otype      = __ALLOC_DATA(char , st->batch);
+    slot->ref        = __ALLOC_DATA(float, st->batch);
+    slot->output     = __ALLOC_DATA(float, st->batch);
+  }
+
+  return 0;
+}
+
+void stream_close(stream_t* st)
+{
+  for (int s = 0; s < 2; s++) {
+    stream_slot_t* slot = &st->slots[s];
+
+    __FREE_DATA(slot->sptPrice);
+    __FREE_DATA(slot->strike);
+    __FREE_DATA(slot->rate);
+    __FREE_DATA(slot->volatility);
+    __FREE_DATA(slot->otime);
+    __FREE_DATA(slot->otype);
+    __FREE_DATA(slot->ref);
+    __FREE_DATA(slot->output);
+  }
+
+  if (st->fd     >= 0) close(st->fd);
+  if (st->out_fd >= 0) close(st->out_fd);
+
+  memset(st, 0, sizeof(*st));
+  st->fd     = -1;
+  st->out_fd = -1;
+}
+
+static size_t stream_batch_size(const stream_t* st, size_t k)
+{
+  size_t first = k * st->batch;
+
+  return (st->count - first) < st->batch ? (st->count - first) : st->batch;
+}
+
+static int stream_pread(int fd, void* buf, size_t bytes, uint64_t at)
+{
+  return pread(fd, buf, bytes, (off_t)at) == (ssize_t)bytes ? 0 : -1;
+}
+
+/* Read batch k into its slot */
+static void stream_read(stream_t* st, size_t k)
+{
+  stream_slot_t*         slot  = &st->slots[k % 2];
+  const dsfile_header_t* hdr   = &st->hdr;
+  size_t                 n     = stream_batch_size(st, k);
+  uint64_t               first = (uint64_t)k * st->batch;
+
+  int err = 0;
+  err |= stream_pread(st->fd, slot->sptPrice  , n * sizeof(float), hdr->offset[DSFILE_SPTPRICE  ] + first * sizeof(float));
+  err |= stream_pread(st->fd, slot->strike    , n * sizeof(float), hdr->offset[DSFILE_STRIKE    ] + first * sizeof(float));
+  err |= stream_pread(st->fd, slot->rate      , n * sizeof(float), hdr->offset[DSFILE_RATE      ] + first * sizeof(float));
+  err |= stream_pread(st->fd, slot->volatility, n * sizeof(float), hdr->offset[DSFILE_VOLATILITY] + first * sizeof(float));
+  err |= stream_pread(st->fd, slot->otime     , n * sizeof(float), hdr->offset[DSFILE_OTIME     ] + first * sizeof(float));
+  err |= stream_pread(st->fd, slot->otype     , n * sizeof(char ), hdr->offset[DSFILE_OTYPE     ] + first * sizeof(char ));
+  err |= stream_pread(st->fd, slot->ref       , n * sizeof(float), hdr->offset[DSFILE_PRICE     ] + first * sizeof(float));
+
+  if (err) st->io_err = 1;
+}
+
+/* Check batch k against its reference prices and write it out */
+static void stream_write(stream_t* st, size_t k)
+{
+  stream_slot_t* slot  = &st->slots[k % 2];
+  size_t         n     = stream_batch_size(st, k);
+  uint64_t       first = (uint64_t)k * st->batch;
+
+  check_stats_t err;
+  check_floats(slot->ref, slot->output, n, STREAM_DELTA, &err);
+
+  if (err.mismatches > 0 && st->err.mismatches == 0) {
+    st->err.first_bad = first + err.first_bad;
+  }
+  st->err.mismatches += err.mismatches;
+  if (err.max_abs > st->err.max_abs) st->err.max_abs = err.max_abs;
+  if (err.max_rel > st->err.max_rel) st->err.max_rel = err.max_rel;
+
+  if (st->out_fd >= 0) {
+    size_t bytes = n * sizeof(float);
+    if (pwrite(st->out_fd, slot->output, bytes,
+               (off_t)(first * sizeof(float))) != (ssize_t)bytes) {
+      st->io_err = 1;
+    }
+  }
+}
+
+/* Price options [begin, end) of the batch in slot */
+static void stream_compute(const stream_run_t* run, stream_slot_t* slot,
+                           size_t begin, size_t end)
+{
+  args_t chunk = *run->args;
+
+  chunk.num_stocks = end - begin;
+  chunk.sptPrice   = slot->sptPrice   + begin;
+  chunk.strike     = slot->strike     + begin;
+  chunk.rate       = slot->rate       + begin;
+  chunk.volatility = slot->volatility + begin;
+  chunk.otime      = slot->otime      + begin;
+  chunk.otype      = slot->otype      + begin;
+  chunk.output     = slot->output     + begin;
+
+  if (chunk.num_stocks > 0) run->kernel(&chunk);
+}
+
+static void stream_io_worker(stream_run_t* run)
+{
+  stream_t* st = run->st;
+
+  size_t next_read  = 0;
+  size_t next_write = 0;
+
+  while (next_write < st->nbatches) {
+    /* Keep both slots busy: read ahead whenever a slot is free */
+    if (next_read < st->nbatches && next_read < next_write + 2) {
+      stream_read(st, next_read);
+      atomic_store_explicit(&st->slots[next_read % 2].loaded, next_read + 1,
+                            memory_order_release);
+      next_read++;
+      continue;
+    }
+
+    stream_wait(&st->slots[next_write % 2].computed, next_write + 1);
+    stream_write(st, next_write);
+    next_write++;
+  }
+}
+
+static void stream_compute_worker(stream_run_t* run, int cid)
+{
+  stream_t* st = run->st;
+
+  for (size_t k = 0; k < st->nbatches; k++) {
+    stream_slot_t* slot = &st->slots[k % 2];
+
+    stream_wait(&slot->loaded, k + 1);
+
+    size_t begin, end;
+    pool_partition(stream_batch_size(st, k), PARA_CHUNK_ALIGN, cid,
+                   run->ncompute, &begin, &end);
+    stream_compute(run, slot, begin, end);
+
+    /* The last one through publishes the batch */
+    if (atomic_fetch_add(&slot->done, 1) + 1 == run->ncompute) {
+      atomic_store(&slot->done, 0);
+      atomic_store_explicit(&slot->computed, k + 1, memory_order_release);
+    }
+  }
+}
+
+static void stream_worker(int tid, int nthreads, void* args)
+{
+  stream_run_t* run = (stream_run_t*)args;
+
+  if (tid == 0) {
+    stream_io_worker(run);
+  } else if (tid <= run->ncompute) {
+    stream_compute_worker(run, tid - 1);
+  }
+}
+
+/* Stream the whole dataset once, pricing with kernel on up to ncompute
+ * threads besides the I/O thread */
+static void stream_run(args_t* args, void* (*kernel)(void*), int ncompute)
+{
+  stream_t* st = args->stream;
+
+  st->io_err = 0;
+  memset(&st->err, 0, sizeof(st->err));
+  st->err.count     = st->count;
+  st->err.first_bad = st->count;
+
+  for (int s = 0; s < 2; s++) {
+    atomic_store(&st->slots[s].loaded  , 0);
+    atomic_store(&st->slots[s].computed, 0);
+    atomic_store(&st->slots[s].done    , 0);
+  }
+
+  stream_run_t run = { st, args, kernel, 0 };
+
+  /* pool_run gives no more threads than the pool has */
+  int nthreads = args->nthreads;
+  if (args->pool == NULL) nthreads = 1;
+  else if (nthreads > args->pool->nthreads) nthreads = args->pool->nthreads;
+
+  if (nthreads < 2 || ncompute < 1) {
+    /* No thread to overlap with; the stages alternate */
+    for (size_t k = 0; k < st->nbatches; k++) {
+      stream_read   (st, k);
+      stream_compute(&run, &st->slots[k % 2], 0, stream_batch_size(st, k));
+      stream_write  (st, k);
+    }
+    return;
+  }
+
+  if (ncompute > nthreads - 1) ncompute = nthreads - 1;
+  run.ncompute = ncompute;
+
+  pool_run(args->pool, ncompute + 1, stream_worker, &run);
+}
+
+/* Alternative Implementation */
+void* impl_stream_scalar(void* args)
+{
+  stream_run((args_t*)args, impl_scalar, 0);
+
+  return NULL;
+}
+
+void* impl_stream_vector(void* args)
+{
+  stream_run((args_t*)args, impl_vector, 1);
+
+  return NULL;
+}
+
+void* impl_stream_parallel(void* args)
+{
+  args_t* p_args = (args_t*)args;
+
+  stream_run(p_args, impl_vector, p_args->nthreads - 1);
+
+  return NULL;
+}
@@ -0,0 +1,81 @@
+/* stream.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the streaming Black-Scholes pipeline (--stream). Instead of
+ * mapping the whole dataset, options are read from the binary dataset
+ * (include/dsfile.h) in batches into two buffers, priced with a regular
+ * kernel and the prices written out, so the resident set is two batches
+ * whatever the portfolio size:
+ *
+ *   tid 0       I/O: reads batch k + 1 and writes batch k - 1 while
+ *               batch k is priced
+ *   tid 1 ..    compute: every thread prices its partition of the batch
+ *               with the vectorized kernel (impl_stream_vector uses one
+ *               compute thread, impl_stream_parallel all of them)
+ *
+ * Throughput is then bounded by the slower of I/O and compute instead of
+ * their sum. With a single thread (and for impl_stream_scalar) the
+ * stages simply alternate. The I/O
+ * thread also checks every batch against its reference prices.
+ */
+
+#ifndef __IMPL_STREAM_H_
+#define __IMPL_STREAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "common/check.h"
+#include "include/dsfile.h"
+
+/* Default options per batch */
+#define STREAM_BATCH (1024 * 1024)
+
+/* One of the two batch buffers */
+typedef struct {
+  float*         sptPrice;
+  float*         strike;
+  float*         rate;
+  float*         volatility;
+  float*         otime;
+  char *         otype;
+  float*         ref;
+  float*         output;
+
+  /* Batch k sits in the slot once loaded == k + 1 and is priced once
+   * computed == k + 1; done counts compute threads through it */
+  _Alignas(64) atomic_size_t loaded;
+  _Alignas(64) atomic_size_t computed;
+  _Alignas(64) atomic_int    done;
+} stream_slot_t;
+
+typedef struct stream_t {
+  int              fd;         /* Dataset                      */
+  int              out_fd;     /* Prices (float32), or -1      */
+  dsfile_header_t  hdr;
+  size_t           count;
+  size_t           batch;
+  size_t           nbatches;
+
+  stream_slot_t    slots[2];
+
+  /* Result of the last run */
+  check_stats_t    err;
+  int              io_err;
+} stream_t;
+
+/* Open the dataset (and create the output file, if out_path is not NULL)
+ * and allocate the buffers; 0 on success */
+int   stream_open (stream_t* st, const char* path, const char* out_path,
+                   size_t batch);
+void  stream_close(stream_t* st);
+
+/* Streaming versions of the implementations; args->stream is set */
+void* impl_stream_scalar  (void* args);
+void* impl_stream_vector  (void* args);
+void* impl_stream_parallel(void* args);
+
+#endif //__IMPL_STREAM_H_
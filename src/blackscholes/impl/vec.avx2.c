@@ -0,0 +1,679 @@
+/* vec.avx2.c
+ *
+ * Author:
+ * Date  :
+ *
+ *  Description
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/vmath.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/vec.h"
+#include "impl/price.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Greeks of 8 options */
+typedef struct {
+  __m256 delta, gamma, vega, theta, rho;
+} greeks_ps_t;
+
+/* Price 8 European options (no dividends); put_mask selects puts. With
+ * g, the Greeks come out of the same d1/d2, N(d1)/N(d2) and
+ * K * exp(-r * T), at the cost of a few FMAs. */
+static inline __m256 blackscholes_ps(__m256 sptPrice, __m256 strike,
+                                     __m256 rate    , __m256 volatility,
+                                     __m256 otime   , __m256 put_mask,
+                                     greeks_ps_t* g)
+{
+  /* d1 = (log(S / K) + (r + v^2 / 2) * T) / (v * sqrt(T)) */
+  __m256 log_term = VMATH_LOG256(_mm256_div_ps(sptPrice, strike));
+
+  __m256 pwr_term = _mm256_mul_ps(volatility, volatility);
+  pwr_term = _mm256_mul_ps(pwr_term, _mm256_set1_ps(0.5f));
+
+  __m256 d1  = _mm256_add_ps(rate, pwr_term);
+  d1 = _mm256_mul_ps(d1, otime);
+  d1 = _mm256_add_ps(d1, log_term);
+
+  __m256 sqrt_t = _mm256_sqrt_ps(otime);
+  __m256 den    = _mm256_mul_ps(volatility, sqrt_t);
+  d1 = _mm256_div_ps(d1, den);
+
+  /* d2 = d1 - v * sqrt(T) */
+  __m256 d2  = _mm256_sub_ps(d1, den);
+
+  __m256 p_d1;
+  __m256 n_d1 = _mm256_cndf_pdf_ps(d1, &p_d1);
+  __m256 n_d2 = _mm256_cndf_ps(d2);
+
+  /* Future value of the strike: K * exp(-r * T) */
+  __m256 fv  = _mm256_mul_ps(rate, otime);
+  fv = _mm256_sub_ps(_mm256_setzero_ps(), fv);
+  fv = _mm256_mul_ps(strike, VMATH_EXP256(fv));
+
+  /* call = S * N(d1) - FV * N(d2)             *
+   * put  = FV * (1 - N(d2)) - S * (1 - N(d1)) */
+  __m256 call = _mm256_sub_ps(_mm256_mul_ps(sptPrice, n_d1),
+                              _mm256_mul_ps(fv      , n_d2));
+
+  __m256 one  = _mm256_set1_ps(1.0f);
+  __m256 put  = _mm256_sub_ps(_mm256_mul_ps(fv      , _mm256_sub_ps(one, n_d2)),
+                              _mm256_mul_ps(sptPrice, _mm256_sub_ps(one, n_d1)));
+
+  if (g != NULL) {
+    /* Puts use N(d1) - 1 and N(d2) - 1 in the call formulas */
+    __m256 c_d1 = _mm256_sub_ps(n_d1, _mm256_and_ps(put_mask, one));
+    __m256 c_d2 = _mm256_sub_ps(n_d2, _mm256_and_ps(put_mask, one));
+
+    /* S * N'(d1) appears in gamma, vega and theta */
+    __m256 s_p  = _mm256_mul_ps(sptPrice, p_d1);
+
+    g->delta = c_d1;
+    g->gamma = _mm256_div_ps(p_d1, _mm256_mul_ps(sptPrice, den));
+    g->vega  = _mm256_mul_ps(s_p, sqrt_t);
+
+    /* theta = -S * N'(d1) * v / (2 * sqrt(T)) - r * FV * N(+-d2) */
+    __m256 t_s  = _mm256_div_ps(_mm256_mul_ps(s_p, volatility),
+                                _mm256_add_ps(sqrt_t, sqrt_t));
+    __m256 fv_d2 = _mm256_mul_ps(fv, c_d2);
+
+    g->theta = _mm256_fnmadd_ps(rate, fv_d2, _mm256_sub_ps(_mm256_setzero_ps(), t_s));
+    g->rho   = _mm256_mul_ps(otime, fv_d2);
+  }
+
+  return _mm256_blendv_ps(call, put, put_mask);
+}
+
+/* Expand 8 option-type bytes into a per-lane put mask */
+static inline __m256 otype_put_mask(const char* otype)
+{
+  __m128i  types = _mm_loadl_epi64((const __m128i*)otype);
+  __m256i  lanes = _mm256_cvtepu8_epi32(types);
+  __m256i  puts  = _mm256_cmpeq_epi32(lanes, _mm256_set1_epi32('P'));
+
+  return _mm256_castsi256_ps(puts);
+}
+
+/* Price n options by column into output; with greek_args, also their
+ * Greeks into its delta .. rho */
+PRICE_INLINE void soa_avx2(size_t num_stocks,
+                           const float* sptPrice  , const float* strike,
+                           const float* rate      , const float* volatility,
+                           const float* otime     , const char * otype,
+                           float*       output    , const args_t* greek_args)
+{
+  const bool  greeks = (greek_args != NULL);
+  greeks_ps_t g;
+
+  const size_t max_vlen = 32 / sizeof(float);
+
+  /* Main loop: full vectors only */
+  size_t i = 0;
+  for (; i + max_vlen <= num_stocks; i += max_vlen) {
+    __m256 price = blackscholes_ps(_mm256_loadu_ps(&sptPrice  [i]),
+                                   _mm256_loadu_ps(&strike    [i]),
+                                   _mm256_loadu_ps(&rate      [i]),
+                                   _mm256_loadu_ps(&volatility[i]),
+                                   _mm256_loadu_ps(&otime     [i]),
+                                   otype_put_mask (&otype     [i]),
+                                   greeks ? &g : NULL);
+
+    _mm256_storeu_ps(&output[i], price);
+
+    if (greeks) {
+      _mm256_storeu_ps(&greek_args->delta[i], g.delta);
+      _mm256_storeu_ps(&greek_args->gamma[i], g.gamma);
+      _mm256_storeu_ps(&greek_args->vega [i], g.vega );
+      _mm256_storeu_ps(&greek_args->theta[i], g.theta);
+      _mm256_storeu_ps(&greek_args->rho  [i], g.rho  );
+    }
+  }
+
+  /* Masked tail: num_stocks % 8 options */
+  if (i < num_stocks) {
+    size_t rem = num_stocks - i;
+
+    int m[8];
+    for (size_t j = 0; j < max_vlen; j++)
+      m[j] = (j < rem) ? 0x80000000 : 0x00000000;
+    __m256i vm = _mm256_loadu_si256((const __m256i*)m);
+
+    /* Never read past the end of the otype array */
+    char types[8] = { 0 };
+    memcpy(types, &otype[i], rem);
+
+    __m256 price = blackscholes_ps(_mm256_maskload_ps(&sptPrice  [i], vm),
+                                   _mm256_maskload_ps(&strike    [i], vm),
+                                   _mm256_maskload_ps(&rate      [i], vm),
+                                   _mm256_maskload_ps(&volatility[i], vm),
+                                   _mm256_maskload_ps(&otime     [i], vm),
+                                   otype_put_mask (types),
+                                   greeks ? &g : NULL);
+
+    _mm256_maskstore_ps(&output[i], vm, price);
+
+    if (greeks) {
+      _mm256_maskstore_ps(&greek_args->delta[i], vm, g.delta);
+      _mm256_maskstore_ps(&greek_args->gamma[i], vm, g.gamma);
+      _mm256_maskstore_ps(&greek_args->vega [i], vm, g.vega );
+      _mm256_maskstore_ps(&greek_args->theta[i], vm, g.theta);
+      _mm256_maskstore_ps(&greek_args->rho  [i], vm, g.rho  );
+    }
+  }
+}
+
+/* AVX2 variant */
+void* impl_vector_avx2(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Prices only: through the size-specialized copies */
+  if (parsed_args->delta == NULL) {
+    price_vector_avx2(parsed_args->num_stocks,
+                      parsed_args->sptPrice  , parsed_args->strike    ,
+                      parsed_args->rate      , parsed_args->volatility,
+                      parsed_args->otime     , parsed_args->otype     ,
+                      parsed_args->output    );
+    return NULL;
+  }
+
+  soa_avx2(parsed_args->num_stocks,
+           parsed_args->sptPrice  , parsed_args->strike    ,
+           parsed_args->rate      , parsed_args->volatility,
+           parsed_args->otime     , parsed_args->otype     ,
+           parsed_args->output    , parsed_args);
+
+  /* Done */
+  return NULL;
+}
+
+/* Typed single-batch entry point (impl/price.h) */
+void price_vector_avx2(size_t n,
+                       const float* sptPrice  , const float* strike    ,
+                       const float* rate      , const float* volatility,
+                       const float* otime     , const char * otype     ,
+                       float*       output)
+{
+  PRICE_SPECIALIZE(n, soa_avx2, sptPrice, strike, rate, volatility, otime, otype,
+                   output, NULL);
+}
+
+/* Price 4 options in double, as blackscholes_ps */
+static inline __m256d blackscholes_pd(__m256d sptPrice, __m256d strike,
+                                      __m256d rate    , __m256d volatility,
+                                      __m256d otime   , __m256d put_mask)
+{
+  __m256d log_term = _mm256_log_pd(_mm256_div_pd(sptPrice, strike));
+
+  __m256d pwr_term = _mm256_mul_pd(volatility, volatility);
+  pwr_term = _mm256_fmadd_pd(pwr_term, _mm256_set1_pd(0.5), rate);
+
+  __m256d d1  = _mm256_fmadd_pd(pwr_term, otime, log_term);
+
+  __m256d den = _mm256_mul_pd(volatility, _mm256_sqrt_pd(otime));
+  d1 = _mm256_div_pd(d1, den);
+
+  __m256d d2  = _mm256_sub_pd(d1, den);
+
+  __m256d n_d1 = _mm256_cndf_pd(d1);
+  __m256d n_d2 = _mm256_cndf_pd(d2);
+
+  __m256d fv  = _mm256_mul_pd(rate, otime);
+  fv = _mm256_sub_pd(_mm256_setzero_pd(), fv);
+  fv = _mm256_mul_pd(strike, _mm256_exp_pd(fv));
+
+  __m256d call = _mm256_fmsub_pd(sptPrice, n_d1, _mm256_mul_pd(fv, n_d2));
+
+  __m256d one  = _mm256_set1_pd(1.0);
+  __m256d put  = _mm256_fmsub_pd(fv, _mm256_sub_pd(one, n_d2),
+                                 _mm256_mul_pd(sptPrice, _mm256_sub_pd(one, n_d1)));
+
+  return _mm256_blendv_pd(call, put, put_mask);
+}
+
+/* Expand 4 option-type bytes into a per-lane put mask */
+static inline __m256d otype_put_mask_pd(const char* otype)
+{
+  int32_t  bytes;
+  memcpy(&bytes, otype, sizeof(bytes));
+
+  __m256i  lanes = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(bytes));
+  __m256i  puts  = _mm256_cmpeq_epi64(lanes, _mm256_set1_epi64x('P'));
+
+  return _mm256_castsi256_pd(puts);
+}
+
+/* AVX2 double-precision variant */
+void* impl_vector_pd_avx2(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t  num_stocks = parsed_args->num_stocks;
+
+  register const double* sptPrice   = parsed_args->pd.sptPrice  ;
+  register const double* strike     = parsed_args->pd.strike    ;
+  register const double* rate       = parsed_args->pd.rate      ;
+  register const double* volatility = parsed_args->pd.volatility;
+  register const double* otime      = parsed_args->pd.otime     ;
+  register const char  * otype      = parsed_args->otype        ;
+  register       double* output     = parsed_args->pd.output    ;
+
+  const size_t max_vlen = 32 / sizeof(double);
+
+  /* Main loop: full vectors only */
+  size_t i = 0;
+  for (; i + max_vlen <= num_stocks; i += max_vlen) {
+    __m256d price = blackscholes_pd(_mm256_loadu_pd(&sptPrice  [i]),
+                                    _mm256_loadu_pd(&strike    [i]),
+                                    _mm256_loadu_pd(&rate      [i]),
+                                    _mm256_loadu_pd(&volatility[i]),
+                                    _mm256_loadu_pd(&otime     [i]),
+                                    otype_put_mask_pd(&otype   [i]));
+
+    _mm256_storeu_pd(&output[i], price);
+  }
+
+  /* Masked tail: num_stocks % 4 options */
+  if (i < num_stocks) {
+    size_t rem = num_stocks - i;
+
+    long long m[4];
+    for (size_t j = 0; j < max_vlen; j++)
+      m[j] = (j < rem) ? (long long)0x8000000000000000ULL : 0;
+    __m256i vm = _mm256_loadu_si256((const __m256i*)m);
+
+    /* Never read past the end of the otype array */
+    char types[4] = { 0 };
+    memcpy(types, &otype[i], rem);
+
+    __m256d price = blackscholes_pd(_mm256_maskload_pd(&sptPrice  [i], vm),
+                                    _mm256_maskload_pd(&strike    [i], vm),
+                                    _mm256_maskload_pd(&rate      [i], vm),
+                                    _mm256_maskload_pd(&volatility[i], vm),
+                                    _mm256_maskload_pd(&otime     [i], vm),
+                                    otype_put_mask_pd(types));
+
+    _mm256_maskstore_pd(&output[i], vm, price);
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* d = (log(S / K) + (r + v^2 / 2) * T) / (v * sqrt(T)) and den in double
+ * for 4 options given as floats */
+static inline __m256d d1_pd(__m128 sptPrice, __m128 strike, __m128 rate,
+                            __m128 volatility, __m128 otime, __m256d* den)
+{
+  __m256d s = _mm256_cvtps_pd(sptPrice  );
+  __m256d k = _mm256_cvtps_pd(strike    );
+  __m256d r = _mm256_cvtps_pd(rate      );
+  __m256d v = _mm256_cvtps_pd(volatility);
+  __m256d t = _mm256_cvtps_pd(otime     );
+
+  __m256d log_term = _mm256_log_pd(_mm256_div_pd(s, k));
+
+  __m256d pwr_term = _mm256_mul_pd(v, v);
+  pwr_term = _mm256_fmadd_pd(pwr_term, _mm256_set1_pd(0.5), r);
+
+  *den = _mm256_mul_pd(v, _mm256_sqrt_pd(t));
+
+  return _mm256_div_pd(_mm256_fmadd_pd(pwr_term, t, log_term), *den);
+}
+
+#define LO128(x) _mm256_castps256_ps128(x)
+#define HI128(x) _mm256_extractf128_ps(x, 1)
+
+/* Price 8 options given as floats, with d1 and d2 in double */
+static inline __m256 blackscholes_mixed_ps(__m256 sptPrice, __m256 strike,
+                                           __m256 rate    , __m256 volatility,
+                                           __m256 otime   , __m256 put_mask)
+{
+  __m256d den_lo, den_hi;
+  __m256d d1_lo = d1_pd(LO128(sptPrice), LO128(strike), LO128(rate),
+                        LO128(volatility), LO128(otime), &den_lo);
+  __m256d d1_hi = d1_pd(HI128(sptPrice), HI128(strike), HI128(rate),
+                        HI128(volatility), HI128(otime), &den_hi);
+
+  /* Back to float for the CNDF; its polynomial is the limit anyway */
+  __m256 d1 = _mm256_set_m128(_mm256_cvtpd_ps(d1_hi), _mm256_cvtpd_ps(d1_lo));
+  __m256 d2 = _mm256_set_m128(_mm256_cvtpd_ps(_mm256_sub_pd(d1_hi, den_hi)),
+                              _mm256_cvtpd_ps(_mm256_sub_pd(d1_lo, den_lo)));
+
+  __m256 n_d1 = _mm256_cndf_ps(d1);
+  __m256 n_d2 = _mm256_cndf_ps(d2);
+
+  __m256 fv  = _mm256_mul_ps(rate, otime);
+  fv = _mm256_sub_ps(_mm256_setzero_ps(), fv);
+  fv = _mm256_mul_ps(strike, VMATH_EXP256(fv));
+
+  __m256 call = _mm256_sub_ps(_mm256_mul_ps(sptPrice, n_d1),
+                              _mm256_mul_ps(fv      , n_d2));
+
+  __m256 one  = _mm256_set1_ps(1.0f);
+  __m256 put  = _mm256_sub_ps(_mm256_mul_ps(fv      , _mm256_sub_ps(one, n_d2)),
+                              _mm256_mul_ps(sptPrice, _mm256_sub_ps(one, n_d1)));
+
+  return _mm256_blendv_ps(call, put, put_mask);
+}
+
+#undef LO128
+#undef HI128
+
+/* AVX2 mixed-precision variant */
+void* impl_vector_mixed_avx2(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t num_stocks = parsed_args->num_stocks;
+
+  register const float* sptPrice   = parsed_args->sptPrice  ;
+  register const float* strike     = parsed_args->strike    ;
+  register const float* rate       = parsed_args->rate      ;
+  register const float* volatility = parsed_args->volatility;
+  register const float* otime      = parsed_args->otime     ;
+  register const char * otype      = parsed_args->otype     ;
+  register       float* output     = parsed_args->output    ;
+
+  const size_t max_vlen = 32 / sizeof(float);
+
+  /* Main loop: full vectors only */
+  size_t i = 0;
+  for (; i + max_vlen <= num_stocks; i += max_vlen) {
+    __m256 price = blackscholes_mixed_ps(_mm256_loadu_ps(&sptPrice  [i]),
+                                         _mm256_loadu_ps(&strike    [i]),
+                                         _mm256_loadu_ps(&rate      [i]),
+                                         _mm256_loadu_ps(&volatility[i]),
+                                         _mm256_loadu_ps(&otime     [i]),
+                                         otype_put_mask (&otype     [i]));
+
+    _mm256_storeu_ps(&output[i], price);
+  }
+
+  /* Masked tail: num_stocks % 8 options */
+  if (i < num_stocks) {
+    size_t rem = num_stocks - i;
+
+    int m[8];
+    for (size_t j = 0; j < max_vlen; j++)
+      m[j] = (j < rem) ? 0x80000000 : 0x00000000;
+    __m256i vm = _mm256_loadu_si256((const __m256i*)m);
+
+    char types[8] = { 0 };
+    memcpy(types, &otype[i], rem);
+
+    __m256 price = blackscholes_mixed_ps(_mm256_maskload_ps(&sptPrice  [i], vm),
+                                         _mm256_maskload_ps(&strike    [i], vm),
+                                         _mm256_maskload_ps(&rate      [i], vm),
+                                         _mm256_maskload_ps(&volatility[i], vm),
+                                         _mm256_maskload_ps(&otime     [i], vm),
+                                         otype_put_mask (types));
+
+    _mm256_maskstore_ps(&output[i], vm, price);
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* Record stride and field offsets, in floats, for the gathers */
+#define REC_STRIDE (sizeof(option_rec_t) / sizeof(float))
+#define REC_FIELD(f) (offsetof(option_rec_t, f) / sizeof(float))
+
+_Static_assert(sizeof(option_rec_t) % sizeof(float) == 0,
+               "records must be a whole number of floats");
+
+/* Price 8 records at base under a lane mask (all ones but for the tail) */
+static inline __m256 blackscholes_aos_ps(const float* base, __m256i idx,
+                                         __m256 mask)
+{
+  __m256 ones = _mm256_set1_ps(1.0f);
+
+  /* The option type sits in the low byte of the word after otime */
+  __m256i types = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+                                              (const int*)(base + REC_FIELD(otype)),
+                                              idx, _mm256_castps_si256(mask), 4);
+  types = _mm256_and_si256(types, _mm256_set1_epi32(0xFF));
+  __m256 puts = _mm256_castsi256_ps(_mm256_cmpeq_epi32(types, _mm256_set1_epi32('P')));
+
+  return blackscholes_ps(_mm256_mask_i32gather_ps(ones, base + REC_FIELD(sptPrice  ), idx, mask, 4),
+                         _mm256_mask_i32gather_ps(ones, base + REC_FIELD(strike    ), idx, mask, 4),
+                         _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base + REC_FIELD(rate), idx, mask, 4),
+                         _mm256_mask_i32gather_ps(ones, base + REC_FIELD(volatility), idx, mask, 4),
+                         _mm256_mask_i32gather_ps(ones, base + REC_FIELD(otime     ), idx, mask, 4),
+                         puts, NULL);
+}
+
+/* AVX2 variant over records: every field is a strided gather */
+void* impl_vector_aos_avx2(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t        num_stocks = parsed_args->num_stocks;
+
+  register const option_rec_t* rec        = parsed_args->aos   ;
+  register       float*        output     = parsed_args->output;
+
+  const size_t  max_vlen = 32 / sizeof(float);
+  const __m256i idx      = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                              _mm256_set1_epi32(REC_STRIDE));
+
+  /* Main loop: full vectors only */
+  size_t i = 0;
+  for (; i + max_vlen <= num_stocks; i += max_vlen) {
+    __m256 all   = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    __m256 price = blackscholes_aos_ps((const float*)&rec[i], idx, all);
+
+    _mm256_storeu_ps(&output[i], price);
+  }
+
+  /* Masked tail: the gathers skip the lanes past the end */
+  if (i < num_stocks) {
+    __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i vm   = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(num_stocks - i)), lane);
+
+    __m256 price = blackscholes_aos_ps((const float*)&rec[i], idx,
+                                       _mm256_castsi256_ps(vm));
+
+    _mm256_maskstore_ps(&output[i], vm, price);
+  }
+
+  /* Done */
+  return NULL;
+}
+
+#undef REC_STRIDE
+#undef REC_FIELD
+
+/* AVX2 variant over blocks: two aligned loads per field and block */
+void* impl_vector_aosoa_avx2(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t          num_stocks = parsed_args->num_stocks;
+
+  register const option_block_t* blk        = parsed_args->aosoa ;
+  register       float*          output     = parsed_args->output;
+
+  const size_t max_vlen = 32 / sizeof(float);
+
+  _Static_assert(AOSOA_BLOCK % (32 / sizeof(float)) == 0, "whole vectors per field");
+
+  for (size_t i = 0; i < num_stocks; i += max_vlen) {
+    const option_block_t* b = &blk[i / AOSOA_BLOCK];
+    size_t                j = i % AOSOA_BLOCK;
+    size_t                rem = num_stocks - i;
+
+    if (rem >= max_vlen) {
+      __m256 price = blackscholes_ps(_mm256_load_ps(&b->sptPrice  [j]),
+                                     _mm256_load_ps(&b->strike    [j]),
+                                     _mm256_load_ps(&b->rate      [j]),
+                                     _mm256_load_ps(&b->volatility[j]),
+                                     _mm256_load_ps(&b->otime     [j]),
+                                     otype_put_mask(&b->otype     [j]),
+                                     NULL);
+
+      _mm256_storeu_ps(&output[i], price);
+      continue;
+    }
+
+    /* Partial last vector */
+    int m[8];
+    for (size_t k = 0; k < max_vlen; k++)
+      m[k] = (k < rem) ? 0x80000000 : 0x00000000;
+    __m256i vm = _mm256_loadu_si256((const __m256i*)m);
+
+    char types[8] = { 0 };
+    memcpy(types, &b->otype[j], rem);
+
+    __m256 price = blackscholes_ps(_mm256_maskload_ps(&b->sptPrice  [j], vm),
+                                   _mm256_maskload_ps(&b->strike    [j], vm),
+                                   _mm256_maskload_ps(&b->rate      [j], vm),
+                                   _mm256_maskload_ps(&b->volatility[j], vm),
+                                   _mm256_maskload_ps(&b->otime     [j], vm),
+                                   otype_put_mask(types), NULL);
+
+    _mm256_maskstore_ps(&output[i], vm, price);
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* Manaster-Koehler starting volatility, clamped; see vec.h */
+static inline __m256 iv_guess_ps(__m256 sptPrice, __m256 strike,
+                                 __m256 rate    , __m256 otime)
+{
+  __m256 m = _mm256_fmadd_ps(rate, otime, VMATH_LOG256(_mm256_div_ps(sptPrice, strike)));
+  m = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), m);
+
+  __m256 v = _mm256_sqrt_ps(_mm256_div_ps(_mm256_add_ps(m, m), otime));
+
+  return _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(IV_MIN)),
+                       _mm256_set1_ps(IV_MAX));
+}
+
+/* Solve 8 options; the lanes of live take Newton steps until every one
+ * of them has converged, the others are frozen */
+static inline __m256 implied_vol_ps(__m256 sptPrice, __m256 strike,
+                                    __m256 rate    , __m256 otime,
+                                    __m256 puts    , __m256 market,
+                                    __m256 live)
+{
+  __m256 v  = iv_guess_ps(sptPrice, strike, rate, otime);
+  __m256 lo = _mm256_set1_ps(IV_MIN);
+  __m256 hi = _mm256_set1_ps(IV_MAX);
+
+  for (int it = 0; it < IV_MAX_ITERS && _mm256_movemask_ps(live) != 0; it++) {
+    greeks_ps_t g;
+    __m256 price = blackscholes_ps(sptPrice, strike, rate, v, otime, puts, &g);
+
+    /* The price rises with the volatility */
+    __m256 above = _mm256_cmp_ps(price, market, _CMP_GT_OQ);
+    hi = _mm256_blendv_ps(hi, v, above);
+    lo = _mm256_blendv_ps(v, lo, above);
+
+    /* Newton, or bisection when it leaves the bracket (NaN included) */
+    __m256 next = _mm256_sub_ps(v, _mm256_div_ps(_mm256_sub_ps(price, market), g.vega));
+    __m256 in   = _mm256_and_ps(_mm256_cmp_ps(next, lo, _CMP_GE_OQ),
+                                _mm256_cmp_ps(next, hi, _CMP_LE_OQ));
+    next = _mm256_blendv_ps(_mm256_mul_ps(_mm256_add_ps(lo, hi), _mm256_set1_ps(0.5f)),
+                            next, in);
+
+    __m256 step = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _mm256_sub_ps(next, v));
+
+    v    = _mm256_blendv_ps(v, next, live);
+    live = _mm256_and_ps(live, _mm256_cmp_ps(step, _mm256_set1_ps(IV_TOL), _CMP_GE_OQ));
+  }
+
+  return v;
+}
+
+/* AVX2 implied-volatility variant, 8 options at a time */
+void* impl_vector_iv_avx2(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t num_stocks = parsed_args->num_stocks;
+
+  register const float* sptPrice   = parsed_args->sptPrice;
+  register const float* strike     = parsed_args->strike  ;
+  register const float* rate       = parsed_args->rate    ;
+  register const float* otime      = parsed_args->otime   ;
+  register const char * otype      = parsed_args->otype   ;
+  register const float* market     = parsed_args->market  ;
+  register       float* output     = parsed_args->output  ;
+
+  const size_t max_vlen = 32 / sizeof(float);
+  const __m256 all      = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+  /* Main loop: full vectors only */
+  size_t i = 0;
+  for (; i + max_vlen <= num_stocks; i += max_vlen) {
+    __m256 v = implied_vol_ps(_mm256_loadu_ps(&sptPrice[i]),
+                              _mm256_loadu_ps(&strike  [i]),
+                              _mm256_loadu_ps(&rate    [i]),
+                              _mm256_loadu_ps(&otime   [i]),
+                              otype_put_mask (&otype   [i]),
+                              _mm256_loadu_ps(&market  [i]),
+                              all);
+
+    _mm256_storeu_ps(&output[i], v);
+  }
+
+  /* Masked tail: the lanes past the end are never live */
+  if (i < num_stocks) {
+    size_t rem = num_stocks - i;
+
+    int m[8];
+    for (size_t j = 0; j < max_vlen; j++)
+      m[j] = (j < rem) ? 0x80000000 : 0x00000000;
+    __m256i vm = _mm256_loadu_si256((const __m256i*)m);
+
+    char types[8] = { 0 };
+    memcpy(types, &otype[i], rem);
+
+    __m256 ones = _mm256_set1_ps(1.0f);
+    __m256 v = implied_vol_ps(_mm256_blendv_ps(ones, _mm256_maskload_ps(&sptPrice[i], vm), _mm256_castsi256_ps(vm)),
+                              _mm256_blendv_ps(ones, _mm256_maskload_ps(&strike  [i], vm), _mm256_castsi256_ps(vm)),
+                              _mm256_maskload_ps(&rate  [i], vm),
+                              _mm256_blendv_ps(ones, _mm256_maskload_ps(&otime   [i], vm), _mm256_castsi256_ps(vm)),
+                              otype_put_mask (types),
+                              _mm256_maskload_ps(&market[i], vm),
+                              _mm256_castsi256_ps(vm));
+
+    _mm256_maskstore_ps(&output[i], vm, v);
+  }
+
+  /* Done */
+  return NULL;
+}
+#endif
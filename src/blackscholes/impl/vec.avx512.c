@@ -0,0 +1,576 @@
+/* vec.avx512.c
+ *
+ * Author:
+ * Date  :
+ *
+ *  Description
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/vmath.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/vec.h"
+#include "impl/price.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Greeks of 16 options */
+typedef struct {
+  __m512 delta, gamma, vega, theta, rho;
+} greeks_ps_t;
+
+/* Price 16 European options (no dividends); puts selects the put lanes.
+ * With g, the Greeks come out of the same d1/d2, N(d1)/N(d2) and
+ * K * exp(-r * T), at the cost of a few FMAs. */
+static inline __m512 blackscholes_ps(__m512 sptPrice, __m512 strike,
+                                     __m512 rate    , __m512 volatility,
+                                     __m512 otime   , __mmask16 puts,
+                                     greeks_ps_t* g)
+{
+  /* d1 = (log(S / K) + (r + v^2 / 2) * T) / (v * sqrt(T)) */
+  __m512 log_term = VMATH_LOG512(_mm512_div_ps(sptPrice, strike));
+
+  __m512 pwr_term = _mm512_mul_ps(volatility, volatility);
+  pwr_term = _mm512_fmadd_ps(pwr_term, _mm512_set1_ps(0.5f), rate);
+
+  __m512 d1  = _mm512_fmadd_ps(pwr_term, otime, log_term);
+
+  __m512 sqrt_t = _mm512_sqrt_ps(otime);
+  __m512 den    = _mm512_mul_ps(volatility, sqrt_t);
+  d1 = _mm512_div_ps(d1, den);
+
+  /* d2 = d1 - v * sqrt(T) */
+  __m512 d2  = _mm512_sub_ps(d1, den);
+
+  __m512 p_d1;
+  __m512 n_d1 = _mm512_cndf_pdf_ps(d1, &p_d1);
+  __m512 n_d2 = _mm512_cndf_ps(d2);
+
+  /* Future value of the strike: K * exp(-r * T) */
+  __m512 fv  = _mm512_mul_ps(rate, otime);
+  fv = _mm512_sub_ps(_mm512_setzero_ps(), fv);
+  fv = _mm512_mul_ps(strike, VMATH_EXP512(fv));
+
+  /* call = S * N(d1) - FV * N(d2)             *
+   * put  = FV * (1 - N(d2)) - S * (1 - N(d1)) */
+  __m512 call = _mm512_sub_ps(_mm512_mul_ps(sptPrice, n_d1),
+                              _mm512_mul_ps(fv      , n_d2));
+
+  __m512 one  = _mm512_set1_ps(1.0f);
+  __m512 put  = _mm512_sub_ps(_mm512_mul_ps(fv      , _mm512_sub_ps(one, n_d2)),
+                              _mm512_mul_ps(sptPrice, _mm512_sub_ps(one, n_d1)));
+
+  if (g != NULL) {
+    /* Puts use N(d1) - 1 and N(d2) - 1 in the call formulas */
+    __m512 c_d1 = _mm512_mask_sub_ps(n_d1, puts, n_d1, one);
+    __m512 c_d2 = _mm512_mask_sub_ps(n_d2, puts, n_d2, one);
+
+    /* S * N'(d1) appears in gamma, vega and theta */
+    __m512 s_p  = _mm512_mul_ps(sptPrice, p_d1);
+
+    g->delta = c_d1;
+    g->gamma = _mm512_div_ps(p_d1, _mm512_mul_ps(sptPrice, den));
+    g->vega  = _mm512_mul_ps(s_p, sqrt_t);
+
+    /* theta = -S * N'(d1) * v / (2 * sqrt(T)) - r * FV * N(+-d2) */
+    __m512 t_s  = _mm512_div_ps(_mm512_mul_ps(s_p, volatility),
+                                _mm512_add_ps(sqrt_t, sqrt_t));
+    __m512 fv_d2 = _mm512_mul_ps(fv, c_d2);
+
+    g->theta = _mm512_fnmadd_ps(rate, fv_d2, _mm512_sub_ps(_mm512_setzero_ps(), t_s));
+    g->rho   = _mm512_mul_ps(otime, fv_d2);
+  }
+
+  return _mm512_mask_mov_ps(call, puts, put);
+}
+
+/* Price n options by column into output; with greek_args, also their
+ * Greeks into its delta .. rho */
+PRICE_INLINE void soa_avx512(size_t num_stocks,
+                             const float* sptPrice  , const float* strike,
+                             const float* rate      , const float* volatility,
+                             const float* otime     , const char * otype,
+                             float*       output    , const args_t* greek_args)
+{
+  const bool greeks = (greek_args != NULL);
+
+  const size_t max_vlen = 64 / sizeof(float);
+
+  /* One loop; the last iteration runs under a partial mask, and masked
+   * loads never touch memory past the end of the arrays */
+  for (size_t i = 0; i < num_stocks; i += max_vlen) {
+    size_t    rem = num_stocks - i;
+    __mmask16 m   = (rem >= max_vlen) ? (__mmask16)0xFFFF
+                                      : (__mmask16)((1u << rem) - 1);
+
+    __m128i   types = _mm_maskz_loadu_epi8(m, &otype[i]);
+    __mmask16 puts  = _mm_cmpeq_epi8_mask(types, _mm_set1_epi8('P'));
+
+    /* Inactive lanes price S = K = T = v = 1, so no NaN is ever raised */
+    __m512      ones  = _mm512_set1_ps(1.0f);
+    greeks_ps_t g;
+    __m512 price = blackscholes_ps(_mm512_mask_loadu_ps(ones, m, &sptPrice  [i]),
+                                   _mm512_mask_loadu_ps(ones, m, &strike    [i]),
+                                   _mm512_maskz_loadu_ps(    m, &rate      [i]),
+                                   _mm512_mask_loadu_ps(ones, m, &volatility[i]),
+                                   _mm512_mask_loadu_ps(ones, m, &otime     [i]),
+                                   puts, greeks ? &g : NULL);
+
+    _mm512_mask_storeu_ps(&output[i], m, price);
+
+    if (greeks) {
+      _mm512_mask_storeu_ps(&greek_args->delta[i], m, g.delta);
+      _mm512_mask_storeu_ps(&greek_args->gamma[i], m, g.gamma);
+      _mm512_mask_storeu_ps(&greek_args->vega [i], m, g.vega );
+      _mm512_mask_storeu_ps(&greek_args->theta[i], m, g.theta);
+      _mm512_mask_storeu_ps(&greek_args->rho  [i], m, g.rho  );
+    }
+  }
+}
+
+/* AVX-512 variant */
+void* impl_vector_avx512(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Prices only: through the size-specialized copies */
+  if (parsed_args->delta == NULL) {
+    price_vector_avx512(parsed_args->num_stocks,
+                        parsed_args->sptPrice  , parsed_args->strike    ,
+                        parsed_args->rate      , parsed_args->volatility,
+                        parsed_args->otime     , parsed_args->otype     ,
+                        parsed_args->output    );
+    return NULL;
+  }
+
+  soa_avx512(parsed_args->num_stocks,
+             parsed_args->sptPrice  , parsed_args->strike    ,
+             parsed_args->rate      , parsed_args->volatility,
+             parsed_args->otime     , parsed_args->otype     ,
+             parsed_args->output    , parsed_args);
+
+  /* Done */
+  return NULL;
+}
+
+/* Typed single-batch entry point (impl/price.h) */
+void price_vector_avx512(size_t n,
+                         const float* sptPrice  , const float* strike    ,
+                         const float* rate      , const float* volatility,
+                         const float* otime     , const char * otype     ,
+                         float*       output)
+{
+  PRICE_SPECIALIZE(n, soa_avx512, sptPrice, strike, rate, volatility, otime, otype,
+                   output, NULL);
+}
+
+/* Price 8 options in double, as blackscholes_ps */
+static inline __m512d blackscholes_pd(__m512d sptPrice, __m512d strike,
+                                      __m512d rate    , __m512d volatility,
+                                      __m512d otime   , __mmask8 puts)
+{
+  __m512d log_term = _mm512_log_pd(_mm512_div_pd(sptPrice, strike));
+
+  __m512d pwr_term = _mm512_mul_pd(volatility, volatility);
+  pwr_term = _mm512_fmadd_pd(pwr_term, _mm512_set1_pd(0.5), rate);
+
+  __m512d d1  = _mm512_fmadd_pd(pwr_term, otime, log_term);
+
+  __m512d den = _mm512_mul_pd(volatility, _mm512_sqrt_pd(otime));
+  d1 = _mm512_div_pd(d1, den);
+
+  __m512d d2  = _mm512_sub_pd(d1, den);
+
+  __m512d n_d1 = _mm512_cndf_pd(d1);
+  __m512d n_d2 = _mm512_cndf_pd(d2);
+
+  __m512d fv  = _mm512_mul_pd(rate, otime);
+  fv = _mm512_sub_pd(_mm512_setzero_pd(), fv);
+  fv = _mm512_mul_pd(strike, _mm512_exp_pd(fv));
+
+  __m512d call = _mm512_fmsub_pd(sptPrice, n_d1, _mm512_mul_pd(fv, n_d2));
+
+  __m512d one  = _mm512_set1_pd(1.0);
+  __m512d put  = _mm512_fmsub_pd(fv, _mm512_sub_pd(one, n_d2),
+                                 _mm512_mul_pd(sptPrice, _mm512_sub_pd(one, n_d1)));
+
+  return _mm512_mask_mov_pd(call, puts, put);
+}
+
+/* AVX-512 double-precision variant */
+void* impl_vector_pd_avx512(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t  num_stocks = parsed_args->num_stocks;
+
+  register const double* sptPrice   = parsed_args->pd.sptPrice  ;
+  register const double* strike     = parsed_args->pd.strike    ;
+  register const double* rate       = parsed_args->pd.rate      ;
+  register const double* volatility = parsed_args->pd.volatility;
+  register const double* otime      = parsed_args->pd.otime     ;
+  register const char  * otype      = parsed_args->otype        ;
+  register       double* output     = parsed_args->pd.output    ;
+
+  const size_t max_vlen = 64 / sizeof(double);
+
+  for (size_t i = 0; i < num_stocks; i += max_vlen) {
+    size_t   rem = num_stocks - i;
+    __mmask8 m   = (rem >= max_vlen) ? (__mmask8)0xFF
+                                     : (__mmask8)((1u << rem) - 1);
+
+    __m128i  types = _mm_maskz_loadu_epi8((__mmask16)m, &otype[i]);
+    __mmask8 puts  = (__mmask8)_mm_cmpeq_epi8_mask(types, _mm_set1_epi8('P'));
+
+    /* Inactive lanes price S = K = T = v = 1 */
+    __m512d  ones  = _mm512_set1_pd(1.0);
+    __m512d price = blackscholes_pd(_mm512_mask_loadu_pd(ones, m, &sptPrice  [i]),
+                                    _mm512_mask_loadu_pd(ones, m, &strike    [i]),
+                                    _mm512_maskz_loadu_pd(    m, &rate      [i]),
+                                    _mm512_mask_loadu_pd(ones, m, &volatility[i]),
+                                    _mm512_mask_loadu_pd(ones, m, &otime     [i]),
+                                    puts);
+
+    _mm512_mask_storeu_pd(&output[i], m, price);
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* d = (log(S / K) + (r + v^2 / 2) * T) / (v * sqrt(T)) and den in double
+ * for 8 options given as floats */
+static inline __m512d d1_pd(__m256 sptPrice, __m256 strike, __m256 rate,
+                            __m256 volatility, __m256 otime, __m512d* den)
+{
+  __m512d s = _mm512_cvtps_pd(sptPrice  );
+  __m512d k = _mm512_cvtps_pd(strike    );
+  __m512d r = _mm512_cvtps_pd(rate      );
+  __m512d v = _mm512_cvtps_pd(volatility);
+  __m512d t = _mm512_cvtps_pd(otime     );
+
+  __m512d log_term = _mm512_log_pd(_mm512_div_pd(s, k));
+
+  __m512d pwr_term = _mm512_mul_pd(v, v);
+  pwr_term = _mm512_fmadd_pd(pwr_term, _mm512_set1_pd(0.5), r);
+
+  *den = _mm512_mul_pd(v, _mm512_sqrt_pd(t));
+
+  return _mm512_div_pd(_mm512_fmadd_pd(pwr_term, t, log_term), *den);
+}
+
+#define LO256(x) _mm512_castps512_ps256(x)
+#define HI256(x) _mm512_extractf32x8_ps(x, 1)
+
+/* Price 16 options given as floats, with d1 and d2 in double */
+static inline __m512 blackscholes_mixed_ps(__m512 sptPrice, __m512 strike,
+                                           __m512 rate    , __m512 volatility,
+                                           __m512 otime   , __mmask16 puts)
+{
+  __m512d den_lo, den_hi;
+  __m512d d1_lo = d1_pd(LO256(sptPrice), LO256(strike), LO256(rate),
+                        LO256(volatility), LO256(otime), &den_lo);
+  __m512d d1_hi = d1_pd(HI256(sptPrice), HI256(strike), HI256(rate),
+                        HI256(volatility), HI256(otime), &den_hi);
+
+  /* Back to float for the CNDF; its polynomial is the limit anyway */
+  __m512 d1 = _mm512_insertf32x8(_mm512_castps256_ps512(_mm512_cvtpd_ps(d1_lo)),
+                                 _mm512_cvtpd_ps(d1_hi), 1);
+  __m512 d2 = _mm512_insertf32x8(_mm512_castps256_ps512(_mm512_cvtpd_ps(_mm512_sub_pd(d1_lo, den_lo))),
+                                 _mm512_cvtpd_ps(_mm512_sub_pd(d1_hi, den_hi)), 1);
+
+  __m512 n_d1 = _mm512_cndf_ps(d1);
+  __m512 n_d2 = _mm512_cndf_ps(d2);
+
+  __m512 fv  = _mm512_mul_ps(rate, otime);
+  fv = _mm512_sub_ps(_mm512_setzero_ps(), fv);
+  fv = _mm512_mul_ps(strike, VMATH_EXP512(fv));
+
+  __m512 call = _mm512_sub_ps(_mm512_mul_ps(sptPrice, n_d1),
+                              _mm512_mul_ps(fv      , n_d2));
+
+  __m512 one  = _mm512_set1_ps(1.0f);
+  __m512 put  = _mm512_sub_ps(_mm512_mul_ps(fv      , _mm512_sub_ps(one, n_d2)),
+                              _mm512_mul_ps(sptPrice, _mm512_sub_ps(one, n_d1)));
+
+  return _mm512_mask_mov_ps(call, puts, put);
+}
+
+#undef LO256
+#undef HI256
+
+/* AVX-512 mixed-precision variant */
+void* impl_vector_mixed_avx512(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t num_stocks = parsed_args->num_stocks;
+
+  register const float* sptPrice   = parsed_args->sptPrice  ;
+  register const float* strike     = parsed_args->strike    ;
+  register const float* rate       = parsed_args->rate      ;
+  register const float* volatility = parsed_args->volatility;
+  register const float* otime      = parsed_args->otime     ;
+  register const char * otype      = parsed_args->otype     ;
+  register       float* output     = parsed_args->output    ;
+
+  const size_t max_vlen = 64 / sizeof(float);
+
+  for (size_t i = 0; i < num_stocks; i += max_vlen) {
+    size_t    rem = num_stocks - i;
+    __mmask16 m   = (rem >= max_vlen) ? (__mmask16)0xFFFF
+                                      : (__mmask16)((1u << rem) - 1);
+
+    __m128i   types = _mm_maskz_loadu_epi8(m, &otype[i]);
+    __mmask16 puts  = _mm_cmpeq_epi8_mask(types, _mm_set1_epi8('P'));
+
+    __m512    ones  = _mm512_set1_ps(1.0f);
+    __m512 price = blackscholes_mixed_ps(_mm512_mask_loadu_ps(ones, m, &sptPrice  [i]),
+                                         _mm512_mask_loadu_ps(ones, m, &strike    [i]),
+                                         _mm512_maskz_loadu_ps(    m, &rate      [i]),
+                                         _mm512_mask_loadu_ps(ones, m, &volatility[i]),
+                                         _mm512_mask_loadu_ps(ones, m, &otime     [i]),
+                                         puts);
+
+    _mm512_mask_storeu_ps(&output[i], m, price);
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* Record stride and field offsets, in floats, for the gathers */
+#define REC_STRIDE (sizeof(option_rec_t) / sizeof(float))
+#define REC_FIELD(f) (offsetof(option_rec_t, f) / sizeof(float))
+
+_Static_assert(sizeof(option_rec_t) % sizeof(float) == 0,
+               "records must be a whole number of floats");
+
+/* AVX-512 variant over records: every field is a strided gather */
+void* impl_vector_aos_avx512(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t        num_stocks = parsed_args->num_stocks;
+
+  register const option_rec_t* rec        = parsed_args->aos   ;
+  register       float*        output     = parsed_args->output;
+
+  const size_t  max_vlen = 64 / sizeof(float);
+  const __m512i idx      = _mm512_mullo_epi32(_mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                                                8, 9, 10, 11, 12, 13, 14, 15),
+                                              _mm512_set1_epi32(REC_STRIDE));
+
+  for (size_t i = 0; i < num_stocks; i += max_vlen) {
+    size_t    rem = num_stocks - i;
+    __mmask16 m   = (rem >= max_vlen) ? (__mmask16)0xFFFF
+                                      : (__mmask16)((1u << rem) - 1);
+
+    const float* base = (const float*)&rec[i];
+    __m512       ones = _mm512_set1_ps(1.0f);
+
+    /* The option type sits in the low byte of the word after otime */
+    __m512i   types = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), m, idx,
+                                                  (const int*)(base + REC_FIELD(otype)), 4);
+    types = _mm512_and_si512(types, _mm512_set1_epi32(0xFF));
+    __mmask16 puts  = _mm512_cmpeq_epi32_mask(types, _mm512_set1_epi32('P'));
+
+    __m512 price = blackscholes_ps(_mm512_mask_i32gather_ps(ones, m, idx, base + REC_FIELD(sptPrice  ), 4),
+                                   _mm512_mask_i32gather_ps(ones, m, idx, base + REC_FIELD(strike    ), 4),
+                                   _mm512_mask_i32gather_ps(_mm512_setzero_ps(), m, idx, base + REC_FIELD(rate), 4),
+                                   _mm512_mask_i32gather_ps(ones, m, idx, base + REC_FIELD(volatility), 4),
+                                   _mm512_mask_i32gather_ps(ones, m, idx, base + REC_FIELD(otime     ), 4),
+                                   puts, NULL);
+
+    _mm512_mask_storeu_ps(&output[i], m, price);
+  }
+
+  /* Done */
+  return NULL;
+}
+
+#undef REC_STRIDE
+#undef REC_FIELD
+
+/* AVX-512 variant over blocks: one aligned load per field and block */
+void* impl_vector_aosoa_avx512(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t          num_stocks = parsed_args->num_stocks;
+
+  register const option_block_t* blk        = parsed_args->aosoa ;
+  register       float*          output     = parsed_args->output;
+
+  _Static_assert(AOSOA_BLOCK == 64 / sizeof(float), "one vector per field");
+
+  for (size_t i = 0; i < num_stocks; i += AOSOA_BLOCK, blk++) {
+    size_t    rem = num_stocks - i;
+    __mmask16 m   = (rem >= AOSOA_BLOCK) ? (__mmask16)0xFFFF
+                                         : (__mmask16)((1u << rem) - 1);
+
+    __m128i   types = _mm_maskz_loadu_epi8(m, blk->otype);
+    __mmask16 puts  = _mm_cmpeq_epi8_mask(types, _mm_set1_epi8('P'));
+
+    __m512    ones  = _mm512_set1_ps(1.0f);
+    __m512 price = blackscholes_ps(_mm512_mask_load_ps(ones, m, blk->sptPrice  ),
+                                   _mm512_mask_load_ps(ones, m, blk->strike    ),
+                                   _mm512_maskz_load_ps(    m, blk->rate      ),
+                                   _mm512_mask_load_ps(ones, m, blk->volatility),
+                                   _mm512_mask_load_ps(ones, m, blk->otime     ),
+                                   puts, NULL);
+
+    _mm512_mask_storeu_ps(&output[i], m, price);
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* Manaster-Koehler starting volatility, clamped; see vec.h */
+static inline __m512 iv_guess_ps(__m512 sptPrice, __m512 strike,
+                                 __m512 rate    , __m512 otime)
+{
+  __m512 m = _mm512_fmadd_ps(rate, otime, VMATH_LOG512(_mm512_div_ps(sptPrice, strike)));
+  m = _mm512_abs_ps(m);
+
+  __m512 v = _mm512_sqrt_ps(_mm512_div_ps(_mm512_add_ps(m, m), otime));
+
+  return _mm512_min_ps(_mm512_max_ps(v, _mm512_set1_ps(IV_MIN)),
+                       _mm512_set1_ps(IV_MAX));
+}
+
+/* AVX-512 implied-volatility variant. The 16 lanes form a queue: a lane
+ * whose option has converged stores it (scatter) and is refilled with the
+ * next option (expand loads), so the vector stays full until the last
+ * 16 options, instead of waiting for the slowest lane of each vector. */
+void* impl_vector_iv_avx512(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t num_stocks = parsed_args->num_stocks;
+
+  register const float* sptPrice   = parsed_args->sptPrice;
+  register const float* strike     = parsed_args->strike  ;
+  register const float* rate       = parsed_args->rate    ;
+  register const float* otime      = parsed_args->otime   ;
+  register const char * otype      = parsed_args->otype   ;
+  register const float* market     = parsed_args->market  ;
+  register       float* output     = parsed_args->output  ;
+
+  const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                         8, 9, 10, 11, 12, 13, 14, 15);
+
+  /* Lane state; idle lanes hold harmless values */
+  __m512    S    = _mm512_set1_ps(1.0f);
+  __m512    K    = _mm512_set1_ps(1.0f);
+  __m512    r    = _mm512_setzero_ps();
+  __m512    T    = _mm512_set1_ps(1.0f);
+  __m512    mkt  = _mm512_setzero_ps();
+  __m512    v    = _mm512_set1_ps(1.0f);
+  __m512    lo   = _mm512_set1_ps(IV_MIN);
+  __m512    hi   = _mm512_set1_ps(IV_MAX);
+  __m512i   idx  = _mm512_setzero_si512();
+  __m512i   its  = _mm512_setzero_si512();
+  __mmask16 puts = 0;
+  __mmask16 live = 0;
+
+  /* Lanes to (re)fill: all of them at first */
+  __mmask16 fill = 0xFFFF;
+  size_t    next = 0;
+
+  for (;;) {
+    /* Refill from the next options, fewer near the end */
+    size_t avail = num_stocks - next;
+    while ((size_t)_mm_popcnt_u32(fill) > avail) {
+      fill &= (__mmask16)~(1u << (31 - __builtin_clz(fill)));
+    }
+
+    if (fill != 0) {
+      size_t    cnt = (size_t)_mm_popcnt_u32(fill);
+      __mmask16 src = (__mmask16)((1u << cnt) - 1);
+
+      S   = _mm512_mask_expandloadu_ps(S  , fill, &sptPrice[next]);
+      K   = _mm512_mask_expandloadu_ps(K  , fill, &strike  [next]);
+      r   = _mm512_mask_expandloadu_ps(r  , fill, &rate    [next]);
+      T   = _mm512_mask_expandloadu_ps(T  , fill, &otime   [next]);
+      mkt = _mm512_mask_expandloadu_ps(mkt, fill, &market  [next]);
+      idx = _mm512_mask_expand_epi32(idx, fill,
+                                     _mm512_add_epi32(lane, _mm512_set1_epi32((int)next)));
+      its = _mm512_mask_mov_epi32(its, fill, _mm512_setzero_si512());
+      v   = _mm512_mask_mov_ps(v, fill, iv_guess_ps(S, K, r, T));
+      lo  = _mm512_mask_mov_ps(lo, fill, _mm512_set1_ps(IV_MIN));
+      hi  = _mm512_mask_mov_ps(hi, fill, _mm512_set1_ps(IV_MAX));
+
+      /* Option types: one bit per option, spread over the filled lanes */
+      __m128i   types = _mm_maskz_loadu_epi8(src, &otype[next]);
+      __mmask16 p     = _mm_cmpeq_epi8_mask(types, _mm_set1_epi8('P'));
+      __m512i   pv    = _mm512_mask_expand_epi32(_mm512_setzero_si512(), fill,
+                                                 _mm512_movm_epi32(p));
+      puts = (__mmask16)((puts & ~fill) | _mm512_movepi32_mask(pv));
+
+      live |= fill;
+      next += cnt;
+    }
+
+    if (live == 0) break;
+
+    /* One Newton step on the live lanes */
+    greeks_ps_t g;
+    __m512 price = blackscholes_ps(S, K, r, v, T, puts, &g);
+
+    /* The price rises with the volatility */
+    __mmask16 above = _mm512_cmp_ps_mask(price, mkt, _CMP_GT_OQ);
+    hi = _mm512_mask_mov_ps(hi, above, v);
+    lo = _mm512_mask_mov_ps(lo, (__mmask16)~above, v);
+
+    /* Newton, or bisection when it leaves the bracket (NaN included) */
+    __m512    nv = _mm512_sub_ps(v, _mm512_div_ps(_mm512_sub_ps(price, mkt), g.vega));
+    __mmask16 in = _mm512_cmp_ps_mask(nv, lo, _CMP_GE_OQ) &
+                   _mm512_cmp_ps_mask(nv, hi, _CMP_LE_OQ);
+    nv = _mm512_mask_mov_ps(_mm512_mul_ps(_mm512_add_ps(lo, hi), _mm512_set1_ps(0.5f)),
+                            in, nv);
+
+    __m512 step = _mm512_abs_ps(_mm512_sub_ps(nv, v));
+
+    v   = _mm512_mask_mov_ps(v, live, nv);
+    its = _mm512_mask_add_epi32(its, live, its, _mm512_set1_epi32(1));
+
+    __mmask16 done = _mm512_mask_cmp_ps_mask(live, step, _mm512_set1_ps(IV_TOL), _CMP_LT_OQ) |
+                     _mm512_mask_cmpge_epi32_mask(live, its, _mm512_set1_epi32(IV_MAX_ITERS));
+
+    _mm512_mask_i32scatter_ps(output, done, idx, v, 4);
+
+    live &= (__mmask16)~done;
+    fill  = done;
+  }
+
+  /* Done */
+  return NULL;
+}
+#endif
@@ -6,18 +6,410 @@
  *  Description
  */
 
-/* Standard C includes */
+/* Standard C includes  */
 #include <stdlib.h>
+#include <math.h>
+#include <stdbool.h>
 
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
+#include "common/cpu.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "impl/vec.h"
+#include "impl/price.h"
+
+/* Variants, widest first */
+static const cpu_variant_t variants[] = {
+#if defined(__amd64__) || defined(__x86_64__)
+  { CPU_ISA_AVX512, impl_vector_avx512 },
+  { CPU_ISA_AVX2  , impl_vector_avx2   },
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+  { CPU_ISA_SVE   , impl_vector_sve    },
+  { CPU_ISA_NEON  , impl_vector_neon   },
+#endif
+  { CPU_ISA_SCALAR, impl_vector_scalar },
+};
+
+static cpu_dispatch_t dispatch = CPU_DISPATCH_INIT(variants);
+
+static const cpu_variant_t variants_pd[] = {
+#if defined(__amd64__) || defined(__x86_64__)
+  { CPU_ISA_AVX512, impl_vector_pd_avx512 },
+  { CPU_ISA_AVX2  , impl_vector_pd_avx2   },
+#endif
+  { CPU_ISA_SCALAR, impl_vector_pd_scalar },
+};
+
+static cpu_dispatch_t dispatch_pd = CPU_DISPATCH_INIT(variants_pd);
+
+static const cpu_variant_t variants_mixed[] = {
+#if defined(__amd64__) || defined(__x86_64__)
+  { CPU_ISA_AVX512, impl_vector_mixed_avx512 },
+  { CPU_ISA_AVX2  , impl_vector_mixed_avx2   },
+#endif
+  { CPU_ISA_SCALAR, impl_vector_mixed_scalar },
+};
+
+static cpu_dispatch_t dispatch_mixed = CPU_DISPATCH_INIT(variants_mixed);
+
+static const cpu_variant_t variants_aos[] = {
+#if defined(__amd64__) || defined(__x86_64__)
+  { CPU_ISA_AVX512, impl_vector_aos_avx512 },
+  { CPU_ISA_AVX2  , impl_vector_aos_avx2   },
+#endif
+  { CPU_ISA_SCALAR, impl_vector_aos_scalar },
+};
+
+static cpu_dispatch_t dispatch_aos = CPU_DISPATCH_INIT(variants_aos);
+
+static const cpu_variant_t variants_aosoa[] = {
+#if defined(__amd64__) || defined(__x86_64__)
+  { CPU_ISA_AVX512, impl_vector_aosoa_avx512 },
+  { CPU_ISA_AVX2  , impl_vector_aosoa_avx2   },
+#endif
+  { CPU_ISA_SCALAR, impl_vector_aosoa_scalar },
+};
+
+static cpu_dispatch_t dispatch_aosoa = CPU_DISPATCH_INIT(variants_aosoa);
+
+static const cpu_variant_t variants_iv[] = {
+#if defined(__amd64__) || defined(__x86_64__)
+  { CPU_ISA_AVX512, impl_vector_iv_avx512 },
+  { CPU_ISA_AVX2  , impl_vector_iv_avx2   },
+#endif
+  { CPU_ISA_SCALAR, impl_vector_iv_scalar },
+};
+
+static cpu_dispatch_t dispatch_iv = CPU_DISPATCH_INIT(variants_iv);
+
+/* Price n options by column into output; with greek_args, also their
+ * Greeks into its delta .. rho */
+PRICE_INLINE void soa_scalar(size_t num_stocks,
+                             const float* sptPrice  , const float* strike,
+                             const float* rate      , const float* volatility,
+                             const float* otime     , const char * otype,
+                             float*       output    , const args_t* greek_args)
+{
+  const bool greeks = (greek_args != NULL);
+
+  for (size_t i = 0; i < num_stocks; i++) {
+    float sqrt_t = sqrtf(otime[i]);
+    float den    = volatility[i] * sqrt_t;
+
+    float d1 = (logf(sptPrice[i] / strike[i]) +
+                (rate[i] + 0.5f * volatility[i] * volatility[i]) * otime[i]) / den;
+    float d2 = d1 - den;
+
+    float p_d1, p_d2;
+    float n_d1 = price_cndf(d1, &p_d1);
+    float n_d2 = price_cndf(d2, &p_d2);
+
+    float fv = strike[i] * expf(-rate[i] * otime[i]);
+
+    int   put = (otype[i] == 'P');
+
+    if (put) {
+      output[i] = fv * (1.0f - n_d2) - sptPrice[i] * (1.0f - n_d1);
+    } else {
+      output[i] = sptPrice[i] * n_d1 - fv * n_d2;
+    }
+
+    if (greeks) {
+      /* Puts use N(d1) - 1 and N(d2) - 1 in the call formulas */
+      float c_d1  = put ? n_d1 - 1.0f : n_d1;
+      float c_d2  = put ? n_d2 - 1.0f : n_d2;
+      float s_p   = sptPrice[i] * p_d1;
+      float fv_d2 = fv * c_d2;
+
+      greek_args->delta[i] = c_d1;
+      greek_args->gamma[i] = p_d1 / (sptPrice[i] * den);
+      greek_args->vega [i] = s_p * sqrt_t;
+      greek_args->theta[i] = -(s_p * volatility[i]) / (2.0f * sqrt_t) - rate[i] * fv_d2;
+      greek_args->rho  [i] = otime[i] * fv_d2;
+    }
+  }
+}
+
+/* Baseline variant for hosts without AVX2 */
+void* impl_vector_scalar(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Prices only: through the size-specialized copies */
+  if (parsed_args->delta == NULL) {
+    price_vector_scalar(parsed_args->num_stocks,
+                        parsed_args->sptPrice  , parsed_args->strike    ,
+                        parsed_args->rate      , parsed_args->volatility,
+                        parsed_args->otime     , parsed_args->otype     ,
+                        parsed_args->output    );
+    return NULL;
+  }
+
+  soa_scalar(parsed_args->num_stocks,
+             parsed_args->sptPrice  , parsed_args->strike    ,
+             parsed_args->rate      , parsed_args->volatility,
+             parsed_args->otime     , parsed_args->otype     ,
+             parsed_args->output    , parsed_args);
+
+  /* Done */
+  return NULL;
+}
+
+/* Typed single-batch entry point (impl/price.h) */
+void price_vector_scalar(size_t n,
+                         const float* sptPrice  , const float* strike    ,
+                         const float* rate      , const float* volatility,
+                         const float* otime     , const char * otype     ,
+                         float*       output)
+{
+  PRICE_SPECIALIZE(n, soa_scalar, sptPrice, strike, rate, volatility, otime, otype,
+                   output, NULL);
+}
+
+/* Double-precision baseline; libm's erfc gives N(x) exactly enough */
+void* impl_vector_pd_scalar(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t  num_stocks = parsed_args->num_stocks;
+
+  register const double* sptPrice   = parsed_args->pd.sptPrice  ;
+  register const double* strike     = parsed_args->pd.strike    ;
+  register const double* rate       = parsed_args->pd.rate      ;
+  register const double* volatility = parsed_args->pd.volatility;
+  register const double* otime      = parsed_args->pd.otime     ;
+  register const char  * otype      = parsed_args->otype        ;
+  register       double* output     = parsed_args->pd.output    ;
+
+  for (size_t i = 0; i < num_stocks; i++) {
+    double den = volatility[i] * sqrt(otime[i]);
+
+    double d1 = (log(sptPrice[i] / strike[i]) +
+                 (rate[i] + 0.5 * volatility[i] * volatility[i]) * otime[i]) / den;
+    double d2 = d1 - den;
+
+    double n_d1 = 0.5 * erfc(-d1 * M_SQRT1_2);
+    double n_d2 = 0.5 * erfc(-d2 * M_SQRT1_2);
+
+    double fv = strike[i] * exp(-rate[i] * otime[i]);
+
+    if (otype[i] == 'P') {
+      output[i] = fv * (1.0 - n_d2) - sptPrice[i] * (1.0 - n_d1);
+    } else {
+      output[i] = sptPrice[i] * n_d1 - fv * n_d2;
+    }
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* Mixed-precision baseline */
+void* impl_vector_mixed_scalar(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t num_stocks = parsed_args->num_stocks;
+
+  register const float* sptPrice   = parsed_args->sptPrice  ;
+  register const float* strike     = parsed_args->strike    ;
+  register const float* rate       = parsed_args->rate      ;
+  register const float* volatility = parsed_args->volatility;
+  register const float* otime      = parsed_args->otime     ;
+  register const char * otype      = parsed_args->otype     ;
+  register       float* output     = parsed_args->output    ;
+
+  for (size_t i = 0; i < num_stocks; i++) {
+    double v   = volatility[i];
+    double den = v * sqrt((double)otime[i]);
+
+    double d1 = (log((double)sptPrice[i] / strike[i]) +
+                 (rate[i] + 0.5 * v * v) * otime[i]) / den;
+    double d2 = d1 - den;
+
+    float pdf;
+    float n_d1 = price_cndf((float)d1, &pdf);
+    float n_d2 = price_cndf((float)d2, &pdf);
+
+    float fv = strike[i] * expf(-rate[i] * otime[i]);
+
+    if (otype[i] == 'P') {
+      output[i] = fv * (1.0f - n_d2) - sptPrice[i] * (1.0f - n_d1);
+    } else {
+      output[i] = sptPrice[i] * n_d1 - fv * n_d2;
+    }
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* AoS baseline */
+void* impl_vector_aos_scalar(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t        num_stocks = parsed_args->num_stocks;
+
+  register const option_rec_t* rec        = parsed_args->aos   ;
+  register       float*        output     = parsed_args->output;
+
+  for (size_t i = 0; i < num_stocks; i++) {
+    output[i] = price_one(rec[i].sptPrice, rec[i].strike,
+                          rec[i].rate    , rec[i].volatility,
+                          rec[i].otime   , rec[i].otype, NULL);
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* AoSoA baseline */
+void* impl_vector_aosoa_scalar(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t          num_stocks = parsed_args->num_stocks;
+
+  register const option_block_t* blk        = parsed_args->aosoa ;
+  register       float*          output     = parsed_args->output;
+
+  for (size_t i = 0; i < num_stocks; i++) {
+    const option_block_t* b = &blk[i / AOSOA_BLOCK];
+    size_t                j = i % AOSOA_BLOCK;
+
+    output[i] = price_one(b->sptPrice[j], b->strike    [j],
+                          b->rate    [j], b->volatility[j],
+                          b->otime   [j], b->otype     [j], NULL);
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* Typed variants of impl_vector, widest first (impl/price.h) */
+static const struct {
+  cpu_isa_t  isa;
+  price_fn_t fn;
+} price_variants[] = {
+#if defined(__amd64__) || defined(__x86_64__)
+  { CPU_ISA_AVX512, price_vector_avx512 },
+  { CPU_ISA_AVX2  , price_vector_avx2   },
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+  { CPU_ISA_SVE   , price_vector_sve    },
+  { CPU_ISA_NEON  , price_vector_neon   },
+#endif
+  { CPU_ISA_SCALAR, price_vector_scalar },
+};
+
+bool price_sized = true;
+
+price_fn_t price_select(void)
+{
+  int n = sizeof(price_variants) / sizeof(price_variants[0]);
+
+  for (int i = 0; i < n - 1; i++) {
+    if (cpu_isa_enabled(price_variants[i].isa)) return price_variants[i].fn;
+  }
+
+  return price_variants[n - 1].fn;
+}
 
 /* Alternative Implementation */
 void* impl_vector(void* args)
 {
+  return cpu_dispatch(&dispatch)(args);
+}
+
+void* impl_vector_pd(void* args)
+{
+  return cpu_dispatch(&dispatch_pd)(args);
+}
+
+void* impl_vector_mixed(void* args)
+{
+  return cpu_dispatch(&dispatch_mixed)(args);
+}
+
+void* impl_vector_aos(void* args)
+{
+  return cpu_dispatch(&dispatch_aos)(args);
+}
+
+void* impl_vector_aosoa(void* args)
+{
+  return cpu_dispatch(&dispatch_aosoa)(args);
+}
+
+/* Implied volatility of one option from its market price; see vec.h */
+static inline float implied_vol_one(float sptPrice, float strike, float rate,
+                                    float otime, char otype, float market)
+{
+  float v = sqrtf(2.0f * fabsf(logf(sptPrice / strike) + rate * otime) / otime);
+  v = fminf(fmaxf(v, IV_MIN), IV_MAX);
+
+  float lo = IV_MIN, hi = IV_MAX;
+
+  for (int it = 0; it < IV_MAX_ITERS; it++) {
+    float vega;
+    float price = price_one(sptPrice, strike, rate, v, otime, otype,
+                            &vega);
+
+    /* The price rises with the volatility */
+    if (price > market) hi = v;
+    else                lo = v;
+
+    float next = v - (price - market) / vega;
+    if (!(next >= lo && next <= hi)) next = 0.5f * (lo + hi);
+
+    float step = fabsf(next - v);
+    v = next;
+
+    if (step < IV_TOL) break;
+  }
+
+  return v;
+}
+
+/* Baseline implied-volatility variant: one option at a time */
+void* impl_vector_iv_scalar(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register       size_t num_stocks = parsed_args->num_stocks;
+
+  register const float* sptPrice   = parsed_args->sptPrice;
+  register const float* strike     = parsed_args->strike  ;
+  register const float* rate       = parsed_args->rate    ;
+  register const float* otime      = parsed_args->otime   ;
+  register const char * otype      = parsed_args->otype   ;
+  register const float* market     = parsed_args->market  ;
+  register       float* output     = parsed_args->output  ;
+
+  for (size_t i = 0; i < num_stocks; i++) {
+    output[i] = implied_vol_one(sptPrice[i], strike[i], rate[i], otime[i],
+                                otype[i], market[i]);
+  }
+
+  /* Done */
   return NULL;
 }
+
+void* impl_vector_iv(void* args)
+{
+  return cpu_dispatch(&dispatch_iv)(args);
+}
@@ -3,7 +3,9 @@
  * Author: Khalid Al-Hawaj
  * Date  : 13 Nov. 2023
  *
- * Header for the vectorized function.
+ * Header for the vectorized function. impl_vector dispatches at runtime
+ * to the widest variant the host supports (see common/cpu.h); the
+ * variants live in vec.<isa>.c.
  */
 
 #ifndef __IMPL_VEC_H_
@@ -12,4 +14,61 @@
 /* Function declaration */
 void* impl_vector(void* args);
 
+/* Per-ISA variants */
+void* impl_vector_scalar(void* args);
+void* impl_vector_avx2  (void* args);
+void* impl_vector_avx512(void* args);
+void* impl_vector_neon  (void* args);
+void* impl_vector_sve   (void* args);
+
+/* Double precision, on args->pd (--precision double) */
+void* impl_vector_pd       (void* args);
+void* impl_vector_pd_scalar(void* args);
+void* impl_vector_pd_avx2  (void* args);
+void* impl_vector_pd_avx512(void* args);
+
+/* Mixed precision: float in and out, log(S/K), d1 and d2 in double, so
+ * the cancellation in d1 for long-dated options does not cost digits
+ * (--precision mixed) */
+void* impl_vector_mixed       (void* args);
+void* impl_vector_mixed_scalar(void* args);
+void* impl_vector_mixed_avx2  (void* args);
+void* impl_vector_mixed_avx512(void* args);
+
+/* The same kernel over args->aos records (gathering the fields) and over
+ * args->aosoa blocks (--layout aos, --layout aosoa) */
+void* impl_vector_aos          (void* args);
+void* impl_vector_aos_scalar   (void* args);
+void* impl_vector_aos_avx2     (void* args);
+void* impl_vector_aos_avx512   (void* args);
+
+void* impl_vector_aosoa        (void* args);
+void* impl_vector_aosoa_scalar (void* args);
+void* impl_vector_aosoa_avx2   (void* args);
+void* impl_vector_aosoa_avx512 (void* args);
+
+/* Implied volatility (--implied-vol): the Newton iteration
+ *
+ *   v' = v - (price(v) - market) / vega(v)
+ *
+ * per option, from the Manaster-Koehler guess sqrt(2 |log(S / K) + r T| / T)
+ * (where vega peaks, so the iteration converges monotonically). Each
+ * price narrows a bracket, from [IV_MIN, IV_MAX], around the solution and
+ * a step leaving it bisects it instead: far out of the money, vega and the
+ * price vanish into rounding and plain Newton would bounce between the
+ * bounds. An option is done once a step is under IV_TOL or after
+ * IV_MAX_ITERS steps. Lanes converge at different rates: the AVX2 variant
+ * freezes finished lanes until all 8 of a vector are done, the AVX-512 one
+ * refills them with the next options (expand loads) so every step prices
+ * 16 live options. */
+#define IV_MIN       1e-3f
+#define IV_MAX       5.0f
+#define IV_TOL       1e-5f
+#define IV_MAX_ITERS 32
+
+void* impl_vector_iv       (void* args);
+void* impl_vector_iv_scalar(void* args);
+void* impl_vector_iv_avx2  (void* args);
+void* impl_vector_iv_avx512(void* args);
+
 #endif //__IMPL_VEC_H_
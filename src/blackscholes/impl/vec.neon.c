@@ -0,0 +1,225 @@
+/* vec.neon.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * NEON variant of the single-precision SoA kernel, Greeks included; the
+ * same formulas as vec.avx2.c on 4 lanes, with log/exp/CNDF from
+ * common/vmath.h. The other precisions and layouts use the scalar
+ * variants on aarch64.
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+/*  -> SIMD header file  */
+#if defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+#include <arm_neon.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/vmath.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/vec.h"
+#include "impl/price.h"
+
+#if defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+/* Greeks of 4 options */
+typedef struct {
+  float32x4_t delta, gamma, vega, theta, rho;
+} greeks_f32x4_t;
+
+/* Price 4 European options (no dividends), as blackscholes_ps */
+static inline float32x4_t blackscholes_f32x4(float32x4_t sptPrice, float32x4_t strike,
+                                             float32x4_t rate    , float32x4_t volatility,
+                                             float32x4_t otime   , uint32x4_t  put_mask,
+                                             greeks_f32x4_t* g)
+{
+  /* d1 = (log(S / K) + (r + v^2 / 2) * T) / (v * sqrt(T)) */
+  float32x4_t log_term = vlog_f32(vdivq_f32(sptPrice, strike));
+
+  float32x4_t pwr_term = vmulq_f32(vmulq_f32(volatility, volatility),
+                                   vdupq_n_f32(0.5f));
+
+  float32x4_t d1 = vfmaq_f32(log_term, vaddq_f32(rate, pwr_term), otime);
+
+  float32x4_t sqrt_t = vsqrtq_f32(otime);
+  float32x4_t den    = vmulq_f32(volatility, sqrt_t);
+  d1 = vdivq_f32(d1, den);
+
+  /* d2 = d1 - v * sqrt(T) */
+  float32x4_t d2 = vsubq_f32(d1, den);
+
+  float32x4_t p_d1, p_d2;
+  float32x4_t n_d1 = vcndf_pdf_f32(d1, &p_d1);
+  float32x4_t n_d2 = vcndf_pdf_f32(d2, &p_d2);
+
+  /* Future value of the strike: K * exp(-r * T) */
+  float32x4_t fv = vmulq_f32(strike, vexp_f32(vnegq_f32(vmulq_f32(rate, otime))));
+
+  /* call = S * N(d1) - FV * N(d2)             *
+   * put  = FV * (1 - N(d2)) - S * (1 - N(d1)) */
+  float32x4_t one  = vdupq_n_f32(1.0f);
+  float32x4_t call = vfmsq_f32(vmulq_f32(sptPrice, n_d1), fv, n_d2);
+  float32x4_t put  = vfmsq_f32(vmulq_f32(fv, vsubq_f32(one, n_d2)),
+                               sptPrice, vsubq_f32(one, n_d1));
+
+  if (g != NULL) {
+    /* Puts use N(d1) - 1 and N(d2) - 1 in the call formulas */
+    float32x4_t put_one = vreinterpretq_f32_u32(vandq_u32(put_mask,
+                                                vreinterpretq_u32_f32(one)));
+    float32x4_t c_d1    = vsubq_f32(n_d1, put_one);
+    float32x4_t c_d2    = vsubq_f32(n_d2, put_one);
+
+    /* S * N'(d1) appears in gamma, vega and theta */
+    float32x4_t s_p     = vmulq_f32(sptPrice, p_d1);
+
+    g->delta = c_d1;
+    g->gamma = vdivq_f32(p_d1, vmulq_f32(sptPrice, den));
+    g->vega  = vmulq_f32(s_p, sqrt_t);
+
+    /* theta = -S * N'(d1) * v / (2 * sqrt(T)) - r * FV * N(+-d2) */
+    float32x4_t t_s   = vdivq_f32(vmulq_f32(s_p, volatility),
+                                  vaddq_f32(sqrt_t, sqrt_t));
+    float32x4_t fv_d2 = vmulq_f32(fv, c_d2);
+
+    g->theta = vfmsq_f32(vnegq_f32(t_s), rate, fv_d2);
+    g->rho   = vmulq_f32(otime, fv_d2);
+  }
+
+  return vbslq_f32(put_mask, put, call);
+}
+
+/* Expand 4 option-type bytes into a per-lane put mask */
+static inline uint32x4_t otype_put_mask(const char* otype)
+{
+  uint32_t word;
+  memcpy(&word, otype, sizeof(word));
+
+  uint8x8_t  bytes = vreinterpret_u8_u32(vdup_n_u32(word));
+  uint32x4_t lanes = vmovl_u16(vget_low_u16(vmovl_u8(bytes)));
+
+  return vceqq_u32(lanes, vdupq_n_u32('P'));
+}
+
+/* Price n options by column into output; with greek_args, also their
+ * Greeks into its delta .. rho */
+PRICE_INLINE void soa_neon(size_t num_stocks,
+                           const float* sptPrice  , const float* strike,
+                           const float* rate      , const float* volatility,
+                           const float* otime     , const char * otype,
+                           float*       output    , const args_t* greek_args)
+{
+  const bool     greeks = (greek_args != NULL);
+  greeks_f32x4_t g;
+
+  const size_t max_vlen = 16 / sizeof(float);
+
+  /* Main loop: full vectors only */
+  size_t i = 0;
+  for (; i + max_vlen <= num_stocks; i += max_vlen) {
+    float32x4_t price = blackscholes_f32x4(vld1q_f32(&sptPrice  [i]),
+                                           vld1q_f32(&strike    [i]),
+                                           vld1q_f32(&rate      [i]),
+                                           vld1q_f32(&volatility[i]),
+                                           vld1q_f32(&otime     [i]),
+                                           otype_put_mask(&otype[i]),
+                                           greeks ? &g : NULL);
+
+    vst1q_f32(&output[i], price);
+
+    if (greeks) {
+      vst1q_f32(&greek_args->delta[i], g.delta);
+      vst1q_f32(&greek_args->gamma[i], g.gamma);
+      vst1q_f32(&greek_args->vega [i], g.vega );
+      vst1q_f32(&greek_args->theta[i], g.theta);
+      vst1q_f32(&greek_args->rho  [i], g.rho  );
+    }
+  }
+
+  /* Tail: num_stocks % 4 options, through buffers padded with a valid
+   * option (no lane of the padding produces a NaN or an infinity) */
+  if (i < num_stocks) {
+    size_t rem   = num_stocks - i;
+    size_t bytes = rem * sizeof(float);
+
+    float in[5][4], out[6][4];
+    char  types[4] = { 'C', 'C', 'C', 'C' };
+
+    for (int f = 0; f < 5; f++) {
+      for (int j = 0; j < 4; j++) in[f][j] = 1.0f;
+    }
+    memcpy(in[0], &sptPrice  [i], bytes);
+    memcpy(in[1], &strike    [i], bytes);
+    memcpy(in[2], &rate      [i], bytes);
+    memcpy(in[3], &volatility[i], bytes);
+    memcpy(in[4], &otime     [i], bytes);
+    memcpy(types, &otype     [i], rem);
+
+    vst1q_f32(out[0], blackscholes_f32x4(vld1q_f32(in[0]), vld1q_f32(in[1]),
+                                         vld1q_f32(in[2]), vld1q_f32(in[3]),
+                                         vld1q_f32(in[4]),
+                                         otype_put_mask(types),
+                                         greeks ? &g : NULL));
+    memcpy(&output[i], out[0], bytes);
+
+    if (greeks) {
+      vst1q_f32(out[1], g.delta);
+      vst1q_f32(out[2], g.gamma);
+      vst1q_f32(out[3], g.vega );
+      vst1q_f32(out[4], g.theta);
+      vst1q_f32(out[5], g.rho  );
+
+      memcpy(&greek_args->delta[i], out[1], bytes);
+      memcpy(&greek_args->gamma[i], out[2], bytes);
+      memcpy(&greek_args->vega [i], out[3], bytes);
+      memcpy(&greek_args->theta[i], out[4], bytes);
+      memcpy(&greek_args->rho  [i], out[5], bytes);
+    }
+  }
+}
+
+/* NEON variant */
+void* impl_vector_neon(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Prices only: through the size-specialized copies */
+  if (parsed_args->delta == NULL) {
+    price_vector_neon(parsed_args->num_stocks,
+                      parsed_args->sptPrice  , parsed_args->strike    ,
+                      parsed_args->rate      , parsed_args->volatility,
+                      parsed_args->otime     , parsed_args->otype     ,
+                      parsed_args->output    );
+    return NULL;
+  }
+
+  soa_neon(parsed_args->num_stocks,
+           parsed_args->sptPrice  , parsed_args->strike    ,
+           parsed_args->rate      , parsed_args->volatility,
+           parsed_args->otime     , parsed_args->otype     ,
+           parsed_args->output    , parsed_args);
+
+  /* Done */
+  return NULL;
+}
+
+/* Typed single-batch entry point (impl/price.h) */
+void price_vector_neon(size_t n,
+                       const float* sptPrice  , const float* strike    ,
+                       const float* rate      , const float* volatility,
+                       const float* otime     , const char * otype     ,
+                       float*       output)
+{
+  PRICE_SPECIALIZE(n, soa_neon, sptPrice, strike, rate, volatility, otime, otype,
+                   output, NULL);
+}
+#endif
@@ -0,0 +1,185 @@
+/* vec.sve.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * SVE variant of the single-precision SoA kernel, Greeks included: as
+ * vec.neon.c, vector-length agnostic, with the tail as one more
+ * predicated iteration. Without an SVE toolchain (Darwin) it forwards
+ * to the NEON variant; cpu_has_isa() never picks it there.
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+/*  -> SIMD header file  */
+#if defined(__ARM_FEATURE_SVE)
+#include <arm_sve.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/vmath.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/vec.h"
+#include "impl/price.h"
+
+#if defined(__ARM_FEATURE_SVE)
+/* Greeks of one vector of options */
+typedef struct {
+  svfloat32_t delta, gamma, vega, theta, rho;
+} greeks_sv_t;
+
+/* Price the active lanes of pg, as blackscholes_ps */
+static inline svfloat32_t blackscholes_sv(svbool_t pg,
+                                          svfloat32_t sptPrice, svfloat32_t strike,
+                                          svfloat32_t rate    , svfloat32_t volatility,
+                                          svfloat32_t otime   , svbool_t    put_mask,
+                                          greeks_sv_t* g)
+{
+  /* d1 = (log(S / K) + (r + v^2 / 2) * T) / (v * sqrt(T)) */
+  svfloat32_t log_term = svlog_f32_x(pg, svdiv_f32_x(pg, sptPrice, strike));
+
+  svfloat32_t pwr_term = svmul_n_f32_x(pg, svmul_f32_x(pg, volatility, volatility), 0.5f);
+
+  svfloat32_t d1 = svmla_f32_x(pg, log_term, svadd_f32_x(pg, rate, pwr_term), otime);
+
+  svfloat32_t sqrt_t = svsqrt_f32_x(pg, otime);
+  svfloat32_t den    = svmul_f32_x(pg, volatility, sqrt_t);
+  d1 = svdiv_f32_x(pg, d1, den);
+
+  /* d2 = d1 - v * sqrt(T) */
+  svfloat32_t d2 = svsub_f32_x(pg, d1, den);
+
+  svfloat32_t p_d1, p_d2;
+  svfloat32_t n_d1 = svcndf_pdf_f32_x(pg, d1, &p_d1);
+  svfloat32_t n_d2 = svcndf_pdf_f32_x(pg, d2, &p_d2);
+
+  /* Future value of the strike: K * exp(-r * T) */
+  svfloat32_t fv = svmul_f32_x(pg, strike,
+                               svexp_f32_x(pg, svneg_f32_x(pg, svmul_f32_x(pg, rate, otime))));
+
+  /* call = S * N(d1) - FV * N(d2)             *
+   * put  = FV * (1 - N(d2)) - S * (1 - N(d1)) */
+  svfloat32_t call = svmls_f32_x(pg, svmul_f32_x(pg, sptPrice, n_d1), fv, n_d2);
+  svfloat32_t put  = svmls_f32_x(pg, svmul_f32_x(pg, fv, svsubr_n_f32_x(pg, n_d2, 1.0f)),
+                                 sptPrice, svsubr_n_f32_x(pg, n_d1, 1.0f));
+
+  if (g != NULL) {
+    /* Puts use N(d1) - 1 and N(d2) - 1 in the call formulas */
+    svfloat32_t c_d1 = svsub_n_f32_m(put_mask, n_d1, 1.0f);
+    svfloat32_t c_d2 = svsub_n_f32_m(put_mask, n_d2, 1.0f);
+
+    /* S * N'(d1) appears in gamma, vega and theta */
+    svfloat32_t s_p  = svmul_f32_x(pg, sptPrice, p_d1);
+
+    g->delta = c_d1;
+    g->gamma = svdiv_f32_x(pg, p_d1, svmul_f32_x(pg, sptPrice, den));
+    g->vega  = svmul_f32_x(pg, s_p, sqrt_t);
+
+    /* theta = -S * N'(d1) * v / (2 * sqrt(T)) - r * FV * N(+-d2) */
+    svfloat32_t t_s   = svdiv_f32_x(pg, svmul_f32_x(pg, s_p, volatility),
+                                    svadd_f32_x(pg, sqrt_t, sqrt_t));
+    svfloat32_t fv_d2 = svmul_f32_x(pg, fv, c_d2);
+
+    g->theta = svmls_f32_x(pg, svneg_f32_x(pg, t_s), rate, fv_d2);
+    g->rho   = svmul_f32_x(pg, otime, fv_d2);
+  }
+
+  return svsel_f32(put_mask, put, call);
+}
+
+/* Price n options by column into output; with greek_args, also their
+ * Greeks into its delta .. rho */
+PRICE_INLINE void soa_sve(size_t num_stocks,
+                          const float* sptPrice  , const float* strike,
+                          const float* rate      , const float* volatility,
+                          const float* otime     , const char * otype,
+                          float*       output    , const args_t* greek_args)
+{
+  const bool   greeks = (greek_args != NULL);
+  const size_t vlen   = svcntw();
+  greeks_sv_t  g;
+
+  for (size_t i = 0; i < num_stocks; i += vlen) {
+    svbool_t pg = svwhilelt_b32_u64(i, num_stocks);
+
+    /* Inactive lanes load 0, which only they see */
+    svbool_t put_mask = svcmpeq_n_u32(pg, svld1ub_u32(pg, (const uint8_t*)&otype[i]), 'P');
+
+    svfloat32_t price = blackscholes_sv(pg,
+                                        svld1_f32(pg, &sptPrice  [i]),
+                                        svld1_f32(pg, &strike    [i]),
+                                        svld1_f32(pg, &rate      [i]),
+                                        svld1_f32(pg, &volatility[i]),
+                                        svld1_f32(pg, &otime     [i]),
+                                        put_mask, greeks ? &g : NULL);
+
+    svst1_f32(pg, &output[i], price);
+
+    if (greeks) {
+      svst1_f32(pg, &greek_args->delta[i], g.delta);
+      svst1_f32(pg, &greek_args->gamma[i], g.gamma);
+      svst1_f32(pg, &greek_args->vega [i], g.vega );
+      svst1_f32(pg, &greek_args->theta[i], g.theta);
+      svst1_f32(pg, &greek_args->rho  [i], g.rho  );
+    }
+  }
+}
+
+/* SVE variant */
+void* impl_vector_sve(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Prices only: through the size-specialized copies */
+  if (parsed_args->delta == NULL) {
+    price_vector_sve(parsed_args->num_stocks,
+                     parsed_args->sptPrice  , parsed_args->strike    ,
+                     parsed_args->rate      , parsed_args->volatility,
+                     parsed_args->otime     , parsed_args->otype     ,
+                     parsed_args->output    );
+    return NULL;
+  }
+
+  soa_sve(parsed_args->num_stocks,
+          parsed_args->sptPrice  , parsed_args->strike    ,
+          parsed_args->rate      , parsed_args->volatility,
+          parsed_args->otime     , parsed_args->otype     ,
+          parsed_args->output    , parsed_args);
+
+  /* Done */
+  return NULL;
+}
+
+/* Typed single-batch entry point (impl/price.h) */
+void price_vector_sve(size_t n,
+                      const float* sptPrice  , const float* strike    ,
+                      const float* rate      , const float* volatility,
+                      const float* otime     , const char * otype     ,
+                      float*       output)
+{
+  PRICE_SPECIALIZE(n, soa_sve, sptPrice, strike, rate, volatility, otime, otype,
+                   output, NULL);
+}
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+void* impl_vector_sve(void* args)
+{
+  return impl_vector_neon(args);
+}
+
+void price_vector_sve(size_t n,
+                      const float* sptPrice  , const float* strike    ,
+                      const float* rate      , const float* volatility,
+                      const float* otime     , const char * otype     ,
+                      float*       output)
+{
+  price_vector_neon(n, sptPrice, strike, rate, volatility, otime, otype, output);
+}
+#endif
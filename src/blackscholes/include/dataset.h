@@ -6,12 +6,17 @@
  * This file helps with generation of different datasets.
  * The defined function will take as an input the size of the dataset.
  * Then, the function will replicate a set of pre-calculated dataset in
- * optionData.txt over and over again.
+ * optionData.txt over and over again, in parallel over the worker pool
+ * (impl/para.h).
  */
 
 #ifndef __INCLUDE_DATASET_H_
 #define __INCLUDE_DATASET_H_
 
+#include <string.h>
+
+#include "impl/para.h"
+
 #define __dataset_name(x) ((x == 0? "test"  : \
                            (x == 1? "dev"   : \
                            (x == 2? "small" : \
@@ -42,32 +47,60 @@ optionData_t refDataSet[] = {
 
 const int REF_DATASET_SIZE = sizeof(refDataSet) / sizeof(optionData_t);
 
+#define REF_DATASET_LEN (sizeof(refDataSet) / sizeof(optionData_t))
+
+/* The reference dataset transposed to columns, so that every chunk is a
+ * handful of contiguous (vectorized) copies instead of a gather */
+static struct {
+  float sptPrice  [REF_DATASET_LEN];
+  float strike    [REF_DATASET_LEN];
+  float rate      [REF_DATASET_LEN];
+  float volatility[REF_DATASET_LEN];
+  float otime     [REF_DATASET_LEN];
+  char  otype     [REF_DATASET_LEN];
+  float price     [REF_DATASET_LEN];
+} refColumns;
+
+/* Fill one chunk (starting at option begin) from the reference columns */
+static void genDatasetChunk(void* args, size_t begin)
+{
+  args_t* chunk      = (args_t*)args;
+  size_t  num_stocks = chunk->num_stocks;
+
+  size_t  ref_i      = begin % REF_DATASET_LEN;
+
+  for (size_t i = 0; i < num_stocks; ) {
+    size_t n = REF_DATASET_LEN - ref_i;
+    if (n > num_stocks - i) n = num_stocks - i;
+
+    memcpy(&chunk->sptPrice  [i], &refColumns.sptPrice  [ref_i], n * sizeof(float));
+    memcpy(&chunk->strike    [i], &refColumns.strike    [ref_i], n * sizeof(float));
+    memcpy(&chunk->rate      [i], &refColumns.rate      [ref_i], n * sizeof(float));
+    memcpy(&chunk->volatility[i], &refColumns.volatility[ref_i], n * sizeof(float));
+    memcpy(&chunk->otime     [i], &refColumns.otime     [ref_i], n * sizeof(float));
+    memcpy(&chunk->otype     [i], &refColumns.otype     [ref_i], n * sizeof(char ));
+    memcpy(&chunk->output    [i], &refColumns.price     [ref_i], n * sizeof(float));
+
+    i    += n;
+    ref_i = 0;
+  }
+}
+
+/* Replicate the reference dataset over the arrays of args (the reference
+ * prices go to args->output). Every thread of the pool writes its own
+ * impl_parallel chunk, which is also what places the pages. */
 void genDataset(args_t* args) {
-  /* Get all needed pointers */
-  size_t num_stocks = args->num_stocks;
-
-  float* sptPrice   = args->sptPrice  ;
-  float* strike     = args->strike    ;
-  float* rate       = args->rate      ;
-  float* volatility = args->volatility;
-  float* otime      = args->otime     ;
-  char * otype      = args->otype     ;
-  float* ref        = args->output    ;
-
-  /* Copy the data from the reference dataset */
-  for (size_t i = 0; i < num_stocks; i++) {
-    size_t ref_i = i % REF_DATASET_SIZE;
-
-    sptPrice[i]   = refDataSet[ref_i].sptPrice;
-    strike[i]     = refDataSet[ref_i].strike;
-    rate[i]       = refDataSet[ref_i].rate;
-    volatility[i] = refDataSet[ref_i].volatility;
-    otime[i]      = refDataSet[ref_i].otime;
-    otype[i]      = refDataSet[ref_i].otype;
-
-    ref[i]        = refDataSet[ref_i].price;
+  for (size_t i = 0; i < REF_DATASET_LEN; i++) {
+    refColumns.sptPrice  [i] = refDataSet[i].sptPrice;
+    refColumns.strike    [i] = refDataSet[i].strike;
+    refColumns.rate      [i] = refDataSet[i].rate;
+    refColumns.volatility[i] = refDataSet[i].volatility;
+    refColumns.otime     [i] = refDataSet[i].otime;
+    refColumns.otype     [i] = refDataSet[i].otype;
+    refColumns.price     [i] = refDataSet[i].price;
   }
+
+  para_for_chunks(args, genDatasetChunk);
 }
 
 #endif //__INCLUDE_DATASET_H_
-
@@ -0,0 +1,85 @@
+/* dsfile.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the binary dataset format for Black-Scholes inputs.
+ * A file is a fixed header followed by one section per column (SoA), so
+ * mapping it gives args_t its input pointers directly, with no parsing
+ * and no copies:
+ *
+ *   offset 0        dsfile_header_t
+ *   offset[col]     count elements of column col (float, or char for
+ *                   the option type), page aligned and followed by at
+ *                   least DSFILE_PAD bytes of zero padding
+ *
+ * The padding lets the benchmark put its guard word right after the
+ * reference prices; the mapping is private, so that never reaches the
+ * file. Values are stored in host byte order.
+ *
+ * Files are produced from the PARSEC text format (a count line, then one
+ * "S K r q vol T P/C divs DGref" row per option) with --convert, so real
+ * portfolios run at their own size instead of a replicated 1000-option
+ * pattern.
+ */
+
+#ifndef __INCLUDE_DSFILE_H_
+#define __INCLUDE_DSFILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DSFILE_MAGIC    "BSDATA\r\n"
+#define DSFILE_VERSION  1
+#define DSFILE_ALIGN    4096
+#define DSFILE_PAD      64
+
+typedef enum {
+  DSFILE_SPTPRICE = 0,
+  DSFILE_STRIKE,
+  DSFILE_RATE,
+  DSFILE_VOLATILITY,
+  DSFILE_OTIME,
+  DSFILE_OTYPE,
+  DSFILE_PRICE,          /* Reference price */
+  DSFILE_NCOLS
+} dsfile_col_t;
+
+typedef struct {
+  char     magic[8];
+  uint32_t version;
+  uint32_t ncols;
+  uint64_t count;
+  uint64_t offset[DSFILE_NCOLS];   /* Section start, from the file start */
+  uint32_t elsize[DSFILE_NCOLS];   /* Bytes per element                   */
+} dsfile_header_t;
+
+/* A mapped dataset */
+typedef struct {
+  void*    base;
+  size_t   length;
+  size_t   count;
+
+  float*   sptPrice;
+  float*   strike;
+  float*   rate;
+  float*   volatility;
+  float*   otime;
+  char *   otype;
+  float*   price;
+} dsfile_t;
+
+/* Open and validate path for reading; returns the descriptor, or -1 with
+ * the reason printed. length is the size the layout implies. */
+int     dsfile_open   (const char* path, dsfile_header_t* hdr,
+                       uint64_t* length);
+
+/* Map path; prints the reason and returns -1 on failure */
+int     dsfile_map    (const char* path, dsfile_t* ds);
+void    dsfile_unmap  (dsfile_t* ds);
+
+/* Convert a PARSEC text dataset; returns the number of options written,
+ * or -1 (with the reason printed) on failure */
+int64_t dsfile_convert(const char* txt_path, const char* out_path);
+
+#endif //__INCLUDE_DSFILE_H_
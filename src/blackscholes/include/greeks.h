@@ -0,0 +1,83 @@
+/* greeks.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file generates the reference Greeks that --greeks is checked
+ * against. They are taken by central finite differences of a double
+ * precision price (with an exact CNDF) rather than from the closed forms
+ * the kernels use, so a wrong formula cannot verify against itself. Steps
+ * are relative (1e-4) except for the rate, which may be zero; truncation
+ * is then around 1e-8 of each Greek and cancellation far below that in
+ * double, well under the float kernels' own error.
+ */
+
+#ifndef __INCLUDE_GREEKS_H_
+#define __INCLUDE_GREEKS_H_
+
+#include <math.h>
+
+#include "impl/para.h"
+
+#define GREEKS_STEP      1e-4
+#define GREEKS_RATE_STEP 1e-5
+
+static double greeksPrice(double S, double K, double r, double v, double T,
+                          int put)
+{
+  double den = v * sqrt(T);
+  double d1  = (log(S / K) + (r + 0.5 * v * v) * T) / den;
+  double d2  = d1 - den;
+
+  double n_d1 = 0.5 * erfc(-d1 * M_SQRT1_2);
+  double n_d2 = 0.5 * erfc(-d2 * M_SQRT1_2);
+  double fv   = K * exp(-r * T);
+
+  return put ? fv * (1.0 - n_d2) - S * (1.0 - n_d1)
+             : S * n_d1 - fv * n_d2;
+}
+
+/* Fill the Greeks of one chunk from its inputs */
+static void genGreeksChunk(void* args, size_t begin)
+{
+  args_t* chunk = (args_t*)args;
+
+  for (size_t i = 0; i < chunk->num_stocks; i++) {
+    double S   = chunk->sptPrice  [i];
+    double K   = chunk->strike    [i];
+    double r   = chunk->rate      [i];
+    double v   = chunk->volatility[i];
+    double T   = chunk->otime     [i];
+    int    put = (chunk->otype[i] == 'P');
+
+    double hS  = GREEKS_STEP * S;
+    double hv  = GREEKS_STEP * v;
+    double hT  = GREEKS_STEP * T;
+    double hr  = GREEKS_RATE_STEP;
+
+    double p   = greeksPrice(S     , K, r     , v     , T     , put);
+    double pSu = greeksPrice(S + hS, K, r     , v     , T     , put);
+    double pSd = greeksPrice(S - hS, K, r     , v     , T     , put);
+    double pvu = greeksPrice(S     , K, r     , v + hv, T     , put);
+    double pvd = greeksPrice(S     , K, r     , v - hv, T     , put);
+    double pTu = greeksPrice(S     , K, r     , v     , T + hT, put);
+    double pTd = greeksPrice(S     , K, r     , v     , T - hT, put);
+    double pru = greeksPrice(S     , K, r + hr, v     , T     , put);
+    double prd = greeksPrice(S     , K, r - hr, v     , T     , put);
+
+    chunk->delta[i] = (float)((pSu - pSd) / (2.0 * hS));
+    chunk->gamma[i] = (float)((pSu - 2.0 * p + pSd) / (hS * hS));
+    chunk->vega [i] = (float)((pvu - pvd) / (2.0 * hv));
+    /* Theta is the decay as time passes, i.e. as T shrinks */
+    chunk->theta[i] = (float)(-(pTu - pTd) / (2.0 * hT));
+    chunk->rho  [i] = (float)((pru - prd) / (2.0 * hr));
+  }
+}
+
+/* Reference Greeks of the options in args, written to its Greek arrays in
+ * parallel over the worker pool */
+void genGreeks(args_t* args) {
+  para_for_chunks(args, genGreeksChunk);
+}
+
+#endif //__INCLUDE_GREEKS_H_
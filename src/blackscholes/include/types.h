@@ -9,6 +9,57 @@
 #ifndef __INCLUDE_TYPES_H_
 #define __INCLUDE_TYPES_H_
 
+/* Precision of the arithmetic (--precision) */
+typedef enum {
+  PRECISION_SINGLE = 0,  /* float throughout                          */
+  PRECISION_DOUBLE,      /* double inputs, arithmetic and prices      */
+  PRECISION_MIXED,       /* float inputs and prices, log(S/K), d1 and
+                            d2 in double                              */
+} precision_t;
+
+/* Layout of the option inputs (--layout); prices are always a column */
+typedef enum {
+  LAYOUT_SOA = 0,        /* One array per field                       */
+  LAYOUT_AOS,            /* option_rec_t records, as a feed delivers  */
+  LAYOUT_AOSOA,          /* option_block_t blocks of AOSOA_BLOCK      */
+} layout_t;
+
+/* One option record (AoS). The char pads the record to 24 bytes. */
+typedef struct {
+  float sptPrice  ;
+  float strike    ;
+  float rate      ;
+  float volatility;
+  float otime     ;
+  char  otype     ;
+} option_rec_t;
+
+/* AOSOA_BLOCK options field by field (AoSoA): every field of a block is
+ * one full AVX-512 vector, or two AVX2 ones, and every block starts on a
+ * cache line. The last block of a dataset may be partial. */
+#define AOSOA_BLOCK 16
+
+typedef struct {
+  _Alignas(64)
+  float sptPrice  [AOSOA_BLOCK];
+  float strike    [AOSOA_BLOCK];
+  float rate      [AOSOA_BLOCK];
+  float volatility[AOSOA_BLOCK];
+  float otime     [AOSOA_BLOCK];
+  char  otype     [AOSOA_BLOCK];
+} option_block_t;
+
+/* Double-precision inputs and prices, for PRECISION_DOUBLE; the option
+ * types stay in args_t.otype */
+typedef struct {
+  double* sptPrice  ;
+  double* strike    ;
+  double* rate      ;
+  double* volatility;
+  double* otime     ;
+  double* output    ;
+} args_pd_t;
+
 typedef struct {
   size_t num_stocks;
 
@@ -20,8 +71,44 @@ typedef struct {
   char * otype     ;
   float* output    ;
 
+  /* Optional Greeks (--greeks), filled in the same pass as output: all
+   * NULL, or all set. Vega, theta and rho are per unit of volatility,
+   * year and rate. */
+  float* delta     ;
+  float* gamma     ;
+  float* vega      ;
+  float* theta     ;
+  float* rho       ;
+
+  /* Market prices the implied-volatility kernels solve for (--implied-vol),
+   * NULL otherwise; they write volatilities to output and ignore
+   * volatility */
+  float* market    ;
+
+  /* Set when the double-precision kernels run, NULL otherwise */
+  args_pd_t pd;
+
+  /* Inputs for the AoS and AoSoA kernels (--layout), NULL otherwise;
+   * aosoa always starts on a block boundary */
+  option_rec_t*   aos;
+  option_block_t* aosoa;
+
   int    cpu;
   int    nthreads;
+
+  struct pool_t* pool;
+
+  /* Batched pipeline state (--stream, impl/stream.h), or NULL */
+  struct stream_t* stream;
+
+  /* Per-call timing state (--latency, impl/latency.h), or NULL */
+  struct latency_t* latency;
+
+  /* Request-queue service state (--serve, impl/serve.h), or NULL */
+  struct serve_t* serve;
+
+  /* Ranks of impl_dist (impl/dist.h, common/dist.h) */
+  struct dist_t* dist;
 } args_t;
 
 #endif //__INCLUDE_TYPES_H_
@@ -4,27 +4,46 @@
  * Date  : 12 Nov. 2023
  *
  * This file is structured to call different implementation of the same
- * algorithm/microbenchmark. The file will allocate 3 output arrays one
- * for: scalar naive impl, scalar opt impl, vectorized impl. As it stands
- * the file will allocate and initialize with random data one input array
- * of type 'byte'. To check correctness, the file allocate a 'ref' array;
- * to calculate this 'ref' array, the file will invoke a ref_impl, which
- * is supposed to be functionally correct and act as a reference for
- * the functionality. The file also adds a guard word at the end of the
- * output arrays to check for buffer overruns.
+ * algorithm/microbenchmark. The file will allocate the option inputs and
+ * two output arrays: one for the reference prices produced alongside the
+ * generated dataset (genDataset) and one for the implementation under
+ * test. With --file, the inputs and reference prices are instead mapped
+ * from a binary dataset (include/dsfile.h) and only the output is
+ * allocated. With --stream on top, nothing is resident: the options are
+ * read, priced and written back batch by batch (impl/stream.h). The file
+ * also adds a guard word at the end of the output arrays to check for
+ * buffer overruns. With --greeks, the kernels also fill delta, gamma,
+ * vega, theta and rho in the same pass; they are checked against finite
+ * differences (include/greeks.h). --precision double prices double
+ * copies of the inputs and --precision mixed float ones with d1/d2 in
+ * double (impl/vec.h), so each precision's cost shows up on the same data.
+ * --layout aos|aosoa prices records or blocks of AOSOA_BLOCK options
+ * instead of the columns (include/types.h); the inputs are first packed
+ * into records, as a feed delivers them, and the time to transpose those
+ * into the layout under test is reported, --layout soa included.
+ * --implied-vol inverts the pricer: every implementation solves the
+ * volatility of every option from its reference price (impl/vec.h), and
+ * the solution is checked by pricing with it. --latency 1,8,64 runs one case per batch
+ * size: every invocation walks the dataset in calls of that many options
+ * through the typed API (impl/price.h), each call timed on its own, and
+ * the distribution of those calls is reported (impl/latency.h).
+ * --serve turns the dataset into a stream of single-option requests,
+ * issued open loop at --rate per second by --producers threads through
+ * lock-free queues; the other threads price them in micro-batches and
+ * the sustained rate and the latency of every request are reported
+ * (impl/serve.h). With --ranks N, dist splits the dataset over N
+ * processes, this one and N - 1 started with --connect, and reports the
+ * time spent sending, pricing and gathering (impl/dist.h); it prices
+ * plain columns only, so none of the modes above offers it. The
+ * vectorized kernels are also compiled for a few fixed sizes
+ * (PRICE_SPECIALIZE, impl/price.h); --generic runs the generic loop at
+ * every size, to see what that saves.
  *
- * The file will invoke each implementation n number of times. It will
- * record the runtime of _each_ invocation through the following Linux
- * API:
- *    clock_gettime(), with the clk_id set to CLOCK_MONOTONIC
- * Then, the file will calculate the standard deviation and calculate
- * an outlier-free average by excluding runtimes that are larger than
- * 2 standard deviation of the original average.
+ * Option parsing, scheduling, timing, statistics and the CSV dump are
+ * handled by the shared driver (common/driver.h); this file only owns
+ * the data.
  */
 
-/* Set features         */
-#define _GNU_SOURCE
-
 /* Standard C includes  */
 /*  -> Standard Library */
 #include <assert.h>
@@ -32,461 +51,1273 @@
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
-/*  -> Scheduling       */
-#include <sched.h>
+#include <strings.h>
+#include <ctype.h>
 /*  -> Types            */
 #include <stdbool.h>
 #include <inttypes.h>
-/*  -> Runtimes         */
-#include <time.h>
-#include <unistd.h>
-#include <errno.h>
 
 /* Include all implementations declarations */
 #include "impl/scalar.h"
 #include "impl/vec.h"
 #include "impl/para.h"
+#include "impl/stream.h"
+#include "impl/latency.h"
+#include "impl/serve.h"
+#include "impl/price.h"
+#include "impl/dist.h"
 
 /* Include common headers */
 #include "common/types.h"
 #include "common/macros.h"
+#include "common/driver.h"
+#include "common/dist.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
 
 /* Dataset */
 #include "include/dataset.h"
+#include "include/dsfile.h"
+#include "include/greeks.h"
+
+/* Work per option: five float inputs and the option type are read, one
+ * price is written. The FLOP count follows impl/vec.c: 21 arithmetic ops,
+ * log (~30), exp (~25) and two CNDFs (19 + exp each). */
+#define BLACKSCHOLES_BYTES_PER_OPTION (5 * sizeof(float) + sizeof(char) + sizeof(float))
+#define BLACKSCHOLES_FLOPS_PER_OPTION (21 + 30 + 25 + 2 * (19 + 25))
+
+/* The same in double precision */
+#define BLACKSCHOLES_BYTES_PER_OPTION_PD (5 * sizeof(double) + sizeof(char) + sizeof(double))
+
+/* --greeks: five more prices' worth of writes, and 17 ops on top of what
+ * pricing already computed (see blackscholes_ps in impl/vec.avx512.c) */
+#define BLACKSCHOLES_NGREEKS          5
+#define BLACKSCHOLES_BYTES_PER_GREEKS (BLACKSCHOLES_NGREEKS * sizeof(float))
+#define BLACKSCHOLES_FLOPS_PER_GREEKS 17
+
+/* --implied-vol: the market price is read instead of the volatility, and
+ * every Newton step prices with vega. Flops assume a typical step count
+ * from the Manaster-Koehler guess. */
+#define BLACKSCHOLES_IV_STEPS          4
+#define BLACKSCHOLES_FLOPS_PER_IV_STEP (BLACKSCHOLES_FLOPS_PER_OPTION + 2 + 8)
+
+/* Tolerances of delta, gamma, vega, theta and rho against the reference */
+static const float greeks_tolerance[BLACKSCHOLES_NGREEKS] = {
+  1e-4f, 1e-4f, 1e-3f, 1e-3f, 1e-3f,
+};
+
+/* Benchmark state */
+typedef struct {
+  int    dataset;
+  int    dataset_size;
+  bool   dataset_set;
+
+  /* Binary dataset (--file); mapped instead of generated when set */
+  const char* file;
+  dsfile_t    ds;
+
+  /* Batched pipeline over the file (--stream) */
+  bool        stream;
+  size_t      batch;
+  const char* output;
+  stream_t    st;
+
+  float* sptPrice;
+  float* strike;
+  float* rate;
+  float* volatility;
+  float* otime;
+  char * otype;
+  float* ref;
+  float* dest;
+
+  /* Greeks (--greeks): outputs and references, in args_t order */
+  bool   greeks;
+  float* greek    [BLACKSCHOLES_NGREEKS];
+  float* greek_ref[BLACKSCHOLES_NGREEKS];
+
+  /* Precision (--precision); double copies for PRECISION_DOUBLE */
+  precision_t precision;
+  args_pd_t   pd;
+
+  /* Layout (--layout); records as fed, and blocks for LAYOUT_AOSOA */
+  bool            layout_set;
+  layout_t        layout;
+  option_rec_t*   recs;
+  option_block_t* blocks;
+
+  /* Implied volatility (--implied-vol); prices at the solved volatility */
+  bool   iv;
+  float* reprice;
+
+  /* Latency mode (--latency): one case per batch size */
+  bool      latency;
+  size_t    batches[LATENCY_MAX_BATCHES];
+  int       nbatches;
+  latency_t lat;
+  char      labels[LATENCY_MAX_BATCHES][32];
+
+  /* Service mode (--serve): requests per second, issuing threads and the
+   * largest micro-batch */
+  bool      serve;
+  double    serve_rate;
+  int       producers;
+  size_t    serve_batch;
+  serve_t   sv;
+
+  /* Copies of the input columns for --cache cold; copy 0 is the above */
+  float* copy_col [DRIVER_CACHE_COPIES][5];
+  char * copy_type[DRIVER_CACHE_COPIES];
+  int    ncopies;
 
-int main(int argc, char** argv)
+  args_t args;
+} blackscholes_t;
+
+static const char* precision_name(precision_t p)
 {
-  /* Set the buffer for printf to NULL */
-  setbuf(stdout, NULL);
-
-  /* Arguments */
-  int nthreads = 1;
-  int cpu      = 0;
-
-  int nruns    = 128;
-  int nstdevs  = 3;
-
-  /* Data */
-  int dataset      = 0;
-  int dataset_size = 0;
-
-  /* Parse arguments */
-  /* Function pointers */
-  void* (*impl_scalar_ptr  )(void* args) = impl_scalar;
-  void* (*impl_vector_ptr  )(void* args) = impl_vector;
-  void* (*impl_parallel_ptr)(void* args) = impl_parallel;
-
-  /* Chosen */
-  void* (*impl)(void* args) = NULL;
-  const char* impl_str      = NULL;
-
-  bool parse_args_err       = false;
-
-  bool help = false;
-  for (int i = 1; i < argc; i++) {
-    /* Implementations */
-    if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--impl") == 0) {
-      assert (++i < argc);
-      if (strcmp(argv[i], "scalar") == 0) {
-        impl = impl_scalar_ptr  ; impl_str = "scalar";
-      } else if (strcmp(argv[i], "vec"  ) == 0) {
-        impl = impl_vector_ptr  ; impl_str = "vectorized"  ;
-      } else if (strcmp(argv[i], "para" ) == 0) {
-        impl = impl_parallel_ptr; impl_str = "parallelized";
-      } else {
-        impl = NULL             ; impl_str = "unknown"     ;
+  switch (p) {
+    case PRECISION_SINGLE: return "single";
+    case PRECISION_DOUBLE: return "double";
+    case PRECISION_MIXED : return "mixed";
+  }
 
-        printf("\n");
-        printf("ERROR: Unknown \"%s\" implementation.\n", argv[i]);
+  return "unknown";
+}
 
-        parse_args_err = true;
-      }
+static const char* layout_name(layout_t l)
+{
+  switch (l) {
+    case LAYOUT_SOA  : return "soa";
+    case LAYOUT_AOS  : return "aos";
+    case LAYOUT_AOSOA: return "aosoa";
+  }
 
-      continue;
+  return "unknown";
+}
+
+/* Not const: --stream swaps in the pipelined entry points, and every
+ * mode takes dist out (fn = NULL) */
+static driver_impl_t impls[] = {
+  { "scalar", "scalar"      , impl_scalar   },
+  { "vec"   , "vectorized"  , impl_vector   },
+  { "para"  , "parallelized", impl_parallel },
+  { "dist"  , "distributed" , impl_dist     },
+};
+
+static int blackscholes_parse_arg(void* ctx, int argc, char** argv, int i)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  /* Choosing a dataset */
+  if (strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--dataset") == 0) {
+    assert (++i < argc);
+    if      (strcasecmp(argv[i], "test"  ) == 0) { b->dataset =  0; }
+    else if (strcasecmp(argv[i], "dev"   ) == 0) { b->dataset =  1; }
+    else if (strcasecmp(argv[i], "small" ) == 0) { b->dataset =  2; }
+    else if (strcasecmp(argv[i], "medium") == 0) { b->dataset =  3; }
+    else if (strcasecmp(argv[i], "large" ) == 0) { b->dataset =  4; }
+    else if (strcasecmp(argv[i], "native") == 0) { b->dataset =  5; }
+    else                                         { b->dataset = -1; }
+    b->dataset_set = true;
+
+    if (b->dataset < 0) {
+      printf("\n");
+      printf("ERROR: Unknown dataset \"%s\"\n", argv[i]);
+
+      b->dataset = 0;
+      return -1;
     }
 
-    /* Choosing a dataset */
-    if (strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "--dataset") == 0) {
-      assert (++i < argc);
-      if      (strcasecmp(argv[i], "test"  ) == 0) { dataset =  0; }
-      else if (strcasecmp(argv[i], "dev"   ) == 0) { dataset =  1; }
-      else if (strcasecmp(argv[i], "small" ) == 0) { dataset =  2; }
-      else if (strcasecmp(argv[i], "medium") == 0) { dataset =  3; }
-      else if (strcasecmp(argv[i], "large" ) == 0) { dataset =  4; }
-      else if (strcasecmp(argv[i], "native") == 0) { dataset =  5; }
-      else                                         { dataset = -1; }
-
-      if (dataset < 0) {
-        printf("\n");
-        printf("ERROR: Unknown dataset \"%s\"\n", argv[i]);
+    return 2;
+  }
 
-        parse_args_err = true;
-        break;
-      }
+  /* Mapping a binary dataset */
+  if (strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--file") == 0) {
+    assert (++i < argc);
+    b->file = argv[i];
+
+    return 2;
+  }
+
+  /* Streaming the binary dataset in batches */
+  if (strcmp(argv[i], "--stream") == 0) {
+    b->stream = true;
 
-      continue;
+    /* Every implementation runs through the pipeline instead */
+    impls[0].fn = impl_stream_scalar  ; impls[0].label = "stream_scalar";
+    impls[1].fn = impl_stream_vector  ; impls[1].label = "stream_vectorized";
+    impls[2].fn = impl_stream_parallel; impls[2].label = "stream_parallelized";
+    impls[3].fn = NULL;
+
+    return 1;
+  }
+
+  if (strcmp(argv[i], "--batch") == 0) {
+    assert (++i < argc);
+    long long batch = atoll(argv[i]);
+
+    if (batch <= 0) {
+      printf("\n");
+      printf("ERROR: Invalid batch size \"%s\"\n", argv[i]);
+      return -1;
     }
 
-    /* Run parameterization */
-    if (strcmp(argv[i], "--nruns") == 0) {
-      assert (++i < argc);
-      nruns = atoi(argv[i]);
+    b->batch = (size_t)batch;
+    return 2;
+  }
+
+  if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+    assert (++i < argc);
+    b->output = argv[i];
+
+    return 2;
+  }
+
+  /* Computing the Greeks alongside the prices */
+  if (strcmp(argv[i], "--greeks") == 0) {
+    b->greeks = true;
+
+    impls[3].fn = NULL;
 
-      continue;
+    return 1;
+  }
+
+  /* Precision of the vectorized and parallel kernels */
+  if (strcmp(argv[i], "--precision") == 0) {
+    assert (++i < argc);
+    if      (strcasecmp(argv[i], "single") == 0) { b->precision = PRECISION_SINGLE; }
+    else if (strcasecmp(argv[i], "double") == 0) { b->precision = PRECISION_DOUBLE; }
+    else if (strcasecmp(argv[i], "mixed" ) == 0) { b->precision = PRECISION_MIXED;  }
+    else {
+      printf("\n");
+      printf("ERROR: Unknown precision \"%s\"\n", argv[i]);
+      return -1;
     }
 
-    if (strcmp(argv[i], "--nstdevs") == 0) {
-      assert (++i < argc);
-      nstdevs = atoi(argv[i]);
+    if (b->precision == PRECISION_DOUBLE) {
+      impls[1].fn = impl_vector_pd     ; impls[1].label = "vectorized_double";
+      impls[2].fn = impl_parallel_pd   ; impls[2].label = "parallelized_double";
+      impls[3].fn = NULL;
+    } else if (b->precision == PRECISION_MIXED) {
+      impls[1].fn = impl_vector_mixed  ; impls[1].label = "vectorized_mixed";
+      impls[2].fn = impl_parallel_mixed; impls[2].label = "parallelized_mixed";
+      impls[3].fn = NULL;
+    }
+
+    return 2;
+  }
 
-      continue;
+  /* Layout of the inputs of the vectorized and parallel kernels */
+  if (strcmp(argv[i], "--layout") == 0) {
+    assert (++i < argc);
+    if      (strcasecmp(argv[i], "soa"  ) == 0) { b->layout = LAYOUT_SOA;   }
+    else if (strcasecmp(argv[i], "aos"  ) == 0) { b->layout = LAYOUT_AOS;   }
+    else if (strcasecmp(argv[i], "aosoa") == 0) { b->layout = LAYOUT_AOSOA; }
+    else {
+      printf("\n");
+      printf("ERROR: Unknown layout \"%s\"\n", argv[i]);
+      return -1;
     }
+    b->layout_set = true;
+
+    if (b->layout == LAYOUT_AOS) {
+      impls[1].fn = impl_vector_aos    ; impls[1].label = "vectorized_aos";
+      impls[2].fn = impl_parallel_aos  ; impls[2].label = "parallelized_aos";
+      impls[3].fn = NULL;
+    } else if (b->layout == LAYOUT_AOSOA) {
+      impls[1].fn = impl_vector_aosoa  ; impls[1].label = "vectorized_aosoa";
+      impls[2].fn = impl_parallel_aosoa; impls[2].label = "parallelized_aosoa";
+      impls[3].fn = NULL;
+    }
+
+    return 2;
+  }
+
+  /* Solving for the volatility instead of pricing */
+  if (strcmp(argv[i], "--implied-vol") == 0) {
+    b->iv = true;
 
-    /* Parallelization */
-    if (strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "--nthreads") == 0) {
-      assert (++i < argc);
-      nthreads = atoi(argv[i]);
+    impls[1].fn = impl_vector_iv  ; impls[1].label = "vectorized_iv";
+    impls[2].fn = impl_parallel_iv; impls[2].label = "parallelized_iv";
+    impls[3].fn = NULL;
 
-      continue;
+    return 1;
+  }
+
+  /* Timing every call of a few options, for each batch size */
+  if (strcmp(argv[i], "--latency") == 0) {
+    const char* list = LATENCY_DEFAULT_BATCHES;
+    int         used = 1;
+
+    if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) {
+      list = argv[i + 1];
+      used = 2;
+    }
+
+    b->latency  = true;
+    b->nbatches = 0;
+
+    for (const char* p = list; *p != '\0'; ) {
+      char*     end;
+      long long batch = strtoll(p, &end, 10);
+
+      if (end == p || batch <= 0 || b->nbatches == LATENCY_MAX_BATCHES ||
+          (*end != ',' && *end != '\0')) {
+        printf("\n");
+        printf("ERROR: Invalid latency batch sizes \"%s\" (at most %d)\n",
+               list, LATENCY_MAX_BATCHES);
+        return -1;
+      }
+
+      b->batches[b->nbatches++] = (size_t)batch;
+      p = (*end == ',') ? end + 1 : end;
+    }
+
+    impls[0].fn = impl_latency_scalar  ; impls[0].label = "latency_scalar";
+    impls[1].fn = impl_latency_vector  ; impls[1].label = "latency_vectorized";
+    impls[2].fn = impl_latency_parallel; impls[2].label = "latency_parallelized";
+    impls[3].fn = NULL;
+
+    return used;
+  }
+
+  /* Serving single-option requests from queues */
+  if (strcmp(argv[i], "--serve") == 0) {
+    b->serve = true;
+
+    impls[0].fn = impl_serve_scalar  ; impls[0].label = "serve_scalar";
+    impls[1].fn = impl_serve_vector  ; impls[1].label = "serve_vectorized";
+    impls[2].fn = impl_serve_parallel; impls[2].label = "serve_parallelized";
+    impls[3].fn = NULL;
+
+    return 1;
+  }
+
+  if (strcmp(argv[i], "--rate") == 0) {
+    assert (++i < argc);
+    char*  end;
+    double rate = strtod(argv[i], &end);
+
+    if (end == argv[i] || *end != '\0' || rate < 0.0) {
+      printf("\n");
+      printf("ERROR: Invalid request rate \"%s\"\n", argv[i]);
+      return -1;
     }
 
-    if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--cpu") == 0) {
-      assert (++i < argc);
-      cpu = atoi(argv[i]);
+    b->serve_rate = rate;
+    return 2;
+  }
+
+  if (strcmp(argv[i], "--producers") == 0) {
+    assert (++i < argc);
+    int producers = atoi(argv[i]);
 
-      continue;
+    if (producers <= 0) {
+      printf("\n");
+      printf("ERROR: Invalid number of producers \"%s\"\n", argv[i]);
+      return -1;
     }
 
-    /* Help */
-    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
-      help = true;
+    b->producers = producers;
+    return 2;
+  }
+
+  if (strcmp(argv[i], "--serve-batch") == 0) {
+    assert (++i < argc);
+    long long batch = atoll(argv[i]);
 
-      continue;
+    if (batch <= 0) {
+      printf("\n");
+      printf("ERROR: Invalid serve batch \"%s\"\n", argv[i]);
+      return -1;
     }
+
+    b->serve_batch = (size_t)batch;
+    return 2;
   }
 
-  if (!parse_args_err && !help && impl == NULL) {
-    printf("\n");
-    printf("ERROR: No implementation was chosen.\n");
+  /* Running every size through the generic loop */
+  if (strcmp(argv[i], "--generic") == 0) {
+    price_sized = false;
+
+    return 1;
   }
 
-  if (help || impl == NULL || parse_args_err) {
-    printf("\n");
-    printf("Usage:\n");
-    printf("  %s {-i | --impl} impl_str [Options]\n", argv[0]);
-    printf("  \n");
-    printf("  Required:\n");
-    printf("    -i | --impl      Available implementations = {scalar, vec, para}\n");
-    printf("    \n");
-    printf("  Options:\n");
-    printf("    -h | --help      Print this message\n");
-    printf("    -n | --nthreads  Set number of threads available (default = %d)\n", nthreads);
-    printf("    -c | --cpu       Set the main CPU for the program (default = %d)\n", cpu);
-    printf("    -d | --dataset   Dataset to be used (default = %s)\n", __dataset_name(dataset));
-    printf("                     Available datasets = {test, dev, small, medium, large, native}.\n");
-    printf("         --nruns     Number of runs to the implementation (default = %d)\n", nruns);
-    printf("         --stdevs    Number of standard deviation to exclude outliers (default = %d)\n", nstdevs);
-    printf("\n");
+  /* Converting a PARSEC text dataset, then exiting */
+  if (strcmp(argv[i], "--convert") == 0) {
+    assert (i + 2 < argc);
+    printf("Converting \"%s\" to \"%s\" .... ", argv[i + 1], argv[i + 2]);
+    fflush(stdout);
+
+    int64_t count = dsfile_convert(argv[i + 1], argv[i + 2]);
+    if (count < 0) exit(1);
 
-    exit(help? 0 : 1);
+    printf("%" PRId64 " options\n", count);
+    exit(0);
   }
 
-  /* Dataset sizes */
-  switch(dataset) {
-    case  0: dataset_size =  4              ; break;
-    case  1: dataset_size = 23              ; break;
-    case  2: dataset_size =  4 * 1000       ; break;
-    case  3: dataset_size = 16 * 1000       ; break;
-    case  4: dataset_size = 64 * 1000       ; break;
-    case  5: dataset_size = 10 * 1000 * 1000; break;
-    default: dataset_size = -1              ;
-  }
-
-  /* Set our priority the highest */
-  int nice_level = -20;
-
-  printf("Setting up schedulers and affinity:\n");
-  printf("  * Setting the niceness level:\n");
-  do {
-    errno = 0;
-    printf("      -> trying niceness level = %d\n", nice_level);
-    int __attribute__((unused)) ret = nice(nice_level);
-  } while (errno != 0 && nice_level++);
-
-  printf("    + Process has niceness level = %d\n", nice_level);
-
-  /* If we are on an apple operating system, skip the scheduling  *
-   * routine; Darwin does not support sched_set* system calls ... *
-   *                                                              *
-   * hawajkm: and here I was--thinking that MacOS is POSIX ...    *
-   *          Silly me!                                           */
-#if !defined(__APPLE__)
-  /* Set scheduling to reduce context switching */
-  /*    -> Set scheduling scheme                */
-  /* Set scheduling to reduce context switching */
-  /*    -> Set scheduling scheme                */
-  printf("  * Setting up FIFO scheduling scheme and high priority ... ");
-  pid_t pid    = 0;
-  int   policy = SCHED_FIFO;
-  struct sched_param param;
-
-  param.sched_priority = sched_get_priority_max(policy);
-  int res = sched_setscheduler(pid, policy, &param);
-  if (res != 0) {
-    printf("Failed\n");
-  } else {
-    printf("Succeeded\n");
+  return 0;
+}
+
+static void blackscholes_usage(void* ctx)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  printf("    -d | --dataset   Dataset to be used (default = %s)\n", __dataset_name(b->dataset));
+  printf("                     Available datasets = {test, dev, small, medium, large, native}.\n");
+  printf("    -f | --file      Map a binary dataset instead of generating one\n");
+  printf("         --stream    Price the --file dataset in batches, overlapping\n");
+  printf("                     reads and writes with compute (two batches resident)\n");
+  printf("         --batch     Options per batch with --stream (default = %d)\n", STREAM_BATCH);
+  printf("    -o | --output    Write the --stream prices (float32) to this file\n");
+  printf("         --greeks    Also compute delta, gamma, vega, theta and rho\n");
+  printf("         --precision Arithmetic of vec and para (default = %s)\n", precision_name(b->precision));
+  printf("                     Available precisions = {single, double, mixed}.\n");
+  printf("         --layout    Input layout of vec and para (default = %s)\n", layout_name(b->layout));
+  printf("                     Available layouts = {soa, aos, aosoa}.\n");
+  printf("         --implied-vol\n");
+  printf("                     Solve vec and para for the volatility that\n");
+  printf("                     reproduces each reference price\n");
+  printf("         --latency   Price batches of a few options per call and report\n");
+  printf("                     the latency of every call, e.g. \"--latency 1,8,64\"\n");
+  printf("                     (default = %s; dataset small unless -d)\n", LATENCY_DEFAULT_BATCHES);
+  printf("         --serve     Issue every option as a request through lock-free\n");
+  printf("                     queues and report the rate sustained and the\n");
+  printf("                     latency of every request (dataset small unless -d)\n");
+  printf("         --rate      Requests per second with --serve, 0 = unpaced (default = %.0f)\n", b->serve_rate);
+  printf("         --producers Threads issuing requests (default = %d)\n", b->producers);
+  printf("         --serve-batch\n");
+  printf("                     Most requests priced per call (default = %zu)\n", b->serve_batch);
+  printf("         --generic   Skip the size-specialized kernels (see impl/price.h)\n");
+  printf("         --convert   \"--convert in.txt out.bin\": convert a PARSEC text\n");
+  printf("                     dataset to the binary format and exit\n");
+}
+
+/* Work of one case of n options */
+static void blackscholes_work(const blackscholes_t* b, size_t n,
+                              driver_case_t* c)
+{
+  c->flops = (double)BLACKSCHOLES_FLOPS_PER_OPTION * n;
+  c->bytes = (double)BLACKSCHOLES_BYTES_PER_OPTION * n;
+
+  if (b->precision == PRECISION_DOUBLE) {
+    c->bytes = (double)BLACKSCHOLES_BYTES_PER_OPTION_PD * n;
+  }
+
+  if (b->iv) {
+    c->flops = (double)BLACKSCHOLES_FLOPS_PER_IV_STEP * BLACKSCHOLES_IV_STEPS * n;
+  }
+
+  if (b->greeks) {
+    c->flops += (double)BLACKSCHOLES_FLOPS_PER_GREEKS * n;
+    c->bytes += (double)BLACKSCHOLES_BYTES_PER_GREEKS * n;
+  }
+}
+
+/* Allocate the Greeks and their references for the inputs of args, and
+ * point args at the outputs; call before para_first_touch */
+static void blackscholes_setup_greeks(blackscholes_t* b, args_t* args)
+{
+  size_t n = args->num_stocks;
+
+  for (int g = 0; g < BLACKSCHOLES_NGREEKS; g++) {
+    b->greek    [g] = __ALLOC_DATA(float, n + 1);
+    b->greek_ref[g] = __ALLOC_DATA(float, n + 1);
+  }
+
+  args_t args_ref = *args;
+
+  args_ref.delta = b->greek_ref[0];
+  args_ref.gamma = b->greek_ref[1];
+  args_ref.vega  = b->greek_ref[2];
+  args_ref.theta = b->greek_ref[3];
+  args_ref.rho   = b->greek_ref[4];
+
+  printf("  * Invoking genGreeks .... ");
+  genGreeks(&args_ref);
+  printf("Finished\n");
+
+  for (int g = 0; g < BLACKSCHOLES_NGREEKS; g++) {
+    __SET_GUARD(b->greek_ref[g], n * sizeof(float));
+    __SET_GUARD(b->greek    [g], n * sizeof(float));
   }
 
-  /*    -> Set affinity                         */
-  printf("  * Setting up scheduling affinity ... ");
-  cpu_set_t cpumask;
+  args->delta = b->greek[0];
+  args->gamma = b->greek[1];
+  args->vega  = b->greek[2];
+  args->theta = b->greek[3];
+  args->rho   = b->greek[4];
+}
 
-  CPU_ZERO(&cpumask);
-  for (int i = 0; i < nthreads; i++) {
-    CPU_SET(cpu + i, &cpumask);
+/* Widen one chunk of inputs into its double-precision copies */
+static void to_double_chunk(void* args, size_t begin)
+{
+  args_t* chunk = (args_t*)args;
+
+  for (size_t i = 0; i < chunk->num_stocks; i++) {
+    chunk->pd.sptPrice  [i] = chunk->sptPrice  [i];
+    chunk->pd.strike    [i] = chunk->strike    [i];
+    chunk->pd.rate      [i] = chunk->rate      [i];
+    chunk->pd.volatility[i] = chunk->volatility[i];
+    chunk->pd.otime     [i] = chunk->otime     [i];
   }
+}
+
+/* Double-precision copies of the inputs of args, for PRECISION_DOUBLE;
+ * call before para_first_touch */
+static void blackscholes_setup_pd(blackscholes_t* b, args_t* args)
+{
+  size_t n = args->num_stocks;
+
+  b->pd.sptPrice   = __ALLOC_DATA(double, n + 0);
+  b->pd.strike     = __ALLOC_DATA(double, n + 0);
+  b->pd.rate       = __ALLOC_DATA(double, n + 0);
+  b->pd.volatility = __ALLOC_DATA(double, n + 0);
+  b->pd.otime      = __ALLOC_DATA(double, n + 0);
+  b->pd.output     = __ALLOC_DATA(double, n + 1);
 
-  res = sched_setaffinity(pid, sizeof(cpumask), &cpumask);
+  args->pd = b->pd;
 
-  if (res != 0) {
-    printf("Failed\n");
+  /* pd.output is placed by para_first_touch */
+  printf("  * Widening to double .... ");
+  para_for_chunks(args, to_double_chunk);
+  printf("Finished\n");
+
+  __SET_GUARD(b->pd.output, n * sizeof(double));
+}
+
+/* Pack one chunk of columns into records */
+static void to_records_chunk(void* args, size_t begin)
+{
+  args_t* chunk = (args_t*)args;
+
+  for (size_t i = 0; i < chunk->num_stocks; i++) {
+    option_rec_t* rec = &chunk->aos[i];
+
+    rec->sptPrice   = chunk->sptPrice  [i];
+    rec->strike     = chunk->strike    [i];
+    rec->rate       = chunk->rate      [i];
+    rec->volatility = chunk->volatility[i];
+    rec->otime      = chunk->otime     [i];
+    rec->otype      = chunk->otype     [i];
+  }
+}
+
+/* Transpose one chunk of records back into columns */
+static void records_to_soa_chunk(void* args, size_t begin)
+{
+  args_t* chunk = (args_t*)args;
+
+  for (size_t i = 0; i < chunk->num_stocks; i++) {
+    const option_rec_t* rec = &chunk->aos[i];
+
+    chunk->sptPrice  [i] = rec->sptPrice  ;
+    chunk->strike    [i] = rec->strike    ;
+    chunk->rate      [i] = rec->rate      ;
+    chunk->volatility[i] = rec->volatility;
+    chunk->otime     [i] = rec->otime     ;
+    chunk->otype     [i] = rec->otype     ;
+  }
+}
+
+/* Fault in one chunk's blocks, so the transposition times only itself */
+static void zero_blocks_chunk(void* args, size_t begin)
+{
+  args_t* chunk = (args_t*)args;
+  size_t  n     = (chunk->num_stocks + AOSOA_BLOCK - 1) / AOSOA_BLOCK;
+
+  memset(chunk->aosoa, 0, n * sizeof(option_block_t));
+}
+
+/* Transpose one chunk of records into blocks; chunks start on a block */
+static void records_to_aosoa_chunk(void* args, size_t begin)
+{
+  args_t* chunk = (args_t*)args;
+
+  for (size_t i = 0; i < chunk->num_stocks; i++) {
+    const option_rec_t* rec = &chunk->aos[i];
+    option_block_t*     blk = &chunk->aosoa[i / AOSOA_BLOCK];
+    size_t              j   = i % AOSOA_BLOCK;
+
+    blk->sptPrice  [j] = rec->sptPrice  ;
+    blk->strike    [j] = rec->strike    ;
+    blk->rate      [j] = rec->rate      ;
+    blk->volatility[j] = rec->volatility;
+    blk->otime     [j] = rec->otime     ;
+    blk->otype     [j] = rec->otype     ;
+  }
+}
+
+/* Feed records for the inputs of args, then transpose them into b->layout
+ * and point args at it; call before para_first_touch */
+static void blackscholes_setup_layout(blackscholes_t* b, args_t* args)
+{
+  size_t n = args->num_stocks;
+
+  b->recs = __ALLOC_DATA(option_rec_t, n);
+
+  args_t feed = *args;
+  feed.aos = b->recs;
+
+  if (b->layout == LAYOUT_AOSOA) {
+    b->blocks  = __ALLOC_DATA(option_block_t, (n + AOSOA_BLOCK - 1) / AOSOA_BLOCK);
+    feed.aosoa = b->blocks;
+    para_for_chunks(&feed, zero_blocks_chunk);
+  }
+
+  printf("  * Packing records .... ");
+  para_for_chunks(&feed, to_records_chunk);
+  printf("Finished\n");
+
+  /* What a records feed pays before the first kernel runs */
+  struct timespec ts, te;
+
+  printf("  * Transposing records to %s .... ", layout_name(b->layout));
+  __SET_START_TIME();
+
+  switch (b->layout) {
+    case LAYOUT_SOA:
+      para_for_chunks(&feed, records_to_soa_chunk);
+      break;
+    case LAYOUT_AOS:
+      /* The records are the layout */
+      break;
+    case LAYOUT_AOSOA:
+      para_for_chunks(&feed, records_to_aosoa_chunk);
+      break;
+  }
+
+  __SET_END_TIME();
+  printf("Finished (%.3f ms)\n", (double)__CALC_RUNTIME() / 1e6);
+
+  args->aos   = (b->layout == LAYOUT_AOS) ? b->recs : NULL;
+  args->aosoa = b->blocks;
+}
+
+/* The reference prices become the market the solver inverts */
+static void blackscholes_setup_iv(blackscholes_t* b, args_t* args)
+{
+  b->reprice   = __ALLOC_DATA(float, args->num_stocks);
+  args->market = b->ref;
+}
+
+/* List what a run touches for --cache, and where the kernels read plain
+ * single-precision columns, make the copies rotate switches between */
+static void blackscholes_setup_cache(blackscholes_t* b, const driver_env_t* env,
+                                     driver_case_t* c)
+{
+  size_t n       = b->args.num_stocks;
+  bool   columns = (b->precision == PRECISION_SINGLE && b->layout == LAYOUT_SOA);
+
+  b->ncopies = columns ? env->copies : 1;
+
+  b->copy_col [0][0] = b->sptPrice  ;
+  b->copy_col [0][1] = b->strike    ;
+  b->copy_col [0][2] = b->rate      ;
+  b->copy_col [0][3] = b->volatility;
+  b->copy_col [0][4] = b->otime     ;
+  b->copy_type[0]    = b->otype     ;
+
+  for (int k = 1; k < b->ncopies; k++) {
+    for (int j = 0; j < 5; j++) {
+      b->copy_col[k][j] = __ALLOC_DATA(float, n);
+      memcpy(b->copy_col[k][j], b->copy_col[0][j], n * sizeof(float));
+    }
+    b->copy_type[k] = __ALLOC_DATA(char, n);
+    memcpy(b->copy_type[k], b->copy_type[0], n);
+  }
+
+  if (columns) {
+    for (int k = 0; k < b->ncopies; k++) {
+      for (int j = 0; j < 5; j++) driver_case_buf(c, b->copy_col[k][j], n * sizeof(float), k);
+      driver_case_buf(c, b->copy_type[k], n, k);
+    }
+  } else if (b->precision == PRECISION_DOUBLE) {
+    driver_case_buf(c, b->pd.sptPrice  , n * sizeof(double), 0);
+    driver_case_buf(c, b->pd.strike    , n * sizeof(double), 0);
+    driver_case_buf(c, b->pd.rate      , n * sizeof(double), 0);
+    driver_case_buf(c, b->pd.volatility, n * sizeof(double), 0);
+    driver_case_buf(c, b->pd.otime     , n * sizeof(double), 0);
+    driver_case_buf(c, b->otype        , n                 , 0);
+  } else if (b->layout == LAYOUT_AOS) {
+    driver_case_buf(c, b->recs, n * sizeof(option_rec_t), 0);
   } else {
-    printf("Succeeded\n");
+    driver_case_buf(c, b->blocks, (n + AOSOA_BLOCK - 1) / AOSOA_BLOCK *
+                                  sizeof(option_block_t), 0);
+  }
+
+  driver_case_buf(c, b->dest, n * sizeof(float), -1);
+  if (b->pd.output != NULL) driver_case_buf(c, b->pd.output, n * sizeof(double), -1);
+  if (b->iv) driver_case_buf(c, b->ref, n * sizeof(float), -1);
+  for (int g = 0; b->greeks && g < BLACKSCHOLES_NGREEKS; g++) {
+    driver_case_buf(c, b->greek[g], n * sizeof(float), -1);
+  }
+
+  c->ncopies = b->ncopies;
+}
+
+/* Inputs and reference prices straight from the mapped file */
+static bool blackscholes_setup_file(blackscholes_t* b, const driver_env_t* env,
+                                    driver_case_t* c)
+{
+  printf("Mapping dataset \"%s\":\n", b->file);
+  if (dsfile_map(b->file, &b->ds) != 0) return false;
+
+  if (b->ds.count > INT32_MAX) {
+    printf("ERROR: Dataset has %zu options (max = %d)\n", b->ds.count, INT32_MAX);
+    dsfile_unmap(&b->ds);
+    return false;
+  }
+
+  int dataset_size = (int)b->ds.count;
+  b->dataset_size  = dataset_size;
+
+  printf("  * Dataset size: %d\n", dataset_size);
+
+  b->sptPrice   = b->ds.sptPrice  ;
+  b->strike     = b->ds.strike    ;
+  b->rate       = b->ds.rate      ;
+  b->volatility = b->ds.volatility;
+  b->otime      = b->ds.otime     ;
+  b->otype      = b->ds.otype     ;
+  b->ref        = b->ds.price     ;
+  b->dest       = __ALLOC_DATA(float, dataset_size + 1);
+
+  /* The mapping is private; the guard after ref never reaches the file */
+  __SET_GUARD(b->ref , dataset_size * sizeof(float));
+  __SET_GUARD(b->dest, dataset_size * sizeof(float));
+
+  args_t* args = &b->args;
+
+  args->num_stocks = dataset_size;
+
+  args->sptPrice   = b->sptPrice   ;
+  args->strike     = b->strike     ;
+  args->rate       = b->rate       ;
+  args->volatility = b->volatility ;
+  args->otime      = b->otime      ;
+  args->otype      = b->otype      ;
+  args->output     = b->dest       ;
+
+  args->cpu        = env->cpu      ;
+  args->nthreads   = env->nthreads ;
+  args->pool       = env->pool     ;
+  args->dist       = env->dist     ;
+
+  if (b->greeks) blackscholes_setup_greeks(b, args);
+  if (b->precision == PRECISION_DOUBLE) blackscholes_setup_pd(b, args);
+  if (b->layout_set) blackscholes_setup_layout(b, args);
+  if (b->iv) blackscholes_setup_iv(b, args);
+  printf("\n");
+
+  /* Initialize dest from the threads that will write it */
+  para_first_touch(args);
+
+  c->args  = args;
+  c->label = NULL;
+  blackscholes_work(b, dataset_size, c);
+  blackscholes_setup_cache(b, env, c);
+
+  return true;
+}
+
+/* Two batch buffers over the file; the data never becomes resident */
+static bool blackscholes_setup_stream(blackscholes_t* b, const driver_env_t* env,
+                                      driver_case_t* c)
+{
+  printf("Streaming dataset \"%s\":\n", b->file);
+  if (stream_open(&b->st, b->file, b->output, b->batch) != 0) return false;
+
+  b->dataset_size = (int)(b->st.count > INT32_MAX ? INT32_MAX : b->st.count);
+
+  printf("  * Dataset size: %zu\n", b->st.count);
+  printf("  * Batches     : %zu of %zu options\n", b->st.nbatches, b->st.batch);
+  if (b->output != NULL) {
+    printf("  * Output      : %s\n", b->output);
   }
-#endif
   printf("\n");
 
-  /* Statistics */
-  __DECLARE_STATS(nruns, nstdevs);
+  args_t* args = &b->args;
 
-  /* Initialize Rand */
-  srand(0xdeadbeef);
+  memset(args, 0, sizeof(*args));
+  args->num_stocks = b->st.count;
+  args->cpu        = env->cpu     ;
+  args->nthreads   = env->nthreads;
+  args->pool       = env->pool    ;
+  args->stream     = &b->st       ;
+
+  c->args  = args;
+  c->label = NULL;
+  blackscholes_work(b, b->st.count, c);
+
+  return true;
+}
+
+/* Inputs generated from the reference dataset */
+static bool blackscholes_setup_dataset(blackscholes_t* b, const driver_env_t* env,
+                                       driver_case_t* c)
+{
+  /* Dataset sizes */
+  switch(b->dataset) {
+    case  0: b->dataset_size =  4              ; break;
+    case  1: b->dataset_size = 23              ; break;
+    case  2: b->dataset_size =  4 * 1000       ; break;
+    case  3: b->dataset_size = 16 * 1000       ; break;
+    case  4: b->dataset_size = 64 * 1000       ; break;
+    case  5: b->dataset_size = 10 * 1000 * 1000; break;
+    default: b->dataset_size = -1              ;
+  }
+
+  if (b->dataset_size < 0) return false;
+
+  int dataset_size = b->dataset_size;
 
   /* Datasets */
   /* Allocation and initialization */
-  float* sptPrice   = __ALLOC_DATA(float, dataset_size + 0);
-  float* strike     = __ALLOC_DATA(float, dataset_size + 0);
-  float* rate       = __ALLOC_DATA(float, dataset_size + 0);
-  float* volatility = __ALLOC_DATA(float, dataset_size + 0);
-  float* otime      = __ALLOC_DATA(float, dataset_size + 0);
-  char * otype      = __ALLOC_DATA(char , dataset_size + 0);
-  float* ref        = __ALLOC_DATA(float, dataset_size + 1);
-  float* dest       = __ALLOC_DATA(float, dataset_size + 1);
+  b->sptPrice   = __ALLOC_DATA(float, dataset_size + 0);
+  b->strike     = __ALLOC_DATA(float, dataset_size + 0);
+  b->rate       = __ALLOC_DATA(float, dataset_size + 0);
+  b->volatility = __ALLOC_DATA(float, dataset_size + 0);
+  b->otime      = __ALLOC_DATA(float, dataset_size + 0);
+  b->otype      = __ALLOC_DATA(char , dataset_size + 0);
+  b->ref        = __ALLOC_DATA(float, dataset_size + 1);
+  b->dest       = __ALLOC_DATA(float, dataset_size + 1);
+
+  /* Arguments shared by every call below */
+  args_t args;
 
-  /* Initialize dest */
-  for (int i = 0; i < dataset_size; i++) {
-    dest[i] = 0.0f;
-  }
+  args.num_stocks = dataset_size;
 
-  /* Setting a guards, which is 0xdeadcafe.
-     The guard should not change or be touched. */
-  __SET_GUARD(ref , dataset_size * sizeof(float));
-  __SET_GUARD(dest, dataset_size * sizeof(float));
+  args.sptPrice   = b->sptPrice   ;
+  args.strike     = b->strike     ;
+  args.rate       = b->rate       ;
+  args.volatility = b->volatility ;
+  args.otime      = b->otime      ;
+  args.otype      = b->otype      ;
+  args.output     = b->dest       ;
+
+  args.cpu        = env->cpu      ;
+  args.nthreads   = env->nthreads ;
+  args.pool       = env->pool     ;
+  args.stream     = NULL          ;
+  args.latency    = NULL          ;
+  args.serve      = NULL          ;
+  args.dist       = env->dist     ;
+
+  args.delta      = NULL          ;
+  args.gamma      = NULL          ;
+  args.vega       = NULL          ;
+  args.theta      = NULL          ;
+  args.rho        = NULL          ;
+
+  memset(&args.pd, 0, sizeof(args.pd));
+
+  args.aos        = NULL          ;
+  args.aosoa      = NULL          ;
+  args.market     = NULL          ;
 
   /* Generate ref data */
-  printf("Generating dataset \"%s\":\n", __dataset_name(dataset));
+  printf("Generating dataset \"%s\":\n", __dataset_name(b->dataset));
   printf("  * Dataset size: %d\n", dataset_size);
 
   /* Arguments for the functions */
-  args_t args_ref;
-
-  args_ref.num_stocks = dataset_size;
+  args_t args_ref = args;
 
-  args_ref.sptPrice   = sptPrice    ;
-  args_ref.strike     = strike      ;
-  args_ref.rate       = rate        ;
-  args_ref.volatility = volatility  ;
-  args_ref.otime      = otime       ;
-  args_ref.otype      = otype       ;
-  args_ref.output     = ref         ;
+  args_ref.output = b->ref;
 
-  args_ref.cpu        = cpu         ;
-  args_ref.nthreads   = nthreads    ;
-
-  /* Call genDataset to generate dataset and reference output */
+  /* Call genDataset to generate dataset and reference output; the
+     inputs are written by the threads that will price them */
   printf("  * Invoking genDataset .... ");
   genDataset(&args_ref);
   printf("Finished\n");
+
+  if (b->greeks) blackscholes_setup_greeks(b, &args);
+  if (b->precision == PRECISION_DOUBLE) blackscholes_setup_pd(b, &args);
+  if (b->layout_set) blackscholes_setup_layout(b, &args);
+  if (b->iv) blackscholes_setup_iv(b, &args);
   printf("\n");
 
-  /* Execute the requested implementation */
-  /* Arguments for the function */
-  args_t args;
+  /* Initialize dest from the threads that will write it */
+  para_first_touch(&args);
 
-  args.num_stocks = dataset_size;
+  /* Setting a guards, which is 0xdeadcafe.
+     The guard should not change or be touched. */
+  __SET_GUARD(b->ref , dataset_size * sizeof(float));
+  __SET_GUARD(b->dest, dataset_size * sizeof(float));
 
-  args.sptPrice   = sptPrice    ;
-  args.strike     = strike      ;
-  args.rate       = rate        ;
-  args.volatility = volatility  ;
-  args.otime      = otime       ;
-  args.otype      = otype       ;
-  args.output     = dest        ;
-
-  args.cpu        = cpu         ;
-  args.nthreads   = nthreads    ;
-
-  /* Start execution */
-  printf("Running \"%s\" implementation:\n", impl_str);
-
-  printf("  * Invoking the implementation %d times .... ", num_runs);
-  for (int i = 0; i < num_runs; i++) {
-    __SET_START_TIME();
-    for (int j = 0; j < 4; j++) {
-      (*impl)(&args);
-    }
-    __SET_END_TIME();
-    runtimes[i] = __CALC_RUNTIME() / 4;
+  /* Arguments for the requested implementation */
+  b->args = args;
+
+  c->args  = &b->args;
+  c->label = NULL;
+  blackscholes_work(b, dataset_size, c);
+  blackscholes_setup_cache(b, env, c);
+
+  return true;
+}
+
+/* One batch size per case, on the data of the case; call last */
+static bool blackscholes_setup_latency(blackscholes_t* b, int idx, driver_case_t* c)
+{
+  size_t batch = b->batches[idx];
+
+  if (batch > (size_t)b->dataset_size) {
+    printf("ERROR: --latency batch of %zu exceeds the dataset (%d options)\n",
+           batch, b->dataset_size);
+    return false;
   }
-  printf("Finished\n");
 
-  /* Verfication */
-  printf("  * Verifying results .... ");
-
-  bool match = __CHECK_FLOAT_MATCH(ref, dest, dataset_size, 1e-4);
-  bool guard = __CHECK_GUARD(dest, dataset_size * sizeof(float));
-
-  if (match && guard) {
-    printf("Success\n");
-  } else if (!match && guard) {
-    printf("Fail, but no buffer overruns\n");
-  } else if (match && !guard) {
-    printf("Success, but failed buffer overruns check\n");
-  } else if(!match && !guard) {
-    printf("Failed, and failed buffer overruns check\n");
-  }
-
-  /* Running analytics */
-  uint64_t min     = -1;
-  uint64_t max     =  0;
-
-  uint64_t avg     =  0;
-  uint64_t avg_n   =  0;
-
-  uint64_t std     =  0;
-  uint64_t std_n   =  0;
-
-  int      n_msked =  0;
-  int      n_stats =  0;
-
-  for (int i = 0; i < num_runs; i++)
-    runtimes_mask[i] = true;
-
-  printf("  * Running statistics:\n");
-  do {
-    n_stats++;
-    printf("    + Starting statistics run number #%d:\n", n_stats);
-    avg_n =  0;
-    avg   =  0;
-
-    /*   -> Calculate min, max, and avg */
-    for (int i = 0; i < num_runs; i++) {
-      if (runtimes_mask[i]) {
-        if (runtimes[i] < min) {
-          min = runtimes[i];
-        }
-        if (runtimes[i] > max) {
-          max = runtimes[i];
-        }
-        avg += runtimes[i];
-        avg_n += 1;
-      }
-    }
-    avg = avg / avg_n;
+  if (latency_init(&b->lat, batch) != 0) {
+    printf("ERROR: Cannot allocate the latency samples\n");
+    return false;
+  }
 
-    /*   -> Calculate standard deviation */
-    std   =  0;
-    std_n =  0;
+  b->args.latency = &b->lat;
 
-    for (int i = 0; i < num_runs; i++) {
-      if (runtimes_mask[i]) {
-        std   += ((runtimes[i] - avg) *
-                  (runtimes[i] - avg));
-        std_n += 1;
-      }
+  snprintf(b->labels[idx], sizeof(b->labels[idx]), "batch%zu", batch);
+  c->label = b->labels[idx];
+
+  return true;
+}
+
+/* Queues and lanes for every thread; call last */
+static bool blackscholes_setup_serve(blackscholes_t* b, const driver_env_t* env,
+                                     driver_case_t* c)
+{
+  if (serve_init(&b->sv, b->serve_rate, b->producers, b->serve_batch,
+                 env->nthreads) != 0) {
+    printf("ERROR: Cannot allocate the request queues\n");
+    return false;
+  }
+
+  b->args.serve = &b->sv;
+
+  /* The driver reports requests per second */
+  c->elems = (double)b->dataset_size;
+  c->unit  = "requests";
+
+  return true;
+}
+
+static bool blackscholes_setup(void* ctx, int idx, const driver_env_t* env,
+                               driver_case_t* c)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  if (b->stream && b->file == NULL) {
+    printf("ERROR: --stream needs a binary dataset (--file)\n");
+    return false;
+  }
+
+  if (b->stream && b->greeks) {
+    printf("ERROR: --greeks is not supported with --stream\n");
+    return false;
+  }
+
+  /* The double and mixed kernels price only */
+  if (b->precision != PRECISION_SINGLE && (b->stream || b->greeks)) {
+    printf("ERROR: --precision %s supports neither --stream nor --greeks\n",
+           precision_name(b->precision));
+    return false;
+  }
+
+  /* ... and so do the AoS and AoSoA ones, in single precision */
+  if (b->layout != LAYOUT_SOA &&
+      (b->stream || b->greeks || b->precision != PRECISION_SINGLE)) {
+    printf("ERROR: --layout %s supports none of --stream, --greeks and --precision\n",
+           layout_name(b->layout));
+    return false;
+  }
+
+  /* ... and the solver reads plain columns */
+  if (b->iv && (b->stream || b->greeks || b->precision != PRECISION_SINGLE ||
+                b->layout != LAYOUT_SOA)) {
+    printf("ERROR: --implied-vol supports none of --stream, --greeks, --precision and --layout\n");
+    return false;
+  }
+
+  /* ... and so does the latency mode, through price.h */
+  if (b->latency && (b->stream || b->greeks || b->precision != PRECISION_SINGLE ||
+                     b->layout != LAYOUT_SOA || b->iv)) {
+    printf("ERROR: --latency supports none of --stream, --greeks, --precision, --layout and --implied-vol\n");
+    return false;
+  }
+
+  if (b->serve && (b->stream || b->greeks || b->precision != PRECISION_SINGLE ||
+                   b->layout != LAYOUT_SOA || b->iv || b->latency)) {
+    printf("ERROR: --serve supports none of --stream, --greeks, --precision, --layout, --implied-vol and --latency\n");
+    return false;
+  }
+
+  /* The ranks price plain columns; every other mode leaves dist out */
+  bool mode = b->stream || b->greeks || b->precision != PRECISION_SINGLE ||
+              b->layout != LAYOUT_SOA || b->iv || b->latency || b->serve;
+
+  if (mode && env->dist->nranks > 1) {
+    printf("ERROR: --ranks supports none of --stream, --greeks, --precision, --layout, --implied-vol, --latency and --serve\n");
+    return false;
+  }
+
+  memset(&env->dist->phases, 0, sizeof(env->dist->phases));
+  env->dist->used = false;
+
+  if (b->stream) return blackscholes_setup_stream(b, env, c);
+
+  /* Single options want more than the 4 of the test dataset */
+  if ((b->latency || b->serve) && !b->dataset_set) b->dataset = 2;
+
+  bool ok = (b->file != NULL) ? blackscholes_setup_file   (b, env, c)
+                              : blackscholes_setup_dataset(b, env, c);
+
+  if (ok && b->latency) ok = blackscholes_setup_latency(b, idx, c);
+  if (ok && b->serve  ) ok = blackscholes_setup_serve  (b, env, c);
+
+  return ok;
+}
+
+static driver_check_t blackscholes_verify(void* ctx, int idx)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+  driver_check_t check = { 0 };
+
+  /* The pipeline checks every batch as it goes by */
+  if (b->stream) {
+    check.err   = b->st.err;
+    check.match = (b->st.err.mismatches == 0) && !b->st.io_err;
+    check.guard = true;
+
+    return check;
+  }
+
+  /* Solved volatilities pass if they reproduce the reference prices; deep
+   * in or out of the money, vega vanishes and the volatility itself is
+   * not determined */
+  if (b->iv) {
+    args_t args = b->args;
+
+    args.volatility = b->dest   ;
+    args.output     = b->reprice;
+    args.market     = NULL      ;
+    impl_parallel(&args);
+
+    check.match = check_floats(b->ref, b->reprice, b->dataset_size, 1e-4, &check.err);
+    check.guard = __CHECK_GUARD(b->dest, b->dataset_size * sizeof(float));
+
+    return check;
+  }
+
+  /* Double prices are rounded into dest and checked like the others */
+  if (b->precision == PRECISION_DOUBLE) {
+    for (int i = 0; i < b->dataset_size; i++) {
+      b->dest[i] = (float)b->pd.output[i];
     }
-    std = sqrt(std / std_n);
-
-    /*   -> Calculate outlier-free average (mean) */
-    n_msked = 0;
-    for (int i = 0; i < num_runs; i++) {
-      if (runtimes_mask[i]) {
-        if (runtimes[i] > avg) {
-          if ((runtimes[i] - avg) > (nstd * std)) {
-            runtimes_mask[i] = false;
-            n_msked += 1;
-          }
-        } else {
-          if ((avg - runtimes[i]) > (nstd * std)) {
-            runtimes_mask[i] = false;
-            n_msked += 1;
-          }
-        }
+  }
+
+  check.match = check_floats(b->ref, b->dest, b->dataset_size, 1e-4, &check.err);
+  check.guard = __CHECK_GUARD(b->dest, b->dataset_size * sizeof(float));
+
+  if (b->precision == PRECISION_DOUBLE) {
+    check.guard &= __CHECK_GUARD(b->pd.output, b->dataset_size * sizeof(double));
+  }
+
+  /* The error statistics stay those of the prices; mismatching Greeks
+   * are counted in with them */
+  if (b->greeks) {
+    for (int g = 0; g < BLACKSCHOLES_NGREEKS; g++) {
+      check_stats_t err;
+
+      if (!check_floats(b->greek_ref[g], b->greek[g], b->dataset_size,
+                        greeks_tolerance[g], &err)) {
+        check.match = false;
       }
-    }
+      check.guard &= __CHECK_GUARD(b->greek[g], b->dataset_size * sizeof(float));
 
-    printf("      - Standard deviation = %" PRIu64 "\n", std);
-    printf("      - Average = %" PRIu64 "\n", avg);
-    printf("      - Number of active elements = %" PRIu64 "\n", avg_n);
-    printf("      - Number of masked-off = %d\n", n_msked);
-  } while (n_msked > 0);
-  /* Display information */
-  printf("  * Runtimes (%s): ", __PRINT_MATCH(match));
-  printf(" %" PRIu64 " ns\n"  , avg                 );
-
-  /* Dump */
-  printf("  * Dumping runtime informations:\n");
-  FILE * fp;
-  char filename[256];
-  strcpy(filename, impl_str);
-  strcat(filename, "_runtimes.csv");
-  printf("    - Filename: %s\n", filename);
-  printf("    - Opening file .... ");
-  fp = fopen(filename, "w");
-
-  if (fp != NULL) {
-    printf("Succeeded\n");
-    printf("    - Writing runtimes ... ");
-    fprintf(fp, "impl,%s", impl_str);
-
-    fprintf(fp, "\n");
-    fprintf(fp, "num_of_runs,%d", num_runs);
-
-    fprintf(fp, "\n");
-    fprintf(fp, "runtimes");
-    for (int i = 0; i < num_runs; i++) {
-      fprintf(fp, ", ");
-      fprintf(fp, "%" PRIu64 "", runtimes[i]);
+      if (err.first_bad < check.err.first_bad) check.err.first_bad = err.first_bad;
+      check.err.mismatches += err.mismatches;
     }
+  }
 
-    fprintf(fp, "\n");
-    fprintf(fp, "avg,%" PRIu64 "", avg);
-    printf("Finished\n");
-    printf("    - Closing file handle .... ");
-    fclose(fp);
-    printf("Finished\n");
-  } else {
-    printf("Failed\n");
+  return check;
+}
+
+static void blackscholes_report(void* ctx, int idx)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  if (b->latency) latency_print(&b->lat, "  ");
+  if (b->serve  ) serve_print  (&b->sv , "  ");
+  if (b->args.dist != NULL && b->args.dist->used) dist_print(b->args.dist, "  ");
+}
+
+static void blackscholes_reset(void* ctx, int idx)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  /* The next implementation reports only if it is distributed too */
+  if (b->args.dist != NULL) b->args.dist->used = false;
+
+  /* Every streamed run starts from the file again */
+  if (b->stream) return;
+
+  /* Clear the output, leaving the guard intact */
+  memset(b->dest, 0, b->dataset_size * sizeof(float));
+
+  if (b->pd.output != NULL) {
+    memset(b->pd.output, 0, b->dataset_size * sizeof(double));
   }
-  printf("\n");
+
+  if (b->greeks) {
+    for (int g = 0; g < BLACKSCHOLES_NGREEKS; g++) {
+      memset(b->greek[g], 0, b->dataset_size * sizeof(float));
+    }
+  }
+}
+
+static void blackscholes_timed(void* ctx, int idx, bool on)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  if (b->latency) latency_timed(&b->lat, on);
+  if (b->serve  ) serve_timed  (&b->sv , on);
+}
+
+static void blackscholes_set_nthreads(void* ctx, int idx, int nthreads)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  b->args.nthreads = nthreads;
+}
+
+static void blackscholes_rotate(void* ctx, int idx, int copy)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  b->args.sptPrice   = b->copy_col [copy][0];
+  b->args.strike     = b->copy_col [copy][1];
+  b->args.rate       = b->copy_col [copy][2];
+  b->args.volatility = b->copy_col [copy][3];
+  b->args.otime      = b->copy_col [copy][4];
+  b->args.otype      = b->copy_type[copy];
+}
+
+static void blackscholes_dump(void* ctx, int idx, FILE* fp)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  fprintf(fp, "\ndataset,%s\nsize,%d\nprecision,%s\nlayout,%s\ngreeks,%d\nimplied_vol,%d\nsized,%d",
+          (b->file != NULL) ? b->file : __dataset_name(b->dataset), b->dataset_size,
+          precision_name(b->precision), layout_name(b->layout), b->greeks, b->iv,
+          price_sized);
+
+  if (b->latency) latency_dump(&b->lat, fp);
+  if (b->serve  ) serve_dump  (&b->sv , fp);
+  if (b->args.dist != NULL && b->args.dist->used) dist_dump(b->args.dist, fp);
+}
+
+static int blackscholes_serve(void* ctx, const driver_env_t* env)
+{
+  return dist_worker(env);
+}
+
+static int blackscholes_ncases(void* ctx)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  return b->latency ? b->nbatches : 1;
+}
+
+static void blackscholes_teardown(void* ctx, int idx)
+{
+  blackscholes_t* b = (blackscholes_t*)ctx;
+
+  if (b->latency) latency_destroy(&b->lat);
+  if (b->serve  ) serve_destroy  (&b->sv );
 
   /* Manage memory */
-  free(sptPrice);
-  free(strike);
-  free(rate);
-  free(volatility);
-  free(otime);
-  free(otype);
-  free(dest);
-  free(ref);
-
-  /* Finished with statistics */
-  __DESTROY_STATS();
-
-  /* Done */
-  return 0;
+  __FREE_DATA(b->pd.sptPrice);
+  __FREE_DATA(b->pd.strike);
+  __FREE_DATA(b->pd.rate);
+  __FREE_DATA(b->pd.volatility);
+  __FREE_DATA(b->pd.otime);
+  __FREE_DATA(b->pd.output);
+  memset(&b->pd, 0, sizeof(b->pd));
+
+  __FREE_DATA(b->reprice); b->reprice = NULL;
+  __FREE_DATA(b->recs  ); b->recs   = NULL;
+  __FREE_DATA(b->blocks); b->blocks = NULL;
+
+  for (int g = 0; g < BLACKSCHOLES_NGREEKS; g++) {
+    __FREE_DATA(b->greek    [g]); b->greek    [g] = NULL;
+    __FREE_DATA(b->greek_ref[g]); b->greek_ref[g] = NULL;
+  }
+
+  for (int k = 1; k < b->ncopies; k++) {
+    for (int j = 0; j < 5; j++) __FREE_DATA(b->copy_col[k][j]);
+    __FREE_DATA(b->copy_type[k]);
+  }
+  memset(b->copy_col , 0, sizeof(b->copy_col ));
+  memset(b->copy_type, 0, sizeof(b->copy_type));
+  b->ncopies = 0;
+
+  if (b->stream) {
+    stream_close(&b->st);
+    return;
+  }
+
+  if (b->file != NULL) {
+    __FREE_DATA(b->dest);
+    dsfile_unmap(&b->ds);
+    return;
+  }
+
+  __FREE_DATA(b->sptPrice);
+  __FREE_DATA(b->strike);
+  __FREE_DATA(b->rate);
+  __FREE_DATA(b->volatility);
+  __FREE_DATA(b->otime);
+  __FREE_DATA(b->otype);
+  __FREE_DATA(b->dest);
+  __FREE_DATA(b->ref);
+}
+
+
+int main(int argc, char** argv)
+{
+  blackscholes_t ctx;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.dataset = 0;
+
+  ctx.serve_rate  = SERVE_RATE;
+  ctx.producers   = SERVE_PRODUCERS;
+  ctx.serve_batch = SERVE_BATCH;
+
+  driver_bench_t bench = {
+    .name         = "blackscholes",
+    .impls        = impls,
+    .nimpls       = sizeof(impls) / sizeof(impls[0]),
+
+    .nruns        = 128,
+    .ninner       = 4,
+    .nwarmup      = 0,
+
+    .ctx          = &ctx,
+
+    .parse_arg    = blackscholes_parse_arg,
+    .usage        = blackscholes_usage,
+    .ncases       = blackscholes_ncases,
+    .setup        = blackscholes_setup,
+    .verify       = blackscholes_verify,
+    .report       = blackscholes_report,
+    .reset        = blackscholes_reset,
+    .timed        = blackscholes_timed,
+    .dump         = blackscholes_dump,
+    .teardown     = blackscholes_teardown,
+    .set_nthreads = blackscholes_set_nthreads,
+    .rotate       = blackscholes_rotate,
+    .serve        = blackscholes_serve,
+  };
+
+  return driver_main(&bench, argc, argv);
 }
@@ -0,0 +1,350 @@
+/* affinity.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the thread placement planner; see affinity.h.
+ */
+
+/* Set features */
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <sched.h>
+#include <unistd.h>
+
+/* If we are on Darwin, include the compatibility header */
+#if defined(__APPLE__)
+#include "common/mach_pthread_compatibility.h"
+#endif
+
+/* Include common headers */
+#include "common/affinity.h"
+
+#if !defined(CPU_SETSIZE)
+#define CPU_SETSIZE 1024
+#endif
+
+static const char* affinity_names[AFFINITY_NUM] = {
+  "linear", "compact", "scatter", "one-per-core", "pcores-only"
+};
+
+typedef struct {
+  int  cpu;
+  int  core;
+  int  package;
+  long capacity;
+  bool ecore;
+} affinity_cpu_t;
+
+/* A core: n siblings from cpus[first], sorted by CPU number */
+typedef struct {
+  int  first;
+  int  n;
+  int  package;
+  bool ecore;
+} affinity_core_t;
+
+static struct {
+  bool             loaded;
+  int              ncpus;
+  affinity_cpu_t*  cpus;
+  int              ncores;
+  affinity_core_t* cores;
+} affinity_topo;
+
+/* An integer from a sysfs file, or def */
+static long affinity_read(const char* fmt, int cpu, long def)
+{
+  char  path[128];
+  long  v;
+  FILE* fp;
+
+  snprintf(path, sizeof(path), fmt, cpu);
+  fp = fopen(path, "r");
+  if (fp == NULL) return def;
+  if (fscanf(fp, "%ld", &v) != 1) v = def;
+  fclose(fp);
+
+  return v;
+}
+
+/* Mark the CPUs of a sysfs list ("0-7,16,18-19"); false if unreadable */
+static bool affinity_read_list(const char* path, bool* set, int max)
+{
+  FILE* fp = fopen(path, "r");
+  if (fp == NULL) return false;
+
+  int  lo, hi;
+  bool ok = false;
+
+  while (fscanf(fp, "%d", &lo) == 1) {
+    hi = lo;
+    if (fscanf(fp, "-%d", &hi) != 1) hi = lo;
+    for (int c = lo; c <= hi && c < max; c++) {
+      if (c >= 0) set[c] = true;
+    }
+    ok = true;
+    if (fgetc(fp) != ',') break;
+  }
+  fclose(fp);
+
+  return ok;
+}
+
+static int affinity_cmp(const void* a, const void* b)
+{
+  const affinity_cpu_t* x = (const affinity_cpu_t*)a;
+  const affinity_cpu_t* y = (const affinity_cpu_t*)b;
+
+  if (x->package != y->package) return x->package - y->package;
+  if (x->core    != y->core   ) return x->core    - y->core;
+  return x->cpu - y->cpu;
+}
+
+static void affinity_load(void)
+{
+  if (affinity_topo.loaded) return;
+  affinity_topo.loaded = true;
+
+  /* The CPUs we may run on, before the driver narrows the mask */
+  bool* allowed = (bool*)calloc(CPU_SETSIZE, sizeof(bool));
+  bool* ecores  = (bool*)calloc(CPU_SETSIZE, sizeof(bool));
+  int   n       = 0;
+
+  if (allowed == NULL || ecores == NULL) {
+    free(allowed);
+    free(ecores);
+    return;
+  }
+
+#if defined(__linux__)
+  cpu_set_t mask;
+
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (int c = 0; c < CPU_SETSIZE; c++) allowed[c] = CPU_ISSET(c, &mask);
+  } else
+#elif defined(__APPLE__)
+  /* Our own numbering, performance cores first (see the compatibility
+   * header) */
+  int nperf = 0;
+  int smt   = mach_cpu_smt();
+  int ncpus = mach_cpu_count(&nperf);
+
+  if (ncpus > 0) {
+    for (int c = 0; c < ncpus && c < CPU_SETSIZE; c++) allowed[c] = true;
+  } else
+#endif
+  {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    for (int c = 0; c < online && c < CPU_SETSIZE; c++) allowed[c] = true;
+  }
+
+  for (int c = 0; c < CPU_SETSIZE; c++) n += allowed[c];
+
+  affinity_topo.cpus  = (affinity_cpu_t* )calloc(n > 0 ? n : 1, sizeof(affinity_cpu_t));
+  affinity_topo.cores = (affinity_core_t*)calloc(n > 0 ? n : 1, sizeof(affinity_core_t));
+  if (affinity_topo.cpus == NULL || affinity_topo.cores == NULL) {
+    free(allowed);
+    free(ecores);
+    return;
+  }
+
+  /* Hybrid Intel parts list their Atom CPUs; elsewhere the capacity
+   * tells big from little cores */
+  bool listed = affinity_read_list("/sys/devices/cpu_atom/cpus", ecores, CPU_SETSIZE);
+  long maxcap = 0;
+
+  for (int c = 0; c < CPU_SETSIZE; c++) {
+    if (!allowed[c]) continue;
+
+    affinity_cpu_t* p = &affinity_topo.cpus[affinity_topo.ncpus++];
+
+    p->cpu      = c;
+    p->core     = (int)affinity_read("/sys/devices/system/cpu/cpu%d/topology/core_id", c, c);
+    p->package  = (int)affinity_read("/sys/devices/system/cpu/cpu%d/topology/physical_package_id", c, 0);
+    p->capacity = affinity_read("/sys/devices/system/cpu/cpu%d/cpu_capacity", c, 0);
+    p->ecore    = listed && ecores[c];
+#if defined(__APPLE__)
+    p->core     = c / smt;
+    p->capacity = (c < nperf) ? 1024 : 512;
+#endif
+    if (p->package < 0) p->package = 0;
+    if (p->capacity > maxcap) maxcap = p->capacity;
+  }
+
+  for (int i = 0; !listed && i < affinity_topo.ncpus; i++) {
+    affinity_cpu_t* p = &affinity_topo.cpus[i];
+    p->ecore = (p->capacity > 0 && p->capacity < maxcap);
+  }
+
+  free(allowed);
+  free(ecores);
+
+  /* Siblings next to each other, cores in order within a package */
+  qsort(affinity_topo.cpus, affinity_topo.ncpus, sizeof(affinity_cpu_t), affinity_cmp);
+
+  for (int i = 0; i < affinity_topo.ncpus; i++) {
+    affinity_cpu_t*  p = &affinity_topo.cpus[i];
+    affinity_cpu_t*  q = (i > 0) ? &affinity_topo.cpus[i - 1] : NULL;
+    affinity_core_t* g = &affinity_topo.cores[affinity_topo.ncores > 0 ?
+                                              affinity_topo.ncores - 1 : 0];
+
+    if (q == NULL || p->package != q->package || p->core != q->core) {
+      g = &affinity_topo.cores[affinity_topo.ncores++];
+      g->first   = i;
+      g->n       = 0;
+      g->package = p->package;
+      g->ecore   = p->ecore;
+    }
+    g->n++;
+  }
+}
+
+void affinity_info(affinity_info_t* info)
+{
+  affinity_load();
+
+  memset(info, 0, sizeof(*info));
+  info->ncpus  = affinity_topo.ncpus;
+  info->ncores = affinity_topo.ncores;
+
+  for (int g = 0; g < affinity_topo.ncores; g++) {
+    const affinity_core_t* core = &affinity_topo.cores[g];
+
+    if (core->package + 1 > info->npackages) info->npackages = core->package + 1;
+    if (core->ecore) info->hybrid = true;
+    else             info->npcores++;
+  }
+}
+
+/* Sibling s of the j-th core from start; the -c CPU is sibling 0 of its
+ * own core */
+static int affinity_sibling(int j, int start, int cpu, int s)
+{
+  const affinity_core_t* g   = &affinity_topo.cores[(start + j) % affinity_topo.ncores];
+  const affinity_cpu_t*  sib = &affinity_topo.cpus[g->first];
+  int                    at  = 0;
+
+  if (j == 0) {
+    for (int k = 0; k < g->n; k++) {
+      if (sib[k].cpu == cpu) at = k;
+    }
+  }
+
+  if (s == 0) return sib[at].cpu;
+  return sib[(s <= at) ? s - 1 : s].cpu;
+}
+
+int affinity_plan(affinity_policy_t policy, int cpu, int nthreads, int* cpus)
+{
+  if (policy == AFFINITY_LINEAR) {
+    for (int i = 0; i < nthreads; i++) cpus[i] = cpu + i;
+    return 0;
+  }
+
+  affinity_load();
+
+  int ncores = affinity_topo.ncores;
+  if (ncores == 0) return -1;
+
+  /* The walk starts at -c's core, or at the first one */
+  int start = 0;
+  for (int g = 0; g < ncores; g++) {
+    const affinity_core_t* core = &affinity_topo.cores[g];
+    for (int k = 0; k < core->n; k++) {
+      if (affinity_topo.cpus[core->first + k].cpu == cpu) start = g;
+    }
+  }
+
+  int* plan = (int*)malloc(affinity_topo.ncpus * sizeof(int));
+  int* rank = (int*)malloc(ncores * sizeof(int));
+  int  n    = 0;
+
+  if (plan == NULL || rank == NULL) {
+    free(plan);
+    free(rank);
+    return -1;
+  }
+
+  if (policy == AFFINITY_COMPACT) {
+    for (int j = 0; j < ncores; j++) {
+      const affinity_core_t* g = &affinity_topo.cores[(start + j) % ncores];
+      for (int s = 0; s < g->n; s++) plan[n++] = affinity_sibling(j, start, cpu, s);
+    }
+  } else if (policy == AFFINITY_ONE_PER_CORE) {
+    for (int j = 0; j < ncores; j++) plan[n++] = affinity_sibling(j, start, cpu, 0);
+  } else {
+    /* Round-robin over the packages by each core's rank within its
+     * package; one sibling per core per pass */
+    bool pcores  = (policy == AFFINITY_PCORES);
+    int  maxsib  = 0;
+    int  maxrank = 0;
+    int  npkgs   = 0;
+    int  pkgs[ncores];
+
+    for (int j = 0; j < ncores; j++) {
+      const affinity_core_t* g = &affinity_topo.cores[(start + j) % ncores];
+      int                    r = 0;
+
+      rank[j] = -1;
+      if (pcores && g->ecore) continue;
+
+      for (int i = 0; i < j; i++) {
+        const affinity_core_t* h = &affinity_topo.cores[(start + i) % ncores];
+        if (rank[i] >= 0 && h->package == g->package) r++;
+      }
+      rank[j] = r;
+
+      bool seen = false;
+      for (int p = 0; p < npkgs; p++) seen |= (pkgs[p] == g->package);
+      if (!seen) pkgs[npkgs++] = g->package;
+
+      if (g->n > maxsib ) maxsib  = g->n;
+      if (r + 1 > maxrank) maxrank = r + 1;
+    }
+
+    for (int s = 0; s < maxsib; s++) {
+      for (int r = 0; r < maxrank; r++) {
+        for (int p = 0; p < npkgs; p++) {
+          for (int j = 0; j < ncores; j++) {
+            const affinity_core_t* g = &affinity_topo.cores[(start + j) % ncores];
+            if (rank[j] == r && g->package == pkgs[p] && s < g->n) {
+              plan[n++] = affinity_sibling(j, start, cpu, s);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  int ret = -1;
+  if (n >= nthreads) {
+    memcpy(cpus, plan, nthreads * sizeof(int));
+    ret = 0;
+  }
+
+  free(plan);
+  free(rank);
+
+  return ret;
+}
+
+const char* affinity_name(affinity_policy_t policy)
+{
+  return (policy >= 0 && policy < AFFINITY_NUM) ? affinity_names[policy] : "unknown";
+}
+
+affinity_policy_t affinity_parse(const char* name)
+{
+  for (int p = 0; p < AFFINITY_NUM; p++) {
+    if (strcmp(name, affinity_names[p]) == 0) return (affinity_policy_t)p;
+  }
+
+  return AFFINITY_NUM;
+}
@@ -0,0 +1,63 @@
+/* affinity.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the thread placement planner behind the driver's
+ * --affinity option. The topology comes from sysfs on Linux: the core
+ * and package of every CPU (topology/core_id, physical_package_id) and,
+ * on hybrid parts, which CPUs are efficiency cores (/sys/devices/
+ * cpu_atom/cpus on Intel, a lower cpu_capacity on Arm big.LITTLE). Only
+ * the CPUs the process may run on at startup are planned over. On
+ * Darwin, which numbers no CPUs, the compatibility layer's numbering is
+ * used (common/mach_pthread_compatibility.h): performance cores first.
+ *
+ * Every policy returns one CPU per thread, thread 0 first:
+ *
+ *   linear        cpu, cpu + 1, ... whatever they are (the historical
+ *                 placement, and the default)
+ *   compact       fill every SMT sibling of a core before the next core
+ *   scatter       one thread per core, alternating packages, before any
+ *                 second sibling
+ *   one-per-core  one thread per core, never two siblings
+ *   pcores-only   like scatter, but on performance cores only
+ *
+ * Apart from linear the walk starts at the core of -c | --cpu, which
+ * thread 0 gets.
+*/
+
+#ifndef __COMMON_AFFINITY_H_
+#define __COMMON_AFFINITY_H_
+
+#include <stdio.h>
+#include <stdbool.h>
+
+typedef enum {
+  AFFINITY_LINEAR = 0,
+  AFFINITY_COMPACT,
+  AFFINITY_SCATTER,
+  AFFINITY_ONE_PER_CORE,
+  AFFINITY_PCORES,
+  AFFINITY_NUM
+} affinity_policy_t;
+
+/* What the planner sees */
+typedef struct {
+  int  ncpus;                  /* Allowed CPUs             */
+  int  ncores;                 /* Cores with an allowed CPU */
+  int  npackages;
+  int  npcores;                /* Performance cores        */
+  bool hybrid;
+} affinity_info_t;
+
+void              affinity_info (affinity_info_t* info);
+
+/* Thread i runs on cpus[i]; -1 if the policy has fewer CPUs than
+ * nthreads (nothing is written then) */
+int               affinity_plan (affinity_policy_t policy, int cpu,
+                                 int nthreads, int* cpus);
+
+const char*       affinity_name (affinity_policy_t policy);
+affinity_policy_t affinity_parse(const char* name);  /* AFFINITY_NUM if unknown */
+
+#endif //__COMMON_AFFINITY_H_
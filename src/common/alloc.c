@@ -0,0 +1,255 @@
+/* alloc.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the benchmark data allocator; see alloc.h.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+
+/* Include common headers */
+#include "common/alloc.h"
+
+/* Every block starts with a header one cache line long, so the data that
+ * follows keeps the 64-byte alignment of the block */
+#define MEM_HEADER 64
+
+#define MEM_2M     (2ull << 20)
+#define MEM_1G     (1ull << 30)
+
+/* Page-size encoding for MAP_HUGETLB (linux/mman.h) */
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+/* Memory policies for mbind (linux/mempolicy.h) */
+#define MEM_MPOL_BIND       2
+#define MEM_MPOL_INTERLEAVE 3
+
+typedef enum {
+  MEM_KIND_HEAP = 0,   /* aligned_alloc         */
+  MEM_KIND_MAP,        /* mmap, released by munmap */
+} mem_kind_t;
+
+typedef struct {
+  void*      base;
+  size_t     length;
+  mem_kind_t kind;
+} mem_header_t;
+
+static const char* pages_names[MEM_PAGES_NUM] = {
+  "default",
+  "thp",
+  "2m",
+  "1g",
+};
+
+static mem_policy_t policy = { MEM_PAGES_DEFAULT, MEM_NUMA_LOCAL, 0, false };
+
+void mem_set_policy(const mem_policy_t* p)
+{
+  policy = *p;
+}
+
+const mem_policy_t* mem_get_policy(void)
+{
+  return &policy;
+}
+
+const char* mem_pages_name(mem_pages_t pages)
+{
+  return (pages < MEM_PAGES_NUM) ? pages_names[pages] : "unknown";
+}
+
+mem_pages_t mem_pages_parse(const char* name)
+{
+  for (int i = 0; i < MEM_PAGES_NUM; i++) {
+    if (strcmp(name, pages_names[i]) == 0) return (mem_pages_t)i;
+  }
+
+  return MEM_PAGES_NUM;
+}
+
+bool mem_numa_parse(const char* name, mem_policy_t* p)
+{
+  if (strcmp(name, "local") == 0) {
+    p->numa = MEM_NUMA_LOCAL;
+    return true;
+  }
+
+  if (strcmp(name, "interleave") == 0) {
+    p->numa = MEM_NUMA_INTERLEAVE;
+    return true;
+  }
+
+  char* end;
+  long  node = strtol(name, &end, 10);
+  if (end == name || *end != '\0' || node < 0 || node >= 64) return false;
+
+  p->numa = MEM_NUMA_BIND;
+  p->node = (int)node;
+
+  return true;
+}
+
+static size_t mem_round_up(size_t n, size_t align)
+{
+  return (n + align - 1) / align * align;
+}
+
+/* Print a fallback warning once per reason */
+static void mem_warn_once(bool* done, const char* msg)
+{
+  if (*done) return;
+  *done = true;
+
+  printf("\n");
+  printf("  WARNING: %s\n", msg);
+}
+
+/* Anonymous mapping of length bytes whose start is aligned to align */
+static void* mem_map_aligned(size_t length, size_t align, void** base,
+                             size_t* mapped)
+{
+  size_t total = mem_round_up(length, align) + align;
+  void*  p     = mmap(NULL, total, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED) return NULL;
+
+  *base   = p;
+  *mapped = total;
+
+  return (void*)mem_round_up((uintptr_t)p, align);
+}
+
+/* Place [addr, addr + length) according to the NUMA policy; must run
+ * before the pages are first touched */
+static void mem_place(void* addr, size_t length)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+  static bool warned = false;
+
+  if (policy.numa == MEM_NUMA_LOCAL) return;
+
+  unsigned long mask = 0;
+  int           mode = MEM_MPOL_BIND;
+
+  if (policy.numa == MEM_NUMA_BIND) {
+    mask = 1ul << policy.node;
+  } else {
+    mask = ~0ul;               /* The kernel trims this to allowed nodes */
+    mode = MEM_MPOL_INTERLEAVE;
+  }
+
+  /* mbind wants page-aligned ranges */
+  long      pg    = sysconf(_SC_PAGESIZE);
+  uintptr_t start = (uintptr_t)addr & ~(uintptr_t)(pg - 1);
+  uintptr_t end   = mem_round_up((uintptr_t)addr + length, pg);
+
+  if (syscall(SYS_mbind, (void*)start, end - start, mode, &mask,
+              sizeof(mask) * 8 + 1, 0) != 0) {
+    mem_warn_once(&warned, "NUMA placement failed; using first touch");
+  }
+#else
+  (void)addr;
+  (void)length;
+#endif
+}
+
+void* mem_alloc(size_t nbytes)
+{
+  static bool warned_2m = false;
+  static bool warned_1g = false;
+
+  size_t       length = mem_round_up(nbytes + MEM_HEADER, 64);
+  mem_header_t hdr    = { NULL, 0, MEM_KIND_MAP };
+  char*        block  = NULL;
+
+  /* Pages reserved through hugetlbfs */
+#if defined(MAP_HUGETLB)
+  if (policy.pages == MEM_PAGES_2M || policy.pages == MEM_PAGES_1G) {
+    size_t huge  = (policy.pages == MEM_PAGES_1G) ? MEM_1G : MEM_2M;
+    int    shift = (policy.pages == MEM_PAGES_1G) ? 30 : 21;
+    size_t len   = mem_round_up(length, huge);
+
+    void*  p     = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB |
+                        (shift << MAP_HUGE_SHIFT), -1, 0);
+    if (p != MAP_FAILED) {
+      hdr.base   = p;
+      hdr.length = len;
+      block      = (char*)p;
+    } else if (policy.pages == MEM_PAGES_1G) {
+      mem_warn_once(&warned_1g, "no 1 GiB huge pages reserved; using transparent huge pages");
+    } else {
+      mem_warn_once(&warned_2m, "no 2 MiB huge pages reserved; using transparent huge pages");
+    }
+  }
+#endif
+
+  /* Transparent huge pages on a 2 MiB aligned mapping */
+  if (block == NULL && policy.pages != MEM_PAGES_DEFAULT) {
+    block = (char*)mem_map_aligned(length, MEM_2M, &hdr.base, &hdr.length);
+    if (block == NULL) return NULL;
+#if defined(MADV_HUGEPAGE)
+    madvise(block, mem_round_up(length, MEM_2M), MADV_HUGEPAGE);
+#endif
+  }
+
+  /* A private mapping of regular pages, so that NUMA placement does not
+   * move heap pages shared with other allocations */
+  if (block == NULL && policy.numa != MEM_NUMA_LOCAL) {
+    block = (char*)mem_map_aligned(length, 64, &hdr.base, &hdr.length);
+    if (block == NULL) return NULL;
+  }
+
+  /* Regular heap memory */
+  if (block == NULL) {
+    block = (char*)aligned_alloc(64, length);
+    if (block == NULL) return NULL;
+
+    hdr.base   = block;
+    hdr.length = length;
+    hdr.kind   = MEM_KIND_HEAP;
+  }
+
+  mem_place(block, length);
+
+  if (policy.prefault) {
+    long pg = sysconf(_SC_PAGESIZE);
+    for (size_t off = 0; off < length; off += pg) {
+      ((volatile char*)block)[off] = 0;
+    }
+    ((volatile char*)block)[length - 1] = 0;
+  }
+
+  memcpy(block, &hdr, sizeof(hdr));
+
+  return block + MEM_HEADER;
+}
+
+void mem_free(void* ptr)
+{
+  if (ptr == NULL) return;
+
+  mem_header_t hdr;
+  memcpy(&hdr, (char*)ptr - MEM_HEADER, sizeof(hdr));
+
+  if (hdr.kind == MEM_KIND_HEAP) {
+    free(hdr.base);
+  } else {
+    munmap(hdr.base, hdr.length);
+  }
+}
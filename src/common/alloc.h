@@ -0,0 +1,74 @@
+/* alloc.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the allocator behind __ALLOC_DATA (common/macros.h).
+ * Benchmark data is large and streamed, so page size and placement show
+ * up directly in the measurements: a 10M-option dataset or a large GEMM
+ * spends a good part of its time on TLB misses with 4 KiB pages, and on
+ * a multi-socket host first touch from the main thread puts every page
+ * on one node.
+ *
+ * One process-wide policy applies to every allocation; the driver sets
+ * it from --pages, --numa and --prefault before any benchmark data is
+ * allocated:
+ *
+ *   pages     default  : malloc-backed, whatever the system does
+ *             thp      : 2 MiB aligned anonymous mapping + MADV_HUGEPAGE
+ *             2m / 1g  : MAP_HUGETLB from the reserved pool; falls back
+ *                        to thp (with a warning) if the pool is empty
+ *   numa      local    : first-touch placement
+ *             <node>   : bind the pages to one node (MPOL_BIND)
+ *             interleave: spread pages over all allowed nodes
+ *   prefault           : touch every page at allocation, so no page
+ *                        fault is ever taken inside a timed run
+ *
+ * Sizes are 64-bit throughout. Every block is at least 64-byte aligned
+ * and must be released with mem_free() (__FREE_DATA), never free().
+*/
+
+#ifndef __COMMON_ALLOC_H_
+#define __COMMON_ALLOC_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef enum {
+  MEM_PAGES_DEFAULT = 0,
+  MEM_PAGES_THP,
+  MEM_PAGES_2M,
+  MEM_PAGES_1G,
+  MEM_PAGES_NUM
+} mem_pages_t;
+
+typedef enum {
+  MEM_NUMA_LOCAL = 0,
+  MEM_NUMA_BIND,
+  MEM_NUMA_INTERLEAVE,
+} mem_numa_t;
+
+typedef struct {
+  mem_pages_t pages;
+  mem_numa_t  numa;
+  int         node;       /* Node for MEM_NUMA_BIND */
+  bool        prefault;
+} mem_policy_t;
+
+/* Process-wide policy; the default is all-default, no prefault */
+void                 mem_set_policy(const mem_policy_t* policy);
+const mem_policy_t*  mem_get_policy(void);
+
+/* Allocate nbytes (64-byte aligned) under the current policy; NULL on
+ * failure. mem_free accepts NULL. */
+void*        mem_alloc      (size_t nbytes);
+void         mem_free       (void* ptr);
+
+/* Option strings */
+const char*  mem_pages_name (mem_pages_t pages);
+mem_pages_t  mem_pages_parse(const char* name);   /* MEM_PAGES_NUM if unknown */
+
+/* "local", "interleave" or a node number; false if unknown */
+bool         mem_numa_parse (const char* name, mem_policy_t* policy);
+
+#endif //__COMMON_ALLOC_H_
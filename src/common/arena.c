@@ -0,0 +1,48 @@
+/* arena.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the scratch arena; see arena.h.
+ */
+
+/* Standard C includes */
+#include <unistd.h>
+
+/* Include common headers */
+#include "common/alloc.h"
+#include "common/arena.h"
+
+int arena_reserve(arena_t* a, size_t bytes)
+{
+  bytes = arena_bytes(bytes);
+
+  if (bytes > a->size) {
+    arena_destroy(a);
+
+    a->base = (char*)mem_alloc(bytes);
+    if (a->base == NULL) return -1;
+    a->size = bytes;
+
+    /* First touch here, on the owning thread, and never in a timed run */
+    long pg = sysconf(_SC_PAGESIZE);
+    for (size_t off = 0; off < bytes; off += pg) {
+      ((volatile char*)a->base)[off] = 0;
+    }
+  }
+
+  a->used = 0;
+  a->peak = 0;
+
+  return 0;
+}
+
+void arena_destroy(arena_t* a)
+{
+  mem_free(a->base);
+
+  a->base = NULL;
+  a->size = 0;
+  a->used = 0;
+  a->peak = 0;
+}
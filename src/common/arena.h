@@ -0,0 +1,77 @@
+/* arena.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains a bump-pointer arena for scratch memory inside
+ * kernels (packing buffers, intermediates, ...). Every thread of the
+ * worker pool owns one (pool_arena(), common/pool.h); the driver grows
+ * them to what each case declares in driver_case_t.scratch before any
+ * timing, touching every page from the owning thread, and rewinds them
+ * after every timed run. Taking scratch in the hot path is then a couple
+ * of adds: no syscalls, no locks and no page faults.
+ *
+ * A kernel brackets its use with a mark so that repeated invocations
+ * within one timed run do not pile up:
+ *
+ *   size_t mark = arena_mark(a);
+ *   float* buf  = (float*)arena_alloc(a, n * sizeof(float));
+ *   ...
+ *   arena_rewind(a, mark);
+ *
+ * Blocks are 64-byte aligned. Running out means the case declared too
+ * little scratch; arena_alloc reports it and exits, like __ALLOC_DATA.
+*/
+
+#ifndef __COMMON_ARENA_H_
+#define __COMMON_ARENA_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+#define ARENA_ALIGN 64
+
+typedef struct arena_t {
+  char*   base;
+  size_t  size;
+  size_t  used;
+  size_t  peak;    /* High-water mark since the last reserve */
+} arena_t;
+
+/* Grow a to at least bytes (contents are discarded) and touch every page
+ * from the calling thread; 0 on success */
+int     arena_reserve(arena_t* a, size_t bytes);
+void    arena_destroy(arena_t* a);
+
+/* Bytes a block of the given size takes from an arena, alignment included */
+static inline size_t arena_bytes(size_t bytes)
+{
+  return (bytes + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+}
+
+static inline void* arena_alloc(arena_t* a, size_t bytes)
+{
+  size_t used = a->used + arena_bytes(bytes);
+
+  if (__builtin_expect(used > a->size, 0)) {
+    printf("\n");
+    printf("  ERROR: Scratch arena exhausted (%zu of %zu bytes)!", used, a->size);
+    printf("\n");
+    printf("\n");
+    exit(-2);
+  }
+
+  void* p = a->base + a->used;
+
+  a->used = used;
+  if (used > a->peak) a->peak = used;
+
+  return p;
+}
+
+static inline size_t arena_mark  (const arena_t* a)      { return a->used; }
+static inline void   arena_rewind(arena_t* a, size_t m)  { a->used = m;    }
+static inline void   arena_reset (arena_t* a)            { a->used = 0;    }
+
+#endif //__COMMON_ARENA_H_
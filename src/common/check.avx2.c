@@ -0,0 +1,74 @@
+/* check.avx2.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX2 variant of the floating-point verifier; see check.h.
+ */
+
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/check.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+static inline float hmax256(__m256 v)
+{
+  __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+
+  m = _mm_max_ps(m, _mm_movehl_ps(m, m));
+  m = _mm_max_ss(m, _mm_shuffle_ps(m, m, 1));
+
+  return _mm_cvtss_f32(m);
+}
+
+void check_floats_avx2(const float* ref, const float* out, size_t n,
+                       float delta, check_stats_t* stats)
+{
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  const __m256 vdelta   = _mm256_set1_ps(delta);
+  const __m256 zero     = _mm256_setzero_ps();
+
+  __m256 vabs = zero;
+  __m256 vrel = zero;
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 r = _mm256_loadu_ps(&ref[i]);
+    __m256 o = _mm256_loadu_ps(&out[i]);
+    __m256 d = _mm256_and_ps(_mm256_sub_ps(r, o), abs_mask);
+
+    /* Ordered compare: NaNs fail */
+    int bad = ~_mm256_movemask_ps(_mm256_cmp_ps(d, vdelta, _CMP_LT_OQ)) & 0xff;
+    if (bad) {
+      if (stats->mismatches == 0) stats->first_bad = i + __builtin_ctz(bad);
+      stats->mismatches += __builtin_popcount(bad);
+    }
+
+    /* max_ps returns its second operand when either is NaN */
+    __m256 ar  = _mm256_and_ps(r, abs_mask);
+    __m256 rel = _mm256_div_ps(d, ar);
+    rel  = _mm256_and_ps(rel, _mm256_cmp_ps(ar, zero, _CMP_NEQ_OQ));
+
+    vabs = _mm256_max_ps(d  , vabs);
+    vrel = _mm256_max_ps(rel, vrel);
+  }
+
+  float mabs = hmax256(vabs);
+  float mrel = hmax256(vrel);
+  if (mabs > stats->max_abs) stats->max_abs = mabs;
+  if (mrel > stats->max_rel) stats->max_rel = mrel;
+
+  /* Tail */
+  check_stats_t tail = { 0, 0, 0, stats->max_abs, stats->max_rel };
+  check_floats_scalar(&ref[i], &out[i], n - i, delta, &tail);
+
+  if (tail.mismatches > 0 && stats->mismatches == 0) stats->first_bad = i + tail.first_bad;
+  stats->mismatches += tail.mismatches;
+  stats->max_abs     = tail.max_abs;
+  stats->max_rel     = tail.max_rel;
+}
+#endif
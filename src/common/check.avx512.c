@@ -0,0 +1,57 @@
+/* check.avx512.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX-512 variant of the floating-point verifier; see check.h. The tail
+ * is a single masked iteration.
+ */
+
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/check.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+void check_floats_avx512(const float* ref, const float* out, size_t n,
+                         float delta, check_stats_t* stats)
+{
+  const __m512 vdelta = _mm512_set1_ps(delta);
+  const __m512 zero   = _mm512_setzero_ps();
+
+  __m512 vabs = zero;
+  __m512 vrel = zero;
+
+  for (size_t i = 0; i < n; i += 16) {
+    __mmask16 vm = (n - i >= 16) ? (__mmask16)0xffff
+                                 : (__mmask16)((1u << (n - i)) - 1);
+
+    __m512 r = _mm512_maskz_loadu_ps(vm, &ref[i]);
+    __m512 o = _mm512_maskz_loadu_ps(vm, &out[i]);
+    __m512 d = _mm512_abs_ps(_mm512_sub_ps(r, o));
+
+    /* Ordered compare: NaNs fail */
+    unsigned bad = vm & ~_mm512_cmp_ps_mask(d, vdelta, _CMP_LT_OQ) & 0xffff;
+    if (bad) {
+      if (stats->mismatches == 0) stats->first_bad = i + __builtin_ctz(bad);
+      stats->mismatches += __builtin_popcount(bad);
+    }
+
+    /* NaN lanes and lanes with ref == 0 are left out of the maxima */
+    __m512    ar  = _mm512_abs_ps(r);
+    __mmask16 ok  = _mm512_cmp_ps_mask(d, d, _CMP_ORD_Q);
+    __mmask16 nz  = _mm512_cmp_ps_mask(ar, zero, _CMP_NEQ_OQ) & ok;
+
+    vabs = _mm512_mask_max_ps(vabs, ok, vabs, d);
+    vrel = _mm512_mask_max_ps(vrel, nz, vrel, _mm512_div_ps(d, ar));
+  }
+
+  float mabs = _mm512_reduce_max_ps(vabs);
+  float mrel = _mm512_reduce_max_ps(vrel);
+  if (mabs > stats->max_abs) stats->max_abs = mabs;
+  if (mrel > stats->max_rel) stats->max_rel = mrel;
+}
+#endif
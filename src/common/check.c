@@ -0,0 +1,54 @@
+/* check.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the floating-point verifier; see check.h.
+ */
+
+/* Standard C includes */
+#include <math.h>
+
+/* Include common headers */
+#include "common/cpu.h"
+#include "common/check.h"
+
+void check_floats_scalar(const float* ref, const float* out, size_t n,
+                         float delta, check_stats_t* stats)
+{
+  for (size_t i = 0; i < n; i++) {
+    float d = fabsf(ref[i] - out[i]);
+
+    if (!(d < delta)) {
+      if (stats->mismatches++ == 0) stats->first_bad = i;
+    }
+
+    if (d > stats->max_abs) stats->max_abs = d;
+    if (ref[i] != 0.0f && d / fabsf(ref[i]) > stats->max_rel) {
+      stats->max_rel = d / fabsf(ref[i]);
+    }
+  }
+}
+
+bool check_floats(const float* ref, const float* out, size_t n,
+                  float delta, check_stats_t* stats)
+{
+  stats->count      = n;
+  stats->mismatches = 0;
+  stats->first_bad  = n;
+  stats->max_abs    = 0.0;
+  stats->max_rel    = 0.0;
+
+#if defined(__amd64__) || defined(__x86_64__)
+  if (cpu_has_isa(CPU_ISA_AVX512)) {
+    check_floats_avx512(ref, out, n, delta, stats);
+  } else if (cpu_has_isa(CPU_ISA_AVX2)) {
+    check_floats_avx2(ref, out, n, delta, stats);
+  } else
+#endif
+  {
+    check_floats_scalar(ref, out, n, delta, stats);
+  }
+
+  return stats->mismatches == 0;
+}
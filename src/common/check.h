@@ -0,0 +1,41 @@
+/* check.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the output verifier for floating-point results.
+ * Unlike __CHECK_FLOAT_MATCH it does not stop at the first mismatch: it
+ * runs over the whole output with the widest vector unit the host has
+ * (regardless of --isa, which only caps the kernels under test) and
+ * reports how far off the output is, which the driver prints beneath the
+ * verification result.
+*/
+
+#ifndef __COMMON_CHECK_H_
+#define __COMMON_CHECK_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef struct {
+  size_t count;        /* Elements compared; 0 = no statistics       */
+  size_t mismatches;   /* Elements with !(|ref - out| < delta)        */
+  size_t first_bad;    /* Index of the first mismatch (count if none) */
+  double max_abs;      /* Largest |ref - out| (NaNs excluded)         */
+  double max_rel;      /* Largest |ref - out| / |ref|, ref != 0       */
+} check_stats_t;
+
+/* Compare n floats; true if every element matches. A NaN in either
+ * array is a mismatch. */
+bool check_floats(const float* ref, const float* out, size_t n,
+                  float delta, check_stats_t* stats);
+
+/* Per-ISA variants over [0, n), merged into stats by check_floats */
+void check_floats_scalar(const float* ref, const float* out, size_t n,
+                         float delta, check_stats_t* stats);
+void check_floats_avx2  (const float* ref, const float* out, size_t n,
+                         float delta, check_stats_t* stats);
+void check_floats_avx512(const float* ref, const float* out, size_t n,
+                         float delta, check_stats_t* stats);
+
+#endif //__COMMON_CHECK_H_
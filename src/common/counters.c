@@ -0,0 +1,228 @@
+/* counters.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the performance counter layer; see counters.h.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <inttypes.h>
+
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/* Include common headers */
+#include "common/counters.h"
+#include "common/output.h"
+
+static const char* counter_names[CNT_NUM] = {
+  "cycles",
+  "instructions",
+  "l1d_misses",
+  "llc_misses",
+  "branch_misses",
+  "fp_arith_insts",
+  "page_faults",
+  "ctx_switches",
+};
+
+#if defined(__linux__)
+static bool cpu_is_intel(void)
+{
+  FILE* fp = fopen("/proc/cpuinfo", "r");
+  if (fp == NULL) return false;
+
+  char line[256];
+  bool intel = false;
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    if (strncmp(line, "vendor_id", 9) == 0) {
+      intel = (strstr(line, "GenuineIntel") != NULL);
+      break;
+    }
+  }
+
+  fclose(fp);
+  return intel;
+}
+
+static int counter_open(uint32_t type, uint64_t config)
+{
+  struct perf_event_attr attr;
+
+  memset(&attr, 0, sizeof(attr));
+  attr.size           = sizeof(attr);
+  attr.type           = type;
+  attr.config         = config;
+  attr.inherit        = 1;     /* Count threads spawned afterwards */
+  attr.exclude_kernel = 1;     /* Works with perf_event_paranoid=2 */
+  attr.exclude_hv     = 1;
+
+  /* Software events do count in the kernel; fault handling is the point */
+  if (type == PERF_TYPE_SOFTWARE) attr.exclude_kernel = 0;
+
+  long fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+
+  /* Retry excluding the kernel if we are not allowed to see it */
+  if (fd < 0 && type == PERF_TYPE_SOFTWARE) {
+    attr.exclude_kernel = 1;
+    fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+  }
+
+  return (int)fd;
+}
+
+static uint64_t counter_read(int fd)
+{
+  uint64_t value = 0;
+
+  if (read(fd, &value, sizeof(value)) != sizeof(value)) return 0;
+
+  return value;
+}
+#endif
+
+int counters_init(counters_t* cnt, int num_runs)
+{
+  cnt->num_runs = num_runs;
+  cnt->navail   = 0;
+  cnt->values   = (uint64_t*)calloc((size_t)num_runs * CNT_NUM,
+                                    sizeof(uint64_t));
+
+  for (int i = 0; i < CNT_NUM; i++) {
+    cnt->fd[i]    = -1;
+    cnt->start[i] =  0;
+  }
+
+#if defined(__linux__)
+  cnt->fd[CNT_CYCLES]        = counter_open(PERF_TYPE_HARDWARE,
+                                            PERF_COUNT_HW_CPU_CYCLES);
+  cnt->fd[CNT_INSTRUCTIONS]  = counter_open(PERF_TYPE_HARDWARE,
+                                            PERF_COUNT_HW_INSTRUCTIONS);
+  cnt->fd[CNT_L1D_MISSES]    = counter_open(PERF_TYPE_HW_CACHE,
+                                            (PERF_COUNT_HW_CACHE_L1D          ) |
+                                            (PERF_COUNT_HW_CACHE_OP_READ  <<  8) |
+                                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+  cnt->fd[CNT_LLC_MISSES]    = counter_open(PERF_TYPE_HARDWARE,
+                                            PERF_COUNT_HW_CACHE_MISSES);
+  cnt->fd[CNT_BRANCH_MISSES] = counter_open(PERF_TYPE_HARDWARE,
+                                            PERF_COUNT_HW_BRANCH_MISSES);
+
+  /* FP_ARITH_INST_RETIRED: event 0xC7, all scalar/packed umasks */
+  if (cpu_is_intel()) {
+    cnt->fd[CNT_FP_ARITH]    = counter_open(PERF_TYPE_RAW, 0xFFC7);
+  }
+
+  cnt->fd[CNT_PAGE_FAULTS]   = counter_open(PERF_TYPE_SOFTWARE,
+                                            PERF_COUNT_SW_PAGE_FAULTS);
+  cnt->fd[CNT_CTX_SWITCHES]  = counter_open(PERF_TYPE_SOFTWARE,
+                                            PERF_COUNT_SW_CONTEXT_SWITCHES);
+#endif
+
+  for (int i = 0; i < CNT_NUM; i++) {
+    if (cnt->fd[i] >= 0) cnt->navail++;
+    else                 cnt->fd[i] = -1;
+  }
+
+  return cnt->navail;
+}
+
+void counters_start(counters_t* cnt)
+{
+#if defined(__linux__)
+  for (int i = 0; i < CNT_NUM; i++) {
+    if (cnt->fd[i] >= 0) cnt->start[i] = counter_read(cnt->fd[i]);
+  }
+#endif
+}
+
+void counters_stop(counters_t* cnt, int run, int divisor)
+{
+#if defined(__linux__)
+  uint64_t end[CNT_NUM];
+
+  /* Read everything first, then do the bookkeeping */
+  for (int i = 0; i < CNT_NUM; i++) {
+    end[i] = (cnt->fd[i] >= 0) ? counter_read(cnt->fd[i]) : 0;
+  }
+
+  if (run < 0 || run >= cnt->num_runs || cnt->values == NULL) return;
+  if (divisor < 1) divisor = 1;
+
+  for (int i = 0; i < CNT_NUM; i++) {
+    if (cnt->fd[i] >= 0) {
+      cnt->values[(size_t)run * CNT_NUM + i] = (end[i] - cnt->start[i]) / divisor;
+    }
+  }
+#endif
+}
+
+bool counters_avail(const counters_t* cnt, int id)
+{
+  return (id >= 0) && (id < CNT_NUM) && (cnt->fd[id] >= 0);
+}
+
+const char* counters_name(int id)
+{
+  return (id >= 0 && id < CNT_NUM) ? counter_names[id] : "unknown";
+}
+
+double counters_mean(const counters_t* cnt, int id)
+{
+  if (!counters_avail(cnt, id) || cnt->num_runs == 0) return 0.0;
+
+  double sum = 0.0;
+  for (int r = 0; r < cnt->num_runs; r++) {
+    sum += (double)cnt->values[(size_t)r * CNT_NUM + id];
+  }
+
+  return sum / cnt->num_runs;
+}
+
+void counters_print(const counters_t* cnt, const char* indent)
+{
+  for (int i = 0; i < CNT_NUM; i++) {
+    if (counters_avail(cnt, i)) {
+      printf("%s- %-15s = %.1f\n", indent, counters_name(i), counters_mean(cnt, i));
+    } else {
+      printf("%s- %-15s = unavailable\n", indent, counters_name(i));
+    }
+  }
+
+  if (counters_avail(cnt, CNT_CYCLES) && counters_avail(cnt, CNT_INSTRUCTIONS)) {
+    double cycles = counters_mean(cnt, CNT_CYCLES);
+    printf("%s- %-15s = %.3f\n", indent, "ipc",
+           cycles > 0.0 ? counters_mean(cnt, CNT_INSTRUCTIONS) / cycles : 0.0);
+  }
+}
+
+void counters_dump(const counters_t* cnt, FILE* fp)
+{
+  for (int i = 0; i < CNT_NUM; i++) {
+    if (!counters_avail(cnt, i)) continue;
+
+    fprintf(fp, "\n");
+    fprintf(fp, "%s", counters_name(i));
+    out_put_u64s(fp, ", ", &cnt->values[i], cnt->num_runs, CNT_NUM);
+  }
+}
+
+void counters_destroy(counters_t* cnt)
+{
+  for (int i = 0; i < CNT_NUM; i++) {
+    if (cnt->fd[i] >= 0) close(cnt->fd[i]);
+    cnt->fd[i] = -1;
+  }
+
+  free(cnt->values);
+  cnt->values = NULL;
+}
@@ -0,0 +1,64 @@
+/* counters.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains an optional hardware performance counter layer built
+ * on top of Linux's perf_event_open(). Counters are opened for the whole
+ * process (inherited by threads created afterwards, e.g. the worker pool)
+ * and left running; each timed run reads them before and after, so the
+ * per-run value is a simple difference and no ioctl is issued inside the
+ * timed region.
+ *
+ * Events that cannot be opened (no PMU in a VM, perf_event_paranoid,
+ * non-Intel FP events, non-Linux hosts) are reported as unavailable and
+ * skipped; the benchmark keeps running.
+*/
+
+#ifndef __COMMON_COUNTERS_H_
+#define __COMMON_COUNTERS_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+  CNT_CYCLES = 0,
+  CNT_INSTRUCTIONS,
+  CNT_L1D_MISSES,
+  CNT_LLC_MISSES,
+  CNT_BRANCH_MISSES,
+  CNT_FP_ARITH,        /* Intel FP_ARITH_INST_RETIRED (all umasks)  */
+  CNT_PAGE_FAULTS,     /* Software event                            */
+  CNT_CTX_SWITCHES,    /* Software event                            */
+  CNT_NUM
+} counter_id_t;
+
+typedef struct {
+  int       fd[CNT_NUM];          /* -1 when unavailable          */
+  uint64_t  start[CNT_NUM];       /* Snapshot at counters_start() */
+  uint64_t* values;               /* [num_runs][CNT_NUM]          */
+  int       num_runs;
+  int       navail;
+} counters_t;
+
+/* Open all events and allocate room for num_runs samples; returns the
+ * number of events that are available */
+int         counters_init   (counters_t* cnt, int num_runs);
+
+/* Snapshot around a timed run; divisor is the number of invocations in
+ * the run, so stored values are per invocation like runtimes[] */
+void        counters_start  (counters_t* cnt);
+void        counters_stop   (counters_t* cnt, int run, int divisor);
+
+bool        counters_avail  (const counters_t* cnt, int id);
+const char* counters_name   (int id);
+double      counters_mean   (const counters_t* cnt, int id);
+
+/* Print a one-line-per-counter summary and append CSV rows */
+void        counters_print  (const counters_t* cnt, const char* indent);
+void        counters_dump   (const counters_t* cnt, FILE* fp);
+
+void        counters_destroy(counters_t* cnt);
+
+#endif //__COMMON_COUNTERS_H_
@@ -0,0 +1,221 @@
+/* cpu.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of CPU feature detection and dispatch; see cpu.h.
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#if defined(__amd64__) || defined(__x86_64__)
+#include <cpuid.h>
+#endif
+#if defined(__linux__) && (defined(__aarch64__) || defined(__arm64__))
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+/* Include common headers */
+#include "common/cpu.h"
+
+static const char* isa_names[CPU_ISA_NUM] = {
+  "scalar",
+  "sse42",
+  "avx2",
+  "avx512",
+  "neon",
+  "sve",
+};
+
+/* Vector width class of each ISA; the cap compares these */
+static const int isa_rank[CPU_ISA_NUM] = {
+  0,   /* scalar */
+  1,   /* sse42  */
+  2,   /* avx2   */
+  3,   /* avx512 */
+  1,   /* neon   */
+  2,   /* sve    */
+};
+
+static int isa_cap = 1 << 30;
+
+bool cpu_has_isa(cpu_isa_t isa)
+{
+  switch (isa) {
+    case CPU_ISA_SCALAR:
+      return true;
+#if defined(__amd64__) || defined(__x86_64__)
+    case CPU_ISA_SSE42:
+      return __builtin_cpu_supports("sse4.2");
+    case CPU_ISA_AVX2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case CPU_ISA_AVX512:
+      return __builtin_cpu_supports("avx512f")  &&
+             __builtin_cpu_supports("avx512dq") &&
+             __builtin_cpu_supports("avx512bw") &&
+             __builtin_cpu_supports("avx512vl");
+#elif defined(__aarch64__) || defined(__arm64__)
+    case CPU_ISA_NEON:
+#if defined(__linux__)
+      return (getauxval(AT_HWCAP) & HWCAP_ASIMD) != 0;
+#else
+      return true;
+#endif
+    case CPU_ISA_SVE:
+#if defined(__linux__) && defined(HWCAP_SVE)
+      return (getauxval(AT_HWCAP) & HWCAP_SVE) != 0;
+#else
+      return false;
+#endif
+#endif
+    default:
+      return false;
+  }
+}
+
+cpu_isa_t cpu_best_isa(void)
+{
+  cpu_isa_t best = CPU_ISA_SCALAR;
+
+  for (int i = 0; i < CPU_ISA_NUM; i++) {
+    if (cpu_has_isa((cpu_isa_t)i) && isa_rank[i] > isa_rank[best]) {
+      best = (cpu_isa_t)i;
+    }
+  }
+
+  return best;
+}
+
+void cpu_limit_isa(cpu_isa_t isa)
+{
+  isa_cap = (isa >= 0 && isa < CPU_ISA_NUM) ? isa_rank[isa] : 1 << 30;
+}
+
+bool cpu_isa_enabled(cpu_isa_t isa)
+{
+  return (isa >= 0) && (isa < CPU_ISA_NUM) &&
+         (isa_rank[isa] <= isa_cap) && cpu_has_isa(isa);
+}
+
+cpu_isa_t cpu_active_isa(void)
+{
+  cpu_isa_t best = CPU_ISA_SCALAR;
+
+  for (int i = 0; i < CPU_ISA_NUM; i++) {
+    if (cpu_isa_enabled((cpu_isa_t)i) && isa_rank[i] > isa_rank[best]) {
+      best = (cpu_isa_t)i;
+    }
+  }
+
+  return best;
+}
+
+cpu_impl_fn_t cpu_select(const cpu_variant_t* variants, int n,
+                         cpu_isa_t* chosen)
+{
+  for (int i = 0; i < n; i++) {
+    if (cpu_isa_enabled(variants[i].isa)) {
+      if (chosen != NULL) *chosen = variants[i].isa;
+      return variants[i].fn;
+    }
+  }
+
+  /* Lists end with a scalar entry, so this is a table bug */
+  fprintf(stderr, "ERROR: no usable kernel variant.\n");
+  exit(-1);
+}
+
+const char* cpu_isa_name(cpu_isa_t isa)
+{
+  return (isa >= 0 && isa < CPU_ISA_NUM) ? isa_names[isa] : "unknown";
+}
+
+cpu_isa_t cpu_isa_parse(const char* name)
+{
+  for (int i = 0; i < CPU_ISA_NUM; i++) {
+    if (strcasecmp(name, isa_names[i]) == 0) return (cpu_isa_t)i;
+  }
+
+  return CPU_ISA_NUM;
+}
+
+size_t cpu_cache_bytes(int level)
+{
+  static const size_t fallback[3] = { 32 << 10, 1 << 20, 8 << 20 };
+  static size_t       sizes[3];
+
+  if (level < 1 || level > 3) return 0;
+
+  if (sizes[level - 1] == 0) {
+    long bytes = -1;
+
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+    static const int names[3] = {
+      _SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE
+    };
+    bytes = sysconf(names[level - 1]);
+#endif
+
+    sizes[level - 1] = (bytes > 0) ? (size_t)bytes : fallback[level - 1];
+  }
+
+  return sizes[level - 1];
+}
+
+const char* cpu_model(void)
+{
+  static char model[64];
+
+  if (model[0] != '\0') return model;
+
+#if defined(__amd64__) || defined(__x86_64__)
+  /* The brand string, 48 bytes over three leaves */
+  unsigned int regs[12];
+  unsigned int max = __get_cpuid_max(0x80000000u, NULL);
+
+  if (max >= 0x80000004u) {
+    for (unsigned int i = 0; i < 3; i++) {
+      __get_cpuid(0x80000002u + i, &regs[4 * i + 0], &regs[4 * i + 1],
+                                   &regs[4 * i + 2], &regs[4 * i + 3]);
+    }
+    memcpy(model, regs, 48);
+    model[48] = '\0';
+  }
+#else
+  /* Linux names the part in /proc/cpuinfo */
+  FILE* fp = fopen("/proc/cpuinfo", "r");
+
+  if (fp != NULL) {
+    char line[256];
+
+    while (fgets(line, sizeof(line), fp) != NULL) {
+      char* colon = strchr(line, ':');
+
+      if (colon != NULL && (strncmp(line, "model name", 10) == 0 ||
+                            strncmp(line, "Hardware"  ,  8) == 0)) {
+        snprintf(model, sizeof(model), "%s", colon + 1);
+        break;
+      }
+    }
+    fclose(fp);
+  }
+#endif
+
+  /* Trim the padding and the newline */
+  char* p = model;
+  while (*p == ' ') p++;
+  memmove(model, p, strlen(p) + 1);
+  for (size_t n = strlen(model); n > 0 && (model[n - 1] == ' ' ||
+                                           model[n - 1] == '\n'); n--) {
+    model[n - 1] = '\0';
+  }
+
+  if (model[0] == '\0') snprintf(model, sizeof(model), "unknown");
+
+  return model;
+}
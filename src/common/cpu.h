@@ -0,0 +1,106 @@
+/* cpu.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains runtime CPU feature detection and kernel dispatch.
+ * Binaries are built for the baseline ISA of the target; kernels that
+ * need more are compiled in separate translation units named
+ * <kernel>.<isa>.c, which the build compiles with that ISA's flags (see
+ * ISA_FLAGS_* in the top-level Makefile). At startup an implementation
+ * picks the widest variant the host supports through cpu_select():
+ *
+ *   static const cpu_variant_t variants[] = {
+ *     { CPU_ISA_AVX512, impl_vector_avx512 },
+ *     { CPU_ISA_AVX2  , impl_vector_avx2   },
+ *     { CPU_ISA_SCALAR, impl_vector_scalar },
+ *   };
+ *
+ *   static cpu_dispatch_t dispatch = CPU_DISPATCH_INIT(variants);
+ *
+ *   void* impl_vector(void* args) { return cpu_dispatch(&dispatch)(args); }
+ *
+ * The list is ordered widest first and must end with a CPU_ISA_SCALAR
+ * entry; the choice is made on the first call and cached. cpu_limit_isa()
+ * caps it (the driver's --isa option, applied before any kernel runs), so
+ * the narrower variants can be measured on a wide host.
+ *
+ * Detection uses CPUID through __builtin_cpu_supports() on x86 (which
+ * also checks that the OS saves the wide registers) and AT_HWCAP on
+ * Linux/aarch64; NEON is architectural on aarch64 otherwise, and SVE is
+ * only used on Linux. SVE variants are written vector-length agnostic,
+ * so one binary covers 128-bit (Graviton4) and 256-bit (Graviton3)
+ * parts.
+*/
+
+#ifndef __COMMON_CPU_H_
+#define __COMMON_CPU_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+typedef enum {
+  CPU_ISA_SCALAR = 0,   /* Baseline; always available              */
+  CPU_ISA_SSE42,        /* SSE4.2                                  */
+  CPU_ISA_AVX2,         /* AVX2 + FMA                              */
+  CPU_ISA_AVX512,       /* AVX-512 F/DQ/BW/VL                      */
+  CPU_ISA_NEON,         /* AArch64 Advanced SIMD                   */
+  CPU_ISA_SVE,          /* AArch64 SVE, any vector length          */
+  CPU_ISA_NUM
+} cpu_isa_t;
+
+typedef void* (*cpu_impl_fn_t)(void* args);
+
+typedef struct {
+  cpu_isa_t     isa;
+  cpu_impl_fn_t fn;
+} cpu_variant_t;
+
+/* Host support, ignoring any limit */
+bool          cpu_has_isa    (cpu_isa_t isa);
+cpu_isa_t     cpu_best_isa   (void);
+
+/* Cap dispatch at isa (by vector width); CPU_ISA_NUM removes the cap */
+void          cpu_limit_isa  (cpu_isa_t isa);
+
+/* Supported by the host and within the cap */
+bool          cpu_isa_enabled(cpu_isa_t isa);
+cpu_isa_t     cpu_active_isa (void);
+
+/* The first enabled variant of a widest-first list */
+cpu_impl_fn_t cpu_select     (const cpu_variant_t* variants, int n,
+                              cpu_isa_t* chosen);
+
+/* Lazily resolved entry point of one kernel */
+typedef struct {
+  const cpu_variant_t*    variants;
+  int                     n;
+  _Atomic(cpu_impl_fn_t)  fn;
+} cpu_dispatch_t;
+
+#define CPU_DISPATCH_INIT(v) { (v), sizeof(v) / sizeof((v)[0]), NULL }
+
+static inline cpu_impl_fn_t cpu_dispatch(cpu_dispatch_t* d)
+{
+  cpu_impl_fn_t fn = atomic_load_explicit(&d->fn, memory_order_relaxed);
+
+  if (__builtin_expect(fn == NULL, 0)) {
+    fn = cpu_select(d->variants, d->n, NULL);
+    atomic_store_explicit(&d->fn, fn, memory_order_relaxed);
+  }
+
+  return fn;
+}
+
+const char*   cpu_isa_name   (cpu_isa_t isa);
+cpu_isa_t     cpu_isa_parse  (const char* name);   /* CPU_ISA_NUM if unknown */
+
+/* Data cache capacity in bytes of level 1, 2 or 3 (as reported by the OS,
+ * so the L3 is the whole shared cache); a typical size if unknown */
+size_t        cpu_cache_bytes(int level);
+
+/* Marketing name of the processor ("Intel(R) Xeon(R) ..."), or "unknown" */
+const char*   cpu_model      (void);
+
+#endif //__COMMON_CPU_H_
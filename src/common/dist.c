@@ -0,0 +1,308 @@
+/* dist.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the distributed-mode transport; see dist.h.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+/* Include common headers */
+#include "common/dist.h"
+
+/* Handshake */
+#define DIST_OP_HELLO   0xFFFFFFF0u  /* Worker: arg[0] name bytes follow */
+#define DIST_OP_WELCOME 0xFFFFFFF1u  /* Root  : arg[0] rank, arg[1] ranks */
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+uint64_t dist_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* Requests and results are written whole; small headers must not wait
+ * for an ACK */
+static void dist_tune(int fd)
+{
+  int one = 1;
+
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+bool dist_send(dist_t* d, int fd, const void* buf, size_t bytes)
+{
+  const char* p = (const char*)buf;
+
+  while (bytes > 0) {
+    ssize_t n = send(fd, p, bytes, MSG_NOSIGNAL);
+
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+
+    p     += n;
+    bytes -= n;
+    d->phases.bytes_out += n;
+  }
+
+  return true;
+}
+
+bool dist_recv(dist_t* d, int fd, void* buf, size_t bytes)
+{
+  char* p = (char*)buf;
+
+  while (bytes > 0) {
+    ssize_t n = recv(fd, p, bytes, 0);
+
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) return false;
+
+    p     += n;
+    bytes -= n;
+    d->phases.bytes_in += n;
+  }
+
+  return true;
+}
+
+bool dist_send_msg(dist_t* d, int fd, uint32_t op, const uint64_t* arg, int narg)
+{
+  dist_msg_t msg;
+
+  memset(&msg, 0, sizeof(msg));
+  msg.magic = DIST_MAGIC;
+  msg.op    = op;
+  for (int i = 0; i < narg && i < 6; i++) msg.arg[i] = arg[i];
+
+  return dist_send(d, fd, &msg, sizeof(msg));
+}
+
+bool dist_recv_msg(dist_t* d, int fd, dist_msg_t* msg)
+{
+  if (!dist_recv(d, fd, msg, sizeof(*msg))) return false;
+
+  return msg->magic == DIST_MAGIC;
+}
+
+static void dist_init(dist_t* d)
+{
+  memset(d, 0, sizeof(*d));
+  d->nranks = 1;
+  for (int r = 0; r < DIST_MAX_RANKS; r++) d->fds[r] = -1;
+}
+
+int dist_listen(dist_t* d, const char* bench, int port, int nranks)
+{
+  dist_init(d);
+
+  if (nranks < 1 || nranks > DIST_MAX_RANKS) {
+    printf("ERROR: --ranks must be in [1, %d]\n", DIST_MAX_RANKS);
+    return -1;
+  }
+
+  if (nranks == 1) return 0;
+
+  int lfd = socket(AF_INET, SOCK_STREAM, 0);
+  if (lfd < 0) {
+    printf("ERROR: socket: %s\n", strerror(errno));
+    return -1;
+  }
+
+  int one = 1;
+  setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family      = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port        = htons((uint16_t)port);
+
+  if (bind(lfd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+      listen(lfd, nranks) != 0) {
+    printf("ERROR: Cannot listen on port %d: %s\n", port, strerror(errno));
+    close(lfd);
+    return -1;
+  }
+
+  size_t len = strlen(bench);
+
+  /* Ranks in the order the workers arrive */
+  for (int r = 1; r < nranks; r++) {
+    int fd = accept(lfd, NULL, NULL);
+    if (fd < 0) {
+      if (errno == EINTR) { r--; continue; }
+      printf("ERROR: accept: %s\n", strerror(errno));
+      close(lfd);
+      dist_close(d);
+      return -1;
+    }
+    dist_tune(fd);
+
+    dist_msg_t hello;
+    char       name[64] = { 0 };
+
+    if (!dist_recv_msg(d, fd, &hello) || hello.op != DIST_OP_HELLO ||
+        hello.arg[0] >= sizeof(name) ||
+        !dist_recv(d, fd, name, hello.arg[0]) ||
+        hello.arg[0] != len || memcmp(name, bench, len) != 0) {
+      printf("ERROR: A peer that is not a \"%s\" worker connected\n", bench);
+      close(fd);
+      r--;
+      continue;
+    }
+
+    uint64_t welcome[2] = { (uint64_t)r, (uint64_t)nranks };
+    if (!dist_send_msg(d, fd, DIST_OP_WELCOME, welcome, 2)) {
+      close(fd);
+      r--;
+      continue;
+    }
+
+    d->fds[r] = fd;
+    d->nranks = r + 1;
+  }
+
+  close(lfd);
+  memset(&d->phases, 0, sizeof(d->phases));
+
+  return 0;
+}
+
+int dist_connect(dist_t* d, const char* bench, const char* addr)
+{
+  dist_init(d);
+
+  char        host[256];
+  const char* colon = strrchr(addr, ':');
+  size_t      hlen  = (colon != NULL) ? (size_t)(colon - addr) : 0;
+
+  if (colon == NULL || hlen == 0 || hlen >= sizeof(host) || colon[1] == '\0') {
+    printf("ERROR: --connect wants host:port, not \"%s\"\n", addr);
+    return -1;
+  }
+  memcpy(host, addr, hlen);
+  host[hlen] = '\0';
+
+  struct addrinfo  hints;
+  struct addrinfo* res;
+
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family   = AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+
+  int err = getaddrinfo(host, colon + 1, &hints, &res);
+  if (err != 0) {
+    printf("ERROR: Cannot resolve \"%s\": %s\n", addr, gai_strerror(err));
+    return -1;
+  }
+
+  /* Rank 0 may not be listening yet */
+  int fd = -1;
+  for (int t = 0; t < DIST_CONNECT_TIMEOUT * 10 && fd < 0; t++) {
+    fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) != 0) {
+      close(fd);
+      fd = -1;
+      usleep(100 * 1000);
+    }
+  }
+  freeaddrinfo(res);
+
+  if (fd < 0) {
+    printf("ERROR: Cannot reach rank 0 at %s\n", addr);
+    return -1;
+  }
+  dist_tune(fd);
+
+  uint64_t   len = strlen(bench);
+  dist_msg_t welcome;
+
+  if (!dist_send_msg(d, fd, DIST_OP_HELLO, &len, 1) ||
+      !dist_send(d, fd, bench, len) ||
+      !dist_recv_msg(d, fd, &welcome) || welcome.op != DIST_OP_WELCOME) {
+    printf("ERROR: Rank 0 at %s turned us down\n", addr);
+    close(fd);
+    return -1;
+  }
+
+  d->rank   = (int)welcome.arg[0];
+  d->nranks = (int)welcome.arg[1];
+  d->fds[0] = fd;
+  memset(&d->phases, 0, sizeof(d->phases));
+
+  return 0;
+}
+
+void dist_close(dist_t* d)
+{
+  for (int r = 0; r < DIST_MAX_RANKS; r++) {
+    if (d->fds[r] >= 0) close(d->fds[r]);
+    d->fds[r] = -1;
+  }
+}
+
+void dist_print(const dist_t* d, const char* indent)
+{
+  const dist_phases_t* p = &d->phases;
+  if (p->invocations == 0) return;
+
+  double n       = (double)p->invocations;
+  double workers = (d->nranks > 1) ? d->nranks - 1 : 1;
+  double total   = (p->send + p->compute + p->gather) / n;
+  double rc      = p->remote_compute / workers / n;
+  double rw      = p->remote_wait    / workers / n;
+
+  printf("%s* Distributed over %d rank(s), per invocation:\n", indent, d->nranks);
+  printf("%s  - rank 0 send     = %.1f ns (%.1f%%)\n", indent, p->send    / n,
+         (total > 0.0) ? 100.0 * p->send    / n / total : 0.0);
+  printf("%s  - rank 0 compute  = %.1f ns (%.1f%%)\n", indent, p->compute / n,
+         (total > 0.0) ? 100.0 * p->compute / n / total : 0.0);
+  printf("%s  - rank 0 gather   = %.1f ns (%.1f%%)\n", indent, p->gather  / n,
+         (total > 0.0) ? 100.0 * p->gather  / n / total : 0.0);
+  if (d->nranks > 1) {
+    printf("%s  - worker compute  = %.1f ns (mean of %d)\n", indent, rc, d->nranks - 1);
+    printf("%s  - worker recv     = %.1f ns (mean of %d)\n", indent, rw, d->nranks - 1);
+    printf("%s  - network         = %.1f%% of the wall time (1 - worker compute)\n",
+           indent, (total > 0.0 && rc < total) ? 100.0 * (1.0 - rc / total) : 0.0);
+  }
+  printf("%s  - bytes           = %.0f out, %.0f in\n", indent,
+         p->bytes_out / n, p->bytes_in / n);
+}
+
+void dist_dump(const dist_t* d, FILE* fp)
+{
+  const dist_phases_t* p = &d->phases;
+  if (p->invocations == 0) return;
+
+  double n       = (double)p->invocations;
+  double workers = (d->nranks > 1) ? d->nranks - 1 : 1;
+
+  fprintf(fp, "\ndist_ranks,%d", d->nranks);
+  fprintf(fp, "\ndist_send,%.3f", p->send / n);
+  fprintf(fp, "\ndist_compute,%.3f", p->compute / n);
+  fprintf(fp, "\ndist_gather,%.3f", p->gather / n);
+  fprintf(fp, "\ndist_remote_compute,%.3f", p->remote_compute / workers / n);
+  fprintf(fp, "\ndist_remote_wait,%.3f", p->remote_wait / workers / n);
+  fprintf(fp, "\ndist_bytes_out,%.0f", p->bytes_out / n);
+  fprintf(fp, "\ndist_bytes_in,%.0f", p->bytes_in / n);
+}
@@ -0,0 +1,101 @@
+/* dist.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the transport of the distributed mode: plain TCP,
+ * in a star around rank 0, with no dependency beyond POSIX sockets.
+ * Rank 0 is the process the driver measures in; it listens (--ranks N
+ * [--port P]) for N - 1 workers, each one the same benchmark started
+ * with --connect host:port on another node (or the same one). A worker
+ * greets the root with the benchmark's name, is told its rank, and then
+ * answers the root's messages with its own worker pool until the root
+ * hangs up (driver_bench_t.serve).
+ *
+ * What travels is up to the benchmark: a dist_msg_t header, then the
+ * payload it announces. The root times its side of every invocation by
+ * phase (sending, its own share of the compute, waiting for and
+ * receiving the results) and every worker reports the time it computed
+ * and the time it waited on the network, so the report splits a run
+ * into network and compute.
+*/
+
+#ifndef __COMMON_DIST_H_
+#define __COMMON_DIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/* Most ranks, rank 0 included */
+#define DIST_MAX_RANKS 64
+
+/* Port rank 0 listens on without --port */
+#define DIST_PORT      7077
+
+/* Seconds a worker keeps retrying before rank 0 is up */
+#define DIST_CONNECT_TIMEOUT 30
+
+/* Header of every message; the meaning of op and arg is the benchmark's */
+typedef struct {
+  uint32_t magic;                    /* DIST_MAGIC                   */
+  uint32_t op;
+  uint64_t arg[6];
+} dist_msg_t;
+
+#define DIST_MAGIC 0x44495354u       /* "DIST" */
+
+/* Time per phase, in ns, summed over invocations */
+typedef struct {
+  uint64_t invocations;
+
+  /* Rank 0 */
+  double   send;                     /* Writing requests             */
+  double   compute;                  /* Its own share                */
+  double   gather;                   /* Waiting for and reading results */
+
+  /* Workers, summed over the ranks */
+  double   remote_compute;
+  double   remote_wait;              /* Blocked receiving requests   */
+
+  uint64_t bytes_out;                /* Rank 0 to the workers        */
+  uint64_t bytes_in;
+} dist_phases_t;
+
+typedef struct dist_t {
+  int           rank;                /* 0 at the root                */
+  int           nranks;              /* 1: nothing to distribute     */
+  int           fds[DIST_MAX_RANKS]; /* Root: fds[r] talks to rank r;
+                                      * worker: fds[0] to the root   */
+  dist_phases_t phases;
+  bool          used;                /* Set by every invocation that
+                                      * adds to phases; the benchmark
+                                      * clears it                    */
+} dist_t;
+
+/* Rank 0: accept nranks - 1 workers of bench on port; 0 on success */
+int   dist_listen (dist_t* d, const char* bench, int port, int nranks);
+
+/* Worker: reach rank 0 at "host:port"; 0 on success */
+int   dist_connect(dist_t* d, const char* bench, const char* addr);
+
+/* Hang up on every peer */
+void  dist_close  (dist_t* d);
+
+/* Whole buffers, or false on an error or a closed peer */
+bool  dist_send   (dist_t* d, int fd, const void* buf, size_t bytes);
+bool  dist_recv   (dist_t* d, int fd, void* buf, size_t bytes);
+
+/* A header and its payload; dist_recv_msg checks the magic */
+bool  dist_send_msg(dist_t* d, int fd, uint32_t op, const uint64_t* arg, int narg);
+bool  dist_recv_msg(dist_t* d, int fd, dist_msg_t* msg);
+
+/* CLOCK_MONOTONIC, in ns */
+uint64_t dist_now(void);
+
+/* Phases per invocation, and the same as CSV rows (dist_<phase>) */
+void  dist_print  (const dist_t* d, const char* indent);
+void  dist_dump   (const dist_t* d, FILE* fp);
+
+#endif //__COMMON_DIST_H_
@@ -0,0 +1,1928 @@
+/* driver.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the shared benchmark driver; see driver.h.
+ *
+ * The driver invokes the chosen implementation n number of times per
+ * case. It records the runtime of _each_ run through the following
+ * Linux API:
+ *    clock_gettime(), with the clk_id set to CLOCK_MONOTONIC
+ * Then, it calculates the standard deviation and an outlier-free average
+ * by iteratively excluding runtimes that are further than nstdevs
+ * standard deviations from the average.
+ */
+
+/* Set features         */
+#define _GNU_SOURCE
+
+/* Standard C includes  */
+/*  -> Standard Library */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+/*  -> Scheduling       */
+#include <sched.h>
+/*  -> Types            */
+#include <stdbool.h>
+#include <inttypes.h>
+/*  -> Runtimes         */
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+#if defined(__amd64__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+/* Include common headers */
+#include "common/types.h"
+#include "common/macros.h"
+#include "common/pool.h"
+#include "common/counters.h"
+#include "common/stats.h"
+#include "common/roofline.h"
+#include "common/cpu.h"
+#include "common/alloc.h"
+#include "common/output.h"
+#include "common/manifest.h"
+#include "common/evict.h"
+#include "common/trace.h"
+#include "common/affinity.h"
+#include "common/dist.h"
+#include "common/driver.h"
+
+/* Timed runs per candidate of the --autotune search; the median decides */
+#define DRIVER_TUNE_RUNS 5
+
+/* Command-line options shared by every benchmark */
+typedef struct {
+  const driver_impl_t* impls[DRIVER_MAX_IMPLS];
+  int                  nimpls;
+  const char*          impl_str;
+
+  int                  nthreads;
+  int                  cpu;
+  affinity_policy_t    affinity;   /* Placement of the threads */
+  int*                 cpus;       /* The CPU of each thread, as planned */
+
+  int                  scale[DRIVER_MAX_SCALE];
+  int                  nscale;
+
+  int                  nruns;
+  int                  nstdevs;
+  int                  ninner;
+  int                  nwarmup;
+
+  bool                 use_counters;
+  bool                 roofline;
+  cpu_isa_t            isa;        /* Dispatch cap; CPU_ISA_NUM = none */
+  mem_policy_t         mem;        /* Benchmark data allocation policy */
+  driver_cache_t       cache;      /* Cache state of each timed run */
+  bool                 trace;      /* Per-thread fork/join analysis */
+  int                  nranks;     /* Processes of a distributed run */
+  int                  port;       /* Rank 0 listens here */
+  const char*          connect;    /* host:port of rank 0, for workers */
+  bool                 autotune;
+  out_format_t         out_fmt;    /* Result files */
+  const char*          out_dir;
+  const char*          tune_cache;
+  bool                 help;
+  bool                 parse_err;
+} driver_opts_t;
+
+/* Results of one implementation on one case, kept for the summary */
+typedef struct {
+  uint64_t avg;
+  double   median;
+  double   p99;
+  double   gflops;
+  double   gbps;
+  double   speedup;
+  int      nthreads;
+  bool     ok;
+} driver_result_t;
+
+/* Measurement state shared by every case and scaling step */
+typedef struct {
+  uint32_t       num_runs;
+  uint64_t*      runtimes;         /* [nimpls][num_runs] */
+  bool*          runtimes_mask;
+  unsigned int   nstd;
+
+  counters_t     cnt[DRIVER_MAX_IMPLS];
+
+  uint64_t       order_state;
+  int            order[DRIVER_MAX_IMPLS];
+
+  roofline_t     peak;             /* Valid with --roofline */
+  double         tsc_ghz;          /* Reference cycles per ns, or 0 */
+
+  pool_t*        pool;             /* Owner of the scratch arenas */
+
+  out_file_t*    manifest;         /* Run manifest, or NULL */
+  int            nmanifest;        /* Results in it so far */
+
+  trace_t        trace[DRIVER_MAX_IMPLS]; /* Valid with --trace */
+} driver_state_t;
+
+static const char* driver_cache_names[DRIVER_CACHE_NUM] = {
+  "warm", "cold", "llc"
+};
+
+/* Private generator for the run order; keeps rand() for the datasets */
+static uint32_t driver_rand(uint64_t* state)
+{
+  uint64_t x = *state;
+
+  x ^= x << 13;
+  x ^= x >>  7;
+  x ^= x << 17;
+  *state = x;
+
+  return (uint32_t)(x >> 32);
+}
+
+double driver_tsc_ghz(void)
+{
+#if defined(__amd64__) || defined(__x86_64__)
+  struct timespec ts, te;
+  uint64_t        cs, ce;
+  double          ns;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  cs = __rdtsc();
+  do {
+    clock_gettime(CLOCK_MONOTONIC, &te);
+    ns = (te.tv_sec - ts.tv_sec) * 1e9 + (te.tv_nsec - ts.tv_nsec);
+  } while (ns < 10e6);
+  ce = __rdtsc();
+
+  return (ce - cs) / ns;
+#else
+  return 0.0;
+#endif
+}
+
+static const driver_impl_t* driver_find_impl(const driver_bench_t* bench,
+                                             const char* name, size_t len)
+{
+  for (int j = 0; j < bench->nimpls; j++) {
+    if (strlen(bench->impls[j].name) == len &&
+        strncmp(name, bench->impls[j].name, len) == 0) {
+      return &bench->impls[j];
+    }
+  }
+
+  return NULL;
+}
+
+static bool driver_select_impl(driver_opts_t* opts, const driver_impl_t* impl)
+{
+  for (int k = 0; k < opts->nimpls; k++) {
+    if (opts->impls[k] == impl) return true;
+  }
+
+  if (opts->nimpls >= DRIVER_MAX_IMPLS) return false;
+  opts->impls[opts->nimpls++] = impl;
+
+  return true;
+}
+
+static void driver_usage(const driver_bench_t* bench,
+                         const driver_opts_t* opts, const char* prog)
+{
+  printf("\n");
+  printf("Usage:\n");
+  printf("  %s {-i | --impl} impl_str [Options]\n", prog);
+  printf("  \n");
+  printf("  Required:\n");
+  printf("    -i | --impl      Available implementations = {");
+  for (int i = 0; i < bench->nimpls; i++) {
+    printf("%s%s", i ? ", " : "", bench->impls[i].name);
+  }
+  printf("}\n");
+  printf("                     \"all\" or a comma separated list runs several\n");
+  printf("                     implementations interleaved on the same data\n");
+  printf("    \n");
+  printf("  Options:\n");
+  printf("    -h | --help      Print this message\n");
+  printf("    -n | --nthreads  Set number of threads available (default = %d)\n", opts->nthreads);
+  printf("    -c | --cpu       Set the main CPU for the program (default = %d)\n", opts->cpu);
+  printf("         --affinity  Placement of the threads = {");
+  for (int p = 0; p < AFFINITY_NUM; p++) {
+    printf("%s%s", p ? ", " : "", affinity_name((affinity_policy_t)p));
+  }
+  printf("}\n");
+  printf("                     (default = linear, i.e. cpu .. cpu + nthreads - 1)\n");
+  printf("         --scale     Rerun at each thread count of a list \"1,2,4\" and\n");
+  printf("                     report speedup and parallel efficiency\n");
+  if (bench->usage != NULL) bench->usage(bench->ctx);
+  printf("         --nruns     Number of runs to the implementation (default = %d)\n", opts->nruns);
+  printf("         --nstdevs   Number of standard deviation to exclude outliers (default = %d)\n", opts->nstdevs);
+  printf("         --ninner    Invocations per timed run (default = %d)\n", opts->ninner);
+  printf("         --nwarmup   Untimed invocations before timing (default = %d)\n", opts->nwarmup);
+  printf("         --counters  Collect hardware performance counters for each run\n");
+  printf("         --roofline  Probe peak bandwidth/FLOP/s and report against them\n");
+  if (bench->ntunables > 0) {
+    printf("         --autotune  Search the tunables of the chosen implementations\n");
+    printf("                     on every case first and cache the winners:\n");
+    for (int i = 0; i < bench->ntunables; i++) {
+      const tune_param_t* p = &bench->tunables[i];
+
+      printf("                       %-16s (%s) = {", p->name, p->impl);
+      for (int c = 0; c < p->ncands; c++) printf("%s%d", c ? ", " : "", p->cands[c]);
+      printf("}, default = %d\n", *p->value);
+    }
+    printf("         --tune-cache Tunables cache, loaded on every run (default = %s)\n",
+           TUNE_CACHE_DEFAULT);
+  }
+  printf("         --isa       Cap runtime kernel dispatch = {");
+  for (int i = 0; i < CPU_ISA_NUM; i++) {
+    printf("%s%s", i ? ", " : "", cpu_isa_name((cpu_isa_t)i));
+  }
+  printf("}\n");
+  printf("                     (default = best supported, here %s)\n",
+         cpu_isa_name(cpu_best_isa()));
+  printf("         --output-format Result files = {");
+  for (int i = 0; i < OUT_FORMAT_NUM; i++) {
+    printf("%s%s", i ? ", " : "", out_format_name((out_format_t)i));
+  }
+  printf("}\n");
+  printf("                     (default = csv; see src/common/output.h)\n");
+  printf("         --output-dir Directory of the result files (default = .)\n");
+  printf("         --pages     Page size of benchmark data = {");
+  for (int i = 0; i < MEM_PAGES_NUM; i++) {
+    printf("%s%s", i ? ", " : "", mem_pages_name((mem_pages_t)i));
+  }
+  printf("}\n");
+  printf("                     (default = default)\n");
+  printf("         --numa      Placement of benchmark data = {local, interleave, <node>}\n");
+  printf("                     (default = local)\n");
+  printf("         --prefault  Touch benchmark data at allocation so no page\n");
+  printf("                     faults are timed\n");
+  printf("         --cache     Cache state of each timed run = {warm, cold, llc}\n");
+  printf("                     (default = warm); cold and llc time one invocation\n");
+  printf("                     per run\n");
+  printf("         --trace     Time every thread of every fork/join: load imbalance,\n");
+  printf("                     fork latency and barrier wait, plus a Chrome trace\n");
+  printf("                     (<impl>_<case>_trace.json)\n");
+  if (bench->serve != NULL) {
+    printf("         --ranks     Processes of a distributed run, this one rank 0\n");
+    printf("                     (default = 1); the others join with --connect\n");
+    printf("         --port      Port rank 0 listens on (default = %d)\n", DIST_PORT);
+    printf("         --connect   \"--connect host:port\": serve as a worker of the\n");
+    printf("                     rank 0 there until it is done, then exit\n");
+  }
+  printf("\n");
+}
+
+static void driver_parse(const driver_bench_t* bench, driver_opts_t* opts,
+                         int argc, char** argv)
+{
+  for (int i = 1; i < argc; i++) {
+    /* Implementations */
+    if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--impl") == 0) {
+      assert (++i < argc);
+      opts->nimpls   = 0;
+      opts->impl_str = argv[i];
+
+      if (strcmp(argv[i], "all") == 0) {
+        for (int j = 0; j < bench->nimpls; j++) {
+          driver_select_impl(opts, &bench->impls[j]);
+        }
+
+        continue;
+      }
+
+      const char* p = argv[i];
+      while (*p != '\0') {
+        size_t len = strcspn(p, ",");
+        const driver_impl_t* impl = driver_find_impl(bench, p, len);
+
+        if (impl == NULL) {
+          printf("\n");
+          printf("ERROR: Unknown \"%.*s\" implementation.\n", (int)len, p);
+
+          opts->parse_err = true;
+        } else if (!driver_select_impl(opts, impl)) {
+          printf("\n");
+          printf("ERROR: Too many implementations (max = %d).\n", DRIVER_MAX_IMPLS);
+
+          opts->parse_err = true;
+        }
+
+        p += len;
+        if (*p == ',') p++;
+      }
+
+      continue;
+    }
+
+    /* Run parameterization */
+    if (strcmp(argv[i], "--nruns") == 0) {
+      assert (++i < argc);
+      opts->nruns = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--nstdevs") == 0) {
+      assert (++i < argc);
+      opts->nstdevs = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--ninner") == 0) {
+      assert (++i < argc);
+      opts->ninner = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--nwarmup") == 0) {
+      assert (++i < argc);
+      opts->nwarmup = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--counters") == 0) {
+      opts->use_counters = true;
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--roofline") == 0) {
+      opts->roofline = true;
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--autotune") == 0) {
+      opts->autotune = true;
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--tune-cache") == 0) {
+      assert (++i < argc);
+      opts->tune_cache = argv[i];
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--isa") == 0) {
+      assert (++i < argc);
+      opts->isa = cpu_isa_parse(argv[i]);
+      if (opts->isa == CPU_ISA_NUM) {
+        printf("\n");
+        printf("ERROR: Unknown \"%s\" ISA.\n", argv[i]);
+        opts->parse_err = true;
+      }
+
+      continue;
+    }
+
+    /* Result files */
+    if (strcmp(argv[i], "--output-format") == 0) {
+      assert (++i < argc);
+      opts->out_fmt = out_format_parse(argv[i]);
+      if (opts->out_fmt == OUT_FORMAT_NUM) {
+        printf("\n");
+        printf("ERROR: Unknown \"%s\" output format.\n", argv[i]);
+        opts->out_fmt = OUT_CSV;
+        opts->parse_err = true;
+      }
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--output-dir") == 0) {
+      assert (++i < argc);
+      opts->out_dir = argv[i];
+
+      continue;
+    }
+
+    /* Memory */
+    if (strcmp(argv[i], "--pages") == 0) {
+      assert (++i < argc);
+      opts->mem.pages = mem_pages_parse(argv[i]);
+      if (opts->mem.pages == MEM_PAGES_NUM) {
+        printf("\n");
+        printf("ERROR: Unknown \"%s\" page size.\n", argv[i]);
+        opts->mem.pages = MEM_PAGES_DEFAULT;
+        opts->parse_err = true;
+      }
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--numa") == 0) {
+      assert (++i < argc);
+      if (!mem_numa_parse(argv[i], &opts->mem)) {
+        printf("\n");
+        printf("ERROR: Unknown \"%s\" NUMA placement.\n", argv[i]);
+        opts->parse_err = true;
+      }
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--prefault") == 0) {
+      opts->mem.prefault = true;
+
+      continue;
+    }
+
+    /* Cache state */
+    if (strcmp(argv[i], "--cache") == 0) {
+      assert (++i < argc);
+      opts->cache = DRIVER_CACHE_NUM;
+      for (int m = 0; m < DRIVER_CACHE_NUM; m++) {
+        if (strcmp(argv[i], driver_cache_names[m]) == 0) opts->cache = (driver_cache_t)m;
+      }
+      if (opts->cache == DRIVER_CACHE_NUM) {
+        printf("\n");
+        printf("ERROR: Unknown \"%s\" cache state.\n", argv[i]);
+        opts->cache = DRIVER_CACHE_WARM;
+        opts->parse_err = true;
+      }
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--trace") == 0) {
+      opts->trace = true;
+
+      continue;
+    }
+
+    /* Distributed runs */
+    if (strcmp(argv[i], "--ranks") == 0) {
+      assert (++i < argc);
+      opts->nranks = atoi(argv[i]);
+      if (opts->nranks < 1 || opts->nranks > DIST_MAX_RANKS) {
+        printf("\n");
+        printf("ERROR: --ranks must be in [1, %d].\n", DIST_MAX_RANKS);
+        opts->parse_err = true;
+      }
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--port") == 0) {
+      assert (++i < argc);
+      opts->port = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--connect") == 0) {
+      assert (++i < argc);
+      opts->connect = argv[i];
+
+      continue;
+    }
+
+    /* Parallelization */
+    if (strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "--nthreads") == 0) {
+      assert (++i < argc);
+      opts->nthreads = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--cpu") == 0) {
+      assert (++i < argc);
+      opts->cpu = atoi(argv[i]);
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--affinity") == 0) {
+      assert (++i < argc);
+      opts->affinity = affinity_parse(argv[i]);
+      if (opts->affinity == AFFINITY_NUM) {
+        printf("\n");
+        printf("ERROR: Unknown \"%s\" placement.\n", argv[i]);
+        opts->affinity = AFFINITY_LINEAR;
+        opts->parse_err = true;
+      }
+
+      continue;
+    }
+
+    if (strcmp(argv[i], "--scale") == 0) {
+      assert (++i < argc);
+      opts->nscale = 0;
+
+      const char* p = argv[i];
+      while (*p != '\0') {
+        char* next;
+        long n = strtol(p, &next, 10);
+
+        if (next == p || n < 1 || opts->nscale >= DRIVER_MAX_SCALE ||
+            (*next != ',' && *next != '\0')) {
+          printf("\n");
+          printf("ERROR: Invalid thread counts \"%s\".\n", argv[i]);
+
+          opts->parse_err = true;
+          break;
+        }
+
+        opts->scale[opts->nscale++] = (int)n;
+        p = (*next == ',') ? next + 1 : next;
+      }
+
+      continue;
+    }
+
+    /* Help */
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      opts->help = true;
+
+      continue;
+    }
+
+    /* Benchmark-specific options */
+    int consumed = 0;
+    if (bench->parse_arg != NULL) {
+      consumed = bench->parse_arg(bench->ctx, argc, argv, i);
+    }
+
+    if (consumed < 0) {
+      opts->parse_err = true;
+      break;
+    } else if (consumed == 0) {
+      printf("\n");
+      printf("ERROR: Unknown option \"%s\".\n", argv[i]);
+
+      opts->parse_err = true;
+      break;
+    }
+
+    i += consumed - 1;
+  }
+
+  if (opts->nruns   < 1) opts->nruns   = 1;
+  if (opts->ninner  < 1) opts->ninner  = 1;
+  if (opts->nwarmup < 0) opts->nwarmup = 0;
+}
+
+static void driver_sched_setup(const driver_opts_t* opts)
+{
+  /* Set our priority the highest */
+  int nice_level = -20;
+
+  printf("Setting up schedulers and affinity:\n");
+  printf("  * Setting the niceness level:\n");
+  do {
+    errno = 0;
+    printf("      -> trying niceness level = %d\n", nice_level);
+    int __attribute__((unused)) ret = nice(nice_level);
+  } while (errno != 0 && nice_level++);
+
+  printf("    + Process has niceness level = %d\n", nice_level);
+
+  /* If we are on an apple operating system, skip the scheduling  *
+   * routine; Darwin does not support sched_set* system calls ... *
+   *                                                              *
+   * hawajkm: and here I was--thinking that MacOS is POSIX ...    *
+   *          Silly me!                                           */
+#if !defined(__APPLE__)
+  /* Set scheduling to reduce context switching */
+  /*    -> Set scheduling scheme                */
+  printf("  * Setting up FIFO scheduling scheme and high priority ... ");
+  pid_t pid    = 0;
+  int   policy = SCHED_FIFO;
+  struct sched_param param;
+
+  param.sched_priority = sched_get_priority_max(policy);
+  int res = sched_setscheduler(pid, policy, &param);
+  if (res != 0) {
+    printf("Failed\n");
+  } else {
+    printf("Succeeded\n");
+  }
+
+  /*    -> Set affinity                         */
+  printf("  * Setting up scheduling affinity ... ");
+  cpu_set_t cpumask;
+
+  CPU_ZERO(&cpumask);
+  for (int i = 0; i < opts->nthreads; i++) {
+    CPU_SET(opts->cpus[i], &cpumask);
+  }
+
+  res = sched_setaffinity(pid, sizeof(cpumask), &cpumask);
+
+  if (res != 0) {
+    printf("Failed\n");
+  } else {
+    printf("Succeeded\n");
+  }
+#endif
+  printf("\n");
+}
+
+/* Iteratively mask off outliers; returns the outlier-free average. The
+ * moments are kept in double so that the standard deviation is not
+ * truncated before it is compared against. */
+static uint64_t driver_statistics(const uint64_t* runtimes,
+                                  bool* runtimes_mask, uint32_t num_runs,
+                                  unsigned int nstd)
+{
+  /* Running analytics */
+  double   avg     =  0;
+  uint64_t avg_n   =  0;
+
+  double   std     =  0;
+  uint64_t std_n   =  0;
+
+  int      n_msked =  0;
+  int      n_stats =  0;
+
+  for (uint32_t i = 0; i < num_runs; i++)
+    runtimes_mask[i] = true;
+
+  printf("  * Running statistics:\n");
+  do {
+    n_stats++;
+    printf("    + Starting statistics run number #%d:\n", n_stats);
+    avg_n =  0;
+    avg   =  0;
+
+    /*   -> Calculate avg */
+    for (uint32_t i = 0; i < num_runs; i++) {
+      if (runtimes_mask[i]) {
+        avg += runtimes[i];
+        avg_n += 1;
+      }
+    }
+    avg = avg / avg_n;
+
+    /*   -> Calculate standard deviation */
+    std   =  0;
+    std_n =  0;
+
+    for (uint32_t i = 0; i < num_runs; i++) {
+      if (runtimes_mask[i]) {
+        std   += ((runtimes[i] - avg) *
+                  (runtimes[i] - avg));
+        std_n += 1;
+      }
+    }
+    std = sqrt(std / std_n);
+
+    /*   -> Calculate outlier-free average (mean) */
+    n_msked = 0;
+    for (uint32_t i = 0; i < num_runs; i++) {
+      if (runtimes_mask[i]) {
+        if (fabs(runtimes[i] - avg) > (nstd * std)) {
+          runtimes_mask[i] = false;
+          n_msked += 1;
+        }
+      }
+    }
+
+    printf("      - Standard deviation = %.1f\n", std);
+    printf("      - Average = %.1f\n", avg);
+    printf("      - Number of active elements = %" PRIu64 "\n", avg_n);
+    printf("      - Number of masked-off = %d\n", n_msked);
+  } while (n_msked > 0);
+
+  return (uint64_t)llround(avg);
+}
+
+/* Bring the caches into the state --cache asks for, before timed run
+ * `run` of one case. Cold flushes the case's buffers (those of the input
+ * copy the run rotates to and the shared ones) from every level, or
+ * sweeps twice the LLC where it lists none; llc touches them and sweeps
+ * twice L1 + L2, so they are left in the LLC only. */
+static void driver_cache_prepare(const driver_bench_t* bench,
+                                 const driver_opts_t* opts, int idx,
+                                 const driver_case_t* c, uint32_t run)
+{
+  int copy = -1;
+
+  if (opts->cache == DRIVER_CACHE_WARM) return;
+
+  if (opts->cache == DRIVER_CACHE_COLD) {
+    if (bench->rotate != NULL && c->ncopies > 1) {
+      copy = (int)(run % c->ncopies);
+      bench->rotate(bench->ctx, idx, copy);
+    }
+
+    if (c->nbufs == 0 || !evict_can_flush()) {
+      evict_sweep(2 * cpu_cache_bytes(3));
+      return;
+    }
+
+    for (int b = 0; b < c->nbufs; b++) {
+      if (c->bufs[b].copy < 0 || c->bufs[b].copy == copy ||
+          (copy < 0 && c->bufs[b].copy == 0)) {
+        evict_flush(c->bufs[b].ptr, c->bufs[b].bytes);
+      }
+    }
+  } else {
+    for (int b = 0; b < c->nbufs; b++) {
+      if (c->bufs[b].copy <= 0) evict_touch(c->bufs[b].ptr, c->bufs[b].bytes);
+    }
+
+    evict_sweep(2 * (cpu_cache_bytes(1) + cpu_cache_bytes(2)));
+  }
+}
+
+/* The "key,value" lines of a runtimes file around the runs themselves */
+static void driver_dump_head(const driver_bench_t* bench, const char* impl_str,
+                             int idx, const driver_case_t* c,
+                             uint32_t num_runs, FILE* fp)
+{
+  fprintf(fp, "impl,%s", impl_str);
+
+  if (c->label != NULL) {
+    fprintf(fp, "\n");
+    fprintf(fp, "case,%s", c->label);
+  }
+
+  if (bench->dump != NULL) bench->dump(bench->ctx, idx, fp);
+
+  fprintf(fp, "\n");
+  fprintf(fp, "num_of_runs,%d", num_runs);
+}
+
+static void driver_dump_tail(const driver_case_t* c, uint64_t avg,
+                             double gflops, double gbps, const stats_t* st,
+                             FILE* fp)
+{
+  fprintf(fp, "\n");
+  fprintf(fp, "avg,%" PRIu64 "", avg);
+
+  if (c->flops > 0) {
+    fprintf(fp, "\n");
+    fprintf(fp, "gflops,%.6f", gflops);
+  }
+
+  if (c->bytes > 0) {
+    fprintf(fp, "\n");
+    fprintf(fp, "gbps,%.6f", gbps);
+  }
+
+  if (c->elems > 0) {
+    fprintf(fp, "\n");
+    fprintf(fp, "ns_per_elem,%.6f", avg / c->elems);
+  }
+
+  if (c->elems > 0 && c->unit != NULL && avg > 0) {
+    fprintf(fp, "\n");
+    fprintf(fp, "elems_per_sec,%.6f", c->elems * 1e9 / avg);
+  }
+
+  stats_dump(st, fp);
+}
+
+/* Queue the runtimes (csv, or binary with the counters as extra rows) and
+ * the statistics (JSON) of one implementation to the result writer */
+static void driver_dump(const driver_bench_t* bench, const driver_opts_t* opts,
+                        const char* impl_str, int idx, const driver_case_t* c,
+                        const uint64_t* runtimes, uint32_t num_runs,
+                        uint64_t avg, double gflops, double gbps,
+                        const stats_t* st, const counters_t* cnt)
+{
+  printf("  * Dumping runtime informations (%s):\n", out_format_name(out_format()));
+  out_file_t* f;
+  char basename[192];
+  char filename[256];
+  if (c->label != NULL) {
+    snprintf(basename, sizeof(basename), "%s_%s", impl_str, c->label);
+  } else {
+    snprintf(basename, sizeof(basename), "%s", impl_str);
+  }
+
+  if (out_binary()) {
+    /* The header lines become the metadata; the runs are row 0 */
+    char*  meta     = NULL;
+    size_t meta_len = 0;
+    FILE*  ms       = open_memstream(&meta, &meta_len);
+    int    nrows    = 1;
+
+    if (ms != NULL) {
+      driver_dump_head(bench, impl_str, idx, c, num_runs, ms);
+      driver_dump_tail(c, avg, gflops, gbps, st, ms);
+
+      fprintf(ms, "\n");
+      fprintf(ms, "rows,runtimes");
+      for (int i = 0; opts->use_counters && i < CNT_NUM; i++) {
+        if (counters_avail(cnt, i)) {
+          fprintf(ms, ",%s", counters_name(i));
+          nrows++;
+        }
+      }
+      fprintf(ms, "\n");
+      fclose(ms);
+    }
+
+    snprintf(filename, sizeof(filename), "%s_runtimes.bin", basename);
+    f = out_open(filename, true);
+    if (f != NULL && meta != NULL) {
+      out_put_header(f->fp, OUT_DTYPE_U64, nrows, num_runs, meta, meta_len);
+      out_put_bin_u64s(f->fp, runtimes, num_runs, 1);
+      for (int i = 0; opts->use_counters && i < CNT_NUM; i++) {
+        if (counters_avail(cnt, i)) {
+          out_put_bin_u64s(f->fp, &cnt->values[i], num_runs, CNT_NUM);
+        }
+      }
+    }
+    free(meta);
+  } else {
+    snprintf(filename, sizeof(filename), "%s_runtimes.csv", basename);
+    f = out_open(filename, false);
+    if (f != NULL) {
+      driver_dump_head(bench, impl_str, idx, c, num_runs, f->fp);
+
+      fprintf(f->fp, "\n");
+      fprintf(f->fp, "runtimes");
+      out_put_u64s(f->fp, ", ", runtimes, num_runs, 1);
+
+      driver_dump_tail(c, avg, gflops, gbps, st, f->fp);
+
+      if (opts->use_counters) counters_dump(cnt, f->fp);
+
+      fprintf(f->fp, "\n");
+    }
+  }
+
+  if (f != NULL) {
+    printf("    - Filename: %s\n", f->path);
+    printf("    - Writing runtimes ... Queued\n");
+    out_close(f);
+  } else {
+    printf("    - Filename: %s .... Failed\n", filename);
+  }
+
+  /* The same distribution as JSON, for scripts */
+  snprintf(filename, sizeof(filename), "%s_stats.json", basename);
+  f = out_open(filename, false);
+
+  if (f != NULL) {
+    FILE* fp = f->fp;
+
+    fprintf(fp, "{\"bench\": \"%s\", ", bench->name);
+    fprintf(fp, "\"impl\": \"%s\", ", impl_str);
+    if (c->label != NULL) {
+      fprintf(fp, "\"case\": \"%s\", ", c->label);
+    }
+    fprintf(fp, "\"num_of_runs\": %u, ", num_runs);
+    fprintf(fp, "\"avg\": %" PRIu64 ", ", avg);
+    if (c->flops > 0) {
+      fprintf(fp, "\"gflops\": %.6f, ", gflops);
+    }
+    if (c->bytes > 0) {
+      fprintf(fp, "\"gbps\": %.6f, ", gbps);
+    }
+    if (c->elems > 0) {
+      fprintf(fp, "\"ns_per_elem\": %.6f, ", avg / c->elems);
+    }
+    if (c->elems > 0 && c->unit != NULL && avg > 0) {
+      fprintf(fp, "\"elems_per_sec\": %.6f, ", c->elems * 1e9 / avg);
+    }
+    fprintf(fp, "\"runtimes_ns\": ");
+    stats_json(st, fp);
+    fprintf(fp, "}\n");
+
+    printf("    - Filename: %s\n", f->path);
+    printf("    - Writing statistics ... Queued\n");
+    out_close(f);
+  } else {
+    printf("    - Filename: %s .... Failed\n", filename);
+  }
+}
+
+/* Queue the Chrome trace of one implementation */
+static void driver_trace_dump(const char* impl_str, const driver_case_t* c,
+                              const trace_t* trace)
+{
+  char filename[256];
+
+  if (c->label != NULL) {
+    snprintf(filename, sizeof(filename), "%s_%s_trace.json", impl_str, c->label);
+  } else {
+    snprintf(filename, sizeof(filename), "%s_trace.json", impl_str);
+  }
+
+  out_file_t* f = out_open(filename, false);
+
+  if (f != NULL) {
+    trace_chrome(trace, impl_str, f->fp);
+    printf("    - Chrome trace: %s (%zu spans)\n", f->path, trace->nspans);
+    out_close(f);
+  } else {
+    printf("    - Chrome trace: %s .... Failed\n", filename);
+  }
+}
+
+/* Start the run manifest: everything that decides whether two runs are
+ * comparable, before any result */
+static void driver_manifest_open(const driver_bench_t* bench,
+                                 const driver_opts_t* opts, driver_state_t* drv,
+                                 int argc, char** argv)
+{
+  char filename[192];
+
+  snprintf(filename, sizeof(filename), "%s_manifest.json", bench->name);
+  drv->manifest = out_open(filename, false);
+
+  if (drv->manifest == NULL) {
+    printf("  * Manifest: %s .... Failed\n", filename);
+    return;
+  }
+  printf("  * Manifest: %s\n", drv->manifest->path);
+
+  FILE* fp = drv->manifest->fp;
+
+  fprintf(fp, "{\"schema\": %d, ", MANIFEST_SCHEMA);
+  fprintf(fp, "\"bench\": "); manifest_str(fp, bench->name); fprintf(fp, ", ");
+  fprintf(fp, "\"command\": [");
+  for (int i = 0; i < argc; i++) {
+    fprintf(fp, "%s", i ? ", " : "");
+    manifest_str(fp, argv[i]);
+  }
+  fprintf(fp, "], ");
+  fprintf(fp, "\"date\": "); manifest_date(fp); fprintf(fp, ",\n ");
+  manifest_build(fp); fprintf(fp, ",\n ");
+  manifest_machine(fp, opts->cpu); fprintf(fp, ",\n ");
+
+  fprintf(fp, "\"config\": {");
+  fprintf(fp, "\"impls\": "); manifest_str(fp, opts->impl_str); fprintf(fp, ", ");
+  fprintf(fp, "\"nthreads\": %d, ", opts->nthreads);
+  fprintf(fp, "\"cpu\": %d, ", opts->cpu);
+  fprintf(fp, "\"affinity\": "); manifest_str(fp, affinity_name(opts->affinity)); fprintf(fp, ", ");
+  fprintf(fp, "\"cpus\": [");
+  for (int i = 0; i < opts->nthreads; i++) {
+    fprintf(fp, "%s%d", i ? ", " : "", opts->cpus[i]);
+  }
+  fprintf(fp, "], ");
+  fprintf(fp, "\"scale\": [");
+  for (int s = 0; s < opts->nscale; s++) {
+    fprintf(fp, "%s%d", s ? ", " : "", opts->scale[s]);
+  }
+  fprintf(fp, "], ");
+  fprintf(fp, "\"nruns\": %d, ", opts->nruns);
+  fprintf(fp, "\"nstdevs\": %d, ", opts->nstdevs);
+  fprintf(fp, "\"ninner\": %d, ", opts->ninner);
+  fprintf(fp, "\"nwarmup\": %d, ", opts->nwarmup);
+  fprintf(fp, "\"counters\": %s, ", opts->use_counters ? "true" : "false");
+  fprintf(fp, "\"autotune\": %s, ", opts->autotune ? "true" : "false");
+  fprintf(fp, "\"isa_cap\": ");
+  if (opts->isa != CPU_ISA_NUM) manifest_str(fp, cpu_isa_name(opts->isa));
+  else                          fprintf(fp, "null");
+  fprintf(fp, ", ");
+  fprintf(fp, "\"pages\": "); manifest_str(fp, mem_pages_name(opts->mem.pages)); fprintf(fp, ", ");
+  if      (opts->mem.numa == MEM_NUMA_BIND      ) fprintf(fp, "\"numa\": %d, ", opts->mem.node);
+  else if (opts->mem.numa == MEM_NUMA_INTERLEAVE) fprintf(fp, "\"numa\": \"interleave\", ");
+  else                                            fprintf(fp, "\"numa\": \"local\", ");
+  fprintf(fp, "\"prefault\": %s, ", opts->mem.prefault ? "true" : "false");
+  fprintf(fp, "\"cache\": \"%s\", ", driver_cache_names[opts->cache]);
+  fprintf(fp, "\"trace\": %s", opts->trace ? "true" : "false");
+  fprintf(fp, "},\n ");
+
+  fprintf(fp, "\"results\": [");
+}
+
+/* One implementation on one case: the dataset from the dump hook, the
+ * tunables in effect, the statistics and every run */
+static void driver_manifest_result(const driver_bench_t* bench,
+                                   const driver_opts_t* opts,
+                                   driver_state_t* drv, const char* impl_str,
+                                   int idx, const driver_case_t* c,
+                                   int nthreads, const uint64_t* runtimes,
+                                   uint64_t avg, double gflops, double gbps,
+                                   const stats_t* st, const counters_t* cnt,
+                                   const trace_t* trace, bool ok)
+{
+  if (drv->manifest == NULL) return;
+
+  FILE* fp = drv->manifest->fp;
+
+  fprintf(fp, "%s\n  {", drv->nmanifest++ ? "," : "");
+  fprintf(fp, "\"impl\": "); manifest_str(fp, impl_str); fprintf(fp, ", ");
+  fprintf(fp, "\"case\": ");
+  if (c->label != NULL) manifest_str(fp, c->label);
+  else                  fprintf(fp, "null");
+  fprintf(fp, ", ");
+  fprintf(fp, "\"threads\": %d, ", nthreads);
+  fprintf(fp, "\"verified\": %s, ", ok ? "true" : "false");
+
+  /* The dataset, as the dump hook describes it */
+  char*  lines = NULL;
+  size_t len   = 0;
+  FILE*  ms    = open_memstream(&lines, &len);
+
+  if (ms != NULL) {
+    if (bench->dump != NULL) bench->dump(bench->ctx, idx, ms);
+    fclose(ms);
+    fprintf(fp, "\"dataset\": ");
+    manifest_kv(fp, lines, len);
+    fprintf(fp, ", ");
+  }
+  free(lines);
+
+  fprintf(fp, "\"tunables\": {");
+  for (int p = 0; p < bench->ntunables; p++) {
+    fprintf(fp, "%s", p ? ", " : "");
+    manifest_str(fp, bench->tunables[p].name);
+    fprintf(fp, ": %d", *bench->tunables[p].value);
+  }
+  fprintf(fp, "}, ");
+
+  fprintf(fp, "\"avg\": %" PRIu64 ", ", avg);
+  if (c->flops > 0) fprintf(fp, "\"gflops\": %.6f, ", gflops);
+  if (c->bytes > 0) fprintf(fp, "\"gbps\": %.6f, ", gbps);
+  if (c->elems > 0) fprintf(fp, "\"ns_per_elem\": %.6f, ", avg / c->elems);
+
+  if (opts->use_counters) {
+    bool first = true;
+
+    fprintf(fp, "\"counters\": {");
+    for (int i = 0; i < CNT_NUM; i++) {
+      if (!counters_avail(cnt, i)) continue;
+      fprintf(fp, "%s\"%s\": %.3f", first ? "" : ", ", counters_name(i),
+              counters_mean(cnt, i));
+      first = false;
+    }
+    fprintf(fp, "}, ");
+  }
+
+  if (trace != NULL) {
+    fprintf(fp, "\"trace\": ");
+    trace_json(trace, fp);
+    fprintf(fp, ", ");
+  }
+
+  fprintf(fp, "\"stats\": ");
+  stats_json(st, fp);
+  fprintf(fp, ",\n   \"runtimes\": ");
+  manifest_u64s(fp, runtimes, drv->num_runs);
+  fprintf(fp, "}");
+}
+
+/* Finish the manifest and queue it */
+static void driver_manifest_close(driver_state_t* drv)
+{
+  if (drv->manifest == NULL) return;
+
+  fprintf(drv->manifest->fp, "\n ]}\n");
+  out_close(drv->manifest);
+  drv->manifest = NULL;
+}
+
+/* Time every selected implementation on one case and report; row holds
+ * one result per implementation */
+static void driver_measure(const driver_bench_t* bench,
+                           const driver_opts_t* opts, driver_state_t* drv,
+                           int idx, const driver_case_t* c, int nthreads,
+                           driver_result_t* row)
+{
+  /* Time keeping */
+  struct timespec ts;
+  struct timespec te;
+
+  int      nsel     = opts->nimpls;
+  uint32_t num_runs = drv->num_runs;
+  void*    args     = c->args;
+
+  /* Speedups are relative to the first registered implementation (the
+   * naive/scalar one) when it is selected, else to the first selected */
+  int base = 0;
+  for (int k = 0; k < nsel; k++) {
+    if (opts->impls[k] == &bench->impls[0]) base = k;
+  }
+
+  /* Start execution */
+  if (nsel == 1) {
+    printf("Running \"%s\" implementation", opts->impls[0]->label);
+  } else {
+    printf("Running %d implementations interleaved in random order", nsel);
+  }
+  if (c->label != NULL) {
+    printf(" (%s)", c->label);
+  }
+  if (opts->nscale > 0) {
+    printf(" with %d thread(s)", nthreads);
+  }
+  printf(":\n");
+
+  /* Calibrated once, the first time a case reports per element */
+  if (c->elems > 0 && drv->tsc_ghz == 0) drv->tsc_ghz = driver_tsc_ghz();
+
+  if (opts->nwarmup > 0) {
+    printf("  * Warming up with %d invocations .... ", opts->nwarmup);
+    for (int k = 0; k < nsel; k++) {
+      for (int i = 0; i < opts->nwarmup; i++) {
+        opts->impls[k]->fn(args);
+      }
+    }
+    printf("Finished\n");
+  }
+
+  if (bench->timed != NULL) bench->timed(bench->ctx, idx, true);
+
+  /* Only the timed runs are traced; whatever came before is dropped */
+  if (opts->trace) {
+    pool_trace(drv->pool, true);
+    trace_collect(NULL, drv->pool);
+    for (int k = 0; k < nsel; k++) trace_reset(&drv->trace[k]);
+  }
+
+  printf("  * Invoking %s %d times .... ",
+         nsel == 1 ? "the implementation" : "each implementation", num_runs);
+  for (int k = 0; k < nsel; k++) {
+    drv->order[k] = k;
+  }
+
+  for (uint32_t i = 0; i < num_runs; i++) {
+    /* Shuffle so that drift hits every implementation alike */
+    for (int k = nsel - 1; k > 0; k--) {
+      int r = driver_rand(&drv->order_state) % (k + 1);
+      int t = drv->order[k]; drv->order[k] = drv->order[r]; drv->order[r] = t;
+    }
+
+    for (int o = 0; o < nsel; o++) {
+      int k = drv->order[o];
+      void* (*impl)(void* args) = opts->impls[k]->fn;
+
+      driver_cache_prepare(bench, opts, idx, c, i);
+
+      if (opts->use_counters) counters_start(&drv->cnt[k]);
+      __SET_START_TIME();
+      for (int j = 0; j < opts->ninner; j++) {
+        (*impl)(args);
+      }
+      __SET_END_TIME();
+      if (opts->use_counters) counters_stop(&drv->cnt[k], i, opts->ninner);
+      drv->runtimes[(size_t)k * num_runs + i] = __CALC_RUNTIME() / opts->ninner;
+
+      /* Whatever a kernel left in its arena is not carried into the next run */
+      pool_reset_scratch(drv->pool);
+
+      if (opts->trace) trace_collect(&drv->trace[k], drv->pool);
+    }
+  }
+  printf("Finished\n");
+
+  if (bench->timed != NULL) bench->timed(bench->ctx, idx, false);
+
+  if (opts->trace) pool_trace(drv->pool, false);
+
+  for (int k = 0; k < nsel; k++) {
+    const driver_impl_t* impl = opts->impls[k];
+    uint64_t* impl_runtimes   = &drv->runtimes[(size_t)k * num_runs];
+    driver_result_t* res      = &row[k];
+
+    if (nsel > 1) {
+      printf("Results of \"%s\" implementation:\n", impl->label);
+    }
+
+    /* Verfication; each implementation produces the output afresh */
+    printf("  * Verifying results .... ");
+    if (nsel > 1) {
+      if (bench->reset != NULL) bench->reset(bench->ctx, idx);
+      impl->fn(args);
+    }
+    driver_check_t check = bench->verify(bench->ctx, idx);
+    bool match = check.match;
+    bool guard = check.guard;
+    if (match && guard) {
+      printf("Success\n");
+    } else if (!match && guard) {
+      printf("Fail, but no buffer overruns\n");
+    } else if (match && !guard) {
+      printf("Success, but failed buffer overruns check\n");
+    } else if(!match && !guard) {
+      printf("Failed, and failed buffer overruns check\n");
+    }
+    if (check.err.count > 0) {
+      printf("    + Max error: abs = %.3e, rel = %.3e\n",
+             check.err.max_abs, check.err.max_rel);
+      if (check.err.mismatches > 0) {
+        printf("    + Mismatches: %zu of %zu, first at index %zu\n",
+               check.err.mismatches, check.err.count, check.err.first_bad);
+      }
+    }
+    if (bench->report != NULL) bench->report(bench->ctx, idx);
+
+    /* Running analytics */
+    uint64_t avg    = driver_statistics(impl_runtimes, drv->runtimes_mask,
+                                        num_runs, drv->nstd);
+    double   gflops = (c->flops > 0 && avg > 0) ? c->flops / avg : 0.0;
+    double   gbps   = (c->bytes > 0 && avg > 0) ? c->bytes / avg : 0.0;
+
+    /* Distribution of all runs, outliers included */
+    stats_t st;
+    stats_compute(&st, impl_runtimes, num_runs);
+
+    /* Display information */
+    printf("  * Runtimes (%s): ", __PRINT_MATCH(match));
+    printf(" %" PRIu64 " ns\n"  , avg                 );
+
+    /* The rate of wrong results is no result */
+    if (!(match && guard) && (c->flops > 0 || c->bytes > 0)) {
+      printf("  * Throughput: not reported, the results do not verify\n");
+    }
+
+    if (c->flops > 0 && match && guard) {
+      printf("  * Throughput: %.3f GFLOP/s\n", gflops);
+    }
+
+    if (c->bytes > 0 && match && guard) {
+      printf("  * Bandwidth: %.3f GB/s\n", gbps);
+    }
+
+    if (c->elems > 0 && avg > 0) {
+      double ns_elem = avg / c->elems;
+
+      /* Core cycles when counted, otherwise reference (TSC) cycles */
+      printf("  * Per element: %.3f ns", ns_elem);
+      if (opts->use_counters && counters_avail(&drv->cnt[k], CNT_CYCLES)) {
+        printf(", %.3f cycles", counters_mean(&drv->cnt[k], CNT_CYCLES) / c->elems);
+      } else if (drv->tsc_ghz > 0) {
+        printf(", %.3f TSC cycles", ns_elem * drv->tsc_ghz);
+      }
+      printf("\n");
+
+      if (c->unit != NULL) {
+        printf("  * Rate: %.3f M %s/s\n", 1e3 / ns_elem, c->unit);
+      }
+    }
+
+    if (opts->roofline && c->flops > 0 && c->bytes > 0) {
+      double intensity  = c->flops / c->bytes;
+      double attainable = roofline_attainable(&drv->peak, intensity);
+      bool   mem_bound  = intensity * drv->peak.bw_gbps < drv->peak.gflops;
+
+      printf("  * Roofline:\n");
+      printf("    - Arithmetic intensity = %.3f FLOP/B\n", intensity);
+      printf("    - Attainable = %.3f GFLOP/s (%s bound)\n", attainable,
+             mem_bound ? "memory" : "compute");
+      printf("    - Achieved = %.1f%% of attainable, %.1f%% of peak bandwidth, "
+             "%.1f%% of peak compute\n", 100.0 * gflops / attainable,
+             100.0 * gbps / drv->peak.bw_gbps, 100.0 * gflops / drv->peak.gflops);
+    }
+
+    printf("  * Distribution (all runs):\n");
+    stats_print(&st, "    ");
+
+    if (opts->use_counters) {
+      printf("  * Counters (per invocation, mean of all runs):\n");
+      counters_print(&drv->cnt[k], "    ");
+    }
+
+    if (opts->trace) {
+      printf("  * Threads (per fork/join, mean of all runs):\n");
+      trace_print(&drv->trace[k], "    ");
+      if (drv->trace[k].nspans > 0) driver_trace_dump(impl->label, c, &drv->trace[k]);
+    }
+
+    /* Dump */
+    driver_dump(bench, opts, impl->label, idx, c, impl_runtimes, num_runs,
+                avg, gflops, gbps, &st, &drv->cnt[k]);
+    driver_manifest_result(bench, opts, drv, impl->label, idx, c, nthreads,
+                           impl_runtimes, avg, gflops, gbps, &st, &drv->cnt[k],
+                           opts->trace ? &drv->trace[k] : NULL, match && guard);
+    printf("\n");
+
+    res->avg      = avg;
+    res->median   = st.median;
+    res->p99      = st.p99;
+    res->gflops   = gflops;
+    res->gbps     = gbps;
+    res->ok       = match && guard;
+    res->nthreads = nthreads;
+  }
+
+  /* Speedups on the median, which the interleaving keeps comparable; a
+   * baseline that fails verification is replaced by the first that
+   * passes, and implementations that fail get none */
+  int ref = base;
+  for (int k = 0; k < nsel && !row[ref].ok; k++) {
+    if (row[k].ok) ref = k;
+  }
+
+  for (int k = 0; k < nsel; k++) {
+    row[k].speedup = (row[k].ok && row[ref].ok && row[k].median > 0)
+                   ? row[ref].median / row[k].median : 0.0;
+  }
+
+  if (nsel > 1) {
+    if (row[ref].ok) printf("Comparison (baseline = %s):\n", opts->impls[ref]->label);
+    else             printf("Comparison (no implementation verifies):\n");
+    for (int k = 0; k < nsel; k++) {
+      if (row[k].ok) {
+        printf("  %-16s median = %14.1f ns, speedup = %8.3fx\n",
+               opts->impls[k]->label, row[k].median, row[k].speedup);
+      } else {
+        printf("  %-16s median = %14.1f ns, FAILED verification\n",
+               opts->impls[k]->label, row[k].median);
+      }
+    }
+    printf("\n");
+  }
+}
+
+/* Report speedup and parallel efficiency over the scaling steps of one
+ * case; steps holds nscale rows of nimpls results */
+static void driver_scaling(const driver_opts_t* opts, const driver_case_t* c,
+                           const driver_result_t* steps)
+{
+  int nsel = opts->nimpls;
+
+  for (int k = 0; k < nsel; k++) {
+    const driver_result_t* first = &steps[k];
+
+    printf("Scaling of \"%s\"", opts->impls[k]->label);
+    if (c->label != NULL) printf(" (%s)", c->label);
+    printf(":\n");
+    printf("  %8s %16s %10s %10s %10s %10s\n", "threads", "median (ns)",
+           "GFLOP/s", "GB/s", "speedup", "efficiency");
+
+    int saturated = -1;
+    for (int s = 0; s < opts->nscale; s++) {
+      const driver_result_t* res = &steps[(size_t)s * nsel + k];
+      double speedup    = (res->median > 0) ? first->median / res->median : 0.0;
+      double efficiency = speedup * first->nthreads / res->nthreads;
+
+      if (!res->ok || !first->ok) {
+        printf("  %8d %16.1f %10s %10s %10s %10s  FAILED verification\n",
+               res->nthreads, res->median, "-", "-", "-", "-");
+        continue;
+      }
+
+      printf("  %8d %16.1f %10.3f %10.3f %10.3f %10.3f\n", res->nthreads,
+             res->median, res->gflops, res->gbps, speedup, efficiency);
+
+      /* Saturation: the step gains less than half of its extra threads */
+      if (s > 0 && saturated < 0) {
+        const driver_result_t* prev = &steps[(size_t)(s - 1) * nsel + k];
+        double ratio = (double)res->nthreads / prev->nthreads;
+        double gain  = (res->median > 0) ? prev->median / res->median : 0.0;
+
+        if (ratio > 1.0 && (gain - 1.0) < 0.5 * (ratio - 1.0)) {
+          saturated = prev->nthreads;
+        }
+      }
+    }
+
+    if (saturated > 0) {
+      printf("  * Throughput saturates at %d thread(s)\n", saturated);
+    } else {
+      printf("  * No saturation up to %d thread(s)\n",
+             steps[(size_t)(opts->nscale - 1) * nsel + k].nthreads);
+    }
+    printf("\n");
+  }
+}
+
+/* Median runtime of impl on one case with the current tunables, or 0 if
+ * its output does not verify */
+static double driver_tune_time(const driver_bench_t* bench,
+                               const driver_opts_t* opts, driver_state_t* drv,
+                               int idx, const driver_case_t* c,
+                               const driver_impl_t* impl)
+{
+  /* Time keeping */
+  struct timespec ts;
+  struct timespec te;
+
+  uint64_t runtimes[DRIVER_TUNE_RUNS];
+
+  /* A candidate must still produce the right result */
+  if (bench->reset != NULL) bench->reset(bench->ctx, idx);
+  impl->fn(c->args);
+  pool_reset_scratch(drv->pool);
+
+  driver_check_t check = bench->verify(bench->ctx, idx);
+  if (!check.match || !check.guard) return 0.0;
+
+  for (int i = 0; i < opts->nwarmup; i++) {
+    impl->fn(c->args);
+    pool_reset_scratch(drv->pool);
+  }
+
+  for (int i = 0; i < DRIVER_TUNE_RUNS; i++) {
+    driver_cache_prepare(bench, opts, idx, c, i);
+
+    __SET_START_TIME();
+    for (int j = 0; j < opts->ninner; j++) {
+      impl->fn(c->args);
+    }
+    __SET_END_TIME();
+    runtimes[i] = __CALC_RUNTIME() / opts->ninner;
+
+    pool_reset_scratch(drv->pool);
+  }
+
+  stats_t st;
+  stats_compute(&st, runtimes, DRIVER_TUNE_RUNS);
+
+  return st.median;
+}
+
+/* Set the tunables of one case: the kernels' defaults, overridden by the
+ * tune cache. With --autotune, the tunables of the chosen implementations
+ * are then searched one at a time (each keeps its winner while the next
+ * is searched) and the winners are written back to the cache. */
+static void driver_tune(const driver_bench_t* bench, const driver_opts_t* opts,
+                        driver_state_t* drv, int idx, const driver_case_t* c,
+                        const int* defaults)
+{
+  int n = bench->ntunables;
+
+  for (int p = 0; p < n; p++) {
+    *bench->tunables[p].value = defaults[p];
+  }
+
+  int nset = tune_load(opts->tune_cache, bench->name, c->label, opts->nthreads,
+                       bench->tunables, n);
+
+  if (!opts->autotune) {
+    if (nset > 0) {
+      printf("Tunables from \"%s\":", opts->tune_cache);
+      for (int p = 0; p < n; p++) {
+        printf("%s %s = %d", p ? "," : "", bench->tunables[p].name,
+               *bench->tunables[p].value);
+      }
+      printf("\n");
+      printf("\n");
+    }
+    return;
+  }
+
+  tune_param_t tuned[TUNE_MAX_PARAMS];
+  int          ntuned = 0;
+
+  printf("Autotuning");
+  if (c->label != NULL) printf(" (%s)", c->label);
+  printf(" on %s:\n", tune_machine());
+
+  for (int p = 0; p < n; p++) {
+    const tune_param_t*  t    = &bench->tunables[p];
+    const driver_impl_t* impl = driver_find_impl(bench, t->impl, strlen(t->impl));
+    bool                 sel  = false;
+
+    for (int k = 0; k < opts->nimpls; k++) {
+      if (opts->impls[k] == impl) sel = true;
+    }
+    if (!sel) continue;
+
+    printf("  * %s (%s):\n", t->name, impl->label);
+
+    int    best    = *t->value;
+    double best_ns = 0.0;
+
+    for (int i = 0; i < t->ncands; i++) {
+      *t->value = t->cands[i];
+
+      double ns = driver_tune_time(bench, opts, drv, idx, c, impl);
+
+      if (ns > 0) {
+        printf("    - %8d: median = %14.1f ns\n", t->cands[i], ns);
+      } else {
+        printf("    - %8d: fails verification\n", t->cands[i]);
+      }
+
+      if (ns > 0 && (best_ns == 0 || ns < best_ns)) {
+        best    = t->cands[i];
+        best_ns = ns;
+      }
+    }
+
+    *t->value = best;
+    printf("    + Best = %d\n", best);
+
+    tuned[ntuned++] = *t;
+  }
+
+  if (ntuned == 0) {
+    printf("  * None of the chosen implementations has tunables\n");
+  } else {
+    printf("  * Saving to \"%s\" .... ", opts->tune_cache);
+    if (tune_save(opts->tune_cache, bench->name, c->label, opts->nthreads,
+                  tuned, ntuned) == 0) {
+      printf("Succeeded\n");
+    } else {
+      printf("Failed\n");
+    }
+  }
+  printf("\n");
+}
+
+/* A worker of a distributed run (--connect): its own pool, then the
+ * benchmark's serve hook until rank 0 hangs up */
+static int driver_serve(const driver_bench_t* bench, const driver_opts_t* opts)
+{
+  printf("Creating a worker pool with %d thread(s) .... ", opts->nthreads);
+  pool_t pool;
+  if (pool_create(&pool, opts->nthreads, opts->cpus) != 0) {
+    printf("Failed\n");
+    exit(-1);
+  }
+  printf("Succeeded\n");
+
+  dist_t dist;
+
+  printf("Connecting to rank 0 at %s .... ", opts->connect);
+  if (dist_connect(&dist, bench->name, opts->connect) != 0) {
+    printf("\n");
+    exit(-1);
+  }
+  printf("rank %d of %d\n", dist.rank, dist.nranks);
+  printf("\n");
+
+  driver_env_t env;
+
+  memset(&env, 0, sizeof(env));
+  env.cpu      = opts->cpu;
+  env.nthreads = opts->nthreads;
+  env.pool     = &pool;
+  env.cache    = DRIVER_CACHE_WARM;
+  env.copies   = 1;
+  env.dist     = &dist;
+
+  int ret = bench->serve(bench->ctx, &env);
+
+  printf("Rank 0 is done; served %" PRIu64 " request(s)\n", dist.phases.invocations);
+
+  dist_close(&dist);
+  pool_destroy(&pool);
+
+  return (out_finish() > 0 || ret != 0) ? 1 : 0;
+}
+
+int driver_main(const driver_bench_t* bench, int argc, char** argv)
+{
+  /* Set the buffer for printf to NULL */
+  setbuf(stdout, NULL);
+
+  /* Arguments */
+  driver_opts_t opts;
+
+  memset(&opts, 0, sizeof(opts));
+  opts.nthreads = 1;
+  opts.cpu      = 0;
+  opts.nruns    = bench->nruns;
+  opts.nstdevs  = 3;
+  opts.ninner   = bench->ninner;
+  opts.nwarmup  = bench->nwarmup;
+  opts.isa      = CPU_ISA_NUM;
+  opts.tune_cache = TUNE_CACHE_DEFAULT;
+  opts.out_fmt    = OUT_CSV;
+  opts.out_dir    = ".";
+  opts.nranks     = 1;
+  opts.port       = DIST_PORT;
+
+  driver_parse(bench, &opts, argc, argv);
+
+  /* Entry points are final once every option is in */
+  int navail = 0;
+  for (int k = 0; k < opts.nimpls; k++) {
+    const driver_impl_t* impl = opts.impls[k];
+
+    if (impl->fn != NULL) {
+      opts.impls[navail++] = impl;
+    } else if (strcmp(opts.impl_str, "all") != 0) {
+      printf("\n");
+      printf("ERROR: The \"%s\" implementation is not available with these options.\n",
+             impl->name);
+
+      opts.parse_err = true;
+    }
+  }
+  opts.nimpls = navail;
+
+  if (!opts.parse_err && (opts.nranks > 1 || opts.connect != NULL) &&
+      bench->serve == NULL) {
+    printf("\n");
+    printf("ERROR: \"%s\" does not support --ranks and --connect.\n", bench->name);
+
+    opts.parse_err = true;
+  }
+
+  /* A worker runs what rank 0 asks for, no implementation of its own */
+  bool worker = (opts.connect != NULL);
+
+  if (!opts.parse_err && !opts.help && opts.nimpls == 0 && !worker) {
+    printf("\n");
+    printf("ERROR: No implementation was chosen.\n");
+  }
+
+  if (!opts.parse_err && opts.nscale > 0 && bench->set_nthreads == NULL) {
+    printf("\n");
+    printf("ERROR: \"%s\" does not support --scale.\n", bench->name);
+
+    opts.parse_err = true;
+  }
+
+  if (!opts.parse_err && opts.autotune && bench->ntunables == 0) {
+    printf("\n");
+    printf("ERROR: \"%s\" has nothing to autotune.\n", bench->name);
+
+    opts.parse_err = true;
+  }
+
+  if (opts.help || (opts.nimpls == 0 && !worker) || opts.parse_err) {
+    driver_usage(bench, &opts, argv[0]);
+    exit(opts.help ? 0 : 1);
+  }
+
+  /* A prepared cache state only holds for the first invocation */
+  if (opts.cache != DRIVER_CACHE_WARM) opts.ninner = 1;
+
+  /* The pool and the affinity mask cover the largest step */
+  for (int s = 0; s < opts.nscale; s++) {
+    if (s == 0 || opts.scale[s] > opts.nthreads) opts.nthreads = opts.scale[s];
+  }
+
+  /* Result files, written in the background from here on; before the
+   * cases, which may create directories inside */
+  if (out_init(opts.out_fmt, opts.out_dir) != 0) {
+    printf("\n");
+    exit(1);
+  }
+
+  int ncases = (bench->ncases != NULL) ? bench->ncases(bench->ctx) : 1;
+  if (ncases < 1 && !worker) {
+    printf("\n");
+    printf("ERROR: Nothing to run.\n");
+    printf("\n");
+    exit(1);
+  }
+
+  int nsel   = opts.nimpls;
+  int nsteps = (opts.nscale > 0) ? opts.nscale : 1;
+
+  /* The kernels' own values, restored before every case */
+  int tune_defaults[TUNE_MAX_PARAMS];
+
+  assert(bench->ntunables <= TUNE_MAX_PARAMS);
+  for (int p = 0; p < bench->ntunables; p++) {
+    tune_defaults[p] = *bench->tunables[p].value;
+  }
+
+  /* Thread placement; the pool and the process mask follow it */
+  affinity_info_t topo;
+
+  affinity_info(&topo);
+  opts.cpus = (int*)malloc(opts.nthreads * sizeof(int));
+  if (opts.cpus == NULL ||
+      affinity_plan(opts.affinity, opts.cpu, opts.nthreads, opts.cpus) != 0) {
+    printf("\n");
+    printf("ERROR: \"%s\" cannot place %d thread(s) on %d CPU(s), %d core(s) "
+           "of which %d performance.\n", affinity_name(opts.affinity),
+           opts.nthreads, topo.ncpus, topo.ncores, topo.npcores);
+    printf("\n");
+    exit(1);
+  }
+
+  /* Scheduling and affinity */
+  driver_sched_setup(&opts);
+
+  printf("  * Topology: %d package(s), %d core(s), %d CPU(s)",
+         topo.npackages, topo.ncores, topo.ncpus);
+  if (topo.hybrid) {
+    printf(", hybrid (%d performance + %d efficiency cores)", topo.npcores,
+           topo.ncores - topo.npcores);
+  }
+  printf("\n");
+  printf("  * Placement (%s):", affinity_name(opts.affinity));
+  for (int i = 0; i < opts.nthreads; i++) printf(" %d", opts.cpus[i]);
+  printf("\n");
+
+  /* Kernel dispatch; capped before any implementation resolves its variant */
+  if (opts.isa != CPU_ISA_NUM) cpu_limit_isa(opts.isa);
+  printf("  * Kernel ISA: best = %s, active = %s\n",
+         cpu_isa_name(cpu_best_isa()), cpu_isa_name(cpu_active_isa()));
+
+  /* Allocation policy; set before the first benchmark allocation */
+  mem_set_policy(&opts.mem);
+  printf("  * Memory: pages = %s, numa = ", mem_pages_name(opts.mem.pages));
+  if      (opts.mem.numa == MEM_NUMA_BIND      ) printf("node %d", opts.mem.node);
+  else if (opts.mem.numa == MEM_NUMA_INTERLEAVE) printf("interleave");
+  else                                           printf("local");
+  printf(", prefault = %s\n", opts.mem.prefault ? "on" : "off");
+
+  printf("  * Cache: %s", driver_cache_names[opts.cache]);
+  if (opts.cache != DRIVER_CACHE_WARM) printf(", one invocation per timed run");
+  printf("\n");
+
+  printf("  * Results: format = %s, directory = %s\n",
+         out_format_name(opts.out_fmt), opts.out_dir);
+
+  if (worker) return driver_serve(bench, &opts);
+
+  /* Statistics; one row of runtimes per selected implementation */
+  driver_state_t* drv = (driver_state_t*)calloc(1, sizeof(driver_state_t));
+
+  drv->num_runs      = opts.nruns;
+  drv->runtimes      = (uint64_t*)calloc((size_t)nsel * drv->num_runs,
+                                         sizeof(uint64_t));
+  drv->runtimes_mask = (bool*    )calloc(drv->num_runs, sizeof(bool));
+  drv->nstd          = opts.nstdevs;
+  drv->order_state   = 0x2545f4914f6cdd1dllu;
+
+  /* Run manifest; results are added as they are measured */
+  driver_manifest_open(bench, &opts, drv, argc, argv);
+
+  /* Performance counters; opened before the pool so workers inherit them */
+  if (opts.use_counters) {
+    printf("Opening performance counters .... ");
+    int navail = 0;
+    for (int k = 0; k < nsel; k++) {
+      navail = counters_init(&drv->cnt[k], drv->num_runs);
+    }
+    printf("%d of %d available\n", navail, CNT_NUM);
+  }
+
+  /* Worker pool; created once so that thread creation is never timed */
+  printf("Creating a worker pool with %d thread(s) .... ", opts.nthreads);
+  pool_t pool;
+  if (pool_create(&pool, opts.nthreads, opts.cpus) != 0) {
+    printf("Failed\n");
+    exit(-1);
+  }
+  printf("Succeeded\n");
+  printf("\n");
+
+  /* Machine ceilings with the same threads the kernels will use */
+  if (opts.roofline) {
+    printf("Probing machine peaks with %d thread(s):\n", opts.nthreads);
+    roofline_probe(&drv->peak, &pool, opts.nthreads);
+    printf("  * Bandwidth (triad): %.3f GB/s\n", drv->peak.bw_gbps);
+    printf("  * Compute (FMA)    : %.3f GFLOP/s\n", drv->peak.gflops);
+    printf("  * Ridge point      : %.3f FLOP/B\n",
+           drv->peak.gflops / drv->peak.bw_gbps);
+    printf("\n");
+  }
+
+  driver_env_t env;
+
+  env.cpu      = opts.cpu;
+  env.nthreads = opts.nthreads;
+  env.pool     = &pool;
+  env.cache    = opts.cache;
+  env.copies   = (opts.cache == DRIVER_CACHE_COLD) ? DRIVER_CACHE_COPIES : 1;
+
+  drv->pool    = &pool;
+
+  /* The workers of a distributed run; with one rank, nobody to wait for */
+  dist_t dist;
+
+  if (opts.nranks > 1) {
+    printf("Waiting for %d worker(s) on port %d .... ", opts.nranks - 1, opts.port);
+  }
+  if (dist_listen(&dist, bench->name, opts.port, opts.nranks) != 0) {
+    printf("\n");
+    exit(-1);
+  }
+  if (opts.nranks > 1) {
+    printf("Connected\n");
+    printf("\n");
+  }
+
+  env.dist     = &dist;
+
+  if (opts.trace) {
+    for (int k = 0; k < nsel; k++) {
+      if (trace_init(&drv->trace[k], opts.nthreads) != 0) {
+        printf("ERROR: Allocating the trace buffers failed.\n");
+        exit(-1);
+      }
+    }
+  }
+
+  /* Initialize Rand */
+  srand(0xdeadbeef);
+
+  driver_result_t* results = (driver_result_t*)calloc((size_t)ncases * nsteps * nsel,
+                                                      sizeof(driver_result_t));
+  driver_case_t*   cases   = (driver_case_t*  )calloc(ncases,
+                                                      sizeof(driver_case_t));
+
+  for (int idx = 0; idx < ncases; idx++) {
+    driver_case_t* c = &cases[idx];
+
+    if (!bench->setup(bench->ctx, idx, &env, c)) {
+      printf("ERROR: Setting up case #%d failed.\n", idx);
+      exit(-1);
+    }
+
+    /* Scratch for the case; grown (never shrunk) and touched up front */
+    if (c->scratch > 0) {
+      printf("Reserving %.1f KiB of scratch per thread .... ", c->scratch / 1024.0);
+      if (pool_reserve_scratch(&pool, c->scratch) != 0) {
+        printf("Failed\n");
+        exit(-1);
+      }
+      printf("Succeeded\n");
+      printf("\n");
+    }
+
+    /* Tunables of the case, from the cache or searched afresh */
+    if (bench->ntunables > 0) {
+      driver_tune(bench, &opts, drv, idx, c, tune_defaults);
+    }
+
+    driver_result_t* steps = &results[(size_t)idx * nsteps * nsel];
+
+    if (opts.nscale == 0) {
+      driver_measure(bench, &opts, drv, idx, c, opts.nthreads, steps);
+    } else {
+      for (int s = 0; s < opts.nscale; s++) {
+        /* Same data, fewer threads; outputs are named after the step */
+        char label[160];
+        driver_case_t step = *c;
+
+        snprintf(label, sizeof(label), "%s%sn%d",
+                 c->label != NULL ? c->label : "",
+                 c->label != NULL ? "_"      : "", opts.scale[s]);
+        step.label = label;
+
+        bench->set_nthreads(bench->ctx, idx, opts.scale[s]);
+        driver_measure(bench, &opts, drv, idx, &step, opts.scale[s],
+                       &steps[(size_t)s * nsel]);
+      }
+
+      driver_scaling(&opts, c, steps);
+    }
+
+    /* Manage memory */
+    bench->teardown(bench->ctx, idx);
+  }
+
+  /* Summary table */
+  if (ncases > 1) {
+    printf("Summary (%s):\n", opts.impl_str);
+    printf("  %-24s %-16s %8s %16s %16s %16s %10s %10s %10s %10s\n", "case",
+           "impl", "threads", "avg (ns)", "median (ns)", "p99 (ns)", "GFLOP/s",
+           "GB/s", "speedup", "result");
+    for (int idx = 0; idx < ncases; idx++) {
+      for (int s = 0; s < nsteps; s++) {
+        for (int k = 0; k < nsel; k++) {
+          driver_result_t* res = &results[((size_t)idx * nsteps + s) * nsel + k];
+
+          if (!res->ok) {
+            printf("  %-24s %-16s %8d %16" PRIu64 " %16.1f %16.1f %10s %10s %10s %10s\n",
+                   cases[idx].label != NULL ? cases[idx].label : "-",
+                   opts.impls[k]->label, res->nthreads, res->avg, res->median,
+                   res->p99, "-", "-", "-", __PRINT_MATCH(res->ok));
+            continue;
+          }
+
+          printf("  %-24s %-16s %8d %16" PRIu64 " %16.1f %16.1f %10.3f %10.3f %10.3f %10s\n",
+                 cases[idx].label != NULL ? cases[idx].label : "-",
+                 opts.impls[k]->label, res->nthreads, res->avg, res->median,
+                 res->p99, res->gflops, res->gbps, res->speedup,
+                 __PRINT_MATCH(res->ok));
+        }
+      }
+    }
+    printf("\n");
+  }
+
+  free(results);
+  free(cases);
+
+  /* Let the workers go, then tear down the worker pool */
+  dist_close(&dist);
+  pool_destroy(&pool);
+
+  /* Close the performance counters */
+  if (opts.use_counters) {
+    for (int k = 0; k < nsel; k++) {
+      counters_destroy(&drv->cnt[k]);
+    }
+  }
+
+  if (opts.trace) {
+    for (int k = 0; k < nsel; k++) {
+      trace_destroy(&drv->trace[k]);
+    }
+  }
+
+  /* Finished with statistics */
+  driver_manifest_close(drv);
+  free(opts.cpus);
+  free(drv->runtimes);
+  free(drv->runtimes_mask);
+  free(drv);
+
+  /* Every result file is on disk before we exit */
+  int failed = out_finish();
+
+  /* Done */
+  return (failed > 0) ? 1 : 0;
+}
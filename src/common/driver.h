@@ -0,0 +1,208 @@
+/* driver.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the shared benchmark driver. Every benchmark's
+ * main.c describes itself with a driver_bench_t (its implementations,
+ * measurement defaults and a handful of hooks) and hands control to
+ * driver_main(). The driver owns everything that must be identical
+ * across kernels:
+ *
+ *   - common command-line options (-i, -n, -c, --nruns, ...)
+ *   - niceness, SCHED_FIFO and the placement of every thread on a CPU
+ *     (--affinity; common/affinity.h)
+ *   - page size, NUMA placement and prefaulting of the benchmark data
+ *     (common/alloc.h)
+ *   - the worker pool, its per-thread scratch arenas (common/arena.h)
+ *     and the optional performance counters
+ *   - the timed loop, the outlier-masking statistics and the CSV dump
+ *   - comparing several implementations (-i all, or -i naive,vec) on the
+ *     same resident data, interleaved in a random order per run
+ *   - thread-count scaling sweeps (--scale 1,2,4) on the same data
+ *   - the processes of a distributed run (--ranks, --connect;
+ *     common/dist.h), for benchmarks that support one
+ *   - GB/s and GFLOP/s from the declared bytes/ops of each case, and with
+ *     --roofline, against measured machine peaks (common/roofline.h)
+ *   - ns and cycles per element, when the case declares its elements
+ *   - loading the benchmark's tunables from the tune cache, and with
+ *     --autotune, searching them per case first (common/tune.h)
+ *   - the cache state each timed run starts from (--cache): warm (the
+ *     data left by the previous run), cold (flushed from every level, or
+ *     swept out where a case does not list its buffers, and rotating
+ *     through copies of the inputs) or llc (flushed from L1/L2 only)
+ *
+ * The benchmark owns its data: it parses its own options, allocates and
+ * generates inputs (and the reference output) for each case, verifies
+ * the result and frees everything again.
+*/
+
+#ifndef __COMMON_DRIVER_H_
+#define __COMMON_DRIVER_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "common/pool.h"
+#include "common/check.h"
+#include "common/tune.h"
+
+/* Most implementations one process can compare (-i all or a list) */
+#define DRIVER_MAX_IMPLS 16
+
+/* Most thread counts one --scale sweep can visit */
+#define DRIVER_MAX_SCALE 32
+
+/* Most buffers one case can list for --cache */
+#define DRIVER_MAX_BUFS  32
+
+/* Copies of the inputs a case may rotate through with --cache cold */
+#define DRIVER_CACHE_COPIES 4
+
+/* Cache state at the start of each timed run (--cache) */
+typedef enum {
+  DRIVER_CACHE_WARM = 0,
+  DRIVER_CACHE_COLD,
+  DRIVER_CACHE_LLC,
+  DRIVER_CACHE_NUM
+} driver_cache_t;
+
+/* Implementation entry point */
+typedef void* (*driver_impl_fn_t)(void* args);
+
+typedef struct {
+  const char*       name;    /* Name on the command line (-i name) */
+  const char*       label;   /* Name in reports and file names      */
+  driver_impl_fn_t  fn;      /* NULL if the options parse_arg took
+                              * leave no such implementation; "all"
+                              * skips it then */
+} driver_impl_t;
+
+/* Execution environment handed to the benchmark */
+typedef struct {
+  int             cpu;
+  int             nthreads;
+  pool_t*         pool;
+
+  driver_cache_t  cache;
+  int             copies;  /* Input copies to make for rotate (1 = none) */
+
+  /* The other processes of a distributed run (common/dist.h); one rank
+   * (nranks = 1) unless --ranks or --connect */
+  struct dist_t*  dist;
+} driver_env_t;
+
+/* Data of a case; copy is the input copy it belongs to, or -1 for data
+ * every copy uses (the outputs, say) */
+typedef struct {
+  const void* ptr;
+  size_t      bytes;
+  int         copy;
+} driver_buf_t;
+
+/* One problem instance (a dataset, a matrix shape, ...) */
+typedef struct {
+  void*       args;    /* Argument struct passed to the impl           */
+  const char* label;   /* Case label for reports; NULL for single case */
+  double      flops;   /* Arithmetic ops per invocation, or 0          */
+  double      bytes;   /* Compulsory bytes moved per invocation, or 0  */
+  double      elems;   /* Elements per invocation (ns/cycles per
+                        * element are reported), or 0               */
+  const char* unit;    /* Elements, plural ("matrices"); if set, the
+                        * element rate is reported too, or NULL     */
+  size_t      scratch; /* Scratch bytes each thread takes from its
+                        * arena (pool_arena()) per invocation, or 0 */
+
+  /* Optional, for --cache: the data an invocation touches, and how many
+   * input copies rotate can switch between (0 or 1 = none) */
+  driver_buf_t bufs[DRIVER_MAX_BUFS];
+  int          nbufs;
+  int          ncopies;
+} driver_case_t;
+
+/* List a buffer of a case (for setup) */
+static inline void driver_case_buf(driver_case_t* c, const void* ptr,
+                                   size_t bytes, int copy)
+{
+  if (ptr != NULL && c->nbufs < DRIVER_MAX_BUFS) {
+    c->bufs[c->nbufs].ptr   = ptr;
+    c->bufs[c->nbufs].bytes = bytes;
+    c->bufs[c->nbufs].copy  = copy;
+    c->nbufs++;
+  }
+}
+
+/* Verification outcome; err is optional (err.count = 0 prints nothing)
+ * and is filled by check_floats() for floating-point outputs */
+typedef struct {
+  bool          match;
+  bool          guard;
+  check_stats_t err;
+} driver_check_t;
+
+typedef struct {
+  const char*          name;
+  const driver_impl_t* impls;
+  int                  nimpls;
+
+  /* Defaults of the measurement loop */
+  int                  nruns;
+  int                  ninner;    /* Invocations per timed run      */
+  int                  nwarmup;   /* Untimed invocations per case   */
+
+  /* Optional runtime tunables; see common/tune.h */
+  const tune_param_t*  tunables;
+  int                  ntunables;
+
+  /* Benchmark state handed back to every hook */
+  void*                ctx;
+
+  /* parse_arg returns how many argv entries it consumed starting at i
+   * (0 if it does not know the option); usage prints the benchmark's
+   * own options. ncases is queried after parsing (NULL means 1). */
+  int            (*parse_arg)(void* ctx, int argc, char** argv, int i);
+  void           (*usage    )(void* ctx);
+  int            (*ncases   )(void* ctx);
+
+  /* Per case: allocate and generate data, fill in c. When several
+   * implementations are compared, reset clears the output before each of
+   * them is run once for verification. */
+  bool           (*setup    )(void* ctx, int idx, const driver_env_t* env,
+                              driver_case_t* c);
+  driver_check_t (*verify   )(void* ctx, int idx);
+  void           (*report   )(void* ctx, int idx);  /* Optional; after verify */
+  void           (*reset    )(void* ctx, int idx);  /* Optional */
+
+  /* Optional; called with on = true right before the timed runs of a
+   * case and with on = false right after them. What an implementation
+   * records of its own invocations should cover those in between, not
+   * the warm-up nor the verification. */
+  void           (*timed    )(void* ctx, int idx, bool on);
+  void           (*dump     )(void* ctx, int idx, FILE* fp);  /* Optional */
+
+  /* Optional; rewrites the thread count in the case's args so --scale can
+   * rerun the same resident data with fewer pool workers */
+  void           (*set_nthreads)(void* ctx, int idx, int nthreads);
+
+  /* Optional; points the case's args at input copy (0 .. ncopies - 1),
+   * before every timed run of --cache cold */
+  void           (*rotate   )(void* ctx, int idx, int copy);
+  void           (*teardown )(void* ctx, int idx);
+
+  /* Optional; a worker of a distributed run (--connect) calls this
+   * instead of any case: answer the messages of rank 0 on env->dist
+   * until it hangs up, and return 0 (or non-zero on an error). Without
+   * it, --ranks and --connect are refused. */
+  int            (*serve    )(void* ctx, const driver_env_t* env);
+} driver_bench_t;
+
+/* Parse the command line, run the chosen implementation on every case
+ * and report; returns the process exit code */
+int driver_main(const driver_bench_t* bench, int argc, char** argv);
+
+/* Reference (TSC) cycles per ns, from a 10 ms spin against the monotonic
+ * clock; 0 where there is no such counter */
+double driver_tsc_ghz(void);
+
+#endif //__COMMON_DRIVER_H_
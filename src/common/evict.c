@@ -0,0 +1,101 @@
+/* evict.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the cache state controls; see evict.h.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#if defined(__amd64__) || defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+/* Include common headers */
+#include "common/evict.h"
+
+/* Line size the flush and touch loops step by */
+static size_t evict_line(void)
+{
+#if defined(__aarch64__) || defined(__arm64__)
+  static size_t line;
+
+  if (line == 0) {
+    uint64_t ctr;
+
+    /* CTR_EL0.DminLine: log2 of the smallest data line, in words */
+    __asm__ volatile("mrs %0, ctr_el0" : "=r"(ctr));
+    line = (size_t)4 << ((ctr >> 16) & 0xf);
+  }
+
+  return line;
+#else
+  return 64;
+#endif
+}
+
+bool evict_can_flush(void)
+{
+#if defined(__amd64__) || defined(__x86_64__) || defined(__aarch64__) || defined(__arm64__)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void evict_flush(const void* p, size_t bytes)
+{
+  if (p == NULL || bytes == 0) return;
+
+  size_t         line = evict_line();
+  const uint8_t* s    = (const uint8_t*)((uintptr_t)p & ~(uintptr_t)(line - 1));
+  const uint8_t* e    = (const uint8_t*)p + bytes;
+
+#if defined(__amd64__) || defined(__x86_64__)
+  for (; s < e; s += line) _mm_clflush(s);
+  _mm_mfence();
+#elif defined(__aarch64__) || defined(__arm64__)
+  for (; s < e; s += line) __asm__ volatile("dc civac, %0" : : "r"(s) : "memory");
+  __asm__ volatile("dsb ish" : : : "memory");
+#else
+  (void)s; (void)e;
+#endif
+}
+
+void evict_touch(const void* p, size_t bytes)
+{
+  if (p == NULL || bytes == 0) return;
+
+  size_t                  line = evict_line();
+  const volatile uint8_t* s    = (const volatile uint8_t*)p;
+  uint8_t                 acc  = 0;
+
+  for (size_t i = 0; i < bytes; i += line) acc ^= s[i];
+  acc ^= s[bytes - 1];
+
+  (void)acc;
+}
+
+void evict_sweep(size_t bytes)
+{
+  static uint8_t* buf;
+  static size_t   size;
+
+  if (bytes > size) {
+    free(buf);
+    size = (bytes + 4095) & ~(size_t)4095;
+    buf  = (uint8_t*)aligned_alloc(4096, size);
+    if (buf == NULL) { size = 0; return; }
+    memset(buf, 0, size);
+  }
+
+  /* Dirty lines take the place of whatever was cached */
+  size_t            line = evict_line();
+  volatile uint8_t* s    = buf;
+
+  for (size_t i = 0; i < bytes; i += line) s[i]++;
+}
@@ -0,0 +1,33 @@
+/* evict.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the cache state controls behind the driver's
+ * --cache modes: writing lines back and dropping them from every level
+ * (clflush on x86, dc civac on AArch64), touching a buffer into the
+ * caches, and sweeping a private buffer through them, which evicts by
+ * capacity where lines cannot be flushed by address.
+*/
+
+#ifndef __COMMON_EVICT_H_
+#define __COMMON_EVICT_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Lines can be flushed by address on this machine */
+bool   evict_can_flush(void);
+
+/* Flush every line of [p, p + bytes) from all cache levels; a no-op
+ * unless evict_can_flush() */
+void   evict_flush    (const void* p, size_t bytes);
+
+/* Read every line of [p, p + bytes) */
+void   evict_touch    (const void* p, size_t bytes);
+
+/* Read and write bytes of a private buffer, displacing about as much
+ * cached data; the buffer is kept for the next sweep */
+void   evict_sweep    (size_t bytes);
+
+#endif //__COMMON_EVICT_H_
@@ -0,0 +1,92 @@
+/* mach_pthread_compatibility.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the Darwin pthreads compatibility layer; see
+ * mach_pthread_compatibility.h. Empty elsewhere.
+ */
+
+#if defined(__APPLE__)
+
+/* Standard C includes */
+#include <errno.h>
+#include <pthread.h>
+#include <pthread/qos.h>
+#include <sys/types.h>
+#include <sys/sysctl.h>
+
+/* Include common headers */
+#include "common/mach_pthread_compatibility.h"
+
+/* An integer sysctl, or def */
+static int mach_sysctl(const char* name, int def)
+{
+  int    v    = 0;
+  size_t size = sizeof(v);
+
+  if (sysctlbyname(name, &v, &size, NULL, 0) != 0 || v <= 0) return def;
+
+  return v;
+}
+
+int mach_cpu_count(int *nperf)
+{
+  int ncpus = mach_sysctl("hw.logicalcpu", 1);
+
+  /* perflevel0 is the fastest kind; absent on Intel Macs */
+  if (nperf != NULL) {
+    *nperf = mach_sysctl("hw.perflevel0.logicalcpu", ncpus);
+    if (*nperf > ncpus) *nperf = ncpus;
+  }
+
+  return ncpus;
+}
+
+int mach_cpu_smt(void)
+{
+  int logical  = mach_sysctl("hw.logicalcpu" , 1);
+  int physical = mach_sysctl("hw.physicalcpu", logical);
+
+  return (logical > physical) ? logical / physical : 1;
+}
+
+int pthread_setaffinity_np(pthread_t thread, size_t cpu_size,
+                           const cpu_set_t *cpu_set)
+{
+  int nperf = 0;
+  int ncpus = mach_cpu_count(&nperf);
+  int first = -1;
+  int count = 0;
+  int pcpus = 0;
+
+  for (int core = 0; core < CPU_SETSIZE && core < 8 * (int)cpu_size; core++) {
+    if (!CPU_ISSET(core, cpu_set)) continue;
+    if (first < 0) first = core;
+    if (core < nperf || core >= ncpus) pcpus++;
+    count++;
+  }
+
+  if (count == 0) return EINVAL;
+
+  /* Core kind, through the QoS class of the calling thread */
+  if (pthread_equal(thread, pthread_self())) {
+    qos_class_t qos = (pcpus > 0) ? QOS_CLASS_USER_INTERACTIVE
+                                  : QOS_CLASS_BACKGROUND;
+
+    if (pthread_set_qos_class_self_np(qos, 0) != 0) return EPERM;
+  }
+
+  /* Spreading over L2 domains, where tags are honored */
+  if (count == 1) {
+    thread_affinity_policy_data_t policy = { first + 1 };
+    thread_port_t mach_thread = pthread_mach_thread_np(thread);
+
+    thread_policy_set(mach_thread, THREAD_AFFINITY_POLICY,
+                      (thread_policy_t)&policy, THREAD_AFFINITY_POLICY_COUNT);
+  }
+
+  return 0;
+}
+
+#endif
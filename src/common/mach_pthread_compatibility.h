@@ -2,7 +2,7 @@
  *
  * Author: Khalid Al-Hawaj
  * Date  : 30 Dec. 2023
- * 
+ *
  * This file contains compatability layer for POSIX pthreads
  * with Darwin. So far, there is one function that requires
  * implementation:
@@ -12,8 +12,25 @@
  * There are multiple CPU SET functions and data type that
  * requires implementation and declarations:
  *
- *   datatype: cpu_set_t
- *   functions: CPU_ZERO, CPU_SET, CPU_ISSET
+ *   datatype: cpu_set_t (CPU_SETSIZE CPUs, one bit each)
+ *   functions: CPU_ZERO, CPU_SET, CPU_CLR, CPU_ISSET, CPU_COUNT
+ *
+ * Darwin does not let a thread be bound to a CPU, and does not number
+ * them either; the CPU numbers here are our own. CPUs 0 .. nperf - 1
+ * are the performance cores and the rest are the efficiency cores of
+ * Apple Silicon (hw.perflevel0/1), so the planner in common/affinity.h
+ * can tell them apart. pthread_setaffinity_np() turns a placement into
+ * what Darwin does offer:
+ *
+ *   - a QoS class for the calling thread: user-interactive, which is
+ *     scheduled on performance cores first, unless every CPU of the set
+ *     is an efficiency core, which takes background (the class that
+ *     keeps a thread on efficiency cores)
+ *   - an affinity tag (cpu + 1) for a single-CPU set, so that threads
+ *     on different CPUs are spread over L2 domains where the kernel
+ *     honors tags (Intel Macs; Apple Silicon ignores them)
+ *
+ * QoS can only be set by the thread itself; pool workers pin themselves.
 */
 
 #if defined(__APPLE__)
@@ -25,36 +42,58 @@
 #ifndef __COMMON_MACH_PTHREAD_COMPATIBILITY_H_
 #define __COMMON_MACH_PTHREAD_COMPATIBILITY_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 /* CPU SET */
+#define CPU_SETSIZE 1024
+
 typedef struct cpu_set {
-  uint32_t    count;
+  uint64_t    bits[CPU_SETSIZE / 64];
 } cpu_set_t;
 
 static inline void
-CPU_ZERO(cpu_set_t *cs) { cs->count = 0; }
+CPU_ZERO(cpu_set_t *cs)
+{
+  for (int i = 0; i < CPU_SETSIZE / 64; i++) cs->bits[i] = 0;
+}
+
+static inline void
+CPU_SET(int num, cpu_set_t *cs)
+{
+  if (num >= 0 && num < CPU_SETSIZE) cs->bits[num / 64] |= (uint64_t)1 << (num % 64);
+}
 
 static inline void
-CPU_SET(int num, cpu_set_t *cs) { cs->count |= (1 << num); }
+CPU_CLR(int num, cpu_set_t *cs)
+{
+  if (num >= 0 && num < CPU_SETSIZE) cs->bits[num / 64] &= ~((uint64_t)1 << (num % 64));
+}
 
 static inline int
-CPU_ISSET(int num, cpu_set_t *cs) { return (cs->count & (1 << num)); }
+CPU_ISSET(int num, const cpu_set_t *cs)
+{
+  if (num < 0 || num >= CPU_SETSIZE) return 0;
+  return (cs->bits[num / 64] >> (num % 64)) & 1;
+}
 
-/* pthreads functions */
-int pthread_setaffinity_np(pthread_t thread, size_t cpu_size,
-                           cpu_set_t *cpu_set)
+static inline int
+CPU_COUNT(const cpu_set_t *cs)
 {
-  thread_port_t mach_thread;
-  int core = 0;
-
-  for (core = 0; core < 8 * cpu_size; core++) {
-    if (CPU_ISSET(core, cpu_set)) break;
-  }
-  //printf("binding to core %d\n", core);
-  thread_affinity_policy_data_t policy = { core };
-  mach_thread = pthread_mach_thread_np(thread);
-  thread_policy_set(mach_thread, THREAD_AFFINITY_POLICY,
-                    (thread_policy_t)&policy, 1);
-  return 0;
+  int n = 0;
+  for (int i = 0; i < CPU_SETSIZE / 64; i++) n += __builtin_popcountll(cs->bits[i]);
+  return n;
 }
 
+/* Logical CPUs, and how many of them are performance cores (all of
+ * them where the machine has a single kind) */
+int mach_cpu_count(int *nperf);
+
+/* SMT threads per core */
+int mach_cpu_smt(void);
+
+/* pthreads functions */
+int pthread_setaffinity_np(pthread_t thread, size_t cpu_size,
+                           const cpu_set_t *cpu_set);
+
 #endif //__COMMON_MACH_PTHREAD_COMPATIBILITY_H_
@@ -9,6 +9,8 @@
 #ifndef __COMMON_MACROS_H_
 #define __COMMON_MACROS_H_
 
+#include "common/alloc.h"
+
 /* General */
 #define __COMPILER_FENCE_ __asm__ __volatile__ ("" : : : "memory");
 
@@ -16,10 +18,12 @@
 #define __PRINT_MATCH(x) (x ? "MATCHING" : "MISMATCH")
 
 /* Testing and Statistics Macros */
-#ifndef __APPLE__
+/*   -> Benchmark data comes from common/alloc.h, which applies the page
+ *      size, NUMA and prefault policy; sizes are 64-bit. Release it with
+ *      __FREE_DATA, not free(). */
 #define __ALLOC_DATA(type, nelems) ({                  \
-  unsigned int nbytes = (nelems) * sizeof(type);       \
-  type* temp = (type*)aligned_alloc(512 / 8, nbytes);  \
+  size_t nbytes = (size_t)(nelems) * sizeof(type);     \
+  type* temp = (type*)mem_alloc(nbytes);               \
                                                        \
   if (temp == NULL) {                                  \
     printf("\n");                                      \
@@ -31,64 +35,18 @@
                                                        \
   temp;                                                \
 })
-#else
-#define __ALLOC_DATA(type, nelems) ({                  \
-  unsigned int nbytes = (nelems) * sizeof(type);       \
-  nbytes = ((nbytes + 63) / 64) * 64;                  \
-  type* temp = (type*)aligned_alloc(512 / 8, nbytes);  \
-                                                       \
-  if (temp == NULL) {                                  \
-    printf("\n");                                      \
-    printf("  ERROR: Cannot allocate memory!");        \
-    printf("\n");                                      \
-    printf("\n");                                      \
-    exit(-2);                                          \
-  }                                                    \
-                                                       \
-  temp;                                                \
-})
-#endif
 
-#ifndef __APPLE__
 #define __ALLOC_INIT_DATA(type, nelems) ({             \
-  unsigned int nbytes = (nelems) * sizeof(type);       \
-  type* temp = (type*)aligned_alloc(512 / 8, nbytes);  \
-                                                       \
-  if (temp == NULL) {                                  \
-    printf("\n");                                      \
-    printf("  ERROR: Cannot allocate memory!");        \
-    printf("\n");                                      \
-    printf("\n");                                      \
-    exit(-2);                                          \
-  }                                                    \
+  type* temp = __ALLOC_DATA(type, nelems);             \
                                                        \
   /* Generate data */                                  \
-  for(int i = 0; i < nelems; i++) {                    \
+  for(size_t i = 0; i < (size_t)(nelems); i++) {       \
     temp[i] = rand() % (0x1llu << (sizeof(type) * 8)); \
   }                                                    \
   temp;                                                \
 })
-#else
-#define __ALLOC_INIT_DATA(type, nelems) ({             \
-  unsigned int nbytes = (nelems) * sizeof(type);       \
-  nbytes = ((nbytes + 63) / 64) * 64;                  \
-  type* temp = (type*)aligned_alloc(512 / 8, nbytes);  \
-                                                       \
-  if (temp == NULL) {                                  \
-    printf("\n");                                      \
-    printf("  ERROR: Cannot allocate memory!");        \
-    printf("\n");                                      \
-    printf("\n");                                      \
-    exit(-2);                                          \
-  }                                                    \
-                                                       \
-  /* Generate data */                                  \
-  for(int i = 0; i < nelems; i++) {                    \
-    temp[i] = rand() % (0x1llu << (sizeof(type) * 8)); \
-  }                                                    \
-  temp;                                                \
-})
-#endif
+
+#define __FREE_DATA(ptr) mem_free(ptr)
 
 #define __SET_GUARD(array, sz) {                       \
   ((byte*)array)[sz + 0] = 0xfe;                       \
@@ -100,7 +58,7 @@
 #define __CHECK_MATCH(ref, array, sz) ({               \
   bool __tmp = true;                                   \
                                                        \
-  for(int i = 0; (i < sz) && __tmp; i++) {             \
+  for(size_t i = 0; i < (size_t)(sz) && __tmp; i++) {  \
     __tmp = __tmp && (ref[i] == array[i]);             \
   }                                                    \
                                                        \
@@ -110,7 +68,7 @@
 #define __CHECK_FLOAT_MATCH(ref, array, sz, delta) ({  \
   bool __tmp = true;                                   \
                                                        \
-  for(int i = 0; (i < sz) && __tmp; i++) {             \
+  for(size_t i = 0; i < (size_t)(sz) && __tmp; i++) {  \
     __tmp = __tmp && (fabs(ref[i] - array[i]) < delta);\
   }                                                    \
                                                        \
@@ -128,11 +86,13 @@
   match;                                               \
 })
 
-#define __DECLARE_STATS(_num_runs, _num_stdev)         \
-  /* Time keeping */                                   \
+/* Time keeping of __SET_START_TIME and __SET_END_TIME; declared on its
+ * own, so a caller that only gathers statistics leaves no unused pair */
+#define __DECLARE_TIME()                               \
   struct timespec ts;                                  \
-  struct timespec te;                                  \
-                                                       \
+  struct timespec te;
+
+#define __DECLARE_STATS(_num_runs, _num_stdev)         \
   /* Iterate and average runtimes */                   \
   uint32_t num_runs = _num_runs;                       \
   uint64_t* runtimes;                                  \
@@ -0,0 +1,186 @@
+/* manifest.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the run manifest; see manifest.h.
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+
+/* Include common headers */
+#include "common/cpu.h"
+#include "common/tune.h"
+#include "common/output.h"
+#include "common/manifest.h"
+
+/* Generated by the Makefile */
+#include "build_info.h"
+
+void manifest_str(FILE* fp, const char* s)
+{
+  fputc('"', fp);
+
+  for (; s != NULL && *s != '\0'; s++) {
+    unsigned char ch = (unsigned char)*s;
+
+    if      (ch == '"' ) fputs("\\\"", fp);
+    else if (ch == '\\') fputs("\\\\", fp);
+    else if (ch == '\n') fputs("\\n" , fp);
+    else if (ch == '\t') fputs("\\t" , fp);
+    else if (ch <  0x20) fprintf(fp, "\\u%04x", ch);
+    else                 fputc(ch, fp);
+  }
+
+  fputc('"', fp);
+}
+
+/* First line of a sysfs file, or NULL if there is none */
+static const char* manifest_sysfs(char* buf, size_t size, const char* fmt, int cpu)
+{
+  char  path[128];
+  FILE* fp;
+
+  snprintf(path, sizeof(path), fmt, cpu);
+  fp = fopen(path, "r");
+  if (fp == NULL) return NULL;
+
+  bool ok = fgets(buf, size, fp) != NULL;
+  fclose(fp);
+  if (!ok) return NULL;
+
+  buf[strcspn(buf, "\n")] = '\0';
+
+  return buf;
+}
+
+/* A sysfs frequency (kHz) as MHz, or null */
+static void manifest_freq(FILE* fp, const char* name, const char* file, int cpu)
+{
+  char        path[128];
+  char        buf[64];
+  const char* v;
+
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%%d/cpufreq/%s", file);
+  v = manifest_sysfs(buf, sizeof(buf), path, cpu);
+
+  fprintf(fp, "\"%s\": ", name);
+  if (v != NULL) fprintf(fp, "%.1f", atof(v) / 1e3);
+  else           fprintf(fp, "null");
+}
+
+void manifest_build(FILE* fp)
+{
+  fprintf(fp, "\"build\": {");
+  fprintf(fp, "\"git_rev\": ");  manifest_str(fp, BUILD_GIT_REV);  fprintf(fp, ", ");
+#if defined(__clang__)
+  fprintf(fp, "\"compiler\": "); manifest_str(fp, "clang " __clang_version__); fprintf(fp, ", ");
+#else
+  fprintf(fp, "\"compiler\": "); manifest_str(fp, "gcc " __VERSION__);         fprintf(fp, ", ");
+#endif
+  fprintf(fp, "\"cflags\": ");   manifest_str(fp, BUILD_CFLAGS);   fprintf(fp, ", ");
+  fprintf(fp, "\"ldflags\": ");  manifest_str(fp, BUILD_LDFLAGS);  fprintf(fp, ", ");
+  fprintf(fp, "\"profile\": ");  manifest_str(fp, BUILD_PROFILE);
+  fprintf(fp, "}");
+}
+
+void manifest_machine(FILE* fp, int cpu)
+{
+  struct utsname uts;
+  char           buf[128];
+  const char*    governor;
+
+  if (uname(&uts) != 0) memset(&uts, 0, sizeof(uts));
+
+  governor = manifest_sysfs(buf, sizeof(buf),
+                            "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", cpu);
+
+  fprintf(fp, "\"machine\": {");
+  fprintf(fp, "\"key\": ");      manifest_str(fp, tune_machine()); fprintf(fp, ", ");
+  fprintf(fp, "\"model\": ");    manifest_str(fp, cpu_model());    fprintf(fp, ", ");
+  fprintf(fp, "\"hostname\": "); manifest_str(fp, uts.nodename);   fprintf(fp, ", ");
+  fprintf(fp, "\"kernel\": ");   manifest_str(fp, uts.release);    fprintf(fp, ", ");
+  fprintf(fp, "\"arch\": ");     manifest_str(fp, uts.machine);    fprintf(fp, ", ");
+  fprintf(fp, "\"ncpus\": %ld, ", sysconf(_SC_NPROCESSORS_ONLN));
+  fprintf(fp, "\"l1d_kib\": %zu, ", cpu_cache_bytes(1) >> 10);
+  fprintf(fp, "\"l2_kib\": %zu, " , cpu_cache_bytes(2) >> 10);
+  fprintf(fp, "\"l3_kib\": %zu, " , cpu_cache_bytes(3) >> 10);
+  fprintf(fp, "\"isa_best\": ");   manifest_str(fp, cpu_isa_name(cpu_best_isa()));   fprintf(fp, ", ");
+  fprintf(fp, "\"isa_active\": "); manifest_str(fp, cpu_isa_name(cpu_active_isa())); fprintf(fp, ", ");
+  fprintf(fp, "\"governor\": ");
+  if (governor != NULL) manifest_str(fp, governor);
+  else                  fprintf(fp, "null");
+  fprintf(fp, ", ");
+  manifest_freq(fp, "freq_cur_mhz", "scaling_cur_freq", cpu); fprintf(fp, ", ");
+  manifest_freq(fp, "freq_min_mhz", "scaling_min_freq", cpu); fprintf(fp, ", ");
+  manifest_freq(fp, "freq_max_mhz", "scaling_max_freq", cpu);
+  fprintf(fp, "}");
+}
+
+void manifest_date(FILE* fp)
+{
+  char      buf[32];
+  time_t    now = time(NULL);
+  struct tm tm;
+
+  gmtime_r(&now, &tm);
+  strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%SZ", &tm);
+
+  manifest_str(fp, buf);
+}
+
+void manifest_kv(FILE* fp, const char* lines, size_t len)
+{
+  char* copy = (char*)malloc(len + 1);
+  bool  first = true;
+
+  memcpy(copy, lines, len);
+  copy[len] = '\0';
+
+  fprintf(fp, "{");
+
+  for (char* line = strtok(copy, "\n"); line != NULL; line = strtok(NULL, "\n")) {
+    char* comma = strchr(line, ',');
+    if (comma == NULL) continue;
+    *comma = '\0';
+
+    const char* value = comma + 1;
+    char*       end   = NULL;
+
+    while (*value == ' ') value++;
+    strtod(value, &end);
+
+    /* strtod also takes what JSON does not ("nan", "0x1p3") */
+    bool number = *value != '\0' && end != NULL && *end == '\0' &&
+                  value[strspn(value, "0123456789+-.eE")] == '\0';
+
+    fprintf(fp, "%s", first ? "" : ", ");
+    manifest_str(fp, line);
+    fprintf(fp, ": ");
+    if (number) fprintf(fp, "%s", value);
+    else        manifest_str(fp, value);
+
+    first = false;
+  }
+
+  fprintf(fp, "}");
+
+  free(copy);
+}
+
+void manifest_u64s(FILE* fp, const uint64_t* v, size_t n)
+{
+  fprintf(fp, "[");
+  if (n > 0) {
+    out_put_u64s(fp, "", v, 1, 1);
+    out_put_u64s(fp, ", ", v + 1, n - 1, 1);
+  }
+  fprintf(fp, "]");
+}
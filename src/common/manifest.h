@@ -0,0 +1,49 @@
+/* manifest.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the pieces of the run manifest, a JSON file the
+ * driver writes next to the results of every run (<bench>_manifest.json):
+ *
+ *   {"schema": 1, "bench": ..., "command": [...], "date": ...,
+ *    "build":   {git revision, compiler, flags, profile},
+ *    "machine": {processor, caches, governor, frequencies, ...},
+ *    "config":  {threads, runs, ISA, memory policy, ...},
+ *    "results": [{impl, case, threads, dataset, verified, statistics,
+ *                 "runtimes": [every run, in ns]}, ...]}
+ *
+ * so that two runs can be checked for being comparable before they are
+ * compared (see tools/compare.c). The build fields come from
+ * build_info.h, which the Makefile regenerates when they change.
+*/
+
+#ifndef __COMMON_MANIFEST_H_
+#define __COMMON_MANIFEST_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/* Version of the layout above */
+#define MANIFEST_SCHEMA 1
+
+/* s as a JSON string, quoted and escaped */
+void manifest_str     (FILE* fp, const char* s);
+
+/* The "build" and "machine" members, without a separator; cpu is the
+ * main CPU, whose frequency governor is recorded */
+void manifest_build   (FILE* fp);
+void manifest_machine (FILE* fp, int cpu);
+
+/* The current time in UTC, ISO 8601 */
+void manifest_date    (FILE* fp);
+
+/* An object from "key,value" lines (the header of a runtimes file);
+ * values that are numbers stay numbers */
+void manifest_kv      (FILE* fp, const char* lines, size_t len);
+
+/* An array of n values */
+void manifest_u64s    (FILE* fp, const uint64_t* v, size_t n);
+
+#endif //__COMMON_MANIFEST_H_
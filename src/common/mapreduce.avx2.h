@@ -0,0 +1,211 @@
+/* mapreduce.avx2.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX2 generators of common/mapreduce.h; include from a .avx2.c file.
+ * The vector functors take and return MR_V256(E) (__m256i or __m256).
+ * Full vectors go through the main loop (reductions keep four vector
+ * partials); the tail is a single iteration under a lane mask, with the
+ * masked-off lanes of a reduction set to the identity.
+*/
+
+#ifndef __COMMON_MAPREDUCE_AVX2_H_
+#define __COMMON_MAPREDUCE_AVX2_H_
+
+#if defined(__amd64__) || defined(__x86_64__)
+
+#include <immintrin.h>
+
+#include "common/mapreduce.h"
+
+/* Vector type and memory operations per element type */
+#define MR_V256_i32 __m256i
+#define MR_V256_u32 __m256i
+#define MR_V256_f32 __m256
+#define MR_V256(E)  MR_CAT(MR_V256_, E)
+
+#define MR_LOADU256_i32(p)        _mm256_loadu_si256((const __m256i*)(p))
+#define MR_LOADU256_u32(p)        _mm256_loadu_si256((const __m256i*)(p))
+#define MR_LOADU256_f32(p)        _mm256_loadu_ps(p)
+#define MR_LOADU256(E, p)         MR_CAT(MR_LOADU256_, E)(p)
+
+#define MR_STOREU256_i32(p, v)    _mm256_storeu_si256((__m256i*)(p), v)
+#define MR_STOREU256_u32(p, v)    _mm256_storeu_si256((__m256i*)(p), v)
+#define MR_STOREU256_f32(p, v)    _mm256_storeu_ps(p, v)
+#define MR_STOREU256(E, p, v)     MR_CAT(MR_STOREU256_, E)(p, v)
+
+#define MR_MASKLOAD256_i32(p, m)  _mm256_maskload_epi32((const int*)(p), m)
+#define MR_MASKLOAD256_u32(p, m)  _mm256_maskload_epi32((const int*)(p), m)
+#define MR_MASKLOAD256_f32(p, m)  _mm256_maskload_ps(p, m)
+#define MR_MASKLOAD256(E, p, m)   MR_CAT(MR_MASKLOAD256_, E)(p, m)
+
+#define MR_MASKSTORE256_i32(p, m, v) _mm256_maskstore_epi32((int*)(p), m, v)
+#define MR_MASKSTORE256_u32(p, m, v) _mm256_maskstore_epi32((int*)(p), m, v)
+#define MR_MASKSTORE256_f32(p, m, v) _mm256_maskstore_ps(p, m, v)
+#define MR_MASKSTORE256(E, p, m, v)  MR_CAT(MR_MASKSTORE256_, E)(p, m, v)
+
+#define MR_SET1256_i32(x)         _mm256_set1_epi32((int)(x))
+#define MR_SET1256_u32(x)         _mm256_set1_epi32((int)(x))
+#define MR_SET1256_f32(x)         _mm256_set1_ps(x)
+#define MR_SET1256(E, x)          MR_CAT(MR_SET1256_, E)(x)
+
+/* Lanes of m take b, the others a */
+#define MR_BLEND256_i32(a, b, m)  _mm256_blendv_epi8(a, b, m)
+#define MR_BLEND256_u32(a, b, m)  _mm256_blendv_epi8(a, b, m)
+#define MR_BLEND256_f32(a, b, m)  _mm256_blendv_ps(a, b, _mm256_castsi256_ps(m))
+#define MR_BLEND256(E, a, b, m)   MR_CAT(MR_BLEND256_, E)(a, b, m)
+
+/* Mask of the first n (< 8) lanes */
+static inline __m256i mr_tail_mask256(size_t n)
+{
+  return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)n),
+                            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+#define MR_MAP_AVX2(fn, E, F_V)                             \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in  = (const MR_CTYPE(E)*)a->input;  \
+          MR_CTYPE(E)* out = (      MR_CTYPE(E)*)a->output; \
+    const size_t       n   = a->size;                       \
+    const size_t       vl  = 32 / sizeof(MR_CTYPE(E));      \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + vl <= n; i += vl) {                          \
+      MR_STOREU256(E, &out[i], F_V(MR_LOADU256(E, &in[i])));\
+    }                                                       \
+                                                            \
+    if (i < n) {                                            \
+      __m256i m = mr_tail_mask256(n - i);                   \
+      MR_MASKSTORE256(E, &out[i], m,                        \
+                      F_V(MR_MASKLOAD256(E, &in[i], m)));   \
+    }                                                       \
+                                                            \
+    return NULL;                                            \
+  }
+
+#define MR_MAP2_AVX2(fn, E, F_V)                            \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in0 = (const MR_CTYPE(E)*)a->input;  \
+    const MR_CTYPE(E)* in1 = (const MR_CTYPE(E)*)a->input1; \
+          MR_CTYPE(E)* out = (      MR_CTYPE(E)*)a->output; \
+    const size_t       n   = a->size;                       \
+    const size_t       vl  = 32 / sizeof(MR_CTYPE(E));      \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + vl <= n; i += vl) {                          \
+      MR_STOREU256(E, &out[i], F_V(MR_LOADU256(E, &in0[i]), \
+                                   MR_LOADU256(E, &in1[i])));\
+    }                                                       \
+                                                            \
+    if (i < n) {                                            \
+      __m256i m = mr_tail_mask256(n - i);                   \
+      MR_MASKSTORE256(E, &out[i], m,                        \
+                      F_V(MR_MASKLOAD256(E, &in0[i], m),    \
+                          MR_MASKLOAD256(E, &in1[i], m)));  \
+    }                                                       \
+                                                            \
+    return NULL;                                            \
+  }
+
+/* R combines the lanes of the final partial */
+#define MR_REDUCE_AVX2(fn, E, G_V, R_V, R, ID)              \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in  = (const MR_CTYPE(E)*)a->input;  \
+    const size_t       n   = a->size;                       \
+    const size_t       vl  = 32 / sizeof(MR_CTYPE(E));      \
+                                                            \
+    const MR_V256(E) id = MR_SET1256(E, ID);                \
+    MR_V256(E) acc0 = id, acc1 = id, acc2 = id, acc3 = id;  \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 4 * vl <= n; i += 4 * vl) {                  \
+      acc0 = R_V(acc0, G_V(MR_LOADU256(E, &in[i + 0 * vl])));\
+      acc1 = R_V(acc1, G_V(MR_LOADU256(E, &in[i + 1 * vl])));\
+      acc2 = R_V(acc2, G_V(MR_LOADU256(E, &in[i + 2 * vl])));\
+      acc3 = R_V(acc3, G_V(MR_LOADU256(E, &in[i + 3 * vl])));\
+    }                                                       \
+    for (; i + vl <= n; i += vl) {                          \
+      acc0 = R_V(acc0, G_V(MR_LOADU256(E, &in[i])));        \
+    }                                                       \
+                                                            \
+    if (i < n) {                                            \
+      __m256i    m = mr_tail_mask256(n - i);                \
+      MR_V256(E) g = G_V(MR_MASKLOAD256(E, &in[i], m));     \
+      acc1 = R_V(acc1, MR_BLEND256(E, id, g, m));           \
+    }                                                       \
+                                                            \
+    MR_V256(E) acc = R_V(R_V(acc0, acc1), R_V(acc2, acc3)); \
+                                                            \
+    MR_CTYPE(E) lanes[8];                                   \
+    MR_STOREU256(E, lanes, acc);                            \
+                                                            \
+    MR_CTYPE(E) r = lanes[0];                               \
+    for (size_t l = 1; l < vl; l++) r = R(r, lanes[l]);     \
+                                                            \
+    *(MR_CTYPE(E)*)a->output = r;                           \
+                                                            \
+    return NULL;                                            \
+  }
+
+#define MR_REDUCE2_AVX2(fn, E, G_V, R_V, R, ID)             \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in0 = (const MR_CTYPE(E)*)a->input;  \
+    const MR_CTYPE(E)* in1 = (const MR_CTYPE(E)*)a->input1; \
+    const size_t       n   = a->size;                       \
+    const size_t       vl  = 32 / sizeof(MR_CTYPE(E));      \
+                                                            \
+    const MR_V256(E) id = MR_SET1256(E, ID);                \
+    MR_V256(E) acc0 = id, acc1 = id, acc2 = id, acc3 = id;  \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 4 * vl <= n; i += 4 * vl) {                  \
+      acc0 = R_V(acc0, G_V(MR_LOADU256(E, &in0[i + 0 * vl]),\
+                           MR_LOADU256(E, &in1[i + 0 * vl])));\
+      acc1 = R_V(acc1, G_V(MR_LOADU256(E, &in0[i + 1 * vl]),\
+                           MR_LOADU256(E, &in1[i + 1 * vl])));\
+      acc2 = R_V(acc2, G_V(MR_LOADU256(E, &in0[i + 2 * vl]),\
+                           MR_LOADU256(E, &in1[i + 2 * vl])));\
+      acc3 = R_V(acc3, G_V(MR_LOADU256(E, &in0[i + 3 * vl]),\
+                           MR_LOADU256(E, &in1[i + 3 * vl])));\
+    }                                                       \
+    for (; i + vl <= n; i += vl) {                          \
+      acc0 = R_V(acc0, G_V(MR_LOADU256(E, &in0[i]),         \
+                           MR_LOADU256(E, &in1[i])));       \
+    }                                                       \
+                                                            \
+    if (i < n) {                                            \
+      __m256i    m = mr_tail_mask256(n - i);                \
+      MR_V256(E) g = G_V(MR_MASKLOAD256(E, &in0[i], m),     \
+                         MR_MASKLOAD256(E, &in1[i], m));    \
+      acc1 = R_V(acc1, MR_BLEND256(E, id, g, m));           \
+    }                                                       \
+                                                            \
+    MR_V256(E) acc = R_V(R_V(acc0, acc1), R_V(acc2, acc3)); \
+                                                            \
+    MR_CTYPE(E) lanes[8];                                   \
+    MR_STOREU256(E, lanes, acc);                            \
+                                                            \
+    MR_CTYPE(E) r = lanes[0];                               \
+    for (size_t l = 1; l < vl; l++) r = R(r, lanes[l]);     \
+                                                            \
+    *(MR_CTYPE(E)*)a->output = r;                           \
+                                                            \
+    return NULL;                                            \
+  }
+
+#endif
+
+#endif //__COMMON_MAPREDUCE_AVX2_H_
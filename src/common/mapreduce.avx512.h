@@ -0,0 +1,210 @@
+/* mapreduce.avx512.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX-512 generators of common/mapreduce.h; include from a .avx512.c
+ * file. The vector functors take and return MR_V512(E) (__m512i or
+ * __m512). As with AVX2, reductions keep four vector partials and the
+ * tail is one masked iteration, its masked-off lanes reset to the
+ * identity after G.
+*/
+
+#ifndef __COMMON_MAPREDUCE_AVX512_H_
+#define __COMMON_MAPREDUCE_AVX512_H_
+
+#if defined(__amd64__) || defined(__x86_64__)
+
+#include <immintrin.h>
+
+#include "common/mapreduce.h"
+
+/* Vector type and memory operations per element type */
+#define MR_V512_i32 __m512i
+#define MR_V512_u32 __m512i
+#define MR_V512_f32 __m512
+#define MR_V512(E)  MR_CAT(MR_V512_, E)
+
+#define MR_LOADU512_i32(p)        _mm512_loadu_si512(p)
+#define MR_LOADU512_u32(p)        _mm512_loadu_si512(p)
+#define MR_LOADU512_f32(p)        _mm512_loadu_ps(p)
+#define MR_LOADU512(E, p)         MR_CAT(MR_LOADU512_, E)(p)
+
+#define MR_STOREU512_i32(p, v)    _mm512_storeu_si512(p, v)
+#define MR_STOREU512_u32(p, v)    _mm512_storeu_si512(p, v)
+#define MR_STOREU512_f32(p, v)    _mm512_storeu_ps(p, v)
+#define MR_STOREU512(E, p, v)     MR_CAT(MR_STOREU512_, E)(p, v)
+
+/* Lanes outside m come from src */
+#define MR_MASKLOAD512_i32(src, m, p) _mm512_mask_loadu_epi32(src, m, p)
+#define MR_MASKLOAD512_u32(src, m, p) _mm512_mask_loadu_epi32(src, m, p)
+#define MR_MASKLOAD512_f32(src, m, p) _mm512_mask_loadu_ps(src, m, p)
+#define MR_MASKLOAD512(E, src, m, p)  MR_CAT(MR_MASKLOAD512_, E)(src, m, p)
+
+#define MR_MASKSTORE512_i32(p, m, v) _mm512_mask_storeu_epi32(p, m, v)
+#define MR_MASKSTORE512_u32(p, m, v) _mm512_mask_storeu_epi32(p, m, v)
+#define MR_MASKSTORE512_f32(p, m, v) _mm512_mask_storeu_ps(p, m, v)
+#define MR_MASKSTORE512(E, p, m, v)  MR_CAT(MR_MASKSTORE512_, E)(p, m, v)
+
+#define MR_SET1512_i32(x)         _mm512_set1_epi32((int)(x))
+#define MR_SET1512_u32(x)         _mm512_set1_epi32((int)(x))
+#define MR_SET1512_f32(x)         _mm512_set1_ps(x)
+#define MR_SET1512(E, x)          MR_CAT(MR_SET1512_, E)(x)
+
+#define MR_MASKMOV512_i32(a, m, b) _mm512_mask_mov_epi32(a, m, b)
+#define MR_MASKMOV512_u32(a, m, b) _mm512_mask_mov_epi32(a, m, b)
+#define MR_MASKMOV512_f32(a, m, b) _mm512_mask_mov_ps(a, m, b)
+#define MR_MASKMOV512(E, a, m, b)  MR_CAT(MR_MASKMOV512_, E)(a, m, b)
+
+/* Mask of the first n (< 16) lanes */
+#define MR_TAIL_MASK512(n) ((__mmask16)((1u << (n)) - 1))
+
+#define MR_MAP_AVX512(fn, E, F_V)                           \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in  = (const MR_CTYPE(E)*)a->input;  \
+          MR_CTYPE(E)* out = (      MR_CTYPE(E)*)a->output; \
+    const size_t       n   = a->size;                       \
+    const size_t       vl  = 64 / sizeof(MR_CTYPE(E));      \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + vl <= n; i += vl) {                          \
+      MR_STOREU512(E, &out[i], F_V(MR_LOADU512(E, &in[i])));\
+    }                                                       \
+                                                            \
+    if (i < n) {                                            \
+      __mmask16 m = MR_TAIL_MASK512(n - i);                 \
+      MR_MASKSTORE512(E, &out[i], m,                        \
+                      F_V(MR_MASKLOAD512(E, MR_SET1512(E, 0),\
+                                         m, &in[i])));      \
+    }                                                       \
+                                                            \
+    return NULL;                                            \
+  }
+
+#define MR_MAP2_AVX512(fn, E, F_V)                          \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in0 = (const MR_CTYPE(E)*)a->input;  \
+    const MR_CTYPE(E)* in1 = (const MR_CTYPE(E)*)a->input1; \
+          MR_CTYPE(E)* out = (      MR_CTYPE(E)*)a->output; \
+    const size_t       n   = a->size;                       \
+    const size_t       vl  = 64 / sizeof(MR_CTYPE(E));      \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + vl <= n; i += vl) {                          \
+      MR_STOREU512(E, &out[i], F_V(MR_LOADU512(E, &in0[i]), \
+                                   MR_LOADU512(E, &in1[i])));\
+    }                                                       \
+                                                            \
+    if (i < n) {                                            \
+      __mmask16  m = MR_TAIL_MASK512(n - i);                \
+      MR_V512(E) z = MR_SET1512(E, 0);                      \
+      MR_MASKSTORE512(E, &out[i], m,                        \
+                      F_V(MR_MASKLOAD512(E, z, m, &in0[i]), \
+                          MR_MASKLOAD512(E, z, m, &in1[i])));\
+    }                                                       \
+                                                            \
+    return NULL;                                            \
+  }
+
+/* R combines the lanes of the final partial */
+#define MR_REDUCE_AVX512(fn, E, G_V, R_V, R, ID)            \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in  = (const MR_CTYPE(E)*)a->input;  \
+    const size_t       n   = a->size;                       \
+    const size_t       vl  = 64 / sizeof(MR_CTYPE(E));      \
+                                                            \
+    const MR_V512(E) id = MR_SET1512(E, ID);                \
+    MR_V512(E) acc0 = id, acc1 = id, acc2 = id, acc3 = id;  \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 4 * vl <= n; i += 4 * vl) {                  \
+      acc0 = R_V(acc0, G_V(MR_LOADU512(E, &in[i + 0 * vl])));\
+      acc1 = R_V(acc1, G_V(MR_LOADU512(E, &in[i + 1 * vl])));\
+      acc2 = R_V(acc2, G_V(MR_LOADU512(E, &in[i + 2 * vl])));\
+      acc3 = R_V(acc3, G_V(MR_LOADU512(E, &in[i + 3 * vl])));\
+    }                                                       \
+    for (; i + vl <= n; i += vl) {                          \
+      acc0 = R_V(acc0, G_V(MR_LOADU512(E, &in[i])));        \
+    }                                                       \
+                                                            \
+    if (i < n) {                                            \
+      __mmask16  m = MR_TAIL_MASK512(n - i);                \
+      MR_V512(E) g = G_V(MR_MASKLOAD512(E, id, m, &in[i])); \
+      acc1 = R_V(acc1, MR_MASKMOV512(E, id, m, g));         \
+    }                                                       \
+                                                            \
+    MR_V512(E) acc = R_V(R_V(acc0, acc1), R_V(acc2, acc3)); \
+                                                            \
+    MR_CTYPE(E) lanes[16];                                  \
+    MR_STOREU512(E, lanes, acc);                            \
+                                                            \
+    MR_CTYPE(E) r = lanes[0];                               \
+    for (size_t l = 1; l < vl; l++) r = R(r, lanes[l]);     \
+                                                            \
+    *(MR_CTYPE(E)*)a->output = r;                           \
+                                                            \
+    return NULL;                                            \
+  }
+
+#define MR_REDUCE2_AVX512(fn, E, G_V, R_V, R, ID)           \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in0 = (const MR_CTYPE(E)*)a->input;  \
+    const MR_CTYPE(E)* in1 = (const MR_CTYPE(E)*)a->input1; \
+    const size_t       n   = a->size;                       \
+    const size_t       vl  = 64 / sizeof(MR_CTYPE(E));      \
+                                                            \
+    const MR_V512(E) id = MR_SET1512(E, ID);                \
+    MR_V512(E) acc0 = id, acc1 = id, acc2 = id, acc3 = id;  \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 4 * vl <= n; i += 4 * vl) {                  \
+      acc0 = R_V(acc0, G_V(MR_LOADU512(E, &in0[i + 0 * vl]),\
+                           MR_LOADU512(E, &in1[i + 0 * vl])));\
+      acc1 = R_V(acc1, G_V(MR_LOADU512(E, &in0[i + 1 * vl]),\
+                           MR_LOADU512(E, &in1[i + 1 * vl])));\
+      acc2 = R_V(acc2, G_V(MR_LOADU512(E, &in0[i + 2 * vl]),\
+                           MR_LOADU512(E, &in1[i + 2 * vl])));\
+      acc3 = R_V(acc3, G_V(MR_LOADU512(E, &in0[i + 3 * vl]),\
+                           MR_LOADU512(E, &in1[i + 3 * vl])));\
+    }                                                       \
+    for (; i + vl <= n; i += vl) {                          \
+      acc0 = R_V(acc0, G_V(MR_LOADU512(E, &in0[i]),         \
+                           MR_LOADU512(E, &in1[i])));       \
+    }                                                       \
+                                                            \
+    if (i < n) {                                            \
+      __mmask16  m = MR_TAIL_MASK512(n - i);                \
+      MR_V512(E) z = MR_SET1512(E, 0);                      \
+      MR_V512(E) g = G_V(MR_MASKLOAD512(E, z, m, &in0[i]),  \
+                         MR_MASKLOAD512(E, z, m, &in1[i])); \
+      acc1 = R_V(acc1, MR_MASKMOV512(E, id, m, g));         \
+    }                                                       \
+                                                            \
+    MR_V512(E) acc = R_V(R_V(acc0, acc1), R_V(acc2, acc3)); \
+                                                            \
+    MR_CTYPE(E) lanes[16];                                  \
+    MR_STOREU512(E, lanes, acc);                            \
+                                                            \
+    MR_CTYPE(E) r = lanes[0];                               \
+    for (size_t l = 1; l < vl; l++) r = R(r, lanes[l]);     \
+                                                            \
+    *(MR_CTYPE(E)*)a->output = r;                           \
+                                                            \
+    return NULL;                                            \
+  }
+
+#endif
+
+#endif //__COMMON_MAPREDUCE_AVX512_H_
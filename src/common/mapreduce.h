@@ -0,0 +1,392 @@
+/* mapreduce.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains a generator for element-wise map and reduce kernels,
+ * so that a new kernel only states its per-element operation and gets the
+ * hot loops (unrolling, vector tails, chunking, pinning) from here. A
+ * kernel supplies functors as macros:
+ *
+ *   map    out[i] = F(in[i])                       (MR_MAP_*)
+ *          out[i] = F(in[i], in1[i])               (MR_MAP2_*)
+ *   reduce *out   = R(... R(R(ID, G(in[0])), G(in[1])) ..., G(in[n-1]))
+ *                                                  (MR_REDUCE_*)
+ *          ... with G(in[i], in1[i])               (MR_REDUCE2_*)
+ *
+ * over one element type E (i32, u32 or f32; see MR_CTYPE). The scalar
+ * functors take and return MR_CTYPE(E); the vector ones (F_V, G_V, R_V),
+ * used by the per-ISA generators in common/mapreduce.<isa>.h, take and
+ * return the vector type of the ISA. R must be associative with identity ID
+ * (float sums are reassociated, so they only match the naive order up to
+ * rounding). Each kernel is then a few lines per file:
+ *
+ *   naive.c       MR_MAP_NAIVE (impl_scalar_naive, u32, F)
+ *   opt.c         MR_MAP_OPT   (impl_scalar_opt  , u32, F)
+ *   vec.avx2.c    MR_MAP_AVX2  (impl_vector_avx2  , u32, F_AVX2)
+ *   vec.avx512.c  MR_MAP_AVX512(impl_vector_avx512, u32, F_AVX512)
+ *   vec.c         MR_DISPATCH  (impl_vector, impl_scalar_opt)
+ *   para.c        MR_MAP_PARA  (impl_parallel, u32, impl_vector)
+ *
+ * The generated functions have the driver's signature, void* fn(void*),
+ * and take an mr_args_t (or, for a benchmark with its own argument
+ * struct, anything that starts with one). MR_DISPATCH expects the AVX2
+ * and AVX-512 variants to be named <fn>_avx2 and <fn>_avx512, as declared
+ * by MR_DECLARE_VEC. Parallel versions split the elements over the pool
+ * on cache-line boundaries and run the dispatched vector kernel per chunk;
+ * reductions keep one cache-line-padded partial per thread and combine
+ * them after the join in a pairwise tree over the thread order (fixed for
+ * a given thread count).
+*/
+
+#ifndef __COMMON_MAPREDUCE_H_
+#define __COMMON_MAPREDUCE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/cpu.h"
+#include "common/pool.h"
+
+/* Arguments of every generated kernel */
+typedef struct {
+  const void*    input;      /* size elements                          */
+  const void*    input1;     /* Second operand of MR_MAP2_*, else NULL */
+  void*          output;     /* size elements (maps) or one (reduces)  */
+
+  size_t         size;       /* Elements                               */
+
+  int            cpu;
+  int            nthreads;
+
+  struct pool_t* pool;
+} mr_args_t;
+
+/* Token pasting after expansion, so E may itself be a macro */
+#define MR_CAT_(a, b) a##b
+#define MR_CAT(a, b)  MR_CAT_(a, b)
+
+/* C type of an element type */
+#define MR_CTYPE_i32 int32_t
+#define MR_CTYPE_u32 uint32_t
+#define MR_CTYPE_f32 float
+#define MR_CTYPE(E)  MR_CAT(MR_CTYPE_, E)
+
+/* Threads pool_run will actually use for a */
+static inline int mr_nthreads(const mr_args_t* a)
+{
+  int nthreads = a->nthreads;
+
+  if (a->pool == NULL) return 1;
+  if (nthreads > a->pool->nthreads) nthreads = a->pool->nthreads;
+
+  return (nthreads < 1) ? 1 : nthreads;
+}
+
+/* Parallel chunks start on a cache line, so no two threads share one */
+#define MR_CHUNK_ALIGN(E) (64 / sizeof(MR_CTYPE(E)))
+
+/* Declare fn and its per-ISA variants */
+#define MR_DECLARE_VEC(fn)                                  \
+  void* fn          (void* args);                           \
+  void* fn##_avx2   (void* args);                           \
+  void* fn##_avx512 (void* args)
+
+/* fn dispatching to fn_avx512, fn_avx2 or scalar_fn at runtime */
+#if defined(__amd64__) || defined(__x86_64__)
+#define MR_DISPATCH(fn, scalar_fn)                          \
+  static const cpu_variant_t fn##_variants[] = {           \
+    { CPU_ISA_AVX512, fn##_avx512 },                        \
+    { CPU_ISA_AVX2  , fn##_avx2   },                        \
+    { CPU_ISA_SCALAR, scalar_fn   },                        \
+  };                                                        \
+                                                            \
+  static cpu_dispatch_t fn##_dispatch =                     \
+    CPU_DISPATCH_INIT(fn##_variants);                       \
+                                                            \
+  void* fn(void* args)                                      \
+  {                                                         \
+    return cpu_dispatch(&fn##_dispatch)(args);              \
+  }
+#else
+#define MR_DISPATCH(fn, scalar_fn)                          \
+  void* fn(void* args)                                      \
+  {                                                         \
+    return scalar_fn(args);                                 \
+  }
+#endif
+
+/* Scalar maps: the plain loop, and one unrolled by four */
+#define MR_MAP_NAIVE(fn, E, F)                              \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in  = (const MR_CTYPE(E)*)a->input;  \
+          MR_CTYPE(E)* out = (      MR_CTYPE(E)*)a->output; \
+                                                            \
+    for (size_t i = 0; i < a->size; i++) {                  \
+      out[i] = F(in[i]);                                    \
+    }                                                       \
+                                                            \
+    return NULL;                                            \
+  }
+
+#define MR_MAP_OPT(fn, E, F)                                \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in  = (const MR_CTYPE(E)*)a->input;  \
+          MR_CTYPE(E)* out = (      MR_CTYPE(E)*)a->output; \
+    const size_t       n   = a->size;                       \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 4 <= n; i += 4) {                            \
+      out[i + 0] = F(in[i + 0]);                            \
+      out[i + 1] = F(in[i + 1]);                            \
+      out[i + 2] = F(in[i + 2]);                            \
+      out[i + 3] = F(in[i + 3]);                            \
+    }                                                       \
+    for (; i < n; i++) {                                    \
+      out[i] = F(in[i]);                                    \
+    }                                                       \
+                                                            \
+    return NULL;                                            \
+  }
+
+#define MR_MAP2_NAIVE(fn, E, F)                             \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in0 = (const MR_CTYPE(E)*)a->input;  \
+    const MR_CTYPE(E)* in1 = (const MR_CTYPE(E)*)a->input1; \
+          MR_CTYPE(E)* out = (      MR_CTYPE(E)*)a->output; \
+                                                            \
+    for (size_t i = 0; i < a->size; i++) {                  \
+      out[i] = F(in0[i], in1[i]);                           \
+    }                                                       \
+                                                            \
+    return NULL;                                            \
+  }
+
+#define MR_MAP2_OPT(fn, E, F)                               \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in0 = (const MR_CTYPE(E)*)a->input;  \
+    const MR_CTYPE(E)* in1 = (const MR_CTYPE(E)*)a->input1; \
+          MR_CTYPE(E)* out = (      MR_CTYPE(E)*)a->output; \
+    const size_t       n   = a->size;                       \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 4 <= n; i += 4) {                            \
+      out[i + 0] = F(in0[i + 0], in1[i + 0]);               \
+      out[i + 1] = F(in0[i + 1], in1[i + 1]);               \
+      out[i + 2] = F(in0[i + 2], in1[i + 2]);               \
+      out[i + 3] = F(in0[i + 3], in1[i + 3]);               \
+    }                                                       \
+    for (; i < n; i++) {                                    \
+      out[i] = F(in0[i], in1[i]);                           \
+    }                                                       \
+                                                            \
+    return NULL;                                            \
+  }
+
+/* Scalar reductions; the unrolled one keeps four independent partials so
+ * the loop is not one long dependency chain through R */
+#define MR_REDUCE_NAIVE(fn, E, G, R, ID)                    \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in  = (const MR_CTYPE(E)*)a->input;  \
+          MR_CTYPE(E)  acc = (ID);                          \
+                                                            \
+    for (size_t i = 0; i < a->size; i++) {                  \
+      acc = R(acc, G(in[i]));                               \
+    }                                                       \
+                                                            \
+    *(MR_CTYPE(E)*)a->output = acc;                         \
+                                                            \
+    return NULL;                                            \
+  }
+
+#define MR_REDUCE_OPT(fn, E, G, R, ID)                      \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in  = (const MR_CTYPE(E)*)a->input;  \
+    const size_t       n   = a->size;                       \
+                                                            \
+    MR_CTYPE(E) acc0 = (ID), acc1 = (ID);                   \
+    MR_CTYPE(E) acc2 = (ID), acc3 = (ID);                   \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 4 <= n; i += 4) {                            \
+      acc0 = R(acc0, G(in[i + 0]));                         \
+      acc1 = R(acc1, G(in[i + 1]));                         \
+      acc2 = R(acc2, G(in[i + 2]));                         \
+      acc3 = R(acc3, G(in[i + 3]));                         \
+    }                                                       \
+    for (; i < n; i++) {                                    \
+      acc0 = R(acc0, G(in[i]));                             \
+    }                                                       \
+                                                            \
+    *(MR_CTYPE(E)*)a->output = R(R(acc0, acc1),             \
+                                 R(acc2, acc3));            \
+                                                            \
+    return NULL;                                            \
+  }
+
+#define MR_REDUCE2_NAIVE(fn, E, G, R, ID)                   \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in0 = (const MR_CTYPE(E)*)a->input;  \
+    const MR_CTYPE(E)* in1 = (const MR_CTYPE(E)*)a->input1; \
+          MR_CTYPE(E)  acc = (ID);                          \
+                                                            \
+    for (size_t i = 0; i < a->size; i++) {                  \
+      acc = R(acc, G(in0[i], in1[i]));                      \
+    }                                                       \
+                                                            \
+    *(MR_CTYPE(E)*)a->output = acc;                         \
+                                                            \
+    return NULL;                                            \
+  }
+
+#define MR_REDUCE2_OPT(fn, E, G, R, ID)                     \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in0 = (const MR_CTYPE(E)*)a->input;  \
+    const MR_CTYPE(E)* in1 = (const MR_CTYPE(E)*)a->input1; \
+    const size_t       n   = a->size;                       \
+                                                            \
+    MR_CTYPE(E) acc0 = (ID), acc1 = (ID);                   \
+    MR_CTYPE(E) acc2 = (ID), acc3 = (ID);                   \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 4 <= n; i += 4) {                            \
+      acc0 = R(acc0, G(in0[i + 0], in1[i + 0]));            \
+      acc1 = R(acc1, G(in0[i + 1], in1[i + 1]));            \
+      acc2 = R(acc2, G(in0[i + 2], in1[i + 2]));            \
+      acc3 = R(acc3, G(in0[i + 3], in1[i + 3]));            \
+    }                                                       \
+    for (; i < n; i++) {                                    \
+      acc0 = R(acc0, G(in0[i], in1[i]));                    \
+    }                                                       \
+                                                            \
+    *(MR_CTYPE(E)*)a->output = R(R(acc0, acc1),             \
+                                 R(acc2, acc3));            \
+                                                            \
+    return NULL;                                            \
+  }
+
+/* Pairwise tree over n values v(0) .. v(n-1), in place into v(0): level
+ * s combines v(t) and v(t + s) for every t that is a multiple of 2s, so
+ * the shape only depends on n and rounding grows with log2(n) */
+#define MR_TREE(v, n, R)                                    \
+  for (size_t mr_s = 1; mr_s < (size_t)(n); mr_s *= 2) {    \
+    for (size_t mr_t = 0; mr_t + mr_s < (size_t)(n);        \
+         mr_t += 2 * mr_s) {                                \
+      v(mr_t) = R(v(mr_t), v(mr_t + mr_s));                 \
+    }                                                       \
+  }
+
+/* Parallel map: every thread runs vec_fn on its chunk */
+#define MR_MAP_PARA(fn, E, vec_fn)                          \
+  static void fn##_worker(int tid, int nthreads, void* args)\
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    size_t begin, end;                                      \
+    pool_partition(a->size, MR_CHUNK_ALIGN(E), tid,         \
+                   nthreads, &begin, &end);                 \
+    if (begin == end) return;                               \
+                                                            \
+    mr_args_t chunk = *a;                                   \
+                                                            \
+    chunk.size   = end - begin;                             \
+    chunk.input  = (const MR_CTYPE(E)*)a->input + begin;    \
+    chunk.output = (      MR_CTYPE(E)*)a->output + begin;   \
+    if (a->input1 != NULL) {                                \
+      chunk.input1 = (const MR_CTYPE(E)*)a->input1 + begin; \
+    }                                                       \
+                                                            \
+    vec_fn(&chunk);                                         \
+  }                                                         \
+                                                            \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    pool_run(a->pool, a->nthreads, fn##_worker, a);         \
+                                                            \
+    return NULL;                                            \
+  }
+
+/* Partial t in MR_REDUCE_PARA */
+#define MR_PARTIAL(t) partials[t].value
+
+/* Parallel reduction (MR_REDUCE_* or MR_REDUCE2_* per chunk): every
+ * thread reduces its chunk with vec_fn into its own partial, and the
+ * partials are combined with MR_TREE */
+#define MR_REDUCE_PARA(fn, E, vec_fn, R, ID)                \
+  typedef struct {                                          \
+    _Alignas(64) MR_CTYPE(E) value;                         \
+  } fn##_partial_t;                                         \
+                                                            \
+  typedef struct {                                          \
+    mr_args_t*      args;                                   \
+    fn##_partial_t* partials;                               \
+  } fn##_task_t;                                            \
+                                                            \
+  static void fn##_worker(int tid, int nthreads, void* args)\
+  {                                                         \
+    fn##_task_t* t = (fn##_task_t*)args;                    \
+    mr_args_t*   a = t->args;                               \
+                                                            \
+    size_t begin, end;                                      \
+    pool_partition(a->size, MR_CHUNK_ALIGN(E), tid,         \
+                   nthreads, &begin, &end);                 \
+                                                            \
+    t->partials[tid].value = (ID);                          \
+    if (begin == end) return;                               \
+                                                            \
+    mr_args_t chunk = *a;                                   \
+                                                            \
+    chunk.size   = end - begin;                             \
+    chunk.input  = (const MR_CTYPE(E)*)a->input + begin;    \
+    chunk.output = &t->partials[tid].value;                 \
+    if (a->input1 != NULL) {                                \
+      chunk.input1 = (const MR_CTYPE(E)*)a->input1 + begin; \
+    }                                                       \
+                                                            \
+    vec_fn(&chunk);                                         \
+  }                                                         \
+                                                            \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    int nthreads = mr_nthreads(a);                          \
+                                                            \
+    fn##_partial_t partials[nthreads];                      \
+    fn##_task_t    task = { a, partials };                  \
+                                                            \
+    pool_run(a->pool, nthreads, fn##_worker, &task);        \
+                                                            \
+    MR_TREE(MR_PARTIAL, nthreads, R)                        \
+    *(MR_CTYPE(E)*)a->output = partials[0].value;           \
+                                                            \
+    return NULL;                                            \
+  }
+
+#endif //__COMMON_MAPREDUCE_H_
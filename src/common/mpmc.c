@@ -0,0 +1,43 @@
+/* mpmc.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the bounded MPMC queue; see mpmc.h.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <string.h>
+
+/* Include common headers */
+#include "common/mpmc.h"
+
+int mpmc_init(mpmc_t* q, size_t capacity)
+{
+  /* At least 8 cells, so the array is a whole number of cache lines */
+  size_t n = 8;
+  while (n < capacity) n <<= 1;
+
+  memset(q, 0, sizeof(*q));
+
+  q->cells = (mpmc_cell_t*)aligned_alloc(64, n * sizeof(mpmc_cell_t));
+  if (q->cells == NULL) return -1;
+
+  q->mask = n - 1;
+  for (size_t i = 0; i < n; i++) {
+    atomic_init(&q->cells[i].seq, i);
+  }
+
+  atomic_init(&q->head, 0);
+  atomic_init(&q->tail, 0);
+
+  return 0;
+}
+
+void mpmc_destroy(mpmc_t* q)
+{
+  free(q->cells);
+  q->cells = NULL;
+  q->mask  = 0;
+}
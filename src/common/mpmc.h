@@ -0,0 +1,111 @@
+/* mpmc.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains a bounded, lock-free multi-producer multi-consumer
+ * queue (D. Vyukov's array queue). Every cell carries a sequence number
+ * that says whose turn it is: a producer claims position pos when the
+ * cell's sequence is pos, a consumer when it is pos + 1, and each hands
+ * the cell over with a release store. Producers and consumers only
+ * contend on their own index (head and tail, on separate cache lines),
+ * and a full or empty queue fails the call instead of blocking.
+ *
+ * An item is a request id and a timestamp; the queue does not look at
+ * either.
+*/
+
+#ifndef __COMMON_MPMC_H_
+#define __COMMON_MPMC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+typedef struct {
+  uint64_t id;
+  uint64_t stamp;
+} mpmc_item_t;
+
+typedef struct {
+  atomic_size_t seq;
+  mpmc_item_t   item;
+} mpmc_cell_t;
+
+typedef struct {
+  mpmc_cell_t*  cells;
+  size_t        mask;
+
+  _Alignas(64) atomic_size_t head;   /* Next position to push */
+  _Alignas(64) atomic_size_t tail;   /* Next position to pop  */
+} mpmc_t;
+
+/* capacity is rounded up to a power of two (at least 8); 0 on success */
+int  mpmc_init   (mpmc_t* q, size_t capacity);
+void mpmc_destroy(mpmc_t* q);
+
+/* false if the queue is full */
+static inline bool mpmc_push(mpmc_t* q, mpmc_item_t item)
+{
+  size_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+  for (;;) {
+    mpmc_cell_t* cell = &q->cells[pos & q->mask];
+    size_t       seq  = atomic_load_explicit(&cell->seq, memory_order_acquire);
+    intptr_t     dif  = (intptr_t)seq - (intptr_t)pos;
+
+    if (dif == 0) {
+      /* On failure pos is reloaded with the current head */
+      if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed)) {
+        cell->item = item;
+        atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+        return true;
+      }
+    } else if (dif < 0) {
+      return false;
+    } else {
+      pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+    }
+  }
+}
+
+/* false if the queue is empty */
+static inline bool mpmc_pop(mpmc_t* q, mpmc_item_t* item)
+{
+  size_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+  for (;;) {
+    mpmc_cell_t* cell = &q->cells[pos & q->mask];
+    size_t       seq  = atomic_load_explicit(&cell->seq, memory_order_acquire);
+    intptr_t     dif  = (intptr_t)seq - (intptr_t)(pos + 1);
+
+    if (dif == 0) {
+      if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed)) {
+        *item = cell->item;
+        /* The cell is free for the push one lap later */
+        atomic_store_explicit(&cell->seq, pos + q->mask + 1, memory_order_release);
+        return true;
+      }
+    } else if (dif < 0) {
+      return false;
+    } else {
+      pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    }
+  }
+}
+
+/* Items queued, racy: a hint for sizing a batch, never a guarantee */
+static inline size_t mpmc_depth(mpmc_t* q)
+{
+  size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+  size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+  return (head > tail) ? head - tail : 0;
+}
+
+#endif //__COMMON_MPMC_H_
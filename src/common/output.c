@@ -0,0 +1,525 @@
+/* output.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the result writer; see output.h.
+ */
+
+/* Set features         */
+#define _GNU_SOURCE
+
+/* Standard C includes  */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+/* Include common headers */
+#include "common/output.h"
+
+/* zstd level: fast, still a good ratio on runtimes */
+#define OUT_ZSTD_LEVEL 3
+
+static const char* format_names[OUT_FORMAT_NUM] = {
+  "csv",
+  "bin",
+  "bin.zst",
+  "bin.lz4",
+};
+
+/* A compressor from a shared library, resolved by out_init */
+typedef struct {
+  const char*  lib;
+  const char*  suffix;
+  void*        handle;
+  size_t     (*bound   )(size_t n);
+  size_t     (*compress)(void* dst, size_t cap, const void* src, size_t n);
+  bool       (*failed  )(size_t ret);
+} out_codec_t;
+
+/* Queued file */
+typedef struct out_job_t {
+  struct out_job_t* next;
+  char*             data;
+  size_t            len;
+  bool              compress;
+  char              path[PATH_MAX];
+} out_job_t;
+
+static out_format_t    out_fmt = OUT_CSV;
+/* Leaves room in a path for the file names under it */
+static char            out_root[PATH_MAX / 2] = ".";
+static out_codec_t*    out_codec;
+
+static pthread_t       writer;
+static pthread_mutex_t writer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  writer_cond = PTHREAD_COND_INITIALIZER;
+static out_job_t*      queue_head;
+static out_job_t*      queue_tail;
+static bool            writer_running;
+static bool            writer_stop;
+static int             writer_failures;
+
+/* zstd: ZSTD_compressBound, ZSTD_compress, ZSTD_isError */
+static size_t   (*zstd_bound_fn   )(size_t);
+static size_t   (*zstd_compress_fn)(void*, size_t, const void*, size_t, int);
+static unsigned (*zstd_error_fn   )(size_t);
+
+static size_t zstd_bound(size_t n) { return zstd_bound_fn(n); }
+static bool   zstd_failed(size_t r) { return zstd_error_fn(r) != 0; }
+static size_t zstd_compress(void* dst, size_t cap, const void* src, size_t n)
+{
+  return zstd_compress_fn(dst, cap, src, n, OUT_ZSTD_LEVEL);
+}
+
+/* LZ4 frames: LZ4F_compressFrameBound, LZ4F_compressFrame, LZ4F_isError;
+ * default preferences */
+static size_t   (*lz4_bound_fn   )(size_t, const void*);
+static size_t   (*lz4_compress_fn)(void*, size_t, const void*, size_t, const void*);
+static unsigned (*lz4_error_fn   )(size_t);
+
+static size_t lz4_bound(size_t n) { return lz4_bound_fn(n, NULL); }
+static bool   lz4_failed(size_t r) { return lz4_error_fn(r) != 0; }
+static size_t lz4_compress(void* dst, size_t cap, const void* src, size_t n)
+{
+  return lz4_compress_fn(dst, cap, src, n, NULL);
+}
+
+static out_codec_t codec_zstd = { "libzstd.so.1", ".zst", NULL, zstd_bound, zstd_compress, zstd_failed };
+static out_codec_t codec_lz4  = { "liblz4.so.1" , ".lz4", NULL, lz4_bound , lz4_compress , lz4_failed  };
+
+/* Resolve the codec's symbols; false if the library is missing */
+static bool out_codec_load(out_codec_t* c)
+{
+  c->handle = dlopen(c->lib, RTLD_NOW | RTLD_LOCAL);
+  if (c->handle == NULL) return false;
+
+  if (c == &codec_zstd) {
+    *(void**)&zstd_bound_fn    = dlsym(c->handle, "ZSTD_compressBound");
+    *(void**)&zstd_compress_fn = dlsym(c->handle, "ZSTD_compress");
+    *(void**)&zstd_error_fn    = dlsym(c->handle, "ZSTD_isError");
+
+    return zstd_bound_fn != NULL && zstd_compress_fn != NULL && zstd_error_fn != NULL;
+  } else {
+    *(void**)&lz4_bound_fn    = dlsym(c->handle, "LZ4F_compressFrameBound");
+    *(void**)&lz4_compress_fn = dlsym(c->handle, "LZ4F_compressFrame");
+    *(void**)&lz4_error_fn    = dlsym(c->handle, "LZ4F_isError");
+
+    return lz4_bound_fn != NULL && lz4_compress_fn != NULL && lz4_error_fn != NULL;
+  }
+}
+
+out_format_t out_format_parse(const char* name)
+{
+  for (int i = 0; i < OUT_FORMAT_NUM; i++) {
+    if (strcasecmp(name, format_names[i]) == 0) return (out_format_t)i;
+  }
+
+  return OUT_FORMAT_NUM;
+}
+
+const char* out_format_name(out_format_t fmt)
+{
+  return (fmt >= 0 && fmt < OUT_FORMAT_NUM) ? format_names[fmt] : "unknown";
+}
+
+out_format_t out_format(void) { return out_fmt;            }
+bool         out_binary(void) { return out_fmt != OUT_CSV; }
+
+/* Compress (if asked) and write one file; false on failure */
+static bool out_write(const out_job_t* job)
+{
+  const char* data = job->data;
+  size_t      len  = job->len;
+  char*       buf  = NULL;
+
+  if (job->compress && out_codec != NULL) {
+    size_t cap = out_codec->bound(len);
+
+    buf = (char*)malloc(cap);
+    if (buf == NULL) return false;
+
+    len = out_codec->compress(buf, cap, data, len);
+    if (out_codec->failed(len)) {
+      free(buf);
+      return false;
+    }
+    data = buf;
+  }
+
+  FILE* fp = fopen(job->path, "wb");
+  bool  ok = (fp != NULL) && fwrite(data, 1, len, fp) == len;
+
+  if (fp != NULL && fclose(fp) != 0) ok = false;
+
+  free(buf);
+
+  return ok;
+}
+
+static void* out_writer(void* arg)
+{
+  (void)arg;
+
+  pthread_mutex_lock(&writer_lock);
+  while (true) {
+    while (queue_head == NULL && !writer_stop) {
+      pthread_cond_wait(&writer_cond, &writer_lock);
+    }
+    if (queue_head == NULL) break;
+
+    out_job_t* job = queue_head;
+    queue_head = job->next;
+    if (queue_head == NULL) queue_tail = NULL;
+
+    /* Compress and write outside the lock */
+    pthread_mutex_unlock(&writer_lock);
+    bool ok = out_write(job);
+    free(job->data);
+    free(job);
+    pthread_mutex_lock(&writer_lock);
+
+    if (!ok) writer_failures++;
+  }
+  pthread_mutex_unlock(&writer_lock);
+
+  return NULL;
+}
+
+int out_init(out_format_t fmt, const char* dir)
+{
+  out_fmt = fmt;
+
+  int n = snprintf(out_root, sizeof(out_root), "%s", dir);
+  if (n < 0 || (size_t)n >= sizeof(out_root)) {
+    printf("\n");
+    printf("ERROR: The output directory name is too long (at most %zu characters).\n",
+           sizeof(out_root) - 1);
+    snprintf(out_root, sizeof(out_root), ".");
+    return -1;
+  }
+
+  if (mkdir(out_root, 0755) != 0 && errno != EEXIST) {
+    printf("\n");
+    printf("ERROR: Cannot create the output directory \"%s\".\n", out_root);
+    return -1;
+  }
+
+  out_codec = NULL;
+  if (fmt == OUT_BIN_ZSTD) out_codec = &codec_zstd;
+  if (fmt == OUT_BIN_LZ4 ) out_codec = &codec_lz4;
+
+  if (out_codec != NULL && !out_codec_load(out_codec)) {
+    printf("\n");
+    printf("ERROR: \"%s\" needs %s, which cannot be loaded.\n",
+           out_format_name(fmt), out_codec->lib);
+    return -1;
+  }
+
+  writer_stop    = false;
+  writer_running = pthread_create(&writer, NULL, out_writer, NULL) == 0;
+
+  return 0;
+}
+
+int out_finish(void)
+{
+  if (writer_running) {
+    pthread_mutex_lock(&writer_lock);
+    writer_stop = true;
+    pthread_cond_signal(&writer_cond);
+    pthread_mutex_unlock(&writer_lock);
+
+    pthread_join(writer, NULL);
+    writer_running = false;
+  }
+
+  if (writer_failures > 0) {
+    printf("ERROR: %d result file(s) could not be written.\n", writer_failures);
+  }
+
+  return writer_failures;
+}
+
+int out_mkdir(const char* name)
+{
+  char path[PATH_MAX];
+  int  n = snprintf(path, sizeof(path), "%s/%s", out_root, name);
+
+  if (n < 0 || (size_t)n >= sizeof(path)) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+
+  return (mkdir(path, 0755) == 0 || errno == EEXIST) ? 0 : -1;
+}
+
+out_file_t* out_open(const char* name, bool binary)
+{
+  out_file_t* f = (out_file_t*)calloc(1, sizeof(out_file_t));
+
+  if (f == NULL) return NULL;
+
+  f->binary = binary;
+
+  int n = snprintf(f->path, sizeof(f->path), "%s/%s%s", out_root, name,
+                   (binary && out_codec != NULL) ? out_codec->suffix : "");
+  if (n < 0 || (size_t)n >= sizeof(f->path)) {
+    printf("ERROR: The path of \"%s\" is too long.\n", name);
+    free(f);
+    return NULL;
+  }
+
+  f->fp = open_memstream(&f->data, &f->len);
+  if (f->fp == NULL) {
+    free(f);
+    return NULL;
+  }
+
+  return f;
+}
+
+void out_close(out_file_t* f)
+{
+  out_job_t* job = (out_job_t*)calloc(1, sizeof(out_job_t));
+
+  fclose(f->fp);
+
+  if (job == NULL) {
+    pthread_mutex_lock(&writer_lock);
+    writer_failures++;
+    pthread_mutex_unlock(&writer_lock);
+    free(f->data);
+    free(f);
+    return;
+  }
+
+  job->data     = f->data;
+  job->len      = f->len;
+  job->compress = f->binary;
+  memcpy(job->path, f->path, sizeof(job->path));
+  free(f);
+
+  /* Without a writer thread, write in place */
+  if (!writer_running) {
+    bool ok = out_write(job);
+
+    pthread_mutex_lock(&writer_lock);
+    if (!ok) writer_failures++;
+    pthread_mutex_unlock(&writer_lock);
+    free(job->data);
+    free(job);
+    return;
+  }
+
+  pthread_mutex_lock(&writer_lock);
+  if (queue_tail != NULL) queue_tail->next = job;
+  else                    queue_head       = job;
+  queue_tail = job;
+  pthread_cond_signal(&writer_cond);
+  pthread_mutex_unlock(&writer_lock);
+}
+
+size_t out_fmt_u64(char* p, uint64_t v)
+{
+  char   tmp[20];
+  size_t n = 0;
+
+  do {
+    tmp[n++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v != 0);
+
+  for (size_t i = 0; i < n; i++) p[i] = tmp[n - 1 - i];
+
+  return n;
+}
+
+size_t out_fmt_f32(char* p, float v, int decimals)
+{
+  static const uint64_t pow10[10] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+  };
+
+  if (decimals < 0) decimals = 0;
+  if (decimals > 9) decimals = 9;
+
+  /* Exact: a float's 24-bit mantissa times 5^9 still fits in a double,
+   * so the rounding (ties to even) is the same as printf's */
+  uint64_t scale = pow10[decimals];
+  double   x     = fabs((double)v) * (double)scale;
+
+  /* Out of the fast path's range: printf */
+  if (!isfinite(v) || x >= 9e18) {
+    return (size_t)sprintf(p, "%.*f", decimals, v);
+  }
+
+  uint64_t t  = (uint64_t)nearbyint(x);
+  uint64_t ip = t / scale;
+  uint64_t fp = t % scale;
+  size_t   n  = 0;
+
+  if (signbit(v)) p[n++] = '-';
+
+  n += out_fmt_u64(&p[n], ip);
+
+  if (decimals > 0) {
+    p[n++] = '.';
+    for (int d = decimals - 1; d >= 0; d--) {
+      p[n + d] = (char)('0' + fp % 10);
+      fp /= 10;
+    }
+    n += decimals;
+  }
+
+  return n;
+}
+
+/* Formatted values are collected in a chunk and written per chunk */
+#define OUT_CHUNK 8192
+
+void out_put_u64s(FILE* fp, const char* sep, const uint64_t* v,
+                  size_t n, size_t stride)
+{
+  char   buf[OUT_CHUNK];
+  size_t len  = 0;
+  size_t slen = strlen(sep);
+
+  for (size_t i = 0; i < n; i++) {
+    if (len + slen + 20 > sizeof(buf)) {
+      fwrite(buf, 1, len, fp);
+      len = 0;
+    }
+
+    memcpy(&buf[len], sep, slen);
+    len += slen;
+    len += out_fmt_u64(&buf[len], v[i * stride]);
+  }
+
+  fwrite(buf, 1, len, fp);
+}
+
+void out_put_f32s(FILE* fp, const char* sep, const float* v,
+                  size_t n, int decimals)
+{
+  char   buf[OUT_CHUNK];
+  size_t len  = 0;
+  size_t slen = strlen(sep);
+
+  for (size_t i = 0; i < n; i++) {
+    /* Room for the widest value printf may produce (a float is < 1e39) */
+    if (len + slen + 64 > sizeof(buf)) {
+      fwrite(buf, 1, len, fp);
+      len = 0;
+    }
+
+    memcpy(&buf[len], sep, slen);
+    len += slen;
+    len += out_fmt_f32(&buf[len], v[i], decimals);
+  }
+
+  fwrite(buf, 1, len, fp);
+}
+
+/* Little-endian stores */
+static void out_le(char* p, uint64_t v, int bytes)
+{
+  for (int i = 0; i < bytes; i++) p[i] = (char)(v >> (8 * i));
+}
+
+void out_put_header(FILE* fp, out_dtype_t dtype, uint64_t rows,
+                    uint64_t cols, const char* meta, size_t meta_len)
+{
+  char h[32];
+
+  memcpy(h, "BSR1", 4);
+  out_le(&h[ 4], 1       , 2);
+  out_le(&h[ 6], dtype   , 2);
+  out_le(&h[ 8], rows    , 8);
+  out_le(&h[16], cols    , 8);
+  out_le(&h[24], meta_len, 4);
+  out_le(&h[28], 0       , 4);
+
+  fwrite(h, 1, sizeof(h), fp);
+  if (meta_len > 0) fwrite(meta, 1, meta_len, fp);
+}
+
+void out_put_bin_u64s(FILE* fp, const uint64_t* v, size_t n, size_t stride)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  if (stride == 1) {
+    fwrite(v, sizeof(uint64_t), n, fp);
+    return;
+  }
+#endif
+
+  char   buf[OUT_CHUNK];
+  size_t len = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    if (len + 8 > sizeof(buf)) {
+      fwrite(buf, 1, len, fp);
+      len = 0;
+    }
+
+    out_le(&buf[len], v[i * stride], 8);
+    len += 8;
+  }
+
+  fwrite(buf, 1, len, fp);
+}
+
+void out_put_bin_f32s(FILE* fp, const float* v, size_t n)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  fwrite(v, sizeof(float), n, fp);
+#else
+  for (size_t i = 0; i < n; i++) {
+    uint32_t u;
+    char     b[4];
+
+    memcpy(&u, &v[i], 4);
+    out_le(b, u, 4);
+    fwrite(b, 1, 4, fp);
+  }
+#endif
+}
+
+int out_matrix(const char* name, const float* m, size_t rows, size_t cols,
+               int decimals)
+{
+  char        file[PATH_MAX];
+  bool        binary = out_binary();
+  out_file_t* f;
+
+  int n = snprintf(file, sizeof(file), "%s.%s", name, binary ? "bin" : "csv");
+  if (n < 0 || (size_t)n >= sizeof(file)) return -1;
+
+  f = out_open(file, binary);
+  if (f == NULL) return -1;
+
+  if (binary) {
+    out_put_header(f->fp, OUT_DTYPE_F32, rows, cols, NULL, 0);
+    out_put_bin_f32s(f->fp, m, rows * cols);
+  } else {
+    for (size_t i = 0; i < rows; i++) {
+      if (cols > 0) {
+        out_put_f32s(f->fp, "" , &m[i * cols]    , 1       , decimals);
+        out_put_f32s(f->fp, ",", &m[i * cols + 1], cols - 1, decimals);
+      }
+      fputc('\n', f->fp);
+    }
+  }
+
+  out_close(f);
+
+  return 0;
+}
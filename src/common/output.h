@@ -0,0 +1,116 @@
+/* output.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the result writer. Every result file (the driver's
+ * runtimes and statistics, a benchmark's exported data) is assembled in
+ * memory and handed to a background thread that compresses and writes
+ * it, so the next case never waits on the disk; out_finish() drains the
+ * queue before the process exits. All files go to one directory
+ * (--output-dir), in one of the formats of out_format_t
+ * (--output-format):
+ *
+ *   csv      text; numbers go through the integer and fixed-point
+ *            formatters below rather than printf
+ *   bin      raw little-endian values behind a small header
+ *   bin.zst  bin, compressed into a zstd frame (zstd -d reads it)
+ *   bin.lz4  bin, compressed into an LZ4 frame (lz4 -d reads it)
+ *
+ * The compressors are loaded at runtime (libzstd.so.1, liblz4.so.1), so
+ * the build does not depend on them; out_init fails if the chosen one is
+ * missing. The binary layout is
+ *
+ *   offset  0  char[4]   magic "BSR1"
+ *           4  uint16    version (1)
+ *           6  uint16    dtype (out_dtype_t)
+ *           8  uint64    rows
+ *          16  uint64    cols
+ *          24  uint32    meta_len
+ *          28  uint32    reserved (0)
+ *          32  meta_len bytes of metadata: the "key,value" lines the
+ *              csv file would have had besides the data itself
+ *          32 + meta_len: rows x cols values, row-major
+ *
+ * which numpy reads with np.frombuffer(data, dtype, offset=32 + meta_len).
+*/
+
+#ifndef __COMMON_OUTPUT_H_
+#define __COMMON_OUTPUT_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <limits.h>
+
+typedef enum {
+  OUT_CSV = 0,
+  OUT_BIN,
+  OUT_BIN_ZSTD,
+  OUT_BIN_LZ4,
+  OUT_FORMAT_NUM
+} out_format_t;
+
+typedef enum {
+  OUT_DTYPE_U64 = 1,
+  OUT_DTYPE_F32 = 2,
+} out_dtype_t;
+
+/* An in-memory file; fp is an ordinary stream, so fprintf-based writers
+ * (e.g. the dump hook of a benchmark) can fill it */
+typedef struct {
+  FILE*  fp;
+  char*  data;
+  size_t len;
+  bool   binary;
+  char   path[PATH_MAX];
+} out_file_t;
+
+out_format_t out_format_parse(const char* name);   /* OUT_FORMAT_NUM if unknown */
+const char*  out_format_name (out_format_t fmt);
+
+/* Pick the format and the directory (created if needed) and start the
+ * writer; 0 on success */
+int          out_init  (out_format_t fmt, const char* dir);
+
+/* Wait for every queued file, stop the writer and report failures;
+ * returns how many files could not be written */
+int          out_finish(void);
+
+out_format_t out_format(void);
+bool         out_binary(void);
+
+/* Create a directory inside the output directory; 0 if it exists after */
+int          out_mkdir (const char* name);
+
+/* Start a file at name inside the output directory; binary files get the
+ * compressor's suffix (".zst", ".lz4") and are compressed on the way out */
+out_file_t*  out_open  (const char* name, bool binary);
+
+/* Queue the file to the writer, which takes over its memory */
+void         out_close (out_file_t* f);
+
+/* Fast formatters: write v at p, without a terminator, and return the
+ * length; out_fmt_f32 is fixed-point with decimals (<= 9) digits */
+size_t       out_fmt_u64(char* p, uint64_t v);
+size_t       out_fmt_f32(char* p, float v, int decimals);
+
+/* Text lists: n values, each preceded by sep; values are stride apart */
+void         out_put_u64s(FILE* fp, const char* sep, const uint64_t* v,
+                          size_t n, size_t stride);
+void         out_put_f32s(FILE* fp, const char* sep, const float* v,
+                          size_t n, int decimals);
+
+/* Binary header and little-endian values */
+void         out_put_header(FILE* fp, out_dtype_t dtype, uint64_t rows,
+                            uint64_t cols, const char* meta, size_t meta_len);
+void         out_put_bin_u64s(FILE* fp, const uint64_t* v, size_t n, size_t stride);
+void         out_put_bin_f32s(FILE* fp, const float* v, size_t n);
+
+/* A rows x cols row-major matrix as name.csv (comma separated rows) or
+ * name.bin[.zst|.lz4]; 0 if it was queued */
+int          out_matrix(const char* name, const float* m, size_t rows,
+                        size_t cols, int decimals);
+
+#endif //__COMMON_OUTPUT_H_
@@ -0,0 +1,356 @@
+/* pool.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the persistent worker pool; see pool.h.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* If we are on Darwin, include the compatibility header */
+#if defined(__APPLE__)
+#include "common/mach_pthread_compatibility.h"
+#endif
+
+/* Include common headers */
+#include "common/pool.h"
+
+/* Number of polling iterations before a thread backs off */
+#define POOL_SPIN_LIMIT (1 << 16)
+
+static inline void pool_pause(void)
+{
+#if defined(__amd64__) || defined(__x86_64__)
+  _mm_pause();
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+  __asm__ __volatile__ ("yield");
+#endif
+}
+
+static void pool_pin(pthread_t thread, int cpu)
+{
+  cpu_set_t cpuset;
+
+  if (cpu < 0) return;
+
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+
+  /* Pinning is best-effort; the CPU might not exist or be allowed */
+  int __attribute__((unused)) res = pthread_setaffinity_np(thread,
+                                               sizeof(cpuset), &cpuset);
+}
+
+/* Timestamp of a span */
+static inline uint64_t pool_now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (uint64_t)ts.tv_sec * 1000000000llu + ts.tv_nsec;
+}
+
+/* Append a span to the owner's ring; the oldest unread one is lost when
+ * the ring is full */
+static void pool_record(pool_worker_t* worker, unsigned seq, int nthreads,
+                        uint64_t fork, uint64_t start, uint64_t end,
+                        uint64_t join)
+{
+  pool_ring_t* ring = &worker->ring;
+  pool_span_t* span = &ring->spans[ring->head % POOL_TRACE_SPANS];
+
+  span->seq      = seq;
+  span->nthreads = nthreads;
+  span->fork     = fork;
+  span->start    = start;
+  span->end      = end;
+  span->join     = join;
+
+  ring->head++;
+}
+
+/* Wait until the generation moves past seen */
+static unsigned pool_wait_gen(pool_t* pool, unsigned seen)
+{
+  unsigned gen;
+
+  for (int spins = 0; spins < POOL_SPIN_LIMIT; spins++) {
+    gen = atomic_load_explicit(&pool->gen, memory_order_acquire);
+    if (gen != seen) return gen;
+    pool_pause();
+  }
+
+  /* Nothing showed up; go to sleep */
+  pthread_mutex_lock(&pool->lock);
+  atomic_fetch_add(&pool->sleepers, 1);
+  while ((gen = atomic_load(&pool->gen)) == seen) {
+    pthread_cond_wait(&pool->cond, &pool->lock);
+  }
+  atomic_fetch_sub(&pool->sleepers, 1);
+  pthread_mutex_unlock(&pool->lock);
+
+  return gen;
+}
+
+static void* pool_worker(void* args)
+{
+  pool_worker_t* worker = (pool_worker_t*)args;
+  pool_t*        pool   = worker->pool;
+  unsigned       seen   = 0;
+
+  pool_pin(pthread_self(), worker->cpu);
+
+  while (true) {
+    seen = pool_wait_gen(pool, seen);
+
+    if (atomic_load_explicit(&pool->quit, memory_order_acquire)) break;
+
+    /* The fork is only stable until every worker has acknowledged it */
+    pool_task_t task   = pool->task;
+    void*       targs  = pool->args;
+    int         active = pool->active;
+    bool        trace  = pool->trace;
+    unsigned    seq    = pool->seq;
+    uint64_t    fork   = pool->fork;
+
+    if (worker->tid >= active) {
+      atomic_fetch_sub_explicit(&pool->pending, 1, memory_order_release);
+      continue;
+    }
+
+    if (trace) {
+      uint64_t start = pool_now();
+      task(worker->tid, active, targs);
+      pool_record(worker, seq, active, fork, start, pool_now(), 0);
+    } else {
+      task(worker->tid, active, targs);
+    }
+    atomic_fetch_sub_explicit(&pool->pending, 1, memory_order_release);
+  }
+
+  return NULL;
+}
+
+/* Publish a new generation and wake up anyone that went to sleep */
+static void pool_publish(pool_t* pool)
+{
+  atomic_fetch_add(&pool->gen, 1);
+
+  if (atomic_load(&pool->sleepers) > 0) {
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+  }
+}
+
+int pool_create(pool_t* pool, int nthreads, const int* cpus)
+{
+  pool->nthreads = nthreads > 0 ? nthreads : 1;
+  pool->cpu      = (cpus != NULL) ? cpus[0] : -1;
+  pool->task     = NULL;
+  pool->args     = NULL;
+  pool->active   = 0;
+  pool->trace    = false;
+  pool->seq      = 0;
+  pool->fork     = 0;
+
+  atomic_init(&pool->gen     , 0);
+  atomic_init(&pool->pending , 0);
+  atomic_init(&pool->sleepers, 0);
+  atomic_init(&pool->quit    , false);
+
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init (&pool->cond, NULL);
+
+  pool->workers = (pool_worker_t*)calloc(pool->nthreads,
+                                         sizeof(pool_worker_t));
+  if (pool->workers == NULL) return -1;
+
+  /* The caller is thread 0 */
+  pool->workers[0].pool   = pool;
+  pool->workers[0].tid    = 0;
+  pool->workers[0].cpu    = pool->cpu;
+  pool->workers[0].thread = pthread_self();
+  pool_pin(pool->workers[0].thread, pool->cpu);
+
+  for (int i = 1; i < pool->nthreads; i++) {
+    pool->workers[i].pool = pool;
+    pool->workers[i].tid  = i;
+    pool->workers[i].cpu  = (cpus != NULL) ? cpus[i] : -1;
+
+    if (pthread_create(&(pool->workers[i].thread), NULL,
+                       pool_worker, (void*)&(pool->workers[i])) != 0) {
+      /* Tear down whatever was created so far */
+      pool->nthreads = i;
+      pool_destroy(pool);
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+void pool_run(pool_t* pool, int nthreads, pool_task_t task, void* args)
+{
+  if (pool == NULL || nthreads <= 1 || pool->nthreads <= 1) {
+    if (pool != NULL && pool->trace) {
+      uint64_t start = pool_now();
+      task(0, 1, args);
+      uint64_t end = pool_now();
+      pool_record(&pool->workers[0], ++pool->seq, 1, start, start, end, end);
+    } else {
+      task(0, 1, args);
+    }
+    return;
+  }
+
+  if (nthreads > pool->nthreads) nthreads = pool->nthreads;
+
+  bool     trace = pool->trace;
+  uint64_t start = 0, end = 0;
+
+  /* Fork */
+  pool->task   = task;
+  pool->args   = args;
+  pool->active = nthreads;
+  if (trace) {
+    pool->seq++;
+    pool->fork = pool_now();
+  }
+  /* Every worker acknowledges every fork, those left out too: one that
+   * had not read this fork yet could otherwise read the next one in its
+   * place, and run that twice */
+  atomic_store_explicit(&pool->pending, pool->nthreads - 1, memory_order_relaxed);
+  pool_publish(pool);
+
+  /* Our own share */
+  if (trace) start = pool_now();
+  task(0, nthreads, args);
+  if (trace) end = pool_now();
+
+  /* Join */
+  for (int spins = 0;
+       atomic_load_explicit(&pool->pending, memory_order_acquire) > 0;
+       spins++) {
+    if (spins < POOL_SPIN_LIMIT) {
+      pool_pause();
+    } else {
+      sched_yield();
+    }
+  }
+
+  if (trace) {
+    pool_record(&pool->workers[0], pool->seq, nthreads, pool->fork, start,
+                end, pool_now());
+  }
+}
+
+void pool_destroy(pool_t* pool)
+{
+  if (pool->workers == NULL) return;
+
+  atomic_store_explicit(&pool->quit, true, memory_order_release);
+  pool_publish(pool);
+
+  for (int i = 1; i < pool->nthreads; i++) {
+    pthread_join(pool->workers[i].thread, NULL);
+  }
+
+  pthread_mutex_destroy(&pool->lock);
+  pthread_cond_destroy (&pool->cond);
+
+  for (int i = 0; i < pool->nthreads; i++) {
+    arena_destroy(&pool->workers[i].scratch);
+    free(pool->workers[i].ring.spans);
+  }
+
+  free(pool->workers);
+  pool->workers = NULL;
+}
+
+/* Scratch reservation, run on every thread so each touches its own */
+typedef struct {
+  pool_t*     pool;
+  size_t      bytes;
+  atomic_int  failed;
+} pool_scratch_t;
+
+static void pool_scratch_worker(int tid, int nthreads, void* args)
+{
+  pool_scratch_t* req = (pool_scratch_t*)args;
+
+  if (arena_reserve(&req->pool->workers[tid].scratch, req->bytes) != 0) {
+    atomic_store(&req->failed, 1);
+  }
+}
+
+int pool_reserve_scratch(pool_t* pool, size_t bytes)
+{
+  pool_scratch_t req;
+
+  req.pool  = pool;
+  req.bytes = bytes;
+  atomic_init(&req.failed, 0);
+
+  pool_run(pool, pool->nthreads, pool_scratch_worker, &req);
+
+  return atomic_load(&req.failed) ? -1 : 0;
+}
+
+void pool_reset_scratch(pool_t* pool)
+{
+  for (int i = 0; i < pool->nthreads; i++) {
+    arena_reset(&pool->workers[i].scratch);
+  }
+}
+
+int pool_trace(pool_t* pool, bool on)
+{
+  for (int i = 0; on && i < pool->nthreads; i++) {
+    pool_ring_t* ring = &pool->workers[i].ring;
+
+    if (ring->spans == NULL) {
+      ring->spans = (pool_span_t*)calloc(POOL_TRACE_SPANS, sizeof(pool_span_t));
+      if (ring->spans == NULL) return -1;
+    }
+  }
+
+  pool->trace = on;
+
+  return 0;
+}
+
+int pool_trace_read(pool_t* pool, int tid, pool_span_t* out, int max)
+{
+  pool_ring_t* ring = &pool->workers[tid].ring;
+  int          n    = 0;
+
+  if (ring->spans == NULL) return 0;
+
+  if (ring->head - ring->tail > POOL_TRACE_SPANS) {
+    ring->lost += ring->head - ring->tail - POOL_TRACE_SPANS;
+    ring->tail  = ring->head - POOL_TRACE_SPANS;
+  }
+
+  while (ring->tail < ring->head && n < max) {
+    out[n++] = ring->spans[ring->tail % POOL_TRACE_SPANS];
+    ring->tail++;
+  }
+
+  return n;
+}
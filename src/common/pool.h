@@ -0,0 +1,155 @@
+/* pool.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains a persistent, CPU-pinned worker pool that is shared
+ * by all parallel implementations. The pool is created once by main.c
+ * before any timing takes place, and destroyed after the statistics are
+ * done. Each invocation of a parallel implementation is a single fork/join
+ * through pool_run():
+ *
+ *   fork : the calling thread (tid 0) publishes a task and bumps a
+ *          generation counter; pinned workers spinning on the counter
+ *          pick the task up immediately.
+ *   join : the calling thread runs its own share (tid 0), then waits for
+ *          the pending-workers counter to drain to zero. Every worker
+ *          counts down, including those a fork with fewer threads
+ *          leaves idle, so none reads the task of a fork once the next
+ *          one may have replaced it.
+ *
+ * Workers spin for a bounded number of iterations and then fall back to
+ * sleeping on a condition variable, so an idle pool does not burn CPUs
+ * between benchmarks.
+ *
+ * With tracing on (pool_trace()), every thread also records a span per
+ * fork/join in a ring of its own: when the caller forked, when the
+ * thread started and finished its share and, for thread 0, when the
+ * join completed. Only the owner writes a ring and only while the pool
+ * runs; pool_trace_read() drains them in between (see common/trace.h).
+*/
+
+#ifndef __COMMON_POOL_H_
+#define __COMMON_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "common/arena.h"
+
+/* Task signature: tid is in [0, nthreads) and tid 0 is the caller */
+typedef void (*pool_task_t)(int tid, int nthreads, void* args);
+
+/* Spans each thread keeps until they are read */
+#define POOL_TRACE_SPANS 4096
+
+/* One fork/join as seen by one thread, in ns of CLOCK_MONOTONIC; join
+ * is only known to thread 0 (0 elsewhere) */
+typedef struct {
+  unsigned  seq;               /* Fork/join number, shared by its spans */
+  int       nthreads;          /* Threads that took part                */
+  uint64_t  fork;
+  uint64_t  start;
+  uint64_t  end;
+  uint64_t  join;
+} pool_span_t;
+
+/* Single-writer ring of spans */
+typedef struct {
+  pool_span_t*     spans;      /* POOL_TRACE_SPANS, or NULL             */
+  uint64_t         head;       /* Spans written by the owner            */
+  uint64_t         tail;       /* Spans read                            */
+  uint64_t         lost;       /* Overwritten before they were read     */
+} pool_ring_t;
+
+/* Per-worker bookkeeping */
+typedef struct pool_worker_t {
+  struct pool_t*   pool;
+  int              tid;
+  int              cpu;
+  pthread_t        thread;
+  arena_t          scratch;    /* Touched and used by this thread only */
+  pool_ring_t      ring;       /* Written by this thread only          */
+} pool_worker_t;
+
+typedef struct pool_t {
+  /* Configuration */
+  int              nthreads;
+  int              cpu;
+  pool_worker_t*   workers;
+
+  /* Current task */
+  pool_task_t      task;
+  void*            args;
+  int              active;
+
+  /* Tracing (pool_trace()); seq and fork describe the current fork */
+  bool             trace;
+  unsigned         seq;
+  uint64_t         fork;
+
+  /* Fork/join state; each counter lives on its own cache line */
+  _Alignas(64) atomic_uint gen;
+  _Alignas(64) atomic_int  pending;
+  _Alignas(64) atomic_int  sleepers;
+  atomic_bool      quit;
+
+  /* Sleeping workers */
+  pthread_mutex_t  lock;
+  pthread_cond_t   cond;
+} pool_t;
+
+/* Create a pool of nthreads (the caller counts as thread 0). Thread i is
+ * pinned to cpus[i] (see common/affinity.h), or left unpinned when cpus
+ * is NULL. Returns 0 on success. */
+int  pool_create (pool_t* pool, int nthreads, const int* cpus);
+
+/* Run task on the first nthreads threads of the pool and wait for all of
+ * them to finish. A NULL pool runs the task inline as a single thread. */
+void pool_run    (pool_t* pool, int nthreads, pool_task_t task, void* args);
+
+/* Stop and join all workers */
+void pool_destroy(pool_t* pool);
+
+/* Grow the scratch arena of every thread to at least bytes; each thread
+ * reserves (and first-touches) its own. Returns 0 on success. */
+int  pool_reserve_scratch(pool_t* pool, size_t bytes);
+
+/* Rewind every thread's arena; call outside the timed region */
+void pool_reset_scratch  (pool_t* pool);
+
+/* Start (allocating the rings) or stop recording spans; 0 on success */
+int  pool_trace          (pool_t* pool, bool on);
+
+/* Move up to max of thread tid's unread spans, oldest first, to out;
+ * returns how many were moved. Call while the pool is idle. */
+int  pool_trace_read     (pool_t* pool, int tid, pool_span_t* out, int max);
+
+/* Scratch arena of thread tid, or NULL without a pool */
+static inline arena_t* pool_arena(struct pool_t* pool, int tid)
+{
+  return (pool != NULL) ? &pool->workers[tid].scratch : NULL;
+}
+
+/* Split n elements into nthreads contiguous chunks whose boundaries fall
+ * on multiples of align elements; returns the chunk of thread tid. */
+static inline void
+pool_partition(size_t n, size_t align, int tid, int nthreads,
+               size_t* begin, size_t* end)
+{
+  size_t nblocks = (n + align - 1) / align;
+  size_t q       = nblocks / nthreads;
+  size_t r       = nblocks % nthreads;
+  size_t t       = (size_t)tid;
+
+  size_t b = t * q + (t < r ? t : r);
+  size_t e = b + q + (t < r ? 1 : 0);
+
+  *begin = (b * align) < n ? (b * align) : n;
+  *end   = (e * align) < n ? (e * align) : n;
+}
+
+#endif //__COMMON_POOL_H_
@@ -0,0 +1,192 @@
+/* roofline.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the machine-peak probe; see roofline.h.
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/types.h"
+#include "common/macros.h"
+#include "common/pool.h"
+#include "common/cpu.h"
+#include "common/roofline.h"
+
+typedef struct {
+  float*       a;
+  float*       b;
+  float*       c;
+  size_t       n;
+  float        scalar;
+} triad_args_t;
+
+static void triad_worker(int tid, int nthreads, void* args)
+{
+  triad_args_t* t = (triad_args_t*)args;
+  size_t begin, end;
+
+  pool_partition(t->n, 64 / sizeof(float), tid, nthreads, &begin, &end);
+
+  register       float* a = t->a;
+  register const float* b = t->b;
+  register const float* c = t->c;
+  register const float  s = t->scalar;
+
+  for (size_t i = begin; i < end; i++) {
+    a[i] = b[i] + s * c[i];
+  }
+}
+
+static void init_worker(int tid, int nthreads, void* args)
+{
+  triad_args_t* t = (triad_args_t*)args;
+  size_t begin, end;
+
+  /* First touch from the threads that will stream the arrays */
+  pool_partition(t->n, 64 / sizeof(float), tid, nthreads, &begin, &end);
+
+  for (size_t i = begin; i < end; i++) {
+    t->a[i] = 0.0f;
+    t->b[i] = 1.0f;
+    t->c[i] = 2.0f;
+  }
+}
+
+/* Results of the FMA probe, one per thread on its own cache line */
+typedef struct {
+  _Alignas(64) float sink;
+} fma_slot_t;
+
+/* Scalar probe: 10 independent multiply-add chains */
+static void fma_worker_scalar(int tid, int nthreads, void* args)
+{
+  fma_slot_t* slots = (fma_slot_t*)args;
+
+  float a[10];
+  for (int j = 0; j < 10; j++) a[j] = 1.0f;
+
+  for (int i = 0; i < ROOFLINE_FMA_ITERS; i++) {
+    for (int j = 0; j < 10; j++) a[j] = a[j] * 0.999999f + 1e-7f;
+  }
+
+  slots[tid].sink = a[0];
+}
+
+#if defined(__amd64__) || defined(__x86_64__)
+#pragma GCC push_options
+#pragma GCC target ("avx2,fma")
+
+static void fma_worker_avx2(int tid, int nthreads, void* args)
+{
+  fma_slot_t* slots = (fma_slot_t*)args;
+
+  /* 10 independent accumulators cover FMA latency x throughput */
+  __m256 x  = _mm256_set1_ps(0.999999f);
+  __m256 y  = _mm256_set1_ps(1e-7f);
+  __m256 a0 = _mm256_set1_ps(1.0f), a1 = a0, a2 = a0, a3 = a0, a4 = a0;
+  __m256 a5 = a0, a6 = a0, a7 = a0, a8 = a0, a9 = a0;
+
+  for (int i = 0; i < ROOFLINE_FMA_ITERS; i++) {
+    a0 = _mm256_fmadd_ps(a0, x, y); a1 = _mm256_fmadd_ps(a1, x, y);
+    a2 = _mm256_fmadd_ps(a2, x, y); a3 = _mm256_fmadd_ps(a3, x, y);
+    a4 = _mm256_fmadd_ps(a4, x, y); a5 = _mm256_fmadd_ps(a5, x, y);
+    a6 = _mm256_fmadd_ps(a6, x, y); a7 = _mm256_fmadd_ps(a7, x, y);
+    a8 = _mm256_fmadd_ps(a8, x, y); a9 = _mm256_fmadd_ps(a9, x, y);
+  }
+
+  __m256 sum = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(a0, a1),
+                                           _mm256_add_ps(a2, a3)),
+                             _mm256_add_ps(_mm256_add_ps(a4, a5),
+                                           _mm256_add_ps(_mm256_add_ps(a6, a7),
+                                                         _mm256_add_ps(a8, a9))));
+  float lanes[8];
+  _mm256_storeu_ps(lanes, sum);
+  slots[tid].sink = lanes[0];
+}
+
+#pragma GCC pop_options
+#endif
+
+/* FLOPs of one fma_worker_* call */
+#define ROOFLINE_FMA_FLOPS_SCALAR ((double)ROOFLINE_FMA_ITERS * 10 * 2)
+#define ROOFLINE_FMA_FLOPS_AVX2   ((double)ROOFLINE_FMA_ITERS * 10 * 8 * 2)
+
+static double now_ns(void)
+{
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+
+  return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+void roofline_probe(roofline_t* peak, pool_t* pool, int nthreads)
+{
+  /* Bandwidth */
+  triad_args_t t;
+
+  t.n      = ROOFLINE_STREAM_ELEMS;
+  t.scalar = 3.0f;
+  t.a      = __ALLOC_DATA(float, t.n);
+  t.b      = __ALLOC_DATA(float, t.n);
+  t.c      = __ALLOC_DATA(float, t.n);
+
+  pool_run(pool, nthreads, init_worker, &t);
+
+  double best = 0.0;
+  for (int r = 0; r < ROOFLINE_STREAM_REPS; r++) {
+    double start = now_ns();
+    pool_run(pool, nthreads, triad_worker, &t);
+    double ns = now_ns() - start;
+
+    double gbps = (3.0 * sizeof(float) * t.n) / ns;
+    if (gbps > best) best = gbps;
+  }
+  peak->bw_gbps = best;
+
+  __FREE_DATA(t.a);
+  __FREE_DATA(t.b);
+  __FREE_DATA(t.c);
+
+  /* Compute, with the widest FMA probe the dispatcher would use */
+  void (*fma_worker)(int, int, void*) = fma_worker_scalar;
+  double fma_flops                    = ROOFLINE_FMA_FLOPS_SCALAR;
+#if defined(__amd64__) || defined(__x86_64__)
+  if (cpu_isa_enabled(CPU_ISA_AVX2)) {
+    fma_worker = fma_worker_avx2;
+    fma_flops  = ROOFLINE_FMA_FLOPS_AVX2;
+  }
+#endif
+
+  fma_slot_t* slots = (fma_slot_t*)aligned_alloc(64, nthreads * sizeof(fma_slot_t));
+
+  best = 0.0;
+  for (int r = 0; r < ROOFLINE_FMA_REPS; r++) {
+    double start = now_ns();
+    pool_run(pool, nthreads, fma_worker, slots);
+    double ns = now_ns() - start;
+
+    double gflops = (fma_flops * nthreads) / ns;
+    if (gflops > best) best = gflops;
+  }
+  peak->gflops = best;
+
+  free(slots);
+}
+
+double roofline_attainable(const roofline_t* peak, double intensity)
+{
+  double mem = intensity * peak->bw_gbps;
+
+  return (mem < peak->gflops) ? mem : peak->gflops;
+}
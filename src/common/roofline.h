@@ -0,0 +1,45 @@
+/* roofline.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains a small machine-peak probe for roofline reporting.
+ * Two ceilings are measured once, with the same worker pool and thread
+ * count that the benchmark uses:
+ *
+ *   bandwidth : a STREAM-like triad (a[i] = b[i] + s * c[i]) over arrays
+ *               well beyond the last-level cache; the best of a few
+ *               repetitions, counting 12 bytes per element as STREAM does
+ *               (write-allocate traffic is not counted).
+ *   compute   : independent chains of single-precision FMAs held in
+ *               registers (AVX2 when available, scalar otherwise).
+ *
+ * A kernel with arithmetic intensity AI (ops per byte) can at best reach
+ * min(compute, AI * bandwidth); the driver reports against that.
+*/
+
+#ifndef __COMMON_ROOFLINE_H_
+#define __COMMON_ROOFLINE_H_
+
+#include <stddef.h>
+
+#include "common/pool.h"
+
+/* Probe sizes */
+#define ROOFLINE_STREAM_ELEMS  (16 * 1024 * 1024)  /* Per array (64 MiB) */
+#define ROOFLINE_STREAM_REPS   8
+#define ROOFLINE_FMA_ITERS     (1 << 22)
+#define ROOFLINE_FMA_REPS      4
+
+typedef struct {
+  double bw_gbps;     /* Sustainable memory bandwidth, GB/s */
+  double gflops;      /* Peak single-precision GFLOP/s      */
+} roofline_t;
+
+/* Measure both ceilings with nthreads threads of the pool */
+void   roofline_probe(roofline_t* peak, pool_t* pool, int nthreads);
+
+/* Attainable GFLOP/s for a kernel of the given arithmetic intensity */
+double roofline_attainable(const roofline_t* peak, double intensity);
+
+#endif //__COMMON_ROOFLINE_H_
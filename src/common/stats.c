@@ -0,0 +1,231 @@
+/* stats.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the runtime distribution statistics; see stats.h.
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Include common headers */
+#include "common/stats.h"
+
+static int cmp_double(const void* a, const void* b)
+{
+  double x = *(const double*)a;
+  double y = *(const double*)b;
+
+  return (x > y) - (x < y);
+}
+
+static uint64_t xorshift64(uint64_t* state)
+{
+  uint64_t x = *state;
+
+  x ^= x << 13;
+  x ^= x >>  7;
+  x ^= x << 17;
+
+  return *state = x;
+}
+
+double stats_percentile(const double* sorted, uint32_t n, double pct)
+{
+  if (n == 0) return 0.0;
+  if (n == 1) return sorted[0];
+
+  double rank = (pct / 100.0) * (n - 1);
+  uint32_t lo = (uint32_t)floor(rank);
+  uint32_t hi = (lo + 1 < n) ? lo + 1 : lo;
+  double frac = rank - lo;
+
+  return sorted[lo] + frac * (sorted[hi] - sorted[lo]);
+}
+
+void stats_compute(stats_t* s, const uint64_t* runtimes, uint32_t n)
+{
+  memset(s, 0, sizeof(*s));
+  s->n = n;
+
+  if (n == 0) return;
+
+  double* sorted = (double*)malloc(n * sizeof(double));
+  double* dev    = (double*)malloc(n * sizeof(double));
+  double* means  = (double*)malloc(STATS_BOOTSTRAP_RESAMPLES * sizeof(double));
+
+  /* Moments */
+  double sum = 0.0;
+  for (uint32_t i = 0; i < n; i++) {
+    sorted[i] = (double)runtimes[i];
+    sum += sorted[i];
+  }
+  s->mean = sum / n;
+
+  double var = 0.0;
+  for (uint32_t i = 0; i < n; i++) {
+    var += (sorted[i] - s->mean) * (sorted[i] - s->mean);
+  }
+  s->stdev = (n > 1) ? sqrt(var / (n - 1)) : 0.0;
+
+  /* Order statistics */
+  qsort(sorted, n, sizeof(double), cmp_double);
+
+  s->min    = sorted[0];
+  s->max    = sorted[n - 1];
+  s->median = stats_percentile(sorted, n, 50.0);
+  s->p50    = s->median;
+  s->p90    = stats_percentile(sorted, n, 90.0);
+  s->p99    = stats_percentile(sorted, n, 99.0);
+  s->p999   = stats_percentile(sorted, n, 99.9);
+
+  for (uint32_t i = 0; i < n; i++) {
+    dev[i] = fabs(sorted[i] - s->median);
+  }
+  qsort(dev, n, sizeof(double), cmp_double);
+  s->mad = stats_percentile(dev, n, 50.0);
+
+  /* Percentile bootstrap of the mean */
+  uint64_t state = 0x9e3779b97f4a7c15llu;
+  for (int r = 0; r < STATS_BOOTSTRAP_RESAMPLES; r++) {
+    double acc = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+      acc += sorted[xorshift64(&state) % n];
+    }
+    means[r] = acc / n;
+  }
+  qsort(means, STATS_BOOTSTRAP_RESAMPLES, sizeof(double), cmp_double);
+
+  double tail = (1.0 - STATS_CI_LEVEL) / 2.0 * 100.0;
+  s->ci_lo = stats_percentile(means, STATS_BOOTSTRAP_RESAMPLES,         tail);
+  s->ci_hi = stats_percentile(means, STATS_BOOTSTRAP_RESAMPLES, 100.0 - tail);
+
+  free(sorted);
+  free(dev);
+  free(means);
+}
+
+/* A sample of either side, for ranking the two together */
+typedef struct {
+  uint64_t v;
+  int      side;
+} stats_rank_t;
+
+static int cmp_rank(const void* a, const void* b)
+{
+  uint64_t x = ((const stats_rank_t*)a)->v;
+  uint64_t y = ((const stats_rank_t*)b)->v;
+
+  return (x > y) - (x < y);
+}
+
+double stats_mann_whitney(const uint64_t* a, uint32_t na,
+                          const uint64_t* b, uint32_t nb)
+{
+  if (na == 0 || nb == 0) return 1.0;
+
+  size_t        n   = (size_t)na + nb;
+  stats_rank_t* all = (stats_rank_t*)malloc(n * sizeof(stats_rank_t));
+
+  for (uint32_t i = 0; i < na; i++) { all[i     ].v = a[i]; all[i     ].side = 0; }
+  for (uint32_t i = 0; i < nb; i++) { all[na + i].v = b[i]; all[na + i].side = 1; }
+
+  qsort(all, n, sizeof(stats_rank_t), cmp_rank);
+
+  /* Rank sum of a; ties share their average rank */
+  double ra   = 0.0;
+  double ties = 0.0;
+
+  for (size_t i = 0; i < n; ) {
+    size_t j = i;
+    while (j < n && all[j].v == all[i].v) j++;
+
+    double t    = (double)(j - i);
+    double rank = (i + 1 + j) / 2.0;
+
+    for (size_t k = i; k < j; k++) {
+      if (all[k].side == 0) ra += rank;
+    }
+    ties += t * t * t - t;
+
+    i = j;
+  }
+
+  free(all);
+
+  double u    = ra - (double)na * (na + 1) / 2.0;
+  double mean = (double)na * nb / 2.0;
+  double var  = (double)na * nb / 12.0 *
+                ((n + 1) - ties / ((double)n * (n - 1)));
+
+  if (var <= 0.0) return 1.0;
+
+  /* Normal approximation with continuity correction */
+  double d = fabs(u - mean) - 0.5;
+  double z = (d > 0.0 ? d : 0.0) / sqrt(var);
+
+  return erfc(z / sqrt(2.0));
+}
+
+void stats_print(const stats_t* s, const char* indent)
+{
+  printf("%s- min    = %.1f ns\n", indent, s->min);
+  printf("%s- median = %.1f ns (MAD = %.1f ns)\n", indent, s->median, s->mad);
+  printf("%s- p90    = %.1f ns\n", indent, s->p90);
+  printf("%s- p99    = %.1f ns\n", indent, s->p99);
+  printf("%s- p99.9  = %.1f ns\n", indent, s->p999);
+  printf("%s- max    = %.1f ns\n", indent, s->max);
+  printf("%s- mean   = %.1f ns (stdev = %.1f ns)\n", indent, s->mean, s->stdev);
+  printf("%s- %2.0f%% CI = [%.1f, %.1f] ns\n", indent,
+         STATS_CI_LEVEL * 100.0, s->ci_lo, s->ci_hi);
+}
+
+void stats_dump(const stats_t* s, FILE* fp)
+{
+  fprintf(fp, "\n");
+  fprintf(fp, "min,%.3f", s->min);
+  fprintf(fp, "\n");
+  fprintf(fp, "median,%.3f", s->median);
+  fprintf(fp, "\n");
+  fprintf(fp, "mad,%.3f", s->mad);
+  fprintf(fp, "\n");
+  fprintf(fp, "p90,%.3f", s->p90);
+  fprintf(fp, "\n");
+  fprintf(fp, "p99,%.3f", s->p99);
+  fprintf(fp, "\n");
+  fprintf(fp, "p99.9,%.3f", s->p999);
+  fprintf(fp, "\n");
+  fprintf(fp, "max,%.3f", s->max);
+  fprintf(fp, "\n");
+  fprintf(fp, "mean,%.3f", s->mean);
+  fprintf(fp, "\n");
+  fprintf(fp, "stdev,%.3f", s->stdev);
+  fprintf(fp, "\n");
+  fprintf(fp, "ci_lo,%.3f", s->ci_lo);
+  fprintf(fp, "\n");
+  fprintf(fp, "ci_hi,%.3f", s->ci_hi);
+}
+
+void stats_json(const stats_t* s, FILE* fp)
+{
+  fprintf(fp, "{");
+  fprintf(fp, "\"n\": %u, ", s->n);
+  fprintf(fp, "\"min\": %.3f, ", s->min);
+  fprintf(fp, "\"median\": %.3f, ", s->median);
+  fprintf(fp, "\"mad\": %.3f, ", s->mad);
+  fprintf(fp, "\"p50\": %.3f, ", s->p50);
+  fprintf(fp, "\"p90\": %.3f, ", s->p90);
+  fprintf(fp, "\"p99\": %.3f, ", s->p99);
+  fprintf(fp, "\"p99_9\": %.3f, ", s->p999);
+  fprintf(fp, "\"max\": %.3f, ", s->max);
+  fprintf(fp, "\"mean\": %.3f, ", s->mean);
+  fprintf(fp, "\"stdev\": %.3f, ", s->stdev);
+  fprintf(fp, "\"ci_level\": %.2f, ", STATS_CI_LEVEL);
+  fprintf(fp, "\"ci_lo\": %.3f, ", s->ci_lo);
+  fprintf(fp, "\"ci_hi\": %.3f", s->ci_hi);
+  fprintf(fp, "}");
+}
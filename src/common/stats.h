@@ -0,0 +1,67 @@
+/* stats.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains distribution statistics over per-run runtimes. All
+ * values are computed in double precision from a sorted copy of the
+ * samples, so nothing is truncated and outliers are kept: the tail is
+ * the point of percentiles.
+ *
+ * The confidence interval is a percentile bootstrap of the mean, using a
+ * private xorshift generator with a fixed seed so that it neither
+ * consumes nor perturbs rand() and is reproducible across runs.
+ *
+ * Two sets of runtimes are compared with the Mann-Whitney U test, which
+ * assumes nothing about the shape of either distribution; the p-value
+ * comes from the normal approximation with a tie correction, so it is
+ * only meaningful from about ten runs per side.
+*/
+
+#ifndef __COMMON_STATS_H_
+#define __COMMON_STATS_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+/* Bootstrap parameters */
+#define STATS_BOOTSTRAP_RESAMPLES 1000
+#define STATS_CI_LEVEL            0.95
+
+typedef struct {
+  uint32_t n;
+
+  double   min;
+  double   max;
+  double   mean;
+  double   stdev;
+
+  double   median;
+  double   mad;         /* Median absolute deviation (unscaled) */
+
+  double   p50;
+  double   p90;
+  double   p99;
+  double   p999;
+
+  double   ci_lo;       /* Bootstrap CI of the mean at STATS_CI_LEVEL */
+  double   ci_hi;
+} stats_t;
+
+/* Percentile (0..100) of an ascending array, linearly interpolated */
+double stats_percentile(const double* sorted, uint32_t n, double pct);
+
+/* Compute every field of s from n runtimes */
+void   stats_compute(stats_t* s, const uint64_t* runtimes, uint32_t n);
+
+/* Two-sided p-value of the Mann-Whitney U test that a and b come from
+ * the same distribution; 1 when either side is empty */
+double stats_mann_whitney(const uint64_t* a, uint32_t na,
+                          const uint64_t* b, uint32_t nb);
+
+/* Human-readable summary, CSV rows (name,value) and a JSON object */
+void   stats_print(const stats_t* s, const char* indent);
+void   stats_dump (const stats_t* s, FILE* fp);
+void   stats_json (const stats_t* s, FILE* fp);
+
+#endif //__COMMON_STATS_H_
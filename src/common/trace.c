@@ -0,0 +1,269 @@
+/* trace.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the per-thread analysis of parallel runs; see
+ * trace.h.
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* Include common headers */
+#include "common/pool.h"
+#include "common/trace.h"
+
+int trace_init(trace_t* t, int nthreads)
+{
+  memset(t, 0, sizeof(*t));
+
+  t->nthreads = nthreads;
+  t->busy     = (double*     )calloc(nthreads, sizeof(double));
+  t->delay    = (double*     )calloc(nthreads, sizeof(double));
+  t->wait     = (double*     )calloc(nthreads, sizeof(double));
+  t->count    = (uint64_t*   )calloc(nthreads, sizeof(uint64_t));
+  t->spans    = (pool_span_t*)malloc(TRACE_MAX_SPANS * sizeof(pool_span_t));
+  t->tids     = (int*        )malloc(TRACE_MAX_SPANS * sizeof(int));
+  t->buf      = (pool_span_t*)malloc((size_t)nthreads * POOL_TRACE_SPANS *
+                                     sizeof(pool_span_t));
+  t->nbuf     = (int*        )calloc(nthreads, sizeof(int));
+
+  if (!t->busy || !t->delay || !t->wait || !t->count || !t->spans ||
+      !t->tids || !t->buf || !t->nbuf) {
+    trace_destroy(t);
+    return -1;
+  }
+
+  return 0;
+}
+
+void trace_reset(trace_t* t)
+{
+  int nthreads = t->nthreads;
+
+  t->nregions   = 0;
+  t->region_sum = 0;
+  t->imb_sum    = 0;
+  t->imb_max    = 0;
+  t->fork_sum   = 0;
+  t->fork_max   = 0;
+  t->wait_sum   = 0;
+  t->lost       = 0;
+  t->nspans     = 0;
+
+  memset(t->busy , 0, nthreads * sizeof(double));
+  memset(t->delay, 0, nthreads * sizeof(double));
+  memset(t->wait , 0, nthreads * sizeof(double));
+  memset(t->count, 0, nthreads * sizeof(uint64_t));
+}
+
+/* Fold one fork/join: span[i] is thread i's */
+static void trace_fold(trace_t* t, pool_span_t* const* span, int n)
+{
+  const pool_span_t* s0 = span[0];
+
+  double busy_sum = 0, busy_max = 0, fork_sum = 0, fork_max = 0, wait_sum = 0;
+
+  for (int i = 0; i < n; i++) {
+    double busy  = (double)(span[i]->end   - span[i]->start);
+    double delay = (double)(span[i]->start - s0->fork);
+    double wait  = (double)(s0->join       - span[i]->end);
+
+    busy_sum += busy;
+    wait_sum += wait;
+    if (busy > busy_max) busy_max = busy;
+
+    if (i > 0) {
+      fork_sum += delay;
+      if (delay > fork_max) fork_max = delay;
+    }
+
+    t->busy [i] += busy;
+    t->delay[i] += delay;
+    t->wait [i] += wait;
+    t->count[i] += 1;
+
+    if (t->nspans < TRACE_MAX_SPANS) {
+      t->spans[t->nspans] = *span[i];
+      t->tids [t->nspans] = i;
+      t->nspans++;
+    }
+  }
+
+  double imb = (busy_sum > 0) ? busy_max / (busy_sum / n) : 1.0;
+
+  t->nregions++;
+  t->region_sum += (double)(s0->join - s0->fork);
+  t->imb_sum    += imb;
+  t->wait_sum   += wait_sum / n;
+  if (imb > t->imb_max) t->imb_max = imb;
+
+  if (n > 1) {
+    t->fork_sum += fork_sum / (n - 1);
+    if (fork_max > t->fork_max) t->fork_max = fork_max;
+  }
+}
+
+void trace_collect(trace_t* t, pool_t* pool)
+{
+  if (pool == NULL) return;
+
+  int nthreads = pool->nthreads;
+
+  /* Drain everything, even when dropping */
+  if (t == NULL) {
+    pool_span_t span;
+
+    for (int i = 0; i < nthreads; i++) {
+      while (pool_trace_read(pool, i, &span, 1) > 0) { }
+    }
+    return;
+  }
+
+  if (nthreads > t->nthreads) nthreads = t->nthreads;
+
+  for (int i = 0; i < nthreads; i++) {
+    uint64_t lost = pool->workers[i].ring.lost;
+
+    t->nbuf[i] = pool_trace_read(pool, i, &t->buf[(size_t)i * POOL_TRACE_SPANS],
+                                 POOL_TRACE_SPANS);
+    t->lost   += pool->workers[i].ring.lost - lost;
+  }
+
+  /* Thread 0 closes every fork/join; the others' spans of it come in
+   * the same order */
+  int          cur[nthreads];
+  pool_span_t* span[nthreads];
+
+  memset(cur, 0, sizeof(cur));
+
+  for (int j = 0; j < t->nbuf[0]; j++) {
+    pool_span_t* s0 = &t->buf[j];
+    int          n  = s0->nthreads;
+    bool         ok = (n <= nthreads);
+
+    span[0] = s0;
+
+    for (int i = 1; ok && i < n; i++) {
+      pool_span_t* bi = &t->buf[(size_t)i * POOL_TRACE_SPANS];
+
+      while (cur[i] < t->nbuf[i] && (int)(bi[cur[i]].seq - s0->seq) < 0) cur[i]++;
+
+      if (cur[i] < t->nbuf[i] && bi[cur[i]].seq == s0->seq) {
+        span[i] = &bi[cur[i]++];
+      } else {
+        ok = false;
+      }
+    }
+
+    if (ok) trace_fold(t, span, n);
+    else    t->lost++;
+  }
+}
+
+void trace_print(const trace_t* t, const char* indent)
+{
+  if (t->nregions == 0) {
+    printf("%s- No fork/joins recorded\n", indent);
+    return;
+  }
+
+  double n      = (double)t->nregions;
+  double region = t->region_sum / n;
+  double wait   = t->wait_sum / n;
+
+  printf("%s- Fork/joins = %" PRIu64 " (region = %.1f ns on average)\n",
+         indent, t->nregions, region);
+  printf("%s- Imbalance (max/mean busy) = %.3f (worst = %.3f)\n", indent,
+         t->imb_sum / n, t->imb_max);
+  printf("%s- Fork latency = %.1f ns (worst = %.1f ns)\n", indent,
+         t->fork_sum / n, t->fork_max);
+  printf("%s- Barrier wait = %.1f ns per thread (%.1f%% of the region)\n",
+         indent, wait, (region > 0) ? 100.0 * wait / region : 0.0);
+  if (t->lost > 0) {
+    printf("%s- Incomplete or overwritten spans = %" PRIu64 "\n", indent, t->lost);
+  }
+
+  printf("%s  %6s %16s %16s %16s\n", indent, "thread", "busy (ns)",
+         "start (ns)", "wait (ns)");
+  for (int i = 0; i < t->nthreads; i++) {
+    if (t->count[i] == 0) continue;
+
+    double c = (double)t->count[i];
+
+    printf("%s  %6d %16.1f %16.1f %16.1f\n", indent, i, t->busy[i] / c,
+           t->delay[i] / c, t->wait[i] / c);
+  }
+}
+
+void trace_json(const trace_t* t, FILE* fp)
+{
+  double n = (t->nregions > 0) ? (double)t->nregions : 1.0;
+
+  fprintf(fp, "{");
+  fprintf(fp, "\"regions\": %" PRIu64 ", ", t->nregions);
+  fprintf(fp, "\"region_ns\": %.1f, ", t->region_sum / n);
+  fprintf(fp, "\"imbalance\": %.4f, ", t->imb_sum / n);
+  fprintf(fp, "\"imbalance_max\": %.4f, ", t->imb_max);
+  fprintf(fp, "\"fork_ns\": %.1f, ", t->fork_sum / n);
+  fprintf(fp, "\"fork_max_ns\": %.1f, ", t->fork_max);
+  fprintf(fp, "\"wait_ns\": %.1f, ", t->wait_sum / n);
+  fprintf(fp, "\"lost\": %" PRIu64 "", t->lost);
+  fprintf(fp, "}");
+}
+
+/* One complete ("X") event, in us from t0 */
+static void trace_event(FILE* fp, bool* first, const char* name, int tid,
+                        unsigned seq, uint64_t t0, uint64_t from, uint64_t to)
+{
+  fprintf(fp, "%s\n  {\"name\": \"%s\", \"ph\": \"X\", \"pid\": 0, \"tid\": %d, "
+          "\"ts\": %.3f, \"dur\": %.3f, \"args\": {\"seq\": %u}}",
+          *first ? "" : ",", name, tid, (from - t0) / 1e3, (to - from) / 1e3, seq);
+  *first = false;
+}
+
+void trace_chrome(const trace_t* t, const char* name, FILE* fp)
+{
+  uint64_t t0    = (t->nspans > 0) ? t->spans[0].fork : 0;
+  bool     first = true;
+
+  fprintf(fp, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+
+  for (int i = 0; i < t->nthreads; i++) {
+    fprintf(fp, "%s\n  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, "
+            "\"tid\": %d, \"args\": {\"name\": \"%s %d\"}}",
+            first ? "" : ",", i, i ? "worker" : "caller", i);
+    first = false;
+  }
+
+  for (size_t k = 0; k < t->nspans; k++) {
+    const pool_span_t* s   = &t->spans[k];
+    int                tid = t->tids[k];
+
+    /* The caller forks, runs its share and joins; a worker wakes up and
+     * runs its share */
+    trace_event(fp, &first, tid ? "wake" : "fork", tid, s->seq, t0, s->fork, s->start);
+    trace_event(fp, &first, name, tid, s->seq, t0, s->start, s->end);
+    if (tid == 0) trace_event(fp, &first, "join", tid, s->seq, t0, s->end, s->join);
+  }
+
+  fprintf(fp, "\n]}\n");
+}
+
+void trace_destroy(trace_t* t)
+{
+  free(t->busy);
+  free(t->delay);
+  free(t->wait);
+  free(t->count);
+  free(t->spans);
+  free(t->tids);
+  free(t->buf);
+  free(t->nbuf);
+
+  memset(t, 0, sizeof(*t));
+}
@@ -0,0 +1,79 @@
+/* trace.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the per-thread analysis of parallel runs (--trace).
+ * The spans the worker pool records for every fork/join (common/pool.h)
+ * are drained after each timed run and folded into, per fork/join:
+ *
+ *   imbalance     the busiest thread's share over the mean share; 1 is a
+ *                 perfect split
+ *   fork latency  from the caller's fork to a worker starting its share
+ *                 (the wake-up cost of the pool)
+ *   barrier wait  from a thread finishing its share to the join, i.e.
+ *                 time spent waiting for the stragglers
+ *
+ * plus per-thread means, which show whether one thread is always late.
+ * The first TRACE_MAX_SPANS spans are kept for a Chrome trace (the JSON
+ * event format that chrome://tracing and Perfetto load).
+*/
+
+#ifndef __COMMON_TRACE_H_
+#define __COMMON_TRACE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "common/pool.h"
+
+/* Spans kept for the Chrome trace, per implementation and case */
+#define TRACE_MAX_SPANS (1 << 16)
+
+typedef struct {
+  int          nthreads;
+
+  /* Fork/joins seen, and sums over them */
+  uint64_t     nregions;
+  double       region_sum;      /* Fork to join                       */
+  double       imb_sum;
+  double       imb_max;
+  double       fork_sum;        /* Mean fork latency of the workers   */
+  double       fork_max;
+  double       wait_sum;        /* Mean barrier wait of the threads   */
+  uint64_t     lost;            /* Spans overwritten before a drain   */
+
+  /* Per thread: sums over the fork/joins it took part in */
+  double*      busy;
+  double*      delay;
+  double*      wait;
+  uint64_t*    count;
+
+  /* Spans for the Chrome trace, with their threads */
+  pool_span_t* spans;
+  int*         tids;
+  size_t       nspans;
+
+  /* Drain buffer */
+  pool_span_t* buf;
+  int*         nbuf;
+} trace_t;
+
+/* Allocate for nthreads threads; 0 on success */
+int  trace_init   (trace_t* t, int nthreads);
+
+/* Forget everything folded in so far */
+void trace_reset  (trace_t* t);
+
+/* Drain the pool's rings and fold the complete fork/joins in; t = NULL
+ * only drops the spans */
+void trace_collect(trace_t* t, pool_t* pool);
+
+/* Summary lines, the same as a JSON object, and the Chrome trace */
+void trace_print  (const trace_t* t, const char* indent);
+void trace_json   (const trace_t* t, FILE* fp);
+void trace_chrome (const trace_t* t, const char* name, FILE* fp);
+
+void trace_destroy(trace_t* t);
+
+#endif //__COMMON_TRACE_H_
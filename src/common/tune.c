@@ -0,0 +1,154 @@
+/* tune.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the tunables cache; see tune.h.
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/* Include common headers */
+#include "common/cpu.h"
+#include "common/tune.h"
+
+/* Fields of one record */
+enum { TUNE_MACHINE, TUNE_BENCH, TUNE_CASE, TUNE_THREADS, TUNE_PARAM,
+       TUNE_VALUE, TUNE_NFIELDS };
+
+const char* tune_machine(void)
+{
+  static char key[160];
+
+  if (key[0] == '\0') {
+    snprintf(key, sizeof(key), "%s / L1d %zu KiB / L2 %zu KiB / L3 %zu KiB",
+             cpu_model(), cpu_cache_bytes(1) >> 10, cpu_cache_bytes(2) >> 10,
+             cpu_cache_bytes(3) >> 10);
+  }
+
+  return key;
+}
+
+/* Split a record in place; false for comments and malformed lines */
+static bool tune_split(char* line, char* fields[TUNE_NFIELDS])
+{
+  line[strcspn(line, "\r\n")] = '\0';
+
+  if (line[0] == '#' || line[0] == '\0') return false;
+
+  for (int f = 0; f < TUNE_NFIELDS; f++) {
+    fields[f] = line;
+    line += strcspn(line, "\t");
+
+    if (f < TUNE_NFIELDS - 1) {
+      if (*line != '\t') return false;
+      *(line++) = '\0';
+    }
+  }
+
+  return *line == '\0';
+}
+
+/* The record is for this machine, bench, case and thread count */
+static bool tune_match(char* const fields[TUNE_NFIELDS], const char* bench,
+                       const char* label, int nthreads)
+{
+  return strcmp(fields[TUNE_MACHINE], tune_machine()) == 0 &&
+         strcmp(fields[TUNE_BENCH]  , bench         ) == 0 &&
+         strcmp(fields[TUNE_CASE]   , label         ) == 0 &&
+         atoi  (fields[TUNE_THREADS]) == nthreads;
+}
+
+int tune_load(const char* path, const char* bench, const char* label,
+              int nthreads, const tune_param_t* params, int n)
+{
+  FILE* fp = fopen(path, "r");
+
+  if (fp == NULL) return 0;
+
+  if (label == NULL) label = "-";
+
+  char line[512];
+  int  nset = 0;
+
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    char* fields[TUNE_NFIELDS];
+
+    if (!tune_split(line, fields) || !tune_match(fields, bench, label, nthreads)) {
+      continue;
+    }
+
+    for (int p = 0; p < n; p++) {
+      if (strcmp(fields[TUNE_PARAM], params[p].name) == 0) {
+        *params[p].value = atoi(fields[TUNE_VALUE]);
+        nset++;
+      }
+    }
+  }
+
+  fclose(fp);
+
+  return nset;
+}
+
+int tune_save(const char* path, const char* bench, const char* label,
+              int nthreads, const tune_param_t* params, int n)
+{
+  char tmp[512];
+
+  if (label == NULL) label = "-";
+
+  /* Rewrite through a temporary, so a reader never sees half a file */
+  snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+
+  FILE* out = fopen(tmp, "w");
+  if (out == NULL) return -1;
+
+  fprintf(out, "# machine\tbench\tcase\tthreads\tparam\tvalue\n");
+
+  /* Keep every other record */
+  FILE* in = fopen(path, "r");
+
+  if (in != NULL) {
+    char line[512];
+    char copy[512];
+
+    while (fgets(line, sizeof(line), in) != NULL) {
+      char* fields[TUNE_NFIELDS];
+      bool  keep = true;
+
+      memcpy(copy, line, sizeof(copy));
+
+      if (!tune_split(copy, fields)) continue;
+
+      if (tune_match(fields, bench, label, nthreads)) {
+        for (int p = 0; p < n; p++) {
+          if (strcmp(fields[TUNE_PARAM], params[p].name) == 0) keep = false;
+        }
+      }
+
+      if (keep) {
+        fputs(line, out);
+        if (line[strlen(line) - 1] != '\n') fputc('\n', out);
+      }
+    }
+
+    fclose(in);
+  }
+
+  for (int p = 0; p < n; p++) {
+    fprintf(out, "%s\t%s\t%s\t%d\t%s\t%d\n", tune_machine(), bench, label,
+            nthreads, params[p].name, *params[p].value);
+  }
+
+  if (fclose(out) != 0 || rename(tmp, path) != 0) {
+    remove(tmp);
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,55 @@
+/* tune.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the runtime tunables of the kernels (block sizes,
+ * unroll factors, work granularity, ...) and their on-disk cache. A
+ * benchmark lists them in driver_bench_t.tunables; each points at the
+ * int its kernel reads instead of a hardcoded constant. With --autotune
+ * the driver searches every tunable of the chosen implementations on
+ * each case and stores the winners; every later run loads them at
+ * startup (see common/driver.h).
+ *
+ * The cache is a text file of tab separated records,
+ *
+ *   machine  bench  case  threads  param  value
+ *
+ * keyed by the processor model and its cache sizes (tune_machine()), so
+ * one file can be shared by a fleet of different machines. A tunable
+ * without a record keeps the kernel's default.
+*/
+
+#ifndef __COMMON_TUNE_H_
+#define __COMMON_TUNE_H_
+
+#include <stddef.h>
+
+/* Most tunables of one benchmark */
+#define TUNE_MAX_PARAMS 16
+
+/* Default cache file, in the working directory */
+#define TUNE_CACHE_DEFAULT "tune.cache"
+
+typedef struct {
+  const char* name;     /* Name in the cache and in reports ("opt.block")  */
+  const char* impl;     /* Implementation (-i name) whose kernel reads it  */
+  int*        value;    /* The live value                                  */
+  const int*  cands;    /* Candidates the search tries, in order           */
+  int         ncands;
+} tune_param_t;
+
+/* This machine's key in the cache: processor model and cache sizes */
+const char* tune_machine(void);
+
+/* Set the tunables that have a record for this machine, bench, case and
+ * thread count; returns how many were set (0 without a cache file) */
+int         tune_load(const char* path, const char* bench, const char* label,
+                      int nthreads, const tune_param_t* params, int n);
+
+/* Record the current values, replacing older records of the same key;
+ * 0 on success */
+int         tune_save(const char* path, const char* bench, const char* label,
+                      int nthreads, const tune_param_t* params, int n);
+
+#endif //__COMMON_TUNE_H_
@@ -7,23 +7,46 @@
 */
 
 /* SIMD header file  */
+#include <math.h>
 #if defined(__amd64__) || defined(__x86_64__)
 #include <immintrin.h>
 #elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
 #include <arm_neon.h>
+#if defined(__ARM_FEATURE_SVE)
+#include <arm_sve.h>
+#endif
 #endif
 
 #ifndef __COMMON_VMATH_H_
 #define __COMMON_VMATH_H_
 
-#if defined(__amd64__) || defined(__x86_64__)
+/* Precision tiers for log/exp. Every function exists in both tiers under
+ * its own name (_mm256_log_ps / _mm256_log_fast_ps, ...); the VMATH_LOG*
+ * and VMATH_EXP* macros, and everything built on them (CNDF, erf), use the
+ * tier chosen at compile time with -DVMATH_TIER=... (make VMATH=fast):
+ *
+ *   VMATH_TIER_ACCURATE  Cephes polynomials, 1 ULP, special values handled
+ *   VMATH_TIER_FAST      shorter minimax polynomials, 2 ULP, finite
+ *                        positive normal inputs only for log
+ *
+ * src/vmath_bench measures cycles/element and the max error of each. */
+#define VMATH_TIER_ACCURATE 0
+#define VMATH_TIER_FAST     1
+
+#ifndef VMATH_TIER
+#define VMATH_TIER VMATH_TIER_ACCURATE
+#endif
+
+/* The x86 kernels need AVX2/FMA: include this only from vec.avx2.c-style
+ * translation units, which the Makefile builds with -mavx2 -mfma */
+#if defined(__AVX2__)
 
 /* ********************************************** *
  * Based on the SSE/SSE2 implementation of log_ps *
  * by\ Julien Pommier                             *
  * Website\ http://gruntthepeon.free.fr/ssemath/  *
  * ********************************************** */
-__m256 _mm256_log_ps(__m256 x)
+static inline __m256 _mm256_log_ps(__m256 x)
 {
   /* log(x) = NAN, where x is less-than-or-equal to zero */
   __m256 invalid_mask = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LE_OS);
@@ -88,30 +111,25 @@ __m256 _mm256_log_ps(__m256 x)
   return x;
 }
 
-__m256 _mm256_approx_log_ps(__m256 x)
+static inline __m256 _mm256_approx_log_ps(__m256 x)
 {
-  /* Perform an approximation */
-  /* log(x) = 2 * (sum(0, inf)((1 / 2n + 1) * ((x + 1) / (x - 1)) ^ 2n+1) */
-
-  __m256 ret = _mm256_setzero_ps();
+  /* Perform an approximation; only accurate for x close to 1 */
+  /* log(x) = 2 * (sum(0, inf)((1 / 2n + 1) * ((x - 1) / (x + 1)) ^ 2n+1) */
 
   /* Constants */
   __m256 one = _mm256_set1_ps(1.0f);
-  __m256 two = _mm256_set1_ps(2.0f);
   __m256 rN  = _mm256_sub_ps(x, one);
   __m256 rD  = _mm256_add_ps(x, one);
   __m256 r   = _mm256_div_ps(rN, rD);
   __m256 r2  = _mm256_mul_ps(r, r);
 
-  __m256 e   = r;
+  /* 4 terms in Horner form: 2/1 + r^2 (2/3 + r^2 (2/5 + r^2 2/7)) */
+  __m256 ret = _mm256_set1_ps(2.0f / 7.0f);
+  ret = _mm256_fmadd_ps(ret, r2, _mm256_set1_ps(2.0f / 5.0f));
+  ret = _mm256_fmadd_ps(ret, r2, _mm256_set1_ps(2.0f / 3.0f));
+  ret = _mm256_fmadd_ps(ret, r2, _mm256_set1_ps(2.0f));
 
-  for (int i = 0; i < 4; i++) {
-    __m256 c  = _mm256_div_ps(two, _mm256_set1_ps((float)((2 * i) + 1)));
-    ret = _mm256_add_ps(ret, _mm256_mul_ps(c, e));
-    e = _mm256_mul_ps(e, r2);
-  }
-
-  return ret;
+  return _mm256_mul_ps(ret, r);
 }
 
 /* ********************************************** *
@@ -119,7 +137,7 @@ __m256 _mm256_approx_log_ps(__m256 x)
  * by\ Julien Pommier                             *
  * Website\ http://gruntthepeon.free.fr/ssemath/  *
  * ********************************************** */
-__m256 _mm256_exp_ps(__m256 x)
+static inline __m256 _mm256_exp_ps(__m256 x)
 {
   __m256 tmp = _mm256_setzero_ps(), fx;
   __m256i imm0;
@@ -169,14 +187,635 @@ __m256 _mm256_exp_ps(__m256 x)
   return y;
 }
 
-#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+/* ********************************************** *
+ * Fast tier. Same range reductions, shorter      *
+ * minimax polynomials (fitted with Lawson's      *
+ * iteration over the reduced interval) and no    *
+ * special-value fixups: inputs must be positive  *
+ * normal floats for log; exp clamps its input to *
+ * [-87.33, 88.37], the normal-result range.      *
+ * ********************************************** */
+static inline __m256 _mm256_log_fast_ps(__m256 x)
+{
+  /* x = m * 2^e, m in [sqrt(1/2), sqrt(2)), by integer arithmetic */
+  __m256i ix = _mm256_sub_epi32(_mm256_castps_si256(x), _mm256_set1_epi32(0x3f3504f3));
+  __m256  e  = _mm256_cvtepi32_ps(_mm256_srai_epi32(ix, 23));
+  ix = _mm256_and_si256(ix, _mm256_set1_epi32(0x007fffff));
+  ix = _mm256_add_epi32(ix, _mm256_set1_epi32(0x3f3504f3));
+  x  = _mm256_sub_ps(_mm256_castsi256_ps(ix), _mm256_set1_ps(1.0f));
+
+  /* log(1 + x) = x - x^2 / 2 + x^3 * P(x) */
+  __m256 z = _mm256_mul_ps(x, x);
+
+  __m256 y = _mm256_set1_ps(8.7004306819e-2f);
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.4267486260e-1f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps( 1.4914769207e-1f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.6577584763e-1f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps( 1.9963063698e-1f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-2.5001337036e-1f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps( 3.3333910739e-1f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-0.5f));
+  y = _mm256_mul_ps(y, z);
+
+  /* + e * log(2), in two parts */
+  y = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), y);
+  y = _mm256_add_ps(y, x);
+  return _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), y);
+}
+
+static inline __m256 _mm256_exp_fast_ps(__m256 x)
+{
+  x = _mm256_min_ps(x, _mm256_set1_ps( 88.3762626647949f));
+  x = _mm256_max_ps(x, _mm256_set1_ps(-87.3365402221680f));
+
+  /* exp(x) = exp(g + n * log(2)), n = round(x / log(2)) */
+  __m256 fx = _mm256_mul_ps(x, _mm256_set1_ps(1.44269504088896341f));
+  fx = _mm256_round_ps(fx, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+  x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), x);
+  x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), x);
+
+  /* exp(g) = 1 + g + g^2 * P(g) */
+  __m256 y = _mm256_set1_ps(8.3125214507e-3f);
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1890146703e-2f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6667114605e-1f));
+  y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.9999231563e-1f));
+  y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), x);
+  y = _mm256_add_ps(y, _mm256_set1_ps(1.0f));
+
+  /* build 2^n */
+  __m256i imm0 = _mm256_cvtps_epi32(fx);
+  imm0 = _mm256_add_epi32(imm0, _mm256_set1_epi32(0x7f));
+  imm0 = _mm256_slli_epi32(imm0, 23);
+  return _mm256_mul_ps(y, _mm256_castsi256_ps(imm0));
+}
+
+/* Tier selected at compile time (VMATH_TIER, see the top of this file) */
+#if VMATH_TIER == VMATH_TIER_FAST
+#define VMATH_LOG256(x) _mm256_log_fast_ps(x)
+#define VMATH_EXP256(x) _mm256_exp_fast_ps(x)
+#else
+#define VMATH_LOG256(x) _mm256_log_ps(x)
+#define VMATH_EXP256(x) _mm256_exp_ps(x)
+#endif
+
+/* ********************************************** *
+ * Cumulative normal distribution function based  *
+ * on the polynomial approximation (Abramowitz &  *
+ * Stegun 26.2.17) used by PARSEC's blackscholes  *
+ * ********************************************** */
+/* N(x), also returning N'(x) (the normal density) through pdf, which the
+ * polynomial needs anyway; Greeks reuse it instead of another exp */
+static inline __m256 _mm256_cndf_pdf_ps(__m256 x, __m256* pdf)
+{
+  /* N(-x) = 1 - N(x); work on |x| and fix up the sign at the end */
+  __m256 sign_mask = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OS);
+  x = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+
+  /* N'(x) = exp(-x^2 / 2) / sqrt(2 * pi) */
+  __m256 npx = _mm256_mul_ps(_mm256_mul_ps(x, x), _mm256_set1_ps(-0.5f));
+  npx = VMATH_EXP256(npx);
+  npx = _mm256_mul_ps(npx, _mm256_set1_ps(0.39894228040143270286f));
+  *pdf = npx;
+
+  /* k = 1 / (1 + 0.2316419 * x) */
+  __m256 k = _mm256_mul_ps(x, _mm256_set1_ps(0.2316419f));
+  k = _mm256_add_ps(k, _mm256_set1_ps(1.0f));
+  k = _mm256_div_ps(_mm256_set1_ps(1.0f), k);
+
+  /* Polynomial in k (Horner) */
+  __m256 y = _mm256_set1_ps(1.330274429f);
+  y = _mm256_mul_ps(y, k);
+  y = _mm256_add_ps(y, _mm256_set1_ps(-1.821255978f));
+  y = _mm256_mul_ps(y, k);
+  y = _mm256_add_ps(y, _mm256_set1_ps( 1.781477937f));
+  y = _mm256_mul_ps(y, k);
+  y = _mm256_add_ps(y, _mm256_set1_ps(-0.356563782f));
+  y = _mm256_mul_ps(y, k);
+  y = _mm256_add_ps(y, _mm256_set1_ps( 0.319381530f));
+  y = _mm256_mul_ps(y, k);
+
+  y = _mm256_mul_ps(y, npx);
+  y = _mm256_sub_ps(_mm256_set1_ps(1.0f), y);
+
+  /* Negative inputs take the complement */
+  __m256 ny = _mm256_sub_ps(_mm256_set1_ps(1.0f), y);
+  return _mm256_blendv_ps(y, ny, sign_mask);
+}
+
+static inline __m256 _mm256_cndf_ps(__m256 x)
+{
+  __m256 pdf;
+
+  return _mm256_cndf_pdf_ps(x, &pdf);
+}
+
+/* ********************************************** *
+ * Double precision: Cephes exp and log, and the  *
+ * CNDF by Hart's rational approximation (as      *
+ * given by West, "Better approximations to       *
+ * cumulative normal functions", 2005). There is  *
+ * one tier only; VMATH_TIER does not apply. Max  *
+ * error: exp 2 ULP over [-708, 709], log 1 ULP,  *
+ * CNDF 2e-16 absolute                            *
+ * ********************************************** */
+static inline __m256d _mm256_exp_pd(__m256d x)
+{
+  /* 2^n is built in the exponent field; keep n a normal exponent */
+  x = _mm256_min_pd(_mm256_set1_pd( 709.0), x);
+  x = _mm256_max_pd(_mm256_set1_pd(-708.0), x);
+
+  /* exp(x) = exp(g + n * log(2)), n = round(x / log(2)) */
+  __m256d fx = _mm256_mul_pd(x, _mm256_set1_pd(1.4426950408889634073599));
+  fx = _mm256_round_pd(fx, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+  x = _mm256_fnmadd_pd(fx, _mm256_set1_pd(6.93145751953125e-1), x);
+  x = _mm256_fnmadd_pd(fx, _mm256_set1_pd(1.42860682030941723212e-6), x);
+
+  /* exp(g) = 1 + 2 * g P(g^2) / (Q(g^2) - g P(g^2)) */
+  __m256d xx = _mm256_mul_pd(x, x);
+
+  __m256d px = _mm256_set1_pd(1.26177193074810590878e-4);
+  px = _mm256_fmadd_pd(px, xx, _mm256_set1_pd(3.02994407707441961300e-2));
+  px = _mm256_fmadd_pd(px, xx, _mm256_set1_pd(9.99999999999999999910e-1));
+  px = _mm256_mul_pd(px, x);
+
+  __m256d qx = _mm256_set1_pd(3.00198505138664455042e-6);
+  qx = _mm256_fmadd_pd(qx, xx, _mm256_set1_pd(2.52448340349684104192e-3));
+  qx = _mm256_fmadd_pd(qx, xx, _mm256_set1_pd(2.27265548208155028766e-1));
+  qx = _mm256_fmadd_pd(qx, xx, _mm256_set1_pd(2.00000000000000000009e0));
+
+  __m256d y = _mm256_div_pd(px, _mm256_sub_pd(qx, px));
+  y = _mm256_fmadd_pd(y, _mm256_set1_pd(2.0), _mm256_set1_pd(1.0));
+
+  /* build 2^n */
+  __m256i n = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(fx));
+  n = _mm256_add_epi64(n, _mm256_set1_epi64x(1023));
+  n = _mm256_slli_epi64(n, 52);
+  return _mm256_mul_pd(y, _mm256_castsi256_pd(n));
+}
+
+/* Finite, positive and normal inputs; x <= 0 gives NaN */
+static inline __m256d _mm256_log_pd(__m256d x)
+{
+  const __m256d one = _mm256_set1_pd(1.0);
+
+  __m256d invalid_mask = _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LE_OS);
+  __m256i bits = _mm256_castpd_si256(x);
+
+  /* Exponent field as a double: 2^52 + field, minus 2^52 */
+  __m256i ebits = _mm256_srli_epi64(bits, 52);
+  ebits = _mm256_or_si256(ebits, _mm256_set1_epi64x(0x4330000000000000LL));
+  __m256d e = _mm256_sub_pd(_mm256_castsi256_pd(ebits), _mm256_set1_pd(4503599627370496.0));
+  e = _mm256_sub_pd(e, _mm256_set1_pd(1022.0));
+
+  /* x = m * 2^e, m in [0.5, 1) */
+  bits = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+  bits = _mm256_or_si256 (bits, _mm256_set1_epi64x(0x3FE0000000000000LL));
+  __m256d m = _mm256_castsi256_pd(bits);
+
+  /* if (m < SQRTH) { e -= 1; x = m + m - 1; } else { x = m - 1; } */
+  __m256d mask = _mm256_cmp_pd(m, _mm256_set1_pd(0.70710678118654752440), _CMP_LT_OS);
+  e = _mm256_sub_pd(e, _mm256_and_pd(one, mask));
+  x = _mm256_add_pd(_mm256_sub_pd(m, one), _mm256_and_pd(m, mask));
+
+  __m256d z = _mm256_mul_pd(x, x);
+
+  /* y = x * z * P(x) / Q(x) */
+  __m256d p = _mm256_set1_pd(1.01875663804580931796e-4);
+  p = _mm256_fmadd_pd(p, x, _mm256_set1_pd(4.97494994976747001425e-1));
+  p = _mm256_fmadd_pd(p, x, _mm256_set1_pd(4.70579119878881725854e0));
+  p = _mm256_fmadd_pd(p, x, _mm256_set1_pd(1.44989225341610930846e1));
+  p = _mm256_fmadd_pd(p, x, _mm256_set1_pd(1.79368678507819816313e1));
+  p = _mm256_fmadd_pd(p, x, _mm256_set1_pd(7.70838733755885391666e0));
+
+  __m256d q = _mm256_add_pd(x, _mm256_set1_pd(1.12873587189167450590e1));
+  q = _mm256_fmadd_pd(q, x, _mm256_set1_pd(4.52279145837532221105e1));
+  q = _mm256_fmadd_pd(q, x, _mm256_set1_pd(8.29875266912776603211e1));
+  q = _mm256_fmadd_pd(q, x, _mm256_set1_pd(7.11544750618563894466e1));
+  q = _mm256_fmadd_pd(q, x, _mm256_set1_pd(2.31251620126765340583e1));
+
+  __m256d y = _mm256_mul_pd(_mm256_mul_pd(x, z), _mm256_div_pd(p, q));
+
+  y = _mm256_fnmadd_pd(e, _mm256_set1_pd(2.121944400546905827679e-4), y);
+  y = _mm256_fnmadd_pd(z, _mm256_set1_pd(0.5), y);
+
+  x = _mm256_add_pd(x, y);
+  x = _mm256_fmadd_pd(e, _mm256_set1_pd(0.693359375), x);
+  return _mm256_or_pd(x, invalid_mask);
+}
+
+static inline __m256d _mm256_cndf_pd(__m256d x)
+{
+  /* N(-x) = 1 - N(x); work on |x| and fix up the sign at the end */
+  __m256d sign_mask = _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OS);
+  x = _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+
+  __m256d e = _mm256_mul_pd(_mm256_mul_pd(x, x), _mm256_set1_pd(-0.5));
+  e = _mm256_exp_pd(e);
+
+  __m256d n = _mm256_set1_pd(3.52624965998911e-02);
+  n = _mm256_fmadd_pd(n, x, _mm256_set1_pd(0.700383064443688));
+  n = _mm256_fmadd_pd(n, x, _mm256_set1_pd(6.37396220353165));
+  n = _mm256_fmadd_pd(n, x, _mm256_set1_pd(33.912866078383));
+  n = _mm256_fmadd_pd(n, x, _mm256_set1_pd(112.079291497871));
+  n = _mm256_fmadd_pd(n, x, _mm256_set1_pd(221.213596169931));
+  n = _mm256_fmadd_pd(n, x, _mm256_set1_pd(220.206867912376));
+
+  __m256d d = _mm256_set1_pd(8.83883476483184e-02);
+  d = _mm256_fmadd_pd(d, x, _mm256_set1_pd(1.75566716318264));
+  d = _mm256_fmadd_pd(d, x, _mm256_set1_pd(16.064177579207));
+  d = _mm256_fmadd_pd(d, x, _mm256_set1_pd(86.7807322029461));
+  d = _mm256_fmadd_pd(d, x, _mm256_set1_pd(296.564248779674));
+  d = _mm256_fmadd_pd(d, x, _mm256_set1_pd(637.333633378831));
+  d = _mm256_fmadd_pd(d, x, _mm256_set1_pd(793.826512519948));
+  d = _mm256_fmadd_pd(d, x, _mm256_set1_pd(440.413735824752));
+
+  /* Upper tail Q(|x|) */
+  __m256d c = _mm256_div_pd(_mm256_mul_pd(e, n), d);
+
+  __m256d y = _mm256_sub_pd(_mm256_set1_pd(1.0), c);
+  return _mm256_blendv_pd(y, c, sign_mask);
+}
+
+#endif
+
+/* The AVX-512 family needs -mavx512f -mavx512dq (vec.avx512.c). Special
+ * values are patched with mask registers instead of blends, and the
+ * polynomials use FMA. Max error versus the correctly rounded result
+ * (double-precision libm rounded to float):
+ *
+ *   _mm512_log_ps   1 ULP over (0, +inf), subnormals included;
+ *                   0 -> -inf, +inf -> +inf, x < 0 -> NaN
+ *   _mm512_exp_ps   1 ULP over [-87.3, 88.7]; overflows to +inf and
+ *                   underflows through the subnormals to 0
+ *   _mm512_cndf_ps  3e-7 absolute (A&S 26.2.17 is good to 7.5e-8)
+ *   _mm512_erf_ps   6e-7 absolute (A&S 7.1.26 is good to 1.5e-7)
+ *
+ *   _mm512_log_pd   1 ULP, special values as _mm512_log_ps
+ *   _mm512_exp_pd   2 ULP over [-745, 709.7], saturating beyond
+ *   _mm512_cndf_pd  2e-16 absolute (Hart)
+ *
+ * sqrt needs no approximation: _mm512_sqrt_ps is correctly rounded. */
+#if defined(__AVX512F__)
+
+/* ********************************************** *
+ * Cephes logf, as _mm256_log_ps, with getexp and *
+ * getmant doing the range reduction (subnormal   *
+ * inputs are handled, not flushed)               *
+ * ********************************************** */
+static inline __m512 _mm512_log_ps(__m512 x)
+{
+  const __m512 one = _mm512_set1_ps(1.0f);
+
+  /* Special values, patched by mask at the end */
+  __mmask16 neg  = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+  __mmask16 zero = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_EQ_OQ);
+  __mmask16 pinf = _mm512_cmp_ps_mask(x, _mm512_set1_ps(INFINITY), _CMP_EQ_OQ);
+  __mmask16 nan  = _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q);
+  __m512    xin  = x;
+
+  /* x = m * 2^e, m in [0.5, 1) */
+  __m512 e = _mm512_add_ps(_mm512_getexp_ps(x), one);
+  __m512 m = _mm512_getmant_ps(x, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_zero);
+
+  /* if (m < SQRTHF) { e -= 1; m = m + m - 1; } else { m = m - 1; } */
+  __mmask16 small = _mm512_cmp_ps_mask(m, _mm512_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+  e = _mm512_mask_sub_ps(e, small, e, one);
+  m = _mm512_mask_add_ps(m, small, m, m);
+  x = _mm512_sub_ps(m, one);
+
+  __m512 z = _mm512_mul_ps(x, x);
+
+  __m512 y = _mm512_set1_ps(7.0376836292e-2f);
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(-1.1514610310e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps( 1.1676998740e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(-1.2420140846e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps( 1.4249322787e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(-1.6668057665e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps( 2.0000714765e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(-2.4999993993e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps( 3.3333331174e-1f));
+  y = _mm512_mul_ps(_mm512_mul_ps(y, x), z);
+
+  y = _mm512_fmadd_ps(e, _mm512_set1_ps(-2.12194440e-4f), y);
+  y = _mm512_fnmadd_ps(z, _mm512_set1_ps(0.5f), y);
+
+  x = _mm512_add_ps(x, y);
+  x = _mm512_fmadd_ps(e, _mm512_set1_ps(0.693359375f), x);
+
+  x = _mm512_mask_mov_ps(x, neg , _mm512_set1_ps(NAN));
+  x = _mm512_mask_mov_ps(x, zero, _mm512_set1_ps(-INFINITY));
+  x = _mm512_mask_mov_ps(x, pinf, _mm512_set1_ps(INFINITY));
+  x = _mm512_mask_mov_ps(x, nan , xin);
+
+  return x;
+}
+
+/* ********************************************** *
+ * Cephes expf, as _mm256_exp_ps, with scalef     *
+ * building 2^n (no integer exponent tricks, so   *
+ * overflow and underflow saturate correctly)     *
+ * ********************************************** */
+static inline __m512 _mm512_exp_ps(__m512 x)
+{
+  /* Beyond these, scalef saturates anyway; NaN stays in x */
+  x = _mm512_min_ps(_mm512_set1_ps( 89.0f), x);
+  x = _mm512_max_ps(_mm512_set1_ps(-104.0f), x);
+
+  /* exp(x) = exp(g + n * log(2)), n = round(x / log(2)) */
+  __m512 fx = _mm512_mul_ps(x, _mm512_set1_ps(1.44269504088896341f));
+  fx = _mm512_roundscale_ps(fx, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+  x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(0.693359375f), x);
+  x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(-2.12194440e-4f), x);
+
+  __m512 z = _mm512_mul_ps(x, x);
+
+  __m512 y = _mm512_set1_ps(1.9875691500e-4f);
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(1.3981999507e-3f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(8.3334519073e-3f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(4.1665795894e-2f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(1.6666665459e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(5.0000001201e-1f));
+  y = _mm512_fmadd_ps(y, z, x);
+  y = _mm512_add_ps(y, _mm512_set1_ps(1.0f));
+
+  /* y * 2^n */
+  return _mm512_scalef_ps(y, fx);
+}
+
+/* ********************************************** *
+ * Fast tier, as _mm256_log_fast_ps and           *
+ * _mm256_exp_fast_ps                             *
+ * ********************************************** */
+static inline __m512 _mm512_log_fast_ps(__m512 x)
+{
+  /* x = m * 2^e, m in [sqrt(1/2), sqrt(2)), by integer arithmetic */
+  __m512i ix = _mm512_sub_epi32(_mm512_castps_si512(x), _mm512_set1_epi32(0x3f3504f3));
+  __m512  e  = _mm512_cvtepi32_ps(_mm512_srai_epi32(ix, 23));
+  ix = _mm512_and_si512(ix, _mm512_set1_epi32(0x007fffff));
+  ix = _mm512_add_epi32(ix, _mm512_set1_epi32(0x3f3504f3));
+  x  = _mm512_sub_ps(_mm512_castsi512_ps(ix), _mm512_set1_ps(1.0f));
+
+  /* log(1 + x) = x - x^2 / 2 + x^3 * P(x) */
+  __m512 z = _mm512_mul_ps(x, x);
+
+  __m512 y = _mm512_set1_ps(8.7004306819e-2f);
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(-1.4267486260e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps( 1.4914769207e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(-1.6577584763e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps( 1.9963063698e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(-2.5001337036e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps( 3.3333910739e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(-0.5f));
+  y = _mm512_mul_ps(y, z);
+
+  /* + e * log(2), in two parts */
+  y = _mm512_fmadd_ps(e, _mm512_set1_ps(-2.12194440e-4f), y);
+  y = _mm512_add_ps(y, x);
+  return _mm512_fmadd_ps(e, _mm512_set1_ps(0.693359375f), y);
+}
+
+static inline __m512 _mm512_exp_fast_ps(__m512 x)
+{
+  x = _mm512_min_ps(x, _mm512_set1_ps( 88.3762626647949f));
+  x = _mm512_max_ps(x, _mm512_set1_ps(-87.3365402221680f));
+
+  /* exp(x) = exp(g + n * log(2)), n = round(x / log(2)) */
+  __m512 fx = _mm512_mul_ps(x, _mm512_set1_ps(1.44269504088896341f));
+  fx = _mm512_roundscale_ps(fx, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+  x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(0.693359375f), x);
+  x = _mm512_fnmadd_ps(fx, _mm512_set1_ps(-2.12194440e-4f), x);
+
+  /* exp(g) = 1 + g + g^2 * P(g) */
+  __m512 y = _mm512_set1_ps(8.3125214507e-3f);
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(4.1890146703e-2f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(1.6667114605e-1f));
+  y = _mm512_fmadd_ps(y, x, _mm512_set1_ps(4.9999231563e-1f));
+  y = _mm512_fmadd_ps(y, _mm512_mul_ps(x, x), x);
+  y = _mm512_add_ps(y, _mm512_set1_ps(1.0f));
+
+  /* y * 2^n */
+  return _mm512_scalef_ps(y, fx);
+}
+
+/* Tier selected at compile time (VMATH_TIER, see the top of this file) */
+#if VMATH_TIER == VMATH_TIER_FAST
+#define VMATH_LOG512(x) _mm512_log_fast_ps(x)
+#define VMATH_EXP512(x) _mm512_exp_fast_ps(x)
+#else
+#define VMATH_LOG512(x) _mm512_log_ps(x)
+#define VMATH_EXP512(x) _mm512_exp_ps(x)
+#endif
+
+/* ********************************************** *
+ * Cumulative normal distribution function, as    *
+ * _mm256_cndf_ps (Abramowitz & Stegun 26.2.17)   *
+ * ********************************************** */
+static inline __m512 _mm512_cndf_pdf_ps(__m512 x, __m512* pdf)
+{
+  const __m512 one = _mm512_set1_ps(1.0f);
+
+  /* N(-x) = 1 - N(x); work on |x| and fix up the sign at the end */
+  __mmask16 sign = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+  x = _mm512_abs_ps(x);
+
+  /* N'(x) = exp(-x^2 / 2) / sqrt(2 * pi) */
+  __m512 npx = _mm512_mul_ps(_mm512_mul_ps(x, x), _mm512_set1_ps(-0.5f));
+  npx = VMATH_EXP512(npx);
+  npx = _mm512_mul_ps(npx, _mm512_set1_ps(0.39894228040143270286f));
+  *pdf = npx;
+
+  /* k = 1 / (1 + 0.2316419 * x) */
+  __m512 k = _mm512_fmadd_ps(x, _mm512_set1_ps(0.2316419f), one);
+  k = _mm512_div_ps(one, k);
+
+  /* Polynomial in k (Horner) */
+  __m512 y = _mm512_set1_ps(1.330274429f);
+  y = _mm512_fmadd_ps(y, k, _mm512_set1_ps(-1.821255978f));
+  y = _mm512_fmadd_ps(y, k, _mm512_set1_ps( 1.781477937f));
+  y = _mm512_fmadd_ps(y, k, _mm512_set1_ps(-0.356563782f));
+  y = _mm512_fmadd_ps(y, k, _mm512_set1_ps( 0.319381530f));
+  y = _mm512_mul_ps(y, k);
+
+  y = _mm512_fnmadd_ps(y, npx, one);
+
+  /* Negative inputs take the complement */
+  return _mm512_mask_sub_ps(y, sign, one, y);
+}
+
+static inline __m512 _mm512_cndf_ps(__m512 x)
+{
+  __m512 pdf;
+
+  return _mm512_cndf_pdf_ps(x, &pdf);
+}
+
+/* ********************************************** *
+ * Error function (Abramowitz & Stegun 7.1.26)    *
+ * ********************************************** */
+static inline __m512 _mm512_erf_ps(__m512 x)
+{
+  const __m512 one = _mm512_set1_ps(1.0f);
+
+  /* erf(-x) = -erf(x) */
+  __mmask16 sign = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+  x = _mm512_abs_ps(x);
+
+  /* t = 1 / (1 + p * x) */
+  __m512 t = _mm512_fmadd_ps(x, _mm512_set1_ps(0.3275911f), one);
+  t = _mm512_div_ps(one, t);
+
+  __m512 y = _mm512_set1_ps(1.061405429f);
+  y = _mm512_fmadd_ps(y, t, _mm512_set1_ps(-1.453152027f));
+  y = _mm512_fmadd_ps(y, t, _mm512_set1_ps( 1.421413741f));
+  y = _mm512_fmadd_ps(y, t, _mm512_set1_ps(-0.284496736f));
+  y = _mm512_fmadd_ps(y, t, _mm512_set1_ps( 0.254829592f));
+  y = _mm512_mul_ps(y, t);
+
+  /* erf(x) = 1 - y * exp(-x^2) */
+  __m512 ex = VMATH_EXP512(_mm512_mul_ps(_mm512_mul_ps(x, x), _mm512_set1_ps(-1.0f)));
+  y = _mm512_fnmadd_ps(y, ex, one);
+
+  return _mm512_mask_sub_ps(y, sign, _mm512_setzero_ps(), y);
+}
+
+/* ********************************************** *
+ * Double precision, as _mm256_exp_pd,            *
+ * _mm256_log_pd and _mm256_cndf_pd, with scalef, *
+ * getexp and getmant as in the float versions    *
+ * ********************************************** */
+static inline __m512d _mm512_exp_pd(__m512d x)
+{
+  /* Beyond these, scalef saturates anyway; NaN stays in x */
+  x = _mm512_min_pd(_mm512_set1_pd( 710.0), x);
+  x = _mm512_max_pd(_mm512_set1_pd(-746.0), x);
+
+  /* exp(x) = exp(g + n * log(2)), n = round(x / log(2)) */
+  __m512d fx = _mm512_mul_pd(x, _mm512_set1_pd(1.4426950408889634073599));
+  fx = _mm512_roundscale_pd(fx, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+
+  x = _mm512_fnmadd_pd(fx, _mm512_set1_pd(6.93145751953125e-1), x);
+  x = _mm512_fnmadd_pd(fx, _mm512_set1_pd(1.42860682030941723212e-6), x);
+
+  /* exp(g) = 1 + 2 * g P(g^2) / (Q(g^2) - g P(g^2)) */
+  __m512d xx = _mm512_mul_pd(x, x);
+
+  __m512d px = _mm512_set1_pd(1.26177193074810590878e-4);
+  px = _mm512_fmadd_pd(px, xx, _mm512_set1_pd(3.02994407707441961300e-2));
+  px = _mm512_fmadd_pd(px, xx, _mm512_set1_pd(9.99999999999999999910e-1));
+  px = _mm512_mul_pd(px, x);
+
+  __m512d qx = _mm512_set1_pd(3.00198505138664455042e-6);
+  qx = _mm512_fmadd_pd(qx, xx, _mm512_set1_pd(2.52448340349684104192e-3));
+  qx = _mm512_fmadd_pd(qx, xx, _mm512_set1_pd(2.27265548208155028766e-1));
+  qx = _mm512_fmadd_pd(qx, xx, _mm512_set1_pd(2.00000000000000000009e0));
+
+  __m512d y = _mm512_div_pd(px, _mm512_sub_pd(qx, px));
+  y = _mm512_fmadd_pd(y, _mm512_set1_pd(2.0), _mm512_set1_pd(1.0));
+
+  /* y * 2^n */
+  return _mm512_scalef_pd(y, fx);
+}
+
+static inline __m512d _mm512_log_pd(__m512d x)
+{
+  const __m512d one = _mm512_set1_pd(1.0);
+
+  /* Special values, patched by mask at the end */
+  __mmask8 neg  = _mm512_cmp_pd_mask(x, _mm512_setzero_pd(), _CMP_LT_OQ);
+  __mmask8 zero = _mm512_cmp_pd_mask(x, _mm512_setzero_pd(), _CMP_EQ_OQ);
+  __mmask8 pinf = _mm512_cmp_pd_mask(x, _mm512_set1_pd(INFINITY), _CMP_EQ_OQ);
+  __mmask8 nan  = _mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q);
+  __m512d  xin  = x;
+
+  /* x = m * 2^e, m in [0.5, 1) */
+  __m512d e = _mm512_add_pd(_mm512_getexp_pd(x), one);
+  __m512d m = _mm512_getmant_pd(x, _MM_MANT_NORM_p5_1, _MM_MANT_SIGN_zero);
+
+  /* if (m < SQRTH) { e -= 1; x = m + m - 1; } else { x = m - 1; } */
+  __mmask8 small = _mm512_cmp_pd_mask(m, _mm512_set1_pd(0.70710678118654752440), _CMP_LT_OQ);
+  e = _mm512_mask_sub_pd(e, small, e, one);
+  m = _mm512_mask_add_pd(m, small, m, m);
+  x = _mm512_sub_pd(m, one);
+
+  __m512d z = _mm512_mul_pd(x, x);
+
+  /* y = x * z * P(x) / Q(x) */
+  __m512d p = _mm512_set1_pd(1.01875663804580931796e-4);
+  p = _mm512_fmadd_pd(p, x, _mm512_set1_pd(4.97494994976747001425e-1));
+  p = _mm512_fmadd_pd(p, x, _mm512_set1_pd(4.70579119878881725854e0));
+  p = _mm512_fmadd_pd(p, x, _mm512_set1_pd(1.44989225341610930846e1));
+  p = _mm512_fmadd_pd(p, x, _mm512_set1_pd(1.79368678507819816313e1));
+  p = _mm512_fmadd_pd(p, x, _mm512_set1_pd(7.70838733755885391666e0));
+
+  __m512d q = _mm512_add_pd(x, _mm512_set1_pd(1.12873587189167450590e1));
+  q = _mm512_fmadd_pd(q, x, _mm512_set1_pd(4.52279145837532221105e1));
+  q = _mm512_fmadd_pd(q, x, _mm512_set1_pd(8.29875266912776603211e1));
+  q = _mm512_fmadd_pd(q, x, _mm512_set1_pd(7.11544750618563894466e1));
+  q = _mm512_fmadd_pd(q, x, _mm512_set1_pd(2.31251620126765340583e1));
+
+  __m512d y = _mm512_mul_pd(_mm512_mul_pd(x, z), _mm512_div_pd(p, q));
+
+  y = _mm512_fnmadd_pd(e, _mm512_set1_pd(2.121944400546905827679e-4), y);
+  y = _mm512_fnmadd_pd(z, _mm512_set1_pd(0.5), y);
+
+  x = _mm512_add_pd(x, y);
+  x = _mm512_fmadd_pd(e, _mm512_set1_pd(0.693359375), x);
+
+  x = _mm512_mask_mov_pd(x, zero, _mm512_set1_pd(-INFINITY));
+  x = _mm512_mask_mov_pd(x, pinf, xin);
+  x = _mm512_mask_mov_pd(x, neg | nan, _mm512_set1_pd(NAN));
+  return x;
+}
+
+static inline __m512d _mm512_cndf_pd(__m512d x)
+{
+  const __m512d one = _mm512_set1_pd(1.0);
+
+  /* N(-x) = 1 - N(x); work on |x| and fix up the sign at the end */
+  __mmask8 sign = _mm512_cmp_pd_mask(x, _mm512_setzero_pd(), _CMP_LT_OQ);
+  x = _mm512_abs_pd(x);
+
+  __m512d e = _mm512_mul_pd(_mm512_mul_pd(x, x), _mm512_set1_pd(-0.5));
+  e = _mm512_exp_pd(e);
+
+  __m512d n = _mm512_set1_pd(3.52624965998911e-02);
+  n = _mm512_fmadd_pd(n, x, _mm512_set1_pd(0.700383064443688));
+  n = _mm512_fmadd_pd(n, x, _mm512_set1_pd(6.37396220353165));
+  n = _mm512_fmadd_pd(n, x, _mm512_set1_pd(33.912866078383));
+  n = _mm512_fmadd_pd(n, x, _mm512_set1_pd(112.079291497871));
+  n = _mm512_fmadd_pd(n, x, _mm512_set1_pd(221.213596169931));
+  n = _mm512_fmadd_pd(n, x, _mm512_set1_pd(220.206867912376));
+
+  __m512d d = _mm512_set1_pd(8.83883476483184e-02);
+  d = _mm512_fmadd_pd(d, x, _mm512_set1_pd(1.75566716318264));
+  d = _mm512_fmadd_pd(d, x, _mm512_set1_pd(16.064177579207));
+  d = _mm512_fmadd_pd(d, x, _mm512_set1_pd(86.7807322029461));
+  d = _mm512_fmadd_pd(d, x, _mm512_set1_pd(296.564248779674));
+  d = _mm512_fmadd_pd(d, x, _mm512_set1_pd(637.333633378831));
+  d = _mm512_fmadd_pd(d, x, _mm512_set1_pd(793.826512519948));
+  d = _mm512_fmadd_pd(d, x, _mm512_set1_pd(440.413735824752));
+
+  /* Upper tail Q(|x|) */
+  __m512d c = _mm512_div_pd(_mm512_mul_pd(e, n), d);
+
+  __m512d y = _mm512_sub_pd(one, c);
+  return _mm512_mask_mov_pd(y, sign, c);
+}
+
+#endif
+
+#if defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
 
 /* ********************************************** *
  * Based on the ARM NEON implementation of log_ps *
  * by\ Julien Pommier                             *
  * Website\ http://gruntthepeon.free.fr/ssemath/  *
  * ********************************************** */
-float32x4_t vlog_f32(float32x4_t x)
+static inline float32x4_t vlog_f32(float32x4_t x)
 {
   /* force flush to zero on denormal values */
   x = vmaxq_f32(x, vdupq_n_f32(0));
@@ -253,7 +892,7 @@ float32x4_t vlog_f32(float32x4_t x)
  * by\ Julien Pommier                             *
  * Website\ http://gruntthepeon.free.fr/ssemath/  *
  * ********************************************** */
-float32x4_t vexp_f32(float32x4_t x)
+static inline float32x4_t vexp_f32(float32x4_t x)
 {
   float32x4_t tmp, fx;
 
@@ -305,6 +944,143 @@ float32x4_t vexp_f32(float32x4_t x)
   y = vmulq_f32(y, pow2n);
   return y;
 }
+
+/* N(x) and N'(x) (through pdf), as _mm256_cndf_pdf_ps; NEON has only the
+ * accurate tier */
+static inline float32x4_t vcndf_pdf_f32(float32x4_t x, float32x4_t* pdf)
+{
+  uint32x4_t sign_mask = vcltq_f32(x, vdupq_n_f32(0.0f));
+  x = vabsq_f32(x);
+
+  float32x4_t npx = vmulq_f32(vmulq_f32(x, x), vdupq_n_f32(-0.5f));
+  npx = vexp_f32(npx);
+  npx = vmulq_f32(npx, vdupq_n_f32(0.39894228040143270286f));
+  *pdf = npx;
+
+  float32x4_t k = vfmaq_f32(vdupq_n_f32(1.0f), x, vdupq_n_f32(0.2316419f));
+  k = vdivq_f32(vdupq_n_f32(1.0f), k);
+
+  float32x4_t y = vdupq_n_f32(1.330274429f);
+  y = vfmaq_f32(vdupq_n_f32(-1.821255978f), y, k);
+  y = vfmaq_f32(vdupq_n_f32( 1.781477937f), y, k);
+  y = vfmaq_f32(vdupq_n_f32(-0.356563782f), y, k);
+  y = vfmaq_f32(vdupq_n_f32( 0.319381530f), y, k);
+  y = vmulq_f32(y, k);
+
+  y = vfmsq_f32(vdupq_n_f32(1.0f), y, npx);
+
+  float32x4_t ny = vsubq_f32(vdupq_n_f32(1.0f), y);
+  return vbslq_f32(sign_mask, ny, y);
+}
+
+#if defined(__ARM_FEATURE_SVE)
+/* ********************************************** *
+ * SVE: the NEON functions above, vector-length   *
+ * agnostic; inactive lanes of pg are don't-care  *
+ * ********************************************** */
+static inline svfloat32_t svlog_f32_x(svbool_t pg, svfloat32_t x)
+{
+  svbool_t invalid = svcmple_n_f32(pg, x, 0.0f);
+  x = svmax_n_f32_x(pg, x, 0.0f);
+
+  svint32_t ux   = svreinterpret_s32_f32(x);
+  svint32_t emm0 = svsub_n_s32_x(pg, svasr_n_s32_x(pg, ux, 23), 0x7f);
+
+  /* keep only the fractional part, in [0.5, 1) */
+  ux = svand_n_s32_x(pg, ux, ~0x7f800000);
+  ux = svorr_n_s32_x(pg, ux, 0x3f000000);
+  x  = svreinterpret_f32_s32(ux);
+
+  svfloat32_t e = svadd_n_f32_x(pg, svcvt_f32_s32_x(pg, emm0), 1.0f);
+
+  /* x < sqrt(1/2): e -= 1 and x = 2x - 1, otherwise x = x - 1 */
+  svbool_t mask = svcmplt_n_f32(pg, x, 0.707106781186547524f);
+  e = svsub_n_f32_m(mask, e, 1.0f);
+  x = svadd_f32_m(mask, x, x);
+  x = svsub_n_f32_x(pg, x, 1.0f);
+
+  svfloat32_t z = svmul_f32_x(pg, x, x);
+
+  svfloat32_t y = svdup_n_f32(7.0376836292e-2f);
+  y = svmad_f32_x(pg, y, x, svdup_n_f32(-1.1514610310e-1f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32( 1.1676998740e-1f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32(-1.2420140846e-1f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32( 1.4249322787e-1f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32(-1.6668057665e-1f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32( 2.0000714765e-1f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32(-2.4999993993e-1f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32( 3.3333331174e-1f));
+  y = svmul_f32_x(pg, y, x);
+  y = svmul_f32_x(pg, y, z);
+
+  y = svmla_n_f32_x(pg, y, e, -2.12194440e-4f);
+  y = svmls_n_f32_x(pg, y, z, 0.5f);
+
+  x = svadd_f32_x(pg, x, y);
+  x = svmla_n_f32_x(pg, x, e, 0.693359375f);
+
+  /* Zero and negative inputs will be NAN */
+  return svsel_f32(invalid, svdup_n_f32(NAN), x);
+}
+
+static inline svfloat32_t svexp_f32_x(svbool_t pg, svfloat32_t x)
+{
+  x = svmin_n_f32_x(pg, x,  88.3762626647949f);
+  x = svmax_n_f32_x(pg, x, -88.3762626647949f);
+
+  /* exp(x) = exp(g + n * log(2)), n = floor(x / log(2) + 1/2) */
+  svfloat32_t fx = svmla_n_f32_x(pg, svdup_n_f32(0.5f), x, 1.44269504088896341f);
+  fx = svrintm_f32_x(pg, fx);
+
+  x = svmls_n_f32_x(pg, x, fx, 0.693359375f);
+  x = svmls_n_f32_x(pg, x, fx, -2.12194440e-4f);
+
+  svfloat32_t z = svmul_f32_x(pg, x, x);
+
+  svfloat32_t y = svdup_n_f32(1.9875691500e-4f);
+  y = svmad_f32_x(pg, y, x, svdup_n_f32(1.3981999507e-3f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32(8.3334519073e-3f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32(4.1665795894e-2f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32(1.6666665459e-1f));
+  y = svmad_f32_x(pg, y, x, svdup_n_f32(5.0000001201e-1f));
+
+  y = svmla_f32_x(pg, x, y, z);
+  y = svadd_n_f32_x(pg, y, 1.0f);
+
+  /* 2^n */
+  svint32_t mm = svcvt_s32_f32_x(pg, fx);
+  mm = svlsl_n_s32_x(pg, svadd_n_s32_x(pg, mm, 0x7f), 23);
+
+  return svmul_f32_x(pg, y, svreinterpret_f32_s32(mm));
+}
+
+/* N(x) and N'(x) (through pdf), as vcndf_pdf_f32 */
+static inline svfloat32_t svcndf_pdf_f32_x(svbool_t pg, svfloat32_t x,
+                                           svfloat32_t* pdf)
+{
+  svbool_t sign_mask = svcmplt_n_f32(pg, x, 0.0f);
+  x = svabs_f32_x(pg, x);
+
+  svfloat32_t npx = svmul_n_f32_x(pg, svmul_f32_x(pg, x, x), -0.5f);
+  npx = svexp_f32_x(pg, npx);
+  npx = svmul_n_f32_x(pg, npx, 0.39894228040143270286f);
+  *pdf = npx;
+
+  svfloat32_t k = svmla_n_f32_x(pg, svdup_n_f32(1.0f), x, 0.2316419f);
+  k = svdivr_n_f32_x(pg, k, 1.0f);
+
+  svfloat32_t y = svdup_n_f32(1.330274429f);
+  y = svmad_f32_x(pg, y, k, svdup_n_f32(-1.821255978f));
+  y = svmad_f32_x(pg, y, k, svdup_n_f32( 1.781477937f));
+  y = svmad_f32_x(pg, y, k, svdup_n_f32(-0.356563782f));
+  y = svmad_f32_x(pg, y, k, svdup_n_f32( 0.319381530f));
+  y = svmul_f32_x(pg, y, k);
+
+  y = svmsb_f32_x(pg, y, npx, svdup_n_f32(1.0f));
+
+  return svsubr_n_f32_m(sign_mask, y, 1.0f);
+}
+#endif
 #endif
 
 #endif //__COMMON_VMATH_H_
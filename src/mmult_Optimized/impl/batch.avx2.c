@@ -0,0 +1,139 @@
+/* batch.avx2.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX2 variant of the batched GEMM (see batch.h); compiled with AVX2 and
+ * FMA. AVX2 has no scatter, so interleaved results are written back lane
+ * by lane.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/batch.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+
+/* Matrices per interleaved group, floats per register */
+#define BATCH_V 8
+
+/* Rows of R kept in registers at once by the one-matrix kernel */
+#define BATCH_RB 2
+
+/* R = A * B for the BATCH_V matrices starting at A, B and R; element
+ * (i, k) of all of them is one gather */
+BATCH_INLINE void il_group(const args_t* a, const float* A, const float* B,
+                           float* R, size_t n)
+{
+  const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i ia   = _mm256_mullo_epi32(lane, _mm256_set1_epi32((int)a->strideA));
+  const __m256i ib   = _mm256_mullo_epi32(lane, _mm256_set1_epi32((int)a->strideB));
+
+  __m256 va[BATCH_IL_MAX * BATCH_IL_MAX];
+  __m256 vb[BATCH_IL_MAX * BATCH_IL_MAX];
+
+  for (size_t i = 0; i < n; i++) {
+    for (size_t k = 0; k < n; k++) {
+      va[i * n + k] = _mm256_i32gather_ps(&A[i * a->lda + k], ia, 4);
+      vb[i * n + k] = _mm256_i32gather_ps(&B[i * a->ldb + k], ib, 4);
+    }
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    __m256 acc[BATCH_IL_MAX];
+
+    for (size_t j = 0; j < n; j++) acc[j] = _mm256_setzero_ps();
+
+    for (size_t k = 0; k < n; k++) {
+      for (size_t j = 0; j < n; j++) {
+        acc[j] = _mm256_fmadd_ps(va[i * n + k], vb[k * n + j], acc[j]);
+      }
+    }
+
+    for (size_t j = 0; j < n; j++) {
+      float lanes[BATCH_V];
+
+      _mm256_storeu_ps(lanes, acc[j]);
+
+      for (size_t l = 0; l < BATCH_V; l++) R[l * a->strideR + i * a->ldr + j] = lanes[l];
+    }
+  }
+}
+
+/* R = A * B for one n x n x n product, n a multiple of 8 and of
+ * BATCH_RB */
+BATCH_INLINE void row_one(const args_t* a, const float* A, const float* B,
+                          float* R, size_t n)
+{
+  const size_t nv = n / BATCH_V;
+
+  for (size_t i = 0; i < n; i += BATCH_RB) {
+    __m256 acc[BATCH_RB][32 / BATCH_V];
+
+    for (size_t r = 0; r < BATCH_RB; r++) {
+      for (size_t v = 0; v < nv; v++) acc[r][v] = _mm256_setzero_ps();
+    }
+
+    for (size_t k = 0; k < n; k++) {
+      for (size_t r = 0; r < BATCH_RB; r++) {
+        __m256 ai = _mm256_set1_ps(A[(i + r) * a->lda + k]);
+
+        for (size_t v = 0; v < nv; v++) {
+          acc[r][v] = _mm256_fmadd_ps(ai, _mm256_loadu_ps(&B[k * a->ldb + v * BATCH_V]),
+                                      acc[r][v]);
+        }
+      }
+    }
+
+    for (size_t r = 0; r < BATCH_RB; r++) {
+      for (size_t v = 0; v < nv; v++) {
+        _mm256_storeu_ps(&R[(i + r) * a->ldr + v * BATCH_V], acc[r][v]);
+      }
+    }
+  }
+}
+
+BATCH_INLINE void avx2_sized(size_t n, const args_t* a)
+{
+  size_t count = batch_count(a);
+  size_t b     = 0;
+
+  if (n <= BATCH_IL_MAX) {
+    for (; b + BATCH_V <= count; b += BATCH_V) {
+      il_group(a, a->A + b * a->strideA, a->B + b * a->strideB,
+                  a->R + b * a->strideR, n);
+    }
+
+    /* Matrices short of a group */
+    batch_range(a, b, count, n, n, n);
+  } else {
+    for (; b < count; b++) {
+      row_one(a, a->A + b * a->strideA, a->B + b * a->strideB,
+                 a->R + b * a->strideR, n);
+    }
+  }
+}
+
+static void avx2_any(const args_t* a)
+{
+  batch_range(a, 0, batch_count(a), a->M, a->K, a->N);
+}
+
+void* impl_batch_avx2(void* args)
+{
+  args_t* a = (args_t*)args;
+
+  BATCH_SPECIALIZE(a, avx2_sized, avx2_any, a);
+
+  return NULL;
+}
+#endif
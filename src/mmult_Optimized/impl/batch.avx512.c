@@ -0,0 +1,136 @@
+/* batch.avx512.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX-512 variant of the batched GEMM (see batch.h); compiled with
+ * AVX-512 F/DQ/BW/VL and FMA.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/batch.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+
+/* Matrices per interleaved group, floats per register */
+#define BATCH_V 16
+
+/* Rows of R kept in registers at once by the one-matrix kernel */
+#define BATCH_RB 4
+
+/* R = A * B for the BATCH_V matrices starting at A, B and R; element
+ * (i, k) of all of them is one gather */
+BATCH_INLINE void il_group(const args_t* a, const float* A, const float* B,
+                           float* R, size_t n)
+{
+  const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,
+                                         8, 9, 10, 11, 12, 13, 14, 15);
+  const __m512i ia   = _mm512_mullo_epi32(lane, _mm512_set1_epi32((int)a->strideA));
+  const __m512i ib   = _mm512_mullo_epi32(lane, _mm512_set1_epi32((int)a->strideB));
+  const __m512i ir   = _mm512_mullo_epi32(lane, _mm512_set1_epi32((int)a->strideR));
+
+  __m512 va[BATCH_IL_MAX * BATCH_IL_MAX];
+  __m512 vb[BATCH_IL_MAX * BATCH_IL_MAX];
+
+  for (size_t i = 0; i < n; i++) {
+    for (size_t k = 0; k < n; k++) {
+      va[i * n + k] = _mm512_i32gather_ps(ia, &A[i * a->lda + k], 4);
+      vb[i * n + k] = _mm512_i32gather_ps(ib, &B[i * a->ldb + k], 4);
+    }
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    __m512 acc[BATCH_IL_MAX];
+
+    for (size_t j = 0; j < n; j++) acc[j] = _mm512_setzero_ps();
+
+    for (size_t k = 0; k < n; k++) {
+      for (size_t j = 0; j < n; j++) {
+        acc[j] = _mm512_fmadd_ps(va[i * n + k], vb[k * n + j], acc[j]);
+      }
+    }
+
+    for (size_t j = 0; j < n; j++) {
+      _mm512_i32scatter_ps(&R[i * a->ldr + j], ir, acc[j], 4);
+    }
+  }
+}
+
+/* R = A * B for one n x n x n product, n a multiple of 16 and of
+ * BATCH_RB */
+BATCH_INLINE void row_one(const args_t* a, const float* A, const float* B,
+                          float* R, size_t n)
+{
+  const size_t nv = n / BATCH_V;
+
+  for (size_t i = 0; i < n; i += BATCH_RB) {
+    __m512 acc[BATCH_RB][32 / BATCH_V];
+
+    for (size_t r = 0; r < BATCH_RB; r++) {
+      for (size_t v = 0; v < nv; v++) acc[r][v] = _mm512_setzero_ps();
+    }
+
+    for (size_t k = 0; k < n; k++) {
+      for (size_t r = 0; r < BATCH_RB; r++) {
+        __m512 ai = _mm512_set1_ps(A[(i + r) * a->lda + k]);
+
+        for (size_t v = 0; v < nv; v++) {
+          acc[r][v] = _mm512_fmadd_ps(ai, _mm512_loadu_ps(&B[k * a->ldb + v * BATCH_V]),
+                                      acc[r][v]);
+        }
+      }
+    }
+
+    for (size_t r = 0; r < BATCH_RB; r++) {
+      for (size_t v = 0; v < nv; v++) {
+        _mm512_storeu_ps(&R[(i + r) * a->ldr + v * BATCH_V], acc[r][v]);
+      }
+    }
+  }
+}
+
+BATCH_INLINE void avx512_sized(size_t n, const args_t* a)
+{
+  size_t count = batch_count(a);
+  size_t b     = 0;
+
+  if (n <= BATCH_IL_MAX) {
+    for (; b + BATCH_V <= count; b += BATCH_V) {
+      il_group(a, a->A + b * a->strideA, a->B + b * a->strideB,
+                  a->R + b * a->strideR, n);
+    }
+
+    /* Matrices short of a group */
+    batch_range(a, b, count, n, n, n);
+  } else {
+    for (; b < count; b++) {
+      row_one(a, a->A + b * a->strideA, a->B + b * a->strideB,
+                 a->R + b * a->strideR, n);
+    }
+  }
+}
+
+static void avx512_any(const args_t* a)
+{
+  batch_range(a, 0, batch_count(a), a->M, a->K, a->N);
+}
+
+void* impl_batch_avx512(void* args)
+{
+  args_t* a = (args_t*)args;
+
+  BATCH_SPECIALIZE(a, avx512_sized, avx512_any, a);
+
+  return NULL;
+}
+#endif
@@ -0,0 +1,109 @@
+/* batch.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Batched small-matrix GEMM: runtime dispatch, the scalar variant and the
+ * split over threads; see batch.h.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/cpu.h"
+#include "common/pool.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/batch.h"
+
+/* Variants, widest first */
+static const cpu_variant_t variants[] = {
+#if defined(__amd64__) || defined(__x86_64__)
+  { CPU_ISA_AVX512, impl_batch_avx512 },
+  { CPU_ISA_AVX2  , impl_batch_avx2   },
+#endif
+  { CPU_ISA_SCALAR, impl_batch_scalar },
+};
+
+static cpu_dispatch_t dispatch = CPU_DISPATCH_INIT(variants);
+
+static void batch_scalar_sized(size_t n, const args_t* a)
+{
+  batch_range(a, 0, batch_count(a), n, n, n);
+}
+
+static void batch_scalar_any(const args_t* a)
+{
+  batch_range(a, 0, batch_count(a), a->M, a->K, a->N);
+}
+
+/* Baseline variant; the specialized sizes are still unrolled */
+void* impl_batch_scalar(void* args)
+{
+  args_t* a = (args_t*)args;
+
+  BATCH_SPECIALIZE(a, batch_scalar_sized, batch_scalar_any, a);
+
+  return NULL;
+}
+
+bool batch_each(void* args, void* (*fn)(void* args))
+{
+  args_t* a = (args_t*)args;
+
+  if (a->batch <= 1) return false;
+
+  args_t one = *a;
+  one.batch  = 1;
+
+  for (size_t b = 0; b < a->batch; b++) {
+    one.A = a->A + b * a->strideA;
+    one.B = a->B + b * a->strideB;
+    one.R = a->R + b * a->strideR;
+
+    fn(&one);
+  }
+
+  return true;
+}
+
+/* Alternative Implementation */
+void* impl_batch(void* args)
+{
+  return cpu_dispatch(&dispatch)(args);
+}
+
+static void batch_worker(int tid, int nthreads, void* args)
+{
+  args_t* a = (args_t*)args;
+
+  /* Our whole groups of the batch */
+  size_t begin, end;
+  pool_partition(batch_count(a), BATCH_CHUNK_ALIGN, tid, nthreads, &begin, &end);
+
+  if (begin == end) return;
+
+  args_t chunk = *a;
+
+  chunk.A     = a->A + begin * a->strideA;
+  chunk.B     = a->B + begin * a->strideB;
+  chunk.R     = a->R + begin * a->strideR;
+  chunk.batch = end - begin;
+
+  impl_batch(&chunk);
+}
+
+void* impl_batch_para(void* args)
+{
+  args_t* a = (args_t*)args;
+
+  /* Dispatch into the worker pool */
+  pool_run(a->pool, a->nthreads, batch_worker, a);
+
+  return NULL;
+}
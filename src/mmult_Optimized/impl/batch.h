@@ -0,0 +1,105 @@
+/* batch.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the batched small-matrix GEMM: args->batch independent
+ * products, matrix b of A at A + b * strideA (likewise B and R). Tiny
+ * products spend their time in loop overhead and packing rather than in
+ * arithmetic, so impl_batch uses kernels specialized at compile time for
+ * the square sizes of BATCH_SPECIALIZE, fully unrolled:
+ *
+ *   n <= BATCH_IL_MAX  Interleaved: a group of one vector's worth of
+ *                      matrices is gathered element by element across
+ *                      the lanes, so every lane multiplies its own matrix
+ *                      and no lane idles on a 4-wide row
+ *   larger             One matrix at a time, rows of R in registers
+ *
+ * Other shapes (and the tail of a batch that does not fill a group) go
+ * through batch_one. impl_batch dispatches at runtime to the widest
+ * variant the host supports (see common/cpu.h); the variants live in
+ * batch.<isa>.c.
+ */
+
+#ifndef __IMPL_BATCH_H_
+#define __IMPL_BATCH_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "include/types.h"
+
+#define BATCH_INLINE static inline __attribute__((always_inline))
+
+/* Largest square size that is interleaved across lanes */
+#define BATCH_IL_MAX 8
+
+/* Per-thread chunks of impl_batch_para are whole groups of the widest
+ * variant */
+#define BATCH_CHUNK_ALIGN 16
+
+/* Call fn(n, ...) for the specialized n x n x n products, or fb(...) for
+ * any other shape */
+#define BATCH_SPECIALIZE(a, fn, fb, ...)                                \
+  do {                                                                  \
+    size_t __n = (a)->M;                                                \
+    bool   __sq = ((a)->K == __n && (a)->N == __n);                     \
+                                                                        \
+    if      (__sq && __n ==  4) fn( 4, __VA_ARGS__);                    \
+    else if (__sq && __n ==  8) fn( 8, __VA_ARGS__);                    \
+    else if (__sq && __n == 16) fn(16, __VA_ARGS__);                    \
+    else if (__sq && __n == 32) fn(32, __VA_ARGS__);                    \
+    else                        fb(__VA_ARGS__);                        \
+  } while (0)
+
+/* R = A * B for one M x K x N product; with constant sizes this unrolls
+ * into a fixed-size kernel */
+BATCH_INLINE void batch_one(const float* A, size_t lda,
+                            const float* B, size_t ldb,
+                                  float* R, size_t ldr,
+                            size_t M, size_t K, size_t N)
+{
+  for (size_t i = 0; i < M; i++) {
+    for (size_t j = 0; j < N; j++) R[i * ldr + j] = 0.0f;
+
+    for (size_t k = 0; k < K; k++) {
+      float a = A[i * lda + k];
+
+      for (size_t j = 0; j < N; j++) R[i * ldr + j] += a * B[k * ldb + j];
+    }
+  }
+}
+
+/* batch_one over matrices [begin, end) of a */
+BATCH_INLINE void batch_range(const args_t* a, size_t begin, size_t end,
+                              size_t M, size_t K, size_t N)
+{
+  for (size_t b = begin; b < end; b++) {
+    batch_one(a->A + b * a->strideA, a->lda,
+              a->B + b * a->strideB, a->ldb,
+              a->R + b * a->strideR, a->ldr, M, K, N);
+  }
+}
+
+/* Products of a; 1 outside batch mode */
+static inline size_t batch_count(const args_t* a)
+{
+  return (a->batch > 1) ? a->batch : 1;
+}
+
+/* Run the single-product implementation fn on every matrix of the batch
+ * in turn; false (having done nothing) outside batch mode */
+bool  batch_each(void* args, void* (*fn)(void* args));
+
+/* Function declaration */
+void* impl_batch     (void* args);
+
+/* impl_batch with the batch split over the threads */
+void* impl_batch_para(void* args);
+
+/* Per-ISA variants */
+void* impl_batch_scalar(void* args);
+void* impl_batch_avx2  (void* args);
+void* impl_batch_avx512(void* args);
+
+#endif //__IMPL_BATCH_H_
@@ -0,0 +1,275 @@
+/* dist.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the distributed GEMM; see dist.h.
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/pool.h"
+#include "common/dist.h"
+#include "common/driver.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/gemm.h"
+#include "impl/batch.h"
+#include "impl/para.h"
+#include "impl/dist.h"
+
+/* Tile of rank r on the pr x pc grid: rows [i0, i0 + m), columns
+ * [j0, j0 + n) of R */
+typedef struct {
+  size_t i0, m;
+  size_t j0, n;
+} dist_tile_t;
+
+static void dist_grid(int nranks, int* pr, int* pc)
+{
+  *pr = 1;
+  for (int p = 1; p * p <= nranks; p++) {
+    if (nranks % p == 0) *pr = p;
+  }
+  *pc = nranks / *pr;
+}
+
+static dist_tile_t dist_tile(const args_t* a, int r, int pr, int pc)
+{
+  dist_tile_t t;
+  size_t      end;
+
+  pool_partition(a->M, GEMM_MR, r / pc, pr, &t.i0, &end);
+  t.m = end - t.i0;
+  pool_partition(a->N, GEMM_NR, r % pc, pc, &t.j0, &end);
+  t.n = end - t.j0;
+
+  return t;
+}
+
+static void dist_lost(int r)
+{
+  printf("\n");
+  printf("ERROR: Lost rank %d\n", r);
+  exit(1);
+}
+
+void* impl_dist(void* args)
+{
+  /* A batch is the same product over every matrix */
+  if (batch_each(args, impl_dist)) return NULL;
+
+  args_t* a = (args_t*)args;
+  dist_t* d = a->dist;
+
+  if (d->nranks == 1 || a->M == 0 || a->N == 0 || a->K == 0) {
+    return impl_parallel(args);
+  }
+
+  int pr, pc;
+  dist_grid(d->nranks, &pr, &pc);
+
+  uint64_t t0 = dist_now();
+
+  /* Staging for the packed panels of one worker, and later its tile */
+  size_t kc_max = (a->K < GEMM_KC) ? a->K : GEMM_KC;
+  size_t stage  = 0;
+
+  for (int r = 1; r < d->nranks; r++) {
+    dist_tile_t t = dist_tile(a, r, pr, pc);
+    size_t      s = t.m * kc_max + kc_max * t.n;
+
+    if (t.m * t.n > s) s = t.m * t.n;
+    if (s > stage) stage = s;
+
+    if (t.m == 0 || t.n == 0) continue;
+
+    uint64_t arg[3] = { t.m, t.n, a->K };
+    if (!dist_send_msg(d, d->fds[r], DIST_TILE, arg, 3)) dist_lost(r);
+  }
+
+  float* buf = __ALLOC_DATA(float, stage > 0 ? stage : 1);
+
+  dist_tile_t own     = dist_tile(a, 0, pr, pc);
+  uint64_t    send    = dist_now() - t0;
+  uint64_t    compute = 0;
+
+  /* The k loop of SUMMA: panel p goes out, then rank 0 adds its share of
+   * it while the workers add theirs */
+  for (size_t p = 0; p < a->K; p += GEMM_KC) {
+    size_t   kc   = (a->K - p < GEMM_KC) ? a->K - p : GEMM_KC;
+    uint64_t last = (p + kc == a->K);
+    uint64_t t1   = dist_now();
+
+    for (int r = 1; r < d->nranks; r++) {
+      dist_tile_t t = dist_tile(a, r, pr, pc);
+      if (t.m == 0 || t.n == 0) continue;
+
+      float* Ap = buf;
+      float* Bp = buf + t.m * kc;
+
+      for (size_t i = 0; i < t.m; i++) {
+        memcpy(&Ap[i * kc], &a->A[(t.i0 + i) * a->lda + p], kc * sizeof(float));
+      }
+      for (size_t k = 0; k < kc; k++) {
+        memcpy(&Bp[k * t.n], &a->B[(p + k) * a->ldb + t.j0], t.n * sizeof(float));
+      }
+
+      uint64_t arg[2] = { kc, last };
+      if (!dist_send_msg(d, d->fds[r], DIST_PANEL, arg, 2) ||
+          !dist_send(d, d->fds[r], buf, (t.m * kc + kc * t.n) * sizeof(float))) {
+        dist_lost(r);
+      }
+    }
+
+    uint64_t t2 = dist_now();
+
+    para_sgemm_acc(a->pool, a->nthreads, own.m, own.n, kc,
+                   &a->A[own.i0 * a->lda + p], a->lda,
+                   &a->B[p * a->ldb + own.j0], a->ldb,
+                   &a->R[own.i0 * a->ldr + own.j0], a->ldr, p > 0);
+
+    uint64_t t3 = dist_now();
+
+    send    += t2 - t1;
+    compute += t3 - t2;
+  }
+
+  uint64_t t4 = dist_now();
+
+  for (int r = 1; r < d->nranks; r++) {
+    dist_tile_t t = dist_tile(a, r, pr, pc);
+    if (t.m == 0 || t.n == 0) continue;
+
+    dist_msg_t msg;
+    if (!dist_recv_msg(d, d->fds[r], &msg) || msg.op != DIST_DONE ||
+        msg.arg[0] != t.m * t.n ||
+        !dist_recv(d, d->fds[r], buf, t.m * t.n * sizeof(float))) {
+      dist_lost(r);
+    }
+
+    for (size_t i = 0; i < t.m; i++) {
+      memcpy(&a->R[(t.i0 + i) * a->ldr + t.j0], &buf[i * t.n], t.n * sizeof(float));
+    }
+
+    d->phases.remote_compute += (double)msg.arg[1];
+    d->phases.remote_wait    += (double)msg.arg[2];
+  }
+
+  __FREE_DATA(buf);
+
+  uint64_t t5 = dist_now();
+
+  d->phases.invocations++;
+  d->used            = true;
+  d->phases.send    += (double)send;
+  d->phases.compute += (double)compute;
+  d->phases.gather  += (double)(t5 - t4);
+
+  /* Done */
+  return NULL;
+}
+
+/* Grow *p to at least n floats; the old contents are not kept */
+static void dist_reserve(float** p, size_t* cap, size_t n)
+{
+  if (n <= *cap) return;
+
+  __FREE_DATA(*p);
+  *p   = __ALLOC_DATA(float, n);
+  *cap = n;
+}
+
+int dist_worker(const driver_env_t* env)
+{
+  dist_t* d  = env->dist;
+  int     fd = d->fds[0];
+
+  float*  C  = NULL; size_t ccap = 0;
+  float*  P  = NULL; size_t pcap = 0;
+  int     ret = 0;
+
+  for (;;) {
+    dist_msg_t msg;
+
+    /* Idle until the next product */
+    if (!dist_recv_msg(d, fd, &msg)) break;
+
+    if (msg.op != DIST_TILE) {
+      printf("ERROR: Unknown request %u from rank 0\n", msg.op);
+      ret = 1;
+      break;
+    }
+
+    size_t m = (size_t)msg.arg[0];
+    size_t n = (size_t)msg.arg[1];
+    size_t K = (size_t)msg.arg[2];
+    size_t kc_max = (K < GEMM_KC) ? K : GEMM_KC;
+
+    dist_reserve(&C, &ccap, m * n);
+    dist_reserve(&P, &pcap, m * kc_max + kc_max * n);
+
+    if (pool_reserve_scratch(env->pool, gemm_scratch_bytes(n, kc_max)) != 0) {
+      printf("ERROR: Cannot grow the scratch of the worker pool\n");
+      ret = 1;
+      break;
+    }
+
+    uint64_t compute = 0;
+    uint64_t wait    = 0;
+    bool     ok      = true;
+
+    for (size_t p = 0; ok; ) {
+      uint64_t t0 = dist_now();
+
+      ok = dist_recv_msg(d, fd, &msg) && msg.op == DIST_PANEL;
+
+      size_t kc   = ok ? (size_t)msg.arg[0] : 0;
+      bool   last = ok && msg.arg[1] != 0;
+
+      ok = ok && kc <= kc_max &&
+           dist_recv(d, fd, P, (m * kc + kc * n) * sizeof(float));
+
+      uint64_t t1 = dist_now();
+      wait += t1 - t0;
+
+      if (!ok) break;
+
+      para_sgemm_acc(env->pool, env->nthreads, m, n, kc,
+                     P, kc, P + m * kc, n, C, n, p > 0);
+
+      compute += dist_now() - t1;
+      p       += kc;
+
+      if (last) break;
+    }
+
+    if (!ok) {
+      printf("ERROR: Rank 0 hung up in the middle of a product\n");
+      ret = 1;
+      break;
+    }
+
+    uint64_t arg[3] = { m * n, compute, wait };
+    if (!dist_send_msg(d, fd, DIST_DONE, arg, 3) ||
+        !dist_send(d, fd, C, m * n * sizeof(float))) {
+      printf("ERROR: Rank 0 hung up before the tile\n");
+      ret = 1;
+      break;
+    }
+
+    d->phases.invocations++;
+  }
+
+  __FREE_DATA(C);
+  __FREE_DATA(P);
+
+  return ret;
+}
@@ -0,0 +1,42 @@
+/* dist.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the distributed GEMM (-i dist with --ranks N; common/dist.h),
+ * after SUMMA. The ranks form a pr x pc grid, as square as N allows, and
+ * rank i * pc + j owns tile (i, j) of R: the i-th of pr row blocks by the
+ * j-th of pc column blocks. The product runs as a loop over k-panels of
+ * GEMM_KC: for every panel, rank 0 sends each worker the panel of its A
+ * row block and of its B column block, then adds its own tile's share
+ * while the workers add theirs, so the next panel is on the wire while
+ * the last one is multiplied. SUMMA broadcasts the panels along the rows
+ * and columns of the grid; here the star around rank 0 carries them.
+ * Once the last panel is in, every worker sends back its tile.
+ *
+ *   DIST_TILE   rank 0 -> worker: arg[0] m, arg[1] n, arg[2] K of its tile
+ *   DIST_PANEL  rank 0 -> worker: arg[0] kc, arg[1] last panel; the m x kc
+ *               panel of A and the kc x n panel of B follow, packed
+ *   DIST_DONE   worker -> rank 0: arg[0] m * n, arg[1] ns computing,
+ *               arg[2] ns receiving; the tile follows, packed
+ *
+ * On one rank this is impl_parallel; a batch is distributed product by
+ * product.
+ */
+
+#ifndef __IMPL_DIST_H_
+#define __IMPL_DIST_H_
+
+#include "common/driver.h"
+
+#define DIST_TILE  1
+#define DIST_PANEL 2
+#define DIST_DONE  3
+
+/* Rank 0; args->dist must be set */
+void* impl_dist  (void* args);
+
+/* A worker: answer rank 0 until it hangs up (driver_bench_t.serve) */
+int   dist_worker(const driver_env_t* env);
+
+#endif //__IMPL_DIST_H_
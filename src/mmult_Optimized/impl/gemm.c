@@ -0,0 +1,350 @@
+/* gemm.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Packed single-precision GEMM core; see gemm.h.
+ */
+
+/* Standard C includes  */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+#include <arm_neon.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/cpu.h"
+
+/* Include application-specific headers */
+#include "impl/gemm.h"
+
+void gemm_pack_a(size_t mc, size_t kc, const float* A, size_t lda,
+                 float* Ap)
+{
+  for (size_t ir = 0; ir < mc; ir += GEMM_MR) {
+    size_t mr = (mc - ir) < GEMM_MR ? (mc - ir) : GEMM_MR;
+
+    for (size_t k = 0; k < kc; k++) {
+      for (size_t i = 0; i < GEMM_MR; i++) {
+        *(Ap++) = (i < mr) ? A[(ir + i) * lda + k] : 0.0f;
+      }
+    }
+  }
+}
+
+void gemm_pack_b(size_t kc, size_t nc, const float* B, size_t ldb,
+                 float* Bp)
+{
+  for (size_t jr = 0; jr < nc; jr += GEMM_NR) {
+    size_t nr = (nc - jr) < GEMM_NR ? (nc - jr) : GEMM_NR;
+
+    if (nr == GEMM_NR) {
+      for (size_t k = 0; k < kc; k++) {
+        memcpy(Bp, &B[k * ldb + jr], GEMM_NR * sizeof(float));
+        Bp += GEMM_NR;
+      }
+    } else {
+      for (size_t k = 0; k < kc; k++) {
+        for (size_t j = 0; j < GEMM_NR; j++) {
+          *(Bp++) = (j < nr) ? B[k * ldb + jr + j] : 0.0f;
+        }
+      }
+    }
+  }
+}
+
+typedef void (*gemm_micro_kernel_t)(size_t kc,
+                                    const float* restrict a,
+                                    const float* restrict b,
+                                    float* C, size_t ldc, bool accumulate);
+
+/* C[MR x NR] (+)= a[MR x kc] * b[kc x NR]; portable variant */
+static void gemm_micro_kernel_scalar(size_t kc,
+                                     const float* restrict a,
+                                     const float* restrict b,
+                                     float* C, size_t ldc, bool accumulate)
+{
+  float c[GEMM_MR][GEMM_NR] = { { 0.0f } };
+
+  for (size_t k = 0; k < kc; k++) {
+    for (size_t i = 0; i < GEMM_MR; i++) {
+      for (size_t j = 0; j < GEMM_NR; j++) {
+        c[i][j] += a[i] * b[j];
+      }
+    }
+
+    a += GEMM_MR;
+    b += GEMM_NR;
+  }
+
+  for (size_t i = 0; i < GEMM_MR; i++) {
+    for (size_t j = 0; j < GEMM_NR; j++) {
+      C[i * ldc + j] = accumulate ? (C[i * ldc + j] + c[i][j]) : c[i][j];
+    }
+  }
+}
+
+#if defined(__amd64__) || defined(__x86_64__)
+#pragma GCC push_options
+#pragma GCC target ("avx2,fma")
+
+/* C[MR x NR] (+)= a[MR x kc] * b[kc x NR]; 12 YMM accumulators */
+static void gemm_micro_kernel_avx2(size_t kc,
+                                   const float* restrict a,
+                                   const float* restrict b,
+                                   float* C, size_t ldc, bool accumulate)
+{
+  __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+  __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+  __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+  __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+  __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+  __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+  for (size_t k = 0; k < kc; k++) {
+    __m256 b0 = _mm256_load_ps(b + 0);
+    __m256 b1 = _mm256_load_ps(b + 8);
+    __m256 ai;
+
+    ai  = _mm256_broadcast_ss(a + 0);
+    c00 = _mm256_fmadd_ps(ai, b0, c00); c01 = _mm256_fmadd_ps(ai, b1, c01);
+    ai  = _mm256_broadcast_ss(a + 1);
+    c10 = _mm256_fmadd_ps(ai, b0, c10); c11 = _mm256_fmadd_ps(ai, b1, c11);
+    ai  = _mm256_broadcast_ss(a + 2);
+    c20 = _mm256_fmadd_ps(ai, b0, c20); c21 = _mm256_fmadd_ps(ai, b1, c21);
+    ai  = _mm256_broadcast_ss(a + 3);
+    c30 = _mm256_fmadd_ps(ai, b0, c30); c31 = _mm256_fmadd_ps(ai, b1, c31);
+    ai  = _mm256_broadcast_ss(a + 4);
+    c40 = _mm256_fmadd_ps(ai, b0, c40); c41 = _mm256_fmadd_ps(ai, b1, c41);
+    ai  = _mm256_broadcast_ss(a + 5);
+    c50 = _mm256_fmadd_ps(ai, b0, c50); c51 = _mm256_fmadd_ps(ai, b1, c51);
+
+    a += GEMM_MR;
+    b += GEMM_NR;
+  }
+
+  if (accumulate) {
+    c00 = _mm256_add_ps(c00, _mm256_loadu_ps(C + 0 * ldc + 0));
+    c01 = _mm256_add_ps(c01, _mm256_loadu_ps(C + 0 * ldc + 8));
+    c10 = _mm256_add_ps(c10, _mm256_loadu_ps(C + 1 * ldc + 0));
+    c11 = _mm256_add_ps(c11, _mm256_loadu_ps(C + 1 * ldc + 8));
+    c20 = _mm256_add_ps(c20, _mm256_loadu_ps(C + 2 * ldc + 0));
+    c21 = _mm256_add_ps(c21, _mm256_loadu_ps(C + 2 * ldc + 8));
+    c30 = _mm256_add_ps(c30, _mm256_loadu_ps(C + 3 * ldc + 0));
+    c31 = _mm256_add_ps(c31, _mm256_loadu_ps(C + 3 * ldc + 8));
+    c40 = _mm256_add_ps(c40, _mm256_loadu_ps(C + 4 * ldc + 0));
+    c41 = _mm256_add_ps(c41, _mm256_loadu_ps(C + 4 * ldc + 8));
+    c50 = _mm256_add_ps(c50, _mm256_loadu_ps(C + 5 * ldc + 0));
+    c51 = _mm256_add_ps(c51, _mm256_loadu_ps(C + 5 * ldc + 8));
+  }
+
+  _mm256_storeu_ps(C + 0 * ldc + 0, c00); _mm256_storeu_ps(C + 0 * ldc + 8, c01);
+  _mm256_storeu_ps(C + 1 * ldc + 0, c10); _mm256_storeu_ps(C + 1 * ldc + 8, c11);
+  _mm256_storeu_ps(C + 2 * ldc + 0, c20); _mm256_storeu_ps(C + 2 * ldc + 8, c21);
+  _mm256_storeu_ps(C + 3 * ldc + 0, c30); _mm256_storeu_ps(C + 3 * ldc + 8, c31);
+  _mm256_storeu_ps(C + 4 * ldc + 0, c40); _mm256_storeu_ps(C + 4 * ldc + 8, c41);
+  _mm256_storeu_ps(C + 5 * ldc + 0, c50); _mm256_storeu_ps(C + 5 * ldc + 8, c51);
+}
+
+#pragma GCC pop_options
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+
+/* One row of the tile: c[i][0..3] += a[i] * b[0..15], a[i] a lane of av */
+#define GEMM_NEON_ROW(i, fma, av, lane)                 \
+  do {                                                  \
+    c##i##0 = fma(c##i##0, b0, av, lane);               \
+    c##i##1 = fma(c##i##1, b1, av, lane);               \
+    c##i##2 = fma(c##i##2, b2, av, lane);               \
+    c##i##3 = fma(c##i##3, b3, av, lane);               \
+  } while (0)
+
+#define GEMM_NEON_STORE(i)                                                   \
+  do {                                                                       \
+    float* ci = C + i * ldc;                                                 \
+    if (accumulate) {                                                        \
+      c##i##0 = vaddq_f32(c##i##0, vld1q_f32(ci +  0));                      \
+      c##i##1 = vaddq_f32(c##i##1, vld1q_f32(ci +  4));                      \
+      c##i##2 = vaddq_f32(c##i##2, vld1q_f32(ci +  8));                      \
+      c##i##3 = vaddq_f32(c##i##3, vld1q_f32(ci + 12));                      \
+    }                                                                        \
+    vst1q_f32(ci +  0, c##i##0); vst1q_f32(ci +  4, c##i##1);                \
+    vst1q_f32(ci +  8, c##i##2); vst1q_f32(ci + 12, c##i##3);                \
+  } while (0)
+
+/* C[MR x NR] (+)= a[MR x kc] * b[kc x NR]; 24 Q accumulators, a[i] by
+ * lane so that no broadcasts are needed */
+static void gemm_micro_kernel_neon(size_t kc,
+                                   const float* restrict a,
+                                   const float* restrict b,
+                                   float* C, size_t ldc, bool accumulate)
+{
+  float32x4_t c00 = vdupq_n_f32(0.0f), c01 = c00, c02 = c00, c03 = c00;
+  float32x4_t c10 = c00, c11 = c00, c12 = c00, c13 = c00;
+  float32x4_t c20 = c00, c21 = c00, c22 = c00, c23 = c00;
+  float32x4_t c30 = c00, c31 = c00, c32 = c00, c33 = c00;
+  float32x4_t c40 = c00, c41 = c00, c42 = c00, c43 = c00;
+  float32x4_t c50 = c00, c51 = c00, c52 = c00, c53 = c00;
+
+  for (size_t k = 0; k < kc; k++) {
+    float32x4_t b0 = vld1q_f32(b +  0);
+    float32x4_t b1 = vld1q_f32(b +  4);
+    float32x4_t b2 = vld1q_f32(b +  8);
+    float32x4_t b3 = vld1q_f32(b + 12);
+    float32x4_t a0 = vld1q_f32(a + 0);
+    float32x2_t a4 = vld1_f32 (a + 4);
+
+    GEMM_NEON_ROW(0, vfmaq_laneq_f32, a0, 0);
+    GEMM_NEON_ROW(1, vfmaq_laneq_f32, a0, 1);
+    GEMM_NEON_ROW(2, vfmaq_laneq_f32, a0, 2);
+    GEMM_NEON_ROW(3, vfmaq_laneq_f32, a0, 3);
+    GEMM_NEON_ROW(4, vfmaq_lane_f32 , a4, 0);
+    GEMM_NEON_ROW(5, vfmaq_lane_f32 , a4, 1);
+
+    a += GEMM_MR;
+    b += GEMM_NR;
+  }
+
+  GEMM_NEON_STORE(0);
+  GEMM_NEON_STORE(1);
+  GEMM_NEON_STORE(2);
+  GEMM_NEON_STORE(3);
+  GEMM_NEON_STORE(4);
+  GEMM_NEON_STORE(5);
+}
+
+#undef GEMM_NEON_ROW
+#undef GEMM_NEON_STORE
+#endif
+
+void gemm_macro_kernel(size_t mc, size_t nc, size_t kc,
+                       const float* Ap, const float* Bp,
+                       float* C, size_t ldc, bool accumulate)
+{
+  /* Scratch tile for partial micro-tiles at the edges */
+  float edge[GEMM_MR * GEMM_NR] __attribute__((aligned(64)));
+
+  /* Pick the micro-kernel once per panel */
+  gemm_micro_kernel_t gemm_micro_kernel = gemm_micro_kernel_scalar;
+#if defined(__amd64__) || defined(__x86_64__)
+  if (cpu_isa_enabled(CPU_ISA_AVX2)) gemm_micro_kernel = gemm_micro_kernel_avx2;
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+  if (cpu_isa_enabled(CPU_ISA_NEON)) gemm_micro_kernel = gemm_micro_kernel_neon;
+#endif
+
+  for (size_t jr = 0; jr < nc; jr += GEMM_NR) {
+    size_t nr = (nc - jr) < GEMM_NR ? (nc - jr) : GEMM_NR;
+
+    for (size_t ir = 0; ir < mc; ir += GEMM_MR) {
+      size_t mr = (mc - ir) < GEMM_MR ? (mc - ir) : GEMM_MR;
+
+      const float* a = Ap + ir * kc;
+      const float* b = Bp + jr * kc;
+      float*       c = C  + ir * ldc + jr;
+
+      if (mr == GEMM_MR && nr == GEMM_NR) {
+        gemm_micro_kernel(kc, a, b, c, ldc, accumulate);
+      } else {
+        gemm_micro_kernel(kc, a, b, edge, GEMM_NR, false);
+
+        for (size_t i = 0; i < mr; i++) {
+          for (size_t j = 0; j < nr; j++) {
+            c[i * ldc + j] = accumulate ? (c[i * ldc + j] + edge[i * GEMM_NR + j])
+                                        :                   edge[i * GEMM_NR + j];
+          }
+        }
+      }
+    }
+  }
+}
+
+size_t gemm_scratch_bytes(size_t N, size_t K)
+{
+  size_t nc_max = N < GEMM_NC ? N : GEMM_NC;
+  size_t kc_max = K < GEMM_KC ? K : GEMM_KC;
+
+  nc_max = ((nc_max + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
+
+  /* A full MC panel, as the parallel GEMM packs one per thread */
+  size_t mc_max = ((GEMM_MC + GEMM_MR - 1) / GEMM_MR) * GEMM_MR;
+
+  return arena_bytes(mc_max * kc_max * sizeof(float)) +
+         arena_bytes(kc_max * nc_max * sizeof(float));
+}
+
+void gemm_sgemm(size_t M, size_t N, size_t K,
+                const float* A, size_t lda,
+                const float* B, size_t ldb,
+                      float* C, size_t ldc, arena_t* scratch)
+{
+  gemm_sgemm_acc(M, N, K, A, lda, B, ldb, C, ldc, false, scratch);
+}
+
+void gemm_sgemm_acc(size_t M, size_t N, size_t K,
+                    const float* A, size_t lda,
+                    const float* B, size_t ldb,
+                          float* C, size_t ldc, bool accumulate,
+                    arena_t* scratch)
+{
+  /* Degenerate depth: the product is all zeros */
+  if (K == 0) {
+    if (accumulate) return;
+
+    for (size_t i = 0; i < M; i++) {
+      memset(&C[i * ldc], 0, N * sizeof(float));
+    }
+    return;
+  }
+
+  /* Packing buffers, rounded up to whole slivers */
+  size_t nc_max = N < GEMM_NC ? N : GEMM_NC;
+  size_t mc_max = M < GEMM_MC ? M : GEMM_MC;
+  size_t kc_max = K < GEMM_KC ? K : GEMM_KC;
+
+  nc_max = ((nc_max + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
+  mc_max = ((mc_max + GEMM_MR - 1) / GEMM_MR) * GEMM_MR;
+
+  size_t mark = (scratch != NULL) ? arena_mark(scratch) : 0;
+  float* Ap;
+  float* Bp;
+
+  if (scratch != NULL) {
+    Ap = (float*)arena_alloc(scratch, mc_max * kc_max * sizeof(float));
+    Bp = (float*)arena_alloc(scratch, kc_max * nc_max * sizeof(float));
+  } else {
+    Ap = __ALLOC_DATA(float, mc_max * kc_max);
+    Bp = __ALLOC_DATA(float, kc_max * nc_max);
+  }
+
+  for (size_t jc = 0; jc < N; jc += GEMM_NC) {
+    size_t nc = (N - jc) < GEMM_NC ? (N - jc) : GEMM_NC;
+
+    for (size_t pc = 0; pc < K; pc += GEMM_KC) {
+      size_t kc = (K - pc) < GEMM_KC ? (K - pc) : GEMM_KC;
+
+      gemm_pack_b(kc, nc, &B[pc * ldb + jc], ldb, Bp);
+
+      for (size_t ic = 0; ic < M; ic += GEMM_MC) {
+        size_t mc = (M - ic) < GEMM_MC ? (M - ic) : GEMM_MC;
+
+        gemm_pack_a(mc, kc, &A[ic * lda + pc], lda, Ap);
+
+        gemm_macro_kernel(mc, nc, kc, Ap, Bp,
+                          &C[ic * ldc + jc], ldc, accumulate || pc > 0);
+      }
+    }
+  }
+
+  if (scratch != NULL) {
+    arena_rewind(scratch, mark);
+  } else {
+    __FREE_DATA(Ap);
+    __FREE_DATA(Bp);
+  }
+}
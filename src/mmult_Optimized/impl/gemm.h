@@ -0,0 +1,68 @@
+/* gemm.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the packed, register-blocked single-precision GEMM core
+ * shared by the vectorized and parallelized implementations. The
+ * structure follows BLIS:
+ *
+ *   jc loop (NC columns of B, L3)  -> pack a KC x NC panel of B
+ *    pc loop (KC depth, L1/L2)
+ *     ic loop (MC rows of A, L2)   -> pack an MC x KC panel of A
+ *      macro-kernel                -> MR x NR micro-tiles kept in registers
+ *
+ * All matrices are row-major; C = A * B (C is overwritten).
+ */
+
+#ifndef __IMPL_GEMM_H_
+#define __IMPL_GEMM_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "common/arena.h"
+
+/* Register block (6 x 16 = 12 YMM accumulators on AVX2, 24 Q registers on
+ * NEON; the micro-kernel is picked at runtime, see common/cpu.h) */
+#define GEMM_MR   6
+#define GEMM_NR  16
+
+/* Cache blocking: A panel (MC x KC) sits in L2, a KC x NR sliver of B in
+ * L1, and the B panel (KC x NC) in L3 */
+#define GEMM_KC 256
+#define GEMM_MC  72
+#define GEMM_NC 4080
+
+/* Pack an mc x kc block of A into MR-row slivers (zero padded) */
+void gemm_pack_a(size_t mc, size_t kc, const float* A, size_t lda,
+                 float* Ap);
+
+/* Pack a kc x nc block of B into NR-column slivers (zero padded) */
+void gemm_pack_b(size_t kc, size_t nc, const float* B, size_t ldb,
+                 float* Bp);
+
+/* C[mc x nc] (+)= Ap * Bp over packed panels */
+void gemm_macro_kernel(size_t mc, size_t nc, size_t kc,
+                       const float* Ap, const float* Bp,
+                       float* C, size_t ldc, bool accumulate);
+
+/* C[M x N] = A[M x K] * B[K x N]; the packing buffers come from scratch,
+ * or from the heap if it is NULL */
+void gemm_sgemm(size_t M, size_t N, size_t K,
+                const float* A, size_t lda,
+                const float* B, size_t ldb,
+                      float* C, size_t ldc, arena_t* scratch);
+
+/* C[M x N] (+)= A[M x K] * B[K x N]: gemm_sgemm, adding to C instead if
+ * accumulate is set */
+void gemm_sgemm_acc(size_t M, size_t N, size_t K,
+                    const float* A, size_t lda,
+                    const float* B, size_t ldb,
+                          float* C, size_t ldc, bool accumulate,
+                    arena_t* scratch);
+
+/* Scratch one thread needs for a gemm_sgemm (or parallel GEMM) call */
+size_t gemm_scratch_bytes(size_t N, size_t K);
+
+#endif //__IMPL_GEMM_H_
@@ -1,33 +1,42 @@
-/* Standard C includes */
-#include <stdlib.h>
-
-/* Include common headers */
-#include "common/macros.h"
-#include "common/types.h"
-
-/* Include application-specific headers */
-#include "include/types.h"
-
-
-void* impl_scalar_naive(void* args) {
-    /* Extract arguments */
-    args_t* arguments = (args_t*)args;
-    size_t size = arguments->size;
-
-    float* A = (float*)arguments->input;                            // A starts at the beginning
-    float* B = (float*)(arguments->input + size * size * sizeof(float)); // B starts after A
-    float* R = (float*)arguments->output;
-
-    /* Perform matrix-matrix multiplication */
-    for (size_t i = 0; i < size; i++) {
-        for (size_t j = 0; j < size; j++) {
-            R[i * size + j] = 0.0f; // Initialize the result matrix
-            for (size_t k = 0; k < size; k++) {
-                R[i * size + j] += A[i * size + k] * B[k * size + j];
-            }
-        }
-    }
-
-    return NULL;
-}
-
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/batch.h"
+
+
+void* impl_scalar_naive(void* args) {
+    // A batch is the same product over every matrix
+    if (batch_each(args, impl_scalar_naive)) return NULL;
+
+    /* Extract arguments */
+    args_t* arguments = (args_t*)args;
+    size_t M = arguments->M;
+    size_t K = arguments->K;
+    size_t N = arguments->N;
+
+    const float* A = arguments->A;   // M x K
+    const float* B = arguments->B;   // K x N
+    float*       R = arguments->R;   // M x N
+
+    size_t lda = arguments->lda;
+    size_t ldb = arguments->ldb;
+    size_t ldr = arguments->ldr;
+
+    /* Perform matrix-matrix multiplication */
+    for (size_t i = 0; i < M; i++) {
+        for (size_t j = 0; j < N; j++) {
+            R[i * ldr + j] = 0.0f; // Initialize the result matrix
+            for (size_t k = 0; k < K; k++) {
+                R[i * ldr + j] += A[i * lda + k] * B[k * ldb + j];
+            }
+        }
+    }
+
+    return NULL;
+}
@@ -1,5 +1,3 @@
-
-
 /* Standard C includes */
 #include <stdlib.h>
 
@@ -9,39 +7,54 @@
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "impl/batch.h"
+#include "impl/opt.h"
+
+/* Block size (tunable parameter); 16 is a typical value for cache
+ * optimization, --autotune finds this machine's */
+int opt_block_size = 16;
 
 
 void* impl_scalar_opt(void* args) {
+    // A batch is the same product over every matrix
+    if (batch_each(args, impl_scalar_opt)) return NULL;
+
     /* Extract arguments */
     args_t* arguments = (args_t*)args;
-    size_t size = arguments->size;
+    size_t M = arguments->M;
+    size_t K = arguments->K;
+    size_t N = arguments->N;
+
+    const float* A = arguments->A;   // Matrix A (M x K)
+    const float* B = arguments->B;   // Matrix B (K x N)
+    float*       R = arguments->R;   // Result matrix R (M x N)
 
-    float* A = (float*)arguments->input;                            // Matrix A
-    float* B = (float*)(arguments->input + size * size * sizeof(float)); // Matrix B
-    float* R = (float*)arguments->output;                           // Result matrix R
+    size_t lda = arguments->lda;
+    size_t ldb = arguments->ldb;
+    size_t ldr = arguments->ldr;
 
     /* Set block size (tunable parameter) */
-    size_t block_size = 16; // A typical value for cache optimization (adjust if necessary)
+    size_t block_size = (size_t)opt_block_size;
 
     /* Initialize Result Matrix */
-    for (size_t i = 0; i < size; i++) {
-        for (size_t j = 0; j < size; j++) {
-            R[i * size + j] = 0.0f; // Initialize all elements of R to zero
+    for (size_t i = 0; i < M; i++) {
+        for (size_t j = 0; j < N; j++) {
+            R[i * ldr + j] = 0.0f; // Initialize all elements of R to zero
         }
     }
 
     /* Perform Blocked Matrix Multiplication */
-    for (size_t ii = 0; ii < size; ii += block_size) {
-        for (size_t jj = 0; jj < size; jj += block_size) {
-            for (size_t kk = 0; kk < size; kk += block_size) {
+    for (size_t ii = 0; ii < M; ii += block_size) {
+        for (size_t jj = 0; jj < N; jj += block_size) {
+            for (size_t kk = 0; kk < K; kk += block_size) {
                 /* Multiply blocks */
-                for (size_t i = ii; i < ii + block_size && i < size; i++) {
-                    for (size_t j = jj; j < jj + block_size && j < size; j++) {
-                        float sum = R[i * size + j];
-                        for (size_t k = kk; k < kk + block_size && k < size; k++) {
-                            sum += A[i * size + k] * B[k * size + j];
+                for (size_t i = ii; i < ii + block_size && i < M; i++) {
+                    for (size_t j = jj; j < jj + block_size && j < N; j++) {
+                        float sum = R[i * ldr + j];
+                        for (size_t k = kk; k < kk + block_size && k < K; k++) {
+                            sum += A[i * lda + k] * B[k * ldb + j];
                         }
-                        R[i * size + j] = sum;
+                        R[i * ldr + j] = sum;
                     }
                 }
             }
@@ -50,4 +63,3 @@ void* impl_scalar_opt(void* args) {
 
     return NULL;
 }
-
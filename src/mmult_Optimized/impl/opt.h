@@ -3,6 +3,9 @@
 #ifndef __IMPL_OPT_H_
 #define __IMPL_OPT_H_
 
+/* Block size of the blocked loops; a runtime tunable (common/tune.h) */
+extern int opt_block_size;
+
 /* Function declaration */
 void* impl_scalar_opt(void* args);
 
@@ -7,22 +7,221 @@
  */
 
 /* Standard C includes */
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
 
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
-
-/* If we are on Darwin, include the compatibility header */
-#if defined(__APPLE__)
-#include "common/mach_pthread_compatibility.h"
-#endif
+#include "common/pool.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "impl/gemm.h"
+#include "impl/batch.h"
+#include "impl/para.h"
+
+/* Aim for a few tiles per thread so the atomic counter can balance */
+int para_tiles_per_thread = 4;
+
+/* Shared state of one parallel GEMM */
+typedef struct {
+  /* Problem */
+  size_t       M, N, K;
+  const float* A; size_t lda;
+  const float* B; size_t ldb;
+        float* C; size_t ldc;
+  bool         acc;            /* Add to C instead of overwriting it */
+
+  /* Packed panels: one shared B panel and one A panel per thread, from
+   * the threads' scratch arenas (or the heap without a pool) */
+  pool_t*      pool;
+  float*       Bp;
+  float*       Ap;
+  size_t       ap_stride;
+
+  /* Current (jc, pc) block */
+  size_t       jc, nc;
+  size_t       pc, kc;
+
+  /* 2D tiling of the current block of C */
+  size_t       tile_m, tile_n;
+  size_t       ntiles_m, ntiles_n;
+
+  _Alignas(64) atomic_size_t next;
+} para_gemm_t;
+
+static size_t round_up(size_t x, size_t m) { return ((x + m - 1) / m) * m; }
+
+/* Pick the macro-tile shape for an M x nc block of C: start from the L2
+ * sized MC x nc tile and split the wider dimension until there are
+ * enough tiles to keep nthreads busy. Tall-skinny shapes end up with
+ * row tiles, short-wide shapes with column tiles. */
+static void para_tiling(para_gemm_t* g, int nthreads)
+{
+  size_t target = (size_t)nthreads * para_tiles_per_thread;
+
+  g->tile_m = g->M < GEMM_MC ? round_up(g->M, GEMM_MR) : GEMM_MC;
+  g->tile_n = round_up(g->nc, GEMM_NR);
+
+  while (true) {
+    size_t tm = (g->M  + g->tile_m - 1) / g->tile_m;
+    size_t tn = (g->nc + g->tile_n - 1) / g->tile_n;
+
+    if (tm * tn >= target) break;
+
+    bool can_m = g->tile_m > GEMM_MR;
+    bool can_n = g->tile_n > GEMM_NR;
+
+    if (!can_m && !can_n) break;
+
+    /* Keep tiles roughly square in bytes touched */
+    if (can_n && (!can_m || g->tile_n >= g->tile_m)) {
+      g->tile_n = round_up(g->tile_n / 2, GEMM_NR);
+    } else {
+      g->tile_m = round_up(g->tile_m / 2, GEMM_MR);
+    }
+  }
+
+  g->ntiles_m = (g->M  + g->tile_m - 1) / g->tile_m;
+  g->ntiles_n = (g->nc + g->tile_n - 1) / g->tile_n;
+}
+
+/* Phase 1: all threads pack disjoint NR-slivers of the shared B panel */
+static void pack_worker(int tid, int nthreads, void* args)
+{
+  para_gemm_t* g = (para_gemm_t*)args;
+
+  size_t nslivers = (g->nc + GEMM_NR - 1) / GEMM_NR;
+  size_t begin, end;
+  pool_partition(nslivers, 1, tid, nthreads, &begin, &end);
+
+  if (begin == end) return;
+
+  size_t j0 = begin * GEMM_NR;
+  size_t j1 = end   * GEMM_NR < g->nc ? end * GEMM_NR : g->nc;
+
+  gemm_pack_b(g->kc, j1 - j0, &g->B[g->pc * g->ldb + g->jc + j0], g->ldb,
+              g->Bp + j0 * g->kc);
+}
+
+/* Phase 2: threads grab macro-tiles of C from a shared counter */
+static void tile_worker(int tid, int nthreads, void* args)
+{
+  para_gemm_t* g       = (para_gemm_t*)args;
+  arena_t*     scratch = pool_arena(g->pool, tid);
+  size_t       mark    = (scratch != NULL) ? arena_mark(scratch) : 0;
+  float*       Ap      = (scratch != NULL)
+                       ? (float*)arena_alloc(scratch, g->ap_stride * sizeof(float))
+                       : g->Ap + tid * g->ap_stride;
+
+  size_t ntiles = g->ntiles_m * g->ntiles_n;
+  size_t packed = (size_t)-1;
+
+  for (size_t t = atomic_fetch_add(&g->next, 1); t < ntiles;
+       t = atomic_fetch_add(&g->next, 1)) {
+    size_t tm = t / g->ntiles_n;
+    size_t tn = t % g->ntiles_n;
+
+    size_t i0 = tm * g->tile_m;
+    size_t j0 = tn * g->tile_n;
+    size_t mc = (g->M  - i0) < g->tile_m ? (g->M  - i0) : g->tile_m;
+    size_t nc = (g->nc - j0) < g->tile_n ? (g->nc - j0) : g->tile_n;
+
+    /* Tiles are handed out row-major; reuse our packed A when we get
+     * consecutive tiles of the same rows */
+    if (packed != tm) {
+      gemm_pack_a(mc, g->kc, &g->A[i0 * g->lda + g->pc], g->lda, Ap);
+      packed = tm;
+    }
+
+    gemm_macro_kernel(mc, nc, g->kc, Ap, g->Bp + j0 * g->kc,
+                      &g->C[i0 * g->ldc + g->jc + j0], g->ldc, g->acc || g->pc > 0);
+  }
+
+  if (scratch != NULL) arena_rewind(scratch, mark);
+}
+
+void para_sgemm_acc(pool_t* pool, int nthreads,
+                    size_t M, size_t N, size_t K,
+                    const float* A, size_t lda,
+                    const float* B, size_t ldb,
+                          float* C, size_t ldc, bool accumulate)
+{
+  if (M == 0 || N == 0) return;
+  if (K == 0 && accumulate) return;
+
+  /* Nothing to accumulate; the single-threaded path zeroes C */
+  if (K == 0) {
+    gemm_sgemm(M, N, K, A, lda, B, ldb, C, ldc, pool_arena(pool, 0));
+    return;
+  }
+
+  if (nthreads < 1) nthreads = 1;
+
+  para_gemm_t g;
+
+  g.M = M; g.N = N; g.K = K;
+  g.A = A; g.lda = lda;
+  g.B = B; g.ldb = ldb;
+  g.C = C; g.ldc = ldc;
+  g.acc = accumulate;
+
+  size_t nc_max = round_up(N < GEMM_NC ? N : GEMM_NC, GEMM_NR);
+  size_t kc_max = K < GEMM_KC ? K : GEMM_KC;
+
+  arena_t* scratch = pool_arena(pool, 0);
+  size_t   mark    = (scratch != NULL) ? arena_mark(scratch) : 0;
+
+  g.pool      = pool;
+  g.ap_stride = round_up(GEMM_MC, GEMM_MR) * kc_max;
+  if (scratch != NULL) {
+    g.Bp      = (float*)arena_alloc(scratch, kc_max * nc_max * sizeof(float));
+    g.Ap      = NULL;
+  } else {
+    g.Bp      = __ALLOC_DATA(float, kc_max * nc_max);
+    g.Ap      = __ALLOC_DATA(float, nthreads * g.ap_stride);
+  }
+
+  for (g.jc = 0; g.jc < N; g.jc += GEMM_NC) {
+    g.nc = (N - g.jc) < GEMM_NC ? (N - g.jc) : GEMM_NC;
+
+    para_tiling(&g, nthreads);
+
+    for (g.pc = 0; g.pc < K; g.pc += GEMM_KC) {
+      g.kc = (K - g.pc) < GEMM_KC ? (K - g.pc) : GEMM_KC;
+
+      pool_run(pool, nthreads, pack_worker, &g);
+
+      atomic_store(&g.next, 0);
+      pool_run(pool, nthreads, tile_worker, &g);
+    }
+  }
+
+  if (scratch != NULL) {
+    arena_rewind(scratch, mark);
+  } else {
+    __FREE_DATA(g.Ap);
+    __FREE_DATA(g.Bp);
+  }
+}
 
 /* Alternative Implementation */
 void* impl_parallel(void* args)
 {
+  /* A batch is the same product over every matrix */
+  if (batch_each(args, impl_parallel)) return NULL;
+
+  /* Extract arguments */
+  args_t* arguments = (args_t*)args;
+
+  para_sgemm_acc(arguments->pool, arguments->nthreads,
+                 arguments->M, arguments->N, arguments->K,
+                 arguments->A, arguments->lda,
+                 arguments->B, arguments->ldb,
+                 arguments->R, arguments->ldr, false);
+
   return NULL;
 }
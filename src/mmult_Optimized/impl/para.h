@@ -9,6 +9,23 @@
 #ifndef __IMPL_PARA_H_
 #define __IMPL_PARA_H_
 
+#include <stddef.h>
+#include <stdbool.h>
+
+struct pool_t;
+
+/* Macro-tiles per thread the tiling aims for, so the atomic counter can
+ * balance; a runtime tunable (common/tune.h) */
+extern int para_tiles_per_thread;
+
+/* C[M x N] (+)= A[M x K] * B[K x N] on nthreads of pool, adding to C
+ * instead if accumulate is set (impl/dist.h) */
+void para_sgemm_acc(struct pool_t* pool, int nthreads,
+                    size_t M, size_t N, size_t K,
+                    const float* A, size_t lda,
+                    const float* B, size_t ldb,
+                          float* C, size_t ldc, bool accumulate);
+
 /* Function declaration */
 void* impl_parallel(void* args);
 
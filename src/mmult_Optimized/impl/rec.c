@@ -0,0 +1,229 @@
+/* rec.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Cache-oblivious recursive and Strassen-Winograd GEMM; see rec.h.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdbool.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/arena.h"
+#include "common/pool.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/gemm.h"
+#include "impl/batch.h"
+#include "impl/rec.h"
+
+/* Split point of a dimension: about half, rounded to REC_ALIGN */
+static size_t rec_half(size_t n)
+{
+  size_t h = (n / 2 + REC_ALIGN - 1) / REC_ALIGN * REC_ALIGN;
+
+  return (h < n) ? h : n / 2;
+}
+
+/* C (+)= A * B, halving the largest dimension down to the leaf */
+static void rec_gemm(size_t M, size_t N, size_t K,
+                     const float* A, size_t lda,
+                     const float* B, size_t ldb,
+                           float* C, size_t ldc,
+                     bool accumulate, size_t leaf, arena_t* scratch)
+{
+  if (M <= leaf && N <= leaf && K <= leaf) {
+    gemm_sgemm_acc(M, N, K, A, lda, B, ldb, C, ldc, accumulate, scratch);
+    return;
+  }
+
+  if (M >= N && M >= K) {
+    size_t h = rec_half(M);
+
+    rec_gemm(h    , N, K, A          , lda, B, ldb, C          , ldc, accumulate, leaf, scratch);
+    rec_gemm(M - h, N, K, A + h * lda, lda, B, ldb, C + h * ldc, ldc, accumulate, leaf, scratch);
+  } else if (N >= K) {
+    size_t h = rec_half(N);
+
+    rec_gemm(M, h    , K, A, lda, B    , ldb, C    , ldc, accumulate, leaf, scratch);
+    rec_gemm(M, N - h, K, A, lda, B + h, ldb, C + h, ldc, accumulate, leaf, scratch);
+  } else {
+    /* The second half of the depth adds to the first */
+    size_t h = rec_half(K);
+
+    rec_gemm(M, N, h    , A    , lda, B          , ldb, C, ldc, accumulate, leaf, scratch);
+    rec_gemm(M, N, K - h, A + h, lda, B + h * ldb, ldb, C, ldc, true      , leaf, scratch);
+  }
+}
+
+/* Z = X + Y and Z = X - Y over m x n blocks */
+static void rec_add(size_t m, size_t n, const float* X, size_t ldx,
+                    const float* Y, size_t ldy, float* Z, size_t ldz)
+{
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) Z[i * ldz + j] = X[i * ldx + j] + Y[i * ldy + j];
+  }
+}
+
+static void rec_sub(size_t m, size_t n, const float* X, size_t ldx,
+                    const float* Y, size_t ldy, float* Z, size_t ldz)
+{
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) Z[i * ldz + j] = X[i * ldx + j] - Y[i * ldy + j];
+  }
+}
+
+/* Worth another Strassen level: the halves still hold whole leaves */
+static bool rec_use_strassen(size_t M, size_t N, size_t K,
+                             int levels, size_t leaf)
+{
+  return levels > 0 && M >= 2 * leaf && N >= 2 * leaf && K >= 2 * leaf;
+}
+
+/* C = A * B with up to levels of Strassen-Winograd on top of rec_gemm */
+static void rec_winograd(size_t M, size_t N, size_t K,
+                         const float* A, size_t lda,
+                         const float* B, size_t ldb,
+                               float* C, size_t ldc,
+                         int levels, size_t leaf, arena_t* scratch)
+{
+  if (!rec_use_strassen(M, N, K, levels, leaf)) {
+    rec_gemm(M, N, K, A, lda, B, ldb, C, ldc, false, leaf, scratch);
+    return;
+  }
+
+  /* The even part is split in quadrants; odd edges are peeled below */
+  size_t m2 = M & ~(size_t)1, hm = m2 / 2;
+  size_t k2 = K & ~(size_t)1, hk = k2 / 2;
+  size_t n2 = N & ~(size_t)1, hn = n2 / 2;
+
+  const float* A11 = A;            const float* A12 = A   + hk;
+  const float* A21 = A + hm * lda; const float* A22 = A21 + hk;
+  const float* B11 = B;            const float* B12 = B   + hn;
+  const float* B21 = B + hk * ldb; const float* B22 = B21 + hn;
+        float* C11 = C;                  float* C12 = C   + hn;
+        float* C21 = C + hm * ldc;       float* C22 = C21 + hn;
+
+  /* Temporaries: X for sums of A, Y for sums of B, Z for P1 */
+  size_t mark = arena_mark(scratch);
+  float* X = (float*)arena_alloc(scratch, hm * hk * sizeof(float));
+  float* Y = (float*)arena_alloc(scratch, hk * hn * sizeof(float));
+  float* Z = (float*)arena_alloc(scratch, hm * hn * sizeof(float));
+
+  /* The schedule keeps the seven products in C and the three
+   * temporaries (Douglas et al., GEMMW):
+   *
+   *   S1 = A21 + A22  S2 = S1 - A11  S3 = A11 - A21  S4 = A12 - S2
+   *   T1 = B12 - B11  T2 = B22 - T1  T3 = B22 - B12  T4 = T2 - B21
+   *   P1 = A11 B11  P2 = A12 B21  P3 = S4 B22  P4 = A22 T4
+   *   P5 = S1 T1    P6 = S2 T2    P7 = S3 T3
+   *   C11 = P1 + P2               C12 = P1 + P6 + P5 + P3
+   *   C21 = P1 + P6 + P7 - P4     C22 = P1 + P6 + P7 + P5
+   */
+  rec_sub(hm, hk, A11, lda, A21, lda, X, hk);                  /* S3 */
+  rec_sub(hk, hn, B22, ldb, B12, ldb, Y, hn);                  /* T3 */
+  rec_winograd(hm, hn, hk, X, hk, Y, hn, C21, ldc, levels - 1, leaf, scratch);
+
+  rec_add(hm, hk, A21, lda, A22, lda, X, hk);                  /* S1 */
+  rec_sub(hk, hn, B12, ldb, B11, ldb, Y, hn);                  /* T1 */
+  rec_winograd(hm, hn, hk, X, hk, Y, hn, C22, ldc, levels - 1, leaf, scratch);
+
+  rec_sub(hm, hk, X  , hk , A11, lda, X, hk);                  /* S2 */
+  rec_sub(hk, hn, B22, ldb, Y  , hn , Y, hn);                  /* T2 */
+  rec_winograd(hm, hn, hk, X, hk, Y, hn, C12, ldc, levels - 1, leaf, scratch);
+
+  rec_sub(hm, hk, A12, lda, X  , hk , X, hk);                  /* S4 */
+  rec_winograd(hm, hn, hk, X, hk, B22, ldb, C11, ldc, levels - 1, leaf, scratch);
+
+  rec_winograd(hm, hn, hk, A11, lda, B11, ldb, Z, hn, levels - 1, leaf, scratch);
+
+  rec_add(hm, hn, Z  , hn , C12, ldc, C12, ldc);               /* P1 + P6 */
+  rec_add(hm, hn, C12, ldc, C21, ldc, C21, ldc);               /* + P7    */
+  rec_add(hm, hn, C12, ldc, C22, ldc, C12, ldc);               /* + P5    */
+  rec_add(hm, hn, C21, ldc, C22, ldc, C22, ldc);               /* C22     */
+  rec_add(hm, hn, C12, ldc, C11, ldc, C12, ldc);               /* C12     */
+
+  rec_sub(hk, hn, Y, hn, B21, ldb, Y, hn);                     /* T4 */
+  rec_winograd(hm, hn, hk, A22, lda, Y, hn, C11, ldc, levels - 1, leaf, scratch);
+  rec_sub(hm, hn, C21, ldc, C11, ldc, C21, ldc);               /* C21 */
+
+  rec_winograd(hm, hn, hk, A12, lda, B21, ldb, C11, ldc, levels - 1, leaf, scratch);
+  rec_add(hm, hn, C11, ldc, Z, hn, C11, ldc);                  /* C11 */
+
+  arena_rewind(scratch, mark);
+
+  /* Odd edges: the last column of A times the last row of B, the last
+   * column of C and the last row of C */
+  if (K > k2) {
+    rec_gemm(m2, n2, 1, A + k2, lda, B + k2 * ldb, ldb, C, ldc, true, leaf, scratch);
+  }
+  if (N > n2) {
+    rec_gemm(m2, 1, K, A, lda, B + n2, ldb, C + n2, ldc, false, leaf, scratch);
+  }
+  if (M > m2) {
+    rec_gemm(1, N, K, A + m2 * lda, lda, B, ldb, C + m2 * ldc, ldc, false, leaf, scratch);
+  }
+}
+
+size_t rec_scratch_bytes(size_t M, size_t N, size_t K,
+                         int levels, size_t leaf)
+{
+  size_t bytes = 0;
+
+  /* The temporaries of every level are live at once */
+  while (rec_use_strassen(M, N, K, levels, leaf)) {
+    M /= 2; N /= 2; K /= 2; levels--;
+
+    bytes += arena_bytes(M * K * sizeof(float)) +
+             arena_bytes(K * N * sizeof(float)) +
+             arena_bytes(M * N * sizeof(float));
+  }
+
+  /* Plus the packing buffers of a leaf */
+  return bytes + gemm_scratch_bytes(N < leaf ? N : leaf, K < leaf ? K : leaf);
+}
+
+/* Alternative Implementation */
+void* impl_recursive(void* args)
+{
+  /* A batch is the same product over every matrix */
+  if (batch_each(args, impl_recursive)) return NULL;
+
+  /* Extract arguments */
+  args_t* arguments = (args_t*)args;
+
+  size_t leaf = arguments->leaf ? arguments->leaf : REC_LEAF_DEFAULT;
+
+  rec_gemm(arguments->M, arguments->N, arguments->K,
+           arguments->A, arguments->lda,
+           arguments->B, arguments->ldb,
+           arguments->R, arguments->ldr,
+           false, leaf, pool_arena(arguments->pool, 0));
+
+  return NULL;
+}
+
+/* Alternative Implementation */
+void* impl_strassen(void* args)
+{
+  /* A batch is the same product over every matrix */
+  if (batch_each(args, impl_strassen)) return NULL;
+
+  /* Extract arguments */
+  args_t* arguments = (args_t*)args;
+
+  size_t leaf = arguments->leaf ? arguments->leaf : REC_LEAF_DEFAULT;
+
+  rec_winograd(arguments->M, arguments->N, arguments->K,
+               arguments->A, arguments->lda,
+               arguments->B, arguments->ldb,
+               arguments->R, arguments->ldr,
+               arguments->strassen, leaf, pool_arena(arguments->pool, 0));
+
+  return NULL;
+}
@@ -0,0 +1,40 @@
+/* rec.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the cache-oblivious recursive GEMM. The largest of M, K and
+ * N is halved until all three fit in args->leaf, and the leaves go to the
+ * packed SIMD core (impl/gemm.h); every level of the memory hierarchy then
+ * sees blocks that fit it, without tuning for any of them.
+ *
+ * impl_strassen first applies up to args->strassen levels of
+ * Strassen-Winograd (7 half-size products and 15 additions instead of 8
+ * products) where all three dimensions are at least twice the leaf, and
+ * recurses as above below that. It trades a bounded loss of accuracy for
+ * the fewer flops; a last odd row, column or depth is peeled off and
+ * multiplied conventionally. The temporaries come from the thread's
+ * scratch arena (see rec_scratch_bytes).
+ */
+
+#ifndef __IMPL_REC_H_
+#define __IMPL_REC_H_
+
+#include <stddef.h>
+
+/* Default leaf size: all three dimensions of a leaf are at most this */
+#define REC_LEAF_DEFAULT 256
+
+/* Halves are rounded to this many elements, matching the micro-tile */
+#define REC_ALIGN 16
+
+/* Scratch one thread needs for an impl_strassen call with the given
+ * levels and leaf; 0 levels is the plain recursion */
+size_t rec_scratch_bytes(size_t M, size_t N, size_t K,
+                         int levels, size_t leaf);
+
+/* Function declaration */
+void* impl_recursive(void* args);
+void* impl_strassen (void* args);
+
+#endif //__IMPL_REC_H_
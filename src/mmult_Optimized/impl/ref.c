@@ -15,9 +15,38 @@
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "impl/batch.h"
 
 /* Reference Implementation */
 void* impl_ref(void* args)
 {
+  /* A batch is the same product over every matrix */
+  if (batch_each(args, impl_ref)) return NULL;
+
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  size_t M = parsed_args->M;
+  size_t K = parsed_args->K;
+  size_t N = parsed_args->N;
+
+  const float* A = parsed_args->A;
+  const float* B = parsed_args->B;
+        float* R = parsed_args->R;
+
+  /* Straightforward triple loop, accumulated in double */
+  for (size_t i = 0; i < M; i++) {
+    for (size_t j = 0; j < N; j++) {
+      double sum = 0.0;
+      for (size_t k = 0; k < K; k++) {
+        sum += (double)A[i * parsed_args->lda + k] *
+               (double)B[k * parsed_args->ldb + j];
+      }
+      R[i * parsed_args->ldr + j] = (float)sum;
+    }
+  }
+
+  /* Done */
   return NULL;
 }
@@ -12,15 +12,28 @@
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
+#include "common/pool.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "impl/gemm.h"
+#include "impl/batch.h"
 
 /* Alternative Implementation */
-#pragma GCC push_options
-#pragma GCC optimize ("O1")
 void* impl_vector(void* args)
 {
-  return NULL;
+    /* A batch is the same product over every matrix */
+    if (batch_each(args, impl_vector)) return NULL;
+
+    /* Extract arguments */
+    args_t* arguments = (args_t*)args;
+
+    /* Packed, register-blocked AVX2/FMA GEMM */
+    gemm_sgemm(arguments->M, arguments->N, arguments->K,
+               arguments->A, arguments->lda,
+               arguments->B, arguments->ldb,
+               arguments->R, arguments->ldr,
+               pool_arena(arguments->pool, 0));
+
+    return NULL;
 }
-#pragma GCC pop_options
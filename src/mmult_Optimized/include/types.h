@@ -3,13 +3,28 @@
 
 #include <stddef.h>  // For size_t
 
-// Define the argument structure
+// Define the argument structure: R[M x N] = A[M x K] * B[K x N], row-major;
+// in batch mode, the same for each of batch matrix triples (impl/batch.h)
 typedef struct {
-    void* input;       // Pointer to the input data (e.g., matrices A and B as floats)
-    void* output;      // Pointer to the output data (e.g., result matrix R as floats)
-    size_t size;       // Dimension size (used to define M, N, P)
+    const float* A;    // Pointer to matrix A
+    const float* B;    // Pointer to matrix B
+    float* R;          // Pointer to the result matrix R
+    size_t M;          // Rows of A and R
+    size_t K;          // Columns of A, rows of B
+    size_t N;          // Columns of B and R
+    size_t lda;        // Leading dimension (row stride in elements) of A, >= K
+    size_t ldb;        // Leading dimension of B, >= N
+    size_t ldr;        // Leading dimension of R, >= N
+    size_t batch;      // Products in the batch; batch <= 1 means the one product
+    size_t strideA;    // Elements from one matrix of A to the next in a batch
+    size_t strideB;    // ... of B
+    size_t strideR;    // ... of R
+    size_t leaf;       // Leaf size of the recursive impls; 0 = default (impl/rec.h)
+    int strassen;      // Strassen-Winograd levels of impl_strassen
     int cpu;           // CPU core to execute the benchmark (optional)
     int nthreads;      // Number of threads to use (optional for parallel implementation)
+    struct pool_t* pool; // Persistent worker pool (owned by main)
+    struct dist_t* dist; // Ranks of impl_dist (impl/dist.h), or NULL
 } args_t;
 
-#endif // __INCLUDE_TYPES_H_
\ No newline at end of file
+#endif // __INCLUDE_TYPES_H_
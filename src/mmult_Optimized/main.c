@@ -1,225 +1,524 @@
-/* Set features */
-#define _GNU_SOURCE
-
-/* Standard C includes */
-#include <assert.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <math.h>
-#include <string.h>
-#include <sched.h>
-#include <stdbool.h>
-#include <inttypes.h>
-#include <time.h>
-#include <unistd.h>
-#include <errno.h>
-#include <sys/stat.h>
-#include <sys/types.h>
-
-/* Include all implementations declarations */
-#include "impl/naive.h"
-#include "impl/opt.h"
-#include "impl/vec.h"
-#include "impl/para.h"
-
-/* Include common headers */
-#include "common/types.h"
-#include "common/macros.h"
-
-/* Include application-specific headers */
-#include "include/types.h"
-
-/* Default values */
-int num_runs = 10000;
-int nstdevs = 3;
-
-/* Helper function to print a matrix */
-void print_matrix(const char* name, float* matrix, size_t rows, size_t cols) {
-    printf("%s:\n", name);
-    for (size_t i = 0; i < rows; i++) {
-        for (size_t j = 0; j < cols; j++) {
-            printf("%.2f ", matrix[i * cols + j]);
-        }
-        printf("\n");
-    }
-    printf("\n");
-}
-
-/* Helper function to create the Result directory */
-void create_result_directory() {
-    struct stat st = {0};
-    if (stat("Result", &st) == -1) {
-        if (mkdir("Result", 0700) == 0) {
-            printf("Result directory created successfully.\n");
-        } else {
-            perror("Error creating Result directory");
-        }
-    }
-}
-
-/* Helper function to export a matrix to a CSV file in the Result directory */
-void export_matrix_to_csv(const char* filename, float* matrix, size_t rows, size_t cols) {
-    char filepath[256];
-    snprintf(filepath, sizeof(filepath), "Result/%s", filename);
-
-    FILE* file = fopen(filepath, "w");
-    if (!file) {
-        fprintf(stderr, "Error opening file %s for writing.\n", filepath);
-        return;
-    }
-
-    for (size_t i = 0; i < rows; i++) {
-        for (size_t j = 0; j < cols; j++) {
-            fprintf(file, "%.6f", matrix[i * cols + j]);
-            if (j < cols - 1) {
-                fprintf(file, ",");
-            }
-        }
-        fprintf(file, "\n");
-    }
-
-    fclose(file);
-}
-
-int main(int argc, char** argv) {
-    /* Set the buffer for printf to NULL */
-    setbuf(stdout, NULL);
-
-    /* Arguments */
-    int nthreads = 1;
-    int cpu = 0;
-    void* (*impl)(void* args) = NULL;
-    const char* impl_str = NULL;
-    bool run_both = false;
-    bool help = false;
-
-    /* Parse command-line arguments */
-    for (int i = 1; i < argc; i++) {
-        if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--impl") == 0) {
-            assert(++i < argc);
-            if (strcmp(argv[i], "naive") == 0) {
-                impl = impl_scalar_naive;
-                impl_str = "naive";
-            } else if (strcmp(argv[i], "opt") == 0) {
-                impl = impl_scalar_opt;
-                impl_str = "opt";
-            } else if (strcmp(argv[i], "vec") == 0) {
-                impl = impl_vector;
-                impl_str = "vectorized";
-            } else if (strcmp(argv[i], "para") == 0) {
-                impl = impl_parallel;
-                impl_str = "parallelized";
-            } else if (strcmp(argv[i], "both") == 0) {
-                run_both = true;
-            } else {
-                fprintf(stderr, "Unknown implementation: %s\n", argv[i]);
-                exit(1);
-            }
-            continue;
-        }
-
-        if (strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "--nthreads") == 0) {
-            assert(++i < argc);
-            nthreads = atoi(argv[i]);
-            continue;
-        }
-
-        if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--cpu") == 0) {
-            assert(++i < argc);
-            cpu = atoi(argv[i]);
-            continue;
-        }
-
-        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
-            help = true;
-            break;
-        }
-    }
-
-    if (help || (impl == NULL && !run_both)) {
-        printf("Usage: %s -i {naive|opt|vec|para|both} [Options]\n", argv[0]);
-        printf("\nOptions:\n");
-        printf("  -h | --help       Print this message\n");
-        printf("  -n | --nthreads   Set number of threads available (default = %d)\n", nthreads);
-        printf("  -c | --cpu        Set the main CPU for the program (default = %d)\n", cpu);
-        exit(help ? 0 : 1);
-    }
-
-    /* Prompt the user for matrix dimensions */
-    size_t rows_A, cols_A, rows_B, cols_B;
-
-    printf("Enter the number of rows for Matrix A: ");
-    scanf("%zu", &rows_A);
-
-    printf("Enter the number of columns for Matrix A: ");
-    scanf("%zu", &cols_A);
-
-    printf("Enter the number of rows for Matrix B: ");
-    scanf("%zu", &rows_B);
-
-    while (cols_A != rows_B) {
-        printf("Number of columns for Matrix A must equal the number of rows for Matrix B.\n");
-        printf("Enter the number of rows for Matrix B: ");
-        scanf("%zu", &rows_B);
-    }
-
-    printf("Enter the number of columns for Matrix B: ");
-    scanf("%zu", &cols_B);
-
-    /* Create the Result directory */
-    create_result_directory();
-
-    /* Allocate matrices */
-    size_t size_A = rows_A * cols_A;
-    size_t size_B = rows_B * cols_B;
-    size_t size_R = rows_A * cols_B;
-
-    float* A = malloc(size_A * sizeof(float));
-    float* B = malloc(size_B * sizeof(float));
-    float* R = malloc(size_R * sizeof(float));
-
-    if (!A || !B || !R) {
-        fprintf(stderr, "Memory allocation failed.\n");
-        exit(1);
-    }
-
-    /* Initialize matrices with random values */
-    srand((unsigned int)time(NULL));
-    for (size_t i = 0; i < size_A; i++) {
-        A[i] = (float)(rand() % 10);
-    }
-    for (size_t i = 0; i < size_B; i++) {
-        B[i] = (float)(rand() % 10);
-    }
-
-    /* Print input matrices */
-    print_matrix("Matrix A", A, rows_A, cols_A);
-    print_matrix("Matrix B", B, rows_B, cols_B);
-
-    /* Perform the selected implementation(s) */
-    if (run_both) {
-        printf("Running naive implementation...\n");
-        args_t args_naive = { .input = A, .output = R, .size = rows_A };
-        clock_t start_naive = clock();
-        impl_scalar_naive(&args_naive);
-        clock_t end_naive = clock();
-        double naive_time = (double)(end_naive - start_naive) / CLOCKS_PER_SEC;
-        printf("Naive Implementation Runtime: %.6f seconds\n", naive_time);
-        print_matrix("Result Matrix R (Naive)", R, rows_A, cols_B);
-    } else {
-        args_t args = { .input = A, .output = R, .size = rows_A };
-        clock_t start = clock();
-        impl(&args);
-        clock_t end = clock();
-        double runtime = (double)(end - start) / CLOCKS_PER_SEC;
-        printf("%s Implementation Runtime: %.6f seconds\n", impl_str, runtime);
-        print_matrix("Result Matrix R", R, rows_A, cols_B);
-    }
-
-    /* Free allocated memory */
-    free(A);
-    free(B);
-    free(R);
-
-    return 0;
-}
+/* Standard C includes */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+/* Include all implementations declarations */
+#include "impl/ref.h"
+#include "impl/naive.h"
+#include "impl/opt.h"
+#include "impl/vec.h"
+#include "impl/para.h"
+#include "impl/gemm.h"
+#include "impl/batch.h"
+#include "impl/rec.h"
+#include "impl/dist.h"
+
+/* Include common headers */
+#include "common/types.h"
+#include "common/macros.h"
+#include "common/driver.h"
+#include "common/output.h"
+#include "common/dist.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Default values */
+const size_t SIZE_DEFAULT = 256;
+#define MAX_SHAPES 64
+
+/* Largest error of an element with --real, relative to the sum of
+ * magnitudes of its products */
+#define MMULT_RTOL 1e-5
+
+/* One GEMM problem: R[M x N] = A[M x K] * B[K x N] */
+typedef struct {
+    size_t M, K, N;
+    char   label[64];
+} shape_t;
+
+/* Benchmark state */
+typedef struct {
+    /* Problem shape(s) */
+    size_t      M, K, N;
+    const char* sweep;
+    const char* sweep_dims;
+    size_t      batch;      /* Independent products per case; 0 = one */
+    size_t      leaf;       /* Leaf size of the recursive impls */
+    int         strassen;   /* Strassen-Winograd levels */
+    bool        real;       /* Real inputs instead of small integers */
+    bool        print;
+    bool        save;       /* Export A, B and the reference R */
+
+    shape_t     shapes[MAX_SHAPES];
+    int         nshapes;
+
+    /* Current case */
+    float*      A;
+    float*      B;
+    float*      R;
+    float*      ref;
+    float*      bound;      /* Sum of |a_ik b_kj| of every element (--real) */
+    double      err;        /* Largest relative error of the last verify */
+
+    args_t      args;
+} mmult_t;
+
+/* Matrices per case */
+static size_t mmult_count(const mmult_t* b) {
+    return (b->batch > 0) ? b->batch : 1;
+}
+
+/* Helper function to parse a sweep specification, either a comma separated
+ * list ("64,128,500") or a geometric range ("start:end[:factor]") */
+int parse_sweep(const char* spec, size_t* sizes, int max_sizes) {
+    int n = 0;
+
+    if (strchr(spec, ':') != NULL) {
+        size_t start = 0, end = 0, factor = 2;
+        if (sscanf(spec, "%zu:%zu:%zu", &start, &end, &factor) < 2 ||
+            start == 0 || factor < 2) {
+            return -1;
+        }
+        for (size_t x = start; x <= end && n < max_sizes; x *= factor) {
+            sizes[n++] = x;
+        }
+    } else {
+        const char* p = spec;
+        while (*p != '\0' && n < max_sizes) {
+            char* next;
+            size_t x = strtoull(p, &next, 10);
+            if (next == p || x == 0) return -1;
+            sizes[n++] = x;
+            p = (*next == ',') ? next + 1 : next;
+            if (*next != ',' && *next != '\0') return -1;
+        }
+    }
+
+    return n;
+}
+
+/* Helper function to print a matrix */
+void print_matrix(const char* name, float* matrix, size_t rows, size_t cols) {
+    printf("%s:\n", name);
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            printf("%.2f ", matrix[i * cols + j]);
+        }
+        printf("\n");
+    }
+    printf("\n");
+}
+
+/* Helper function to create the Result directory, inside --output-dir */
+void create_result_directory() {
+    if (out_mkdir("Result") != 0) {
+        perror("Error creating Result directory");
+    }
+}
+
+/* Helper function to export a matrix to the Result directory, in the
+ * --output-format (common/output.h); written in the background */
+void export_matrix(const char* case_label, const char* name, const float* matrix,
+                   size_t rows, size_t cols) {
+    char filepath[256];
+    snprintf(filepath, sizeof(filepath), "Result/%s_%s", case_label, name);
+
+    if (out_matrix(filepath, matrix, rows, cols, 6) != 0) {
+        fprintf(stderr, "Error exporting %s.\n", filepath);
+    }
+}
+
+static int mmult_parse_arg(void* ctx, int argc, char** argv, int i) {
+    mmult_t* b = (mmult_t*)ctx;
+
+    /* Matrix dimensions */
+    if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--size") == 0) {
+        assert(++i < argc);
+        b->M = b->K = b->N = strtoull(argv[i], NULL, 10);
+        return 2;
+    }
+
+    if (strcmp(argv[i], "--M") == 0) {
+        assert(++i < argc);
+        b->M = strtoull(argv[i], NULL, 10);
+        return 2;
+    }
+
+    if (strcmp(argv[i], "--K") == 0) {
+        assert(++i < argc);
+        b->K = strtoull(argv[i], NULL, 10);
+        return 2;
+    }
+
+    if (strcmp(argv[i], "--N") == 0) {
+        assert(++i < argc);
+        b->N = strtoull(argv[i], NULL, 10);
+        return 2;
+    }
+
+    if (strcmp(argv[i], "--sweep") == 0) {
+        assert(++i < argc);
+        b->sweep = argv[i];
+        return 2;
+    }
+
+    if (strcmp(argv[i], "--sweep-dims") == 0) {
+        assert(++i < argc);
+        b->sweep_dims = argv[i];
+        return 2;
+    }
+
+    if (strcmp(argv[i], "--batch") == 0) {
+        assert(++i < argc);
+        b->batch = strtoull(argv[i], NULL, 10);
+        return 2;
+    }
+
+    if (strcmp(argv[i], "--leaf") == 0) {
+        assert(++i < argc);
+        b->leaf = strtoull(argv[i], NULL, 10);
+        return 2;
+    }
+
+    if (strcmp(argv[i], "--strassen") == 0) {
+        assert(++i < argc);
+        b->strassen = atoi(argv[i]);
+        return 2;
+    }
+
+    if (strcmp(argv[i], "--real") == 0) {
+        b->real = true;
+        return 1;
+    }
+
+    if (strcmp(argv[i], "--save") == 0) {
+        b->save = true;
+        return 1;
+    }
+
+    if (strcmp(argv[i], "--print") == 0) {
+        b->print = true;
+        return 1;
+    }
+
+    return 0;
+}
+
+static void mmult_usage(void* ctx) {
+    mmult_t* b = (mmult_t*)ctx;
+
+    printf("    -s | --size      Set M = K = N (default = %zu)\n", SIZE_DEFAULT);
+    printf("         --M         Rows of A and R (default = %zu)\n", b->M);
+    printf("         --K         Columns of A and rows of B (default = %zu)\n", b->K);
+    printf("         --N         Columns of B and R (default = %zu)\n", b->N);
+    printf("         --sweep     Sweep sizes: a list \"64,128,500\" or a geometric\n");
+    printf("                     range \"start:end[:factor]\" (default factor = 2)\n");
+    printf("         --sweep-dims Dimensions set by the sweep (default = %s)\n", b->sweep_dims);
+    printf("         --batch     Multiply this many independent matrices per case\n");
+    printf("                     (default = off; see the batch implementations)\n");
+    printf("         --leaf      Leaf size of the recursive impls (default = %zu)\n", b->leaf);
+    printf("         --strassen  Strassen-Winograd levels of \"strassen\" (default = %d)\n", b->strassen);
+    printf("         --real      Random reals in [-1, 1) instead of small integers, so\n");
+    printf("                     rounding shows; results must then be within %.0e\n", MMULT_RTOL);
+    printf("                     of the sum of magnitudes of their products\n");
+    printf("         --save      Export A, B and the reference result of every case\n");
+    printf("                     to Result/ (see --output-format and --output-dir)\n");
+    printf("         --print     Print the input and result matrices (the first\n");
+    printf("                     of a batch)\n");
+}
+
+/* Build the list of shapes once the command line is parsed */
+static int mmult_ncases(void* ctx) {
+    mmult_t* b = (mmult_t*)ctx;
+
+    if (b->sweep != NULL) {
+        size_t sizes[MAX_SHAPES];
+        b->nshapes = parse_sweep(b->sweep, sizes, MAX_SHAPES);
+        if (b->nshapes <= 0) {
+            fprintf(stderr, "Invalid sweep specification: %s\n", b->sweep);
+            exit(1);
+        }
+        for (int s = 0; s < b->nshapes; s++) {
+            b->shapes[s].M = strchr(b->sweep_dims, 'M') ? sizes[s] : b->M;
+            b->shapes[s].K = strchr(b->sweep_dims, 'K') ? sizes[s] : b->K;
+            b->shapes[s].N = strchr(b->sweep_dims, 'N') ? sizes[s] : b->N;
+        }
+    } else {
+        b->shapes[0].M = b->M;
+        b->shapes[0].K = b->K;
+        b->shapes[0].N = b->N;
+        b->nshapes = 1;
+    }
+
+    for (int s = 0; s < b->nshapes; s++) {
+        if (b->batch > 0) {
+            snprintf(b->shapes[s].label, sizeof(b->shapes[s].label), "%zux%zux%zux%zu",
+                     b->shapes[s].M, b->shapes[s].K, b->shapes[s].N, b->batch);
+        } else {
+            snprintf(b->shapes[s].label, sizeof(b->shapes[s].label), "%zux%zux%zu",
+                     b->shapes[s].M, b->shapes[s].K, b->shapes[s].N);
+        }
+    }
+
+    /* Create the Result directory */
+    create_result_directory();
+
+    return b->nshapes;
+}
+
+static bool mmult_setup(void* ctx, int idx, const driver_env_t* env,
+                        driver_case_t* c) {
+    mmult_t* b = (mmult_t*)ctx;
+
+    size_t rows_A = b->shapes[idx].M;
+    size_t cols_A = b->shapes[idx].K;
+    size_t cols_B = b->shapes[idx].N;
+
+    /* Allocate matrices, back to back in batch mode */
+    size_t count  = mmult_count(b);
+    size_t size_A = rows_A * cols_A * count;
+    size_t size_B = cols_A * cols_B * count;
+    size_t size_R = rows_A * cols_B * count;
+
+    b->A   = __ALLOC_DATA(float, size_A + 1);
+    b->B   = __ALLOC_DATA(float, size_B + 1);
+    b->R   = __ALLOC_DATA(float, size_R + 1);
+    b->ref = __ALLOC_DATA(float, size_R + 1);
+
+    /* Setting a guard, which is 0xdeadcafe.
+       The guard should not change or be touched. */
+    __SET_GUARD(b->R, size_R * sizeof(float));
+
+    if (b->leaf == 0) {
+        printf("\n");
+        printf("ERROR: The leaf size must be positive!\n");
+        return false;
+    }
+
+    /* Initialize matrices with small integers, so every impl is exact,
+       or with reals, so that reassociation and Strassen show up */
+    for (size_t i = 0; i < size_A; i++) {
+        b->A[i] = b->real ? 2.0f * rand() / RAND_MAX - 1.0f : (float)(rand() % 10);
+    }
+    for (size_t i = 0; i < size_B; i++) {
+        b->B[i] = b->real ? 2.0f * rand() / RAND_MAX - 1.0f : (float)(rand() % 10);
+    }
+
+    if (b->print) {
+        print_matrix("Matrix A", b->A, rows_A, cols_A);
+        print_matrix("Matrix B", b->B, cols_A, cols_B);
+    }
+
+    args_t args = { .A = b->A, .B = b->B, .R = b->R,
+                    .M = rows_A, .K = cols_A, .N = cols_B,
+                    .lda = cols_A, .ldb = cols_B, .ldr = cols_B,
+                    .batch = b->batch,
+                    .strideA = rows_A * cols_A, .strideB = cols_A * cols_B,
+                    .strideR = rows_A * cols_B,
+                    .leaf = b->leaf, .strassen = b->strassen,
+                    .cpu = env->cpu, .nthreads = env->nthreads, .pool = env->pool,
+                    .dist = env->dist };
+
+    /* Reference result */
+    args_t args_ref = args;
+    args_ref.R = b->ref;
+    impl_ref(&args_ref);
+
+    /* Scale of the error bound of every element: the same product over
+       the magnitudes */
+    if (b->real) {
+        float* absA = __ALLOC_DATA(float, size_A);
+        float* absB = __ALLOC_DATA(float, size_B);
+
+        for (size_t i = 0; i < size_A; i++) absA[i] = fabsf(b->A[i]);
+        for (size_t i = 0; i < size_B; i++) absB[i] = fabsf(b->B[i]);
+
+        b->bound = __ALLOC_DATA(float, size_R);
+
+        args_ref.A = absA;
+        args_ref.B = absB;
+        args_ref.R = b->bound;
+        impl_ref(&args_ref);
+
+        __FREE_DATA(absA);
+        __FREE_DATA(absB);
+    }
+
+    b->args = args;
+
+    memset(&env->dist->phases, 0, sizeof(env->dist->phases));
+    env->dist->used = false;
+
+    /* A batch is exported as one tall matrix */
+    if (b->save) {
+        export_matrix(b->shapes[idx].label, "A", b->A, rows_A * count, cols_A);
+        export_matrix(b->shapes[idx].label, "B", b->B, cols_A * count, cols_B);
+        export_matrix(b->shapes[idx].label, "R", b->ref, rows_A * count, cols_B);
+    }
+
+    c->args    = &b->args;
+    c->label   = b->shapes[idx].label;
+    c->flops   = 2.0 * rows_A * cols_A * cols_B * count;
+    c->bytes   = (double)(size_A + size_B + size_R) * sizeof(float);
+    /* Packing buffers, and the Strassen temporaries */
+    c->scratch = gemm_scratch_bytes(cols_B, cols_A);
+
+    size_t rec = rec_scratch_bytes(rows_A, cols_B, cols_A, b->strassen, b->leaf);
+    if (rec > c->scratch) c->scratch = rec;
+
+    /* Batches also report matrices per second */
+    if (b->batch > 0) {
+        c->elems = (double)b->batch;
+        c->unit  = "matrices";
+    }
+
+    return true;
+}
+
+static driver_check_t mmult_verify(void* ctx, int idx) {
+    mmult_t* b = (mmult_t*)ctx;
+    size_t size_R = b->shapes[idx].M * b->shapes[idx].N * mmult_count(b);
+    driver_check_t check = { 0 };
+
+    if (b->real) {
+        /* Statistics over the whole output; only NaNs fail this part */
+        check.match = check_floats(b->ref, b->R, size_R, INFINITY, &check.err);
+
+        b->err = 0.0;
+        for (size_t i = 0; i < size_R; i++) {
+            double d   = fabs((double)b->R[i] - b->ref[i]);
+            double err = (b->bound[i] > 0.0f) ? d / b->bound[i] : d;
+
+            if (err > b->err) b->err = err;
+        }
+
+        check.match = check.match && (b->err <= MMULT_RTOL);
+    } else {
+        check.match = check_floats(b->ref, b->R, size_R, 1e-3, &check.err);
+    }
+    check.guard = __CHECK_GUARD(b->R, size_R * sizeof(float));
+
+    if (b->print) {
+        print_matrix("Result Matrix R", b->R, b->shapes[idx].M, b->shapes[idx].N);
+    }
+
+    return check;
+}
+
+static void mmult_report(void* ctx, int idx) {
+    mmult_t* b = (mmult_t*)ctx;
+
+    if (b->real) {
+        printf("  * Error: %.3g of the sum of magnitudes of an element\n", b->err);
+    }
+
+    if (b->args.dist != NULL && b->args.dist->used) dist_print(b->args.dist, "  ");
+}
+
+static void mmult_dump(void* ctx, int idx, FILE* fp) {
+    mmult_t* b = (mmult_t*)ctx;
+
+    fprintf(fp, "\nM,%zu\nK,%zu\nN,%zu",
+            b->shapes[idx].M, b->shapes[idx].K, b->shapes[idx].N);
+
+    if (b->batch > 0) fprintf(fp, "\nbatch,%zu", b->batch);
+    if (b->real)      fprintf(fp, "\nrel_err,%.6g", b->err);
+
+    if (b->args.dist != NULL && b->args.dist->used) dist_dump(b->args.dist, fp);
+}
+
+static void mmult_reset(void* ctx, int idx) {
+    mmult_t* b = (mmult_t*)ctx;
+
+    /* The next implementation reports only if it is distributed too */
+    if (b->args.dist != NULL) b->args.dist->used = false;
+
+    /* Clear the result, leaving the guard intact */
+    memset(b->R, 0, b->shapes[idx].M * b->shapes[idx].N * mmult_count(b) * sizeof(float));
+}
+
+static void mmult_set_nthreads(void* ctx, int idx, int nthreads) {
+    mmult_t* b = (mmult_t*)ctx;
+
+    b->args.nthreads = nthreads;
+}
+
+static int mmult_serve(void* ctx, const driver_env_t* env) {
+    return dist_worker(env);
+}
+
+static void mmult_teardown(void* ctx, int idx) {
+    mmult_t* b = (mmult_t*)ctx;
+
+    /* Free allocated memory */
+    __FREE_DATA(b->A);
+    __FREE_DATA(b->B);
+    __FREE_DATA(b->R);
+    __FREE_DATA(b->ref);
+    __FREE_DATA(b->bound);
+}
+
+static const int opt_blocks[] = { 8, 16, 32, 64, 128 };
+static const int para_tiles[] = { 1, 2, 4, 8, 16 };
+
+static const tune_param_t tunables[] = {
+    { "opt.block" , "opt" , &opt_block_size       , opt_blocks, 5 },
+    { "para.tiles", "para", &para_tiles_per_thread, para_tiles, 5 },
+};
+
+static const driver_impl_t impls[] = {
+    { "naive"     , "naive"           , impl_scalar_naive },
+    { "opt"       , "opt"             , impl_scalar_opt   },
+    { "vec"       , "vectorized"      , impl_vector       },
+    { "para"      , "parallelized"    , impl_parallel     },
+    { "batch"     , "batched"         , impl_batch        },
+    { "batch_para", "batched_parallel", impl_batch_para   },
+    { "rec"       , "recursive"       , impl_recursive    },
+    { "strassen"  , "strassen"        , impl_strassen     },
+    { "dist"      , "distributed"     , impl_dist         },
+};
+
+int main(int argc, char** argv) {
+    mmult_t ctx;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.M = ctx.K = ctx.N = SIZE_DEFAULT;
+    ctx.sweep_dims = "MKN";
+    ctx.leaf       = REC_LEAF_DEFAULT;
+    ctx.strassen   = 1;
+
+    driver_bench_t bench = {
+        .name         = "mmult",
+        .impls        = impls,
+        .nimpls       = sizeof(impls) / sizeof(impls[0]),
+
+        .nruns        = 16,
+        .ninner       = 1,
+        .nwarmup      = 2,
+
+        .tunables     = tunables,
+        .ntunables    = sizeof(tunables) / sizeof(tunables[0]),
+
+        .ctx          = &ctx,
+
+        .parse_arg    = mmult_parse_arg,
+        .usage        = mmult_usage,
+        .ncases       = mmult_ncases,
+        .setup        = mmult_setup,
+        .verify       = mmult_verify,
+        .report       = mmult_report,
+        .reset        = mmult_reset,
+        .dump         = mmult_dump,
+        .teardown     = mmult_teardown,
+        .set_nthreads = mmult_set_nthreads,
+        .serve        = mmult_serve,
+    };
+
+    return driver_main(&bench, argc, argv);
+}
@@ -0,0 +1,49 @@
+/* naive.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * One accumulator, in index order.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/mapreduce.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/repro.h"
+
+/* Naive Implementation */
+#pragma GCC push_options
+#pragma GCC optimize ("O1")
+MR_REDUCE_NAIVE (sum_i32_naive, i32, REDUCE_ID     , REDUCE_ADD_i32, 0   )
+MR_REDUCE_NAIVE (sum_f32_naive, f32, REDUCE_ID     , REDUCE_ADD_f32, 0.0f)
+MR_REDUCE2_NAIVE(dot_i32_naive, i32, REDUCE_MUL_i32, REDUCE_ADD_i32, 0   )
+MR_REDUCE2_NAIVE(dot_f32_naive, f32, REDUCE_MUL_f32, REDUCE_ADD_f32, 0.0f)
+ARGMAX_NAIVE    (argmax_i32_naive, i32)
+ARGMAX_NAIVE    (argmax_f32_naive, f32)
+
+static void* (*const kernels[OP_NUM][ELEM_NUM])(void* args) = {
+  [OP_SUM   ] = { sum_i32_naive   , sum_f32_naive    },
+  [OP_DOT   ] = { dot_i32_naive   , dot_f32_naive    },
+  [OP_ARGMAX] = { argmax_i32_naive, argmax_f32_naive },
+};
+
+void* impl_scalar_naive(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  if (repro_applies(parsed_args)) {
+    return repro_run(args, (parsed_args->op == OP_SUM) ? repro_sum_block_scalar
+                                                       : repro_dot_block_scalar);
+  }
+
+  return kernels[parsed_args->op][parsed_args->elem](args);
+}
+#pragma GCC pop_options
@@ -0,0 +1,15 @@
+/* opt.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 13 Nov. 2023
+ *
+ * Header for scalar naive function.
+ */
+
+#ifndef __IMPL_NAIVE_H_
+#define __IMPL_NAIVE_H_
+
+/* Function declaration */
+void* impl_scalar_naive(void* args);
+
+#endif //__IMPL_NAIVE_H_
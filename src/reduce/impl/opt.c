@@ -0,0 +1,47 @@
+/* opt.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Four independent accumulators (or argmax lanes), so that the loop is not
+ * one dependency chain; also the fallback of impl/vec.c.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/mapreduce.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/repro.h"
+
+/* Alternative Implementation */
+MR_REDUCE_OPT (sum_i32_opt, i32, REDUCE_ID     , REDUCE_ADD_i32, 0   )
+MR_REDUCE_OPT (sum_f32_opt, f32, REDUCE_ID     , REDUCE_ADD_f32, 0.0f)
+MR_REDUCE2_OPT(dot_i32_opt, i32, REDUCE_MUL_i32, REDUCE_ADD_i32, 0   )
+MR_REDUCE2_OPT(dot_f32_opt, f32, REDUCE_MUL_f32, REDUCE_ADD_f32, 0.0f)
+ARGMAX_OPT    (argmax_i32_opt, i32)
+ARGMAX_OPT    (argmax_f32_opt, f32)
+
+static void* (*const kernels[OP_NUM][ELEM_NUM])(void* args) = {
+  [OP_SUM   ] = { sum_i32_opt   , sum_f32_opt    },
+  [OP_DOT   ] = { dot_i32_opt   , dot_f32_opt    },
+  [OP_ARGMAX] = { argmax_i32_opt, argmax_f32_opt },
+};
+
+void* impl_scalar_opt(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  if (repro_applies(parsed_args)) {
+    return repro_run(args, (parsed_args->op == OP_SUM) ? repro_sum_block_scalar
+                                                       : repro_dot_block_scalar);
+  }
+
+  return kernels[parsed_args->op][parsed_args->elem](args);
+}
@@ -0,0 +1,23 @@
+/* opt.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 13 Nov. 2023
+ *
+ * Header for scalar optimized function.
+ */
+
+#ifndef __IMPL_OPT_H_
+#define __IMPL_OPT_H_
+
+/* Function declaration */
+void* impl_scalar_opt(void* args);
+
+/* Per reduction and element type; the scalar fallbacks of impl/vec.c */
+void* sum_i32_opt   (void* args);
+void* sum_f32_opt   (void* args);
+void* dot_i32_opt   (void* args);
+void* dot_f32_opt   (void* args);
+void* argmax_i32_opt(void* args);
+void* argmax_f32_opt(void* args);
+
+#endif //__IMPL_OPT_H_
@@ -0,0 +1,151 @@
+/* para.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Every thread reduces its chunk with the dispatched vector kernel into
+ * its own cache-line-padded partial, and the caller combines the partials
+ * in a pairwise tree after the join (MR_REDUCE_PARA). Reproducible float
+ * reductions hand whole impl/repro.h blocks to the threads instead.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/pool.h"
+#include "common/mapreduce.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
+#include "impl/repro.h"
+
+MR_REDUCE_PARA(sum_i32_para, i32, sum_i32_vec, REDUCE_ADD_i32, 0   )
+MR_REDUCE_PARA(sum_f32_para, f32, sum_f32_vec, REDUCE_ADD_f32, 0.0f)
+MR_REDUCE_PARA(dot_i32_para, i32, dot_i32_vec, REDUCE_ADD_i32, 0   )
+MR_REDUCE_PARA(dot_f32_para, f32, dot_f32_vec, REDUCE_ADD_f32, 0.0f)
+
+/* Argmax partials are indices (SIZE_MAX for an empty chunk); the tree
+ * keeps the left one on ties, which is the lower index */
+#define ARGMAX_NONE SIZE_MAX
+
+#define ARGMAX_PICK(ia, ib)                                 \
+  (((ib) != ARGMAX_NONE &&                                  \
+    ((ia) == ARGMAX_NONE || in[ib] > in[ia])) ? (ib) : (ia))
+
+#define ARGMAX_PARTIAL(t) partials[t].index
+
+#define ARGMAX_PARA(fn, E, vec_fn)                          \
+  typedef struct {                                          \
+    _Alignas(64) size_t index;                              \
+  } fn##_partial_t;                                         \
+                                                            \
+  typedef struct {                                          \
+    mr_args_t*      args;                                   \
+    fn##_partial_t* partials;                               \
+  } fn##_task_t;                                            \
+                                                            \
+  static void fn##_worker(int tid, int nthreads, void* args)\
+  {                                                         \
+    fn##_task_t* t = (fn##_task_t*)args;                    \
+    mr_args_t*   a = t->args;                               \
+                                                            \
+    size_t begin, end;                                      \
+    pool_partition(a->size, MR_CHUNK_ALIGN(E), tid,         \
+                   nthreads, &begin, &end);                 \
+                                                            \
+    t->partials[tid].index = ARGMAX_NONE;                   \
+    if (begin == end) return;                               \
+                                                            \
+    size_t    index;                                        \
+    mr_args_t chunk = *a;                                   \
+                                                            \
+    chunk.size   = end - begin;                             \
+    chunk.input  = (const MR_CTYPE(E)*)a->input + begin;    \
+    chunk.output = &index;                                  \
+                                                            \
+    vec_fn(&chunk);                                         \
+                                                            \
+    t->partials[tid].index = begin + index;                 \
+  }                                                         \
+                                                            \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in = (const MR_CTYPE(E)*)a->input;   \
+    int nthreads = mr_nthreads(a);                          \
+                                                            \
+    fn##_partial_t partials[nthreads];                      \
+    fn##_task_t    task = { a, partials };                  \
+                                                            \
+    pool_run(a->pool, nthreads, fn##_worker, &task);        \
+                                                            \
+    MR_TREE(ARGMAX_PARTIAL, nthreads, ARGMAX_PICK)          \
+    *(size_t*)a->output = partials[0].index;                \
+                                                            \
+    return NULL;                                            \
+  }
+
+ARGMAX_PARA(argmax_i32_para, i32, argmax_i32_vec)
+ARGMAX_PARA(argmax_f32_para, f32, argmax_f32_vec)
+
+static void* (*const kernels[OP_NUM][ELEM_NUM])(void* args) = {
+  [OP_SUM   ] = { sum_i32_para   , sum_f32_para    },
+  [OP_DOT   ] = { dot_i32_para   , dot_f32_para    },
+  [OP_ARGMAX] = { argmax_i32_para, argmax_f32_para },
+};
+
+/* Reproducible reductions: contiguous runs of whole blocks per thread,
+ * each block summed into args->blocks, then repro_combine */
+typedef struct {
+  args_t*   args;
+  void*   (*block_fn)(void* args);
+} repro_task_t;
+
+static void repro_worker(int tid, int nthreads, void* args)
+{
+  repro_task_t* task = (repro_task_t*)args;
+  args_t*       a    = task->args;
+
+  size_t begin, end;
+  pool_partition(repro_nblocks(a->mr.size), 1, tid, nthreads, &begin, &end);
+
+  for (size_t k = begin; k < end; k++) {
+    mr_args_t block = repro_block_args(&a->mr, a->blocks, k);
+    task->block_fn(&block);
+  }
+}
+
+static void* repro_parallel(args_t* args, void* (*block_fn)(void* args))
+{
+  repro_task_t task = { args, block_fn };
+
+  pool_run(args->mr.pool, args->mr.nthreads, repro_worker, &task);
+
+  *(float*)args->mr.output = repro_combine(args->blocks,
+                                           repro_nblocks(args->mr.size));
+
+  return NULL;
+}
+
+/* Alternative Implementation */
+void* impl_parallel(void* args)
+{
+  /* Get the argument struct */
+  args_t* p_args = (args_t*)args;
+
+  if (repro_applies(p_args)) {
+    return repro_parallel(p_args, (p_args->op == OP_SUM) ? repro_sum_block
+                                                         : repro_dot_block);
+  }
+
+  return kernels[p_args->op][p_args->elem](args);
+}
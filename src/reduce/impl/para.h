@@ -0,0 +1,15 @@
+/* para.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 13 Nov. 2023
+ *
+ * Header for parallelized implementation.
+ */
+
+#ifndef __IMPL_PARA_H_
+#define __IMPL_PARA_H_
+
+/* Function declaration */
+void* impl_parallel(void* args);
+
+#endif //__IMPL_PARA_H_
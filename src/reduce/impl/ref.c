@@ -0,0 +1,82 @@
+/* ref.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Reference reductions: plain loops, with float sums accumulated in
+ * double. With --reproducible, float sums and dot products are the
+ * scalar form of impl/repro.h instead, which every implementation must
+ * then match bit for bit.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Standard C types */
+#include <inttypes.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/repro.h"
+
+/* Reference Implementation */
+void* impl_ref(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*) args;
+
+  if (repro_applies(parsed_args)) {
+    return repro_run(args, (parsed_args->op == OP_SUM) ? repro_sum_block_scalar
+                                                       : repro_dot_block_scalar);
+  }
+
+  /* Get all the arguments */
+  register const void*  src0 = parsed_args->mr.input;
+  register const void*  src1 = parsed_args->mr.input1;
+  register       void*  dest = parsed_args->mr.output;
+  register       size_t size = parsed_args->mr.size;
+
+  const int32_t* i0 = (const int32_t*)src0;
+  const int32_t* i1 = (const int32_t*)src1;
+  const float*   f0 = (const float*  )src0;
+  const float*   f1 = (const float*  )src1;
+
+  uint32_t isum = 0;
+  double   fsum = 0.0;
+  size_t   best = 0;
+
+  switch (parsed_args->op) {
+  case OP_SUM:
+    for (size_t i = 0; i < size; i++) {
+      if (parsed_args->elem == ELEM_I32) isum += (uint32_t)i0[i];
+      else                               fsum += (double)f0[i];
+    }
+    break;
+
+  case OP_DOT:
+    for (size_t i = 0; i < size; i++) {
+      if (parsed_args->elem == ELEM_I32) isum += (uint32_t)i0[i] * (uint32_t)i1[i];
+      else                               fsum += (double)f0[i] * (double)f1[i];
+    }
+    break;
+
+  default:
+    for (size_t i = 1; i < size; i++) {
+      if (parsed_args->elem == ELEM_I32) best = (i0[i] > i0[best]) ? i : best;
+      else                               best = (f0[i] > f0[best]) ? i : best;
+    }
+    *(size_t*)dest = best;
+    return NULL;
+  }
+
+  if (parsed_args->elem == ELEM_I32) *(int32_t*)dest = (int32_t)isum;
+  else                               *(float*  )dest = (float  )fsum;
+
+  /* Done */
+  return NULL;
+}
@@ -0,0 +1,15 @@
+/* ref.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 13 Nov. 2023
+ *
+ * Header for ref function.
+ */
+
+#ifndef __IMPL_REF_H_
+#define __IMPL_REF_H_
+
+/* Function declaration */
+void* impl_ref(void* args);
+
+#endif //__IMPL_REF_H_
@@ -0,0 +1,75 @@
+/* repro.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Scalar side of impl/repro.h.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <math.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/mapreduce.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/repro.h"
+
+void* repro_sum_block_scalar(void* args)
+{
+  mr_args_t* a = (mr_args_t*)args;
+
+  const float* in = (const float*)a->input;
+  const size_t n  = a->size;
+
+  float lanes[REPRO_LANES] = { 0.0f };
+
+  for (size_t i = 0; i < n; i++) {
+    lanes[i % REPRO_LANES] += in[i];
+  }
+
+  *(float*)a->output = repro_fold(lanes);
+
+  return NULL;
+}
+
+void* repro_dot_block_scalar(void* args)
+{
+  mr_args_t* a = (mr_args_t*)args;
+
+  const float* in0 = (const float*)a->input;
+  const float* in1 = (const float*)a->input1;
+  const size_t n   = a->size;
+
+  float lanes[REPRO_LANES] = { 0.0f };
+
+  /* fmaf, so that the rounding matches the vector FMAs whether or not
+   * the compiler would have contracted a multiply and an add */
+  for (size_t i = 0; i < n; i++) {
+    lanes[i % REPRO_LANES] = fmaf(in0[i], in1[i], lanes[i % REPRO_LANES]);
+  }
+
+  *(float*)a->output = repro_fold(lanes);
+
+  return NULL;
+}
+
+void* repro_run(void* args, void* (*block_fn)(void* args))
+{
+  args_t* parsed_args = (args_t*)args;
+  size_t  nblocks     = repro_nblocks(parsed_args->mr.size);
+
+  for (size_t k = 0; k < nblocks; k++) {
+    mr_args_t block = repro_block_args(&parsed_args->mr, parsed_args->blocks, k);
+    block_fn(&block);
+  }
+
+  *(float*)parsed_args->mr.output = repro_combine(parsed_args->blocks, nblocks);
+
+  return NULL;
+}
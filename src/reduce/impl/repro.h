@@ -0,0 +1,102 @@
+/* repro.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Bitwise-reproducible float sums and dot products. The order of every
+ * addition is fixed by the input size alone:
+ *
+ *   1. the input is cut into blocks of REPRO_BLOCK elements;
+ *   2. within a block, element i goes to lane i % REPRO_LANES, each lane
+ *      accumulating in index order (dot products with one fused
+ *      multiply-add per element), and the lanes are folded in halves,
+ *      lane l taking lane l + w for w = REPRO_LANES / 2, ..., 1;
+ *   3. the block sums are combined with MR_TREE.
+ *
+ * A scalar loop, four AVX-512 or eight AVX2 registers all compute the
+ * same lanes, and threads only decide who
+ * computes which block, so the result is the same bits for every
+ * implementation, ISA and thread count. Lanes start at +0, so the zeros
+ * a masked vector tail adds leave them unchanged.
+*/
+
+#ifndef __IMPL_REPRO_H_
+#define __IMPL_REPRO_H_
+
+#include <stddef.h>
+
+#include "common/mapreduce.h"
+
+#include "include/types.h"
+#include "include/kernel.h"
+
+#define REPRO_BLOCK 4096
+#define REPRO_LANES 64
+
+static inline size_t repro_nblocks(size_t n)
+{
+  return (n + REPRO_BLOCK - 1) / REPRO_BLOCK;
+}
+
+/* Arguments of block k: its input(s), and its sum into blocks[k] */
+static inline mr_args_t repro_block_args(const mr_args_t* a, float* blocks,
+                                         size_t k)
+{
+  size_t begin = k * REPRO_BLOCK;
+  size_t end   = (begin + REPRO_BLOCK < a->size) ? begin + REPRO_BLOCK : a->size;
+
+  mr_args_t b = *a;
+
+  b.size   = end - begin;
+  b.input  = (const float*)a->input + begin;
+  b.output = &blocks[k];
+  if (a->input1 != NULL) {
+    b.input1 = (const float*)a->input1 + begin;
+  }
+
+  return b;
+}
+
+/* Step 2's fold of the lanes */
+static inline float repro_fold(float* lanes)
+{
+  for (size_t w = REPRO_LANES / 2; w > 0; w /= 2) {
+    for (size_t l = 0; l < w; l++) {
+      lanes[l] += lanes[l + w];
+    }
+  }
+
+  return lanes[0];
+}
+
+/* Step 3 */
+#define REPRO_BLOCK_AT(k) blocks[k]
+
+static inline float repro_combine(float* blocks, size_t nblocks)
+{
+  if (nblocks == 0) return 0.0f;
+
+  MR_TREE(REPRO_BLOCK_AT, nblocks, REDUCE_ADD_f32)
+
+  return blocks[0];
+}
+
+/* Does args go through repro_run? */
+static inline bool repro_applies(const args_t* args)
+{
+  return args->reproducible && args->elem == ELEM_F32 && args->op != OP_ARGMAX;
+}
+
+/* One block (an mr_args_t of at most REPRO_BLOCK elements, output one
+ * float); the dispatched versions live in vec.<isa>.c */
+void* repro_sum_block_scalar(void* args);
+void* repro_dot_block_scalar(void* args);
+
+MR_DECLARE_VEC(repro_sum_block);
+MR_DECLARE_VEC(repro_dot_block);
+
+/* The whole of args (an args_t) on the calling thread, one block_fn per
+ * block into args->blocks */
+void* repro_run(void* args, void* (*block_fn)(void* args));
+
+#endif //__IMPL_REPRO_H_
@@ -0,0 +1,142 @@
+/* vec.avx2.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX2 variants of the reductions.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/mapreduce.avx2.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
+#include "impl/repro.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+MR_REDUCE_AVX2 (sum_i32_vec_avx2, i32, REDUCE_ID         , _mm256_add_epi32, REDUCE_ADD_i32, 0   )
+MR_REDUCE_AVX2 (sum_f32_vec_avx2, f32, REDUCE_ID         , _mm256_add_ps   , REDUCE_ADD_f32, 0.0f)
+MR_REDUCE2_AVX2(dot_i32_vec_avx2, i32, _mm256_mullo_epi32, _mm256_add_epi32, REDUCE_ADD_i32, 0   )
+MR_REDUCE2_AVX2(dot_f32_vec_avx2, f32, _mm256_mul_ps     , _mm256_add_ps   , REDUCE_ADD_f32, 0.0f)
+
+/* All-ones lanes where a > b */
+#define ARGMAX_GT256_i32(a, b) _mm256_cmpgt_epi32(a, b)
+#define ARGMAX_GT256_f32(a, b) _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ))
+#define ARGMAX_GT256(E, a, b)  MR_CAT(ARGMAX_GT256_, E)(a, b)
+
+/* Two sets of eight (value, index) lanes, seeded with element 0; tail
+ * lanes are filled with element 0 too, so they never win */
+#define ARGMAX_AVX2(fn, E)                                  \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in = (const MR_CTYPE(E)*)a->input;   \
+    const size_t       n  = a->size;                        \
+                                                            \
+    const MR_V256(E) seed = MR_SET1256(E, in[0]);           \
+    MR_V256(E) v0 = seed, v1 = seed;                        \
+    __m256i    x0 = _mm256_setzero_si256(), x1 = x0;        \
+    __m256i    i0 = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);\
+    __m256i    i1 = _mm256_add_epi32(i0, _mm256_set1_epi32(8));\
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 16 <= n; i += 16) {                          \
+      MR_V256(E) e0 = MR_LOADU256(E, &in[i + 0]);           \
+      MR_V256(E) e1 = MR_LOADU256(E, &in[i + 8]);           \
+      __m256i    m0 = ARGMAX_GT256(E, e0, v0);              \
+      __m256i    m1 = ARGMAX_GT256(E, e1, v1);              \
+                                                            \
+      v0 = MR_BLEND256(E, v0, e0, m0);                      \
+      v1 = MR_BLEND256(E, v1, e1, m1);                      \
+      x0 = _mm256_blendv_epi8(x0, i0, m0);                  \
+      x1 = _mm256_blendv_epi8(x1, i1, m1);                  \
+                                                            \
+      i0 = _mm256_add_epi32(i0, _mm256_set1_epi32(16));     \
+      i1 = _mm256_add_epi32(i1, _mm256_set1_epi32(16));     \
+    }                                                       \
+    for (; i < n; i += 8) {                                 \
+      __m256i    t = mr_tail_mask256(n - i);                \
+      MR_V256(E) e = MR_BLEND256(E, seed,                   \
+                                 MR_MASKLOAD256(E, &in[i], t), t);\
+      __m256i    m = ARGMAX_GT256(E, e, v0);                \
+                                                            \
+      v0 = MR_BLEND256(E, v0, e, m);                        \
+      x0 = _mm256_blendv_epi8(x0, i0, m);                   \
+      i0 = _mm256_add_epi32(i0, _mm256_set1_epi32(8));      \
+    }                                                       \
+                                                            \
+    MR_CTYPE(E) v[16];                                      \
+    uint32_t    x[16];                                      \
+    MR_STOREU256(E, &v[0], v0);                             \
+    MR_STOREU256(E, &v[8], v1);                             \
+    _mm256_storeu_si256((__m256i*)&x[0], x0);               \
+    _mm256_storeu_si256((__m256i*)&x[8], x1);               \
+                                                            \
+    int b = 0;                                              \
+    for (int l = 1; l < 16; l++) {                          \
+      if (ARGMAX_BETTER(v[l], x[l], v[b], x[b])) b = l;     \
+    }                                                       \
+                                                            \
+    *(size_t*)a->output = x[b];                             \
+                                                            \
+    return NULL;                                            \
+  }
+
+ARGMAX_AVX2(argmax_i32_vec_avx2, i32)
+ARGMAX_AVX2(argmax_f32_vec_avx2, f32)
+
+/* impl/repro.h: lane 8j + k of a 64-element row is lane k of acc[j] */
+#define REPRO_AVX2(fn, LOAD_ACC)                            \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const float* in0 = (const float*)a->input;              \
+    const float* in1 = (const float*)a->input1;             \
+    const size_t n   = a->size;                             \
+                                                            \
+    __m256 acc[8];                                          \
+    for (int j = 0; j < 8; j++) acc[j] = _mm256_setzero_ps();\
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + REPRO_LANES <= n; i += REPRO_LANES) {        \
+      for (int j = 0; j < 8; j++) {                         \
+        LOAD_ACC(acc[j], i + 8 * j, REPRO_LOADU256);        \
+      }                                                     \
+    }                                                       \
+    for (int j = 0; i + 8 * j < n; j++) {                   \
+      __m256i m = mr_tail_mask256(n - i - 8 * j);           \
+      LOAD_ACC(acc[j], i + 8 * j, REPRO_MASKLOAD256);       \
+    }                                                       \
+                                                            \
+    float lanes[REPRO_LANES];                               \
+    for (int j = 0; j < 8; j++) {                           \
+      _mm256_storeu_ps(&lanes[8 * j], acc[j]);              \
+    }                                                       \
+                                                            \
+    *(float*)a->output = repro_fold(lanes);                 \
+                                                            \
+    (void)in1;                                              \
+    return NULL;                                            \
+  }
+
+/* Loads of a full row, and of the tail under the lane mask m */
+#define REPRO_LOADU256(p)    _mm256_loadu_ps(p)
+#define REPRO_MASKLOAD256(p) _mm256_maskload_ps(p, m)
+
+#define REPRO_SUM_AVX2(acc, p, LD) \
+  acc = _mm256_add_ps(acc, LD(&in0[p]))
+#define REPRO_DOT_AVX2(acc, p, LD) \
+  acc = _mm256_fmadd_ps(LD(&in0[p]), LD(&in1[p]), acc)
+
+REPRO_AVX2(repro_sum_block_avx2, REPRO_SUM_AVX2)
+REPRO_AVX2(repro_dot_block_avx2, REPRO_DOT_AVX2)
+#endif
@@ -0,0 +1,145 @@
+/* vec.avx512.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX-512 variants of the reductions.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/mapreduce.avx512.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
+#include "impl/repro.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+MR_REDUCE_AVX512 (sum_i32_vec_avx512, i32, REDUCE_ID         , _mm512_add_epi32, REDUCE_ADD_i32, 0   )
+MR_REDUCE_AVX512 (sum_f32_vec_avx512, f32, REDUCE_ID         , _mm512_add_ps   , REDUCE_ADD_f32, 0.0f)
+MR_REDUCE2_AVX512(dot_i32_vec_avx512, i32, _mm512_mullo_epi32, _mm512_add_epi32, REDUCE_ADD_i32, 0   )
+MR_REDUCE2_AVX512(dot_f32_vec_avx512, f32, _mm512_mul_ps     , _mm512_add_ps   , REDUCE_ADD_f32, 0.0f)
+
+/* Lanes where a > b */
+#define ARGMAX_GT512_i32(a, b) _mm512_cmpgt_epi32_mask(a, b)
+#define ARGMAX_GT512_f32(a, b) _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ)
+#define ARGMAX_GT512(E, a, b)  MR_CAT(ARGMAX_GT512_, E)(a, b)
+
+/* Two sets of sixteen (value, index) lanes, seeded with element 0; tail
+ * lanes are filled with element 0 too, so they never win */
+#define ARGMAX_AVX512(fn, E)                                \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in = (const MR_CTYPE(E)*)a->input;   \
+    const size_t       n  = a->size;                        \
+                                                            \
+    const MR_V512(E) seed = MR_SET1512(E, in[0]);           \
+    MR_V512(E) v0 = seed, v1 = seed;                        \
+    __m512i    x0 = _mm512_setzero_si512(), x1 = x0;        \
+    __m512i    i0 = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7,\
+                                      8, 9, 10, 11, 12, 13, 14, 15);\
+    __m512i    i1 = _mm512_add_epi32(i0, _mm512_set1_epi32(16));\
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 32 <= n; i += 32) {                          \
+      MR_V512(E) e0 = MR_LOADU512(E, &in[i +  0]);          \
+      MR_V512(E) e1 = MR_LOADU512(E, &in[i + 16]);          \
+      __mmask16  m0 = ARGMAX_GT512(E, e0, v0);              \
+      __mmask16  m1 = ARGMAX_GT512(E, e1, v1);              \
+                                                            \
+      v0 = MR_MASKMOV512(E, v0, m0, e0);                    \
+      v1 = MR_MASKMOV512(E, v1, m1, e1);                    \
+      x0 = _mm512_mask_mov_epi32(x0, m0, i0);               \
+      x1 = _mm512_mask_mov_epi32(x1, m1, i1);               \
+                                                            \
+      i0 = _mm512_add_epi32(i0, _mm512_set1_epi32(32));     \
+      i1 = _mm512_add_epi32(i1, _mm512_set1_epi32(32));     \
+    }                                                       \
+    for (; i < n; i += 16) {                                \
+      __mmask16  t = (n - i >= 16) ? (__mmask16)0xffff      \
+                                   : MR_TAIL_MASK512(n - i);\
+      MR_V512(E) e = MR_MASKLOAD512(E, seed, t, &in[i]);    \
+      __mmask16  m = ARGMAX_GT512(E, e, v0);                \
+                                                            \
+      v0 = MR_MASKMOV512(E, v0, m, e);                      \
+      x0 = _mm512_mask_mov_epi32(x0, m, i0);                \
+      i0 = _mm512_add_epi32(i0, _mm512_set1_epi32(16));     \
+    }                                                       \
+                                                            \
+    MR_CTYPE(E) v[32];                                      \
+    uint32_t    x[32];                                      \
+    MR_STOREU512(E, &v[ 0], v0);                            \
+    MR_STOREU512(E, &v[16], v1);                            \
+    _mm512_storeu_si512(&x[ 0], x0);                        \
+    _mm512_storeu_si512(&x[16], x1);                        \
+                                                            \
+    int b = 0;                                              \
+    for (int l = 1; l < 32; l++) {                          \
+      if (ARGMAX_BETTER(v[l], x[l], v[b], x[b])) b = l;     \
+    }                                                       \
+                                                            \
+    *(size_t*)a->output = x[b];                             \
+                                                            \
+    return NULL;                                            \
+  }
+
+ARGMAX_AVX512(argmax_i32_vec_avx512, i32)
+ARGMAX_AVX512(argmax_f32_vec_avx512, f32)
+
+/* impl/repro.h: lane 16j + k of a 64-element row is lane k of acc[j] */
+#define REPRO_AVX512(fn, LOAD_ACC)                          \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const float* in0 = (const float*)a->input;              \
+    const float* in1 = (const float*)a->input1;             \
+    const size_t n   = a->size;                             \
+                                                            \
+    __m512 acc[4];                                          \
+    for (int j = 0; j < 4; j++) acc[j] = _mm512_setzero_ps();\
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + REPRO_LANES <= n; i += REPRO_LANES) {        \
+      for (int j = 0; j < 4; j++) {                         \
+        LOAD_ACC(acc[j], i + 16 * j, REPRO_LOADU512);       \
+      }                                                     \
+    }                                                       \
+    for (int j = 0; i + 16 * j < n; j++) {                  \
+      size_t    r = n - i - 16 * j;                         \
+      __mmask16 m = (r >= 16) ? (__mmask16)0xffff           \
+                              : MR_TAIL_MASK512(r);         \
+      LOAD_ACC(acc[j], i + 16 * j, REPRO_MASKLOAD512);      \
+    }                                                       \
+                                                            \
+    float lanes[REPRO_LANES];                               \
+    for (int j = 0; j < 4; j++) {                           \
+      _mm512_storeu_ps(&lanes[16 * j], acc[j]);             \
+    }                                                       \
+                                                            \
+    *(float*)a->output = repro_fold(lanes);                 \
+                                                            \
+    (void)in1;                                              \
+    return NULL;                                            \
+  }
+
+/* Loads of a full row, and of the tail under the lane mask m */
+#define REPRO_LOADU512(p)    _mm512_loadu_ps(p)
+#define REPRO_MASKLOAD512(p) _mm512_maskz_loadu_ps(m, p)
+
+#define REPRO_SUM_AVX512(acc, p, LD) \
+  acc = _mm512_add_ps(acc, LD(&in0[p]))
+#define REPRO_DOT_AVX512(acc, p, LD) \
+  acc = _mm512_fmadd_ps(LD(&in0[p]), LD(&in1[p]), acc)
+
+REPRO_AVX512(repro_sum_block_avx512, REPRO_SUM_AVX512)
+REPRO_AVX512(repro_dot_block_avx512, REPRO_DOT_AVX512)
+#endif
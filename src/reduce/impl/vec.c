@@ -0,0 +1,51 @@
+/* vec.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Runtime dispatch of the vector reductions.
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/cpu.h"
+#include "common/mapreduce.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/opt.h"
+#include "impl/vec.h"
+#include "impl/repro.h"
+
+/* The widest of vec.<isa>.c, falling back to the unrolled scalar loops */
+MR_DISPATCH(sum_i32_vec    , sum_i32_opt           )
+MR_DISPATCH(sum_f32_vec    , sum_f32_opt           )
+MR_DISPATCH(dot_i32_vec    , dot_i32_opt           )
+MR_DISPATCH(dot_f32_vec    , dot_f32_opt           )
+MR_DISPATCH(argmax_i32_vec , argmax_i32_opt        )
+MR_DISPATCH(argmax_f32_vec , argmax_f32_opt        )
+MR_DISPATCH(repro_sum_block, repro_sum_block_scalar)
+MR_DISPATCH(repro_dot_block, repro_dot_block_scalar)
+
+static void* (*const kernels[OP_NUM][ELEM_NUM])(void* args) = {
+  [OP_SUM   ] = { sum_i32_vec   , sum_f32_vec    },
+  [OP_DOT   ] = { dot_i32_vec   , dot_f32_vec    },
+  [OP_ARGMAX] = { argmax_i32_vec, argmax_f32_vec },
+};
+
+/* Alternative Implementation */
+void* impl_vector(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  if (repro_applies(parsed_args)) {
+    return repro_run(args, (parsed_args->op == OP_SUM) ? repro_sum_block
+                                                       : repro_dot_block);
+  }
+
+  return kernels[parsed_args->op][parsed_args->elem](args);
+}
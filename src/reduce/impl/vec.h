@@ -0,0 +1,27 @@
+/* vec.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 13 Nov. 2023
+ *
+ * Header for vectorized function. Every reduction dispatches at runtime
+ * to the widest variant the host supports (see common/cpu.h); the
+ * variants live in vec.<isa>.c.
+ */
+
+#ifndef __IMPL_VEC_H_
+#define __IMPL_VEC_H_
+
+#include "common/mapreduce.h"
+
+/* Function declaration */
+void* impl_vector(void* args);
+
+/* Per reduction and element type, on an mr_args_t */
+MR_DECLARE_VEC(sum_i32_vec);
+MR_DECLARE_VEC(sum_f32_vec);
+MR_DECLARE_VEC(dot_i32_vec);
+MR_DECLARE_VEC(dot_f32_vec);
+MR_DECLARE_VEC(argmax_i32_vec);
+MR_DECLARE_VEC(argmax_f32_vec);
+
+#endif //__IMPL_VEC_H_
@@ -0,0 +1,86 @@
+/* kernel.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Scalar functors of the reductions (see common/mapreduce.h) and the
+ * argmax generators, which carry an index next to the value and so do not
+ * fit MR_REDUCE_*. Every argmax keeps the first index of the maximum: a
+ * lane only moves on a strictly greater value, and lanes, partials and
+ * chunks (all in index order) are merged preferring the lower index on
+ * ties. The inputs are never NaN.
+*/
+
+#ifndef __INCLUDE_KERNEL_H_
+#define __INCLUDE_KERNEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Integer arithmetic wraps, so every order gives the same bits */
+#define REDUCE_ID(x)         (x)
+#define REDUCE_ADD_i32(a, b) ((int32_t)((uint32_t)(a) + (uint32_t)(b)))
+#define REDUCE_MUL_i32(a, b) ((int32_t)((uint32_t)(a) * (uint32_t)(b)))
+#define REDUCE_ADD_f32(a, b) ((a) + (b))
+#define REDUCE_MUL_f32(a, b) ((a) * (b))
+
+/* Does (vb, ib) beat (va, ia)? */
+#define ARGMAX_BETTER(vb, ib, va, ia) \
+  ((vb) > (va) || ((vb) == (va) && (ib) < (ia)))
+
+#define ARGMAX_NAIVE(fn, E)                                 \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in = (const MR_CTYPE(E)*)a->input;   \
+                                                            \
+    size_t best = 0;                                        \
+    for (size_t i = 1; i < a->size; i++) {                  \
+      if (in[i] > in[best]) best = i;                       \
+    }                                                       \
+                                                            \
+    *(size_t*)a->output = best;                             \
+                                                            \
+    return NULL;                                            \
+  }
+
+/* Four independent (value, index) lanes, seeded with element 0 */
+#define ARGMAX_OPT(fn, E)                                   \
+  void* fn(void* args)                                      \
+  {                                                         \
+    mr_args_t* a = (mr_args_t*)args;                        \
+                                                            \
+    const MR_CTYPE(E)* in = (const MR_CTYPE(E)*)a->input;   \
+    const size_t       n  = a->size;                        \
+                                                            \
+    MR_CTYPE(E) v[4] = { in[0], in[0], in[0], in[0] };      \
+    size_t      x[4] = { 0, 0, 0, 0 };                      \
+                                                            \
+    size_t i = 0;                                           \
+    for (; i + 4 <= n; i += 4) {                            \
+      for (int l = 0; l < 4; l++) {                         \
+        if (in[i + l] > v[l]) {                             \
+          v[l] = in[i + l];                                 \
+          x[l] = i + l;                                     \
+        }                                                   \
+      }                                                     \
+    }                                                       \
+    for (; i < n; i++) {                                    \
+      if (in[i] > v[0]) {                                   \
+        v[0] = in[i];                                       \
+        x[0] = i;                                           \
+      }                                                     \
+    }                                                       \
+                                                            \
+    int b = 0;                                              \
+    for (int l = 1; l < 4; l++) {                           \
+      if (ARGMAX_BETTER(v[l], x[l], v[b], x[b])) b = l;     \
+    }                                                       \
+                                                            \
+    *(size_t*)a->output = x[b];                             \
+                                                            \
+    return NULL;                                            \
+  }
+
+#endif //__INCLUDE_KERNEL_H_
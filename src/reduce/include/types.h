@@ -0,0 +1,46 @@
+/* types.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains all required types decalartions.
+*/
+
+#ifndef __INCLUDE_TYPES_H_
+#define __INCLUDE_TYPES_H_
+
+#include <stdbool.h>
+
+#include "common/mapreduce.h"
+
+/* Reductions */
+typedef enum {
+  OP_SUM    = 0,    /* output = sum(input)                          */
+  OP_DOT       ,    /* output = sum(input * input1)                 */
+  OP_ARGMAX    ,    /* output = first index of max(input), a size_t */
+  OP_NUM       ,
+} op_t;
+
+/* Element types; integer sums and products wrap modulo 2^32 */
+typedef enum {
+  ELEM_I32  = 0,
+  ELEM_F32     ,
+  ELEM_NUM     ,
+} elem_t;
+
+typedef struct {
+  /* Input(s), output, size (in elements), cpu, nthreads and pool; first,
+   * so the common/mapreduce.h kernels take an args_t as is */
+  mr_args_t mr;
+
+  op_t      op;
+  elem_t    elem;
+
+  /* Float sums and dot products in the fixed order of impl/repro.h, the
+   * same for every implementation, ISA and thread count; blocks holds
+   * repro_nblocks(size) block sums */
+  bool      reproducible;
+  float*    blocks;
+} args_t;
+
+#endif //__INCLUDE_TYPES_H_
@@ -0,0 +1,376 @@
+/* main.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Microbenchmark for cross-thread reductions: sum, dot product and argmax
+ * over int32 and float, one case per reduction and element type. Integer
+ * sums and products wrap, so every implementation must match the 'ref'
+ * output exactly, as must every argmax (the first index of the maximum).
+ * Float results are checked against a double-precision reference, within
+ * a bound relative to the sum of magnitudes; with --reproducible, float
+ * sums and dot products follow the fixed order of impl/repro.h and must
+ * match the reference bit for bit, for any thread count (--scale). The
+ * file also adds a guard word after the output to check for buffer
+ * overruns.
+ *
+ * Option parsing, scheduling, timing, statistics and the CSV dump are
+ * handled by the shared driver (common/driver.h); this file only owns
+ * the data.
+ */
+
+/* Standard C includes  */
+/*  -> Standard Library */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+/*  -> Types            */
+#include <stdbool.h>
+#include <inttypes.h>
+
+/* Include all implementations declarations */
+#include "impl/ref.h"
+#include "impl/naive.h"
+#include "impl/opt.h"
+#include "impl/vec.h"
+#include "impl/para.h"
+#include "impl/repro.h"
+
+/* Include common headers */
+#include "common/types.h"
+#include "common/macros.h"
+#include "common/driver.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Elements */
+const int SIZE_DATA = 4 * 1024 * 1024;
+
+/* Largest float error, relative to the sum of magnitudes of the terms */
+#define REDUCE_FLOAT_RTOL 1e-5
+
+/* Bytes of the output slot (a size_t for argmax); the guard follows */
+#define REDUCE_OUT_BYTES 8
+
+static const char* op_names  [OP_NUM  ] = { "sum", "dot", "argmax" };
+static const char* elem_names[ELEM_NUM] = { "i32", "f32" };
+
+/* Benchmark state */
+typedef struct {
+  int    data_size;
+  int    op;              /* Only this reduction, or -1 for all   */
+  int    elem;            /* Only this element type, or -1 for all */
+  bool   reproducible;
+
+  /* Current case */
+  char   label[32];
+  double abs_sum;         /* Sum of magnitudes of the float terms */
+  double err;             /* Relative error of the last verify    */
+
+  byte*  src0;
+  byte*  src1;
+  byte*  ref;
+  byte*  dest;
+  float* blocks;
+
+  args_t args;
+} reduce_t;
+
+static int reduce_nops  (const reduce_t* b) { return (b->op   >= 0) ? 1 : OP_NUM;   }
+static int reduce_nelems(const reduce_t* b) { return (b->elem >= 0) ? 1 : ELEM_NUM; }
+
+/* Cases are reductions x element types, types innermost */
+static op_t reduce_op(const reduce_t* b, int idx)
+{
+  return (op_t)((b->op >= 0) ? b->op : idx / reduce_nelems(b));
+}
+
+static elem_t reduce_elem(const reduce_t* b, int idx)
+{
+  return (elem_t)((b->elem >= 0) ? b->elem : idx % ELEM_NUM);
+}
+
+static int reduce_parse_arg(void* ctx, int argc, char** argv, int i)
+{
+  reduce_t* b = (reduce_t*)ctx;
+
+  /* Input size */
+  if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--size") == 0) {
+    assert (++i < argc);
+    b->data_size = atoi(argv[i]);
+    if (b->data_size <= 0) {
+      printf("\n");
+      printf("ERROR: Invalid size \"%s\".\n", argv[i]);
+      return -1;
+    }
+
+    return 2;
+  }
+
+  if (strcmp(argv[i], "-k") == 0 || strcmp(argv[i], "--kernel") == 0) {
+    assert (++i < argc);
+    b->op = -1;
+    for (int k = 0; k < OP_NUM; k++) {
+      if (strcmp(argv[i], op_names[k]) == 0) b->op = k;
+    }
+    if (b->op < 0 && strcmp(argv[i], "all") != 0) {
+      printf("\n");
+      printf("ERROR: Unknown \"%s\" reduction.\n", argv[i]);
+      return -1;
+    }
+
+    return 2;
+  }
+
+  if (strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--type") == 0) {
+    assert (++i < argc);
+    if      (strcmp(argv[i], "int"  ) == 0) b->elem = ELEM_I32;
+    else if (strcmp(argv[i], "float") == 0) b->elem = ELEM_F32;
+    else if (strcmp(argv[i], "all"  ) == 0) b->elem = -1;
+    else {
+      printf("\n");
+      printf("ERROR: Unknown \"%s\" element type.\n", argv[i]);
+      return -1;
+    }
+
+    return 2;
+  }
+
+  if (strcmp(argv[i], "--reproducible") == 0) {
+    b->reproducible = true;
+
+    return 1;
+  }
+
+  return 0;
+}
+
+static void reduce_usage(void* ctx)
+{
+  reduce_t* b = (reduce_t*)ctx;
+
+  printf("    -s | --size      Elements of the input(s) (default = %d)\n", b->data_size);
+  printf("    -k | --kernel    Reduction = {sum, dot, argmax, all} (default = all)\n");
+  printf("    -t | --type      Elements = {int, float, all} (default = all)\n");
+  printf("         --reproducible\n");
+  printf("                     Float sums in a fixed order, the same bits for every\n");
+  printf("                     implementation and thread count\n");
+}
+
+static int reduce_ncases(void* ctx)
+{
+  reduce_t* b = (reduce_t*)ctx;
+
+  return reduce_nops(b) * reduce_nelems(b);
+}
+
+/* Random terms: small integers (so argmax sees many ties) or [-1, 1] */
+static byte* reduce_alloc_input(elem_t elem, size_t n)
+{
+  byte* data = __ALLOC_DATA(byte, n * sizeof(float));
+
+  for (size_t i = 0; i < n; i++) {
+    if (elem == ELEM_I32) ((int32_t*)data)[i] = rand() % 2001 - 1000;
+    else                  ((float*  )data)[i] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  return data;
+}
+
+static bool reduce_setup(void* ctx, int idx, const driver_env_t* env,
+                         driver_case_t* c)
+{
+  reduce_t* b    = (reduce_t*)ctx;
+  op_t      op   = reduce_op  (b, idx);
+  elem_t    elem = reduce_elem(b, idx);
+  size_t    n    = b->data_size;
+
+  snprintf(b->label, sizeof(b->label), "%s_%s", op_names[op], elem_names[elem]);
+
+  /* Datasets */
+  /* Allocation and initialization */
+  b->src0   = reduce_alloc_input(elem, n);
+  b->src1   = (op == OP_DOT) ? reduce_alloc_input(elem, n) : NULL;
+  b->ref    = __ALLOC_DATA(byte, REDUCE_OUT_BYTES + 4);
+  b->dest   = __ALLOC_DATA(byte, REDUCE_OUT_BYTES + 4);
+  b->blocks = __ALLOC_DATA(float, repro_nblocks(n));
+
+  memset(b->ref , 0, REDUCE_OUT_BYTES);
+  memset(b->dest, 0, REDUCE_OUT_BYTES);
+
+  /* Setting a guards, which is 0xdeadcafe.
+     The guard should not change or be touched. */
+  __SET_GUARD(b->ref , REDUCE_OUT_BYTES);
+  __SET_GUARD(b->dest, REDUCE_OUT_BYTES);
+
+  /* Scale of the float error bound */
+  b->abs_sum = 0.0;
+  if (elem == ELEM_F32) {
+    const float* x = (const float*)b->src0;
+    const float* y = (const float*)b->src1;
+    for (size_t i = 0; i < n; i++) {
+      b->abs_sum += fabs((op == OP_DOT) ? (double)x[i] * y[i] : (double)x[i]);
+    }
+  }
+
+  /* Generate ref data */
+  /* Arguments for the functions */
+  args_t args_ref;
+
+  memset(&args_ref, 0, sizeof(args_ref));
+
+  args_ref.mr.input     = b->src0;
+  args_ref.mr.input1    = b->src1;
+  args_ref.mr.output    = b->ref;
+  args_ref.mr.size      = n;
+
+  args_ref.op           = op;
+  args_ref.elem         = elem;
+  args_ref.reproducible = b->reproducible;
+  args_ref.blocks       = b->blocks;
+
+  args_ref.mr.cpu       = env->cpu;
+  args_ref.mr.nthreads  = env->nthreads;
+  args_ref.mr.pool      = env->pool;
+
+  /* Running the reference function */
+  impl_ref(&args_ref);
+
+  /* Arguments for the requested implementation */
+  b->args           = args_ref;
+  b->args.mr.output = b->dest;
+
+  c->args  = &b->args;
+  c->label = b->label;
+  c->flops = (op == OP_ARGMAX) ? 0.0 : ((op == OP_DOT) ? 2.0 : 1.0) * n;
+  c->bytes = ((op == OP_DOT) ? 2.0 : 1.0) * n * sizeof(float);
+  c->elems = (double)n;
+
+  return true;
+}
+
+static driver_check_t reduce_verify(void* ctx, int idx)
+{
+  reduce_t* b = (reduce_t*)ctx;
+  driver_check_t check = { 0 };
+
+  b->err = 0.0;
+
+  if (b->args.op == OP_ARGMAX) {
+    check.match = (*(size_t*)b->dest == *(size_t*)b->ref);
+  } else if (b->args.elem == ELEM_I32) {
+    check.match = (*(int32_t*)b->dest == *(int32_t*)b->ref);
+  } else {
+    double d = *(float*)b->dest;
+    double r = *(float*)b->ref;
+
+    b->err = (b->abs_sum > 0.0) ? fabs(d - r) / b->abs_sum : fabs(d - r);
+
+    /* Reproducible sums must be the very same bits */
+    check.match = repro_applies(&b->args)
+                ? (memcmp(b->dest, b->ref, sizeof(float)) == 0)
+                : (b->err <= REDUCE_FLOAT_RTOL);
+  }
+
+  check.guard = __CHECK_GUARD(b->dest, REDUCE_OUT_BYTES);
+
+  return check;
+}
+
+static void reduce_report(void* ctx, int idx)
+{
+  reduce_t* b = (reduce_t*)ctx;
+
+  if (b->args.op == OP_ARGMAX) {
+    printf("  * Result: index %zu (ref %zu)\n",
+           *(size_t*)b->dest, *(size_t*)b->ref);
+  } else if (b->args.elem == ELEM_I32) {
+    printf("  * Result: %" PRId32 " (ref %" PRId32 ")\n",
+           *(int32_t*)b->dest, *(int32_t*)b->ref);
+  } else {
+    printf("  * Result: %.9g (ref %.9g), error = %.3g of the sum of magnitudes%s\n",
+           *(float*)b->dest, *(float*)b->ref, b->err,
+           repro_applies(&b->args) ? " (reproducible)" : "");
+  }
+}
+
+static void reduce_dump(void* ctx, int idx, FILE* fp)
+{
+  reduce_t* b = (reduce_t*)ctx;
+
+  fprintf(fp, "\nop,%s\nelem,%s\nsize,%d\nreproducible,%d\nrel_err,%.6g",
+          op_names[b->args.op], elem_names[b->args.elem], b->data_size,
+          repro_applies(&b->args), b->err);
+}
+
+static void reduce_reset(void* ctx, int idx)
+{
+  reduce_t* b = (reduce_t*)ctx;
+
+  /* Clear the output, leaving the guard intact */
+  memset(b->dest, 0, REDUCE_OUT_BYTES);
+}
+
+static void reduce_set_nthreads(void* ctx, int idx, int nthreads)
+{
+  reduce_t* b = (reduce_t*)ctx;
+
+  b->args.mr.nthreads = nthreads;
+}
+
+static void reduce_teardown(void* ctx, int idx)
+{
+  reduce_t* b = (reduce_t*)ctx;
+
+  /* Manage memory */
+  __FREE_DATA(b->src0);
+  if (b->src1 != NULL) __FREE_DATA(b->src1);
+  __FREE_DATA(b->dest);
+  __FREE_DATA(b->ref);
+  __FREE_DATA(b->blocks);
+}
+
+static const driver_impl_t impls[] = {
+  { "naive", "scalar_naive", impl_scalar_naive },
+  { "opt"  , "scalar_opt"  , impl_scalar_opt   },
+  { "vec"  , "vectorized"  , impl_vector       },
+  { "para" , "parallelized", impl_parallel     },
+};
+
+int main(int argc, char** argv)
+{
+  reduce_t ctx;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.data_size = SIZE_DATA;
+  ctx.op        = -1;
+  ctx.elem      = -1;
+
+  driver_bench_t bench = {
+    .name         = "reduce",
+    .impls        = impls,
+    .nimpls       = sizeof(impls) / sizeof(impls[0]),
+
+    .nruns        = 1000,
+    .ninner       = 4,
+    .nwarmup      = 2,
+
+    .ctx          = &ctx,
+
+    .parse_arg    = reduce_parse_arg,
+    .usage        = reduce_usage,
+    .ncases       = reduce_ncases,
+    .setup        = reduce_setup,
+    .verify       = reduce_verify,
+    .report       = reduce_report,
+    .reset        = reduce_reset,
+    .dump         = reduce_dump,
+    .teardown     = reduce_teardown,
+    .set_nthreads = reduce_set_nthreads,
+  };
+
+  return driver_main(&bench, argc, argv);
+}
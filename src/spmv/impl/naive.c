@@ -0,0 +1,45 @@
+/* naive.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * CSR, one accumulator per row.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Naive Implementation */
+#pragma GCC push_options
+#pragma GCC optimize ("O1")
+void* impl_scalar_naive(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register const csr_t* A = parsed_args->csr;
+  register const float* x = parsed_args->x;
+  register       float* y = parsed_args->y;
+
+  for (uint32_t r = 0; r < A->nrows; r++) {
+    float sum = 0.0f;
+
+    for (uint32_t k = A->row_ptr[r]; k < A->row_ptr[r + 1]; k++) {
+      sum += A->val[k] * x[A->col_idx[k]];
+    }
+
+    y[r] = sum;
+  }
+
+  /* Done */
+  return NULL;
+}
+#pragma GCC pop_options
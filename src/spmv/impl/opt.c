@@ -0,0 +1,55 @@
+/* opt.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * CSR with four independent accumulators per row, so that a long row is
+ * not one dependency chain.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Alternative Implementation */
+void* impl_scalar_opt(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register const uint32_t* row_ptr = parsed_args->csr->row_ptr;
+  register const uint32_t* col_idx = parsed_args->csr->col_idx;
+  register const float*    val     = parsed_args->csr->val;
+  register const float*    x       = parsed_args->x;
+  register       float*    y       = parsed_args->y;
+  register       uint32_t  nrows   = parsed_args->csr->nrows;
+
+  for (uint32_t r = 0; r < nrows; r++) {
+    uint32_t k   = row_ptr[r];
+    uint32_t end = row_ptr[r + 1];
+
+    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+
+    for (; k + 4 <= end; k += 4) {
+      s0 += val[k + 0] * x[col_idx[k + 0]];
+      s1 += val[k + 1] * x[col_idx[k + 1]];
+      s2 += val[k + 2] * x[col_idx[k + 2]];
+      s3 += val[k + 3] * x[col_idx[k + 3]];
+    }
+    for (; k < end; k++) {
+      s0 += val[k] * x[col_idx[k]];
+    }
+
+    y[r] = (s0 + s1) + (s2 + s3);
+  }
+
+  /* Done */
+  return NULL;
+}
@@ -0,0 +1,15 @@
+/* opt.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 13 Nov. 2023
+ *
+ * Header for scalar optimized function.
+ */
+
+#ifndef __IMPL_OPT_H_
+#define __IMPL_OPT_H_
+
+/* Function declaration */
+void* impl_scalar_opt(void* args);
+
+#endif //__IMPL_OPT_H_
@@ -0,0 +1,92 @@
+/* para.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Every thread runs the dispatched SELL-C-sigma kernel over a contiguous
+ * run of slices. impl_parallel balances the runs by stored entries
+ * (nonzeros plus padding), so a thread that draws a few long rows gets
+ * fewer slices; impl_parallel_rows gives every thread the same number of
+ * slices, as a dense kernel would.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/pool.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/vec.h"
+#include "impl/para.h"
+
+/* First slice at or after stored entry target */
+static size_t para_slice_at(const sell_t* A, size_t target)
+{
+  size_t lo = 0, hi = A->nslices;
+
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+
+    if (A->slice_ptr[mid] < target) lo = mid + 1;
+    else                            hi = mid;
+  }
+
+  return lo;
+}
+
+static void worker_nnz(int tid, int nthreads, void* args)
+{
+  /* Parse the arguments structure */
+  args_t*       p_args = (args_t*)args;
+  const sell_t* A      = p_args->sell;
+
+  /* Our share of the stored entries, rounded to whole slices */
+  args_t chunk = *p_args;
+
+  chunk.slice_begin = para_slice_at(A, A->nstored * tid       / nthreads);
+  chunk.slice_end   = para_slice_at(A, A->nstored * (tid + 1) / nthreads);
+
+  if (chunk.slice_begin < chunk.slice_end) impl_vector(&chunk);
+}
+
+static void worker_rows(int tid, int nthreads, void* args)
+{
+  /* Parse the arguments structure */
+  args_t* p_args = (args_t*)args;
+
+  /* Our share of the slices */
+  args_t chunk = *p_args;
+
+  pool_partition(p_args->sell->nslices, 1, tid, nthreads,
+                 &chunk.slice_begin, &chunk.slice_end);
+
+  if (chunk.slice_begin < chunk.slice_end) impl_vector(&chunk);
+}
+
+/* Alternative Implementation */
+void* impl_parallel(void* args)
+{
+  /* Get the argument struct */
+  args_t* p_args = (args_t*)args;
+
+  /* Dispatch into the worker pool */
+  pool_run(p_args->pool, p_args->nthreads, worker_nnz, p_args);
+
+  /* Done */
+  return NULL;
+}
+
+void* impl_parallel_rows(void* args)
+{
+  args_t* p_args = (args_t*)args;
+
+  pool_run(p_args->pool, p_args->nthreads, worker_rows, p_args);
+
+  return NULL;
+}
@@ -0,0 +1,42 @@
+/* ref.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Reference SpMV: CSR, one row at a time, accumulated in double.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Reference Implementation */
+void* impl_ref(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register const csr_t* A = parsed_args->csr;
+  register const float* x = parsed_args->x;
+  register       float* y = parsed_args->y;
+
+  for (uint32_t r = 0; r < A->nrows; r++) {
+    double sum = 0.0;
+
+    for (uint32_t k = A->row_ptr[r]; k < A->row_ptr[r + 1]; k++) {
+      sum += (double)A->val[k] * x[A->col_idx[k]];
+    }
+
+    y[r] = (float)sum;
+  }
+
+  /* Done */
+  return NULL;
+}
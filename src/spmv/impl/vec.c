@@ -0,0 +1,71 @@
+/* vec.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * SELL-C-sigma SpMV. Within a slice, entry j of its C rows is contiguous,
+ * so each step loads C values and C column indices and gathers C entries
+ * of x; rows of a slice have similar lengths (sigma sorting), so little
+ * of the work is padding.
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/cpu.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/vec.h"
+
+/* Variants, widest first */
+static const cpu_variant_t variants[] = {
+#if defined(__amd64__) || defined(__x86_64__)
+  { CPU_ISA_AVX512, impl_vector_avx512 },
+  { CPU_ISA_AVX2  , impl_vector_avx2   },
+#endif
+  { CPU_ISA_SCALAR, impl_vector_scalar },
+};
+
+static cpu_dispatch_t dispatch = CPU_DISPATCH_INIT(variants);
+
+/* Baseline variant for hosts without a usable SIMD extension */
+void* impl_vector_scalar(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register const sell_t* A = parsed_args->sell;
+  register const float*  x = parsed_args->x;
+  register       float*  y = parsed_args->y;
+  register       size_t  C = A->C;
+
+  for (size_t s = parsed_args->slice_begin; s < parsed_args->slice_end; s++) {
+    const uint32_t* col  = &A->col_idx[A->slice_ptr[s]];
+    const float*    val  = &A->val    [A->slice_ptr[s]];
+    const uint32_t* perm = &A->perm   [s * C];
+
+    for (size_t r = 0; r < C; r++) {
+      float sum = 0.0f;
+
+      for (size_t j = 0; j < A->slice_len[s]; j++) {
+        sum += val[j * C + r] * x[col[j * C + r]];
+      }
+
+      if (perm[r] < A->nrows) y[perm[r]] = sum;
+    }
+  }
+
+  /* Done */
+  return NULL;
+}
+
+/* Alternative Implementation */
+void* impl_vector(void* args)
+{
+  return cpu_dispatch(&dispatch)(args);
+}
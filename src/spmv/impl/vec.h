@@ -0,0 +1,23 @@
+/* vec.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 13 Nov. 2023
+ *
+ * Header for vectorized function. impl_vector runs SELL-C-sigma slices
+ * [slice_begin, slice_end) and dispatches at runtime to the widest
+ * variant the host supports (see common/cpu.h); the variants live in
+ * vec.<isa>.c.
+ */
+
+#ifndef __IMPL_VEC_H_
+#define __IMPL_VEC_H_
+
+/* Function declaration */
+void* impl_vector(void* args);
+
+/* Per-ISA variants */
+void* impl_vector_scalar(void* args);
+void* impl_vector_avx2  (void* args);
+void* impl_vector_avx512(void* args);
+
+#endif //__IMPL_VEC_H_
@@ -0,0 +1,82 @@
+/* matrix.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains the sparse matrix formats of the SpMV benchmark:
+ *
+ *   CSR          row_ptr[nrows + 1] offsets into col_idx/val, the columns
+ *                of every row in increasing order.
+ *   SELL-C-sigma Rows grouped into slices of C; within each window of
+ *                sigma rows, rows are sorted by decreasing length first,
+ *                so the rows of a slice have similar lengths. Slice s
+ *                holds slice_len[s] columns of C entries, column-major
+ *                (entry j of row r of the slice at slice_ptr[s] + j * C +
+ *                r), padded with zeros whose column is 0. perm maps slice
+ *                rows back to matrix rows; padding rows map to nrows.
+ *
+ * Rows and columns are below 2^31, so the vector variants can gather with
+ * the column indices as signed 32-bit offsets.
+ *
+ * Matrices come from a Matrix Market coordinate file, which is mapped and
+ * parsed in place, or from a generator with a few long rows so row- and
+ * nonzero-balanced partitions differ.
+ */
+
+#ifndef __INCLUDE_MATRIX_H_
+#define __INCLUDE_MATRIX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* SELL-C-sigma chunk heights are whole vectors of every variant */
+#define SELL_C_ALIGN 8
+
+typedef struct {
+  uint32_t  nrows;
+  uint32_t  ncols;
+  size_t    nnz;
+
+  uint32_t* row_ptr;
+  uint32_t* col_idx;
+  float*    val;
+} csr_t;
+
+typedef struct {
+  uint32_t  nrows;
+  uint32_t  ncols;
+  size_t    nnz;       /* Nonzeros, without the padding         */
+
+  uint32_t  C;
+  uint32_t  sigma;
+  uint32_t  nslices;
+  size_t    nstored;   /* Entries, padding included             */
+
+  size_t*   slice_ptr; /* nslices + 1 offsets into col_idx/val  */
+  uint32_t* slice_len;
+  uint32_t* perm;      /* nslices * C                           */
+  uint32_t* col_idx;
+  float*    val;
+} sell_t;
+
+/* Map and parse a Matrix Market coordinate file (real, integer or
+ * pattern; general, symmetric or skew-symmetric) into csr; returns 0, or
+ * -1 after printing an error */
+int  csr_load    (const char* path, csr_t* csr);
+
+/* Random nrows x nrows matrix with about nnz_per_row nonzeros a row,
+ * mostly near the diagonal, and a long row every few hundred rows */
+void csr_generate(uint32_t nrows, uint32_t nnz_per_row, csr_t* csr);
+
+void csr_free    (csr_t* csr);
+
+/* Longest row */
+uint32_t csr_max_row(const csr_t* csr);
+
+/* SELL-C-sigma copy of csr; C is a multiple of SELL_C_ALIGN and sigma of
+ * C */
+void sell_build  (const csr_t* csr, uint32_t C, uint32_t sigma, sell_t* sell);
+
+void sell_free   (sell_t* sell);
+
+#endif //__INCLUDE_MATRIX_H_
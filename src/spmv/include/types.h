@@ -0,0 +1,35 @@
+/* types.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains all required types decalartions.
+*/
+
+#ifndef __INCLUDE_TYPES_H_
+#define __INCLUDE_TYPES_H_
+
+#include <stddef.h>
+
+#include "include/matrix.h"
+
+typedef struct {
+  /* y = A x, with A in both formats; the CSR implementations (naive,
+   * opt) read csr, the others sell */
+  const csr_t*  csr;
+  const sell_t* sell;
+
+  const float*  x;
+  float*        y;
+
+  /* Slices [slice_begin, slice_end) of sell, for the SELL kernels */
+  size_t        slice_begin;
+  size_t        slice_end;
+
+  int     cpu;
+  int     nthreads;
+
+  struct pool_t* pool;
+} args_t;
+
+#endif //__INCLUDE_TYPES_H_
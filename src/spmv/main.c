@@ -0,0 +1,363 @@
+/* main.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Microbenchmark for sparse matrix-vector multiplication, y = A x, over
+ * float. The matrix is read from a Matrix Market file (-f) or generated,
+ * and kept in two formats (include/matrix.h): CSR for the scalar
+ * implementations and SELL-C-sigma for the vectorized and parallelized
+ * ones. The parallel implementations split the slices by nonzeros (para)
+ * or by count (para_rows). Every output row is checked against a double-
+ * precision CSR reference, within a bound relative to the sum of
+ * magnitudes of its products. The file also adds a guard word after the
+ * output to check for buffer overruns.
+ *
+ * Option parsing, scheduling, timing, statistics and the CSV dump are
+ * handled by the shared driver (common/driver.h); this file only owns
+ * the data.
+ */
+
+/* Standard C includes  */
+/*  -> Standard Library */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+/*  -> Types            */
+#include <stdbool.h>
+#include <inttypes.h>
+
+/* Include all implementations declarations */
+#include "impl/ref.h"
+#include "impl/naive.h"
+#include "impl/opt.h"
+#include "impl/vec.h"
+#include "impl/para.h"
+
+/* Include common headers */
+#include "common/types.h"
+#include "common/macros.h"
+#include "common/driver.h"
+#include "common/check.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/matrix.h"
+
+/* Rows and nonzeros per row of the generated matrix */
+const int SIZE_DATA   = 256 * 1024;
+const int NNZ_PER_ROW = 16;
+
+/* SELL-C-sigma defaults */
+#define SPMV_C      8
+#define SPMV_SIGMA  4096
+
+/* Largest error of a row, relative to the sum of magnitudes of its
+ * products */
+#define SPMV_RTOL 1e-5
+
+/* Benchmark state */
+typedef struct {
+  const char* path;        /* Matrix Market file, or NULL to generate */
+  int         data_size;
+  int         nnz_per_row;
+  int         C;
+  int         sigma;
+
+  csr_t       csr;
+  sell_t      sell;
+
+  float*      x;
+  float*      ref;
+  float*      dest;
+  double*     bound;       /* Sum of |a_rj x_j| of every row r        */
+  double      err;         /* Largest relative error of the last verify */
+
+  args_t      args;
+} spmv_t;
+
+static int spmv_parse_arg(void* ctx, int argc, char** argv, int i)
+{
+  spmv_t* b = (spmv_t*)ctx;
+
+  /* Matrix file */
+  if (strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--file") == 0) {
+    assert (++i < argc);
+    b->path = argv[i];
+
+    return 2;
+  }
+
+  /* Generated matrix */
+  if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--size") == 0) {
+    assert (++i < argc);
+    b->data_size = atoi(argv[i]);
+    if (b->data_size <= 0) {
+      printf("\n");
+      printf("ERROR: Invalid size \"%s\".\n", argv[i]);
+      return -1;
+    }
+
+    return 2;
+  }
+
+  if (strcmp(argv[i], "--nnz") == 0) {
+    assert (++i < argc);
+    b->nnz_per_row = atoi(argv[i]);
+    if (b->nnz_per_row <= 0) {
+      printf("\n");
+      printf("ERROR: Invalid nonzeros per row \"%s\".\n", argv[i]);
+      return -1;
+    }
+
+    return 2;
+  }
+
+  /* SELL-C-sigma shape */
+  if (strcmp(argv[i], "-C") == 0 || strcmp(argv[i], "--chunk") == 0) {
+    assert (++i < argc);
+    b->C = atoi(argv[i]);
+    if (b->C <= 0 || b->C % SELL_C_ALIGN != 0) {
+      printf("\n");
+      printf("ERROR: The chunk height must be a multiple of %d.\n", SELL_C_ALIGN);
+      return -1;
+    }
+
+    return 2;
+  }
+
+  if (strcmp(argv[i], "--sigma") == 0) {
+    assert (++i < argc);
+    b->sigma = atoi(argv[i]);
+    if (b->sigma <= 0) {
+      printf("\n");
+      printf("ERROR: Invalid sorting window \"%s\".\n", argv[i]);
+      return -1;
+    }
+
+    return 2;
+  }
+
+  return 0;
+}
+
+static void spmv_usage(void* ctx)
+{
+  spmv_t* b = (spmv_t*)ctx;
+
+  printf("    -f | --file      Matrix Market file (coordinate) to multiply\n");
+  printf("    -s | --size      Rows of the generated matrix, without --file (default = %d)\n", b->data_size);
+  printf("         --nnz       Nonzeros per row of the generated matrix (default = %d)\n", b->nnz_per_row);
+  printf("    -C | --chunk     SELL-C-sigma chunk height, a multiple of %d (default = %d)\n", SELL_C_ALIGN, b->C);
+  printf("         --sigma     SELL-C-sigma sorting window, a multiple of C (default = %d)\n", b->sigma);
+}
+
+static bool spmv_setup(void* ctx, int idx, const driver_env_t* env,
+                       driver_case_t* c)
+{
+  spmv_t* b = (spmv_t*)ctx;
+
+  if (b->sigma % b->C != 0) {
+    printf("\n");
+    printf("ERROR: The sorting window (%d) must be a multiple of C (%d).\n",
+           b->sigma, b->C);
+    return false;
+  }
+
+  /* Datasets */
+  /* Matrix */
+  if (b->path != NULL) {
+    printf("Loading matrix \"%s\" .... ", b->path);
+    fflush(stdout);
+    if (csr_load(b->path, &b->csr) != 0) return false;
+    printf("Succeeded\n");
+  } else {
+    csr_generate(b->data_size, b->nnz_per_row, &b->csr);
+  }
+
+  sell_build(&b->csr, b->C, b->sigma, &b->sell);
+
+  /* Allocation and initialization */
+  b->x     = __ALLOC_DATA(float , b->csr.ncols);
+  b->ref   = __ALLOC_DATA(float , b->csr.nrows + 1);
+  b->dest  = __ALLOC_DATA(float , b->csr.nrows + 1);
+  b->bound = __ALLOC_DATA(double, b->csr.nrows);
+
+  for (uint32_t j = 0; j < b->csr.ncols; j++) {
+    b->x[j] = 2.0f * rand() / RAND_MAX - 1.0f;
+  }
+
+  memset(b->dest, 0, b->csr.nrows * sizeof(float));
+
+  /* Setting a guards, which is 0xdeadcafe.
+     The guard should not change or be touched. */
+  __SET_GUARD(b->ref , b->csr.nrows * sizeof(float));
+  __SET_GUARD(b->dest, b->csr.nrows * sizeof(float));
+
+  /* Scale of the error bound of every row */
+  for (uint32_t r = 0; r < b->csr.nrows; r++) {
+    double sum = 0.0;
+
+    for (uint32_t k = b->csr.row_ptr[r]; k < b->csr.row_ptr[r + 1]; k++) {
+      sum += fabs((double)b->csr.val[k] * b->x[b->csr.col_idx[k]]);
+    }
+
+    b->bound[r] = sum;
+  }
+
+  /* Generate ref data */
+  /* Arguments for the functions */
+  args_t args_ref;
+
+  args_ref.csr         = &b->csr;
+  args_ref.sell        = &b->sell;
+  args_ref.x           = b->x;
+  args_ref.y           = b->ref;
+  args_ref.slice_begin = 0;
+  args_ref.slice_end   = b->sell.nslices;
+
+  args_ref.cpu         = env->cpu;
+  args_ref.nthreads    = env->nthreads;
+  args_ref.pool        = env->pool;
+
+  /* Running the reference function */
+  impl_ref(&args_ref);
+
+  /* Arguments for the requested implementation */
+  b->args   = args_ref;
+  b->args.y = b->dest;
+
+  /* Compulsory traffic is that of CSR: every value and column index, the
+   * row pointers, x once and y */
+  c->args  = &b->args;
+  c->label = NULL;
+  c->flops = 2.0 * b->csr.nnz;
+  c->bytes = b->csr.nnz * (sizeof(float) + sizeof(uint32_t))
+           + (b->csr.nrows + 1.0) * sizeof(uint32_t)
+           + (double)b->csr.ncols * sizeof(float)
+           + (double)b->csr.nrows * sizeof(float);
+  c->elems = (double)b->csr.nnz;
+
+  return true;
+}
+
+static driver_check_t spmv_verify(void* ctx, int idx)
+{
+  spmv_t* b = (spmv_t*)ctx;
+  driver_check_t check = { 0 };
+
+  /* Statistics over the whole output; only NaNs fail this part */
+  check.match = check_floats(b->ref, b->dest, b->csr.nrows, INFINITY, &check.err);
+
+  b->err = 0.0;
+  for (uint32_t r = 0; r < b->csr.nrows; r++) {
+    double d   = fabs((double)b->dest[r] - b->ref[r]);
+    double err = (b->bound[r] > 0.0) ? d / b->bound[r] : d;
+
+    if (err > b->err) b->err = err;
+  }
+
+  check.match = check.match && (b->err <= SPMV_RTOL);
+  check.guard = __CHECK_GUARD(b->dest, b->csr.nrows * sizeof(float));
+
+  return check;
+}
+
+static void spmv_report(void* ctx, int idx)
+{
+  spmv_t* b = (spmv_t*)ctx;
+
+  printf("  * Matrix: %" PRIu32 " x %" PRIu32 ", %zu nonzeros (%.1f a row, longest %" PRIu32 ")\n",
+         b->csr.nrows, b->csr.ncols, b->csr.nnz,
+         (double)b->csr.nnz / b->csr.nrows, csr_max_row(&b->csr));
+  printf("  * SELL-%" PRIu32 "-%" PRIu32 ": %zu entries stored, %.1f%% padding\n",
+         b->sell.C, b->sell.sigma, b->sell.nstored,
+         100.0 * (b->sell.nstored - b->sell.nnz) / b->sell.nstored);
+  printf("  * Error: %.3g of the sum of magnitudes of a row\n", b->err);
+}
+
+static void spmv_dump(void* ctx, int idx, FILE* fp)
+{
+  spmv_t* b = (spmv_t*)ctx;
+
+  fprintf(fp, "\nmatrix,%s\nrows,%" PRIu32 "\ncols,%" PRIu32 "\nnnz,%zu"
+              "\nsell_c,%" PRIu32 "\nsell_sigma,%" PRIu32 "\nstored,%zu\nrel_err,%.6g",
+          (b->path != NULL) ? b->path : "generated",
+          b->csr.nrows, b->csr.ncols, b->csr.nnz,
+          b->sell.C, b->sell.sigma, b->sell.nstored, b->err);
+}
+
+static void spmv_reset(void* ctx, int idx)
+{
+  spmv_t* b = (spmv_t*)ctx;
+
+  /* Clear the output, leaving the guard intact */
+  memset(b->dest, 0, b->csr.nrows * sizeof(float));
+}
+
+static void spmv_set_nthreads(void* ctx, int idx, int nthreads)
+{
+  spmv_t* b = (spmv_t*)ctx;
+
+  b->args.nthreads = nthreads;
+}
+
+static void spmv_teardown(void* ctx, int idx)
+{
+  spmv_t* b = (spmv_t*)ctx;
+
+  /* Manage memory */
+  csr_free (&b->csr);
+  sell_free(&b->sell);
+
+  __FREE_DATA(b->x);
+  __FREE_DATA(b->ref);
+  __FREE_DATA(b->dest);
+  __FREE_DATA(b->bound);
+}
+
+static const driver_impl_t impls[] = {
+  { "naive"    , "csr_naive"        , impl_scalar_naive  },
+  { "opt"      , "csr_opt"          , impl_scalar_opt    },
+  { "vec"      , "sell_vectorized"  , impl_vector        },
+  { "para"     , "sell_parallelized", impl_parallel      },
+  { "para_rows", "sell_para_rows"   , impl_parallel_rows },
+};
+
+int main(int argc, char** argv)
+{
+  spmv_t ctx;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.data_size   = SIZE_DATA;
+  ctx.nnz_per_row = NNZ_PER_ROW;
+  ctx.C           = SPMV_C;
+  ctx.sigma       = SPMV_SIGMA;
+
+  driver_bench_t bench = {
+    .name         = "spmv",
+    .impls        = impls,
+    .nimpls       = sizeof(impls) / sizeof(impls[0]),
+
+    .nruns        = 1000,
+    .ninner       = 4,
+    .nwarmup      = 2,
+
+    .ctx          = &ctx,
+
+    .parse_arg    = spmv_parse_arg,
+    .usage        = spmv_usage,
+    .ncases       = NULL,
+    .setup        = spmv_setup,
+    .verify       = spmv_verify,
+    .report       = spmv_report,
+    .reset        = spmv_reset,
+    .dump         = spmv_dump,
+    .teardown     = spmv_teardown,
+    .set_nthreads = spmv_set_nthreads,
+  };
+
+  return driver_main(&bench, argc, argv);
+}
@@ -0,0 +1,497 @@
+/* matrix.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Implementation of the sparse matrix formats; see include/matrix.h.
+ */
+
+#define _GNU_SOURCE
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Include common headers */
+#include "common/macros.h"
+
+/* Include application-specific headers */
+#include "include/matrix.h"
+
+/* Longest number the parser accepts */
+#define MM_TOKEN 64
+
+/* Mirrored entries of a symmetric file */
+typedef enum {
+  MM_GENERAL = 0,
+  MM_SYMMETRIC  ,
+  MM_SKEW       ,
+} mm_symmetry_t;
+
+/* Cursor over the mapped file */
+typedef struct {
+  const char* p;
+  const char* end;
+} mm_cursor_t;
+
+static bool mm_space(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/* Next whitespace-separated token as a C string; false past the end or if
+ * it does not fit */
+static bool mm_token(mm_cursor_t* cur, char buf[MM_TOKEN])
+{
+  while (cur->p < cur->end && mm_space(*cur->p)) cur->p++;
+
+  size_t n = 0;
+  while (cur->p < cur->end && !mm_space(*cur->p)) {
+    if (n + 1 == MM_TOKEN) return false;
+    buf[n++] = *cur->p++;
+  }
+  buf[n] = '\0';
+
+  return n > 0;
+}
+
+/* Rest of the current line */
+static void mm_skip_line(mm_cursor_t* cur)
+{
+  while (cur->p < cur->end && *cur->p != '\n') cur->p++;
+  if (cur->p < cur->end) cur->p++;
+}
+
+static bool mm_long(mm_cursor_t* cur, long long* v)
+{
+  char  buf[MM_TOKEN];
+  char* end;
+
+  if (!mm_token(cur, buf)) return false;
+
+  errno = 0;
+  *v = strtoll(buf, &end, 10);
+
+  return errno == 0 && *end == '\0';
+}
+
+static bool mm_double(mm_cursor_t* cur, double* v)
+{
+  char  buf[MM_TOKEN];
+  char* end;
+
+  if (!mm_token(cur, buf)) return false;
+
+  *v = strtod(buf, &end);
+
+  return *end == '\0';
+}
+
+/* Banner and size line; leaves cur at the first entry */
+static int mm_header(const char* path, mm_cursor_t* cur, bool* pattern,
+                     mm_symmetry_t* sym, long long size[3])
+{
+  char object[MM_TOKEN], format[MM_TOKEN], field[MM_TOKEN], symmetry[MM_TOKEN];
+  char banner[MM_TOKEN];
+
+  if (!mm_token(cur, banner) || strcmp(banner, "%%MatrixMarket") != 0 ||
+      !mm_token(cur, object) || !mm_token(cur, format) ||
+      !mm_token(cur, field ) || !mm_token(cur, symmetry)) {
+    printf("\n");
+    printf("ERROR: \"%s\" is not a Matrix Market file\n", path);
+    return -1;
+  }
+
+  if (strcasecmp(object, "matrix") != 0 || strcasecmp(format, "coordinate") != 0) {
+    printf("\n");
+    printf("ERROR: \"%s\" is not a sparse (coordinate) matrix\n", path);
+    return -1;
+  }
+
+  if      (strcasecmp(field, "real"   ) == 0) *pattern = false;
+  else if (strcasecmp(field, "double" ) == 0) *pattern = false;
+  else if (strcasecmp(field, "integer") == 0) *pattern = false;
+  else if (strcasecmp(field, "pattern") == 0) *pattern = true;
+  else {
+    printf("\n");
+    printf("ERROR: Unsupported \"%s\" field in \"%s\"\n", field, path);
+    return -1;
+  }
+
+  if      (strcasecmp(symmetry, "general"       ) == 0) *sym = MM_GENERAL;
+  else if (strcasecmp(symmetry, "symmetric"     ) == 0) *sym = MM_SYMMETRIC;
+  else if (strcasecmp(symmetry, "skew-symmetric") == 0) *sym = MM_SKEW;
+  else {
+    printf("\n");
+    printf("ERROR: Unsupported \"%s\" symmetry in \"%s\"\n", symmetry, path);
+    return -1;
+  }
+
+  /* Comments and blank lines up to the size line */
+  mm_skip_line(cur);
+  while (cur->p < cur->end && (*cur->p == '%' || mm_space(*cur->p))) {
+    if (*cur->p == '%') mm_skip_line(cur);
+    else                cur->p++;
+  }
+
+  if (!mm_long(cur, &size[0]) || !mm_long(cur, &size[1]) ||
+      !mm_long(cur, &size[2]) || size[0] <= 0 || size[1] <= 0 ||
+      size[0] > INT32_MAX || size[1] > INT32_MAX ||
+      size[2] < 0 || size[2] > UINT32_MAX / 2) {
+    printf("\n");
+    printf("ERROR: Bad size line in \"%s\"\n", path);
+    return -1;
+  }
+
+  return 0;
+}
+
+/* One pass over the entries: counts per row if col_idx is NULL, else
+ * places them at next[row]++ */
+static int mm_entries(const char* path, mm_cursor_t cur, bool pattern,
+                      mm_symmetry_t sym, const long long size[3],
+                      uint32_t* next, uint32_t* col_idx, float* val)
+{
+  for (long long k = 0; k < size[2]; k++) {
+    long long i, j;
+    double    v = 1.0;
+
+    if (!mm_long(&cur, &i) || !mm_long(&cur, &j) ||
+        (!pattern && !mm_double(&cur, &v)) ||
+        i < 1 || i > size[0] || j < 1 || j > size[1]) {
+      printf("\n");
+      printf("ERROR: Bad entry %lld in \"%s\"\n", k + 1, path);
+      return -1;
+    }
+
+    /* Any imaginary part or trailing text is ignored */
+    mm_skip_line(&cur);
+
+    uint32_t r = (uint32_t)(i - 1);
+    uint32_t c = (uint32_t)(j - 1);
+    bool     mirror = (sym != MM_GENERAL && r != c);
+
+    if (col_idx == NULL) {
+      next[r + 1]++;
+      if (mirror) next[c + 1]++;
+    } else {
+      col_idx[next[r]] = c;
+      val    [next[r]] = (float)v;
+      next[r]++;
+
+      if (mirror) {
+        col_idx[next[c]] = r;
+        val    [next[c]] = (float)((sym == MM_SKEW) ? -v : v);
+        next[c]++;
+      }
+    }
+  }
+
+  return 0;
+}
+
+typedef struct {
+  uint32_t col;
+  float    val;
+} csr_entry_t;
+
+static int csr_entry_cmp(const void* a, const void* b)
+{
+  uint32_t ca = ((const csr_entry_t*)a)->col;
+  uint32_t cb = ((const csr_entry_t*)b)->col;
+
+  return (ca > cb) - (ca < cb);
+}
+
+/* Columns of every row in increasing order */
+static void csr_sort_rows(csr_t* csr)
+{
+  csr_entry_t* tmp = (csr_entry_t*)malloc(csr_max_row(csr) * sizeof(*tmp) + 1);
+
+  for (uint32_t r = 0; r < csr->nrows; r++) {
+    uint32_t b = csr->row_ptr[r];
+    uint32_t n = csr->row_ptr[r + 1] - b;
+
+    for (uint32_t k = 0; k < n; k++) {
+      tmp[k].col = csr->col_idx[b + k];
+      tmp[k].val = csr->val    [b + k];
+    }
+
+    qsort(tmp, n, sizeof(*tmp), csr_entry_cmp);
+
+    for (uint32_t k = 0; k < n; k++) {
+      csr->col_idx[b + k] = tmp[k].col;
+      csr->val    [b + k] = tmp[k].val;
+    }
+  }
+
+  free(tmp);
+}
+
+int csr_load(const char* path, csr_t* csr)
+{
+  memset(csr, 0, sizeof(*csr));
+
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    printf("\n");
+    printf("ERROR: Cannot open matrix \"%s\": %s\n", path, strerror(errno));
+    return -1;
+  }
+
+  struct stat st;
+  void*       base = MAP_FAILED;
+
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd);
+
+  if (base == MAP_FAILED) {
+    printf("\n");
+    printf("ERROR: Cannot map matrix \"%s\": %s\n", path, strerror(errno));
+    return -1;
+  }
+
+  /* The file is parsed twice in place, counting the entries of every row
+   * and then placing them, so no coordinate copy is ever held */
+  mm_cursor_t   cur = { (const char*)base, (const char*)base + st.st_size };
+  bool          pattern;
+  mm_symmetry_t sym;
+  long long     size[3];
+
+  int rc = mm_header(path, &cur, &pattern, &sym, size);
+
+  if (rc == 0) {
+    csr->nrows   = (uint32_t)size[0];
+    csr->ncols   = (uint32_t)size[1];
+    csr->row_ptr = __ALLOC_DATA(uint32_t, csr->nrows + 1);
+
+    memset(csr->row_ptr, 0, (csr->nrows + 1) * sizeof(uint32_t));
+    rc = mm_entries(path, cur, pattern, sym, size, csr->row_ptr, NULL, NULL);
+  }
+
+  if (rc == 0) {
+    for (uint32_t r = 0; r < csr->nrows; r++) {
+      csr->row_ptr[r + 1] += csr->row_ptr[r];
+    }
+
+    csr->nnz     = csr->row_ptr[csr->nrows];
+    csr->col_idx = __ALLOC_DATA(uint32_t, csr->nnz + 1);
+    csr->val     = __ALLOC_DATA(float   , csr->nnz + 1);
+
+    uint32_t* next = (uint32_t*)malloc(csr->nrows * sizeof(uint32_t));
+    memcpy(next, csr->row_ptr, csr->nrows * sizeof(uint32_t));
+
+    rc = mm_entries(path, cur, pattern, sym, size, next, csr->col_idx, csr->val);
+
+    free(next);
+  }
+
+  munmap(base, st.st_size);
+
+  if (rc != 0) {
+    csr_free(csr);
+    return -1;
+  }
+
+  csr_sort_rows(csr);
+
+  return 0;
+}
+
+static int csr_col_cmp(const void* a, const void* b)
+{
+  uint32_t ca = *(const uint32_t*)a;
+  uint32_t cb = *(const uint32_t*)b;
+
+  return (ca > cb) - (ca < cb);
+}
+
+/* Columns within this distance of the diagonal (wrapping around) are
+ * "near" */
+#define CSR_GEN_BAND 512
+
+/* One row in this many is CSR_GEN_LONG times longer */
+#define CSR_GEN_EVERY 256
+#define CSR_GEN_LONG  32
+
+void csr_generate(uint32_t nrows, uint32_t nnz_per_row, csr_t* csr)
+{
+  memset(csr, 0, sizeof(*csr));
+
+  csr->nrows   = nrows;
+  csr->ncols   = nrows;
+  csr->row_ptr = __ALLOC_DATA(uint32_t, nrows + 1);
+
+  /* Row lengths: uniform in [1, 2 * nnz_per_row - 1], a long row every
+   * CSR_GEN_EVERY on average, and never more than the columns */
+  csr->row_ptr[0] = 0;
+  for (uint32_t r = 0; r < nrows; r++) {
+    size_t len = 1 + rand() % (2 * nnz_per_row - 1);
+    if (rand() % CSR_GEN_EVERY == 0) len *= CSR_GEN_LONG;
+    if (len > nrows) len = nrows;
+
+    csr->row_ptr[r + 1] = csr->row_ptr[r] + (uint32_t)len;
+  }
+
+  csr->col_idx = __ALLOC_DATA(uint32_t, (size_t)csr->row_ptr[nrows] + 1);
+  csr->val     = __ALLOC_DATA(float   , (size_t)csr->row_ptr[nrows] + 1);
+
+  /* Three columns in four near the diagonal, so x is mostly reused from
+   * cache; rows are then sorted and deduplicated in place, dropping
+   * their length a little */
+  size_t nnz = 0;
+  for (uint32_t r = 0; r < nrows; r++) {
+    uint32_t  len  = csr->row_ptr[r + 1] - csr->row_ptr[r];
+    uint32_t* cols = &csr->col_idx[nnz];
+
+    for (uint32_t k = 0; k < len; k++) {
+      if (rand() % 4 != 0) {
+        long long c = (long long)r + rand() % (2 * CSR_GEN_BAND + 1) - CSR_GEN_BAND;
+        cols[k] = (uint32_t)(((c % nrows) + nrows) % nrows);
+      } else {
+        cols[k] = (uint32_t)(rand() % nrows);
+      }
+    }
+
+    qsort(cols, len, sizeof(uint32_t), csr_col_cmp);
+
+    uint32_t n = 0;
+    for (uint32_t k = 0; k < len; k++) {
+      if (n == 0 || cols[n - 1] != cols[k]) cols[n++] = cols[k];
+    }
+
+    for (uint32_t k = 0; k < n; k++) {
+      csr->val[nnz + k] = 2.0f * rand() / RAND_MAX - 1.0f;
+    }
+
+    csr->row_ptr[r] = (uint32_t)nnz;
+    nnz += n;
+  }
+
+  csr->row_ptr[nrows] = (uint32_t)nnz;
+  csr->nnz            = nnz;
+}
+
+void csr_free(csr_t* csr)
+{
+  __FREE_DATA(csr->row_ptr);
+  __FREE_DATA(csr->col_idx);
+  __FREE_DATA(csr->val);
+
+  memset(csr, 0, sizeof(*csr));
+}
+
+uint32_t csr_max_row(const csr_t* csr)
+{
+  uint32_t m = 0;
+
+  for (uint32_t r = 0; r < csr->nrows; r++) {
+    uint32_t len = csr->row_ptr[r + 1] - csr->row_ptr[r];
+    if (len > m) m = len;
+  }
+
+  return m;
+}
+
+/* Row order for sell_build: decreasing length, then increasing index */
+static const csr_t* sell_sort_csr;
+
+static int sell_row_cmp(const void* a, const void* b)
+{
+  uint32_t ra = *(const uint32_t*)a;
+  uint32_t rb = *(const uint32_t*)b;
+
+  uint32_t la = sell_sort_csr->row_ptr[ra + 1] - sell_sort_csr->row_ptr[ra];
+  uint32_t lb = sell_sort_csr->row_ptr[rb + 1] - sell_sort_csr->row_ptr[rb];
+
+  if (la != lb) return (la < lb) - (la > lb);
+
+  return (ra > rb) - (ra < rb);
+}
+
+void sell_build(const csr_t* csr, uint32_t C, uint32_t sigma, sell_t* sell)
+{
+  memset(sell, 0, sizeof(*sell));
+
+  uint32_t nslices = (csr->nrows + C - 1) / C;
+  size_t   npadded = (size_t)nslices * C;
+
+  sell->nrows   = csr->nrows;
+  sell->ncols   = csr->ncols;
+  sell->nnz     = csr->nnz;
+  sell->C       = C;
+  sell->sigma   = sigma;
+  sell->nslices = nslices;
+
+  sell->slice_ptr = __ALLOC_DATA(size_t  , nslices + 1);
+  sell->slice_len = __ALLOC_DATA(uint32_t, nslices + 1);
+  sell->perm      = __ALLOC_DATA(uint32_t, npadded);
+
+  /* Rows sorted within every sigma window; padding rows last */
+  for (size_t r = 0; r < npadded; r++) {
+    sell->perm[r] = (r < csr->nrows) ? (uint32_t)r : csr->nrows;
+  }
+
+  sell_sort_csr = csr;
+  for (uint32_t w = 0; w < csr->nrows; w += sigma) {
+    uint32_t n = (csr->nrows - w < sigma) ? csr->nrows - w : sigma;
+    qsort(&sell->perm[w], n, sizeof(uint32_t), sell_row_cmp);
+  }
+
+  /* Every slice is as wide as its longest row */
+  sell->slice_ptr[0] = 0;
+  for (uint32_t s = 0; s < nslices; s++) {
+    uint32_t len = 0;
+
+    for (uint32_t k = 0; k < C; k++) {
+      uint32_t r = sell->perm[(size_t)s * C + k];
+      if (r < csr->nrows && csr->row_ptr[r + 1] - csr->row_ptr[r] > len) {
+        len = csr->row_ptr[r + 1] - csr->row_ptr[r];
+      }
+    }
+
+    sell->slice_len[s]     = len;
+    sell->slice_ptr[s + 1] = sell->slice_ptr[s] + (size_t)len * C;
+  }
+
+  sell->nstored = sell->slice_ptr[nslices];
+  sell->col_idx = __ALLOC_DATA(uint32_t, sell->nstored + 1);
+  sell->val     = __ALLOC_DATA(float   , sell->nstored + 1);
+
+  for (uint32_t s = 0; s < nslices; s++) {
+    uint32_t* col = &sell->col_idx[sell->slice_ptr[s]];
+    float*    val = &sell->val    [sell->slice_ptr[s]];
+
+    for (uint32_t k = 0; k < C; k++) {
+      uint32_t r   = sell->perm[(size_t)s * C + k];
+      uint32_t b   = (r < csr->nrows) ? csr->row_ptr[r] : 0;
+      uint32_t len = (r < csr->nrows) ? csr->row_ptr[r + 1] - b : 0;
+
+      for (uint32_t j = 0; j < sell->slice_len[s]; j++) {
+        col[(size_t)j * C + k] = (j < len) ? csr->col_idx[b + j] : 0;
+        val[(size_t)j * C + k] = (j < len) ? csr->val    [b + j] : 0.0f;
+      }
+    }
+  }
+}
+
+void sell_free(sell_t* sell)
+{
+  __FREE_DATA(sell->slice_ptr);
+  __FREE_DATA(sell->slice_len);
+  __FREE_DATA(sell->perm);
+  __FREE_DATA(sell->col_idx);
+  __FREE_DATA(sell->val);
+
+  memset(sell, 0, sizeof(*sell));
+}
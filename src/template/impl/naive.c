@@ -12,15 +12,14 @@
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
+#include "common/mapreduce.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "include/kernel.h"
 
 /* Naive Implementation */
 #pragma GCC push_options
 #pragma GCC optimize ("O1")
-void* impl_scalar_naive(void* args)
-{
-  return NULL;
-}
+MR_MAP_NAIVE(impl_scalar_naive, TEMPLATE_ELEM, TEMPLATE_F)
 #pragma GCC pop_options
@@ -12,15 +12,11 @@
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
+#include "common/mapreduce.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "include/kernel.h"
 
-/* Alternative Implementation */
-#pragma GCC push_options
-#pragma GCC optimize ("O1")
-void* impl_scalar_opt(void* args)
-{
-  return NULL;
-}
-#pragma GCC pop_options
+/* Alternative Implementation: unrolled by four */
+MR_MAP_OPT(impl_scalar_opt, TEMPLATE_ELEM, TEMPLATE_F)
@@ -12,6 +12,8 @@
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
+#include "common/pool.h"
+#include "common/mapreduce.h"
 
 /* If we are on Darwin, include the compatibility header */
 #if defined(__APPLE__)
@@ -20,9 +22,8 @@
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
 
-/* Alternative Implementation */
-void* impl_parallel(void* args)
-{
-  return NULL;
-}
+/* Alternative Implementation: impl_vector on every thread's chunk */
+MR_MAP_PARA(impl_parallel, TEMPLATE_ELEM, impl_vector)
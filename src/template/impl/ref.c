@@ -15,9 +15,20 @@
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "include/kernel.h"
 
-/* Reference Implementation */
+/* Reference Implementation; written out rather than generated, so it
+ * checks the framework as well as the kernel */
 void* impl_ref(void* args)
 {
+  args_t* parsed_args = (args_t*)args;
+
+  const TEMPLATE_TYPE* in  = (const TEMPLATE_TYPE*)parsed_args->input;
+        TEMPLATE_TYPE* out = (      TEMPLATE_TYPE*)parsed_args->output;
+
+  for (size_t i = 0; i < parsed_args->size; i++) {
+    out[i] = TEMPLATE_F(in[i]);
+  }
+
   return NULL;
 }
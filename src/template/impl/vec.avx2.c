@@ -0,0 +1,24 @@
+/* vec.avx2.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX2 variant of impl_vector.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/mapreduce.avx2.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+MR_MAP_AVX2(impl_vector_avx2, TEMPLATE_ELEM, TEMPLATE_F_AVX2)
+#endif
@@ -12,15 +12,14 @@
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
+#include "common/cpu.h"
+#include "common/mapreduce.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "impl/opt.h"
+#include "impl/vec.h"
 
-/* Alternative Implementation */
-#pragma GCC push_options
-#pragma GCC optimize ("O1")
-void* impl_vector(void* args)
-{
-  return NULL;
-}
-#pragma GCC pop_options
+/* Alternative Implementation: the widest of vec.<isa>.c, falling back to
+ * the unrolled scalar loop */
+MR_DISPATCH(impl_vector, impl_scalar_opt)
@@ -9,7 +9,9 @@
 #ifndef __IMPL_VEC_H_
 #define __IMPL_VEC_H_
 
-/* Function declaration */
-void* impl_vector(void* args);
+#include "common/mapreduce.h"
+
+/* Function declaration, and its vec.<isa>.c variants */
+MR_DECLARE_VEC(impl_vector);
 
 #endif //__IMPL_VEC_H_
@@ -0,0 +1,26 @@
+/* kernel.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * The template's kernel, as the functors of common/mapreduce.h: every
+ * element becomes 3 * x + 1 (modulo 2^32). A new kernel changes these
+ * and the reference in impl/ref.c; the vector macros are only expanded
+ * in the matching vec.<isa>.c.
+*/
+
+#ifndef __INCLUDE_KERNEL_H_
+#define __INCLUDE_KERNEL_H_
+
+/* Element type (see MR_CTYPE) */
+#define TEMPLATE_ELEM u32
+#define TEMPLATE_TYPE MR_CTYPE(TEMPLATE_ELEM)
+
+/* Per element, per 8 and per 16 lanes */
+#define TEMPLATE_F(x)        ((x) * 3u + 1u)
+#define TEMPLATE_F_AVX2(v)   _mm256_add_epi32(_mm256_mullo_epi32(v, _mm256_set1_epi32(3)), \
+                                              _mm256_set1_epi32(1))
+#define TEMPLATE_F_AVX512(v) _mm512_add_epi32(_mm512_mullo_epi32(v, _mm512_set1_epi32(3)), \
+                                              _mm512_set1_epi32(1))
+
+#endif //__INCLUDE_KERNEL_H_
@@ -9,14 +9,10 @@
 #ifndef __INCLUDE_TYPES_H_
 #define __INCLUDE_TYPES_H_
 
-typedef struct {
-  byte*   input;
-  byte*   output;
+#include "common/mapreduce.h"
 
-  size_t size;
-
-  int     cpu;
-  int     nthreads;
-} args_t;
+/* The generated kernels (common/mapreduce.h) take an mr_args_t: input,
+ * output, size (in elements), cpu, nthreads and pool */
+typedef mr_args_t args_t;
 
 #endif //__INCLUDE_TYPES_H_
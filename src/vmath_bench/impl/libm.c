@@ -0,0 +1,58 @@
+/* libm.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Scalar baseline: logf/expf from the C library, one call per element.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Keep GCC from turning the loops into libmvec calls */
+#pragma GCC push_options
+#pragma GCC optimize ("no-tree-vectorize")
+void* impl_libm(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register const float* src  = parsed_args->input;
+  register       float* dest = parsed_args->output;
+  register       size_t size = parsed_args->size;
+
+  float (*fn)(float) = (parsed_args->func == FUNC_LOG) ? logf : expf;
+
+  if (parsed_args->latency) {
+    uint32_t dep = parsed_args->dep_mask;
+    float    y   = 0.0f;
+
+    for (size_t i = 0; i < size; i++) {
+      uint32_t u, v;
+      memcpy(&u, &src[i], sizeof(u));
+      memcpy(&v, &y     , sizeof(v));
+      u |= v & dep;
+      memcpy(&y, &u     , sizeof(y));
+
+      y = fn(y);
+      dest[i] = y;
+    }
+  } else {
+    for (size_t i = 0; i < size; i++) dest[i] = fn(src[i]);
+  }
+
+  /* Done */
+  return NULL;
+}
+#pragma GCC pop_options
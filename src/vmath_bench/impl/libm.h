@@ -0,0 +1,15 @@
+/* libm.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the scalar libm baseline.
+ */
+
+#ifndef __IMPL_LIBM_H_
+#define __IMPL_LIBM_H_
+
+/* Function declaration */
+void* impl_libm(void* args);
+
+#endif //__IMPL_LIBM_H_
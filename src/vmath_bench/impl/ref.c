@@ -0,0 +1,45 @@
+/* ref.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Reference: the double-precision libm result rounded to float, which is
+ * the correctly rounded float for all but a vanishing number of inputs.
+ */
+
+/* Standard C includes */
+#include <stdlib.h>
+#include <math.h>
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Reference Implementation */
+void* impl_ref(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  /* Get all the arguments */
+  register const float* src  = parsed_args->input;
+  register       float* dest = parsed_args->output;
+  register       size_t size = parsed_args->size;
+
+  switch (parsed_args->func) {
+  case FUNC_LOG:
+    for (size_t i = 0; i < size; i++) dest[i] = (float)log((double)src[i]);
+    break;
+  case FUNC_EXP:
+    for (size_t i = 0; i < size; i++) dest[i] = (float)exp((double)src[i]);
+    break;
+  default:
+    break;
+  }
+
+  /* Done */
+  return NULL;
+}
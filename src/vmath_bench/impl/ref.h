@@ -0,0 +1,15 @@
+/* ref.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the reference function.
+ */
+
+#ifndef __IMPL_REF_H_
+#define __IMPL_REF_H_
+
+/* Function declaration */
+void* impl_ref(void* args);
+
+#endif //__IMPL_REF_H_
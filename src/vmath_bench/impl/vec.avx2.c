@@ -0,0 +1,108 @@
+/* vec.avx2.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX2 log/exp from common/vmath.h, both precision tiers, and glibc's
+ * libmvec AVX2 entry points for comparison.
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <string.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/vmath.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/vec.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* glibc libmvec (x86_64 vector ABI, AVX2 'd' variants) */
+__m256 _ZGVdN8v_logf(__m256 x);
+__m256 _ZGVdN8v_expf(__m256 x);
+
+/* dest[i] = fn(src[i]); the tail is padded with 1.0f, valid for both */
+static inline void map_ps(__m256 (*fn)(__m256), const args_t* args)
+{
+  register const float* src  = args->input;
+  register       float* dest = args->output;
+  register       size_t size = args->size;
+
+  const size_t max_vlen = 32 / sizeof(float);
+
+  size_t i = 0;
+  if (args->latency) {
+    __m256 dep = _mm256_castsi256_ps(_mm256_set1_epi32((int)args->dep_mask));
+    __m256 y   = _mm256_setzero_ps();
+
+    for (; i + max_vlen <= size; i += max_vlen) {
+      __m256 x = _mm256_or_ps(_mm256_loadu_ps(&src[i]), _mm256_and_ps(y, dep));
+      y = fn(x);
+      _mm256_storeu_ps(&dest[i], y);
+    }
+  } else {
+    for (; i + max_vlen <= size; i += max_vlen) {
+      _mm256_storeu_ps(&dest[i], fn(_mm256_loadu_ps(&src[i])));
+    }
+  }
+
+  if (i < size) {
+    size_t rem = size - i;
+    float  buf[8] = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+
+    memcpy(buf, &src[i], rem * sizeof(float));
+    _mm256_storeu_ps(buf, fn(_mm256_loadu_ps(buf)));
+    memcpy(&dest[i], buf, rem * sizeof(float));
+  }
+}
+
+void* impl_avx2(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  switch (parsed_args->func) {
+  case FUNC_LOG: map_ps(_mm256_log_ps, parsed_args); break;
+  case FUNC_EXP: map_ps(_mm256_exp_ps, parsed_args); break;
+  default      : break;
+  }
+
+  /* Done */
+  return NULL;
+}
+
+void* impl_avx2_fast(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  switch (parsed_args->func) {
+  case FUNC_LOG: map_ps(_mm256_log_fast_ps, parsed_args); break;
+  case FUNC_EXP: map_ps(_mm256_exp_fast_ps, parsed_args); break;
+  default      : break;
+  }
+
+  /* Done */
+  return NULL;
+}
+
+void* impl_libmvec_avx2(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  switch (parsed_args->func) {
+  case FUNC_LOG: map_ps(_ZGVdN8v_logf, parsed_args); break;
+  case FUNC_EXP: map_ps(_ZGVdN8v_expf, parsed_args); break;
+  default      : break;
+  }
+
+  /* Done */
+  return NULL;
+}
+#endif
@@ -0,0 +1,106 @@
+/* vec.avx512.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * AVX-512 log/exp from common/vmath.h, both precision tiers, and glibc's
+ * libmvec AVX-512 entry points for comparison.
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/vmath.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/vec.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* glibc libmvec (x86_64 vector ABI, AVX-512 'e' variants) */
+__m512 _ZGVeN16v_logf(__m512 x);
+__m512 _ZGVeN16v_expf(__m512 x);
+
+/* dest[i] = fn(src[i]); the tail is one masked iteration over 1.0f lanes */
+static inline void map_ps(__m512 (*fn)(__m512), const args_t* args)
+{
+  register const float* src  = args->input;
+  register       float* dest = args->output;
+  register       size_t size = args->size;
+
+  const size_t max_vlen = 64 / sizeof(float);
+
+  size_t i = 0;
+  if (args->latency) {
+    __m512i dep = _mm512_set1_epi32((int)args->dep_mask);
+    __m512  y   = _mm512_setzero_ps();
+
+    for (; i + max_vlen <= size; i += max_vlen) {
+      __m512i x = _mm512_or_si512(_mm512_castps_si512(_mm512_loadu_ps(&src[i])),
+                                  _mm512_and_si512(_mm512_castps_si512(y), dep));
+      y = fn(_mm512_castsi512_ps(x));
+      _mm512_storeu_ps(&dest[i], y);
+    }
+  } else {
+    for (; i + max_vlen <= size; i += max_vlen) {
+      _mm512_storeu_ps(&dest[i], fn(_mm512_loadu_ps(&src[i])));
+    }
+  }
+
+  if (i < size) {
+    __mmask16 m = (__mmask16)((1u << (size - i)) - 1);
+
+    __m512 x = _mm512_mask_loadu_ps(_mm512_set1_ps(1.0f), m, &src[i]);
+    _mm512_mask_storeu_ps(&dest[i], m, fn(x));
+  }
+}
+
+void* impl_avx512(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  switch (parsed_args->func) {
+  case FUNC_LOG: map_ps(_mm512_log_ps, parsed_args); break;
+  case FUNC_EXP: map_ps(_mm512_exp_ps, parsed_args); break;
+  default      : break;
+  }
+
+  /* Done */
+  return NULL;
+}
+
+void* impl_avx512_fast(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  switch (parsed_args->func) {
+  case FUNC_LOG: map_ps(_mm512_log_fast_ps, parsed_args); break;
+  case FUNC_EXP: map_ps(_mm512_exp_fast_ps, parsed_args); break;
+  default      : break;
+  }
+
+  /* Done */
+  return NULL;
+}
+
+void* impl_libmvec_avx512(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  switch (parsed_args->func) {
+  case FUNC_LOG: map_ps(_ZGVeN16v_logf, parsed_args); break;
+  case FUNC_EXP: map_ps(_ZGVeN16v_expf, parsed_args); break;
+  default      : break;
+  }
+
+  /* Done */
+  return NULL;
+}
+#endif
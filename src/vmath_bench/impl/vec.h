@@ -0,0 +1,25 @@
+/* vec.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Header for the common/vmath.h kernels under test, one entry point per
+ * ISA and precision tier, plus glibc's libmvec at the same widths. Unlike
+ * the other benchmarks these are not dispatched: main.c lists the ones
+ * the host can run.
+ */
+
+#ifndef __IMPL_VEC_H_
+#define __IMPL_VEC_H_
+
+/* Function declaration */
+void* impl_avx2       (void* args);
+void* impl_avx2_fast  (void* args);
+void* impl_avx512     (void* args);
+void* impl_avx512_fast(void* args);
+void* impl_neon       (void* args);
+
+void* impl_libmvec_avx2  (void* args);
+void* impl_libmvec_avx512(void* args);
+
+#endif //__IMPL_VEC_H_
@@ -0,0 +1,76 @@
+/* vec.neon.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * NEON log/exp from common/vmath.h (a single tier).
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <string.h>
+/*  -> SIMD header file  */
+#if defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+#include <arm_neon.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/vmath.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "impl/vec.h"
+
+#if defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+/* dest[i] = fn(src[i]); the tail is padded with 1.0f, valid for both */
+static inline void map_f32(float32x4_t (*fn)(float32x4_t), const args_t* args)
+{
+  register const float* src  = args->input;
+  register       float* dest = args->output;
+  register       size_t size = args->size;
+
+  const size_t max_vlen = 16 / sizeof(float);
+
+  size_t i = 0;
+  if (args->latency) {
+    uint32x4_t  dep = vdupq_n_u32(args->dep_mask);
+    float32x4_t y   = vdupq_n_f32(0.0f);
+
+    for (; i + max_vlen <= size; i += max_vlen) {
+      uint32x4_t x = vorrq_u32(vreinterpretq_u32_f32(vld1q_f32(&src[i])),
+                               vandq_u32(vreinterpretq_u32_f32(y), dep));
+      y = fn(vreinterpretq_f32_u32(x));
+      vst1q_f32(&dest[i], y);
+    }
+  } else {
+    for (; i + max_vlen <= size; i += max_vlen) {
+      vst1q_f32(&dest[i], fn(vld1q_f32(&src[i])));
+    }
+  }
+
+  if (i < size) {
+    size_t rem = size - i;
+    float  buf[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    memcpy(buf, &src[i], rem * sizeof(float));
+    vst1q_f32(buf, fn(vld1q_f32(buf)));
+    memcpy(&dest[i], buf, rem * sizeof(float));
+  }
+}
+
+void* impl_neon(void* args)
+{
+  args_t* parsed_args = (args_t*)args;
+
+  switch (parsed_args->func) {
+  case FUNC_LOG: map_f32(vlog_f32, parsed_args); break;
+  case FUNC_EXP: map_f32(vexp_f32, parsed_args); break;
+  default      : break;
+  }
+
+  /* Done */
+  return NULL;
+}
+#endif
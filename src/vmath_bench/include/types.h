@@ -0,0 +1,41 @@
+/* types.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * This file contains all required types decalartions.
+*/
+
+#ifndef __INCLUDE_TYPES_H_
+#define __INCLUDE_TYPES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Functions under test */
+typedef enum {
+  FUNC_LOG,
+  FUNC_EXP,
+  FUNC_NUM
+} func_t;
+
+typedef struct {
+  const float* input;
+  float*       output;
+
+  size_t       size;      /* Elements */
+  func_t       func;
+
+  /* Latency mode: every call's input depends on the previous result,
+   * through an OR with (result & dep_mask); dep_mask is 0 at runtime */
+  bool         latency;
+  uint32_t     dep_mask;
+
+  int          cpu;
+  int          nthreads;
+
+  struct pool_t* pool;
+} args_t;
+
+#endif //__INCLUDE_TYPES_H_
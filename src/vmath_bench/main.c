@@ -0,0 +1,421 @@
+/* main.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Microbenchmark for the transcendental functions of common/vmath.h. One
+ * case per function (log, exp) and working-set size; the input covers the
+ * function's whole float domain, sampled evenly in bit pattern so that
+ * every binade gets the same share of elements. The 'ref' array holds the
+ * correctly rounded result, and each implementation is reported with its
+ * time and cycles per element and a histogram of its error in ULPs. The
+ * file also adds a guard word at the end of the output array to check for
+ * buffer overruns.
+ *
+ * Implementations are the scalar libm baseline, glibc's libmvec and,
+ * where the host can run them, every ISA x precision tier combination of
+ * vmath.h. --latency chains every call on the previous result, so the
+ * time per element becomes the latency of one call divided by its lanes.
+ */
+
+/* Standard C includes  */
+/*  -> Standard Library */
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+/*  -> Types            */
+#include <stdbool.h>
+#include <inttypes.h>
+
+/* Include all implementations declarations */
+#include "impl/ref.h"
+#include "impl/libm.h"
+#include "impl/vec.h"
+
+/* Include common headers */
+#include "common/types.h"
+#include "common/macros.h"
+#include "common/cpu.h"
+#include "common/driver.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+
+/* Working sets: L1, L2 and LLC resident (input + output) */
+const char* SIZES_DEFAULT = "4096,65536,1048576";
+#define MAX_SIZES 16
+
+/* ULP histogram buckets: 0, 1, 2, 3, 4-7, 8-15, 16-255, 256+ */
+#define ULP_BUCKETS 8
+static const int64_t ulp_bucket_lo[ULP_BUCKETS] = { 0, 1, 2, 3, 4, 8, 16, 256 };
+static const char*   ulp_bucket_name[ULP_BUCKETS] = {
+  "0", "1", "2", "3", "4-7", "8-15", "16-255", "256+"
+};
+
+/* Functions, and the domain each one is sampled over */
+static const struct {
+  const char* name;
+  float       lo;       /* Smallest magnitude; normal, as subnormal  *
+                         * inputs take microcode assists           */
+  float       hi;       /* Largest magnitude                         */
+  bool        neg;      /* Half of the elements mirror to -lo .. -hi */
+} funcs[FUNC_NUM] = {
+  [FUNC_LOG] = { "log", 1.17549435e-38f, 3.40282347e+38f, false },
+  [FUNC_EXP] = { "exp", 1.17549435e-38f, 87.3365402f    , true  },
+};
+
+/* Benchmark state */
+typedef struct {
+  size_t   sizes[MAX_SIZES];
+  int      nsizes;
+  int      max_ulp;
+  int      func;          /* Only this function, or -1 for all */
+  bool     latency;
+
+  /* Current case */
+  size_t   size;
+  int      cur_func;
+  char     label[32];
+
+  float*   src;
+  float*   ref;
+  float*   dest;
+
+  /* Error of the last verified output */
+  int64_t  err_max;
+  double   err_mean;
+  float    err_at;
+  size_t   err_hist[ULP_BUCKETS];
+
+  args_t   args;
+} vmath_bench_t;
+
+/* Distance in ULPs: map floats onto a monotonic integer line */
+static int64_t float_ord(float f)
+{
+  int32_t i;
+
+  memcpy(&i, &f, sizeof(i));
+
+  return (i < 0) ? (int64_t)INT32_MIN - i : i;
+}
+
+static float float_from_bits(uint32_t u)
+{
+  float f;
+
+  memcpy(&f, &u, sizeof(f));
+
+  return f;
+}
+
+static uint32_t float_bits(float f)
+{
+  uint32_t u;
+
+  memcpy(&u, &f, sizeof(u));
+
+  return u;
+}
+
+/* Cases are functions x sizes, sizes innermost */
+static int vmath_bench_func(const vmath_bench_t* b, int idx)
+{
+  return (b->func >= 0) ? b->func : idx / b->nsizes;
+}
+
+static int parse_sizes(const char* spec, size_t* sizes, int max_sizes)
+{
+  int n = 0;
+  const char* p = spec;
+
+  while (*p != '\0' && n < max_sizes) {
+    char* next;
+    size_t x = strtoull(p, &next, 10);
+    if (next == p || x == 0) return -1;
+    sizes[n++] = x;
+    if (*next != ',' && *next != '\0') return -1;
+    p = (*next == ',') ? next + 1 : next;
+  }
+
+  return n;
+}
+
+static int vmath_bench_parse_arg(void* ctx, int argc, char** argv, int i)
+{
+  vmath_bench_t* b = (vmath_bench_t*)ctx;
+
+  /* Elements per function: one size or a comma separated list */
+  if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--size") == 0 ||
+      strcmp(argv[i], "--sizes") == 0) {
+    assert (++i < argc);
+    b->nsizes = parse_sizes(argv[i], b->sizes, MAX_SIZES);
+    if (b->nsizes <= 0) {
+      printf("\n");
+      printf("ERROR: Invalid size list \"%s\".\n", argv[i]);
+      return -1;
+    }
+
+    return 2;
+  }
+
+  if (strcmp(argv[i], "--latency") == 0) {
+    b->latency = true;
+
+    return 1;
+  }
+
+  if (strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--func") == 0) {
+    assert (++i < argc);
+    b->func = -1;
+    for (int f = 0; f < FUNC_NUM; f++) {
+      if (strcmp(argv[i], funcs[f].name) == 0) b->func = f;
+    }
+    if (b->func < 0 && strcmp(argv[i], "all") != 0) {
+      printf("\n");
+      printf("ERROR: Unknown \"%s\" function.\n", argv[i]);
+      return -1;
+    }
+
+    return 2;
+  }
+
+  if (strcmp(argv[i], "--max-ulp") == 0) {
+    assert (++i < argc);
+    b->max_ulp = atoi(argv[i]);
+
+    return 2;
+  }
+
+  return 0;
+}
+
+static void vmath_bench_usage(void* ctx)
+{
+  vmath_bench_t* b = (vmath_bench_t*)ctx;
+
+  printf("    -s | --sizes     Elements per case, a list \"4096,65536\" (default = %s)\n", SIZES_DEFAULT);
+  printf("    -f | --func      Function = {log, exp, all} (default = all)\n");
+  printf("         --latency   Chain each call on the previous result\n");
+  printf("         --max-ulp   Largest error that still verifies (default = %d)\n", b->max_ulp);
+}
+
+static int vmath_bench_ncases(void* ctx)
+{
+  vmath_bench_t* b = (vmath_bench_t*)ctx;
+
+  return ((b->func >= 0) ? 1 : FUNC_NUM) * b->nsizes;
+}
+
+static bool vmath_bench_setup(void* ctx, int idx, const driver_env_t* env,
+                              driver_case_t* c)
+{
+  vmath_bench_t* b = (vmath_bench_t*)ctx;
+  int    f    = vmath_bench_func(b, idx);
+  size_t size = b->sizes[idx % b->nsizes];
+
+  b->size     = size;
+  b->cur_func = f;
+  snprintf(b->label, sizeof(b->label), "%s_%zu", funcs[f].name, size);
+
+  /* Allocation */
+  b->src   = __ALLOC_DATA(float, size + 0);
+  b->ref   = __ALLOC_DATA(float, size + 1);
+  b->dest  = __ALLOC_DATA(float, size + 1);
+
+  /* Setting a guards, which is 0xdeadcafe.
+     The guard should not change or be touched. */
+  __SET_GUARD(b->ref , size * sizeof(float));
+  __SET_GUARD(b->dest, size * sizeof(float));
+
+  /* Evenly spaced bit patterns between lo and hi, mirrored if negative */
+  size_t   half  = funcs[f].neg ? size / 2 : 0;
+  size_t   npos  = size - half;
+  uint32_t lo    = float_bits(funcs[f].lo);
+  uint32_t hi    = float_bits(funcs[f].hi);
+
+  for (size_t i = 0; i < npos; i++) {
+    uint32_t u = lo + (uint32_t)(((uint64_t)(hi - lo) * i) / (npos > 1 ? npos - 1 : 1));
+    b->src[i] = float_from_bits(u);
+  }
+  for (size_t i = 0; i < half; i++) {
+    b->src[npos + i] = -b->src[npos - 1 - (i * npos) / half];
+  }
+
+  /* Generate ref data */
+  args_t args_ref;
+
+  args_ref.input    = b->src;
+  args_ref.output   = b->ref;
+  args_ref.size     = size;
+  args_ref.func     = (func_t)f;
+  args_ref.latency  = false;
+  args_ref.dep_mask = 0;
+
+  args_ref.cpu      = env->cpu;
+  args_ref.nthreads = env->nthreads;
+  args_ref.pool     = env->pool;
+
+  /* Running the reference function */
+  impl_ref(&args_ref);
+
+  /* Arguments for the requested implementation */
+  b->args         = args_ref;
+  b->args.output  = b->dest;
+  b->args.latency = b->latency;
+
+  c->args  = &b->args;
+  c->label = b->label;
+  c->flops = 0;
+  c->bytes = 2.0 * size * sizeof(float);   /* One input and one output */
+  c->elems = (double)size;
+
+  return true;
+}
+
+static driver_check_t vmath_bench_verify(void* ctx, int idx)
+{
+  vmath_bench_t* b = (vmath_bench_t*)ctx;
+  driver_check_t check = { 0 };
+
+  int64_t err_max = 0;
+  double  err_sum = 0.0;
+  float   err_at  = 0.0f;
+
+  memset(b->err_hist, 0, sizeof(b->err_hist));
+
+  for (size_t i = 0; i < b->size; i++) {
+    int64_t d = llabs(float_ord(b->dest[i]) - float_ord(b->ref[i]));
+
+    /* NaN is never within any number of ULPs */
+    if (isnan(b->dest[i]) != isnan(b->ref[i])) d = INT32_MAX;
+
+    int k = ULP_BUCKETS - 1;
+    while (d < ulp_bucket_lo[k]) k--;
+    b->err_hist[k]++;
+
+    err_sum += (double)d;
+    if (d > err_max) {
+      err_max = d;
+      err_at  = b->src[i];
+    }
+  }
+
+  b->err_max  = err_max;
+  b->err_mean = (b->size > 0) ? err_sum / b->size : 0.0;
+  b->err_at   = err_at;
+
+  check.match = (err_max <= b->max_ulp);
+  check.guard = __CHECK_GUARD(b->dest, b->size * sizeof(float));
+
+  return check;
+}
+
+static void vmath_bench_report(void* ctx, int idx)
+{
+  vmath_bench_t* b = (vmath_bench_t*)ctx;
+
+  printf("  * Error vs. correctly rounded: max = %" PRId64 " ULP (at %g), mean = %.4f ULP\n",
+         b->err_max, b->err_at, b->err_mean);
+
+  printf("  * ULP histogram:\n");
+  for (int k = 0; k < ULP_BUCKETS; k++) {
+    if (b->err_hist[k] == 0) continue;
+    printf("    - %-6s = %10zu (%8.4f%%)\n", ulp_bucket_name[k], b->err_hist[k],
+           100.0 * b->err_hist[k] / b->size);
+  }
+}
+
+static void vmath_bench_dump(void* ctx, int idx, FILE* fp)
+{
+  vmath_bench_t* b = (vmath_bench_t*)ctx;
+
+  fprintf(fp, "\nfunc,%s\nsize,%zu\nlatency,%d\nmax_ulp,%" PRId64 "\nmean_ulp,%.6f",
+          funcs[b->cur_func].name, b->size, b->latency, b->err_max, b->err_mean);
+
+  fprintf(fp, "\nulp_buckets");
+  for (int k = 0; k < ULP_BUCKETS; k++) fprintf(fp, ", %s", ulp_bucket_name[k]);
+  fprintf(fp, "\nulp_hist");
+  for (int k = 0; k < ULP_BUCKETS; k++) fprintf(fp, ", %zu", b->err_hist[k]);
+}
+
+static void vmath_bench_reset(void* ctx, int idx)
+{
+  vmath_bench_t* b = (vmath_bench_t*)ctx;
+
+  /* Clear the output, leaving the guard intact */
+  memset(b->dest, 0, b->size * sizeof(float));
+}
+
+static void vmath_bench_teardown(void* ctx, int idx)
+{
+  vmath_bench_t* b = (vmath_bench_t*)ctx;
+
+  /* Manage memory */
+  __FREE_DATA(b->src);
+  __FREE_DATA(b->dest);
+  __FREE_DATA(b->ref);
+}
+
+int main(int argc, char** argv)
+{
+  vmath_bench_t ctx;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.nsizes  = parse_sizes(SIZES_DEFAULT, ctx.sizes, MAX_SIZES);
+  ctx.max_ulp = 4;
+  ctx.func    = -1;
+
+  /* Only what this host can execute */
+  driver_impl_t impls[DRIVER_MAX_IMPLS];
+  int           nimpls = 0;
+
+  impls[nimpls++] = (driver_impl_t){ "libm"       , "libm"       , impl_libm        };
+#if defined(__amd64__) || defined(__x86_64__)
+  if (cpu_has_isa(CPU_ISA_AVX2)) {
+    impls[nimpls++] = (driver_impl_t){ "libmvec_avx2"  , "libmvec_avx2"  , impl_libmvec_avx2   };
+  }
+  if (cpu_has_isa(CPU_ISA_AVX512)) {
+    impls[nimpls++] = (driver_impl_t){ "libmvec_avx512", "libmvec_avx512", impl_libmvec_avx512 };
+  }
+  if (cpu_has_isa(CPU_ISA_AVX2)) {
+    impls[nimpls++] = (driver_impl_t){ "avx2"       , "avx2"       , impl_avx2        };
+    impls[nimpls++] = (driver_impl_t){ "avx2_fast"  , "avx2_fast"  , impl_avx2_fast   };
+  }
+  if (cpu_has_isa(CPU_ISA_AVX512)) {
+    impls[nimpls++] = (driver_impl_t){ "avx512"     , "avx512"     , impl_avx512      };
+    impls[nimpls++] = (driver_impl_t){ "avx512_fast", "avx512_fast", impl_avx512_fast };
+  }
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+  if (cpu_has_isa(CPU_ISA_NEON)) {
+    impls[nimpls++] = (driver_impl_t){ "neon"       , "neon"       , impl_neon        };
+  }
+#endif
+
+  driver_bench_t bench = {
+    .name         = "vmath_bench",
+    .impls        = impls,
+    .nimpls       = nimpls,
+
+    .nruns        = 100,
+    .ninner       = 1,
+    .nwarmup      = 2,
+
+    .ctx          = &ctx,
+
+    .parse_arg    = vmath_bench_parse_arg,
+    .usage        = vmath_bench_usage,
+    .ncases       = vmath_bench_ncases,
+    .setup        = vmath_bench_setup,
+    .verify       = vmath_bench_verify,
+    .report       = vmath_bench_report,
+    .reset        = vmath_bench_reset,
+    .dump         = vmath_bench_dump,
+    .teardown     = vmath_bench_teardown,
+    .set_nthreads = NULL,
+  };
+
+  return driver_main(&bench, argc, argv);
+}
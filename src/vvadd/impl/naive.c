@@ -15,25 +15,33 @@
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "include/kernel.h"
 
 /* Naive Implementation */
 #pragma GCC push_options
 #pragma GCC optimize ("O1")
-__attribute__ ((optimize(1)))
-void* impl_scalar_naive(void* args)
+VVADD_INLINE void naive_kernel(kernel_t k, args_t* parsed_args)
 {
-  /* Get the argument struct */
-  args_t* parsed_args = (args_t*)args;
-
   /* Get all the arguments */
   register       int*   dest = (      int*)(parsed_args->output);
   register const int*   src0 = (const int*)(parsed_args->input0);
   register const int*   src1 = (const int*)(parsed_args->input1);
+  register const int*   src2 = (const int*)(parsed_args->input2);
+  register       int    s    =              parsed_args->scalar;
   register       size_t size =              parsed_args->size / 4;
 
   for (register int i = 0; i < size; i++) {
-    dest[i] = src0[i] + src1[i];
+    dest[i] = vvadd_elem(k, src0, src1, src2, s, i);
   }
+}
+
+__attribute__ ((optimize(1)))
+void* impl_scalar_naive(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  VVADD_SPECIALIZE(parsed_args->kernel, naive_kernel, parsed_args);
 
   /* Done */
   return NULL;
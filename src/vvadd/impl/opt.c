@@ -15,51 +15,70 @@
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "include/kernel.h"
+#include "impl/opt.h"
+
+/* Unroll factor (tunable parameter); one of 1, 2, 4, 8 or 16 */
+int opt_unroll = 8;
 
 /* Alternative Implementation */
 #pragma GCC push_options
 #pragma GCC optimize ("O1")
-__attribute__ ((optimize(1)))
-void* impl_scalar_opt(void* args)
-{
-  /* Get the argument struct */
-  args_t* parsed_args = (args_t*)args;
 
+/* Element j of the current block, and blocks of 2, 4, 8 and 16 of them */
+#define OPT_ELEM(j) dest[i + (j)] = vvadd_elem(k, src0, src1, src2, s, i + (j))
+#define OPT_X2(j)   OPT_ELEM(j); OPT_ELEM((j) + 1)
+#define OPT_X4(j)   OPT_X2(j);   OPT_X2((j) + 2)
+#define OPT_X8(j)   OPT_X4(j);   OPT_X4((j) + 4)
+#define OPT_X16(j)  OPT_X8(j);   OPT_X8((j) + 8)
+
+VVADD_INLINE void opt_kernel(kernel_t k, size_t u, args_t* parsed_args)
+{
   /* Get all the arguments */
   register       int*   dest = (      int*)(parsed_args->output);
   register const int*   src0 = (const int*)(parsed_args->input0);
   register const int*   src1 = (const int*)(parsed_args->input1);
+  register const int*   src2 = (const int*)(parsed_args->input2);
+  register       int    s    =              parsed_args->scalar;
   register       size_t size =              parsed_args->size / 4;
 
-  register       size_t sz_8 = size / 8;
+  register       size_t i    = 0;
 
-  switch (size % 8) {
-    case 7:  *(dest++) = *(src0++) + *(src1++);
-    case 6:  *(dest++) = *(src0++) + *(src1++);
-    case 5:  *(dest++) = *(src0++) + *(src1++);
-    case 4:  *(dest++) = *(src0++) + *(src1++);
-    case 3:  *(dest++) = *(src0++) + *(src1++);
-    case 2:  *(dest++) = *(src0++) + *(src1++);
-    case 1:  *(dest++) = *(src0++) + *(src1++);
-    case 0:  break;
+  /* The remainder first, then blocks of u */
+  for (; i < size % u; i++) {
+    OPT_ELEM(0);
   }
 
+  for (; i < size; i += u) {
+    switch (u) {
+      case 16: OPT_X16(0); break;
+      case  8: OPT_X8 (0); break;
+      case  4: OPT_X4 (0); break;
+      case  2: OPT_X2 (0); break;
+      default: OPT_ELEM(0); break;
+    }
+  }
+}
 
-  while (sz_8 > 0) {
-    dest[0] = src0[0] + src1[0];
-    dest[1] = src0[1] + src1[1];
-    dest[2] = src0[2] + src1[2];
-    dest[3] = src0[3] + src1[3];
-    dest[4] = src0[4] + src1[4];
-    dest[5] = src0[5] + src1[5];
-    dest[6] = src0[6] + src1[6];
-    dest[7] = src0[7] + src1[7];
+/* opt_kernel with the unroll factor as a constant */
+VVADD_INLINE void opt_kernel_x1 (kernel_t k, args_t* a) { opt_kernel(k,  1, a); }
+VVADD_INLINE void opt_kernel_x2 (kernel_t k, args_t* a) { opt_kernel(k,  2, a); }
+VVADD_INLINE void opt_kernel_x4 (kernel_t k, args_t* a) { opt_kernel(k,  4, a); }
+VVADD_INLINE void opt_kernel_x8 (kernel_t k, args_t* a) { opt_kernel(k,  8, a); }
+VVADD_INLINE void opt_kernel_x16(kernel_t k, args_t* a) { opt_kernel(k, 16, a); }
 
-    dest += 8;
-    src0 += 8;
-    src1 += 8;
+__attribute__ ((optimize(1)))
+void* impl_scalar_opt(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
 
-    --sz_8;
+  switch (opt_unroll) {
+    case 1 : VVADD_SPECIALIZE(parsed_args->kernel, opt_kernel_x1 , parsed_args); break;
+    case 2 : VVADD_SPECIALIZE(parsed_args->kernel, opt_kernel_x2 , parsed_args); break;
+    case 4 : VVADD_SPECIALIZE(parsed_args->kernel, opt_kernel_x4 , parsed_args); break;
+    case 16: VVADD_SPECIALIZE(parsed_args->kernel, opt_kernel_x16, parsed_args); break;
+    default: VVADD_SPECIALIZE(parsed_args->kernel, opt_kernel_x8 , parsed_args); break;
   }
 
   /* Done */
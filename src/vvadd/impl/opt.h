@@ -9,6 +9,9 @@
 #ifndef __IMPL_OPT_H_
 #define __IMPL_OPT_H_
 
+/* Unroll factor of the scalar loop; a runtime tunable (common/tune.h) */
+extern int opt_unroll;
+
 /* Function declaration */
 void* impl_scalar_opt(void* args);
 
@@ -10,24 +10,24 @@
 
 /* Standard C includes */
 #include <stdlib.h>
-#include <pthread.h>
-#include <sched.h>
-#include <assert.h>
 
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
-
-/* If we are on Darwin, include the compatibility header */
-#if defined(__APPLE__)
-#include "common/mach_pthread_compatibility.h"
-#endif
+#include "common/pool.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "impl/vec.h"
+#include "impl/para.h"
+
+/* Chunk boundaries fall on whole cache lines so no two threads share a
+ * line of dest and every chunk starts vector (and stream) aligned */
+#define VVADD_CHUNK_ALIGN (64 / sizeof(int))
 
 /* Alternative Implementation */
-void* worker(void* args) {
+static void worker(int tid, int nthreads, void* args)
+{
   /* Parse the arguments structure */
   args_t *p_args = (args_t*)args;
 
@@ -35,13 +35,28 @@ void* worker(void* args) {
   register       int*   dest = (      int*)(p_args->output);
   register const int*   src0 = (const int*)(p_args->input0);
   register const int*   src1 = (const int*)(p_args->input1);
-  register       size_t size =              p_args->size;
+  register const int*   src2 = (const int*)(p_args->input2);
+  register       size_t size =              p_args->size / 4;
 
-  for (int i = 0; i < size; i++) {
-    dest[i] = src0[i] + src1[i];
-  }
+  /* Our portion of the work */
+  size_t begin, end;
+  pool_partition(size, VVADD_CHUNK_ALIGN, tid, nthreads, &begin, &end);
 
-  return NULL;
+  if (begin == end) return;
+
+  /* Run the dispatched vector kernel on our chunk; the last chunk takes
+   * whatever does not fill a cache line through the kernel's tail */
+  args_t chunk = *p_args;
+
+  chunk.output = (byte*)&dest[begin];
+  chunk.input0 = (byte*)&src0[begin];
+  chunk.size   = (end - begin) * sizeof(int);
+
+  /* Inputs the kernel does not read may be NULL */
+  if (src1 != NULL) chunk.input1 = (byte*)&src1[begin];
+  if (src2 != NULL) chunk.input2 = (byte*)&src2[begin];
+
+  impl_vector(&chunk);
 }
 
 void* impl_parallel(void* args)
@@ -49,75 +64,18 @@ void* impl_parallel(void* args)
   /* Get the argument struct */
   args_t* p_args = (args_t*)args;
 
-  /* Get all the arguments */
-  register       int*   dest = (      int*)(p_args->output);
-  register const int*   src0 = (const int*)(p_args->input0);
-  register const int*   src1 = (const int*)(p_args->input1);
-  register       size_t size =              p_args->size / 4;
+  /* Decide on streaming from the whole working set, not per chunk */
+  args_t shared = *p_args;
+  shared.store  = vvadd_use_stream(p_args) ? STORE_STREAM : STORE_TEMPORAL;
 
-  register       size_t nthreads = p_args->nthreads;
-  register       size_t cpu      = p_args->cpu;
-
-  /* Create all threads */
-  pthread_t tid[nthreads];
-  args_t    targs[nthreads];
-  cpu_set_t cpuset[nthreads];
-
-  /* Amount of work per thread */
-  size_t size_per_thread = size / nthreads;
-  size_t remaining = size % nthreads;
-
-  for (int i = 0; i < nthreads; i++) {
-    /* Initialize the argument structure */
-    targs[i].size     = size_per_thread;
-    targs[i].output   = (byte*)dest;
-    targs[i].input0   = (byte*)src0;
-    targs[i].input1   = (byte*)src1;
-
-    dest += targs[i].size;
-    src0 += targs[i].size;
-    src1 += targs[i].size;
-
-    targs[i].cpu      = (cpu + i) % nthreads;
-    targs[i].nthreads = nthreads;
-
-    /* Affinity */
-    CPU_ZERO(&(cpuset[i]));
-    CPU_SET(targs[i].cpu, &(cpuset[i]));
-
-    /* Set affinity */
-    if (i == 0) {
-      tid[i] = pthread_self();
-    } else {
-      int __attribute__((unused)) res = \
-                         pthread_create(&tid[i], NULL, worker, (void*)&targs[i]);
-    }
-
-    int __attribute__((unused)) res_affinity = pthread_setaffinity_np(tid[i],
-                                                sizeof(cpuset[i]), &(cpuset[i]));
-  }
-
-  if (nthreads > 0) {
-    /* Perform one portion of the work */
-    for (int i = 0; i < targs[0].size; i++) {
-      ((int*)targs[0].output)[i] =                            \
-                          ((const int*)targs[0].input0)[i] +  \
-                              ((const int*)targs[0].input1)[i];
-    }
-
-    /* Perform trailing elements */
-    for (int i = size - remaining; i < size; i++) {
-      ((int*)targs[0].output)[i] =                            \
-                          ((const int*)targs[0].input0)[i] +  \
-                              ((const int*)targs[0].input1)[i];
-    }
-  }
-
-  /* Wait for all threads to finish execution */
-  for (int i = 0; i < nthreads; i++) {
-    pthread_join(tid[i], NULL);
-  }
+  /* Dispatch into the worker pool */
+  pool_run(p_args->pool, p_args->nthreads, worker, &shared);
 
   /* Done */
   return NULL;
 }
+
+void* impl_parallel_passes(void* args)
+{
+  return vvadd_passes(args, impl_parallel);
+}
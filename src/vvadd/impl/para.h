@@ -12,4 +12,7 @@
 /* Function declaration */
 void* impl_parallel(void* args);
 
+/* impl_parallel over each pass of vvadd_passes (impl/vec.h) */
+void* impl_parallel_passes(void* args);
+
 #endif //__IMPL_PARA_H_
@@ -19,20 +19,31 @@
 /* Include application-specific headers */
 #include "include/types.h"
 
-/* Reference Implementation */
+/* Reference Implementation; written out per kernel rather than through
+ * include/kernel.h, so it checks the specialization as well */
 void* impl_ref(void* args)
 {
   /* Get the argument struct */
   args_t* parsed_args = (args_t*) args;
 
   /* Get all the arguments */
-  register       int*   dest = (      int*)(parsed_args->output);
-  register const int*   src0 = (const int*)(parsed_args->input0);
-  register const int*   src1 = (const int*)(parsed_args->input1);
-  register       size_t size =              parsed_args->size / 4;
-
-  for (register int i = 0; i < size; i++) {
-    dest[i] = src0[i] + src1[i];
+  register       unsigned* dest = (      unsigned*)(parsed_args->output);
+  register const unsigned* src0 = (const unsigned*)(parsed_args->input0);
+  register const unsigned* src1 = (const unsigned*)(parsed_args->input1);
+  register const unsigned* src2 = (const unsigned*)(parsed_args->input2);
+  register       unsigned  s    = (      unsigned )(parsed_args->scalar);
+  register       size_t    size =                   parsed_args->size / 4;
+
+  for (register size_t i = 0; i < size; i++) {
+    switch (parsed_args->kernel) {
+    case KERNEL_COPY : dest[i] = src0[i];                       break;
+    case KERNEL_SCALE: dest[i] = s * src0[i];                   break;
+    case KERNEL_ADD  : dest[i] = src0[i] + src1[i];             break;
+    case KERNEL_MUL  : dest[i] = src0[i] * src1[i];             break;
+    case KERNEL_TRIAD: dest[i] = src0[i] + s * src1[i];         break;
+    case KERNEL_CHAIN: dest[i] = (src0[i] + src1[i]) * src2[i]; break;
+    default          :                                          break;
+    }
   }
 
   /* Done */
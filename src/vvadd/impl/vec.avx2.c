@@ -0,0 +1,135 @@
+/* vec.avx2.c
+ *
+ * Author:
+ * Date  :
+ *
+ *  Description
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <stdint.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Prefetch distance for the streaming loop, in elements (1 KiB) */
+#define VVADD_PREFETCH_DIST (1024 / sizeof(int))
+
+/* Sliding window for the epilogue mask: &tail_mask[8 - rem] has rem
+ * leading all-ones lanes */
+static const int tail_mask[16] = { -1, -1, -1, -1, -1, -1, -1, -1,
+                                    0,  0,  0,  0,  0,  0,  0,  0 };
+
+VVADD_INLINE __m256i op256(kernel_t k, __m256i a, __m256i b, __m256i c,
+                           __m256i vs)
+{
+  switch (k) {
+  case KERNEL_COPY : return a;
+  case KERNEL_SCALE: return _mm256_mullo_epi32(vs, a);
+  case KERNEL_ADD  : return _mm256_add_epi32(a, b);
+  case KERNEL_MUL  : return _mm256_mullo_epi32(a, b);
+  case KERNEL_TRIAD: return _mm256_add_epi32(a, _mm256_mullo_epi32(vs, b));
+  case KERNEL_CHAIN: return _mm256_mullo_epi32(_mm256_add_epi32(a, b), c);
+  default          : return a;
+  }
+}
+
+/* Elements i .. i + 7, reading only the inputs k uses */
+VVADD_INLINE __m256i full256(kernel_t k, const int* src0, const int* src1,
+                             const int* src2, __m256i vs, size_t i)
+{
+  __m256i z = _mm256_setzero_si256();
+  __m256i a = _mm256_loadu_si256((const __m256i*)&src0[i]);
+  __m256i b = (vvadd_nsrc(k) > 1) ? _mm256_loadu_si256((const __m256i*)&src1[i]) : z;
+  __m256i c = (vvadd_nsrc(k) > 2) ? _mm256_loadu_si256((const __m256i*)&src2[i]) : z;
+
+  return op256(k, a, b, c, vs);
+}
+
+/* ... under the lane mask vm */
+VVADD_INLINE __m256i elems256(kernel_t k, const int* src0, const int* src1,
+                              const int* src2, __m256i vs, __m256i vm,
+                              size_t i)
+{
+  __m256i z = _mm256_setzero_si256();
+  __m256i a = _mm256_maskload_epi32(&src0[i], vm);
+  __m256i b = (vvadd_nsrc(k) > 1) ? _mm256_maskload_epi32(&src1[i], vm) : z;
+  __m256i c = (vvadd_nsrc(k) > 2) ? _mm256_maskload_epi32(&src2[i], vm) : z;
+
+  return op256(k, a, b, c, vs);
+}
+
+/* AVX2 variant; the main loop is unmasked and the tail is a single
+ * masked iteration. Above the LLC size (see vvadd_use_stream) dest is
+ * written with non-temporal stores, which need 32-byte alignment, so a
+ * short scalar head aligns it first. */
+VVADD_INLINE void avx2_kernel(kernel_t k, args_t* parsed_args)
+{
+  /* Get all the arguments */
+  register       int*   dest = (      int*)(parsed_args->output);
+  register const int*   src0 = (const int*)(parsed_args->input0);
+  register const int*   src1 = (const int*)(parsed_args->input1);
+  register const int*   src2 = (const int*)(parsed_args->input2);
+  register       int    s    =              parsed_args->scalar;
+  register       size_t size =              parsed_args->size / 4;
+
+  const __m256i vs       = _mm256_set1_epi32(s);
+  const size_t  max_vlen = 32 / sizeof(int);
+
+  register size_t i = 0;
+
+  if (vvadd_use_stream(parsed_args)) {
+    for (; i < size && ((uintptr_t)&dest[i] & 31) != 0; i++) {
+      dest[i] = vvadd_elem(k, src0, src1, src2, s, i);
+    }
+
+    for (; i + max_vlen <= size; i += max_vlen) {
+      _mm_prefetch((const char*)&src0[i + VVADD_PREFETCH_DIST], _MM_HINT_T0);
+      if (vvadd_nsrc(k) > 1) {
+        _mm_prefetch((const char*)&src1[i + VVADD_PREFETCH_DIST], _MM_HINT_T0);
+      }
+      if (vvadd_nsrc(k) > 2) {
+        _mm_prefetch((const char*)&src2[i + VVADD_PREFETCH_DIST], _MM_HINT_T0);
+      }
+
+      _mm256_stream_si256((__m256i*)&dest[i], full256(k, src0, src1, src2, vs, i));
+    }
+
+    /* Order the streamed lines before anyone reads dest */
+    _mm_sfence();
+  } else {
+    for (; i + max_vlen <= size; i += max_vlen) {
+      _mm256_storeu_si256((__m256i*)&dest[i], full256(k, src0, src1, src2, vs, i));
+    }
+  }
+
+  if (i < size) {
+    __m256i vm = _mm256_loadu_si256((const __m256i*)&tail_mask[max_vlen - (size - i)]);
+
+    _mm256_maskstore_epi32(&dest[i], vm, elems256(k, src0, src1, src2, vs, vm, i));
+  }
+}
+
+void* impl_vector_avx2(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  VVADD_SPECIALIZE(parsed_args->kernel, avx2_kernel, parsed_args);
+
+  /* Done */
+  return NULL;
+}
+#endif
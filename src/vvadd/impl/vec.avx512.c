@@ -0,0 +1,139 @@
+/* vec.avx512.c
+ *
+ * Author:
+ * Date  :
+ *
+ *  Description
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <stdint.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Prefetch distance for the streaming loop, in elements (1 KiB) */
+#define VVADD_PREFETCH_DIST (1024 / sizeof(int))
+
+VVADD_INLINE __m512i op512(kernel_t k, __m512i a, __m512i b, __m512i c,
+                           __m512i vs)
+{
+  switch (k) {
+  case KERNEL_COPY : return a;
+  case KERNEL_SCALE: return _mm512_mullo_epi32(vs, a);
+  case KERNEL_ADD  : return _mm512_add_epi32(a, b);
+  case KERNEL_MUL  : return _mm512_mullo_epi32(a, b);
+  case KERNEL_TRIAD: return _mm512_add_epi32(a, _mm512_mullo_epi32(vs, b));
+  case KERNEL_CHAIN: return _mm512_mullo_epi32(_mm512_add_epi32(a, b), c);
+  default          : return a;
+  }
+}
+
+/* Elements i .. i + 15 under vm, reading only the inputs k uses */
+VVADD_INLINE __m512i elems512(kernel_t k, const int* src0, const int* src1,
+                              const int* src2, __m512i vs, __mmask16 vm,
+                              size_t i)
+{
+  __m512i z = _mm512_setzero_si512();
+  __m512i a = _mm512_maskz_loadu_epi32(vm, &src0[i]);
+  __m512i b = (vvadd_nsrc(k) > 1) ? _mm512_maskz_loadu_epi32(vm, &src1[i]) : z;
+  __m512i c = (vvadd_nsrc(k) > 2) ? _mm512_maskz_loadu_epi32(vm, &src2[i]) : z;
+
+  return op512(k, a, b, c, vs);
+}
+
+/* ... and all sixteen */
+VVADD_INLINE __m512i full512(kernel_t k, const int* src0, const int* src1,
+                             const int* src2, __m512i vs, size_t i)
+{
+  __m512i z = _mm512_setzero_si512();
+  __m512i a = _mm512_loadu_si512(&src0[i]);
+  __m512i b = (vvadd_nsrc(k) > 1) ? _mm512_loadu_si512(&src1[i]) : z;
+  __m512i c = (vvadd_nsrc(k) > 2) ? _mm512_loadu_si512(&src2[i]) : z;
+
+  return op512(k, a, b, c, vs);
+}
+
+/* AVX-512 variant; the tail is a single masked iteration. Above the LLC
+ * size dest is aligned with a masked head and written with non-temporal
+ * stores (see vec.avx2.c). */
+VVADD_INLINE void avx512_kernel(kernel_t k, args_t* parsed_args)
+{
+  /* Get all the arguments */
+  register       int*   dest = (      int*)(parsed_args->output);
+  register const int*   src0 = (const int*)(parsed_args->input0);
+  register const int*   src1 = (const int*)(parsed_args->input1);
+  register const int*   src2 = (const int*)(parsed_args->input2);
+  register       size_t size =              parsed_args->size / 4;
+
+  const __m512i vs       = _mm512_set1_epi32(parsed_args->scalar);
+  const size_t  max_vlen = 64 / sizeof(int);
+
+  register size_t i = 0;
+
+  if (vvadd_use_stream(parsed_args)) {
+    /* Masked head up to the first 64-byte boundary of dest */
+    size_t head = ((64 - ((uintptr_t)dest & 63)) & 63) / sizeof(int);
+    if (head > size) head = size;
+    if (head > 0) {
+      __mmask16 vm = (__mmask16)((1u << head) - 1);
+
+      _mm512_mask_storeu_epi32(&dest[0], vm,
+                               elems512(k, src0, src1, src2, vs, vm, 0));
+      i = head;
+    }
+
+    for (; i + max_vlen <= size; i += max_vlen) {
+      _mm_prefetch((const char*)&src0[i + VVADD_PREFETCH_DIST], _MM_HINT_T0);
+      if (vvadd_nsrc(k) > 1) {
+        _mm_prefetch((const char*)&src1[i + VVADD_PREFETCH_DIST], _MM_HINT_T0);
+      }
+      if (vvadd_nsrc(k) > 2) {
+        _mm_prefetch((const char*)&src2[i + VVADD_PREFETCH_DIST], _MM_HINT_T0);
+      }
+
+      _mm512_stream_si512((__m512i*)&dest[i],
+                          full512(k, src0, src1, src2, vs, i));
+    }
+
+    /* Order the streamed lines before anyone reads dest */
+    _mm_sfence();
+  } else {
+    for (; i + max_vlen <= size; i += max_vlen) {
+      __m512i res = full512(k, src0, src1, src2, vs, i);  /* Load and compute */
+
+      _mm512_storeu_si512(&dest[i], res);                 /* Store output     */
+    }
+  }
+
+  if (i < size) {
+    __mmask16 vm = (__mmask16)((1u << (size - i)) - 1);
+
+    _mm512_mask_storeu_epi32(&dest[i], vm,
+                             elems512(k, src0, src1, src2, vs, vm, i));
+  }
+}
+
+void* impl_vector_avx512(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  VVADD_SPECIALIZE(parsed_args->kernel, avx512_kernel, parsed_args);
+
+  /* Done */
+  return NULL;
+}
+#endif
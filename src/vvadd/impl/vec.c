@@ -8,64 +8,130 @@
 
 /* Standard C includes  */
 #include <stdlib.h>
-#include <math.h>
-/*  -> SIMD header file  */
-#if defined(__amd64__) || defined(__x86_64__)
-#include <immintrin.h>
-#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
-#include <arm_neon.h>
-#endif
 
 /* Include common headers */
 #include "common/macros.h"
 #include "common/types.h"
-#include "common/vmath.h"
+#include "common/cpu.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
 
-/* Alternative Implementation */
-void* impl_vector(void* args)
-{
+/* Variants, widest first */
+static const cpu_variant_t variants[] = {
 #if defined(__amd64__) || defined(__x86_64__)
-  /* Get the argument struct */
-  args_t* parsed_args = (args_t*)args;
+  { CPU_ISA_AVX512, impl_vector_avx512 },
+  { CPU_ISA_AVX2  , impl_vector_avx2   },
+  { CPU_ISA_SSE42 , impl_vector_sse42  },
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+  { CPU_ISA_SVE   , impl_vector_sve    },
+  { CPU_ISA_NEON  , impl_vector_neon   },
+#endif
+  { CPU_ISA_SCALAR, impl_vector_scalar },
+};
+
+static cpu_dispatch_t dispatch = CPU_DISPATCH_INIT(variants);
 
+/* Baseline variant for hosts without a usable SIMD extension */
+VVADD_INLINE void scalar_kernel(kernel_t k, args_t* parsed_args)
+{
   /* Get all the arguments */
   register       int*   dest = (      int*)(parsed_args->output);
   register const int*   src0 = (const int*)(parsed_args->input0);
   register const int*   src1 = (const int*)(parsed_args->input1);
+  register const int*   src2 = (const int*)(parsed_args->input2);
+  register       int    s    =              parsed_args->scalar;
   register       size_t size =              parsed_args->size / 4;
 
-  __m256i vm = _mm256_set1_epi32(0x80000000);
-  const int max_vlen = 32 / sizeof(int);
+  for (register size_t i = 0; i < size; i++) {
+    dest[i] = vvadd_elem(k, src0, src1, src2, s, i);
+  }
+}
+
+void* impl_vector_scalar(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  VVADD_SPECIALIZE(parsed_args->kernel, scalar_kernel, parsed_args);
+
+  /* Done */
+  return NULL;
+}
+
+/* Streaming only pays off once the inputs the kernel reads and dest no
+ * longer fit in the last-level cache; below that, write-allocate keeps
+ * dest hot for the next run */
+bool vvadd_use_stream(const void* args)
+{
+  const args_t* parsed_args = (const args_t*)args;
+
+  switch (parsed_args->store) {
+  case STORE_TEMPORAL: return false;
+  case STORE_STREAM  : return true;
+  default            : break;
+  }
+
+  size_t streams = (size_t)vvadd_nsrc(parsed_args->kernel) + 1;
 
-  for (register size_t hw_vlen, i = 0; i < size; i += hw_vlen) {
+  return streams * parsed_args->size > cpu_cache_bytes(3);
+}
+
+/* Alternative Implementation */
+void* impl_vector(void* args)
+{
+  return cpu_dispatch(&dispatch)(args);
+}
 
-    register int rem = size - i;
-    hw_vlen = rem < max_vlen ? rem : max_vlen;        /* num of elems      */
-    if (hw_vlen < max_vlen) {
-      unsigned int m[max_vlen];
-      for (size_t j = 0; j < max_vlen; j++)
-        m[j] = (j < hw_vlen) ? 0x80000000 : 0x00000000;
-      vm = _mm256_setr_epi32(m[0], m[1], m[2], m[3],
-                             m[4], m[5], m[6], m[7]);
-    }
+/* One pass of the single-operation kernel k over args, from a and b
+ * into dest */
+static void vvadd_pass(args_t* args, void* (*fn)(void*), kernel_t k,
+                       byte* dest, byte* a, byte* b)
+{
+  args_t pass = *args;
 
-    __m256i vec0 = _mm256_maskload_epi32(src0, vm);   /* Load vectors from */
-    __m256i vec1 = _mm256_maskload_epi32(src1, vm);   /* src0 and src1     */
+  pass.kernel = k;
+  pass.output = dest;
+  pass.input0 = a;
+  pass.input1 = b;
+  pass.input2 = NULL;
 
-    __m256i res  = _mm256_add_epi32(vec0, vec1);      /* Do the compute    */
+  fn(&pass);
+}
 
-    _mm256_maskstore_epi32(dest, vm, res);            /* Store output      */
+void* vvadd_passes(void* args, void* (*fn)(void*))
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
 
-    src0 += hw_vlen;                                  /* -\                */
-    src1 += hw_vlen;                                  /*   |-> ptr arith   */
-    dest += hw_vlen;                                  /* -/                */
+  switch (parsed_args->kernel) {
+  case KERNEL_TRIAD:
+    /* temp = s * src1; dest = src0 + temp */
+    vvadd_pass(parsed_args, fn, KERNEL_SCALE, parsed_args->temp,
+               parsed_args->input1, NULL);
+    vvadd_pass(parsed_args, fn, KERNEL_ADD  , parsed_args->output,
+               parsed_args->input0, parsed_args->temp);
+    break;
+  case KERNEL_CHAIN:
+    /* temp = src0 + src1; dest = temp * src2 */
+    vvadd_pass(parsed_args, fn, KERNEL_ADD  , parsed_args->temp,
+               parsed_args->input0, parsed_args->input1);
+    vvadd_pass(parsed_args, fn, KERNEL_MUL  , parsed_args->output,
+               parsed_args->temp, parsed_args->input2);
+    break;
+  default:
+    /* Already a single pass */
+    fn(parsed_args);
+    break;
   }
 
   /* Done */
   return NULL;
-#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
-#endif
+}
+
+void* impl_vector_passes(void* args)
+{
+  return vvadd_passes(args, impl_vector);
 }
@@ -1,15 +1,37 @@
-/* opt.h
+/* vec.h
  *
  * Author: Khalid Al-Hawaj
  * Date  : 13 Nov. 2023
  *
- * Header for scalar optimized function.
+ * Header for vectorized function. impl_vector dispatches at runtime to
+ * the widest variant the host supports (see common/cpu.h); the variants
+ * live in vec.<isa>.c.
  */
 
 #ifndef __IMPL_VEC_H_
 #define __IMPL_VEC_H_
 
+#include <stdbool.h>
+
 /* Function declaration */
 void* impl_vector(void* args);
 
+/* Per-ISA variants */
+void* impl_vector_scalar(void* args);
+void* impl_vector_sse42 (void* args);
+void* impl_vector_avx2  (void* args);
+void* impl_vector_avx512(void* args);
+void* impl_vector_neon  (void* args);
+void* impl_vector_sve   (void* args);
+
+/* The fused kernels as separate single-operation passes through
+ * args->temp, each pass run by fn; kernels that already are a single
+ * operation run as is */
+void* vvadd_passes(void* args, void* (*fn)(void* args));
+
+void* impl_vector_passes(void* args);
+
+/* True if the variants should use non-temporal stores for this call */
+bool  vvadd_use_stream(const void* args);
+
 #endif //__IMPL_VEC_H_
@@ -0,0 +1,80 @@
+/* vec.neon.c
+ *
+ * Author:
+ * Date  :
+ *
+ *  Description
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+/*  -> SIMD header file  */
+#if defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+#include <arm_neon.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
+
+#if defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+VVADD_INLINE int32x4_t op_neon(kernel_t k, int32x4_t a, int32x4_t b,
+                               int32x4_t c, int32x4_t vs)
+{
+  switch (k) {
+  case KERNEL_COPY : return a;
+  case KERNEL_SCALE: return vmulq_s32(vs, a);
+  case KERNEL_ADD  : return vaddq_s32(a, b);
+  case KERNEL_MUL  : return vmulq_s32(a, b);
+  case KERNEL_TRIAD: return vmlaq_s32(a, vs, b);
+  case KERNEL_CHAIN: return vmulq_s32(vaddq_s32(a, b), c);
+  default          : return a;
+  }
+}
+
+/* NEON variant; the tail is scalar */
+VVADD_INLINE void neon_kernel(kernel_t k, args_t* parsed_args)
+{
+  /* Get all the arguments */
+  register       int*   dest = (      int*)(parsed_args->output);
+  register const int*   src0 = (const int*)(parsed_args->input0);
+  register const int*   src1 = (const int*)(parsed_args->input1);
+  register const int*   src2 = (const int*)(parsed_args->input2);
+  register       int    s    =              parsed_args->scalar;
+  register       size_t size =              parsed_args->size / 4;
+
+  const int32x4_t vs       = vdupq_n_s32(s);
+  const int32x4_t z        = vdupq_n_s32(0);
+  const size_t    max_vlen = 16 / sizeof(int);
+
+  register size_t i = 0;
+
+  for (; i + max_vlen <= size; i += max_vlen) {
+    int32x4_t vec0 = vld1q_s32(&src0[i]);
+    int32x4_t vec1 = (vvadd_nsrc(k) > 1) ? vld1q_s32(&src1[i]) : z;
+    int32x4_t vec2 = (vvadd_nsrc(k) > 2) ? vld1q_s32(&src2[i]) : z;
+
+    vst1q_s32(&dest[i], op_neon(k, vec0, vec1, vec2, vs));
+  }
+
+  for (; i < size; i++) {
+    dest[i] = vvadd_elem(k, src0, src1, src2, s, i);
+  }
+}
+
+void* impl_vector_neon(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  VVADD_SPECIALIZE(parsed_args->kernel, neon_kernel, parsed_args);
+
+  /* Done */
+  return NULL;
+}
+#endif
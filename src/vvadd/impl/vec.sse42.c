@@ -0,0 +1,114 @@
+/* vec.sse42.c
+ *
+ * Author:
+ * Date  :
+ *
+ *  Description
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <stdint.h>
+/*  -> SIMD header file  */
+#if defined(__amd64__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
+
+#if defined(__amd64__) || defined(__x86_64__)
+/* Prefetch distance for the streaming loop, in elements (1 KiB) */
+#define VVADD_PREFETCH_DIST (1024 / sizeof(int))
+
+VVADD_INLINE __m128i op128(kernel_t k, __m128i a, __m128i b, __m128i c,
+                           __m128i vs)
+{
+  switch (k) {
+  case KERNEL_COPY : return a;
+  case KERNEL_SCALE: return _mm_mullo_epi32(vs, a);
+  case KERNEL_ADD  : return _mm_add_epi32(a, b);
+  case KERNEL_MUL  : return _mm_mullo_epi32(a, b);
+  case KERNEL_TRIAD: return _mm_add_epi32(a, _mm_mullo_epi32(vs, b));
+  case KERNEL_CHAIN: return _mm_mullo_epi32(_mm_add_epi32(a, b), c);
+  default          : return a;
+  }
+}
+
+/* Elements i .. i + 3, reading only the inputs k uses */
+VVADD_INLINE __m128i full128(kernel_t k, const int* src0, const int* src1,
+                             const int* src2, __m128i vs, size_t i)
+{
+  __m128i z = _mm_setzero_si128();
+  __m128i a = _mm_loadu_si128((const __m128i*)&src0[i]);
+  __m128i b = (vvadd_nsrc(k) > 1) ? _mm_loadu_si128((const __m128i*)&src1[i]) : z;
+  __m128i c = (vvadd_nsrc(k) > 2) ? _mm_loadu_si128((const __m128i*)&src2[i]) : z;
+
+  return op128(k, a, b, c, vs);
+}
+
+/* SSE4.2 variant; SSE has no masked loads, so the tail is scalar. Above
+ * the LLC size dest is aligned with a scalar head and written with
+ * non-temporal stores (see vec.avx2.c). */
+VVADD_INLINE void sse42_kernel(kernel_t k, args_t* parsed_args)
+{
+  /* Get all the arguments */
+  register       int*   dest = (      int*)(parsed_args->output);
+  register const int*   src0 = (const int*)(parsed_args->input0);
+  register const int*   src1 = (const int*)(parsed_args->input1);
+  register const int*   src2 = (const int*)(parsed_args->input2);
+  register       int    s    =              parsed_args->scalar;
+  register       size_t size =              parsed_args->size / 4;
+
+  const __m128i vs       = _mm_set1_epi32(s);
+  const size_t  max_vlen = 16 / sizeof(int);
+
+  register size_t i = 0;
+
+  if (vvadd_use_stream(parsed_args)) {
+    for (; i < size && ((uintptr_t)&dest[i] & 15) != 0; i++) {
+      dest[i] = vvadd_elem(k, src0, src1, src2, s, i);
+    }
+
+    for (; i + max_vlen <= size; i += max_vlen) {
+      _mm_prefetch((const char*)&src0[i + VVADD_PREFETCH_DIST], _MM_HINT_T0);
+      if (vvadd_nsrc(k) > 1) {
+        _mm_prefetch((const char*)&src1[i + VVADD_PREFETCH_DIST], _MM_HINT_T0);
+      }
+      if (vvadd_nsrc(k) > 2) {
+        _mm_prefetch((const char*)&src2[i + VVADD_PREFETCH_DIST], _MM_HINT_T0);
+      }
+
+      _mm_stream_si128((__m128i*)&dest[i], full128(k, src0, src1, src2, vs, i));
+    }
+
+    /* Order the streamed lines before anyone reads dest */
+    _mm_sfence();
+  } else {
+    for (; i + max_vlen <= size; i += max_vlen) {
+      _mm_storeu_si128((__m128i*)&dest[i], full128(k, src0, src1, src2, vs, i));
+    }
+  }
+
+  for (; i < size; i++) {
+    dest[i] = vvadd_elem(k, src0, src1, src2, s, i);
+  }
+}
+
+void* impl_vector_sse42(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  VVADD_SPECIALIZE(parsed_args->kernel, sse42_kernel, parsed_args);
+
+  /* Done */
+  return NULL;
+}
+#endif
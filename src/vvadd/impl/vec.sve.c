@@ -0,0 +1,88 @@
+/* vec.sve.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * SVE variant: vector-length agnostic, with the tail as one more
+ * predicated iteration instead of a scalar loop. Without an SVE
+ * toolchain (Darwin) it forwards to the NEON variant; cpu_has_isa()
+ * never picks it there.
+ */
+
+/* Standard C includes  */
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+/*  -> SIMD header file  */
+#if defined(__ARM_FEATURE_SVE)
+#include <arm_sve.h>
+#endif
+
+/* Include common headers */
+#include "common/macros.h"
+#include "common/types.h"
+
+/* Include application-specific headers */
+#include "include/types.h"
+#include "include/kernel.h"
+#include "impl/vec.h"
+
+#if defined(__ARM_FEATURE_SVE)
+VVADD_INLINE svint32_t op_sve(kernel_t k, svbool_t pg, svint32_t a,
+                              svint32_t b, svint32_t c, int s)
+{
+  switch (k) {
+  case KERNEL_COPY : return a;
+  case KERNEL_SCALE: return svmul_n_s32_x(pg, a, s);
+  case KERNEL_ADD  : return svadd_s32_x(pg, a, b);
+  case KERNEL_MUL  : return svmul_s32_x(pg, a, b);
+  case KERNEL_TRIAD: return svmla_n_s32_x(pg, a, b, s);
+  case KERNEL_CHAIN: return svmul_s32_x(pg, svadd_s32_x(pg, a, b), c);
+  default          : return a;
+  }
+}
+
+/* One vector of svcntw() elements per iteration; the last is partial */
+VVADD_INLINE void sve_kernel(kernel_t k, args_t* parsed_args)
+{
+  /* Get all the arguments */
+  register       int*   dest = (      int*)(parsed_args->output);
+  register const int*   src0 = (const int*)(parsed_args->input0);
+  register const int*   src1 = (const int*)(parsed_args->input1);
+  register const int*   src2 = (const int*)(parsed_args->input2);
+  register       int    s    =              parsed_args->scalar;
+  register       size_t size =              parsed_args->size / 4;
+
+  const bool      stream = vvadd_use_stream(parsed_args);
+  const size_t    vlen   = svcntw();
+  const svint32_t z      = svdup_n_s32(0);
+
+  for (size_t i = 0; i < size; i += vlen) {
+    svbool_t  pg   = svwhilelt_b32_u64(i, size);
+    svint32_t vec0 = svld1_s32(pg, &src0[i]);
+    svint32_t vec1 = (vvadd_nsrc(k) > 1) ? svld1_s32(pg, &src1[i]) : z;
+    svint32_t vec2 = (vvadd_nsrc(k) > 2) ? svld1_s32(pg, &src2[i]) : z;
+    svint32_t res  = op_sve(k, pg, vec0, vec1, vec2, s);
+
+    /* Non-temporal stores above the LLC, as the x86 variants */
+    if (stream) svstnt1_s32(pg, &dest[i], res);
+    else        svst1_s32  (pg, &dest[i], res);
+  }
+}
+
+void* impl_vector_sve(void* args)
+{
+  /* Get the argument struct */
+  args_t* parsed_args = (args_t*)args;
+
+  VVADD_SPECIALIZE(parsed_args->kernel, sve_kernel, parsed_args);
+
+  /* Done */
+  return NULL;
+}
+#elif defined(__aarch__) || defined(__aarch64__) || defined(__arm64__)
+void* impl_vector_sve(void* args)
+{
+  return impl_vector_neon(args);
+}
+#endif
@@ -0,0 +1,79 @@
+/* kernel.h
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * The STREAM-style kernels of vvadd. Every variant writes its loop once,
+ * as an always-inline function of the kernel, and VVADD_SPECIALIZE calls
+ * it with each kernel_t as a constant; the compiler then folds the
+ * per-element switch away, leaving one plain loop per kernel. Loads of
+ * inputs a kernel does not read are folded away with it, so those inputs
+ * may be NULL.
+ *
+ * The fused kernels (triad, chain) also decompose into passes of
+ * single-operation kernels through a temporary (vvadd_passes(),
+ * impl/vec.h), to compare one pass over memory against several.
+*/
+
+#ifndef __INCLUDE_KERNEL_H_
+#define __INCLUDE_KERNEL_H_
+
+#include <stddef.h>
+
+#include "include/types.h"
+
+#define VVADD_INLINE static inline __attribute__((always_inline))
+
+/* STREAM's scalar is 3 */
+#define VVADD_SCALAR 3
+
+/* Call fn(KERNEL_x, ...) for the kernel k */
+#define VVADD_SPECIALIZE(k, fn, ...)                         \
+  switch (k) {                                               \
+  case KERNEL_COPY : fn(KERNEL_COPY , __VA_ARGS__); break;   \
+  case KERNEL_SCALE: fn(KERNEL_SCALE, __VA_ARGS__); break;   \
+  case KERNEL_ADD  : fn(KERNEL_ADD  , __VA_ARGS__); break;   \
+  case KERNEL_MUL  : fn(KERNEL_MUL  , __VA_ARGS__); break;   \
+  case KERNEL_TRIAD: fn(KERNEL_TRIAD, __VA_ARGS__); break;   \
+  case KERNEL_CHAIN: fn(KERNEL_CHAIN, __VA_ARGS__); break;   \
+  default          : break;                                  \
+  }
+
+/* Inputs each kernel reads */
+VVADD_INLINE int vvadd_nsrc(kernel_t k)
+{
+  switch (k) {
+  case KERNEL_COPY : return 1;
+  case KERNEL_SCALE: return 1;
+  case KERNEL_CHAIN: return 3;
+  default          : return 2;
+  }
+}
+
+/* One element; arithmetic wraps, like the vector instructions */
+VVADD_INLINE int vvadd_op(kernel_t k, int a, int b, int c, int s)
+{
+  unsigned ua = a, ub = b, uc = c, us = s;
+
+  switch (k) {
+  case KERNEL_COPY : return (int)(ua);
+  case KERNEL_SCALE: return (int)(us * ua);
+  case KERNEL_ADD  : return (int)(ua + ub);
+  case KERNEL_MUL  : return (int)(ua * ub);
+  case KERNEL_TRIAD: return (int)(ua + us * ub);
+  case KERNEL_CHAIN: return (int)((ua + ub) * uc);
+  default          : return 0;
+  }
+}
+
+/* Element i, reading only the inputs k uses */
+VVADD_INLINE int vvadd_elem(kernel_t k, const int* src0, const int* src1,
+                            const int* src2, int s, size_t i)
+{
+  int b = (vvadd_nsrc(k) > 1) ? src1[i] : 0;
+  int c = (vvadd_nsrc(k) > 2) ? src2[i] : 0;
+
+  return vvadd_op(k, src0[i], b, c, s);
+}
+
+#endif //__INCLUDE_KERNEL_H_
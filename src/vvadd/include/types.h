@@ -9,15 +9,43 @@
 #ifndef __INCLUDE_TYPES_H_
 #define __INCLUDE_TYPES_H_
 
+/* Output store policy for the vector kernels */
+typedef enum {
+  STORE_AUTO     = 0,    /* Stream when the working set exceeds the LLC */
+  STORE_TEMPORAL    ,    /* Regular (write-allocate) stores             */
+  STORE_STREAM      ,    /* Non-temporal stores                         */
+} store_t;
+
+/* Kernels (include/kernel.h); every element is an int, arithmetic wraps */
+typedef enum {
+  KERNEL_COPY  = 0,    /* output = input0                     */
+  KERNEL_SCALE    ,    /* output = s * input0                 */
+  KERNEL_ADD      ,    /* output = input0 + input1            */
+  KERNEL_MUL      ,    /* output = input0 * input1            */
+  KERNEL_TRIAD    ,    /* output = input0 + s * input1        */
+  KERNEL_CHAIN    ,    /* output = (input0 + input1) * input2 */
+  KERNEL_NUM      ,
+} kernel_t;
+
 typedef struct {
   byte*   input0;
-  byte*   input1;
+  byte*   input1;      /* Unless the kernel reads one input        */
+  byte*   input2;      /* KERNEL_CHAIN only                        */
   byte*   output;
 
+  /* Intermediate of the *_passes implementations, size bytes */
+  byte*   temp;
+
   size_t size;
 
+  kernel_t kernel;
+  int      scalar;     /* s                                        */
+  store_t  store;
+
   int     cpu;
   int     nthreads;
+
+  struct pool_t* pool;
 } args_t;
 
 #endif //__INCLUDE_TYPES_H_
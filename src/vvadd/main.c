@@ -13,34 +13,26 @@
  * the functionality. The file also adds a guard word at the end of the
  * output arrays to check for buffer overruns.
  *
- * The file will invoke each implementation n number of times. It will
- * record the runtime of _each_ invocation through the following Linux
- * API:
- *    clock_gettime(), with the clk_id set to CLOCK_MONOTONIC
- * Then, the file will calculate the standard deviation and calculate
- * an outlier-free average by excluding runtimes that are larger than
- * 2 standard deviation of the original average.
+ * Besides the plain add (the default), -k selects the other STREAM-style
+ * kernels: copy, scale, mul, and the fused triad (src0 + s * src1) and
+ * chain ((src0 + src1) * src2). The *_passes implementations run the
+ * fused ones as separate single-operation passes through a temporary,
+ * to show what fusing saves in memory traffic.
+ *
+ * Option parsing, scheduling, timing, statistics and the CSV dump are
+ * handled by the shared driver (common/driver.h); this file only owns
+ * the data.
  */
 
-/* Set features         */
-#define _GNU_SOURCE
-
 /* Standard C includes  */
 /*  -> Standard Library */
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
 #include <string.h>
-/*  -> Scheduling       */
-#include <sched.h>
 /*  -> Types            */
 #include <stdbool.h>
 #include <inttypes.h>
-/*  -> Runtimes         */
-#include <time.h>
-#include <unistd.h>
-#include <errno.h>
 
 /* Include all implementations declarations */
 #include "impl/ref.h"
@@ -52,382 +44,309 @@
 /* Include common headers */
 #include "common/types.h"
 #include "common/macros.h"
+#include "common/driver.h"
 
 /* Include application-specific headers */
 #include "include/types.h"
+#include "include/kernel.h"
 
 const int SIZE_DATA = 4 * 1024 * 1024;
 
-int main(int argc, char** argv)
-{
-  /* Set the buffer for printf to NULL */
-  setbuf(stdout, NULL);
-
-  /* Arguments */
-  int nthreads = 1;
-  int cpu      = 0;
-
-  int nruns    = 10000;
-  int nstdevs  = 3;
-
-  /* Data */
-  int data_size = SIZE_DATA;
-
-  /* Parse arguments */
-  /* Function pointers */
-  void* (*impl_scalar_naive_ptr)(void* args) = impl_scalar_naive;
-  void* (*impl_scalar_opt_ptr  )(void* args) = impl_scalar_opt;
-  void* (*impl_vector_ptr      )(void* args) = impl_vector;
-  void* (*impl_parallel_ptr    )(void* args) = impl_parallel;
-
-  /* Chosen */
-  void* (*impl)(void* args) = NULL;
-  const char* impl_str      = NULL;
-
-  bool help = false;
-  for (int i = 1; i < argc; i++) {
-    /* Implementations */
-    if (strcmp(argv[i], "-i") == 0 || strcmp(argv[i], "--impl") == 0) {
-      assert (++i < argc);
-      if (strcmp(argv[i], "naive") == 0) {
-        impl = impl_scalar_naive_ptr; impl_str = "scalar_naive";
-      } else if (strcmp(argv[i], "opt"  ) == 0) {
-        impl = impl_scalar_opt_ptr  ; impl_str = "scalar_opt"  ;
-      } else if (strcmp(argv[i], "vec"  ) == 0) {
-        impl = impl_vector_ptr      ; impl_str = "vectorized"  ;
-      } else if (strcmp(argv[i], "para" ) == 0) {
-        impl = impl_parallel_ptr    ; impl_str = "parallelized";
-      } else {
-        impl = NULL                 ; impl_str = "unknown"     ;
-      }
-
-      continue;
-    }
+/* Benchmark state */
+typedef struct {
+  int    data_size;
+  int    store;
+  int    kernel;                   /* kernel_t, or -1 for all       */
 
-    /* Input/output data size */
-    if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--size") == 0) {
-      assert (++i < argc);
-      data_size = atoi(argv[i]) * sizeof(int);
+  byte*  src0;
+  byte*  src1;
+  byte*  src2;
+  byte*  temp;
+  byte*  ref;
+  byte*  dest;
 
-      continue;
-    }
+  /* Further copies of the inputs, for --cache cold; copy 0 is src0-2 */
+  byte*  copy[DRIVER_CACHE_COPIES][3];
+  int    ncopies;
 
-    /* Run parameterization */
-    if (strcmp(argv[i], "--nruns") == 0) {
-      assert (++i < argc);
-      nruns = atoi(argv[i]);
+  args_t args;
+} vvadd_t;
 
-      continue;
-    }
+static const char* kernel_names[KERNEL_NUM] = {
+  "copy", "scale", "add", "mul", "triad", "chain"
+};
 
-    if (strcmp(argv[i], "--nstdevs") == 0) {
-      assert (++i < argc);
-      nstdevs = atoi(argv[i]);
+/* Integer operations per element */
+static const int kernel_flops[KERNEL_NUM] = { 0, 1, 1, 1, 2, 2 };
 
-      continue;
-    }
+static kernel_t vvadd_kernel(const vvadd_t* b, int idx)
+{
+  return (kernel_t)((b->kernel >= 0) ? b->kernel : idx);
+}
 
-    /* Parallelization */
-    if (strcmp(argv[i], "-n") == 0 || strcmp(argv[i], "--nthreads") == 0) {
-      assert (++i < argc);
-      nthreads = atoi(argv[i]);
+static int vvadd_parse_arg(void* ctx, int argc, char** argv, int i)
+{
+  vvadd_t* b = (vvadd_t*)ctx;
 
-      continue;
-    }
+  /* Input/output data size */
+  if (strcmp(argv[i], "-s") == 0 || strcmp(argv[i], "--size") == 0) {
+    assert (++i < argc);
+    b->data_size = atoi(argv[i]) * sizeof(int);
 
-    if (strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--cpu") == 0) {
-      assert (++i < argc);
-      cpu = atoi(argv[i]);
+    return 2;
+  }
 
-      continue;
+  /* Kernel */
+  if (strcmp(argv[i], "-k") == 0 || strcmp(argv[i], "--kernel") == 0) {
+    assert (++i < argc);
+    b->kernel = -1;
+    for (int k = 0; k < KERNEL_NUM; k++) {
+      if (strcmp(argv[i], kernel_names[k]) == 0) b->kernel = k;
     }
-
-    /* Help */
-    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
-      help = true;
-
-      continue;
+    if (b->kernel < 0 && strcmp(argv[i], "all") != 0) {
+      printf("\n");
+      printf("ERROR: Unknown \"%s\" kernel.\n", argv[i]);
+      return -1;
     }
+
+    return 2;
   }
 
-  if (help || impl == NULL) {
-    if (!help) {
-      if (impl_str != NULL) {
-        printf("\n");
-        printf("ERROR: Unknown \"%s\" implementation.\n", impl_str);
-      } else {
-        printf("\n");
-        printf("ERROR: No implementation was chosen.\n");
-      }
+  /* Output store policy */
+  if (strcmp(argv[i], "--store") == 0) {
+    assert (++i < argc);
+    if      (strcmp(argv[i], "auto"    ) == 0) b->store = STORE_AUTO;
+    else if (strcmp(argv[i], "temporal") == 0) b->store = STORE_TEMPORAL;
+    else if (strcmp(argv[i], "stream"  ) == 0) b->store = STORE_STREAM;
+    else {
+      printf("\n");
+      printf("ERROR: Unknown \"%s\" store policy.\n", argv[i]);
+      return -1;
     }
-    printf("\n");
-    printf("Usage:\n");
-    printf("  %s {-i | --impl} impl_str [Options]\n", argv[0]);
-    printf("  \n");
-    printf("  Required:\n");
-    printf("    -i | --impl      Available implementations = {naive, opt, vec, para}\n");
-    printf("    \n");
-    printf("  Options:\n");
-    printf("    -h | --help      Print this message\n");
-    printf("    -n | --nthreads  Set number of threads available (default = %d)\n", nthreads);
-    printf("    -c | --cpu       Set the main CPU for the program (default = %d)\n", cpu);
-    printf("    -s | --size      Size of input and output data (default = %ld)\n", data_size / sizeof(int));
-    printf("         --nruns     Number of runs to the implementation (default = %d)\n", nruns);
-    printf("         --stdevs    Number of standard deviation to exclude outliers (default = %d)\n", nstdevs);
-    printf("\n");
-
-    exit(help? 0 : 1);
-  }
 
-  /* Set our priority the highest */
-  int nice_level = -20;
-
-  printf("Setting up schedulers and affinity:\n");
-  printf("  * Setting the niceness level:\n");
-  do {
-    errno = 0;
-    printf("      -> trying niceness level = %d\n", nice_level);
-    int __attribute__((unused)) ret = nice(nice_level);
-  } while (errno != 0 && nice_level++);
-
-  printf("    + Process has niceness level = %d\n", nice_level);
-
-  /* If we are on an apple operating system, skip the scheduling  *
-   * routine; Darwin does not support sched_set* system calls ... *
-   *                                                              *
-   * hawajkm: and here I was--thinking that MacOS is POSIX ...    *
-   *          Silly me!                                           */
-#if !defined(__APPLE__)
-  /* Set scheduling to reduce context switching */
-  /*    -> Set scheduling scheme                */
-  printf("  * Setting up FIFO scheduling scheme and high priority ... ");
-  pid_t pid    = 0;
-  int   policy = SCHED_FIFO;
-  struct sched_param param;
-
-  param.sched_priority = sched_get_priority_max(policy);
-  int res = sched_setscheduler(pid, policy, &param);
-  if (res != 0) {
-    printf("Failed\n");
-  } else {
-    printf("Succeeded\n");
+    return 2;
   }
 
-  /*    -> Set affinity                         */
-  printf("  * Setting up scheduling affinity ... ");
-  cpu_set_t cpumask;
+  return 0;
+}
 
-  CPU_ZERO(&cpumask);
-  for (int i = 0; i < nthreads; i++) {
-    CPU_SET((cpu + i) % nthreads, &cpumask);
-  }
+static void vvadd_usage(void* ctx)
+{
+  vvadd_t* b = (vvadd_t*)ctx;
 
-  res = sched_setaffinity(pid, sizeof(cpumask), &cpumask);
+  printf("    -s | --size      Size of input and output data (default = %ld)\n", b->data_size / sizeof(int));
+  printf("    -k | --kernel    copy, scale, add, mul, triad, chain or all (default = add)\n");
+  printf("         --store     Output stores: auto, temporal or stream (default = auto)\n");
+  printf("                     auto streams once the data exceeds the last-level cache\n");
+}
 
-  if (res != 0) {
-    printf("Failed\n");
-  } else {
-    printf("Succeeded\n");
-  }
-#endif
-  printf("\n");
+static int vvadd_ncases(void* ctx)
+{
+  vvadd_t* b = (vvadd_t*)ctx;
 
-  /* Statistics */
-  __DECLARE_STATS(nruns, nstdevs);
+  return (b->kernel >= 0) ? 1 : KERNEL_NUM;
+}
 
-  /* Initialize Rand */
-  srand(0xdeadbeef);
+static bool vvadd_setup(void* ctx, int idx, const driver_env_t* env,
+                        driver_case_t* c)
+{
+  vvadd_t* b = (vvadd_t*)ctx;
+  int data_size = b->data_size;
+
+  kernel_t kernel = vvadd_kernel(b, idx);
+  int      nsrc   = vvadd_nsrc(kernel);
 
   /* Datasets */
   /* Allocation and initialization */
-  byte* src0  = __ALLOC_INIT_DATA(byte, data_size + 0);
-  byte* src1  = __ALLOC_INIT_DATA(byte, data_size + 0);
-  byte* ref   = __ALLOC_INIT_DATA(byte, data_size + 4);
-  byte* dest  = __ALLOC_DATA     (byte, data_size + 4);
+  b->src0  = __ALLOC_INIT_DATA(byte, data_size + 0);
+  b->src1  = (nsrc > 1) ? __ALLOC_INIT_DATA(byte, data_size + 0) : NULL;
+  b->src2  = (nsrc > 2) ? __ALLOC_INIT_DATA(byte, data_size + 0) : NULL;
+  b->temp  = __ALLOC_DATA     (byte, data_size + 0);
+  b->ref   = __ALLOC_INIT_DATA(byte, data_size + 4);
+  b->dest  = __ALLOC_DATA     (byte, data_size + 4);
 
   /* Setting a guards, which is 0xdeadcafe.
      The guard should not change or be touched. */
-  __SET_GUARD(ref , data_size);
-  __SET_GUARD(dest, data_size);
+  __SET_GUARD(b->ref , data_size);
+  __SET_GUARD(b->dest, data_size);
 
   /* Generate ref data */
   /* Arguments for the functions */
   args_t args_ref;
 
   args_ref.size     = data_size;
-  args_ref.input0   = src0;
-  args_ref.input1   = src1;
-  args_ref.output   = ref;
-
-  args_ref.cpu      = cpu;
-  args_ref.nthreads = nthreads;
+  args_ref.kernel   = kernel;
+  args_ref.scalar   = VVADD_SCALAR;
+  args_ref.store    = b->store;
+  args_ref.input0   = b->src0;
+  args_ref.input1   = b->src1;
+  args_ref.input2   = b->src2;
+  args_ref.output   = b->ref;
+  args_ref.temp     = b->temp;
+
+  args_ref.cpu      = env->cpu;
+  args_ref.nthreads = env->nthreads;
+  args_ref.pool     = env->pool;
 
   /* Running the reference function */
   impl_ref(&args_ref);
 
-  /* Execute the requested implementation */
-  /* Arguments for the function */
-  args_t args;
+  /* Arguments for the requested implementation */
+  b->args.size     = data_size;
+  b->args.kernel   = kernel;
+  b->args.scalar   = VVADD_SCALAR;
+  b->args.store    = b->store;
+  b->args.input0   = b->src0;
+  b->args.input1   = b->src1;
+  b->args.input2   = b->src2;
+  b->args.output   = b->dest;
+  b->args.temp     = b->temp;
+
+  b->args.cpu      = env->cpu;
+  b->args.nthreads = env->nthreads;
+  b->args.pool     = env->pool;
+
+  /* Inputs to rotate through, and everything a run touches */
+  b->ncopies    = env->copies;
+  b->copy[0][0] = b->src0;
+  b->copy[0][1] = b->src1;
+  b->copy[0][2] = b->src2;
+
+  for (int k = 1; k < b->ncopies; k++) {
+    for (int s = 0; s < nsrc; s++) {
+      b->copy[k][s] = __ALLOC_DATA(byte, data_size + 0);
+      memcpy(b->copy[k][s], b->copy[0][s], data_size);
+    }
+  }
 
-  args.size     = data_size;
-  args.input0   = src0;
-  args.input1   = src1;
-  args.output   = dest;
+  for (int k = 0; k < b->ncopies; k++) {
+    for (int s = 0; s < nsrc; s++) driver_case_buf(c, b->copy[k][s], data_size, k);
+  }
+  driver_case_buf(c, b->temp, data_size, -1);
+  driver_case_buf(c, b->dest, data_size, -1);
+  c->ncopies = b->ncopies;
 
-  args.cpu      = cpu;
-  args.nthreads = nthreads;
+  c->args  = &b->args;
+  c->label = (vvadd_ncases(b) > 1) ? kernel_names[kernel] : NULL;
+  c->flops = (double)kernel_flops[kernel] * (data_size / sizeof(int));
+  c->bytes = (nsrc + 1.0) * data_size; /* Inputs read and one output */
 
-  /* Start execution */
-  printf("Running \"%s\" implementation:\n", impl_str);
+  return true;
+}
 
-  printf("  * Invoking the implementation %d times .... ", num_runs);
-  for (int i = 0; i < num_runs; i++) {
-    __SET_START_TIME();
-    for (int j = 0; j < 16; j++) {
-      (*impl)(&args);
-    }
-    __SET_END_TIME();
-    runtimes[i] = __CALC_RUNTIME() / 16;
-  }
-  printf("Finished\n");
-
-  /* Verfication */
-  printf("  * Verifying results .... ");
-  bool match = __CHECK_MATCH(ref, dest, data_size);
-  bool guard = __CHECK_GUARD(     dest, data_size);
-  if (match && guard) {
-    printf("Success\n");
-  } else if (!match && guard) {
-    printf("Fail, but no buffer overruns\n");
-  } else if (match && !guard) {
-    printf("Success, but failed buffer overruns check\n");
-  } else if(!match && !guard) {
-    printf("Failed, and failed buffer overruns check\n");
-  }
+static driver_check_t vvadd_verify(void* ctx, int idx)
+{
+  vvadd_t* b = (vvadd_t*)ctx;
+  driver_check_t check = { 0 };
 
-  /* Running analytics */
-  uint64_t min     = -1;
-  uint64_t max     =  0;
-
-  uint64_t avg     =  0;
-  uint64_t avg_n   =  0;
-
-  uint64_t std     =  0;
-  uint64_t std_n   =  0;
-
-  int      n_msked =  0;
-  int      n_stats =  0;
-
-  for (int i = 0; i < num_runs; i++)
-    runtimes_mask[i] = true;
-
-  printf("  * Running statistics:\n");
-  do {
-    n_stats++;
-    printf("    + Starting statistics run number #%d:\n", n_stats);
-    avg_n =  0;
-    avg   =  0;
-
-    /*   -> Calculate min, max, and avg */
-    for (int i = 0; i < num_runs; i++) {
-      if (runtimes_mask[i]) {
-        if (runtimes[i] < min) {
-          min = runtimes[i];
-        }
-        if (runtimes[i] > max) {
-          max = runtimes[i];
-        }
-        avg += runtimes[i];
-        avg_n += 1;
-      }
-    }
-    avg = avg / avg_n;
-
-    /*   -> Calculate standard deviation */
-    std   =  0;
-    std_n =  0;
-
-    for (int i = 0; i < num_runs; i++) {
-      if (runtimes_mask[i]) {
-        std   += ((runtimes[i] - avg) *
-                  (runtimes[i] - avg));
-        std_n += 1;
-      }
-    }
-    std = sqrt(std / std_n);
-
-    /*   -> Calculate outlier-free average (mean) */
-    n_msked = 0;
-    for (int i = 0; i < num_runs; i++) {
-      if (runtimes_mask[i]) {
-        if (runtimes[i] > avg) {
-          if ((runtimes[i] - avg) > (nstd * std)) {
-            runtimes_mask[i] = false;
-            n_msked += 1;
-          }
-        } else {
-          if ((avg - runtimes[i]) > (nstd * std)) {
-            runtimes_mask[i] = false;
-            n_msked += 1;
-          }
-        }
-      }
-    }
+  check.match = __CHECK_MATCH(b->ref, b->dest, b->data_size);
+  check.guard = __CHECK_GUARD(        b->dest, b->data_size);
 
-    printf("      - Standard deviation = %" PRIu64 "\n", std);
-    printf("      - Average = %" PRIu64 "\n", avg);
-    printf("      - Number of active elements = %" PRIu64 "\n", avg_n);
-    printf("      - Number of masked-off = %d\n", n_msked);
-  } while (n_msked > 0);
-  /* Display information */
-  printf("  * Runtimes (%s): ", __PRINT_MATCH(match));
-  printf(" %" PRIu64 " ns\n"  , avg                 );
-
-  /* Dump */
-  printf("  * Dumping runtime informations:\n");
-  FILE * fp;
-  char filename[256];
-  strcpy(filename, impl_str);
-  strcat(filename, "_runtimes.csv");
-  printf("    - Filename: %s\n", filename);
-  printf("    - Opening file .... ");
-  fp = fopen(filename, "w");
-
-  if (fp != NULL) {
-    printf("Succeeded\n");
-    printf("    - Writing runtimes ... ");
-    fprintf(fp, "impl,%s", impl_str);
-
-    fprintf(fp, "\n");
-    fprintf(fp, "num_of_runs,%d", num_runs);
-
-    fprintf(fp, "\n");
-    fprintf(fp, "runtimes");
-    for (int i = 0; i < num_runs; i++) {
-      fprintf(fp, ", ");
-      fprintf(fp, "%" PRIu64 "", runtimes[i]);
-    }
+  return check;
+}
 
-    fprintf(fp, "\n");
-    fprintf(fp, "avg,%" PRIu64 "", avg);
-    printf("Finished\n");
-    printf("    - Closing file handle .... ");
-    fclose(fp);
-    printf("Finished\n");
-  } else {
-    printf("Failed\n");
-  }
-  printf("\n");
+static void vvadd_reset(void* ctx, int idx)
+{
+  vvadd_t* b = (vvadd_t*)ctx;
+
+  /* Clear the output, leaving the guard intact */
+  memset(b->dest, 0, b->data_size);
+}
+
+static void vvadd_set_nthreads(void* ctx, int idx, int nthreads)
+{
+  vvadd_t* b = (vvadd_t*)ctx;
+
+  b->args.nthreads = nthreads;
+}
+
+static void vvadd_rotate(void* ctx, int idx, int copy)
+{
+  vvadd_t* b = (vvadd_t*)ctx;
+
+  b->args.input0 = b->copy[copy][0];
+  b->args.input1 = b->copy[copy][1];
+  b->args.input2 = b->copy[copy][2];
+}
+
+static void vvadd_dump(void* ctx, int idx, FILE* fp)
+{
+  vvadd_t* b = (vvadd_t*)ctx;
+
+  static const char* store_names[] = { "auto", "temporal", "stream" };
+
+  fprintf(fp, "\nkernel,%s\nsize,%zu\nstore,%s", kernel_names[vvadd_kernel(b, idx)],
+          b->data_size / sizeof(int), store_names[b->store]);
+}
+
+static void vvadd_teardown(void* ctx, int idx)
+{
+  vvadd_t* b = (vvadd_t*)ctx;
 
   /* Manage memory */
-  free(src0);
-  free(src1);
-  free(dest);
-  free(ref);
+  for (int k = 1; k < b->ncopies; k++) {
+    for (int s = 0; s < 3; s++) __FREE_DATA(b->copy[k][s]);
+  }
+  memset(b->copy, 0, sizeof(b->copy));
+
+  __FREE_DATA(b->src0);
+  __FREE_DATA(b->src1);
+  __FREE_DATA(b->src2);
+  __FREE_DATA(b->temp);
+  __FREE_DATA(b->dest);
+  __FREE_DATA(b->ref);
+}
 
-  /* Finished with statistics */
-  __DESTROY_STATS();
+static const int opt_unrolls[] = { 1, 2, 4, 8, 16 };
 
-  /* Done */
-  return 0;
+static const tune_param_t tunables[] = {
+  { "opt.unroll", "opt", &opt_unroll, opt_unrolls, 5 },
+};
+
+static const driver_impl_t impls[] = {
+  { "naive", "scalar_naive", impl_scalar_naive },
+  { "opt"  , "scalar_opt"  , impl_scalar_opt   },
+  { "vec"  , "vectorized"  , impl_vector       },
+  { "para" , "parallelized", impl_parallel     },
+
+  /* The fused kernels as one pass per operation */
+  { "vec_passes" , "vectorized_passes"  , impl_vector_passes   },
+  { "para_passes", "parallelized_passes", impl_parallel_passes },
+};
+
+int main(int argc, char** argv)
+{
+  vvadd_t ctx;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.data_size = SIZE_DATA;
+  ctx.kernel    = KERNEL_ADD;
+
+  driver_bench_t bench = {
+    .name         = "vvadd",
+    .impls        = impls,
+    .nimpls       = sizeof(impls) / sizeof(impls[0]),
+
+    .nruns        = 10000,
+    .ninner       = 16,
+    .nwarmup      = 0,
+
+    .tunables     = tunables,
+    .ntunables    = sizeof(tunables) / sizeof(tunables[0]),
+
+    .ctx          = &ctx,
+
+    .parse_arg    = vvadd_parse_arg,
+    .usage        = vvadd_usage,
+    .ncases       = vvadd_ncases,
+    .setup        = vvadd_setup,
+    .verify       = vvadd_verify,
+    .reset        = vvadd_reset,
+    .dump         = vvadd_dump,
+    .teardown     = vvadd_teardown,
+    .set_nthreads = vvadd_set_nthreads,
+    .rotate       = vvadd_rotate,
+  };
+
+  return driver_main(&bench, argc, argv);
 }
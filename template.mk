@@ -9,6 +9,12 @@ $(1)_BUILD_DIR := $$(BUILD_DIR)/$(1)_build
 $(1)_C_FILES := $$(shell find $$($(1)_DIR) -name "*.c")
 $(1)_O_FILES := $$(foreach x,$$($(1)_C_FILES),$$(patsubst $$($(1)_DIR)/%,$$($(1)_BUILD_DIR)/%,$$(x)))
 $(1)_O_FILES := $$(foreach x,$$($(1)_O_FILES),$$(patsubst %.c,%.o,$$(x)))
+
+# Common object files (shared by all benchmarks)
+$(1)_COMMON_C_FILES := $$(shell find $$(SRC_DIR)/common -name "*.c")
+$(1)_COMMON_O_FILES := $$(patsubst $$(SRC_DIR)/common/%.c,$$($(1)_BUILD_DIR)/common/%.o,$$($(1)_COMMON_C_FILES))
+$(1)_O_FILES += $$($(1)_COMMON_O_FILES)
+
 $(1)_D_FILES := $$($(1)_O_FILES:%.o=%.d)
 
 # Include directories
@@ -22,10 +28,17 @@ $(1)_INCLUDES := $$(foreach x,$$($(1)_INCLUDE_DIR),$$(addprefix -I,$$(x)))
 
 $$($(1)_BUILD_DIR)/%.o: $$($(1)_DIR)/%.c | $$($(1)_BUILD_DIR)
 	mkdir -p $$(dir $$@)
-	$$(CC) $$($(1)_INCLUDES) $$(CFLAGS) -MMD -c $$< -o $$@
+	$$(CC) $$($(1)_INCLUDES) $$(CFLAGS) $$(call isa_flags,$$<) -MMD -c $$< -o $$@
+
+$$($(1)_BUILD_DIR)/common/%.o: $$(SRC_DIR)/common/%.c | $$($(1)_BUILD_DIR)
+	mkdir -p $$(dir $$@)
+	$$(CC) $$($(1)_INCLUDES) $$(CFLAGS) $$(call isa_flags,$$<) -MMD -c $$< -o $$@
+
+# The manifest records the build
+$$($(1)_BUILD_DIR)/common/manifest.o: $$(BUILD_INFO)
 
 $$(BUILD_DIR)/$$($(1)_BIN): $$($(1)_O_FILES) | $$($(1)_BUILD_DIR)
-	$$(CC) $$($(1)_O_FILES) $$(IFLAGS) -o $$@
+	$$(CC) $$(LDFLAGS) $$($(1)_O_FILES) $$(IFLAGS) -o $$@
 
 $$($(1)_BUILD_DIR): | $$(BUILD_DIR)
 	mkdir -p $$@
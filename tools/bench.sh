@@ -0,0 +1,157 @@
+#!/bin/sh
+# bench.sh
+#
+# Author: Khalid Al-Hawaj
+# Date  : 14 Oct. 2026
+#
+# Runs the regression suite (make bench): every entry of the suite file
+# (tools/bench.suite), one benchmark process each, with the pinned
+# arguments first and the entry's own after them. Entry <e> leaves its
+# results and log in <results>/<e>/ and its run manifest in
+# <results>/<e>.json, so the results directory holds the manifests of
+# the whole suite side by side. They are then compared against the
+# manifests of the same names in the baseline directory (build/compare
+# base_dir new_dir), into one summary that is also kept as
+# <results>/summary.txt. With -s, the run is stored as the new baseline
+# instead.
+#
+# Exit status: 0 when nothing regressed, 1 when something regressed or
+# failed verification, 2 when an entry did not run or could not be
+# compared.
+
+usage() {
+  cat <<EOF
+Usage:
+  $0 [Options] [-- pinned arguments]
+
+  Options:
+    -h           Print this message
+    -b dir       Directory of the benchmark binaries and compare (default = build)
+    -f file      Suite file (default = tools/bench.suite)
+    -o dir       Results directory (default = <build>/bench)
+    -B dir       Baseline directory (default = bench_baseline)
+    -e pattern   Run only the entries whose name matches the shell pattern
+    -s           Store the run as the new baseline instead of comparing
+EOF
+}
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+
+BUILD=$ROOT/build
+SUITE=$ROOT/tools/bench.suite
+RESULTS=
+BASELINE=$ROOT/bench_baseline
+ONLY='*'
+SAVE=0
+
+while getopts "hb:f:o:B:e:s" opt; do
+  case $opt in
+    h) usage; exit 0 ;;
+    b) BUILD=$OPTARG ;;
+    f) SUITE=$OPTARG ;;
+    o) RESULTS=$OPTARG ;;
+    B) BASELINE=$OPTARG ;;
+    e) ONLY=$OPTARG ;;
+    s) SAVE=1 ;;
+    *) usage; exit 2 ;;
+  esac
+done
+shift $((OPTIND - 1))
+[ "$1" = "--" ] && shift
+
+# What is left is pinned on every entry
+PINNED="$*"
+
+[ -n "$RESULTS" ] || RESULTS=$BUILD/bench
+
+if [ ! -r "$SUITE" ]; then
+  echo "ERROR: Cannot read the suite \"$SUITE\"."
+  exit 2
+fi
+
+if [ ! -x "$BUILD/compare" ]; then
+  echo "ERROR: No $BUILD/compare; build first (make)."
+  exit 2
+fi
+
+mkdir -p "$RESULTS" || exit 2
+
+# Manifests of an earlier run would be compared as if they were new
+rm -f "$RESULTS"/*.json "$RESULTS/summary.txt"
+
+echo "Suite   : $SUITE"
+echo "Results : $RESULTS"
+echo "Pinned  : ${PINNED:-(none)}"
+echo ""
+
+status=0
+nrun=0
+
+while read -r entry bench args; do
+  case $entry in ''|'#'*) continue ;; esac
+  case $entry in $ONLY) ;; *) continue ;; esac
+
+  dir=$RESULTS/$entry
+
+  rm -rf "$dir"
+  mkdir -p "$dir"
+
+  printf "  %-20s %-16s .... " "$entry" "$bench"
+
+  start=$(date +%s)
+
+  if [ ! -x "$BUILD/$bench" ]; then
+    echo "No such benchmark"
+    status=2
+    continue
+  fi
+
+  # shellcheck disable=SC2086
+  "$BUILD/$bench" $PINNED $args --output-dir "$dir" > "$dir/log.txt" 2>&1 < /dev/null
+  ret=$?
+
+  manifest=$(ls "$dir"/*_manifest.json 2>/dev/null | head -n 1)
+
+  if [ $ret -ne 0 ] || [ -z "$manifest" ]; then
+    echo "Failed (exit $ret, see $dir/log.txt)"
+    status=2
+    continue
+  fi
+
+  cp "$manifest" "$RESULTS/$entry.json"
+  nrun=$((nrun + 1))
+
+  echo "Done ($(($(date +%s) - start)) s)"
+done < "$SUITE"
+
+echo ""
+
+if [ $nrun -eq 0 ]; then
+  echo "ERROR: No entry of the suite ran."
+  exit 2
+fi
+
+if [ $SAVE -eq 1 ]; then
+  if [ $status -ne 0 ]; then
+    echo "ERROR: Not every entry ran; the baseline is left as it was."
+    exit $status
+  fi
+
+  mkdir -p "$BASELINE" || exit 2
+  cp "$RESULTS"/*.json "$BASELINE"/
+  echo "Stored $nrun manifest(s) as the baseline in $BASELINE"
+  exit 0
+fi
+
+if [ ! -d "$BASELINE" ]; then
+  echo "No baseline in $BASELINE yet (make bench-baseline stores one)"
+  echo ""
+fi
+
+"$BUILD/compare" "$BASELINE" "$RESULTS" > "$RESULTS/summary.txt"
+ret=$?
+cat "$RESULTS/summary.txt"
+
+[ $ret -gt $status ] && status=$ret
+
+exit $status
@@ -0,0 +1,717 @@
+/* compare.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Compares two run manifests (see src/common/manifest.h): a baseline and
+ * a new run. Results are matched by implementation, case and thread
+ * count; for each pair, the change of the median and the Mann-Whitney U
+ * test over the raw runtimes decide whether the new run is a regression,
+ * an improvement or the same. The two runs must come from the same
+ * machine (--cross-machine overrides that); other differences in the
+ * build or the configuration are reported as warnings.
+ *
+ * Given two directories instead, every manifest of the new one is
+ * compared to the baseline of the same name, as make bench lays them out
+ * (tools/bench.sh), and the whole suite is summarized at the end.
+ *
+ * Exit status: 0 when nothing regressed, 1 when a result regressed or
+ * failed verification, 2 when the manifests could not be compared.
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <math.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/* Include common headers */
+#include "common/stats.h"
+#include "common/manifest.h"
+
+/* Defaults */
+#define COMPARE_THRESHOLD 5.0      /* Percent change of the median */
+#define COMPARE_ALPHA     0.01     /* Significance of the U test   */
+
+/* A parsed JSON value */
+typedef enum {
+  JSON_NULL,
+  JSON_BOOL,
+  JSON_NUM,
+  JSON_STR,
+  JSON_ARR,
+  JSON_OBJ
+} json_kind_t;
+
+typedef struct json {
+  json_kind_t  kind;
+  double       num;              /* Numbers and booleans      */
+  char*        str;              /* Strings                   */
+  struct json* items;            /* Elements or member values */
+  char**       keys;             /* Member names (objects)    */
+  size_t       n;
+} json_t;
+
+typedef struct {
+  const char* p;
+  const char* err;
+} json_parser_t;
+
+static void json_ws(json_parser_t* jp)
+{
+  while (*jp->p == ' ' || *jp->p == '\n' || *jp->p == '\r' || *jp->p == '\t') jp->p++;
+}
+
+static bool json_value(json_parser_t* jp, json_t* v);
+
+static bool json_string(json_parser_t* jp, char** out)
+{
+  size_t cap = 16, len = 0;
+  char*  s   = (char*)malloc(cap);
+
+  jp->p++;                                  /* Opening quote */
+
+  while (*jp->p != '"') {
+    char ch = *jp->p++;
+
+    if (ch == '\0') { free(s); jp->err = "unterminated string"; return false; }
+
+    if (ch == '\\') {
+      ch = *jp->p++;
+      if      (ch == 'n') ch = '\n';
+      else if (ch == 't') ch = '\t';
+      else if (ch == 'r') ch = '\r';
+      else if (ch == 'b') ch = '\b';
+      else if (ch == 'f') ch = '\f';
+      else if (ch == 'u') {
+        /* Only what manifest_str escapes: control characters */
+        unsigned code = 0;
+        if (sscanf(jp->p, "%4x", &code) != 1) {
+          free(s); jp->err = "bad escape"; return false;
+        }
+        jp->p += 4;
+        ch = (code < 0x80) ? (char)code : '?';
+      } else if (ch != '"' && ch != '\\' && ch != '/') {
+        free(s); jp->err = "bad escape"; return false;
+      }
+    }
+
+    if (len + 1 >= cap) s = (char*)realloc(s, cap *= 2);
+    s[len++] = ch;
+  }
+
+  jp->p++;                                  /* Closing quote */
+  s[len] = '\0';
+  *out = s;
+
+  return true;
+}
+
+/* Elements of an array or members of an object, up to close */
+static bool json_items(json_parser_t* jp, json_t* v, char close, bool named)
+{
+  size_t cap = 0;
+
+  jp->p++;
+  json_ws(jp);
+
+  if (*jp->p == close) { jp->p++; return true; }
+
+  for (;;) {
+    if (v->n == cap) {
+      cap = cap ? cap * 2 : 8;
+      v->items = (json_t*)realloc(v->items, cap * sizeof(json_t));
+      if (named) v->keys = (char**)realloc(v->keys, cap * sizeof(char*));
+    }
+
+    if (named) {
+      json_ws(jp);
+      if (*jp->p != '"') { jp->err = "expected a member name"; return false; }
+      if (!json_string(jp, &v->keys[v->n])) return false;
+      json_ws(jp);
+      if (*jp->p != ':') { free(v->keys[v->n]); jp->err = "expected ':'"; return false; }
+      jp->p++;
+    }
+
+    if (!json_value(jp, &v->items[v->n])) {
+      if (named) free(v->keys[v->n]);
+      return false;
+    }
+    v->n++;
+
+    json_ws(jp);
+    if (*jp->p == ',') { jp->p++; continue; }
+    if (*jp->p == close) { jp->p++; return true; }
+
+    jp->err = (close == ']') ? "expected ',' or ']'" : "expected ',' or '}'";
+    return false;
+  }
+}
+
+static bool json_value(json_parser_t* jp, json_t* v)
+{
+  memset(v, 0, sizeof(*v));
+  json_ws(jp);
+
+  switch (*jp->p) {
+    case '{': v->kind = JSON_OBJ; return json_items(jp, v, '}', true );
+    case '[': v->kind = JSON_ARR; return json_items(jp, v, ']', false);
+    case '"': v->kind = JSON_STR; return json_string(jp, &v->str);
+    default : break;
+  }
+
+  if (strncmp(jp->p, "null" , 4) == 0) { jp->p += 4; v->kind = JSON_NULL; return true; }
+  if (strncmp(jp->p, "true" , 4) == 0) { jp->p += 4; v->kind = JSON_BOOL; v->num = 1; return true; }
+  if (strncmp(jp->p, "false", 5) == 0) { jp->p += 5; v->kind = JSON_BOOL; v->num = 0; return true; }
+
+  char* end;
+  v->num  = strtod(jp->p, &end);
+  v->kind = JSON_NUM;
+  if (end == jp->p) { jp->err = "unexpected character"; return false; }
+  jp->p = end;
+
+  return true;
+}
+
+static void json_free(json_t* v)
+{
+  for (size_t i = 0; i < v->n; i++) {
+    json_free(&v->items[i]);
+    if (v->keys != NULL) free(v->keys[i]);
+  }
+  free(v->items);
+  free(v->keys);
+  free(v->str);
+}
+
+/* Member of an object, or NULL */
+static const json_t* json_get(const json_t* v, const char* key)
+{
+  if (v == NULL || v->kind != JSON_OBJ) return NULL;
+
+  for (size_t i = 0; i < v->n; i++) {
+    if (strcmp(v->keys[i], key) == 0) return &v->items[i];
+  }
+
+  return NULL;
+}
+
+static const char* json_str(const json_t* v)
+{
+  return (v != NULL && v->kind == JSON_STR) ? v->str : NULL;
+}
+
+static bool json_equal(const json_t* a, const json_t* b)
+{
+  if (a == NULL || b == NULL) return a == b;
+  if (a->kind != b->kind || a->n != b->n) return false;
+
+  switch (a->kind) {
+    case JSON_NULL: return true;
+    case JSON_BOOL:
+    case JSON_NUM : return a->num == b->num;
+    case JSON_STR : return strcmp(a->str, b->str) == 0;
+    case JSON_ARR :
+      for (size_t i = 0; i < a->n; i++) {
+        if (!json_equal(&a->items[i], &b->items[i])) return false;
+      }
+      return true;
+    case JSON_OBJ :
+      for (size_t i = 0; i < a->n; i++) {
+        if (!json_equal(&a->items[i], json_get(b, a->keys[i]))) return false;
+      }
+      return true;
+  }
+
+  return false;
+}
+
+/* Read and parse a manifest; false after printing why not */
+static bool compare_load(const char* path, json_t* doc)
+{
+  FILE* fp = fopen(path, "rb");
+
+  if (fp == NULL) {
+    printf("ERROR: Cannot open \"%s\".\n", path);
+    return false;
+  }
+
+  fseek(fp, 0, SEEK_END);
+  long size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+
+  char* text = (char*)malloc(size + 1);
+  size_t got = fread(text, 1, size, fp);
+  text[got] = '\0';
+  fclose(fp);
+
+  json_parser_t jp = { text, NULL };
+  bool ok = json_value(&jp, doc);
+
+  if (ok) {
+    json_ws(&jp);
+    if (*jp.p != '\0') { jp.err = "trailing characters"; ok = false; }
+  }
+
+  if (!ok) {
+    printf("ERROR: \"%s\" is not valid JSON: %s at offset %ld.\n", path,
+           jp.err, (long)(jp.p - text));
+  } else {
+    const json_t* schema  = json_get(doc, "schema");
+    const json_t* results = json_get(doc, "results");
+
+    if (schema == NULL || schema->kind != JSON_NUM ||
+        schema->num != MANIFEST_SCHEMA || results == NULL ||
+        results->kind != JSON_ARR) {
+      printf("ERROR: \"%s\" is not a run manifest (schema %d).\n", path,
+             MANIFEST_SCHEMA);
+      ok = false;
+    }
+  }
+
+  free(text);
+  return ok;
+}
+
+/* Warn about a field that differs between the two runs */
+static void compare_field(const json_t* base, const json_t* next,
+                          const char* section, const char* key)
+{
+  const json_t* a = json_get(json_get(base, section), key);
+  const json_t* b = json_get(json_get(next, section), key);
+
+  if (json_equal(a, b)) return;
+
+  printf("WARNING: %s.%s differs: ", section, key);
+  if (json_str(a) != NULL) printf("\"%s\"", json_str(a));
+  else if (a != NULL && a->kind == JSON_NUM) printf("%g", a->num);
+  else printf("-");
+  printf(" vs ");
+  if (json_str(b) != NULL) printf("\"%s\"", json_str(b));
+  else if (b != NULL && b->kind == JSON_NUM) printf("%g", b->num);
+  else printf("-");
+  printf("\n");
+}
+
+/* Dump-hook entries that are outcomes of the run, not its inputs */
+static const char* compare_outcomes[] = {
+  "rel_err", "max_ulp", "mean_ulp", "ulp_hist",
+  "latency_calls", "latency_min", "latency_p50", "latency_p90", "latency_p99",
+  "latency_p99.9", "latency_max", "latency_mean", "latency_timer",
+  "serve_sustained", "serve_consumers", "serve_mean_batch", "serve_requests",
+  "serve_min", "serve_p50", "serve_p90", "serve_p99", "serve_p99.9",
+  "serve_max", "serve_mean",
+  "dist_send", "dist_compute", "dist_gather", "dist_remote_compute",
+  "dist_remote_wait", "dist_bytes_out", "dist_bytes_in"
+};
+
+/* Same dataset: every entry of either dump hook but the outcomes */
+static bool compare_same_dataset(const json_t* a, const json_t* b)
+{
+  const json_t* sides[2] = { a, b };
+
+  if (a == NULL || b == NULL) return a == b;
+
+  for (int s = 0; s < 2; s++) {
+    const json_t* v     = sides[s];
+    const json_t* other = sides[1 - s];
+
+    for (size_t i = 0; v->kind == JSON_OBJ && i < v->n; i++) {
+      bool outcome = false;
+
+      for (size_t k = 0; k < sizeof(compare_outcomes) / sizeof(compare_outcomes[0]); k++) {
+        if (strcmp(v->keys[i], compare_outcomes[k]) == 0) outcome = true;
+      }
+
+      if (!outcome && !json_equal(&v->items[i], json_get(other, v->keys[i]))) return false;
+    }
+  }
+
+  return true;
+}
+
+/* Same implementation, case and thread count */
+static bool compare_same_key(const json_t* a, const json_t* b)
+{
+  return json_equal(json_get(a, "impl"), json_get(b, "impl")) &&
+         json_equal(json_get(a, "case"), json_get(b, "case")) &&
+         json_equal(json_get(a, "threads"), json_get(b, "threads"));
+}
+
+/* The runtimes of a result; NULL if it has none */
+static uint64_t* compare_runtimes(const json_t* res, uint32_t* n)
+{
+  const json_t* rt = json_get(res, "runtimes");
+
+  if (rt == NULL || rt->kind != JSON_ARR || rt->n == 0) return NULL;
+
+  uint64_t* v = (uint64_t*)malloc(rt->n * sizeof(uint64_t));
+
+  for (size_t i = 0; i < rt->n; i++) v[i] = (uint64_t)rt->items[i].num;
+  *n = (uint32_t)rt->n;
+
+  return v;
+}
+
+static void compare_label(const json_t* res, char* buf, size_t size)
+{
+  const json_t* threads = json_get(res, "threads");
+  const char*   label   = json_str(json_get(res, "case"));
+
+  snprintf(buf, size, "%s/%s/n%d", label != NULL ? label : "-",
+           json_str(json_get(res, "impl")) != NULL ? json_str(json_get(res, "impl")) : "?",
+           threads != NULL ? (int)threads->num : 0);
+}
+
+/* Outcomes summed over every pair of a suite */
+typedef struct {
+  int regress, improve, same, failed, skipped;
+} compare_totals_t;
+
+static const char* compare_row_fmt = "  %-40s %16s %16s %9s %10s  %s\n";
+
+static void compare_header(double threshold, double alpha)
+{
+  printf("\n");
+  printf("Threshold = %.1f%%, alpha = %.3f:\n", threshold, alpha);
+  printf("  %-40s %16s %16s %9s %10s  %s\n", "case/impl/threads", "base (ns)",
+         "new (ns)", "change", "p-value", "result");
+}
+
+/* A manifest without a baseline: its medians alone */
+static int compare_alone(const char* path, double threshold, double alpha,
+                         compare_totals_t* t)
+{
+  json_t next;
+
+  if (!compare_load(path, &next)) return 2;
+
+  printf("New     : %s (no baseline)\n", path);
+  compare_header(threshold, alpha);
+
+  const json_t* nres = json_get(&next, "results");
+
+  for (size_t j = 0; j < nres->n; j++) {
+    const json_t* nr = &nres->items[j];
+    char          label[160];
+    char          median[32] = "-";
+    uint32_t      nn = 0;
+    uint64_t*     rn = compare_runtimes(nr, &nn);
+
+    compare_label(nr, label, sizeof(label));
+
+    if (rn != NULL) {
+      stats_t sn;
+      stats_compute(&sn, rn, nn);
+      snprintf(median, sizeof(median), "%.1f", sn.median);
+      free(rn);
+    }
+
+    printf(compare_row_fmt, label, "-", median, "-", "-", "not in baseline");
+    t->skipped++;
+  }
+
+  json_free(&next);
+  return 0;
+}
+
+/* One baseline against one new run */
+static int compare_pair(const char* bpath, const char* npath, double threshold,
+                        double alpha, bool cross, compare_totals_t* t)
+{
+  json_t base, next;
+
+  if (!compare_load(bpath, &base)) return 2;
+  if (!compare_load(npath, &next)) { json_free(&base); return 2; }
+
+  /* Comparable at all? */
+  const json_t* bbuild = json_get(&base, "build");
+  const json_t* nbuild = json_get(&next, "build");
+
+  printf("Baseline: %s (%s, rev %s)\n", bpath,
+         json_str(json_get(&base, "date")) ? json_str(json_get(&base, "date")) : "?",
+         json_str(json_get(bbuild, "git_rev")) ? json_str(json_get(bbuild, "git_rev")) : "?");
+  printf("New     : %s (%s, rev %s)\n", npath,
+         json_str(json_get(&next, "date")) ? json_str(json_get(&next, "date")) : "?",
+         json_str(json_get(nbuild, "git_rev")) ? json_str(json_get(nbuild, "git_rev")) : "?");
+  printf("\n");
+
+  int status = 0;
+
+  if (!json_equal(json_get(&base, "bench"), json_get(&next, "bench"))) {
+    printf("ERROR: The manifests are of different benchmarks.\n");
+    status = 2;
+  }
+
+  if (status == 0 &&
+      !json_equal(json_get(json_get(&base, "machine"), "key"),
+                  json_get(json_get(&next, "machine"), "key"))) {
+    printf("%s: The runs are from different machines:\n", cross ? "WARNING" : "ERROR");
+    printf("  %s\n", json_str(json_get(json_get(&base, "machine"), "key")));
+    printf("  %s\n", json_str(json_get(json_get(&next, "machine"), "key")));
+    if (!cross) {
+      printf("  (use --cross-machine to compare them anyway)\n");
+      status = 2;
+    }
+  }
+
+  if (status != 0) {
+    json_free(&base);
+    json_free(&next);
+    return status;
+  }
+
+  compare_field(&base, &next, "build"  , "compiler");
+  compare_field(&base, &next, "build"  , "cflags");
+  compare_field(&base, &next, "build"  , "ldflags");
+  compare_field(&base, &next, "build"  , "profile");
+  compare_field(&base, &next, "machine", "governor");
+  compare_field(&base, &next, "machine", "isa_active");
+  compare_field(&base, &next, "config" , "ninner");
+  compare_field(&base, &next, "config" , "nwarmup");
+  compare_field(&base, &next, "config" , "pages");
+  compare_field(&base, &next, "config" , "numa");
+  compare_field(&base, &next, "config" , "prefault");
+  compare_field(&base, &next, "config" , "affinity");
+  compare_field(&base, &next, "config" , "cache");
+  compare_field(&base, &next, "config" , "trace");
+
+  /* Result by result */
+  const json_t* bres = json_get(&base, "results");
+  const json_t* nres = json_get(&next, "results");
+
+  compare_header(threshold, alpha);
+
+  for (size_t j = 0; j < nres->n; j++) {
+    const json_t* nr = &nres->items[j];
+    const json_t* br = NULL;
+    char          label[160];
+
+    for (size_t i = 0; i < bres->n && br == NULL; i++) {
+      if (compare_same_key(&bres->items[i], nr)) br = &bres->items[i];
+    }
+
+    compare_label(nr, label, sizeof(label));
+
+    if (br == NULL) {
+      printf(compare_row_fmt, label, "-", "-", "-", "-", "not in baseline");
+      t->skipped++;
+      continue;
+    }
+
+    if (!compare_same_dataset(json_get(br, "dataset"), json_get(nr, "dataset"))) {
+      printf(compare_row_fmt, label, "-", "-", "-", "-", "dataset differs");
+      t->skipped++;
+      continue;
+    }
+
+    uint32_t  nb = 0, nn = 0;
+    uint64_t* rb = compare_runtimes(br, &nb);
+    uint64_t* rn = compare_runtimes(nr, &nn);
+
+    if (rb == NULL || rn == NULL) {
+      printf(compare_row_fmt, label, "-", "-", "-", "-", "no runtimes");
+      free(rb);
+      free(rn);
+      t->skipped++;
+      continue;
+    }
+
+    stats_t sb, sn;
+    stats_compute(&sb, rb, nb);
+    stats_compute(&sn, rn, nn);
+
+    double      change = (sb.median > 0) ? 100.0 * (sn.median / sb.median - 1.0) : 0.0;
+    double      p      = stats_mann_whitney(rb, nb, rn, nn);
+    const json_t* ok   = json_get(nr, "verified");
+    const char* result;
+
+    if (ok != NULL && ok->kind == JSON_BOOL && ok->num == 0) {
+      result = "FAILED verification";
+      t->failed++;
+    } else if (p < alpha && change > threshold) {
+      result = "REGRESSION";
+      t->regress++;
+    } else if (p < alpha && change < -threshold) {
+      result = "improvement";
+      t->improve++;
+    } else {
+      result = "same";
+      t->same++;
+    }
+
+    printf("  %-40s %16.1f %16.1f %+8.2f%% %10.2e  %s\n", label, sb.median,
+           sn.median, change, p, result);
+
+    free(rb);
+    free(rn);
+  }
+
+  json_free(&base);
+  json_free(&next);
+
+  return 0;
+}
+
+static void compare_summary(const char* what, const compare_totals_t* t)
+{
+  printf("\n");
+  printf("%s: %d regression(s), %d improvement(s), %d same, %d failed, "
+         "%d not compared\n", what, t->regress, t->improve, t->same, t->failed,
+         t->skipped);
+}
+
+static bool compare_is_dir(const char* path)
+{
+  struct stat st;
+
+  return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+static int compare_json_filter(const struct dirent* e)
+{
+  size_t len = strlen(e->d_name);
+
+  return e->d_name[0] != '.' && len > 5 && strcmp(e->d_name + len - 5, ".json") == 0;
+}
+
+/* Every manifest of ndir against the one of the same name in bdir */
+static int compare_dirs(const char* bdir, const char* ndir, double threshold,
+                        double alpha, bool cross)
+{
+  struct dirent** names;
+  int             n = scandir(ndir, &names, compare_json_filter, alphasort);
+
+  if (n < 0) {
+    printf("ERROR: Cannot read the directory \"%s\".\n", ndir);
+    return 2;
+  }
+
+  if (n == 0) {
+    printf("ERROR: No manifests in \"%s\".\n", ndir);
+    free(names);
+    return 2;
+  }
+
+  compare_totals_t all = { 0 };
+  int              status = 0, nerrors = 0;
+
+  for (int i = 0; i < n; i++) {
+    char bpath[4096], npath[4096];
+
+    snprintf(bpath, sizeof(bpath), "%s/%s", bdir, names[i]->d_name);
+    snprintf(npath, sizeof(npath), "%s/%s", ndir, names[i]->d_name);
+
+    printf("%s== %.*s\n", i ? "\n" : "", (int)strlen(names[i]->d_name) - 5,
+           names[i]->d_name);
+
+    compare_totals_t t = { 0 };
+    int              s = (access(bpath, R_OK) == 0)
+                       ? compare_pair(bpath, npath, threshold, alpha, cross, &t)
+                       : compare_alone(npath, threshold, alpha, &t);
+
+    if (s != 0) {
+      nerrors++;
+      status = 2;
+    }
+
+    all.regress += t.regress; all.improve += t.improve; all.same += t.same;
+    all.failed  += t.failed;  all.skipped += t.skipped;
+
+    free(names[i]);
+  }
+  free(names);
+
+  char what[64];
+
+  if (nerrors > 0) snprintf(what, sizeof(what), "Suite of %d (%d not comparable)", n, nerrors);
+  else             snprintf(what, sizeof(what), "Suite of %d", n);
+  compare_summary(what, &all);
+
+  if (status == 0 && (all.regress > 0 || all.failed > 0)) status = 1;
+
+  return status;
+}
+
+static void compare_usage(const char* prog)
+{
+  printf("\n");
+  printf("Usage:\n");
+  printf("  %s [Options] base.json new.json\n", prog);
+  printf("  %s [Options] base_dir new_dir\n", prog);
+  printf("  \n");
+  printf("  Options:\n");
+  printf("    -h | --help          Print this message\n");
+  printf("    -t | --threshold     Smallest change of the median, in percent, that\n");
+  printf("                         counts (default = %.1f)\n", COMPARE_THRESHOLD);
+  printf("    -a | --alpha         Significance level of the Mann-Whitney U test\n");
+  printf("                         (default = %.2f)\n", COMPARE_ALPHA);
+  printf("         --cross-machine Compare runs of different machines anyway\n");
+  printf("\n");
+}
+
+int main(int argc, char** argv)
+{
+  /* Arguments */
+  double      threshold = COMPARE_THRESHOLD;
+  double      alpha     = COMPARE_ALPHA;
+  bool        cross     = false;
+  const char* paths[2];
+  int         npaths    = 0;
+  bool        parse_err = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      compare_usage(argv[0]);
+      return 0;
+    } else if ((strcmp(argv[i], "-t") == 0 || strcmp(argv[i], "--threshold") == 0) && i + 1 < argc) {
+      threshold = atof(argv[++i]);
+    } else if ((strcmp(argv[i], "-a") == 0 || strcmp(argv[i], "--alpha") == 0) && i + 1 < argc) {
+      alpha = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--cross-machine") == 0) {
+      cross = true;
+    } else if (argv[i][0] != '-' && npaths < 2) {
+      paths[npaths++] = argv[i];
+    } else {
+      printf("\n");
+      printf("ERROR: Unknown option \"%s\".\n", argv[i]);
+      parse_err = true;
+    }
+  }
+
+  if (!parse_err && npaths != 2) {
+    printf("\n");
+    printf("ERROR: Two manifests are needed.\n");
+    parse_err = true;
+  }
+
+  if (!parse_err && (threshold < 0 || alpha <= 0 || alpha >= 1)) {
+    printf("\n");
+    printf("ERROR: The threshold must be >= 0 and alpha in (0, 1).\n");
+    parse_err = true;
+  }
+
+  if (parse_err) {
+    compare_usage(argv[0]);
+    return 2;
+  }
+
+  /* A missing baseline directory is an empty one: nothing to compare yet */
+  if (compare_is_dir(paths[1])) {
+    return compare_dirs(paths[0], paths[1], threshold, alpha, cross);
+  }
+
+  compare_totals_t t = { 0 };
+  int status = compare_pair(paths[0], paths[1], threshold, alpha, cross, &t);
+
+  if (status != 0) return status;
+
+  compare_summary("Summary", &t);
+
+  return (t.regress > 0 || t.failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+/* pool_check.c
+ *
+ * Author: Khalid Al-Hawaj
+ * Date  : 14 Oct. 2026
+ *
+ * Stress check of the worker pool (src/common/pool.h), run by make check:
+ * back-to-back pool_run calls with a different thread count each time,
+ * as --scale, the serve mode and the streamed mode issue them. Every
+ * fork must run its task exactly once on each of its threads, and never
+ * again after pool_run returned.
+ *
+ * Exit status: 0 when every fork ran as it should, 1 otherwise.
+ */
+
+/* Standard C includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+
+/* Include common headers */
+#include "common/pool.h"
+
+#define CHECK_THREADS 4
+#define CHECK_FORKS   20000     /* Default; argv[1] overrides it */
+
+/* One fork: how often each thread ran it */
+typedef struct {
+  atomic_int calls[CHECK_THREADS];
+} check_fork_t;
+
+static void check_task(int tid, int nthreads, void* args)
+{
+  check_fork_t* f = (check_fork_t*)args;
+
+  atomic_fetch_add(&f->calls[tid], 1);
+}
+
+int main(int argc, char** argv)
+{
+  int nforks = (argc > 1) ? atoi(argv[1]) : CHECK_FORKS;
+
+  static const int counts[] = { CHECK_THREADS, 1, 2, CHECK_THREADS, 3, 2 };
+  const int        ncounts  = sizeof(counts) / sizeof(counts[0]);
+
+  pool_t pool;
+
+  if (pool_create(&pool, CHECK_THREADS, NULL) != 0) {
+    printf("ERROR: Cannot create a pool of %d threads.\n", CHECK_THREADS);
+    return 1;
+  }
+
+  /* Two forks in flight at most: the current one and the one before,
+   * which a late worker would still be running */
+  check_fork_t forks[2];
+  int          nbad = 0;
+
+  for (int i = 0; i < nforks && nbad < 10; i++) {
+    check_fork_t* f        = &forks[i % 2];
+    check_fork_t* prev     = &forks[(i + 1) % 2];
+    int           nthreads = counts[i % ncounts];
+
+    for (int t = 0; t < CHECK_THREADS; t++) atomic_init(&f->calls[t], 0);
+
+    pool_run(&pool, nthreads, check_task, f);
+
+    for (int t = 0; t < CHECK_THREADS; t++) {
+      int expect = (t < nthreads) ? 1 : 0;
+      int got    = atomic_load(&f->calls[t]);
+
+      if (got != expect) {
+        printf("ERROR: Fork %d on %d thread(s): thread %d ran it %d time(s).\n",
+               i, nthreads, t, got);
+        nbad++;
+      }
+    }
+
+    /* The fork before must not have been run again meanwhile */
+    int prev_threads = counts[(i + ncounts - 1) % ncounts];
+    for (int t = 0; i > 0 && t < CHECK_THREADS; t++) {
+      int expect = (t < prev_threads) ? 1 : 0;
+      int got    = atomic_load(&prev->calls[t]);
+
+      if (got != expect) {
+        printf("ERROR: Fork %d on %d thread(s): thread %d ran it %d time(s) "
+               "by the next fork.\n", i - 1, prev_threads, t, got);
+        nbad++;
+      }
+    }
+  }
+
+  pool_destroy(&pool);
+
+  if (nbad > 0) return 1;
+
+  printf("Pool: %d forks over {", nforks);
+  for (int c = 0; c < ncounts; c++) printf("%s%d", c ? ", " : "", counts[c]);
+  printf("} thread(s) .... Success\n");
+
+  return 0;
+}